@@ -43,4 +43,6 @@ public interface RemoteEnvironment extends Remote {
 	
 	public String[] getFixesInCenter(int sessionId, String centerId) throws RemoteException;
 	
+	public int getCenterTrafficCount(int sessionId, String centerId) throws RemoteException;
+	
 }
@@ -74,6 +74,8 @@ public interface RemoteRiskMeasures extends BaseRemote {
 	public int load_flightphase_aviationOccurence_mapping(String dirPath) throws RemoteException;
 	public int setSampleWeatherHazard(double[] weatherRegionBounds) throws RemoteException;
 	public String[] calculateRisk(String flightData) throws RemoteException;
+	public String[] calculateRisk_codes() throws RemoteException;
+	public double[][] calculateRisk_batch(String[] aircraftIds1, double[][] states1, String[] aircraftIds2, double[][] states2) throws RemoteException;
 	public int setRegionOfRegard(String aircraft, double[] regionBounds) throws RemoteException;
 	public double[][] getRegionOfRegard(String aircraft) throws RemoteException;
 	public String[] getAircraftInRegionOfRegard(String aircraft) throws RemoteException;
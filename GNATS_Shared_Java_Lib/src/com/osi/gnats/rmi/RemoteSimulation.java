@@ -70,6 +70,14 @@ public interface RemoteSimulation extends BaseRemote {
 	
 	public void clear_trajectory() throws RemoteException;
 	
+	public int save_checkpoint(String checkpoint_file) throws RemoteException;
+	
+	public int load_checkpoint(String checkpoint_file) throws RemoteException;
+	
+	public void enable_profiling(boolean flag) throws RemoteException;
+	
+	public String get_profile_report() throws RemoteException;
+	
 	public void request_aircraft(int sessionId, String ac_id) throws RemoteException;
 	
 	public void request_groundVehicle(int sessionId, String gv_id) throws RemoteException;
@@ -47,6 +47,10 @@ public interface RemoteAirport extends Remote {
 	
 	public String[] getAirportsWithinMiles(double latitude_deg, double longitude_deg, double miles) throws RemoteException;
 	
+	public String[] getClosestAirport_batch(double[] latitude_deg, double[] longitude_deg) throws RemoteException;
+	
+	public String[][] getAirportsWithinMiles_batch(double[] latitude_deg, double[] longitude_deg, double miles) throws RemoteException;
+	
 	public String getFullName(String airport_code) throws RemoteException;
 	
 	public Object[] getAllRunways(String airport_code) throws RemoteException;
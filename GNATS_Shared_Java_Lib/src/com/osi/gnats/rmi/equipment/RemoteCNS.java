@@ -37,6 +37,8 @@ public interface RemoteCNS extends Remote {
 
 	public double[] getLineOfSight(double observerLat, double observerLon, double observerAlt, double targetLat, double targetLon, double targetAlt) throws RemoteException;
 
+	public double[][] getLineOfSight_batch(double[][] observers, double[][] targets, double refractionFactor) throws RemoteException;
+
 	public int setNavigationLocationError(int sessionId, String aircraftId, String parameter, double bias, double drift, double scaleFactor, double noiseVariance, int scope) throws RemoteException;
 
 	public int setNavigationAltitudeError(int sessionId, String aircraftId, double bias, double noiseVariance, int scope) throws RemoteException;
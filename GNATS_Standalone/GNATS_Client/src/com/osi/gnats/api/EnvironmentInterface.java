@@ -92,4 +92,11 @@ public interface EnvironmentInterface extends BaseInterface {
 	 * @return
 	 */
 	public String[] getFixesInCenter(String centerId);
+	
+	/**
+	 * @param centerId ARTCC Id
+	 * Returns the number of aircraft currently inside a center.
+	 * @return
+	 */
+	public int getCenterTrafficCount(String centerId);
 }
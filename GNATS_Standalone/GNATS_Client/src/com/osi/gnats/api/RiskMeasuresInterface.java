@@ -200,6 +200,17 @@ public interface RiskMeasuresInterface extends BaseInterface {
 	public int load_flightphase_aviationOccurence_mapping(String dirPath) throws RemoteException;
 	public int setSampleWeatherHazard(double[] weatherRegionBounds) throws RemoteException;
 	public String[] calculateRisk(String flightData) throws RemoteException;
+	/**
+	 * Occurrence codes reported by calculateRisk_batch(), in column order.
+	 */
+	public String[] calculateRisk_codes() throws RemoteException;
+	/**
+	 * Evaluate the calculateRisk() checks on many cases at once.
+	 * Each state row is {latitude_deg, longitude_deg, altitude_ft, course, speed_knots, rocd_fps, flight_phase}.
+	 * aircraftIds2/states2 may be null, or hold null rows, for single-aircraft cases.
+	 * @return One row per case with the time to go (sec) of each occurrence in calculateRisk_codes() order; NaN when not detected.
+	 */
+	public double[][] calculateRisk_batch(String[] aircraftIds1, double[][] states1, String[] aircraftIds2, double[][] states2) throws RemoteException;
 	public int setRegionOfRegard(String aircraft, double[] regionBounds) throws RemoteException;
 	public double[][] getRegionOfRegard(String aircraft) throws RemoteException;
 	public String[] getAircraftInRegionOfRegard(String aircraft) throws RemoteException;
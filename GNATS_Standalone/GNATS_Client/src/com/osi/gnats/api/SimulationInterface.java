@@ -179,6 +179,36 @@ public interface SimulationInterface extends BaseInterface {
 	 */
 	public void clear_trajectory();
 	
+	/**
+	 * Save the simulation state into a checkpoint file.  The outputted file will be saved on NATS_Server.
+	 * The simulation must be paused.
+	 * @param checkpoint_file The filename and path to be outputted.
+	 * @return 0 means success.  Other values mean failure.
+	 */
+	public int save_checkpoint(String checkpoint_file);
+	
+	/**
+	 * Load a checkpoint file saved by save_checkpoint().  The same TRX and MFL files must be loaded before calling this function.
+	 * After setupSimulation(), the next start() resumes the propagation from the time step of the checkpoint.
+	 * @param checkpoint_file The filename and path of the checkpoint file on NATS_Server.
+	 * @return 0 means success.  Other values mean failure.
+	 */
+	public int load_checkpoint(String checkpoint_file);
+	
+	/**
+	 * Enable or disable profiling of the propagation loop.
+	 * When enabled, the wall time of every stage of each time step and the number of flights in each flight phase are recorded.
+	 * The profile is cleared when the simulation starts.
+	 * @param flag True to enable.  False to disable.
+	 */
+	public void enable_profiling(boolean flag);
+	
+	/**
+	 * Get the profile report of the propagation run.
+	 * @return Text report of the time spent in each stage, flight phase counts and CDNR pairs tested.
+	 */
+	public String get_profile_report();
+	
 	/**
 	 * Request aircrafts from NATS Server
 	 * 
@@ -78,6 +78,23 @@ public interface AirportInterface extends BaseInterface {
 	 */
 	public String[] getAirportsWithinMiles(double latitude_deg, double longitude_deg, double miles);
 	
+	/**
+	 * Get the closest airport for each of the given locations.
+	 * @param latitude_deg
+	 * @param longitude_deg
+	 * @return Airport codes, one per location
+	 */
+	public String[] getClosestAirport_batch(double[] latitude_deg, double[] longitude_deg);
+	
+	/**
+	 * Get all airports within the mile range of each of the given locations.
+	 * @param latitude_deg
+	 * @param longitude_deg
+	 * @param miles
+	 * @return Airport codes per location.  Entry is null if no airport is in range.
+	 */
+	public String[][] getAirportsWithinMiles_batch(double[] latitude_deg, double[] longitude_deg, double miles);
+	
 	/**
 	 * Get full airport name of the given airport code.
 	 * @param airport_code
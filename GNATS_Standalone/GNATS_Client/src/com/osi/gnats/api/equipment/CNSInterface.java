@@ -51,6 +51,16 @@ public interface CNSInterface extends BaseInterface {
 	 */
 	public double[] getLineOfSight(double observerLat, double observerLon, double observerAlt, double targetLat, double targetLon, double targetAlt) throws RemoteException;
 	
+	/**
+	 * Computes getLineOfSight() for every observer against every target.
+	 * @param observers Rows of {latitude (degree), longitude (degree), altitude (ft)}.
+	 * @param targets Rows of {latitude (degree), longitude (degree), altitude (ft)}.
+	 * @param refractionFactor Effective Earth radius over true radius. 4/3 for standard atmospheric refraction, 1 for none.
+	 * @return One row per pair, at index (observer index * number of targets + target index), as returned by getLineOfSight().
+	 * Rows of pairs with a null or short position are NaN.
+	 */
+	public double[][] getLineOfSight_batch(double[][] observers, double[][] targets, double refractionFactor) throws RemoteException;
+	
 	/**
 	 * Sets Latitude/Longitude navigation errors for aircraft CNS.
 	 * 
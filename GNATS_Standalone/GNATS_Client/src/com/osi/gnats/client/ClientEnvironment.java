@@ -119,4 +119,15 @@ public class ClientEnvironment extends BaseClass implements EnvironmentInterface
 		
 		return waypoints;
 	}
+	
+	public int getCenterTrafficCount(String centerId) {
+		int count = -1;
+		try {
+			count = remoteEnvironment.getCenterTrafficCount(sessionId, centerId);
+		} catch (Exception ex) {
+			ex.printStackTrace();
+		}
+		
+		return count;
+	}
 }
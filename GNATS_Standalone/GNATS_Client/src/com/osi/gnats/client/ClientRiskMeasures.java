@@ -316,6 +316,14 @@ public class ClientRiskMeasures extends BaseClass implements RiskMeasuresInterfa
 		return remoteRiskMeasures.calculateRisk(flightData);
 	}
 	
+	public String[] calculateRisk_codes() throws RemoteException {
+		return remoteRiskMeasures.calculateRisk_codes();
+	}
+	
+	public double[][] calculateRisk_batch(String[] aircraftIds1, double[][] states1, String[] aircraftIds2, double[][] states2) throws RemoteException {
+		return remoteRiskMeasures.calculateRisk_batch(aircraftIds1, states1, aircraftIds2, states2);
+	}
+	
 	public int setRegionOfRegard(String aircraft, double[] regionBounds) throws RemoteException {
 		return remoteRiskMeasures.setRegionOfRegard(aircraft, regionBounds);
 	}
@@ -235,6 +235,50 @@ public class ClientSimulation extends BaseClass implements SimulationInterface {
 		}
 	}
 	
+	public int save_checkpoint(String checkpoint_file) {
+		int retValue = -1;
+		
+		try {
+			retValue = remoteSimulation.save_checkpoint(checkpoint_file);
+		} catch (Exception ex) {
+			ex.printStackTrace();
+		}
+		
+		return retValue;
+	}
+	
+	public int load_checkpoint(String checkpoint_file) {
+		int retValue = -1;
+		
+		try {
+			retValue = remoteSimulation.load_checkpoint(checkpoint_file);
+		} catch (Exception ex) {
+			ex.printStackTrace();
+		}
+		
+		return retValue;
+	}
+	
+	public void enable_profiling(boolean flag) {
+		try {
+			remoteSimulation.enable_profiling(flag);
+		} catch (Exception ex) {
+			ex.printStackTrace();
+		}
+	}
+	
+	public String get_profile_report() {
+		String retValue = null;
+		
+		try {
+			retValue = remoteSimulation.get_profile_report();
+		} catch (Exception ex) {
+			ex.printStackTrace();
+		}
+		
+		return retValue;
+	}
+	
 	public void request_aircraft(String ac_id) throws RemoteException {
 		remoteSimulation.request_aircraft(sessionId, ac_id);
 	}
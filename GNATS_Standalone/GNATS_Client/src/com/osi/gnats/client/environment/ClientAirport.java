@@ -122,6 +122,30 @@ public class ClientAirport extends BaseClass implements AirportInterface {
 		return retObject;
 	}
 
+	public String[] getClosestAirport_batch(double[] latitude_deg, double[] longitude_deg) {
+		String[] retObject = null;
+
+		try {
+			retObject = remoteAirport.getClosestAirport_batch(latitude_deg, longitude_deg);
+		} catch (Exception ex) {
+			ex.printStackTrace();
+		}
+
+		return retObject;
+	}
+
+	public String[][] getAirportsWithinMiles_batch(double[] latitude_deg, double[] longitude_deg, double miles) {
+		String[][] retObject = null;
+
+		try {
+			retObject = remoteAirport.getAirportsWithinMiles_batch(latitude_deg, longitude_deg, miles);
+		} catch (Exception ex) {
+			ex.printStackTrace();
+		}
+
+		return retObject;
+	}
+
 	public String getFullName(String airport_code) {
 		String retObject = null;
 
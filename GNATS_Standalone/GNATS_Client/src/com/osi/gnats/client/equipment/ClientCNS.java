@@ -62,6 +62,18 @@ public class ClientCNS extends BaseClass implements CNSInterface {
 		return retValue;
 	}
 	
+	public double[][] getLineOfSight_batch(double[][] observers, double[][] targets, double refractionFactor) {
+		double[][] retValue = null;
+		
+		try {
+			retValue = remoteCNS.getLineOfSight_batch(observers, targets, refractionFactor);
+		} catch (Exception ex) {
+			ex.printStackTrace();
+		}
+		
+		return retValue;
+	}
+	
 	public int setNavigationLocationError(String aircraftId, String parameter, double bias, double drift, double scaleFactor, double noiseVariance, int scope) {
 		int retValue = 0;
 		
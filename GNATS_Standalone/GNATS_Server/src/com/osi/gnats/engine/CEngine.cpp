@@ -39,9 +39,16 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include "tg_api.h"
 #include "tg_rap.h"
 #include "tg_aircraft.h"
+#include "tg_aircraftIndex.h"
 #include "tg_airports.h"
+#include "tg_airportIndex.h"
+#include "tg_centers.h"
+#include "tg_checkpoint.h"
+#include "tg_kinematics.h"
+#include "tg_profiler.h"
 #include "tg_sidstars.h"
 #include "tg_simulation.h"
+#include "tg_wake.h"
 #include "tg_waypoints.h"
 #include "tg_weather.h"
 #include "tg_weatherWaypoint.h"
@@ -66,11 +73,14 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include <vector>
 #include <set>
 
+#include <errno.h>
 #include <float.h>
+#include <limits.h>
 #include <fstream>
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 #include <zip.h>
 
@@ -89,7 +99,9 @@ double startLon = -180;
 double endLon = 180;
 double resolution = 0.1;
 bool terrDataLoaded = false;
-map<int,vector<string>> terrData;
+// Elevation samples of each loaded terrain file, ft.  Lines which do not
+// parse as a number are stored as 0.
+map<int,vector<float>> terrData;
 map<string, vector<string>> airportMapData;
 map<int,int> usgsMetadata;
 
@@ -305,6 +317,194 @@ JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableConflictDetection
 	}
 }
 
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableSteadyStepSkip
+  (JNIEnv *jniEnv, jobject jobj, jboolean j_flag) {
+	const bool c_flag = j_flag;
+
+	tg_enable_steady_step_skip(c_flag);
+
+	if (flag_enable_steady_step_skip) {
+		printf("Steady step skip: Enabled\n");
+	} else {
+		printf("Steady step skip: Disabled\n");
+	}
+}
+
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableCruiseFastForward
+  (JNIEnv *jniEnv, jobject jobj, jboolean j_flag) {
+	const bool c_flag = j_flag;
+
+	tg_enable_cruise_fast_forward(c_flag);
+
+	if (flag_enable_cruise_fast_forward) {
+		printf("Cruise fast-forward: Enabled\n");
+	} else {
+		printf("Cruise fast-forward: Disabled\n");
+	}
+}
+
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableTrafficMetrics
+  (JNIEnv *jniEnv, jobject jobj, jboolean j_flag) {
+	const bool c_flag = j_flag;
+
+	tg_enable_traffic_metrics(c_flag);
+
+	if (flag_enable_traffic_metrics) {
+		printf("Traffic metrics: Enabled\n");
+	} else {
+		printf("Traffic metrics: Disabled\n");
+	}
+}
+
+static void get_string_array(JNIEnv *jniEnv, jobjectArray j_strings, vector<string>& strings) {
+	strings.clear();
+	if (j_strings == NULL)
+		return;
+
+	int count = jniEnv->GetArrayLength(j_strings);
+	for (int i = 0; i < count; i++) {
+		jstring tmpJstring = (jstring)jniEnv->GetObjectArrayElement(j_strings, i);
+		if (tmpJstring == NULL)
+			continue;
+
+		const char *c_tmp_string = (char*)jniEnv->GetStringUTFChars(tmpJstring, NULL);
+		strings.push_back(string(c_tmp_string));
+		jniEnv->ReleaseStringUTFChars(tmpJstring, c_tmp_string);
+		jniEnv->DeleteLocalRef(tmpJstring);
+	}
+}
+
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_setTrafficMetricsConfig
+  (JNIEnv *jniEnv, jobject jobj,
+		  jfloat j_bin_sec,
+		  jobjectArray j_sector_names,
+		  jobjectArray j_airport_codes,
+		  jstring j_output_file) {
+	vector<string> c_sector_names;
+	vector<string> c_airport_codes;
+	get_string_array(jniEnv, j_sector_names, c_sector_names);
+	get_string_array(jniEnv, j_airport_codes, c_airport_codes);
+
+	string c_string_output_file;
+	if (j_output_file != NULL) {
+		const char *c_output_file = (char*)jniEnv->GetStringUTFChars( j_output_file, 0 );
+		c_string_output_file = c_output_file;
+		jniEnv->ReleaseStringUTFChars(j_output_file, c_output_file);
+	}
+
+	return tg_set_traffic_metrics_config(j_bin_sec, c_sector_names, c_airport_codes, c_string_output_file);
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getSectorTrafficMetrics
+  (JNIEnv *jniEnv, jobject jobj, jstring j_sector_name) {
+	const char *c_sector_name = (char*)jniEnv->GetStringUTFChars( j_sector_name, 0 );
+	string c_string_sector_name = c_sector_name;
+	jniEnv->ReleaseStringUTFChars(j_sector_name, c_sector_name);
+
+	traffic_metrics_t metrics;
+	tg_get_traffic_metrics(&metrics);
+
+	vector<sector_metrics_bin_t> bins;
+	vector<string>::const_iterator ite = find(metrics.sector_names.begin(), metrics.sector_names.end(), c_string_sector_name);
+	if (ite != metrics.sector_names.end()) {
+		bins = metrics.sector_bins.at(ite - metrics.sector_names.begin());
+	}
+
+	jclass doubleArrayClass = jniEnv->FindClass("[D");
+	jobjectArray retObj = jniEnv->NewObjectArray((jsize) bins.size(), doubleArrayClass, NULL);
+
+	for (unsigned int i = 0; i < bins.size(); i++) {
+		const sector_metrics_bin_t& bin = bins.at(i);
+		jdouble row[4] = {i * metrics.bin_sec, (jdouble)bin.entries, (jdouble)bin.peak_count,
+				bin.occupancy_flight_sec / metrics.bin_sec};
+
+		jdoubleArray rowArray = jniEnv->NewDoubleArray(4);
+		jniEnv->SetDoubleArrayRegion(rowArray, (jsize) 0, (jsize) 4, row);
+		jniEnv->SetObjectArrayElement(retObj, (jsize) i, rowArray);
+		jniEnv->DeleteLocalRef(rowArray);
+	}
+
+	return retObj;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAirportTrafficMetrics
+  (JNIEnv *jniEnv, jobject jobj, jstring j_airport_code) {
+	const char *c_airport_code = (char*)jniEnv->GetStringUTFChars( j_airport_code, 0 );
+	string c_string_airport_code = c_airport_code;
+	jniEnv->ReleaseStringUTFChars(j_airport_code, c_airport_code);
+
+	traffic_metrics_t metrics;
+	tg_get_traffic_metrics(&metrics);
+
+	vector<airport_metrics_bin_t> bins;
+	vector<string>::const_iterator ite = find(metrics.airport_codes.begin(), metrics.airport_codes.end(), c_string_airport_code);
+	if (ite != metrics.airport_codes.end()) {
+		bins = metrics.airport_bins.at(ite - metrics.airport_codes.begin());
+	}
+
+	jclass doubleArrayClass = jniEnv->FindClass("[D");
+	jobjectArray retObj = jniEnv->NewObjectArray((jsize) bins.size(), doubleArrayClass, NULL);
+
+	for (unsigned int i = 0; i < bins.size(); i++) {
+		const airport_metrics_bin_t& bin = bins.at(i);
+		jdouble row[3] = {i * metrics.bin_sec, (jdouble)bin.departures, (jdouble)bin.arrivals};
+
+		jdoubleArray rowArray = jniEnv->NewDoubleArray(3);
+		jniEnv->SetDoubleArrayRegion(rowArray, (jsize) 0, (jsize) 3, row);
+		jniEnv->SetObjectArrayElement(retObj, (jsize) i, rowArray);
+		jniEnv->DeleteLocalRef(rowArray);
+	}
+
+	return retObj;
+}
+
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_writeTrafficMetrics
+  (JNIEnv *jniEnv, jobject jobj,
+		  jstring j_output_file) {
+	const char *c_output_file = (char*)jniEnv->GetStringUTFChars( j_output_file, 0 );
+
+	int retValue = tg_write_traffic_metrics(c_output_file);
+
+	jniEnv->ReleaseStringUTFChars(j_output_file, c_output_file);
+
+	return retValue;
+}
+
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableWakeVortexModel
+  (JNIEnv *jniEnv, jobject jobj, jboolean j_flag) {
+	const bool c_flag = j_flag;
+
+	tg_enable_wake_vortex_model(c_flag);
+
+	if (flag_enable_wake_vortex_model) {
+		printf("Wake vortex model: Enabled\n");
+	} else {
+		printf("Wake vortex model: Disabled\n");
+	}
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getWakeEncounters
+  (JNIEnv *jniEnv, jobject jobj) {
+	vector<wake_encounter_t> encounters;
+	tg_get_wake_encounters(&encounters);
+
+	jclass doubleArrayClass = jniEnv->FindClass("[D");
+	jobjectArray retObj = jniEnv->NewObjectArray((jsize) encounters.size(), doubleArrayClass, NULL);
+
+	for (unsigned int i = 0; i < encounters.size(); i++) {
+		const wake_encounter_t& encounter = encounters.at(i);
+		jdouble row[6] = {encounter.time, (jdouble)encounter.follower_index, (jdouble)encounter.generator_index,
+				encounter.circulation_m2ps, encounter.lateral_distance_ft, encounter.vertical_distance_ft};
+
+		jdoubleArray rowArray = jniEnv->NewDoubleArray(6);
+		jniEnv->SetDoubleArrayRegion(rowArray, (jsize) 0, (jsize) 6, row);
+		jniEnv->SetObjectArrayElement(retObj, (jsize) i, rowArray);
+		jniEnv->DeleteLocalRef(rowArray);
+	}
+
+	return retObj;
+}
+
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getCDR_1status
   (JNIEnv *jniEnv, jobject jobj) {
 	jobjectArray retArray = NULL;
@@ -507,6 +707,42 @@ JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_clear_1trajectories
 	clear_trajectory();
 }
 
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_save_1checkpoint
+  (JNIEnv *jniEnv, jobject jobj,
+		  jstring j_checkpoint_file) {
+	const char *c_checkpoint_file = (char*)jniEnv->GetStringUTFChars( j_checkpoint_file, 0 );
+
+	int retValue = save_simulation_checkpoint(c_checkpoint_file);
+
+	jniEnv->ReleaseStringUTFChars(j_checkpoint_file, c_checkpoint_file);
+
+	return retValue;
+}
+
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_load_1checkpoint
+  (JNIEnv *jniEnv, jobject jobj,
+		  jstring j_checkpoint_file) {
+	const char *c_checkpoint_file = (char*)jniEnv->GetStringUTFChars( j_checkpoint_file, 0 );
+
+	int retValue = load_simulation_checkpoint(c_checkpoint_file);
+
+	jniEnv->ReleaseStringUTFChars(j_checkpoint_file, c_checkpoint_file);
+
+	return retValue;
+}
+
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enable_1propagation_1profiling
+  (JNIEnv *jniEnv, jobject jobj, jboolean flag) {
+	set_propagation_profiling(flag);
+}
+
+JNIEXPORT jstring JNICALL Java_com_osi_gnats_engine_CEngine_get_1propagation_1profile_1report
+  (JNIEnv *jniEnv, jobject jobj) {
+	string tmpReport = get_propagation_profile_report();
+
+	return jniEnv->NewStringUTF(tmpReport.c_str());
+}
+
 JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_request_1aircraft
   (JNIEnv *jniEnv, jobject jobj, jstring j_assigned_auth_id, jstring j_ac_id) {
 	const char *c_assigned_auth_id = (char*)jniEnv->GetStringUTFChars( j_assigned_auth_id, 0 );
@@ -841,35 +1077,16 @@ JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAircraftIds_
 
 	if (!isnan(jni_c_minLatitude) && !isnan(jni_c_maxLatitude) && !isnan(jni_c_minLongitude) && !isnan(jni_c_maxLongitude)) {
 
-		int c_num_flights = get_num_flights();
-		// Check all flights
-		// If its latitude, longitude and/or altitude are in the query range, collect it
-		for (int i = 0; i < c_num_flights; i++) {
-			if ((jni_c_minLatitude <= h_aircraft_soa.latitude_deg[i]) &&
-					(h_aircraft_soa.latitude_deg[i] < jni_c_maxLatitude) &&
-					(jni_c_minLongitude <= h_aircraft_soa.longitude_deg[i]) &&
-					(h_aircraft_soa.longitude_deg[i] < jni_c_maxLongitude)) {
-				if ((jni_c_minAltitude_ft >= 0) && (jni_c_maxAltitude_ft >= 0)) {
-					if ((jni_c_minAltitude_ft <= h_aircraft_soa.altitude_ft[i]) &&
-							(h_aircraft_soa.altitude_ft[i] < jni_c_maxAltitude_ft)) {
-						mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[i].acid));
-						idx_mapCollectedAircrafts++;
-					}
-				} else if (jni_c_minAltitude_ft >= 0) {
-					if (jni_c_minAltitude_ft <= h_aircraft_soa.altitude_ft[i]) {
-						mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[i].acid));
-						idx_mapCollectedAircrafts++;
-					}
-				} else if (jni_c_maxAltitude_ft >= 0) {
-					if (h_aircraft_soa.altitude_ft[i] < jni_c_maxAltitude_ft) {
-						mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[i].acid));
-						idx_mapCollectedAircrafts++;
-					}
-				} else {
-					mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[i].acid));
-					idx_mapCollectedAircrafts++;
-				}
-			}
+		// Flights whose latitude, longitude and/or altitude are in the query range, in flight sequence order
+		vector<int> c_flight_seqs;
+		get_aircraft_in_box(jni_c_minLatitude, jni_c_maxLatitude,
+				jni_c_minLongitude, jni_c_maxLongitude,
+				jni_c_minAltitude_ft, jni_c_maxAltitude_ft,
+				c_flight_seqs);
+
+		for (unsigned int k = 0; k < c_flight_seqs.size(); k++) {
+			mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[c_flight_seqs[k]].acid));
+			idx_mapCollectedAircrafts++;
 		}
 
 		int j = 0;
@@ -910,36 +1127,16 @@ JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAircraftIds
 		jni_c_minAltitude_ft = jniEnv->GetFloatField(jobj_minAltitude_ft, fieldId);
 		jni_c_maxAltitude_ft = jniEnv->GetFloatField(jobj_maxAltitude_ft, fieldId);
 
-		int c_num_flights = get_num_flights();
-
-		// Check all flights
-		// If its latitude, longitude and/or altitude are in the query range, collect it
-		for (int i = 0; i < c_num_flights; i++) {
-			if ((jni_c_minLatitude <= h_aircraft_soa.latitude_deg[i]) &&
-					(h_aircraft_soa.latitude_deg[i] < jni_c_maxLatitude) &&
-					(jni_c_minLongitude <= h_aircraft_soa.longitude_deg[i]) &&
-					(h_aircraft_soa.longitude_deg[i] < jni_c_maxLongitude)) {
-				if ((jni_c_minAltitude_ft >= 0) && (jni_c_maxAltitude_ft >= 0)) {
-					if ((jni_c_minAltitude_ft <= h_aircraft_soa.altitude_ft[i]) &&
-							(h_aircraft_soa.altitude_ft[i] < jni_c_maxAltitude_ft)) {
-						mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[i].acid));
-						idx_mapCollectedAircrafts++;
-					}
-				} else if (jni_c_minAltitude_ft >= 0) {
-					if (jni_c_minAltitude_ft <= h_aircraft_soa.altitude_ft[i]) {
-						mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[i].acid));
-						idx_mapCollectedAircrafts++;
-					}
-				} else if (jni_c_maxAltitude_ft >= 0) {
-					if (h_aircraft_soa.altitude_ft[i] < jni_c_maxAltitude_ft) {
-						mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[i].acid));
-						idx_mapCollectedAircrafts++;
-					}
-				} else {
-					mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[i].acid));
-					idx_mapCollectedAircrafts++;
-				}
-			}
+		// Flights whose latitude, longitude and/or altitude are in the query range, in flight sequence order
+		vector<int> c_flight_seqs;
+		get_aircraft_in_box(jni_c_minLatitude, jni_c_maxLatitude,
+				jni_c_minLongitude, jni_c_maxLongitude,
+				jni_c_minAltitude_ft, jni_c_maxAltitude_ft,
+				c_flight_seqs);
+
+		for (unsigned int k = 0; k < c_flight_seqs.size(); k++) {
+			mapCollectedAircrafts.insert(pair<int, string>(idx_mapCollectedAircrafts, g_trx_records[c_flight_seqs[k]].acid));
+			idx_mapCollectedAircrafts++;
 		}
 
 		int j = 0;
@@ -1260,6 +1457,10 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_synchronize_1aircraft_1
 		d_aircraft_soa.latitude_deg[c_flightSeq] = jniEnv->GetFloatField(jobj_aircraft, fieldId_latitude_deg);
 		d_aircraft_soa.longitude_deg[c_flightSeq] = jniEnv->GetFloatField(jobj_aircraft, fieldId_longitude_deg);
 		d_aircraft_soa.altitude_ft[c_flightSeq] = jniEnv->GetFloatField(jobj_aircraft, fieldId_altitude_ft);
+
+		// Position changed; aircraft region queries must re-index
+		invalidate_aircraft_index();
+
 		d_aircraft_soa.rocd_fps[c_flightSeq] = jniEnv->GetFloatField(jobj_aircraft, fieldId_rocd_fps);
 		d_aircraft_soa.tas_knots[c_flightSeq] = jniEnv->GetFloatField(jobj_aircraft, fieldId_tas_knots);
 		d_aircraft_soa.course_rad[c_flightSeq] = jniEnv->GetFloatField(jobj_aircraft, fieldId_course_rad);
@@ -2338,23 +2539,7 @@ JNIEXPORT jstring JNICALL Java_com_osi_gnats_engine_CEngine_getClosestAirport
 	double c_latitude = j_latitude;
 	double c_longitude = j_longitude;
 
-	string tmp_closest_airport;
-	double tmp_min_distance = -1; // Reset
-
-	// Check all airports in map_airport
-	map<string, NatsAirport*>::iterator ite;
-	for (ite = map_airport.begin(); ite != map_airport.end(); ite++) {
-		NatsAirport* cur_airport_ptr = ite->second;
-		// Calculate distance to the airport
-		double cur_dist_to_airport = compute_distance_gc(c_latitude, c_longitude, cur_airport_ptr->latitude, cur_airport_ptr->longitude, 0);
-
-		if (tmp_min_distance == -1) {
-			tmp_min_distance = cur_dist_to_airport;
-		} else if (cur_dist_to_airport < tmp_min_distance) {
-			tmp_min_distance = cur_dist_to_airport; // Update
-			tmp_closest_airport = ite->first;
-		}
-	}
+	string tmp_closest_airport = get_closest_airport(c_latitude, c_longitude);
 
 	retString = jniEnv->NewStringUTF(tmp_closest_airport.c_str());
 
@@ -2371,33 +2556,17 @@ JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAirportsWith
 
 	jclass jcls_String = jniEnv->FindClass("Ljava/lang/String;");
 
-	int count = 0;
 	vector<string> collectedAirports;
 
 	if (c_miles > 0) {
 		double rangeFeet = 5280 * c_miles;
 
-		// Check all airports in map_airport
-		map<string, NatsAirport*>::iterator ite;
-		for (ite = map_airport.begin(); ite != map_airport.end(); ite++) {
-			NatsAirport* cur_airport_ptr = ite->second;
-			// Calculate distance to the airport
-			double cur_dist_to_airport = compute_distance_gc(c_latitude, c_longitude, cur_airport_ptr->latitude, cur_airport_ptr->longitude, 0);
-			if (cur_dist_to_airport <= rangeFeet) {
-				collectedAirports.push_back(ite->first);
-			}
-		}
+		get_airports_within_range(c_latitude, c_longitude, rangeFeet, collectedAirports);
 
 		if (collectedAirports.size() > 0) {
-			int i = 0;
-
 			retArray = (jobjectArray)jniEnv->NewObjectArray(collectedAirports.size(), jcls_String, jniEnv->NewStringUTF(""));
-			vector<string>::iterator ite2;
-			for (ite2 = collectedAirports.begin(); ite2 != collectedAirports.end(); ite2++)
-			{
-				string tmpAirport = *ite2;
-				jniEnv->SetObjectArrayElement(retArray, i, jniEnv->NewStringUTF(tmpAirport.c_str()));
-				i++;
+			for (unsigned int i = 0; i < collectedAirports.size(); i++) {
+				jniEnv->SetObjectArrayElement(retArray, i, jniEnv->NewStringUTF(collectedAirports.at(i).c_str()));
 			}
 
 			collectedAirports.clear();
@@ -2407,6 +2576,87 @@ JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAirportsWith
 	return retArray;
 }
 
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getClosestAirport_1batch
+  (JNIEnv *jniEnv, jobject jobj, jdoubleArray j_latitudes, jdoubleArray j_longitudes) {
+	jobjectArray retArray = NULL;
+
+	if ((j_latitudes == NULL) || (j_longitudes == NULL))
+		return retArray;
+
+	int count = min(jniEnv->GetArrayLength(j_latitudes), jniEnv->GetArrayLength(j_longitudes));
+
+	vector<double> c_latitudes(count);
+	vector<double> c_longitudes(count);
+	if (count > 0) {
+		jniEnv->GetDoubleArrayRegion(j_latitudes, 0, count, &c_latitudes[0]);
+		jniEnv->GetDoubleArrayRegion(j_longitudes, 0, count, &c_longitudes[0]);
+	}
+
+	vector<string> closestAirports;
+	get_closest_airports(count, c_latitudes.data(), c_longitudes.data(), closestAirports);
+
+	jclass jcls_String = jniEnv->FindClass("Ljava/lang/String;");
+
+	retArray = (jobjectArray)jniEnv->NewObjectArray(count, jcls_String, NULL);
+	for (int i = 0; i < count; i++) {
+		jstring tmpString = jniEnv->NewStringUTF(closestAirports.at(i).c_str());
+		jniEnv->SetObjectArrayElement(retArray, i, tmpString);
+		jniEnv->DeleteLocalRef(tmpString);
+	}
+
+	return retArray;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAirportsWithinMiles_1batch
+  (JNIEnv *jniEnv, jobject jobj, jdoubleArray j_latitudes, jdoubleArray j_longitudes, jdouble j_miles) {
+	jobjectArray retArray = NULL;
+
+	if ((j_latitudes == NULL) || (j_longitudes == NULL))
+		return retArray;
+
+	int count = min(jniEnv->GetArrayLength(j_latitudes), jniEnv->GetArrayLength(j_longitudes));
+	double c_miles = j_miles;
+
+	vector<double> c_latitudes(count);
+	vector<double> c_longitudes(count);
+	if (count > 0) {
+		jniEnv->GetDoubleArrayRegion(j_latitudes, 0, count, &c_latitudes[0]);
+		jniEnv->GetDoubleArrayRegion(j_longitudes, 0, count, &c_longitudes[0]);
+	}
+
+	vector<vector<string> > collectedAirports;
+	if (c_miles > 0) {
+		double rangeFeet = 5280 * c_miles;
+
+		get_airports_within_range(count, c_latitudes.data(), c_longitudes.data(), rangeFeet, collectedAirports);
+	} else {
+		collectedAirports.resize(count);
+	}
+
+	jclass jcls_String = jniEnv->FindClass("Ljava/lang/String;");
+	jclass jcls_StringArray = jniEnv->FindClass("[Ljava/lang/String;");
+
+	// Positions without any airport in range get a null entry, as in getAirportsWithinMiles()
+	retArray = (jobjectArray)jniEnv->NewObjectArray(count, jcls_StringArray, NULL);
+	for (int i = 0; i < count; i++) {
+		const vector<string>& curAirports = collectedAirports.at(i);
+		if (curAirports.size() == 0)
+			continue;
+
+		jobjectArray innerArray = (jobjectArray)jniEnv->NewObjectArray(curAirports.size(), jcls_String, NULL);
+		for (unsigned int j = 0; j < curAirports.size(); j++) {
+			jstring tmpString = jniEnv->NewStringUTF(curAirports.at(j).c_str());
+			jniEnv->SetObjectArrayElement(innerArray, j, tmpString);
+			jniEnv->DeleteLocalRef(tmpString);
+		}
+
+		jniEnv->SetObjectArrayElement(retArray, i, innerArray);
+		jniEnv->DeleteLocalRef(innerArray);
+	}
+
+	return retArray;
+}
+
 JNIEXPORT jstring JNICALL Java_com_osi_gnats_engine_CEngine_getFullName
   (JNIEnv *jniEnv, jobject jobj, jstring j_airport_code) {
 	jstring retString = NULL;
@@ -4062,7 +4312,8 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_setSampleWeatherHazard
 
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_calculateRisk
   (JNIEnv *jniEnv, jobject jobj, jstring flightData, jboolean cifpExists) {
-    
+	(void)cifpExists; // Kept for the Java signature, terrain is not used
+
     string c_string_flightdata = (string)(char*) jniEnv->GetStringUTFChars(flightData, NULL);
     istringstream iss1(c_string_flightdata);
 	vector<string> flightburst;
@@ -4108,289 +4359,166 @@ JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_calculateRisk
 		phase2 = stoi(flight2.at(7));
 	}
 
-	// Check GCOL
-	double distanceToGoToWeather, distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, lat2, lon2, alt2);
-	double timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-
 	angleConverging = 1;
 
-	if ((flightburst.size() == 2) && distanceToGo < 0.1  && angleConverging) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("GCOL");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(acid2);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(phase2));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
+	risk_case_t c_risk_case;
+	c_risk_case.flag_pair = (flightburst.size() == 2);
+
+	c_risk_case.aircraft1.latitude_deg = lat1;
+	c_risk_case.aircraft1.longitude_deg = lon1;
+	c_risk_case.aircraft1.altitude_ft = alt1;
+	c_risk_case.aircraft1.course = course1;
+	c_risk_case.aircraft1.speed_knots = speed1;
+	c_risk_case.aircraft1.rocd_fps = rocd1;
+	c_risk_case.aircraft1.flight_phase = phase1;
+	c_risk_case.aircraft1.flight_seq = select_flightSeq_by_aircraftId(acid1);
+
+	if (c_risk_case.flag_pair) {
+		c_risk_case.aircraft2.latitude_deg = lat2;
+		c_risk_case.aircraft2.longitude_deg = lon2;
+		c_risk_case.aircraft2.altitude_ft = alt2;
+		c_risk_case.aircraft2.course = course2;
+		c_risk_case.aircraft2.speed_knots = speed2;
+		c_risk_case.aircraft2.rocd_fps = rocd2;
+		c_risk_case.aircraft2.flight_phase = phase2;
+		c_risk_case.aircraft2.flight_seq = select_flightSeq_by_aircraftId(acid2);
 	}
-	
-	// Check MAC
-	if ((flightburst.size() == 2) && distanceToGo < 3 && phase1 > 6 && angleConverging) {
+
+	risk_result_t c_risk_result;
+	calculate_risk_batch(1, &c_risk_case, &c_risk_result);
+
+	// Each detected occurrence: delimiter, code, time to go, aircraft, phase(s), position
+	for (int k = 0; k < RISK_AOC_COUNT; k++) {
+		if ((c_risk_result.aoc_flags & (1u << k)) == 0)
+			continue;
+
+		bool flag_pairwise = is_pairwise_risk_aoc((ENUM_Risk_AOC)k);
+
 		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("MAC");
-		retVal.push_back(to_string(timeToGo));
+		retVal.push_back(RISK_AOC_CODES[k]);
+		retVal.push_back(to_string(c_risk_result.time_to_go_sec[k]));
 		retVal.push_back(acid1);
-		retVal.push_back(acid2);
+		if (flag_pairwise) {
+			retVal.push_back(acid2);
+		}
 		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(phase2));
+		if (flag_pairwise) {
+			retVal.push_back(to_string(phase2));
+		}
 		retVal.push_back(to_string(lat1));
 		retVal.push_back(to_string(lon1));
 	}
-	
-	// Check WAKE
-	if ((flightburst.size() == 2) && (truncf(course1 * 10) / 10 == truncf(course2 * 10) / 10) && distanceToGo < 3 && (6 < phase1 < 10) &&  (6 < phase2 < 10) ) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("WAKE");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(acid2);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(phase2));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
+
+	jobjectArray retArray = NULL;
+	jclass jcls = jniEnv->FindClass("Ljava/lang/String;");
+	retArray = (jobjectArray)jniEnv->NewObjectArray(retVal.size(), jcls, jniEnv->NewStringUTF(""));
+	int i = 0;
+	for(auto element = retVal.begin(); element!=retVal.end(); ++element) {
+		string aocElement = *element;
+		jniEnv->SetObjectArrayElement(retArray, i, jniEnv->NewStringUTF(aocElement.c_str()));
+		i++;
 	}
+
+	return retArray;
 	
-	
-	// Check WSTRW
-	if (weatherSample.size() > 0) {
-		distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, weatherSample.at(0), weatherSample.at(1), weatherSample.at(4));
-		timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-		if (distanceToGo < 4.7 && phase1 > 6) {
-			retVal.push_back("__AOC_DELIM__");
-			retVal.push_back("WSTRW");
-			retVal.push_back(to_string(timeToGo));
-			retVal.push_back(acid1);
-			retVal.push_back(to_string(phase1));
-			retVal.push_back(to_string(lat1));
-			retVal.push_back(to_string(lon1));
-		}
+}
+
+/*
+ * Copy one row of a double[][] state array into a risk_state_t.
+ * Row layout: latitude_deg, longitude_deg, altitude_ft, course, speed_knots, rocd_fps, flight_phase
+ */
+static bool get_risk_state(JNIEnv *jniEnv, jobjectArray j_states, const int index, risk_state_t& state) {
+	jdoubleArray j_row = (jdoubleArray)jniEnv->GetObjectArrayElement(j_states, index);
+	if ((j_row == NULL) || (jniEnv->GetArrayLength(j_row) < 7))
+		return false;
+
+	double c_row[7];
+	jniEnv->GetDoubleArrayRegion(j_row, 0, 7, c_row);
+	jniEnv->DeleteLocalRef(j_row);
+
+	state.latitude_deg = c_row[0];
+	state.longitude_deg = c_row[1];
+	state.altitude_ft = c_row[2];
+	state.course = c_row[3];
+	state.speed_knots = c_row[4];
+	state.rocd_fps = c_row[5];
+	state.flight_phase = (int)c_row[6];
+
+	return true;
+}
+
+static int get_risk_flightSeq(JNIEnv *jniEnv, jobjectArray j_acids, const int index) {
+	int retValue = -1;
+
+	if ((j_acids == NULL) || (index >= jniEnv->GetArrayLength(j_acids)))
+		return retValue;
+
+	jstring j_acid = (jstring)jniEnv->GetObjectArrayElement(j_acids, index);
+	if (j_acid != NULL) {
+		const char *c_acid = (char*)jniEnv->GetStringUTFChars(j_acid, NULL);
+		retValue = select_flightSeq_by_aircraftId(string(c_acid));
+		jniEnv->ReleaseStringUTFChars(j_acid, c_acid);
+		jniEnv->DeleteLocalRef(j_acid);
 	}
 
-	
-	// Check CFIT
-	double terrainElevation = Java_com_osi_gnats_engine_CEngine_getElevation(jniEnv, jobj, lat1, lon1, cifpExists);
-	distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, lat1, lon1, 0.0);
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if (distanceToGo < 4.7 && 21 > phase1 > 6) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("CFIT");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
+	return retValue;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_calculateRisk_1codes
+  (JNIEnv *jniEnv, jobject jobj) {
+	jclass jcls_String = jniEnv->FindClass("Ljava/lang/String;");
+
+	jobjectArray retArray = (jobjectArray)jniEnv->NewObjectArray(RISK_AOC_COUNT, jcls_String, NULL);
+	for (int k = 0; k < RISK_AOC_COUNT; k++) {
+		jniEnv->SetObjectArrayElement(retArray, k, jniEnv->NewStringUTF(RISK_AOC_CODES[k]));
 	}
-	
-	// Check TE
-	distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, lat1 + (sin(1/(lat1 * PI / 180.0))), lon1 + (sin(1/(lon1 * PI / 180.0))), alt1);
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if (distanceToGo < 86.52 && ((22 > phase1 > 19) || (4 > phase1 > 1))) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("TE");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
+
+	return retArray;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_calculateRisk_1batch
+  (JNIEnv *jniEnv, jobject jobj, jobjectArray j_acids1, jobjectArray j_states1, jobjectArray j_acids2, jobjectArray j_states2) {
+	jobjectArray retArray = NULL;
+
+	if (j_states1 == NULL)
+		return retArray;
+
+	int count = jniEnv->GetArrayLength(j_states1);
+	int count2 = (j_states2 == NULL) ? 0 : jniEnv->GetArrayLength(j_states2);
+
+	vector<risk_case_t> c_risk_cases(count);
+	for (int i = 0; i < count; i++) {
+		risk_case_t& c_risk_case = c_risk_cases.at(i);
+
+		if (!get_risk_state(jniEnv, j_states1, i, c_risk_case.aircraft1))
+			return retArray;
+		c_risk_case.aircraft1.flight_seq = get_risk_flightSeq(jniEnv, j_acids1, i);
+
+		// A missing second state makes the case a single-aircraft case
+		c_risk_case.flag_pair = (i < count2) && get_risk_state(jniEnv, j_states2, i, c_risk_case.aircraft2);
+		if (c_risk_case.flag_pair) {
+			c_risk_case.aircraft2.flight_seq = get_risk_flightSeq(jniEnv, j_acids2, i);
+		}
 	}
-	
-	// Check RE
-	distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, lat1 + (sin(1/(lat1 * PI / 180.0))), lon1 + (sin(1/(lon1 * PI / 180.0))), alt1);
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if (distanceToGo < 86.52 && ((20 > phase1 > 17) || (6 > phase1 > 3))) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("RE");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
-	}
-	
-	// Check RI
-	distanceToGoToWeather, distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, lat2, lon2, alt2);
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if ((flightburst.size() == 2) && distanceToGo < .375  && angleConverging) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("RI");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(acid2);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(phase2));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
-	}
-	
-	// Check OS
-	jobject tmpJobject;
-	jstring tmpJstring;
-	jclass jcls_String = jniEnv->FindClass("Ljava/lang/String;");
-	jstring runway = Java_com_osi_gnats_engine_CEngine_getArrivalRunway(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	string c_string_runway = (string)(char*) jniEnv->GetStringUTFChars(runway, NULL);
-	jstring airport = Java_com_osi_gnats_engine_CEngine_getArrivalAirport(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	string c_string_airport = (string)(char*) jniEnv->GetStringUTFChars(airport, NULL);
-	jmethodID methodID_toString = jniEnv->GetMethodID(jcls_String, "toString", "()Ljava/lang/String;");	
-	jobjectArray jObjArr = Java_com_osi_gnats_engine_CEngine_getRunwayEnds(jniEnv, jobj, jniEnv->NewStringUTF(c_string_airport.c_str()), jniEnv->NewStringUTF(c_string_runway.c_str()));
-	tmpJobject = jniEnv->GetObjectArrayElement(jObjArr, 1);
-	tmpJstring = (jstring)jniEnv->CallObjectMethod(tmpJobject, methodID_toString);
-	string runwayEnd = (string)(char*) jniEnv->GetStringUTFChars(tmpJstring, NULL);
-	
-	airportMapData.clear();
-	jobjectArray airportMap = Java_com_osi_gnats_engine_CEngine_getLayout_1node_1data(jniEnv, jobj, airport);
-		
-	vector<double> targetPointLoc;
-	istringstream issData(airportMapData[runwayEnd].at(0));
-    for (string token; getline(issData, token, ','); )
-        targetPointLoc.push_back(stod(move(token)));
-        	
-	distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, targetPointLoc.at(0), targetPointLoc.at(1), get_airport_elevation(c_string_airport));
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if (distanceToGo < .52 && ((20 > phase1 > 17) || (6 > phase1 > 3))) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("OS");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
-	}
-	
-	// Check CTOL
-	runway = Java_com_osi_gnats_engine_CEngine_getArrivalRunway(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	c_string_runway = (string)(char*) jniEnv->GetStringUTFChars(runway, NULL);
-	airport = Java_com_osi_gnats_engine_CEngine_getArrivalAirport(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	c_string_airport = (string)(char*) jniEnv->GetStringUTFChars(airport, NULL);
-	jObjArr = Java_com_osi_gnats_engine_CEngine_getRunwayEnds(jniEnv, jobj, jniEnv->NewStringUTF(c_string_airport.c_str()), jniEnv->NewStringUTF(c_string_runway.c_str()));
-	tmpJobject = jniEnv->GetObjectArrayElement(jObjArr, 0);
-	tmpJstring = (jstring)jniEnv->CallObjectMethod(tmpJobject, methodID_toString);
-	runwayEnd = (string)(char*) jniEnv->GetStringUTFChars(tmpJstring, NULL);
-	
-	airportMap = Java_com_osi_gnats_engine_CEngine_getLayout_1node_1data(jniEnv, jobj, airport);
-	
-	targetPointLoc.clear();	
-	targetPointLoc;
-	istringstream issData1(airportMapData[runwayEnd].at(0));
-    for (string token; getline(issData1, token, ','); )
-        targetPointLoc.push_back(stod(move(token)));
-        	
-	distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, targetPointLoc.at(0), targetPointLoc.at(1), get_airport_elevation(c_string_airport));
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if (distanceToGo < 649.34 && ((7 > phase1))) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("CTOL");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
-	}
-	
-	// Check TI
-	runway = Java_com_osi_gnats_engine_CEngine_getArrivalRunway(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	c_string_runway = (string)(char*) jniEnv->GetStringUTFChars(runway, NULL);
-	airport = Java_com_osi_gnats_engine_CEngine_getArrivalAirport(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	c_string_airport = (string)(char*) jniEnv->GetStringUTFChars(airport, NULL);
-	jObjArr = Java_com_osi_gnats_engine_CEngine_getRunwayEnds(jniEnv, jobj, jniEnv->NewStringUTF(c_string_airport.c_str()), jniEnv->NewStringUTF(c_string_runway.c_str()));
-	tmpJobject = jniEnv->GetObjectArrayElement(jObjArr, 0);
-	tmpJstring = (jstring)jniEnv->CallObjectMethod(tmpJobject, methodID_toString);
-	runwayEnd = (string)(char*) jniEnv->GetStringUTFChars(tmpJstring, NULL);
-	
-	airportMap = Java_com_osi_gnats_engine_CEngine_getLayout_1node_1data(jniEnv, jobj, airport);
-	
-	targetPointLoc.clear();	
-	targetPointLoc;
-	istringstream issData2(airportMapData[runwayEnd].at(0));
-    for (string token; getline(issData2, token, ','); )
-        targetPointLoc.push_back(stod(move(token)));
-        	
-	distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, targetPointLoc.at(0), targetPointLoc.at(1), get_airport_elevation(c_string_airport));
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if (distanceToGo > .6 && ((18 < phase1))) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("TI");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
-	}
-	
-	
-	// Check US
-	runway = Java_com_osi_gnats_engine_CEngine_getArrivalRunway(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	c_string_runway = (string)(char*) jniEnv->GetStringUTFChars(runway, NULL);
-	airport = Java_com_osi_gnats_engine_CEngine_getArrivalAirport(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	c_string_airport = (string)(char*) jniEnv->GetStringUTFChars(airport, NULL);
-	jObjArr = Java_com_osi_gnats_engine_CEngine_getRunwayEnds(jniEnv, jobj, jniEnv->NewStringUTF(c_string_airport.c_str()), jniEnv->NewStringUTF(c_string_runway.c_str()));
-	tmpJobject = jniEnv->GetObjectArrayElement(jObjArr, 0);
-	tmpJstring = (jstring)jniEnv->CallObjectMethod(tmpJobject, methodID_toString);
-	runwayEnd = (string)(char*) jniEnv->GetStringUTFChars(tmpJstring, NULL);
-	
-	airportMap = Java_com_osi_gnats_engine_CEngine_getLayout_1node_1data(jniEnv, jobj, airport);
-	
-	targetPointLoc.clear();	
-	targetPointLoc;
-	istringstream issData3(airportMapData[runwayEnd].at(0));
-    for (string token; getline(issData3, token, ','); )
-        targetPointLoc.push_back(stod(move(token)));
-        	
-	distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, targetPointLoc.at(0), targetPointLoc.at(1), get_airport_elevation(c_string_airport));
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if (distanceToGo > .6 && ((18 < phase1))) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("US");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
-	}
-	
-	// Check ML
-	runway = Java_com_osi_gnats_engine_CEngine_getArrivalRunway(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	c_string_runway = (string)(char*) jniEnv->GetStringUTFChars(runway, NULL);
-	airport = Java_com_osi_gnats_engine_CEngine_getArrivalAirport(jniEnv, jobj, jniEnv->NewStringUTF(acid1.c_str()));
-	c_string_airport = (string)(char*) jniEnv->GetStringUTFChars(airport, NULL);
-	jObjArr = Java_com_osi_gnats_engine_CEngine_getRunwayEnds(jniEnv, jobj, jniEnv->NewStringUTF(c_string_airport.c_str()), jniEnv->NewStringUTF(c_string_runway.c_str()));
-	tmpJobject = jniEnv->GetObjectArrayElement(jObjArr, 0);
-	tmpJstring = (jstring)jniEnv->CallObjectMethod(tmpJobject, methodID_toString);
-	runwayEnd = (string)(char*) jniEnv->GetStringUTFChars(tmpJstring, NULL);
-	
-	airportMap = Java_com_osi_gnats_engine_CEngine_getLayout_1node_1data(jniEnv, jobj, airport);
-	
-	targetPointLoc.clear();	
-	targetPointLoc;
-	istringstream issData4(airportMapData[runwayEnd].at(0));
-    for (string token; getline(issData4, token, ','); )
-        targetPointLoc.push_back(stod(move(token)));
-        	
-	distanceToGo = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, lat1, lon1, alt1, targetPointLoc.at(0), targetPointLoc.at(1), get_airport_elevation(c_string_airport));
-	timeToGo = (distanceToGo * 1609.34) / (speed1 * 0.514444);
-	if (distanceToGo > .6 && ((18 < phase1))) {
-		retVal.push_back("__AOC_DELIM__");
-		retVal.push_back("ML");
-		retVal.push_back(to_string(timeToGo));
-		retVal.push_back(acid1);
-		retVal.push_back(to_string(phase1));
-		retVal.push_back(to_string(lat1));
-		retVal.push_back(to_string(lon1));
-	}
-	
-	jobjectArray retArray = NULL;
-	jclass jcls = jniEnv->FindClass("Ljava/lang/String;");
-	retArray = (jobjectArray)jniEnv->NewObjectArray(retVal.size(), jcls, jniEnv->NewStringUTF(""));
-	int i = 0;
-	for(auto element = retVal.begin(); element!=retVal.end(); ++element) {
-		string aocElement = *element;
-		jniEnv->SetObjectArrayElement(retArray, i, jniEnv->NewStringUTF(aocElement.c_str()));
-		i++;
+
+	angleConverging = 1;
+
+	vector<risk_result_t> c_risk_results(count);
+	if (calculate_risk_batch(count, c_risk_cases.data(), c_risk_results.data()) != 0)
+		return retArray;
+
+	jclass jcls_DoubleArray = jniEnv->FindClass("[D");
+
+	// Row i holds the time to go (sec) of every occurrence in calculateRisk_codes() order, NaN if not detected
+	retArray = (jobjectArray)jniEnv->NewObjectArray(count, jcls_DoubleArray, NULL);
+	for (int i = 0; i < count; i++) {
+		jdoubleArray j_row = jniEnv->NewDoubleArray(RISK_AOC_COUNT);
+		jniEnv->SetDoubleArrayRegion(j_row, 0, RISK_AOC_COUNT, c_risk_results.at(i).time_to_go_sec);
+		jniEnv->SetObjectArrayElement(retArray, i, j_row);
+		jniEnv->DeleteLocalRef(j_row);
 	}
 
 	return retArray;
-	
 }
 
 JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_setRegionOfRegard
@@ -4442,29 +4570,15 @@ JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getRegionOfRega
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAircraftInRegionOfRegard
   (JNIEnv *jniEnv, jobject jobj, jstring aircraft) {
   jclass jcls_string = jniEnv->FindClass("Ljava/lang/String;");
-  jmethodID methodID_toString = jniEnv->GetMethodID(jcls_string, "toString", "()Ljava/lang/String;");
   jobjectArray retArray = NULL;
-  jobjectArray tmpArray = NULL;
   vector<string> tmpVec;
-  jobject tmpJobject;
-  jstring tmpJstring;
   
   string c_string_acid = (string)(char*) jniEnv->GetStringUTFChars(aircraft, NULL);
   
-  for(vector<double> temp: regionOfRegard[c_string_acid]) {
-  	tmpArray = Java_com_osi_gnats_engine_CEngine_getAircraftIds_doubleVals(jniEnv, jobj, temp[0], temp[1], temp[2], temp[3], temp[4], temp[5]);
-  	int cnt_aircraft = jniEnv->GetArrayLength(tmpArray);
-	if (cnt_aircraft > 0) {
-		for (int i = 0; i < cnt_aircraft; i++) {
-			tmpJobject = jniEnv->GetObjectArrayElement(tmpArray, i);
-			tmpJstring = (jstring)jniEnv->CallObjectMethod(tmpJobject, methodID_toString);
-	
-			const char *c_tmp_flight = (char*)jniEnv->GetStringUTFChars(tmpJstring, NULL );
-			string c_flight = c_tmp_flight;
-	
-			tmpVec.push_back(c_flight);
-	    }
-    }
+  vector<int> c_flight_seqs;
+  get_aircraft_in_region_of_regard(c_string_acid, c_flight_seqs);
+  for (unsigned int i = 0; i < c_flight_seqs.size(); i++) {
+	tmpVec.push_back(g_trx_records[c_flight_seqs[i]].acid);
   }
   
   retArray = (jobjectArray)jniEnv->NewObjectArray(tmpVec.size(), jcls_string, jniEnv->NewStringUTF(""));
@@ -4543,32 +4657,38 @@ JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getDistanceToObjectO
 }
 
 
-JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getTimeToVehicleContact
-  (JNIEnv *jniEnv, jobject jobj, jstring aircraftId1, jstring aircraftId2) {
-
-  double retVal = -1;
-  
+/*
+ * Resolve two aircraft ids and compute their closest point of approach.
+ * Returns 0 on success and -1 when either aircraft does not exist.
+ */
+static int compute_aircraft_pair_cpa(JNIEnv *jniEnv, jstring aircraftId1, jstring aircraftId2, cpa_result_t* const result) {
   const char *c_aircraft1 = (char*)jniEnv->GetStringUTFChars( aircraftId1, NULL );
   string string_aircraft1(c_aircraft1); // Convert char* to string
-  
+  jniEnv->ReleaseStringUTFChars(aircraftId1, c_aircraft1);
+
   const char *c_aircraft2 = (char*)jniEnv->GetStringUTFChars( aircraftId2, NULL );
   string string_aircraft2(c_aircraft2); // Convert char* to string
-  
+  jniEnv->ReleaseStringUTFChars(aircraftId2, c_aircraft2);
+
   int c_flightSeq1 = select_flightSeq_by_aircraftId(string_aircraft1);
   int c_flightSeq2 = select_flightSeq_by_aircraftId(string_aircraft2);
-  
-  if (c_flightSeq1 != -1 && c_flightSeq2 != -1) {  
-  	FlightPlan curFlightPlan1 = g_flightplans.at(c_flightSeq1);
-  	FlightPlan curFlightPlan2 = g_flightplans.at(c_flightSeq2);
 
-	int loopLength = (curFlightPlan1.route.size() >= curFlightPlan2.route.size()) ? curFlightPlan2.route.size() : curFlightPlan1.route.size();
-	
-  	for (int i=0; i < loopLength; i++) {  	
-  		if(curFlightPlan1.route.at(i).wpname == curFlightPlan2.route.at(i).wpname) {
-  			    retVal = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, h_aircraft_soa.latitude_deg[c_flightSeq1], h_aircraft_soa.longitude_deg[c_flightSeq1], h_aircraft_soa.altitude_ft[c_flightSeq1], h_aircraft_soa.latitude_deg[c_flightSeq2], h_aircraft_soa.longitude_deg[c_flightSeq2], h_aircraft_soa.altitude_ft[c_flightSeq2]);
-  		}
-  	}
-  }
+  if (c_flightSeq1 == -1 || c_flightSeq2 == -1)
+    return -1;
+
+  return compute_flight_pair_cpa(c_flightSeq1, c_flightSeq2, result);
+}
+
+JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getTimeToVehicleContact
+  (JNIEnv *jniEnv, jobject jobj, jstring aircraftId1, jstring aircraftId2) {
+
+  double retVal = -1;
+
+  // Time until the two aircraft reach their closest point of approach
+  cpa_result_t cpa;
+  if (compute_aircraft_pair_cpa(jniEnv, aircraftId1, aircraftId2, &cpa) == 0)
+    retVal = cpa.t_cpa_sec;
+
   return retVal;
 }
 
@@ -4593,19 +4713,12 @@ JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getRateOfLineOfSight
   (JNIEnv *jniEnv, jobject jobj, jstring aircraftId1, jstring aircraftId2) {
   
   double retVal = -1;
-  
-  const char *c_aircraft1 = (char*)jniEnv->GetStringUTFChars( aircraftId1, NULL );
-  string string_aircraft1(c_aircraft1); // Convert char* to string
-  
-  const char *c_aircraft2 = (char*)jniEnv->GetStringUTFChars( aircraftId2, NULL );
-  string string_aircraft2(c_aircraft2); // Convert char* to string
-  
-  int c_flightSeq1 = select_flightSeq_by_aircraftId(string_aircraft1);
-  int c_flightSeq2 = select_flightSeq_by_aircraftId(string_aircraft2);
-  
-  if (c_flightSeq1 != -1 && c_flightSeq2 != -1 && angleConverging)
-    retVal = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, h_aircraft_soa.latitude_deg[c_flightSeq1], h_aircraft_soa.longitude_deg[c_flightSeq1], h_aircraft_soa.altitude_ft[c_flightSeq1], h_aircraft_soa.latitude_deg[c_flightSeq2], h_aircraft_soa.longitude_deg[c_flightSeq2], h_aircraft_soa.altitude_ft[c_flightSeq2])  / (d_aircraft_soa.tas_knots[c_flightSeq1] * 0.514444);
-  
+
+  // Rotation rate of the line of sight, rad/sec
+  cpa_result_t cpa;
+  if (compute_aircraft_pair_cpa(jniEnv, aircraftId1, aircraftId2, &cpa) == 0)
+    retVal = cpa.los_rate_rad_per_sec;
+
   return retVal;
   
 }
@@ -4632,28 +4745,12 @@ JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getRateOfApproachToV
   (JNIEnv *jniEnv, jobject jobj, jstring aircraftId1, jstring aircraftId2, jint timeSteps) {
  
   double retVal = -1;
-  
-  const char *c_aircraft1 = (char*)jniEnv->GetStringUTFChars( aircraftId1, NULL );
-  string string_aircraft1(c_aircraft1); // Convert char* to string
-  
-  const char *c_aircraft2 = (char*)jniEnv->GetStringUTFChars( aircraftId2, NULL );
-  string string_aircraft2(c_aircraft2); // Convert char* to string
-  
-  int c_flightSeq1 = select_flightSeq_by_aircraftId(string_aircraft1);
-  int c_flightSeq2 = select_flightSeq_by_aircraftId(string_aircraft2);
-  
-  if (c_flightSeq1 != -1 && c_flightSeq2 != -1) {  
-  	FlightPlan curFlightPlan1 = g_flightplans.at(c_flightSeq1);
-  	FlightPlan curFlightPlan2 = g_flightplans.at(c_flightSeq2);
 
-	int loopLength = (curFlightPlan1.route.size() >= curFlightPlan2.route.size()) ? curFlightPlan2.route.size() : curFlightPlan1.route.size();
-	
-  	for (int i=0; i < loopLength; i++) {  	
-  		if(curFlightPlan1.route.at(i).wpname == curFlightPlan2.route.at(i).wpname) {
-  			    retVal = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, h_aircraft_soa.latitude_deg[c_flightSeq1], h_aircraft_soa.longitude_deg[c_flightSeq1], h_aircraft_soa.altitude_ft[c_flightSeq1], h_aircraft_soa.latitude_deg[c_flightSeq2], h_aircraft_soa.longitude_deg[c_flightSeq2], h_aircraft_soa.altitude_ft[c_flightSeq2]) / (timeSteps);
-  		}
-  	}
-  }
+  // Closure rate, ft/sec.  The instantaneous rate does not depend on timeSteps.
+  cpa_result_t cpa;
+  if (compute_aircraft_pair_cpa(jniEnv, aircraftId1, aircraftId2, &cpa) == 0)
+    retVal = cpa.closure_rate_fps;
+
   return retVal;
   
 }
@@ -4741,28 +4838,31 @@ JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getRateOfApproachToW
   (JNIEnv *jniEnv, jobject jobj, jstring aircraftId1, jstring aircraftId2){
  
   double retVal = -1;
-  
+
   const char *c_aircraft1 = (char*)jniEnv->GetStringUTFChars( aircraftId1, NULL );
   string string_aircraft1(c_aircraft1); // Convert char* to string
-  
+  jniEnv->ReleaseStringUTFChars(aircraftId1, c_aircraft1);
+
   const char *c_aircraft2 = (char*)jniEnv->GetStringUTFChars( aircraftId2, NULL );
   string string_aircraft2(c_aircraft2); // Convert char* to string
-  
+  jniEnv->ReleaseStringUTFChars(aircraftId2, c_aircraft2);
+
   int c_flightSeq1 = select_flightSeq_by_aircraftId(string_aircraft1);
   int c_flightSeq2 = select_flightSeq_by_aircraftId(string_aircraft2);
-  
-  if (c_flightSeq1 != -1 && c_flightSeq2 != -1) {  
-  	FlightPlan curFlightPlan1 = g_flightplans.at(c_flightSeq1);
-  	FlightPlan curFlightPlan2 = g_flightplans.at(c_flightSeq2);
 
-	int loopLength = (curFlightPlan1.route.size() >= curFlightPlan2.route.size()) ? curFlightPlan2.route.size() : curFlightPlan1.route.size();
-	
-  	for (int i=0; i < loopLength; i++) {  	
-  		if(curFlightPlan1.route.at(i).wpname == curFlightPlan2.route.at(i).wpname) {
-  			    retVal = Java_com_osi_gnats_engine_CEngine_calculateDistance(jniEnv, jobj, h_aircraft_soa.latitude_deg[c_flightSeq1], h_aircraft_soa.longitude_deg[c_flightSeq1], h_aircraft_soa.altitude_ft[c_flightSeq1], h_aircraft_soa.latitude_deg[c_flightSeq2], h_aircraft_soa.longitude_deg[c_flightSeq2], h_aircraft_soa.altitude_ft[c_flightSeq2]);
-  		}
-  	}
-  }
+  if (c_flightSeq1 == -1 || c_flightSeq2 == -1)
+    return retVal;
+
+  // Closure rate of the trailing aircraft on the nearest live wake segment
+  // of the leading aircraft, ft/sec
+  if (flag_enable_wake_vortex_model && (compute_rate_of_approach_to_wake(c_flightSeq1, c_flightSeq2, &retVal) == 0))
+    return retVal;
+
+  // Without a modeled wake, fall back to the closure rate on the leading aircraft
+  cpa_result_t cpa;
+  if (compute_flight_pair_cpa(c_flightSeq1, c_flightSeq2, &cpa) == 0)
+    retVal = cpa.closure_rate_fps;
+
   return retVal;
   
 }
@@ -4867,6 +4967,30 @@ JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getRateOfApproachToR
 }
 
 
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getClosestPointsOfApproach
+  (JNIEnv *jniEnv, jobject jobj, jdouble radiusFt) {
+	vector<cpa_result_t> results;
+	compute_cpa_within_radius(radiusFt, &results);
+
+	jclass doubleArrayClass = jniEnv->FindClass("[D");
+	jobjectArray retObj = jniEnv->NewObjectArray((jsize) results.size(), doubleArrayClass, NULL);
+
+	for (unsigned int i = 0; i < results.size(); i++) {
+		const cpa_result_t& cpa = results.at(i);
+		jdouble row[7] = {(jdouble)cpa.flight_index_1, (jdouble)cpa.flight_index_2,
+				cpa.range_ft, cpa.t_cpa_sec, cpa.d_cpa_ft,
+				cpa.closure_rate_fps, cpa.los_rate_rad_per_sec};
+
+		jdoubleArray rowArray = jniEnv->NewDoubleArray(7);
+		jniEnv->SetDoubleArrayRegion(rowArray, (jsize) 0, (jsize) 7, row);
+		jniEnv->SetObjectArrayElement(retObj, (jsize) i, rowArray);
+		jniEnv->DeleteLocalRef(rowArray);
+	}
+
+	return retObj;
+}
+
+
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAllGroundVehicleIds
   (JNIEnv *jniEnv, jobject jobj) {
 	jobjectArray retArray = NULL;
@@ -5079,7 +5203,7 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_synchronize_1groundvehi
 		if(string_parameter == "speed")
 			groundVehicleStates.at(c_groundVehicleSeq).speed = jniEnv->GetFloatField(groundVehicle, fieldId_speed);
 		if(string_parameter == "course") {
-			courseChange.push_back(groundVehicleStates.at(c_groundVehicleSeq).vehicle_id);
+			groundVehicleStates.at(c_groundVehicleSeq).flag_course_override = true;
 			groundVehicleStates.at(c_groundVehicleSeq).course = jniEnv->GetFloatField(groundVehicle, fieldId_course);
 		}
 
@@ -5183,69 +5307,83 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_externalGroundVehicle_1
 
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getCenterCodes
   (JNIEnv *jniEnv, jobject jobj) {
-  	vector<string> centerList{"KZAU", "KZBW", "KZDC", "KZDV", "KZFW", "KZHU",
-				"KZID", "KZJX", "KZKC", "KZLA", "KZLC", "KZMA", "KZME", "KZMP", "KZNY", "KZOA", "KZOB", "KZSE", "KZTL", "PZAN", "PZHN", "KZAB" };
-  
+	vector<string> centerList;
+	tg_get_center_codes(&centerList);
+
 	jobjectArray retArray = NULL;
 
 	jclass jcls = jniEnv->FindClass("Ljava/lang/String;");
 
 	retArray = (jobjectArray)jniEnv->NewObjectArray(centerList.size(), jcls, jniEnv->NewStringUTF(""));
 
-	int i = 0;
-
-	for(auto element = centerList.begin(); element!=centerList.end(); ++element) {
-
-		string center = *element;
-		jniEnv->SetObjectArrayElement(retArray, i, jniEnv->NewStringUTF(center.c_str()));
-		i++;
+	for (unsigned int i = 0; i < centerList.size(); i++) {
+		jniEnv->SetObjectArrayElement(retArray, i, jniEnv->NewStringUTF(centerList.at(i).c_str()));
 	}
 
 	return retArray;
-
-  }
+}
 
 
 JNIEXPORT jstring JNICALL Java_com_osi_gnats_engine_CEngine_getCurrentCenter
-  (JNIEnv *, jobject, jstring);
+  (JNIEnv *jniEnv, jobject jobj, jstring aircraftId) {
+	const char *c_acid = (char*)jniEnv->GetStringUTFChars( aircraftId, NULL );
+	string string_acid(c_acid); // Convert char* to string
+	jniEnv->ReleaseStringUTFChars(aircraftId, c_acid);
+
+	string currentCenter = "";
+
+	int flightSeq = select_flightSeq_by_aircraftId(string_acid);
+	if (flightSeq > -1) {
+		if (flightSeq < (int)h_flight_center_index.size()) {
+			// Tracked by the running propagation
+			tg_get_current_center(flightSeq, &currentCenter);
+		} else {
+			// Not propagated yet.  Locate the aircraft's initial state.
+			currentCenter = get_center_code(find_center(h_aircraft_soa.latitude_deg[flightSeq],
+					h_aircraft_soa.longitude_deg[flightSeq],
+					h_aircraft_soa.altitude_ft[flightSeq]));
+		}
+	}
+
+	return jniEnv->NewStringUTF(currentCenter.c_str());
+}
 
 
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getFixesInCenter
   (JNIEnv *jniEnv, jobject jobj, jstring centerId) {
 
-  	const char *c_centerId = (char*)jniEnv->GetStringUTFChars( centerId, NULL );
+	const char *c_centerId = (char*)jniEnv->GetStringUTFChars( centerId, NULL );
 	string string_centerId(c_centerId); // Convert char* to string
+	jniEnv->ReleaseStringUTFChars(centerId, c_centerId);
 
-  	ifstream centerFile(g_share_dir + "/artcc/ArtccWaypoints.csv");
-  	vector<string> fixes;
-  	string line;
-	const char delim = ',';
-	
-	while (getline(centerFile, line)) {
-			vector<std::string> out;
-    		tokenize(line, delim, out);
-
-			if (out.at(0) == string_centerId)
-				fixes.push_back(out.at(1));
-	}
+	vector<string> fixes;
+	tg_get_fixes_in_center(string_centerId, &fixes);
 
-    jobjectArray retArray = NULL;
+	jobjectArray retArray = NULL;
 
 	jclass jcls = jniEnv->FindClass("Ljava/lang/String;");
 
 	retArray = (jobjectArray)jniEnv->NewObjectArray(fixes.size(), jcls, jniEnv->NewStringUTF(""));
 
-	int i = 0;
-
-	for(auto element = fixes.begin(); element!=fixes.end(); ++element) {
-
-		string fix = *element;
-		jniEnv->SetObjectArrayElement(retArray, i, jniEnv->NewStringUTF(fix.c_str()));
-		i++;
+	for (unsigned int i = 0; i < fixes.size(); i++) {
+		jniEnv->SetObjectArrayElement(retArray, i, jniEnv->NewStringUTF(fixes.at(i).c_str()));
 	}
 
 	return retArray;
-  }
+}
+
+
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_getCenterTrafficCount
+  (JNIEnv *jniEnv, jobject jobj, jstring centerId) {
+	const char *c_centerId = (char*)jniEnv->GetStringUTFChars( centerId, NULL );
+	string string_centerId(c_centerId); // Convert char* to string
+	jniEnv->ReleaseStringUTFChars(centerId, c_centerId);
+
+	int count = -1;
+	tg_get_center_traffic_count(string_centerId, &count);
+
+	return count;
+}
 
 
 
@@ -5254,7 +5392,11 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_setGroundOperatorAbsenc
 	const char *c_gvid = (char*)jniEnv->GetStringUTFChars( groundVehicleId, NULL );
 	string string_gvid(c_gvid); // Convert char* to string
 
-	groundOperatorAbsence[string_gvid] = timeSteps;
+	int c_groundVehicleSeq = select_groundVehicleStateSeq(string_gvid);
+	if (c_groundVehicleSeq < 0)
+		return 0;
+
+	groundVehicleStates.at(c_groundVehicleSeq).operator_absence_steps = timeSteps;
 
 	return 1;
 }
@@ -5271,8 +5413,14 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_groundVehicle_1setActio
 	const string lagParameterString = (string) jniEnv->GetStringUTFChars(
 				lagParameter, NULL);
 
+	int c_groundVehicleSeq = select_groundVehicleStateSeq(string_gvid);
+	if (c_groundVehicleSeq < 0)
+		return 0;
+
+	GroundVehicle& groundVehicle = groundVehicleStates.at(c_groundVehicleSeq);
+
 	if (lagParameterString == "COURSE") {
-		gvLagParams[string_gvid].push_back("COURSE");
+		groundVehicle.lag_params.push_back(GROUND_VEHICLE_LAG_COURSE);
 		float G = log(1 / percentageError) / lagTimeConstant
 				* t_step_terminal;
 		if (parameterCurrentValue < parameterTarget) {
@@ -5281,7 +5429,7 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_groundVehicle_1setActio
 				parameterCurrentValue = parameterCurrentValue
 						+ G * (parameterTarget - parameterCurrentValue);
 				if ((parameterCurrentValue < parameterTarget)) {
-					gvLagParamValues[string_gvid]["COURSE"].push_back(
+					groundVehicle.lag_course_values.push_back(
 							parameterCurrentValue);
 				}
 			}
@@ -5291,16 +5439,16 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_groundVehicle_1setActio
 				parameterCurrentValue = parameterCurrentValue
 						+ G * (parameterTarget - parameterCurrentValue);
 				if ((parameterCurrentValue > parameterTarget)) {
-					gvLagParamValues[string_gvid]["COURSE"].push_back(
+					groundVehicle.lag_course_values.push_back(
 							parameterCurrentValue);
 				}
 			}
 		}
-		gvLagParamValues[string_gvid]["COURSE"].push_back(parameterTarget);
+		groundVehicle.lag_course_values.push_back(parameterTarget);
 	}
 
 	if (lagParameterString == "SPEED") {
-		gvLagParams[string_gvid].push_back("SPEED");
+		groundVehicle.lag_params.push_back(GROUND_VEHICLE_LAG_SPEED);
 		float G = log(1 / percentageError) / lagTimeConstant
 				* t_step_terminal;
 		if (parameterCurrentValue < parameterTarget) {
@@ -5309,7 +5457,7 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_groundVehicle_1setActio
 				parameterCurrentValue = parameterCurrentValue
 						+ G * (parameterTarget - parameterCurrentValue);
 				if ((parameterCurrentValue < parameterTarget)) {
-					gvLagParamValues[string_gvid]["SPEED"].push_back(
+					groundVehicle.lag_speed_values.push_back(
 							parameterCurrentValue);
 				}
 			}
@@ -5320,13 +5468,13 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_groundVehicle_1setActio
 				parameterCurrentValue = parameterCurrentValue
 						+ G * (parameterTarget - parameterCurrentValue);
 				if ((parameterCurrentValue > parameterTarget)) {
-					gvLagParamValues[string_gvid]["SPEED"].push_back(
+					groundVehicle.lag_speed_values.push_back(
 							parameterCurrentValue);
 				}
 			}
 
 		}
-		gvLagParamValues[string_gvid]["SPEED"].push_back(parameterTarget);
+		groundVehicle.lag_speed_values.push_back(parameterTarget);
 	}
 
 	return 1;
@@ -5361,9 +5509,9 @@ JNIEXPORT jfloat JNICALL Java_com_osi_gnats_engine_CEngine_groundVehicle_1setAct
 			string_gvid);
 
 	if (string_repeatParameter == "SPEED")
-		retVal = groundVehiclePreviousStates.at(c_groundVehicleSeq).speed;
+		retVal = groundVehiclePreviousStates.speed.at(c_groundVehicleSeq);
 	else if (string_repeatParameter == "COURSE")
-		retVal = groundVehiclePreviousStates.at(c_groundVehicleSeq).course;
+		retVal = groundVehiclePreviousStates.course.at(c_groundVehicleSeq);
 
 	return retVal;
 }
@@ -5397,12 +5545,34 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_setRadarError
 	return retVal;
 }
 
-void explode(string const & s, char delim, int index)
+// Parse one elevation sample per line of a NUL-terminated terrain file
+void explode(const char* contents, const size_t length, int index)
 {
-    istringstream iss(s);
+	vector<float>& samples = terrData[index];
+
+	size_t pos = 0;
+	while (pos < length) {
+		const char* line_end = (const char*)memchr(contents + pos, '\n', length - pos);
+		size_t end = (line_end == NULL) ? length : (line_end - contents);
+
+		// Same result as stod(): leading blanks are skipped, trailing
+		// characters are ignored, and lines without a number read as 0
+		size_t start = pos;
+		while ((start < end) && isspace((unsigned char)contents[start]))
+			start++;
+
+		float sample = 0;
+		if (start < end) {
+			char* parse_end = NULL;
+			errno = 0;
+			double value = strtod(contents + start, &parse_end);
+			if ((parse_end != contents + start) && (errno != ERANGE))
+				sample = value * 100;
+		}
+		samples.push_back(sample);
 
-    for (string token; getline(iss, token, delim); )
-        terrData[index].push_back(move(token));
+		pos = end + 1;
+	}
 }
 
 // Method to get index of file that contains elevation data
@@ -5448,6 +5618,193 @@ int getFileIndex(string path, double latitude, double longitude) {
 	return fileNumber;
 }
 
+// Latitude index of a position on the contiguous US grid
+static int get_conus_latitude_index(const double latitude) {
+	return (int) ((latitude - 23.937) / 0.001);
+}
+
+// Longitude index on the contiguous US grid of round((longitude - 0.001) * 1000)
+static int get_conus_longitude_index(const double rounded_longitude) {
+	int index = (int) ((rounded_longitude / 1000.0 - (-125.185)) / 0.001);
+
+	return (index < 0) ? 0 : index;
+}
+
+// Contiguous US elevation sample, ft, or 0 where no terrain is loaded
+static double get_conus_sample(const int latitude_index, const int longitude_index) {
+	int latitudeDifferenceAcrossGrid = 24872;
+
+	int a = longitude_index * latitudeDifferenceAcrossGrid + latitude_index;
+	int b = (int) floor(a / 50092208);
+
+	map<int, vector<float>>::const_iterator ite_file = terrData.find(b);
+	size_t index = a - (b) * 50092208;
+
+	if ((ite_file == terrData.end()) || (index >= ite_file->second.size()))
+		return 0.0;
+
+	return ite_file->second[index];
+}
+
+// Largest grid the area statistics tables are built for, samples
+#define TERRAIN_STATS_MAX_SAMPLES 16777216
+
+// Most runs of grid indices along one side of a box the tables combine
+#define TERRAIN_STATS_MAX_RUNS 16
+
+// Rectangles of up to this many samples are summed directly
+#define TERRAIN_STATS_DIRECT_SAMPLES 4096
+
+/*
+ * Area statistics tables of a rows x cols grid of elevation samples.
+ *
+ * sum and sum_sq are (rows + 1) x (cols + 1) summed-area tables of the
+ * samples less ref and of their squares, so the sums over any rectangle
+ * take four reads.  min_tree and max_tree are min/max pyramids over
+ * dyadic blocks of rows and columns, stored as a 2D segment tree of
+ * (2 rows) x (2 cols) nodes whose leaves are the samples.  A rectangle
+ * is covered by at most 2 log2(rows) x 2 log2(cols) blocks.
+ */
+typedef struct _terrain_stats_grid_t {
+	int rows;
+	int cols;
+	double ref;
+	vector<double> sum;
+	vector<double> sum_sq;
+	vector<float> min_tree;
+	vector<float> max_tree;
+} terrain_stats_grid_t;
+
+// Statistics of a set of elevation samples
+typedef struct _terrain_stats_t {
+	double count;
+	double mean;
+	double m2;  // sum of squared deviations from the mean
+	double min;
+	double max;
+} terrain_stats_t;
+
+// Contiguous US grid of the loaded area.  Rows are latitude indices from
+// conusStatsLatIndex0, columns rounded longitudes from conusStatsLonIndex0
+// (see get_conus_longitude_index).
+static terrain_stats_grid_t conusTerrainStats;
+static int conusStatsLatIndex0 = 0;
+static int conusStatsLonIndex0 = 0;
+
+// Open terrain files, one row each
+static map<int, terrain_stats_grid_t> openTerrainStats;
+
+// Build the tables of a grid from its row-major samples, which are released
+static void build_terrain_stats_grid(const int rows, const int cols, vector<float>& samples, terrain_stats_grid_t* const grid) {
+	grid->rows = rows;
+	grid->cols = cols;
+
+	// Summing about the mean keeps the squares small
+	double total = 0;
+	for (size_t i = 0; i < samples.size(); i++)
+		total += samples[i];
+	grid->ref = (samples.size() > 0) ? total / samples.size() : 0;
+
+	// Entries are accumulated in extended precision and rounded once
+	const size_t stride = (size_t) cols + 1;
+	grid->sum.assign(((size_t) rows + 1) * stride, 0);
+	grid->sum_sq.assign(((size_t) rows + 1) * stride, 0);
+	vector<long double> columnSum(cols, 0);
+	vector<long double> columnSumSq(cols, 0);
+	for (int r = 0; r < rows; r++) {
+		long double rowSum = 0, rowSumSq = 0;
+		for (int c = 0; c < cols; c++) {
+			const double value = samples[(size_t) r * cols + c] - grid->ref;
+			const size_t node = (r + 1) * stride + c + 1;
+
+			rowSum += value;
+			rowSumSq += value * value;
+			columnSum[c] += rowSum;
+			columnSumSq[c] += rowSumSq;
+			grid->sum[node] = columnSum[c];
+			grid->sum_sq[node] = columnSumSq[c];
+		}
+	}
+
+	const size_t width = 2 * (size_t) cols;
+	grid->min_tree.assign(2 * (size_t) rows * width, 0);
+	grid->max_tree.assign(2 * (size_t) rows * width, 0);
+	for (int r = 0; r < rows; r++) {
+		for (int c = 0; c < cols; c++) {
+			const size_t node = ((size_t) rows + r) * width + cols + c;
+
+			grid->min_tree[node] = samples[(size_t) r * cols + c];
+			grid->max_tree[node] = samples[(size_t) r * cols + c];
+		}
+	}
+	vector<float>().swap(samples);
+
+	// Column blocks of each row, then row blocks
+	for (size_t a = rows; a < 2 * (size_t) rows; a++) {
+		for (size_t b = cols - 1; b > 0; b--) {
+			grid->min_tree[a * width + b] = std::min(grid->min_tree[a * width + 2 * b], grid->min_tree[a * width + 2 * b + 1]);
+			grid->max_tree[a * width + b] = std::max(grid->max_tree[a * width + 2 * b], grid->max_tree[a * width + 2 * b + 1]);
+		}
+	}
+	for (size_t a = rows - 1; a > 0; a--) {
+		for (size_t b = 1; b < width; b++) {
+			grid->min_tree[a * width + b] = std::min(grid->min_tree[2 * a * width + b], grid->min_tree[(2 * a + 1) * width + b]);
+			grid->max_tree[a * width + b] = std::max(grid->max_tree[2 * a * width + b], grid->max_tree[(2 * a + 1) * width + b]);
+		}
+	}
+}
+
+/*
+ * Build the area statistics tables of the terrain just loaded.  With the
+ * CIFP data the contiguous US grid is built over the load area; open
+ * terrain files get one row each.  Grids above TERRAIN_STATS_MAX_SAMPLES
+ * are skipped and their statistics sample the terrain directly.
+ */
+static void build_terrain_stats(double minLatDeg, double maxLatDeg, double minLonDeg, double maxLonDeg, const bool cifpExists) {
+	conusTerrainStats = terrain_stats_grid_t();
+	openTerrainStats.clear();
+
+	if (!cifpExists) {
+		for (map<int, vector<float>>::const_iterator ite = terrData.begin(); ite != terrData.end(); ++ite) {
+			if ((ite->second.size() == 0) || (ite->second.size() > TERRAIN_STATS_MAX_SAMPLES))
+				continue;
+
+			vector<float> samples(ite->second);
+			build_terrain_stats_grid(1, samples.size(), samples, &openTerrainStats[ite->first]);
+		}
+
+		return;
+	}
+
+	minLatDeg = std::max(minLatDeg, 23.937);
+	maxLatDeg = std::min(maxLatDeg, 48.808);
+	minLonDeg = std::max(minLonDeg, -125.185);
+	maxLonDeg = std::min(maxLonDeg, -64.765);
+	if ((minLatDeg > maxLatDeg) || (minLonDeg > maxLonDeg))
+		return;
+
+	const int latIndex0 = get_conus_latitude_index(minLatDeg);
+	const int lonIndex0 = (int) round((minLonDeg - 0.001) * 1000.0);
+	const int rows = get_conus_latitude_index(maxLatDeg) - latIndex0 + 1;
+	const int cols = (int) round((maxLonDeg - 0.001) * 1000.0) - lonIndex0 + 1;
+	if ((double) rows * cols > TERRAIN_STATS_MAX_SAMPLES) {
+		printf("Terrain area of %d x %d samples is too large for the area statistics tables\n", rows, cols);
+
+		return;
+	}
+
+	vector<float> samples((size_t) rows * cols);
+	for (int c = 0; c < cols; c++) {
+		const int longitudeIndex = get_conus_longitude_index(lonIndex0 + c);
+		for (int r = 0; r < rows; r++)
+			samples[(size_t) r * cols + c] = get_conus_sample(latIndex0 + r, longitudeIndex);
+	}
+
+	build_terrain_stats_grid(rows, cols, samples, &conusTerrainStats);
+	conusStatsLatIndex0 = latIndex0;
+	conusStatsLonIndex0 = lonIndex0;
+}
+
 JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_loadTerrainData
   (JNIEnv *jniEnv, jobject jobj, jdouble minLatDeg, jdouble maxLatDeg, jdouble minLonDeg, jdouble maxLonDeg, jboolean cifpExists) {
     int err = 0;
@@ -5460,6 +5817,7 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_loadTerrainData
 	string nameStr;
 	zip *z;
 	double bufferLat = minLatDeg;
+	const double bufferLon = minLonDeg;
 	vector<int> fileList;
 	
 	while (minLonDeg < maxLonDeg) {
@@ -5519,15 +5877,15 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_loadTerrainData
 			// Check if the entry exists in the zip file
 		    if (st.valid != 0) {
 				//Alloc memory for its uncompressed contents
-				contents = new char[st.size];
+				contents = new char[st.size + 1];
 
 				//Read the compressed file
 				f = zip_fopen(z, name, 0);
 
 				zip_fread(f, contents, st.size);
-				string str(contents);
+				contents[st.size] = '\0';
 
-				explode(str, '\n', fileList.at(j));
+				explode(contents, st.size, fileList.at(j));
 
 				zip_fclose(f);
 
@@ -5539,6 +5897,8 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_loadTerrainData
 
 	    zip_close(z);
 
+		build_terrain_stats(bufferLat, maxLatDeg, bufferLon, maxLonDeg, cifpExists);
+
 		terrDataLoaded = true;
 	}
 
@@ -5550,64 +5910,44 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_loadTerrainData
 }
 
 
-JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getElevation
-  (JNIEnv *jniEnv, jobject jobj, jdouble latitude, jdouble longitude, jboolean cifpExists) {
-  
-	double elevation = 0.0;
-	int latitudeDifferenceAcrossGrid, longitudeChangeFactor, a, b, latRange, lonDiff, index;
-	
+/*
+ * Elevation sample containing the position, ft, or 0 where no terrain is
+ * loaded.  Only reads the terrain maps, so it can run in parallel.
+ */
+static double lookup_terrain_elevation(const double latitude, const double longitude) {
+	map<int, vector<float>>::const_iterator ite_file = terrData.end();
+	size_t index = 0;
+
 	if ((latitude >= 23.937 && latitude <= 48.808) && (longitude >= -125.185 && longitude <= -64.765)) {
-	  	latitudeDifferenceAcrossGrid = 24872;
-		longitudeChangeFactor = (int) ((round((longitude - 0.001) * 1000.0) / 1000.0 - (-125.185)) / 0.001);
-	
-		if (longitudeChangeFactor < 0)
-			longitudeChangeFactor = 0;
-	
-		a = longitudeChangeFactor * latitudeDifferenceAcrossGrid + (int) ((latitude - 23.937) / 0.001);
-	
-		b = (int) floor(a / 50092208);
-		
-		if ((a - (b) * 50092208) < terrData[b].size()) {
-			try {
-				elevation = stod(terrData[b].at(a - (b) * 50092208)) * 100;
-			}
-			catch (const invalid_argument&) {
-		    }
-	    	catch (const std::out_of_range& e) {
-			}
-		}
+		return get_conus_sample(get_conus_latitude_index(latitude), get_conus_longitude_index(round((longitude - 0.001) * 1000.0)));
 	}
 	else if (((latitude >= 53.999 && latitude <= 72.000) && (longitude >= -169.000 && longitude <= -130.999))
 		 || ((latitude >= 18.999 && latitude <= 22.000) && (longitude >= -159.000 && longitude <= -154.999))
 	) {
-			
-		latRange = (int) (1.001 / 0.000925925926);
-		lonDiff = (int) ((longitude - floor(longitude)) / 0.000925925926);
-		index = lonDiff * latRange + (int) ((latitude - floor(latitude)) / 0.000925925926);
+		int latRange = (int) (1.001 / 0.000925925926);
+		int lonDiff = (int) ((longitude - floor(longitude)) / 0.000925925926);
 
-		if (index < terrData[usgsMetadata[trunc(latitude)]].size()) {
-			try {
-				elevation = stod(terrData[usgsMetadata[trunc(latitude)]].at(index)) * 100;
-			}
-			catch (const invalid_argument&) {
-		    }
-		    catch (const std::out_of_range& e) {
-			}
-		}
+		// Tiles without metadata read from file 0
+		map<int, int>::const_iterator ite_metadata = usgsMetadata.find(trunc(latitude));
+		ite_file = terrData.find((ite_metadata != usgsMetadata.end()) ? ite_metadata->second : 0);
+		index = lonDiff * latRange + (int) ((latitude - floor(latitude)) / 0.000925925926);
 
 	} else if ((latitude >= startLat && latitude <= endLat) && (longitude >= startLon && longitude <= endLon)) {
-		try {
-			elevation = stod(terrData[trunc(latitude)].at(floor((longitude - (startLon)) * 1/resolution))) * 100;
-		}
-		catch (const invalid_argument&) {
-    	}
-    	catch (const std::out_of_range& e) {
-		}
+		ite_file = terrData.find(trunc(latitude));
+		index = floor((longitude - (startLon)) * 1/resolution);
 	}
-	else
-		elevation = 0.0;
 
-	return elevation;
+	if ((ite_file == terrData.end()) || (index >= ite_file->second.size()))
+		return 0.0;
+
+	return ite_file->second[index];
+}
+
+JNIEXPORT jdouble JNICALL Java_com_osi_gnats_engine_CEngine_getElevation
+  (JNIEnv *jniEnv, jobject jobj, jdouble latitude, jdouble longitude, jboolean cifpExists) {
+	(void)cifpExists; // Kept for the Java signature, the loaded terrain is used
+
+	return lookup_terrain_elevation(latitude, longitude);
 
   }
 
@@ -5648,6 +5988,283 @@ JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getElevationMap
 	return retObj;
   }
 
+// Merge the statistics of count samples into stats
+static void add_terrain_stats(terrain_stats_t* const stats, const double count, const double mean, const double m2, const double min, const double max) {
+	if (count <= 0)
+		return;
+
+	if (stats->count == 0) {
+		stats->count = count;
+		stats->mean = mean;
+		stats->m2 = m2;
+		stats->min = min;
+		stats->max = max;
+
+		return;
+	}
+
+	const double total = stats->count + count;
+	const double delta = mean - stats->mean;
+
+	stats->mean += delta * count / total;
+	stats->m2 += m2 + delta * delta * stats->count * count / total;
+	stats->min = std::min(stats->min, min);
+	stats->max = std::max(stats->max, max);
+	stats->count = total;
+}
+
+/*
+ * Add the samples of rows r0..r1 and columns c0..c1 of the grid, each
+ * counted weight times.
+ */
+static void add_terrain_stats_rect(const terrain_stats_grid_t& grid, const int r0, const int r1, const int c0, const int c1,
+		const double weight, terrain_stats_t* const stats) {
+	const size_t stride = (size_t) grid.cols + 1;
+	const size_t width = 2 * (size_t) grid.cols;
+
+	const double cells = (double) (r1 - r0 + 1) * (c1 - c0 + 1);
+
+	// The table differences lose the low digits of small sums
+	if (cells <= TERRAIN_STATS_DIRECT_SAMPLES) {
+		double mean = 0, m2 = 0;
+		float min = FLT_MAX, max = -FLT_MAX;
+		for (int r = r0; r <= r1; r++) {
+			const float* samples = &grid.min_tree[((size_t) grid.rows + r) * width + grid.cols];
+			for (int c = c0; c <= c1; c++) {
+				mean += samples[c];
+				min = std::min(min, samples[c]);
+				max = std::max(max, samples[c]);
+			}
+		}
+		mean /= cells;
+		for (int r = r0; r <= r1; r++) {
+			const float* samples = &grid.min_tree[((size_t) grid.rows + r) * width + grid.cols];
+			for (int c = c0; c <= c1; c++)
+				m2 += (samples[c] - mean) * (samples[c] - mean);
+		}
+
+		add_terrain_stats(stats, weight * cells, mean, weight * m2, min, max);
+
+		return;
+	}
+
+	const double sum = grid.sum[(r1 + 1) * stride + c1 + 1] - grid.sum[r0 * stride + c1 + 1]
+			- grid.sum[(r1 + 1) * stride + c0] + grid.sum[r0 * stride + c0];
+	const double sum_sq = grid.sum_sq[(r1 + 1) * stride + c1 + 1] - grid.sum_sq[r0 * stride + c1 + 1]
+			- grid.sum_sq[(r1 + 1) * stride + c0] + grid.sum_sq[r0 * stride + c0];
+
+	float min = FLT_MAX;
+	float max = -FLT_MAX;
+	for (size_t a0 = r0 + grid.rows, a1 = r1 + grid.rows + 1; a0 < a1; a0 >>= 1, a1 >>= 1) {
+		size_t rowNodes[2];
+		int numRowNodes = 0;
+		if (a0 & 1)
+			rowNodes[numRowNodes++] = a0++;
+		if (a1 & 1)
+			rowNodes[numRowNodes++] = --a1;
+
+		for (int i = 0; i < numRowNodes; i++) {
+			const float* minRow = &grid.min_tree[rowNodes[i] * width];
+			const float* maxRow = &grid.max_tree[rowNodes[i] * width];
+			for (size_t b0 = c0 + grid.cols, b1 = c1 + grid.cols + 1; b0 < b1; b0 >>= 1, b1 >>= 1) {
+				if (b0 & 1) {
+					min = std::min(min, minRow[b0]);
+					max = std::max(max, maxRow[b0]);
+					b0++;
+				}
+				if (b1 & 1) {
+					b1--;
+					min = std::min(min, minRow[b1]);
+					max = std::max(max, maxRow[b1]);
+				}
+			}
+		}
+	}
+
+	add_terrain_stats(stats, weight * cells, grid.ref + sum / cells,
+			weight * std::max(0.0, sum_sq - sum * sum / cells), min, max);
+}
+
+/*
+ * Positions getElevationAreaStats samples from minDeg while below maxDeg.
+ * The step is added to the position each time, as the direct loop does,
+ * so the positions carry the same rounding.  Returns false when there are
+ * more than maxCount.
+ */
+static bool get_terrain_sample_positions(double minDeg, const double maxDeg, const double step, const size_t maxCount,
+		vector<double>& positions) {
+	positions.clear();
+
+	while (minDeg < maxDeg) {
+		if (positions.size() == maxCount)
+			return false;
+
+		positions.push_back(minDeg);
+		minDeg += step;
+	}
+
+	return true;
+}
+
+// Grid indices first..last, each sampled weight times
+typedef struct _terrain_stats_run_t {
+	int first;
+	int last;
+	int weight;
+} terrain_stats_run_t;
+
+/*
+ * Group the grid indices of the positions along one side into runs.  A
+ * position rounding onto the cell edge can repeat or skip an index, which
+ * starts a new run.  Returns false above TERRAIN_STATS_MAX_RUNS runs.
+ */
+static bool get_terrain_index_runs(const vector<int>& indices, vector<terrain_stats_run_t>& runs) {
+	runs.clear();
+
+	size_t k = 0;
+	while (k < indices.size()) {
+		size_t k1 = k + 1;
+		while ((k1 < indices.size()) && (indices[k1] == indices[k]))
+			k1++;
+
+		const int weight = (int) (k1 - k);
+		if (!runs.empty() && (runs.back().last + 1 == indices[k]) && (runs.back().weight == weight)) {
+			runs.back().last = indices[k];
+		} else {
+			if (runs.size() == TERRAIN_STATS_MAX_RUNS)
+				return false;
+
+			terrain_stats_run_t run = {indices[k], indices[k], weight};
+			runs.push_back(run);
+		}
+
+		k = k1;
+	}
+
+	return true;
+}
+
+// Whether the rectangles [lat0, lat1] x [lon0, lon1] and [a0, a1] x [b0, b1] intersect
+static bool terrain_area_overlaps(const double lat0, const double lat1, const double lon0, const double lon1,
+		const double a0, const double a1, const double b0, const double b1) {
+	return (lat0 <= a1) && (lat1 >= a0) && (lon0 <= b1) && (lon1 >= b0);
+}
+
+/*
+ * Statistics of the samples getElevationAreaStats takes, read from the
+ * area statistics tables.  The sample positions along each side are
+ * replayed and mapped to grid indices as getElevation does, which costs
+ * one step per row and column; the statistics then take time independent
+ * of the area.  Returns false when the tables do not cover the samples,
+ * which are then read one by one.
+ *
+ * Open terrain holds one row of samples per degree of latitude, so each
+ * file row is weighted by the number of latitude samples falling in it.
+ */
+static bool get_terrain_area_stats(const double minLatDeg, const double maxLatDeg, const double minLonDeg, const double maxLonDeg,
+		const bool cifpExists, terrain_stats_t* const stats) {
+	const double step = cifpExists ? 0.001 : resolution;
+	if (!(step > 0))
+		return false;
+
+	vector<double> latitudes;
+	vector<double> longitudes;
+	if (!get_terrain_sample_positions(minLatDeg, maxLatDeg, step, TERRAIN_STATS_MAX_SAMPLES, latitudes)
+			|| !get_terrain_sample_positions(minLonDeg, maxLonDeg, step, TERRAIN_STATS_MAX_SAMPLES, longitudes)
+			|| latitudes.empty() || longitudes.empty())
+		return false;
+
+	const double firstLat = latitudes.front();
+	const double lastLat = latitudes.back();
+	const double firstLon = longitudes.front();
+	const double lastLon = longitudes.back();
+
+	vector<int> latIndices(latitudes.size());
+	vector<int> lonIndices(longitudes.size());
+	vector<terrain_stats_run_t> rowRuns;
+	vector<terrain_stats_run_t> colRuns;
+
+	memset(stats, 0, sizeof(terrain_stats_t));
+
+	if (cifpExists) {
+		if ((conusTerrainStats.rows == 0)
+				|| !((firstLat >= 23.937 && lastLat <= 48.808) && (firstLon >= -125.185 && lastLon <= -64.765)))
+			return false;
+
+		for (size_t i = 0; i < latitudes.size(); i++)
+			latIndices[i] = get_conus_latitude_index(latitudes[i]) - conusStatsLatIndex0;
+		for (size_t j = 0; j < longitudes.size(); j++)
+			lonIndices[j] = (int) round((longitudes[j] - 0.001) * 1000.0) - conusStatsLonIndex0;
+
+		if (!get_terrain_index_runs(latIndices, rowRuns) || !get_terrain_index_runs(lonIndices, colRuns))
+			return false;
+
+		for (size_t a = 0; a < rowRuns.size(); a++) {
+			if ((rowRuns[a].first < 0) || (rowRuns[a].last >= conusTerrainStats.rows))
+				return false;
+		}
+		for (size_t b = 0; b < colRuns.size(); b++) {
+			if ((colRuns[b].first < 0) || (colRuns[b].last >= conusTerrainStats.cols))
+				return false;
+		}
+
+		for (size_t a = 0; a < rowRuns.size(); a++) {
+			for (size_t b = 0; b < colRuns.size(); b++) {
+				add_terrain_stats_rect(conusTerrainStats, rowRuns[a].first, rowRuns[a].last, colRuns[b].first, colRuns[b].last,
+						(double) rowRuns[a].weight * colRuns[b].weight, stats);
+			}
+		}
+
+		return true;
+	}
+
+	if (!((firstLat >= startLat && lastLat <= endLat) && (firstLon >= startLon && lastLon <= endLon)))
+		return false;
+
+	// Samples inside the USGS regions read those grids instead
+	if (terrain_area_overlaps(firstLat, lastLat, firstLon, lastLon, 23.937, 48.808, -125.185, -64.765)
+			|| terrain_area_overlaps(firstLat, lastLat, firstLon, lastLon, 53.999, 72.000, -169.000, -130.999)
+			|| terrain_area_overlaps(firstLat, lastLat, firstLon, lastLon, 18.999, 22.000, -159.000, -154.999))
+		return false;
+
+	for (size_t i = 0; i < latitudes.size(); i++)
+		latIndices[i] = (int) trunc(latitudes[i]);
+	for (size_t j = 0; j < longitudes.size(); j++)
+		lonIndices[j] = (int) floor((longitudes[j] - (startLon)) * 1/resolution);
+
+	if (!get_terrain_index_runs(latIndices, rowRuns) || !get_terrain_index_runs(lonIndices, colRuns))
+		return false;
+
+	for (size_t a = 0; a < rowRuns.size(); a++) {
+		for (int band = rowRuns[a].first; band <= rowRuns[a].last; band++) {
+			const terrain_stats_grid_t* grid = NULL;
+			if (terrData.find(band) != terrData.end()) {
+				map<int, terrain_stats_grid_t>::const_iterator ite_grid = openTerrainStats.find(band);
+				if (ite_grid == openTerrainStats.end())
+					return false;
+
+				grid = &ite_grid->second;
+			}
+
+			for (size_t b = 0; b < colRuns.size(); b++) {
+				const double weight = (double) rowRuns[a].weight * colRuns[b].weight;
+
+				int numCovered = 0;
+				if (grid != NULL) {
+					numCovered = std::max(0, std::min(colRuns[b].last, grid->cols - 1) - colRuns[b].first + 1);
+					if (numCovered > 0)
+						add_terrain_stats_rect(*grid, 0, 0, colRuns[b].first, colRuns[b].first + numCovered - 1, weight, stats);
+				}
+
+				// Samples past the end of the file read 0
+				add_terrain_stats(stats, weight * (colRuns[b].last - colRuns[b].first + 1 - numCovered), 0, 0, 0, 0);
+			}
+		}
+	}
+
+	return (stats->count > 0);
+}
+
 // Returns min, max, mean, variance, st dev
 JNIEXPORT jdoubleArray JNICALL Java_com_osi_gnats_engine_CEngine_getElevationAreaStats
   (JNIEnv *jniEnv, jobject jobj, jdouble minLatDeg, jdouble maxLatDeg, jdouble minLonDeg, jdouble maxLonDeg, jboolean cifpExists) {
@@ -5656,6 +6273,17 @@ JNIEXPORT jdoubleArray JNICALL Java_com_osi_gnats_engine_CEngine_getElevationAre
 	double bufferLat = minLatDeg;
 	vector<double> gridElevation;
 
+	terrain_stats_t stats;
+	if (get_terrain_area_stats(minLatDeg, maxLatDeg, minLonDeg, maxLonDeg, cifpExists, &stats)) {
+		variance = stats.m2 / stats.count;
+		double retArray[5] = {stats.min, stats.max, stats.mean, variance, sqrt(variance)};
+
+		jdoubleArray retObj = jniEnv->NewDoubleArray(5);
+		jniEnv->SetDoubleArrayRegion(retObj, (jsize) 0, (jsize) 5, (jdouble*) retArray);
+
+		return retObj;
+	}
+
 	// Get all elevation data points
 	while (minLonDeg < maxLonDeg) {
 		minLatDeg = bufferLat;
@@ -5711,28 +6339,115 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_clearTerrainData
   	terrDataLoaded = false;	
   	terrData.clear();
   	usgsMetadata.clear();
+  	conusTerrainStats = terrain_stats_grid_t();
+  	openTerrainStats.clear();
   	
   	return 0;
   	
   }
 
 
-JNIEXPORT jdoubleArray JNICALL Java_com_osi_gnats_engine_CEngine_getLineOfSight
-  (JNIEnv *jniEnv, jobject jobj, jdouble observerLat, jdouble observerLon, jdouble observerAlt, jdouble targetLat, jdouble targetLon, jdouble targetAlt, jboolean cifpExists) {
+// Rounding allowance of the chord heights, ft
+#define LINE_OF_SIGHT_HEIGHT_TOLERANCE_FT 0.001
 
+// Sample grid of the terrain data, degrees
+typedef struct _terrain_grid_t {
+	double lat0;
+	double lon0;
+	double dlat;
+	double dlon;
+} terrain_grid_t;
+
+/*
+ * Sample grid of the terrain region containing the position.  Cell (i, j)
+ * spans [lat0 + i*dlat, lat0 + (i+1)*dlat) by [lon0 + j*dlon, lon0 + (j+1)*dlon)
+ * and holds the sample lookup_terrain_elevation() returns anywhere inside
+ * it.  Returns false outside all regions.
+ */
+static bool get_terrain_grid(const double latitude, const double longitude, terrain_grid_t* const grid) {
+	if ((latitude >= 23.937 && latitude <= 48.808) && (longitude >= -125.185 && longitude <= -64.765)) {
+		// Longitudes are rounded to the nearest 0.001 degree
+		grid->lat0 = 23.937;
+		grid->lon0 = -125.1845;
+		grid->dlat = 0.001;
+		grid->dlon = 0.001;
+	}
+	else if (((latitude >= 53.999 && latitude <= 72.000) && (longitude >= -169.000 && longitude <= -130.999))
+		 || ((latitude >= 18.999 && latitude <= 22.000) && (longitude >= -159.000 && longitude <= -154.999))
+	) {
+		grid->lat0 = 0;
+		grid->lon0 = 0;
+		grid->dlat = 0.000925925926;
+		grid->dlon = 0.000925925926;
+	} else if ((latitude >= startLat && latitude <= endLat) && (longitude >= startLon && longitude <= endLon)) {
+		// One file per whole degree of latitude
+		grid->lat0 = 0;
+		grid->lon0 = startLon;
+		grid->dlat = 1.0;
+		grid->dlon = resolution;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Height of the observer-target chord above the sphere of the given radius
+ * at ground angle phi from the observer.  r1 and r2 are the distances of
+ * the observer and the target from the center and theta the ground angle
+ * between them.
+ */
+static inline double get_chord_height(const double r1, const double r2, const double theta, const double phi, const double radius) {
+	return r1 * r2 * sin(theta) / (r1 * sin(phi) + r2 * sin(theta - phi)) - radius;
+}
+
+/*
+ * Lowest chord height over the ground angles [phi_begin, phi_end].  The
+ * distance of the chord from the center is convex in phi, so the minimum
+ * is at its stationary point clamped to the interval.
+ */
+static double get_min_chord_height(const double r1, const double r2, const double theta, const double phi_begin, const double phi_end, const double radius) {
+	double phi = atan2(r1 - r2 * cos(theta), r2 * sin(theta));
+	phi = min(phi_end, max(phi_begin, phi));
+
+	return get_chord_height(r1, r2, theta, phi, radius);
+}
+
+/*
+ * Range (ft), azimuth (deg), elevation (deg) and masking of the target
+ * seen from the observer.  Masking is 2 when the line of sight passes below
+ * sea level, else 1 when it passes below the terrain, else 0.
+ *
+ * The line of sight is the straight chord between the two positions.
+ * Refraction is modeled by an effective Earth radius of refraction_factor
+ * times the true radius (4/3 for the standard atmosphere, 1 for none).
+ *
+ * The ground track is straight in latitude/longitude, as is the terrain
+ * grid, and is walked cell by cell on the grid of the region holding the
+ * observer (or the target), so no terrain cell crossed by the track is
+ * skipped.  Each cell is tested against the lowest chord height over the
+ * part of the track inside it.  The cells holding the observer and the
+ * target are not tested: both are taken to be above their own terrain.
+ */
+static void compute_line_of_sight(double observerLat, double observerLon, const double observerAlt,
+		double targetLat, double targetLon, const double targetAlt,
+		const double refraction_factor,
+		double* const retVal) {
+	const double observerLatDeg = observerLat;
+	const double observerLonDeg = observerLon;
+	const double targetLatDeg = targetLat;
+	const double targetLonDeg = targetLon;
 
-	// Returns an array of (Range, Azimuth, Elevation, Masking)
-	double retVal[] = {0, 0, 0, 0};
-	
 	// Radius of Earth in ft
 	double R = 20902230.97;
-	
+
 	// Convert latitude/longitude to radian
 	observerLat = observerLat * (PI / 180);
 	observerLon = observerLon * (PI / 180);
 	targetLat = targetLat * (PI / 180);
 	targetLon = targetLon * (PI / 180);
-	
+
 	// Transform Lat, Lon, Alt positinos of observer and target to geoinertial frame
 	double xt = (R + targetAlt) * cos(targetLat) * cos(targetLon);
 	double yt = (R + targetAlt) * cos(targetLat) * sin(targetLon);
@@ -5745,59 +6460,111 @@ JNIEXPORT jdoubleArray JNICALL Java_com_osi_gnats_engine_CEngine_getLineOfSight
 	double dxo = xo - xt;
 	double dyo = yo - yt;
 	double dzo = zo - zt;
-	
+
 	// Get transformed relative vector to observer's topocentric frame
 	double xl = dxo * sin(observerLat) * cos(observerLon) + dyo * sin(observerLat) * sin(observerLon) - dzo * cos(observerLat);
 	double yl = -dxo * sin(observerLat) + dyo * cos(observerLat);
 	double zl = dxo * cos(observerLat) * cos(observerLon) + dyo * cos(observerLat) * sin(observerLon) + dzo * sin(observerLat);
-	
-	
+
 	// Calculate Range
 	retVal[0] = sqrt(xl * xl + yl * yl + zl * zl);
-	
+
 	// Calculate Azimuth
 	retVal[1] = atan2((sin(targetLon - observerLon) * cos(targetLat)), (cos(observerLat) * sin(targetLat) - sin(observerLat) * cos(targetLat) * cos(targetLon - observerLon))) * 180.0 / PI;
-	
+
 	// Calculate Elevation
 	retVal[2] = zl / sqrt(xl * xl + yl * yl) * 180.0 / PI;
-	
-	double startLat = observerLat;
-	double endLat = targetLat;
-	double startLon = observerLon;
-	double endLon = targetLon;
 
-	if(startLat > targetLat) {
-		startLat = targetLat;
-		endLat = observerLat;
-		startLon = targetLon;
-		endLon = observerLon;
-	}
-	
-	startLat *= 180.0 / PI;
-	endLat *= 180.0 / PI;
-	startLon *= 180.0 / PI;
-	endLon *= 180.0 / PI;
-	int altCount = (int)((endLat - startLat) / 0.01);
-	
-	double buffAlt = observerAlt;
-	if(buffAlt > targetAlt)
-		buffAlt = targetAlt;
-			
-	double slope = (endLon - startLon) / (endLat - startLat);
-	while(startLat < endLat) {
-		double newLon = slope * startLat - slope * observerLat * 180.0 / PI+ observerLon * 180.0 / PI;
-		if(Java_com_osi_gnats_engine_CEngine_getElevation(jniEnv, jobj, startLat, newLon, cifpExists) > buffAlt)
+	retVal[3] = 0;
+
+	// Ground angle between observer and target
+	double sinHalfLat = sin((targetLat - observerLat) / 2);
+	double sinHalfLon = sin((targetLon - observerLon) / 2);
+	double theta = 2 * asin(min(1.0, sqrt(sinHalfLat * sinHalfLat + cos(observerLat) * cos(targetLat) * sinHalfLon * sinHalfLon)));
+	if (theta <= 0)
+		return;
+
+	// The effective Earth keeps the ground distance, so its ground angle
+	// shrinks by the refraction factor
+	double Re = R * refraction_factor;
+	double r1 = Re + observerAlt;
+	double r2 = Re + targetAlt;
+	theta /= refraction_factor;
+
+	// Earth curvature.  Positions below sea level are not masked by their
+	// own depth.
+	if (get_min_chord_height(r1, r2, theta, 0, theta, Re) < min(0.0, min(observerAlt, targetAlt)) - LINE_OF_SIGHT_HEIGHT_TOLERANCE_FT) {
+		retVal[3] = 2;
+
+		return;
+	}
+
+	if (!terrDataLoaded)
+		return;
+
+	terrain_grid_t grid;
+	if ((!get_terrain_grid(observerLatDeg, observerLonDeg, &grid))
+			&& (!get_terrain_grid(targetLatDeg, targetLonDeg, &grid)))
+		return;
+
+	// Walk the cells crossed by the track, parameterized by s in [0, 1]
+	double u0 = (observerLatDeg - grid.lat0) / grid.dlat;
+	double v0 = (observerLonDeg - grid.lon0) / grid.dlon;
+	double du = (targetLatDeg - observerLatDeg) / grid.dlat;
+	double dv = (targetLonDeg - observerLonDeg) / grid.dlon;
+
+	long i = (long)floor(u0);
+	long j = (long)floor(v0);
+	const long i_observer = i;
+	const long j_observer = j;
+	const long i_target = (long)floor(u0 + du);
+	const long j_target = (long)floor(v0 + dv);
+
+	const long step_i = (du > 0) ? 1 : -1;
+	const long step_j = (dv > 0) ? 1 : -1;
+	const double delta_s_i = (du != 0) ? fabs(1.0 / du) : DBL_MAX;
+	const double delta_s_j = (dv != 0) ? fabs(1.0 / dv) : DBL_MAX;
+	double next_s_i = (du != 0) ? ((i + (du > 0 ? 1 : 0)) - u0) / du : DBL_MAX;
+	double next_s_j = (dv != 0) ? ((j + (dv > 0 ? 1 : 0)) - v0) / dv : DBL_MAX;
+
+	const long max_cells = labs(i_target - i_observer) + labs(j_target - j_observer) + 1;
+
+	double s_begin = 0;
+	for (long cnt_cell = 0; cnt_cell < max_cells; cnt_cell++) {
+		double s_end = min(1.0, min(next_s_i, next_s_j));
+
+		if (((i != i_observer) || (j != j_observer)) && ((i != i_target) || (j != j_target))) {
+			double elevation = lookup_terrain_elevation(grid.lat0 + (i + 0.5) * grid.dlat, grid.lon0 + (j + 0.5) * grid.dlon);
+			if (elevation > get_min_chord_height(r1, r2, theta, s_begin * theta, s_end * theta, Re)) {
 				retVal[3] = 1;
-			buffAlt += abs(observerAlt - targetAlt) / altCount;
 
-		startLat += 0.01;
-	}
+				return;
+			}
+		}
 
-	if (retVal[3] == 0) {
-		if(retVal[2] < asin(R / ((R + observerAlt)) * 180.0 / PI))
-			retVal[3] = 2;
+		if (s_end >= 1.0)
+			break;
+
+		s_begin = s_end;
+		if (next_s_i < next_s_j) {
+			i += step_i;
+			next_s_i += delta_s_i;
+		} else {
+			j += step_j;
+			next_s_j += delta_s_j;
+		}
 	}
-	
+}
+
+JNIEXPORT jdoubleArray JNICALL Java_com_osi_gnats_engine_CEngine_getLineOfSight
+  (JNIEnv *jniEnv, jobject jobj, jdouble observerLat, jdouble observerLon, jdouble observerAlt, jdouble targetLat, jdouble targetLon, jdouble targetAlt, jboolean cifpExists) {
+	(void)cifpExists; // Kept for the Java signature, the loaded terrain is used
+
+	// Returns an array of (Range, Azimuth, Elevation, Masking)
+	double retVal[] = {0, 0, 0, 0};
+
+	compute_line_of_sight(observerLat, observerLon, observerAlt, targetLat, targetLon, targetAlt, 1.0, retVal);
+
 	jclass doubleArrayClass = jniEnv->FindClass("[D");
     jdoubleArray retObj = jniEnv->NewDoubleArray(4);
     jniEnv->SetDoubleArrayRegion(retObj, (jsize) 0, (jsize) 4, (jdouble*) retVal);
@@ -5806,3 +6573,65 @@ JNIEXPORT jdoubleArray JNICALL Java_com_osi_gnats_engine_CEngine_getLineOfSight
 
   }
 
+static bool get_line_of_sight_position(JNIEnv *jniEnv, jobjectArray j_positions, const int index, double* const position) {
+	jdoubleArray j_row = (jdoubleArray)jniEnv->GetObjectArrayElement(j_positions, index);
+	if ((j_row == NULL) || (jniEnv->GetArrayLength(j_row) < 3))
+		return false;
+
+	jniEnv->GetDoubleArrayRegion(j_row, 0, 3, position);
+	jniEnv->DeleteLocalRef(j_row);
+
+	return true;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getLineOfSight_1batch
+  (JNIEnv *jniEnv, jobject jobj, jobjectArray j_observers, jobjectArray j_targets, jdouble refractionFactor, jboolean cifpExists) {
+	(void)cifpExists; // Kept for the Java signature, the loaded terrain is used
+
+	jobjectArray retArray = NULL;
+
+	if ((j_observers == NULL) || (j_targets == NULL) || (refractionFactor <= 0))
+		return retArray;
+
+	const int cnt_observer = jniEnv->GetArrayLength(j_observers);
+	const int cnt_target = jniEnv->GetArrayLength(j_targets);
+
+	// {latitude_deg, longitude_deg, altitude_ft}, NaN for missing rows
+	vector<double> c_observers(3 * cnt_observer, NAN);
+	vector<double> c_targets(3 * cnt_target, NAN);
+	for (int i = 0; i < cnt_observer; i++) {
+		get_line_of_sight_position(jniEnv, j_observers, i, &c_observers[3 * i]);
+	}
+	for (int i = 0; i < cnt_target; i++) {
+		get_line_of_sight_position(jniEnv, j_targets, i, &c_targets[3 * i]);
+	}
+
+	const long cnt_pair = (long)cnt_observer * cnt_target;
+	vector<double> c_results(4 * cnt_pair, NAN);
+
+#pragma omp parallel for schedule(dynamic, 16)
+	for (long k = 0; k < cnt_pair; k++) {
+		const double* observer = &c_observers[3 * (k / cnt_target)];
+		const double* target = &c_targets[3 * (k % cnt_target)];
+		if (std::isnan(observer[0]) || std::isnan(target[0]))
+			continue;
+
+		compute_line_of_sight(observer[0], observer[1], observer[2],
+				target[0], target[1], target[2],
+				refractionFactor,
+				&c_results[4 * k]);
+	}
+
+	jclass jcls_DoubleArray = jniEnv->FindClass("[D");
+
+	// Row (observer index * number of targets + target index) holds (Range, Azimuth, Elevation, Masking)
+	retArray = (jobjectArray)jniEnv->NewObjectArray(cnt_pair, jcls_DoubleArray, NULL);
+	for (long k = 0; k < cnt_pair; k++) {
+		jdoubleArray j_row = jniEnv->NewDoubleArray(4);
+		jniEnv->SetDoubleArrayRegion(j_row, 0, 4, &c_results[4 * k]);
+		jniEnv->SetObjectArrayElement(retArray, k, j_row);
+		jniEnv->DeleteLocalRef(j_row);
+	}
+
+	return retArray;
+}
@@ -119,6 +119,78 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_propagate_1flights__FFF
 JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableConflictDetectionAndResolution
   (JNIEnv *, jobject, jboolean);
 
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    enableSteadyStepSkip
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableSteadyStepSkip
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    enableCruiseFastForward
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableCruiseFastForward
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    enableTrafficMetrics
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableTrafficMetrics
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    setTrafficMetricsConfig
+ * Signature: (F[Ljava/lang/String;[Ljava/lang/String;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_setTrafficMetricsConfig
+  (JNIEnv *, jobject, jfloat, jobjectArray, jobjectArray, jstring);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    getSectorTrafficMetrics
+ * Signature: (Ljava/lang/String;)[[D
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getSectorTrafficMetrics
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    getAirportTrafficMetrics
+ * Signature: (Ljava/lang/String;)[[D
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAirportTrafficMetrics
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    writeTrafficMetrics
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_writeTrafficMetrics
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    enableWakeVortexModel
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enableWakeVortexModel
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    getWakeEncounters
+ * Signature: ()[[D
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getWakeEncounters
+  (JNIEnv *, jobject);
+
 /*
  * Class:     com_osi_gnats_engine_CEngine
  * Method:    getCDR_status
@@ -311,6 +383,38 @@ JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_write_1trajectories
 JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_clear_1trajectories
   (JNIEnv *, jobject);
 
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    save_checkpoint
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_save_1checkpoint
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    load_checkpoint
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_load_1checkpoint
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    enable_propagation_profiling
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_com_osi_gnats_engine_CEngine_enable_1propagation_1profiling
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    get_propagation_profile_report
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_com_osi_gnats_engine_CEngine_get_1propagation_1profile_1report
+  (JNIEnv *, jobject);
+
 /*
  * Class:     com_osi_gnats_engine_CEngine
  * Method:    request_aircraft
@@ -567,6 +671,22 @@ JNIEXPORT jstring JNICALL Java_com_osi_gnats_engine_CEngine_getClosestAirport
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAirportsWithinMiles
   (JNIEnv *, jobject, jdouble, jdouble, jdouble);
 
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    getClosestAirport_batch
+ * Signature: ([D[D)[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getClosestAirport_1batch
+  (JNIEnv *, jobject, jdoubleArray, jdoubleArray);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    getAirportsWithinMiles_batch
+ * Signature: ([D[DD)[[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getAirportsWithinMiles_1batch
+  (JNIEnv *, jobject, jdoubleArray, jdoubleArray, jdouble);
+
 /*
  * Class:     com_osi_gnats_engine_CEngine
  * Method:    getFullName
@@ -1071,6 +1191,22 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_setSampleWeatherHazard
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_calculateRisk
   (JNIEnv *, jobject, jstring, jboolean);
 
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    calculateRisk_codes
+ * Signature: ()[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_calculateRisk_1codes
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    calculateRisk_batch
+ * Signature: ([Ljava/lang/String;[[D[Ljava/lang/String;[[D)[[D
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_calculateRisk_1batch
+  (JNIEnv *, jobject, jobjectArray, jobjectArray, jobjectArray, jobjectArray);
+
 /*
  * Class:     com_osi_gnats_engine_CEngine
  * Method:    setRegionOfRegard
@@ -1239,6 +1375,14 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_load_1groundVehicle
 JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_release_1groundVehicle
   (JNIEnv *, jobject);
 
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    getClosestPointsOfApproach
+ * Signature: (D)[[D
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getClosestPointsOfApproach
+  (JNIEnv *, jobject, jdouble);
+
 /*
  * Class:     com_osi_gnats_engine_CEngine
  * Method:    getAllGroundVehicleIds
@@ -1311,6 +1455,14 @@ JNIEXPORT jstring JNICALL Java_com_osi_gnats_engine_CEngine_getCurrentCenter
 JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getFixesInCenter
   (JNIEnv *, jobject, jstring);
 
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    getCenterTrafficCount
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_getCenterTrafficCount
+  (JNIEnv *, jobject, jstring);
+
 /*
  * Class:     com_osi_gnats_engine_CEngine
  * Method:    setGroundOperatorAbsence
@@ -1407,6 +1559,14 @@ JNIEXPORT jint JNICALL Java_com_osi_gnats_engine_CEngine_setRadarError
 JNIEXPORT jdoubleArray JNICALL Java_com_osi_gnats_engine_CEngine_getLineOfSight
   (JNIEnv *, jobject, jdouble, jdouble, jdouble, jdouble, jdouble, jdouble, jboolean);
 
+/*
+ * Class:     com_osi_gnats_engine_CEngine
+ * Method:    getLineOfSight_batch
+ * Signature: ([[D[[DDZ)[[D
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_osi_gnats_engine_CEngine_getLineOfSight_1batch
+  (JNIEnv *, jobject, jobjectArray, jobjectArray, jdouble, jboolean);
+
 /*
  * Class:     com_osi_gnats_engine_CEngine
  * Method:    setNavigationLocationError
@@ -144,6 +144,58 @@ public class CEngine {
 	
 	public native void enableConflictDetectionAndResolution(boolean flag);
 	
+	/**
+	 * Skip the processing of flights taxiing or flying enroute in a steady
+	 * phase on a few of their time steps, away from waypoints and altitude
+	 * events.  The time steps themselves do not change: the skipped steps
+	 * still move the flights and keep their speeds and rates.  States stay synchronized at every output time; the estimated
+	 * difference to fixed stepping is logged at the INFO level when the
+	 * propagation completes.
+	 */
+	public native void enableSteadyStepSkip(boolean flag);
+	
+	/**
+	 * Let flights in steady cruise move in closed form along the great
+	 * circle to their next waypoint instead of being processed every step.
+	 * Changes trajectories slightly; the estimated error is logged at the
+	 * INFO level when the propagation completes.
+	 */
+	public native void enableCruiseFastForward(boolean flag);
+	
+	public native void enableTrafficMetrics(boolean flag);
+	
+	/**
+	 * Set the time bin length and the sectors and airports whose traffic
+	 * metrics are collected; null or empty arrays select all of them.  When
+	 * outputFile is set, the metrics are written to it (CSV, or HDF5 for
+	 * ".h5") at the end of the run.  Applies from the next propagation.
+	 */
+	public native int setTrafficMetricsConfig(float binSec, String[] sectorNames, String[] airportCodes, String outputFile);
+	
+	/**
+	 * Traffic metrics of a sector collected so far.
+	 * Each row is {bin start time sec, entries, peak aircraft count,
+	 * mean aircraft count}.
+	 */
+	public native double[][] getSectorTrafficMetrics(String sectorName);
+	
+	/**
+	 * Traffic metrics of an airport collected so far.
+	 * Each row is {bin start time sec, departures, arrivals}.
+	 */
+	public native double[][] getAirportTrafficMetrics(String airportCode);
+	
+	public native int writeTrafficMetrics(String outputFile);
+	
+	public native void enableWakeVortexModel(boolean flag);
+	
+	/**
+	 * Wake encounters recorded since the simulation started.
+	 * Each row is {time sec, follower flight index, generator flight index,
+	 * circulation m^2/sec, lateral distance ft, vertical distance ft}.
+	 */
+	public native double[][] getWakeEncounters();
+	
 	public native Object[][] getCDR_status();
 	
 	public native void setCDR_initiation_distance_ft_surface(float distance);
@@ -192,6 +244,14 @@ public class CEngine {
 	
 	public native void clear_trajectories();
 
+	public native int save_checkpoint(String checkpoint_file);
+
+	public native int load_checkpoint(String checkpoint_file);
+
+	public native void enable_propagation_profiling(boolean flag);
+
+	public native String get_propagation_profile_report();
+
 	public native void request_aircraft(String assignedAuthId, String ac_id);
 	
 	public native void request_groundVehicle(String assignedAuthId, String gv_id);
@@ -285,6 +345,10 @@ public class CEngine {
 	
 	public native String[] getAirportsWithinMiles(double latitude_deg, double longitude_deg, double miles);
 	
+	public native String[] getClosestAirport_batch(double[] latitude_deg, double[] longitude_deg);
+	
+	public native String[][] getAirportsWithinMiles_batch(double[] latitude_deg, double[] longitude_deg, double miles);
+	
 	public native String getFullName(String airport_code);
 	
 	public native Object[] getAllRunways(String airport_code);
@@ -432,6 +496,10 @@ public class CEngine {
 		
 	public native String[] calculateRisk(String flightData, boolean cifpExists);
 	
+	public native String[] calculateRisk_codes();
+	
+	public native double[][] calculateRisk_batch(String[] aircraftIds1, double[][] states1, String[] aircraftIds2, double[][] states2);
+	
 	public native int setRegionOfRegard(String aircraft, double[] regionBounds);
 	
 	public native double[][] getRegionOfRegard(String aircraft);
@@ -470,6 +538,13 @@ public class CEngine {
 	
 	public native double getRateOfApproachToRunwayThreshold(String aircraftID, int timesteps);
 	
+	/**
+	 * Closest point of approach of all aircraft pairs within radiusFt slant range.
+	 * Each row is {flight index 1, flight index 2, range ft, time to CPA sec,
+	 * range at CPA ft, closure rate ft/sec, line of sight rate rad/sec}.
+	 */
+	public native double[][] getClosestPointsOfApproach(double radiusFt);
+	
 	// ==================== GNATS GroundVehicle Functions ===================
 	
 	public native int load_groundVehicle(String trx_file);
@@ -495,6 +570,8 @@ public class CEngine {
 	public native String getCurrentCenter(String aircraftId);
 	
 	public native String[] getFixesInCenter(String centerId);
+	
+	public native int getCenterTrafficCount(String centerId);
 		
 	// ==================== GNATS GroundOperator Functions ===================
 	
@@ -526,5 +603,7 @@ public class CEngine {
 
 	public native double[] getLineOfSight(double observerLat, double observerLon, double observerAlt, double targetLat, double targetLon, double targetAlt, boolean cifpExists);
 
+	public native double[][] getLineOfSight_batch(double[][] observers, double[][] targets, double refractionFactor, boolean cifpExists);
+
 	public native int setNavigationLocationError(int sessionId, String aircraftId, String parameter, double bias, double drift, double scaleFactor, double noiseVariance, int scope);
 }
@@ -29,14 +29,9 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 package com.osi.gnats.server;
 
 import com.osi.gnats.rmi.*;
-import java.io.BufferedReader;
 import java.util.*;
-import java.io.FileReader;
-import java.io.IOException;
 
-import com.osi.gnats.aircraft.Aircraft;
 import java.rmi.*;
-import java.awt.geom.*;
 
 /**
  * Actual RMI class which implements RemoteEnvironment
@@ -64,58 +59,15 @@ public class ServerEnvironment extends ServerClass implements RemoteEnvironment
 	}
 
 	public String getCurrentCenter(int sessionId, String aircraftId) {
-		Aircraft aircraft = null;
-		float aircraftLatitude = 0.0f, aircraftLongitude = 0.0f;
-		String currentCenter = "";
-		aircraft = cEngine.select_aircraft(sessionId, aircraftId);
-		if (aircraft != null) {
-			aircraftLatitude = aircraft.getLatitude_deg();
-			aircraftLongitude = aircraft.getLongitude_deg();
-
-		}
-		
-		BufferedReader reader;
-		try {
-			reader = new BufferedReader(new FileReader(ServerNATS.getSharePath() + "/artcc/Centers_CONUS"));
-			String line = reader.readLine();
-
-			while (line != null) {
-				String centerBuffer;
-				int centerBoundaryLength;
-
-				if (line.startsWith("CENTER,")) {
-					centerBoundaryLength = Integer.parseInt(line.split(",")[3]);
-					centerBuffer = line.split(",")[2];
-
-					Path2D path = new Path2D.Double();
-					line = reader.readLine();
-					path.moveTo(Double.parseDouble(line.split(",")[1]), Double.parseDouble(line.split(",")[2]));
-					for (int i = 1; i < centerBoundaryLength; ++i) {
-						path.lineTo(Double.parseDouble(line.split(",")[1]), Double.parseDouble(line.split(",")[2]));
-						line = reader.readLine();
-					}
-					path.closePath();
-
-					if (path.contains(aircraftLatitude, aircraftLongitude)) {
-						if (centerBuffer.contains("ZAN") || centerBuffer.contains("ZHN"))
-							currentCenter = "P" + centerBuffer.split("-")[0];
-						else
-							currentCenter = "K" + centerBuffer.split("-")[0];
-						break;
-					}
-				}
-				line = reader.readLine();
-			}
-			reader.close();
-		} catch (IOException e) {
-			e.printStackTrace();
-		}
-
-		return currentCenter;
+		return cEngine.getCurrentCenter(aircraftId);
 	}
 
 	public String[] getFixesInCenter(int sessionId, String centerId) {
 			return cEngine.getFixesInCenter(centerId);
 	}
 
+	public int getCenterTrafficCount(int sessionId, String centerId) {
+		return cEngine.getCenterTrafficCount(centerId);
+	}
+
 }
@@ -810,6 +810,14 @@ public class ServerRiskMeasures extends ServerClass implements RemoteRiskMeasure
 		return cEngine.calculateRisk(flightData, ServerNATS.cifpExists);
 	}
 	
+	public String[] calculateRisk_codes() throws RemoteException {
+		return cEngine.calculateRisk_codes();
+	}
+	
+	public double[][] calculateRisk_batch(String[] aircraftIds1, double[][] states1, String[] aircraftIds2, double[][] states2) throws RemoteException {
+		return cEngine.calculateRisk_batch(aircraftIds1, states1, aircraftIds2, states2);
+	}
+	
 	public int setRegionOfRegard(String aircraft, double[] regionBounds) throws RemoteException {
 		return cEngine.setRegionOfRegard(aircraft, regionBounds);
 	}
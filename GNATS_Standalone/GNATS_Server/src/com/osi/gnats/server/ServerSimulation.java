@@ -210,6 +210,34 @@ public class ServerSimulation extends ServerClass implements RemoteSimulation {
 		cEngine.clear_trajectories();
 	}
 	
+	/**
+	 * Save the simulation state at the paused time step to a checkpoint file
+	 */
+	public int save_checkpoint(String checkpoint_file) throws RemoteException {
+		return cEngine.save_checkpoint(checkpoint_file);
+	}
+	
+	/**
+	 * Load a checkpoint file.  The next start resumes from the checkpoint time step.
+	 */
+	public int load_checkpoint(String checkpoint_file) throws RemoteException {
+		return cEngine.load_checkpoint(checkpoint_file);
+	}
+	
+	/**
+	 * Enable or disable the per-stage profiling of the propagation loop
+	 */
+	public void enable_profiling(boolean flag) throws RemoteException {
+		cEngine.enable_propagation_profiling(flag);
+	}
+	
+	/**
+	 * Get the profile report of the last propagation run
+	 */
+	public String get_profile_report() throws RemoteException {
+		return cEngine.get_propagation_profile_report();
+	}
+	
 	/**
 	 * Request the ownership of a aircraft
 	 */
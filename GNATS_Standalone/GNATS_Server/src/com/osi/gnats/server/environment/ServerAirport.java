@@ -124,6 +124,32 @@ public class ServerAirport extends ServerClass implements RemoteAirport {
 		return retValue;
 	}
 
+	public String[] getClosestAirport_batch(double[] latitude_deg, double[] longitude_deg) {
+		String[] retValue = null;
+		
+		if(ServerNATS.cifpExists) {
+			retValue = cEngine.getClosestAirport_batch(latitude_deg, longitude_deg);
+		}
+		else {
+			System.out.println("This function won't work due to absence of FAA CIFP file.");
+		}
+		
+		return retValue;
+	}
+	
+	public String[][] getAirportsWithinMiles_batch(double[] latitude_deg, double[] longitude_deg, double miles) {
+		String[][] retValue = null;
+		
+		if(ServerNATS.cifpExists) {
+			retValue = cEngine.getAirportsWithinMiles_batch(latitude_deg, longitude_deg, miles);
+		}
+		else {
+			System.out.println("This function won't work due to absence of FAA CIFP file.");
+		}
+		
+		return retValue;
+	}
+
 	public String getFullName(String airport_code) {
 		String retValue = "";
 		
@@ -68,6 +68,13 @@ public class ServerCNS extends ServerClass implements RemoteCNS {
 		return cEngine.getLineOfSight(observerLat, observerLon, observerAlt, targetLat, targetLon, targetAlt, ServerNATS.cifpExists);
 	}
 	
+	/**
+	 * Computes line of sight of every observer against every target.
+	 */
+	public double[][] getLineOfSight_batch(double[][] observers, double[][] targets, double refractionFactor) {
+		return cEngine.getLineOfSight_batch(observers, targets, refractionFactor, ServerNATS.cifpExists);
+	}
+	
 	/**
 	 * Sets Latitude/Longitude navigation errors for aircraft CNS.
 	 * 
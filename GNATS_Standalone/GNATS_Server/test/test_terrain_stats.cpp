@@ -0,0 +1,278 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_terrain_stats.cpp
+ *
+ * Test of the terrain area statistics tables against the direct loop of
+ * getElevationAreaStats on synthetic terrain.
+ *
+ * The terrain files are filled in the layouts loadTerrainData reads them
+ * into: the contiguous US grid in file 0, and open terrain with one file
+ * per degree of latitude.  For every random box, getElevationAreaStats is
+ * called once with the tables and once with the tables set aside, so the
+ * original direct loop answers.  Minimum and maximum have to agree
+ * exactly, mean and variance within TEST_TOLERANCE_RELATIVE.
+ *
+ * Half of the boxes have sides of a whole number of steps.  The direct
+ * loop adds the step to the position, so it may take a sample on the
+ * upper edge of these boxes.  On the contiguous US grid they are aligned
+ * to the cells, where the positions round to either side of the cell
+ * edges and can repeat or skip a cell.  Open terrain boxes start at cell
+ * centers.
+ *
+ * The statistics helpers are static, so the engine source is compiled into
+ * the test.
+ */
+
+#include "CEngine.cpp"
+
+#include <random>
+
+#define TEST_NUM_BOXES 300
+#define TEST_TOLERANCE_RELATIVE 1e-9
+
+// Size of the contiguous US terrain file 0, and its samples per longitude
+#define TEST_CONUS_FILE_SAMPLES 50092208
+#define TEST_CONUS_LATITUDE_SAMPLES 24872
+
+static std::mt19937 rng(7);
+static std::uniform_real_distribution<double> uniform(0, 1);
+
+static double test_array[5];
+
+static jclass JNICALL test_FindClass(JNIEnv* env, const char* name) {
+	(void)env;
+	(void)name;
+
+	return NULL;
+}
+
+static jdoubleArray JNICALL test_NewDoubleArray(JNIEnv* env, jsize len) {
+	(void)env;
+	(void)len;
+
+	return (jdoubleArray) test_array;
+}
+
+static void JNICALL test_SetDoubleArrayRegion(JNIEnv* env, jdoubleArray array, jsize start, jsize len, const jdouble* buf) {
+	(void)env;
+
+	memcpy((double*) array + start, buf, len * sizeof(double));
+}
+
+// The JNI functions getElevationAreaStats calls, on an otherwise empty table
+static JNINativeInterface_ test_functions;
+static JNIEnv test_env;
+
+static void init_test_env() {
+	memset(&test_functions, 0, sizeof(test_functions));
+	test_functions.FindClass = test_FindClass;
+	test_functions.NewDoubleArray = test_NewDoubleArray;
+	test_functions.SetDoubleArrayRegion = test_SetDoubleArrayRegion;
+
+	test_env.functions = &test_functions;
+}
+
+// Min, max, mean, variance and standard deviation of a box
+static void get_area_stats(const double minLat, const double maxLat, const double minLon, const double maxLon,
+		const bool cifpExists, double* const result) {
+	Java_com_osi_gnats_engine_CEngine_getElevationAreaStats(&test_env, NULL, minLat, maxLat, minLon, maxLon, cifpExists);
+
+	memcpy(result, test_array, sizeof(test_array));
+}
+
+// Same, read one sample at a time with the tables set aside
+static void get_area_stats_direct(const double minLat, const double maxLat, const double minLon, const double maxLon,
+		const bool cifpExists, double* const result) {
+	terrain_stats_grid_t conus = terrain_stats_grid_t();
+	map<int, terrain_stats_grid_t> open;
+
+	std::swap(conus, conusTerrainStats);
+	open.swap(openTerrainStats);
+
+	get_area_stats(minLat, maxLat, minLon, maxLon, cifpExists, result);
+
+	std::swap(conus, conusTerrainStats);
+	open.swap(openTerrainStats);
+}
+
+static bool is_close(const double a, const double b, const double tolerance_abs) {
+	return fabs(a - b) <= TEST_TOLERANCE_RELATIVE * std::max(fabs(a), fabs(b)) + tolerance_abs;
+}
+
+static int compare_box(const double minLat, const double maxLat, const double minLon, const double maxLon,
+		const bool cifpExists) {
+	terrain_stats_t stats;
+	if (!get_terrain_area_stats(minLat, maxLat, minLon, maxLon, cifpExists, &stats)) {
+		printf("FAILED: Box %.6f %.6f %.6f %.6f is not covered by the tables\n", minLat, maxLat, minLon, maxLon);
+
+		return 1;
+	}
+
+	double expected[5];
+	double result[5];
+
+	get_area_stats_direct(minLat, maxLat, minLon, maxLon, cifpExists, expected);
+	get_area_stats(minLat, maxLat, minLon, maxLon, cifpExists, result);
+
+	if ((expected[0] != result[0]) || (expected[1] != result[1])
+			|| !is_close(expected[2], result[2], 1e-6) || !is_close(expected[3], result[3], 1e-3)) {
+		printf("FAILED: Box %.6f %.6f %.6f %.6f min %g/%g max %g/%g mean %.9g/%.9g variance %.9g/%.9g\n",
+				minLat, maxLat, minLon, maxLon, expected[0], result[0], expected[1], result[1],
+				expected[2], result[2], expected[3], result[3]);
+
+		return 1;
+	}
+
+	return 0;
+}
+
+// Random open terrain in the files of latitude bands band0 to band1
+static void fill_open_terrain(const int band0, const int band1, const int num_samples) {
+	for (int band = band0; band <= band1; band++) {
+		vector<float>& samples = terrData[band];
+
+		// One short file, so boxes reach past its end
+		samples.resize((band == band0 + 1) ? num_samples / 2 : num_samples);
+		for (size_t i = 0; i < samples.size(); i++) {
+			samples[i] = (float) (rng() % 900000) / 7;
+		}
+	}
+}
+
+static int test_conus() {
+	terrData.clear();
+
+	// Smooth terrain with noise and a few spikes
+	vector<float>& samples = terrData[0];
+	samples.resize(TEST_CONUS_FILE_SAMPLES);
+	for (size_t i = 0; i < samples.size(); i++) {
+		const size_t lon = i / TEST_CONUS_LATITUDE_SAMPLES;
+		const size_t lat = i % TEST_CONUS_LATITUDE_SAMPLES;
+
+		samples[i] = 100000 + 30000 * sin(lon * 0.003) * cos(lat * 0.002) + (float) (rng() % 1000);
+	}
+	for (int k = 0; k < 2000; k++) {
+		samples[rng() % samples.size()] = 500000 + rng() % 100000;
+	}
+
+	build_terrain_stats(33.0, 35.5, -125.1, -123.3, true);
+
+	int num_failures = 0;
+
+	for (int n = 0; n < TEST_NUM_BOXES; n++) {
+		double lat = 33.0 + uniform(rng) * 2.0;
+		double lon = -125.09 + uniform(rng) * 1.4;
+		double height = 0.0005 + uniform(rng) * 0.3;
+		double width = 0.0005 + uniform(rng) * 0.3;
+
+		// Boxes aligned to the cells whose sides are a whole number of steps
+		if (n % 2 == 1) {
+			lat = round(lat * 1000) / 1000;
+			lon = round(lon * 1000) / 1000;
+			height = round(height * 1000) / 1000 + 0.001;
+			width = round(width * 1000) / 1000 + 0.001;
+		}
+
+		num_failures += compare_box(lat, lat + height, lon, lon + width, true);
+	}
+
+	// The tables take the same time for any box
+	struct timeval time_begin;
+	struct timeval time_end;
+	double result[5];
+
+	gettimeofday(&time_begin, NULL);
+	get_area_stats(33.0001, 35.4, -125.09, -123.4, true, result);
+	gettimeofday(&time_end, NULL);
+	const double duration_tables = (time_end.tv_sec - time_begin.tv_sec) + (time_end.tv_usec - time_begin.tv_usec) / 1e6;
+
+	gettimeofday(&time_begin, NULL);
+	get_area_stats_direct(33.0001, 35.4, -125.09, -123.4, true, result);
+	gettimeofday(&time_end, NULL);
+	const double duration_direct = (time_end.tv_sec - time_begin.tv_sec) + (time_end.tv_usec - time_begin.tv_usec) / 1e6;
+
+	printf("Contiguous US box of 2.4 x 1.7 degrees: %.6f s with the tables, %.6f s direct\n", duration_tables, duration_direct);
+
+	return num_failures;
+}
+
+static int test_open(const int band0, const int band1, const double lat0, const double lat1, const double* const resolutions, const int num_resolutions) {
+	terrData.clear();
+	startLat = -56;
+	endLat = 75;
+	startLon = 0;
+	endLon = 40;
+
+	fill_open_terrain(band0, band1, 4001);
+	build_terrain_stats(0, 0, 0, 0, false);
+
+	int num_failures = 0;
+
+	for (int n = 0; n < TEST_NUM_BOXES; n++) {
+		resolution = resolutions[n % num_resolutions];
+
+		double lat = lat0 + uniform(rng) * (lat1 - lat0);
+		double lon = uniform(rng) * 20;
+		double height = 0.005 + uniform(rng) * 3;
+		double width = 0.005 + uniform(rng) * 5;
+
+		// Boxes from cell centers whose sides are a whole number of steps
+		if (n % 2 == 1) {
+			lat = (floor(lat / resolution) + 0.5) * resolution;
+			lon = (floor(lon / resolution) + 0.5) * resolution;
+			height = (floor(height / resolution) + 1) * resolution;
+			width = (floor(width / resolution) + 1) * resolution;
+		}
+
+		num_failures += compare_box(lat, lat + height, lon, lon + width, false);
+	}
+
+	return num_failures;
+}
+
+int main(int argc, char* argv[]) {
+	(void)argc;
+	(void)argv;
+
+	init_test_env();
+
+	int num_failures = 0;
+
+	num_failures += test_conus();
+
+	// Open terrain, and bands across the equator, where band 0 spans (-1, 1)
+	const double resolutions[] = {0.01, 0.07, 0.3};
+	num_failures += test_open(40, 45, 39.5, 46.5, resolutions, 3);
+	num_failures += test_open(-3, 2, -3.5, 1.5, resolutions, 3);
+
+	printf("test_terrain_stats: %d boxes, %d failures\n", 3 * TEST_NUM_BOXES, num_failures);
+
+	return (num_failures == 0) ? 0 : 1;
+}
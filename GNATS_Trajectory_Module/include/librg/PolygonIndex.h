@@ -0,0 +1 @@
+../../src/librg/src/PolygonIndex.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/libtg/src/tg_aircraftIndex.h
\ No newline at end of file
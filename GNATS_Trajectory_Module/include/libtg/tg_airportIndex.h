@@ -0,0 +1 @@
+../../src/libtg/src/tg_airportIndex.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/libtg/src/tg_centers.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/libtg/src/tg_checkpoint.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/libtg/src/tg_ensemble.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/libtg/src/tg_kinematics.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/libtg/src/tg_profiler.h
\ No newline at end of file
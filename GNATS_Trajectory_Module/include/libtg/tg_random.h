@@ -0,0 +1 @@
+../../src/libtg/src/tg_random.h
\ No newline at end of file
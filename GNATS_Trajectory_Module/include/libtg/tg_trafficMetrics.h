@@ -0,0 +1 @@
+../../src/libtg/src/tg_trafficMetrics.h
\ No newline at end of file
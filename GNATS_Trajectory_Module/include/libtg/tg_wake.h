@@ -0,0 +1 @@
+../../src/libtg/src/tg_wake.h
\ No newline at end of file
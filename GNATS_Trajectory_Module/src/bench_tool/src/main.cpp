@@ -0,0 +1,1144 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * main.cpp
+ *
+ * Benchmark of the trajectory generator on synthetic traffic.
+ *
+ * For every requested flight count the program writes a geo-style TRX
+ * and MFL scenario built from the airports of the bundled navigation
+ * data, then times the major stages of a run: tg_init(), loading the
+ * flights, the propagation of every simulated hour, CDNR and trajectory
+ * recording (from the propagation profiler) and writing the
+ * trajectories.  With --fast-forward every flight count runs a second
+ * time with cruise fast-forward, and the speedup of the propagation is
+ * reported.
+ *
+ * Each flight count runs in a new process.  The program executes itself
+ * with the internal --run-flights option, and that process runs
+ * tg_init() and the benchmark of one flight count.  The runs therefore do
+ * not share simulation state, and no process forks after libgomp started
+ * its OpenMP threads (libgomp is not fork-safe).
+ *
+ * Results are appended to a CSV file with the columns
+ *   flights,metric,index,value,unit
+ *
+ * Run from the GNATS_Server directory so that the share folder is found.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "tg_api.h"
+#include "tg_aircraft.h"
+#include "tg_airports.h"
+#include "tg_profiler.h"
+#include "tg_random.h"
+#include "tg_simulation.h"
+
+#include "geometry_utils.h"
+
+#include "rg_api.h"
+#include "rg_exec.h"
+
+using namespace std;
+using namespace osi;
+
+typedef struct _weighted_code_t {
+	string code;
+	double weight;
+} weighted_code_t;
+
+typedef struct _bench_airport_t {
+	string code;
+	string name;
+	double latitude;
+	double longitude;
+	double elevation;
+	double weight;
+
+	// Airports within the route length range and their cumulative weights
+	vector<int> destinations;
+	vector<double> destination_cumulative_weights;
+} bench_airport_t;
+
+typedef struct _bench_flight_t {
+	long departure_time;
+	int origin;
+	int destination;
+	string actype;
+} bench_flight_t;
+
+static const long TRACK_TIME_BASE = 1121238067;
+
+static const double SECONDS_PER_HOUR = 3600.;
+
+static string g_flight_counts = "100,1000,10000,100000";
+static string g_airport_mix = "KATL:4,KORD:3,KDFW:3,KDEN:3,KLAX:3,KJFK:2,KSFO:2,KSEA:2,KLAS:2,KMCO:2,KCLT:2,KPHX:2,KIAH:2,KMIA:2,KBOS:2,KMSP:2,KDTW:2,KPHL:2,KEWR:2,KLGA:1,KBWI:1,KSLC:1,KSAN:1,KIAD:1,KDCA:1,KTPA:1,KPDX:1,KSTL:1,KMDW:1,KBNA:1";
+static string g_actype_mix = "SA:7,WB:1,RJ:1,TP:1";
+static double g_route_nmi_min = 150;
+static double g_route_nmi_max = 2500;
+static long g_departure_spread_sec = 3600;
+static int g_horizon_hours = 3;
+static float g_t_step_surface = 10;
+static float g_t_step_terminal = 10;
+static float g_t_step_airborne = 30;
+static unsigned long long g_seed = 1;
+static bool g_flag_cdnr = true;
+static string g_outdir = "bench_out";
+static string g_results_file = "";
+static string g_weather_file = "";
+static double g_weather_lookahead_nmi = 250;
+static bool g_flag_fast_forward = false;
+
+// Flight count of a run process started by the main process, and whether
+// the run process enables cruise fast-forward
+static int g_run_flights = 0;
+static bool g_run_fast_forward = false;
+
+/**
+ * Print usage
+ */
+static void print_usage(char* progname) {
+	printf("\n");
+	printf("Usage: %s [options]\n\n", progname);
+	printf("  Option:\n");
+	printf("    --flights=<n,n,...>          -n   Flight counts to run (default %s)\n", g_flight_counts.c_str());
+	printf("    --airports=<code:w,...>      -a   Airport mix with optional weights\n");
+	printf("    --actypes=<type:w,...>       -t   Aircraft type mix (default %s)\n", g_actype_mix.c_str());
+	printf("    --route-nmi=<min:max>        -r   Great circle route length range (default %.0f:%.0f)\n", g_route_nmi_min, g_route_nmi_max);
+	printf("    --departure-spread=<sec>     -d   Departures are spread uniformly over this period (default %ld)\n", g_departure_spread_sec);
+	printf("    --horizon=<hours>            -H   Simulated hours (default %d)\n", g_horizon_hours);
+	printf("    --time-steps=<s,t,a>         -s   Surface, terminal and airborne time steps (default %.0f,%.0f,%.0f)\n", g_t_step_surface, g_t_step_terminal, g_t_step_airborne);
+	printf("    --seed=<n>                   -S   Scenario seed (default %llu)\n", g_seed);
+	printf("    --no-cdnr                    -c   Disable conflict detection and resolution\n");
+	printf("    --out-folder=<dir>           -o   Output folder (default %s)\n", g_outdir.c_str());
+	printf("    --results=<file>             -R   Results CSV file (default <out-folder>/bench_results.csv)\n");
+	printf("    --weather=<polygon file>     -w   Time weather polygon intersection and rerouting on the scenario routes\n");
+	printf("    --weather-lookahead=<nmi>    -l   Look-ahead distance of the polygon search (default %.0f)\n", g_weather_lookahead_nmi);
+	printf("    --fast-forward               -f   Run every flight count again with cruise fast-forward and report the speedup\n");
+	printf("    --help                       -h   Print this message\n");
+	printf("\n");
+}
+
+/**
+ * Parse arguments
+ */
+static void parse_args(int argc, char* argv[]) {
+	int c;
+	while (1) {
+		int option_index = 0;
+
+		// {name, has_arg, flag, val}
+		static struct option opts[] = {
+			{"flights", 1, 0, 'n'},
+			{"airports", 1, 0, 'a'},
+			{"actypes", 1, 0, 't'},
+			{"route-nmi", 1, 0, 'r'},
+			{"departure-spread", 1, 0, 'd'},
+			{"horizon", 1, 0, 'H'},
+			{"time-steps", 1, 0, 's'},
+			{"seed", 1, 0, 'S'},
+			{"no-cdnr", 0, 0, 'c'},
+			{"out-folder", 1, 0, 'o'},
+			{"results", 1, 0, 'R'},
+			{"weather", 1, 0, 'w'},
+			{"weather-lookahead", 1, 0, 'l'},
+			{"fast-forward", 0, 0, 'f'},
+			{"help", 0, 0, 'h'},
+			{"run-flights", 1, 0, 'F'},
+			{"run-fast-forward", 0, 0, 'G'},
+			{0, 0, 0, 0}
+		};
+
+		string optstr = "n:a:t:r:d:H:s:S:co:R:w:l:fh";
+
+		c = getopt_long(argc, argv, optstr.c_str(), opts, &option_index);
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'n':
+			g_flight_counts = optarg;
+			break;
+		case 'a':
+			g_airport_mix = optarg;
+			break;
+		case 't':
+			g_actype_mix = optarg;
+			break;
+		case 'r':
+			if (sscanf(optarg, "%lf:%lf", &g_route_nmi_min, &g_route_nmi_max) != 2) {
+				printf("Invalid route length range: %s\n", optarg);
+				exit(-1);
+			}
+			break;
+		case 'd':
+			g_departure_spread_sec = atol(optarg);
+			break;
+		case 'H':
+			g_horizon_hours = atoi(optarg);
+			break;
+		case 's':
+			if (sscanf(optarg, "%f,%f,%f", &g_t_step_surface, &g_t_step_terminal, &g_t_step_airborne) != 3) {
+				printf("Invalid time steps: %s\n", optarg);
+				exit(-1);
+			}
+			break;
+		case 'S':
+			g_seed = strtoull(optarg, NULL, 10);
+			break;
+		case 'c':
+			g_flag_cdnr = false;
+			break;
+		case 'o':
+			g_outdir = optarg;
+			break;
+		case 'R':
+			g_results_file = optarg;
+			break;
+		case 'w':
+			g_weather_file = optarg;
+			break;
+		case 'l':
+			g_weather_lookahead_nmi = atof(optarg);
+			break;
+		case 'f':
+			g_flag_fast_forward = true;
+			break;
+		case 'F':
+			g_run_flights = atoi(optarg);
+			break;
+		case 'G':
+			g_run_fast_forward = true;
+			break;
+		case 'h':
+		default:
+			print_usage(argv[0]);
+			exit(0);
+		}
+	}
+}
+
+static double get_wall_time_ms() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+/**
+ * Parse "CODE:weight,CODE,..." into codes and weights.  The weight defaults to 1.
+ */
+static vector<weighted_code_t> parse_weighted_list(const string& str_list) {
+	vector<weighted_code_t> retVector;
+
+	stringstream ss(str_list);
+	string token;
+	while (getline(ss, token, ',')) {
+		if (token.length() == 0)
+			continue;
+
+		weighted_code_t tmpCode;
+		tmpCode.weight = 1;
+
+		size_t colon_pos = token.find(':');
+		if (colon_pos == string::npos) {
+			tmpCode.code = token;
+		} else {
+			tmpCode.code = token.substr(0, colon_pos);
+			tmpCode.weight = atof(token.substr(colon_pos + 1).c_str());
+		}
+
+		if (0 < tmpCode.weight) {
+			retVector.push_back(tmpCode);
+		}
+	}
+
+	return retVector;
+}
+
+static vector<int> parse_flight_counts(const string& str_list) {
+	vector<int> retVector;
+
+	stringstream ss(str_list);
+	string token;
+	while (getline(ss, token, ',')) {
+		int tmpCount = atoi(token.c_str());
+		if (0 < tmpCount) {
+			retVector.push_back(tmpCount);
+		}
+	}
+
+	return retVector;
+}
+
+/**
+ * Index of the first cumulative weight larger than the random value
+ */
+static int pick_weighted(const vector<double>& cumulative_weights, const double u) {
+	const double value = u * cumulative_weights.back();
+
+	int index = upper_bound(cumulative_weights.begin(), cumulative_weights.end(), value) - cumulative_weights.begin();
+	if ((int)cumulative_weights.size() <= index)
+		index = cumulative_weights.size() - 1;
+
+	return index;
+}
+
+/**
+ * Format a degree value as the signed DDDMMSS.ssss string used by geo-style TRX
+ */
+static string format_lat_lon(const double degValue) {
+	const double absValue = fabs(degValue);
+
+	int intDeg = (int)floor(absValue);
+	int intMin = (int)floor((absValue - intDeg) * 60);
+	double dblSec = ((absValue - intDeg) * 60 - intMin) * 60;
+
+	if (59.99995 <= dblSec) {
+		dblSec = 0;
+		intMin++;
+	}
+	if (60 <= intMin) {
+		intMin = 0;
+		intDeg++;
+	}
+
+	char tmpStr[32];
+	snprintf(tmpStr, sizeof(tmpStr), "%s%d%02d%07.4f", (degValue < 0) ? "-" : "", intDeg, intMin, dblSec);
+
+	return string(tmpStr);
+}
+
+static string escape_json(const string& str) {
+	string retString;
+
+	for (size_t i = 0; i < str.length(); i++) {
+		if ((str[i] == '"') || (str[i] == '\\'))
+			continue;
+
+		retString.push_back(str[i]);
+	}
+
+	return retString;
+}
+
+/**
+ * Look up the airports of the mix in the navigation data and collect the
+ * destinations within the route length range of every origin
+ */
+static int prepare_airports(vector<bench_airport_t>& airports, vector<double>& origin_cumulative_weights, vector<int>& origins) {
+	map<string, int> map_code_index;
+	for (unsigned int i = 0; i < g_airports.size(); i++) {
+		map_code_index[g_airports.at(i).code] = i;
+	}
+
+	vector<weighted_code_t> airport_mix = parse_weighted_list(g_airport_mix);
+	for (unsigned int i = 0; i < airport_mix.size(); i++) {
+		map<string, int>::iterator ite = map_code_index.find(airport_mix.at(i).code);
+		if (ite == map_code_index.end()) {
+			printf("  Airport %s not found in the navigation data.  Skipped.\n", airport_mix.at(i).code.c_str());
+
+			continue;
+		}
+
+		const NatsAirport& tmpNatsAirport = g_airports.at(ite->second);
+
+		bench_airport_t tmpAirport;
+		tmpAirport.code = tmpNatsAirport.code;
+		tmpAirport.name = escape_json(tmpNatsAirport.name);
+		tmpAirport.latitude = tmpNatsAirport.latitude;
+		tmpAirport.longitude = tmpNatsAirport.longitude;
+		tmpAirport.elevation = tmpNatsAirport.elevation;
+		tmpAirport.weight = airport_mix.at(i).weight;
+
+		airports.push_back(tmpAirport);
+	}
+
+	for (unsigned int i = 0; i < airports.size(); i++) {
+		double tmpCumulative = 0;
+
+		for (unsigned int j = 0; j < airports.size(); j++) {
+			if (i == j)
+				continue;
+
+			const double distance_nmi = compute_distance_gc(airports.at(i).latitude, airports.at(i).longitude, airports.at(j).latitude, airports.at(j).longitude) / NauticalMilestoFeet;
+			if ((distance_nmi < g_route_nmi_min) || (g_route_nmi_max < distance_nmi))
+				continue;
+
+			tmpCumulative += airports.at(j).weight;
+
+			airports.at(i).destinations.push_back(j);
+			airports.at(i).destination_cumulative_weights.push_back(tmpCumulative);
+		}
+
+		if (0 < airports.at(i).destinations.size()) {
+			double tmpOriginCumulative = (origin_cumulative_weights.empty()) ? 0 : origin_cumulative_weights.back();
+
+			origins.push_back(i);
+			origin_cumulative_weights.push_back(tmpOriginCumulative + airports.at(i).weight);
+		}
+	}
+
+	if (origins.empty()) {
+		printf("No airport pair of the airport mix is within %.0f to %.0f nmi.\n", g_route_nmi_min, g_route_nmi_max);
+
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * Append one geo-style waypoint entry
+ */
+static void append_waypoint(ostringstream& oss, int& wp_count, const double lat, const double lon, const double alt, const char* phase) {
+	if (0 < wp_count)
+		oss << ", ";
+
+	wp_count++;
+
+	oss << "{\"wp_name\": \"Waypoint " << wp_count << "\", \"lat\": \"" << format_lat_lon(lat) << "\", \"lon\": \"" << format_lat_lon(lon) << "\", \"alt\": " << (int)round(alt) << ", \"phase\": \"" << phase << "\"}";
+}
+
+static void append_airport(ostringstream& oss, const bench_airport_t& airport) {
+	oss << "{\"ap_code\": \"" << airport.code << "\", \"ap_name\": \"" << airport.name << "\", \"lat\": \"" << format_lat_lon(airport.latitude) << "\", \"lon\": \"" << format_lat_lon(airport.longitude) << "\", \"alt\": " << airport.elevation << "}";
+}
+
+/**
+ * Cruise altitude by route length and aircraft class, lowered so that
+ * the climb and descent fit into the route
+ */
+static double compute_cruise_altitude(const double distance_nmi, const string& actype, const double elev_origin, const double elev_destination) {
+	double cruise_alt_ft = 37000;
+	if (distance_nmi < 300) {
+		cruise_alt_ft = 25000;
+	} else if (distance_nmi < 800) {
+		cruise_alt_ft = 33000;
+	}
+
+	if (actype == "TP") {
+		cruise_alt_ft = min(cruise_alt_ft, 25000.);
+	} else if (actype == "RJ") {
+		cruise_alt_ft = min(cruise_alt_ft, 35000.);
+	}
+
+	// Roughly 300 ft/nmi climbing and 330 ft/nmi descending
+	const double elev = max(elev_origin, elev_destination);
+	const double max_cruise_alt_ft = elev + 0.8 * distance_nmi / (1. / 300 + 1. / 330);
+	if (max_cruise_alt_ft < cruise_alt_ft) {
+		cruise_alt_ft = floor(max_cruise_alt_ft / 1000) * 1000;
+	}
+
+	return max(cruise_alt_ft, elev + 6000);
+}
+
+/**
+ * Write the TRACK and FP_ROUTE lines of one flight
+ */
+static void write_flight(ofstream& trx_out, ofstream& mfl_out, const string& callsign, const bench_flight_t& flight, const vector<bench_airport_t>& airports) {
+	const bench_airport_t& origin = airports.at(flight.origin);
+	const bench_airport_t& destination = airports.at(flight.destination);
+
+	const double distance_nmi = compute_distance_gc(origin.latitude, origin.longitude, destination.latitude, destination.longitude) / NauticalMilestoFeet;
+	const double course_deg = fmod(compute_heading_gc(origin.latitude, origin.longitude, destination.latitude, destination.longitude) + 360, 360);
+
+	const double cruise_alt_ft = compute_cruise_altitude(distance_nmi, flight.actype, origin.elevation, destination.elevation);
+
+	const double climb_nmi = (cruise_alt_ft - origin.elevation) / 300;
+	const double descent_nmi = (cruise_alt_ft - destination.elevation) / 330;
+
+	ostringstream oss;
+	int wp_count = 0;
+
+	double lat, lon;
+
+	oss << "    FP_ROUTE ";
+	append_airport(oss, origin);
+	oss << ".<>.RW<>.<";
+
+	append_waypoint(oss, wp_count, origin.latitude, origin.longitude, origin.elevation, "TAKEOFF");
+
+	compute_location_gc(origin.latitude, origin.longitude, 3 * NauticalMilestoFeet, course_deg, &lat, &lon);
+	append_waypoint(oss, wp_count, lat, lon, origin.elevation + 1000, "CLIMBOUT");
+
+	compute_location_gc(origin.latitude, origin.longitude, 0.5 * climb_nmi * NauticalMilestoFeet, course_deg, &lat, &lon);
+	append_waypoint(oss, wp_count, lat, lon, 0.5 * (origin.elevation + cruise_alt_ft), "CLIMB_TO_CRUISE_ALTITUDE");
+
+	// Cruise waypoints no further apart than 150 nmi from top of climb to top of descent
+	const double cruise_nmi = distance_nmi - climb_nmi - descent_nmi;
+	const int num_cruise_segments = max(1, (int)ceil(cruise_nmi / 150));
+	for (int k = 0; k < num_cruise_segments; k++) {
+		compute_location_gc(origin.latitude, origin.longitude, (climb_nmi + k * cruise_nmi / num_cruise_segments) * NauticalMilestoFeet, course_deg, &lat, &lon);
+		append_waypoint(oss, wp_count, lat, lon, cruise_alt_ft, "CRUISE");
+	}
+
+	compute_location_gc(origin.latitude, origin.longitude, (distance_nmi - descent_nmi) * NauticalMilestoFeet, course_deg, &lat, &lon);
+	append_waypoint(oss, wp_count, lat, lon, cruise_alt_ft, "INITIAL_DESCENT");
+
+	// Approach fix 30 nmi out when the descent starts before it
+	if (30 < descent_nmi) {
+		compute_location_gc(origin.latitude, origin.longitude, (distance_nmi - 30) * NauticalMilestoFeet, course_deg, &lat, &lon);
+		append_waypoint(oss, wp_count, lat, lon, min(cruise_alt_ft, destination.elevation + 8000), "APPROACH");
+	}
+
+	compute_location_gc(origin.latitude, origin.longitude, (distance_nmi - 8) * NauticalMilestoFeet, course_deg, &lat, &lon);
+	append_waypoint(oss, wp_count, lat, lon, destination.elevation + 2500, "FINAL_APPROACH");
+
+	append_waypoint(oss, wp_count, destination.latitude, destination.longitude, destination.elevation, "FINAL_APPROACH");
+
+	oss << ">.RW<>.<>.";
+	append_airport(oss, destination);
+
+	char tmpAlt[32];
+	snprintf(tmpAlt, sizeof(tmpAlt), "%.2f", origin.elevation / 100);
+
+	trx_out << "TRACK_TIME " << (TRACK_TIME_BASE + flight.departure_time) << "\n";
+	trx_out << "TRACK " << callsign << " " << flight.actype << " " << format_lat_lon(origin.latitude) << " " << format_lat_lon(origin.longitude) << " 0 " << tmpAlt << " " << (int)round(course_deg) << "\n";
+	trx_out << oss.str() << "\n\n";
+
+	mfl_out << callsign << " " << (int)(cruise_alt_ft / 100) << "\n";
+}
+
+/**
+ * Draw num_flights synthetic flights
+ *
+ * Every draw of a flight comes from its own random stream, so the first
+ * flights of a larger scenario equal the flights of a smaller one.
+ */
+static int draw_flights(const int num_flights, const vector<bench_airport_t>& airports, const vector<double>& origin_cumulative_weights, const vector<int>& origins, vector<bench_flight_t>& flights) {
+	vector<weighted_code_t> actype_mix = parse_weighted_list(g_actype_mix);
+	if (actype_mix.empty()) {
+		printf("Invalid aircraft type mix: %s\n", g_actype_mix.c_str());
+
+		return -1;
+	}
+
+	vector<double> actype_cumulative_weights;
+	double tmpCumulative = 0;
+	for (unsigned int i = 0; i < actype_mix.size(); i++) {
+		tmpCumulative += actype_mix.at(i).weight;
+		actype_cumulative_weights.push_back(tmpCumulative);
+	}
+
+	flights.resize(num_flights);
+
+	for (int i = 0; i < num_flights; i++) {
+		bench_flight_t& tmpFlight = flights.at(i);
+
+		tmpFlight.origin = origins.at(pick_weighted(origin_cumulative_weights, random_uniform(RANDOM_COMPONENT_TRAFFIC_GENERATOR, i, 0)));
+
+		const bench_airport_t& origin = airports.at(tmpFlight.origin);
+		tmpFlight.destination = origin.destinations.at(pick_weighted(origin.destination_cumulative_weights, random_uniform(RANDOM_COMPONENT_TRAFFIC_GENERATOR, i, 1)));
+
+		tmpFlight.actype = actype_mix.at(pick_weighted(actype_cumulative_weights, random_uniform(RANDOM_COMPONENT_TRAFFIC_GENERATOR, i, 2))).code;
+
+		tmpFlight.departure_time = (long)floor(random_uniform(RANDOM_COMPONENT_TRAFFIC_GENERATOR, i, 3) * (g_departure_spread_sec + 1));
+	}
+
+	return 0;
+}
+
+/**
+ * Write a synthetic scenario of num_flights flights
+ */
+static int generate_scenario(const int num_flights, const vector<bench_airport_t>& airports, const vector<double>& origin_cumulative_weights, const vector<int>& origins, const string& trx_file, const string& mfl_file) {
+	vector<bench_flight_t> flights;
+	if (draw_flights(num_flights, airports, origin_cumulative_weights, origins, flights) != 0)
+		return -1;
+
+	vector<pair<long, int> > departure_order(num_flights);
+	for (int i = 0; i < num_flights; i++) {
+		departure_order.at(i) = make_pair(flights.at(i).departure_time, i);
+	}
+
+	sort(departure_order.begin(), departure_order.end());
+
+	ofstream trx_out(trx_file.c_str());
+	ofstream mfl_out(mfl_file.c_str());
+	if (!trx_out.is_open() || !mfl_out.is_open()) {
+		printf("Can't write scenario files %s and %s\n", trx_file.c_str(), mfl_file.c_str());
+
+		return -1;
+	}
+
+	for (int k = 0; k < num_flights; k++) {
+		const int i = departure_order.at(k).second;
+
+		char callsign[16];
+		snprintf(callsign, sizeof(callsign), "BNC%06d", i);
+
+		write_flight(trx_out, mfl_out, string(callsign), flights.at(i), airports);
+	}
+
+	trx_out.close();
+	mfl_out.close();
+
+	return 0;
+}
+
+static double ns_to_ms(const long long ns) {
+	return (double)ns / 1000000.0;
+}
+
+/**
+ * Write one result.  Metrics of a fast-forward run are prefixed with
+ * "fast_forward_".
+ */
+static void write_result(FILE* results, const int num_flights, const char* metric, const int index, const double value, const char* unit) {
+	const string metric_name = string(g_run_fast_forward ? "fast_forward_" : "") + metric;
+
+	if (index < 0) {
+		fprintf(results, "%d,%s,,%.3f,%s\n", num_flights, metric_name.c_str(), value, unit);
+		printf("  %-32s %14.3f %s\n", metric_name.c_str(), value, unit);
+	} else {
+		fprintf(results, "%d,%s,%d,%.3f,%s\n", num_flights, metric_name.c_str(), index, value, unit);
+		printf("  %-28s %3d %14.3f %s\n", metric_name.c_str(), index, value, unit);
+	}
+
+	fflush(results);
+}
+
+/**
+ * Value of a metric without index of a flight count from the results
+ * file.  Returns -1 when the metric is not found.
+ */
+static int read_result(const int num_flights, const string& metric, double* const value) {
+	ifstream in(g_results_file.c_str());
+	string line;
+
+	while (getline(in, line)) {
+		istringstream iss(line);
+		string str_flights, str_metric, str_index, str_value;
+
+		if ((!getline(iss, str_flights, ',')) || (!getline(iss, str_metric, ',')) || (!getline(iss, str_index, ',')) || (!getline(iss, str_value, ',')))
+			continue;
+
+		if ((atoi(str_flights.c_str()) == num_flights) && (str_metric == metric) && (str_index.empty())) {
+			*value = atof(str_value.c_str());
+
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Metric name of a profiler stage: "profile_" followed by the lower case stage name
+ */
+static string get_stage_metric(const ENUM_Propagation_Stage stage) {
+	string retString("profile_");
+
+	const char* name = get_propagation_stage_name(stage);
+	for (int i = 0; name[i] != '\0'; i++) {
+		retString.push_back((name[i] == ' ') ? '_' : (char)tolower(name[i]));
+	}
+
+	return retString;
+}
+
+/**
+ * Wait until the propagation pauses at the end of the duration or ends
+ */
+static void wait_propagation_pause_or_end() {
+	while ((!flag_simulation_paused_at_step) && (get_runtime_sim_status() != NATS_SIMULATION_STATUS_ENDED)) {
+		usleep(nats_simulation_check_interval);
+	}
+}
+
+/**
+ * Great circle route of a flight with points no further apart than 150 nmi
+ */
+static void build_route_points(const bench_flight_t& flight, const vector<bench_airport_t>& airports, vector<double>& lats_deg, vector<double>& lons_deg) {
+	const bench_airport_t& origin = airports.at(flight.origin);
+	const bench_airport_t& destination = airports.at(flight.destination);
+
+	const double distance_nmi = compute_distance_gc(origin.latitude, origin.longitude, destination.latitude, destination.longitude) / NauticalMilestoFeet;
+	const double course_deg = compute_heading_gc(origin.latitude, origin.longitude, destination.latitude, destination.longitude);
+
+	const int num_segments = max(1, (int)ceil(distance_nmi / 150));
+
+	lats_deg.clear();
+	lons_deg.clear();
+	for (int k = 0; k < num_segments; k++) {
+		double lat, lon;
+		compute_location_gc(origin.latitude, origin.longitude, (k * distance_nmi / num_segments) * NauticalMilestoFeet, course_deg, &lat, &lon);
+		lats_deg.push_back(lat);
+		lons_deg.push_back(lon);
+	}
+	lats_deg.push_back(destination.latitude);
+	lons_deg.push_back(destination.longitude);
+}
+
+static bool same_polygons(const PolygonSet& a, const PolygonSet& b) {
+	if (a.size() != b.size())
+		return false;
+
+	for (unsigned int i = 0; i < a.size(); i++) {
+		const int n = a.at(i).getNumVertices();
+		if (n != b.at(i).getNumVertices())
+			return false;
+		if (memcmp(a.at(i).getXData(), b.at(i).getXData(), n * sizeof(double)) != 0)
+			return false;
+		if (memcmp(a.at(i).getYData(), b.at(i).getYData(), n * sizeof(double)) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Weather polygon search and reroute of every flight, run once with the
+ * full polygon scan and once with the bounding cap prefilter and the
+ * polygon index.  Both runs must give the same polygons and reroutes.
+ */
+static int run_weather(const int num_flights, FILE* results, const vector<bench_airport_t>& airports, const vector<double>& origin_cumulative_weights, const vector<int>& origins) {
+	double t0 = get_wall_time_ms();
+	PolygonSet weatherpolygons;
+	if (loadWeatherPolygons(g_weather_file, weatherpolygons) < 0)
+		return -1;
+	write_result(results, num_flights, "weather_load", -1, get_wall_time_ms() - t0, "ms");
+	write_result(results, num_flights, "weather_polygons", -1, weatherpolygons.size(), "count");
+
+	vector<bench_flight_t> flights;
+	if (draw_flights(num_flights, airports, origin_cumulative_weights, origins, flights) != 0)
+		return -1;
+
+	vector<vector<double> > route_lats(num_flights), route_lons(num_flights);
+	vector<double> lookahead_nmi(num_flights);
+	for (int i = 0; i < num_flights; i++) {
+		build_route_points(flights.at(i), airports, route_lats.at(i), route_lons.at(i));
+
+		// find_intersecting_polygons() expects the look-ahead to end
+		// before the last route point
+		const double distance_nmi = compute_distance_gc(route_lats.at(i).front(), route_lons.at(i).front(), route_lats.at(i).back(), route_lons.at(i).back()) / NauticalMilestoFeet;
+		lookahead_nmi.at(i) = min(g_weather_lookahead_nmi, 0.9 * distance_nmi);
+	}
+
+	vector<PolygonSet> ahead_scan(num_flights), ahead_indexed(num_flights);
+	vector<vector<double> > reroute_lat_scan(num_flights), reroute_lon_scan(num_flights);
+	vector<vector<double> > reroute_lat_indexed(num_flights), reroute_lon_indexed(num_flights);
+	vector<vector<pair<int, int> > > similar_scan(num_flights), similar_indexed(num_flights);
+
+	// Full scan
+	set_weather_polygon_prefilter(false);
+
+	t0 = get_wall_time_ms();
+	for (int i = 0; i < num_flights; i++) {
+		find_intersecting_polygons(route_lats.at(i).front(), route_lons.at(i).front(), 0, lookahead_nmi.at(i), route_lats.at(i), route_lons.at(i), weatherpolygons, ahead_scan.at(i));
+	}
+	write_result(results, num_flights, "weather_intersect_scan", -1, get_wall_time_ms() - t0, "ms");
+
+	t0 = get_wall_time_ms();
+	for (int i = 0; i < num_flights; i++) {
+		if (ahead_scan.at(i).empty())
+			continue;
+
+		weatherAvoidanceRoutesForNATS(ahead_scan.at(i), route_lats.at(i), route_lons.at(i), reroute_lat_scan.at(i), reroute_lon_scan.at(i), similar_scan.at(i));
+	}
+	write_result(results, num_flights, "weather_reroute_scan", -1, get_wall_time_ms() - t0, "ms");
+
+	// Prefilter and polygon index
+	set_weather_polygon_prefilter(true);
+
+	t0 = get_wall_time_ms();
+	PolygonIndex index(weatherpolygons);
+	write_result(results, num_flights, "weather_index_build", -1, get_wall_time_ms() - t0, "ms");
+
+	t0 = get_wall_time_ms();
+	for (int i = 0; i < num_flights; i++) {
+		find_intersecting_polygons(route_lats.at(i).front(), route_lons.at(i).front(), 0, lookahead_nmi.at(i), route_lats.at(i), route_lons.at(i), weatherpolygons, &index, ahead_indexed.at(i));
+	}
+	write_result(results, num_flights, "weather_intersect_indexed", -1, get_wall_time_ms() - t0, "ms");
+
+	t0 = get_wall_time_ms();
+	for (int i = 0; i < num_flights; i++) {
+		if (ahead_indexed.at(i).empty())
+			continue;
+
+		weatherAvoidanceRoutesForNATS(ahead_indexed.at(i), route_lats.at(i), route_lons.at(i), reroute_lat_indexed.at(i), reroute_lon_indexed.at(i), similar_indexed.at(i));
+	}
+	write_result(results, num_flights, "weather_reroute_indexed", -1, get_wall_time_ms() - t0, "ms");
+
+	int num_affected = 0;
+	int num_mismatches = 0;
+	for (int i = 0; i < num_flights; i++) {
+		if (!ahead_scan.at(i).empty())
+			num_affected++;
+
+		if (!same_polygons(ahead_scan.at(i), ahead_indexed.at(i))
+				|| (reroute_lat_scan.at(i) != reroute_lat_indexed.at(i))
+				|| (reroute_lon_scan.at(i) != reroute_lon_indexed.at(i))
+				|| (similar_scan.at(i) != similar_indexed.at(i))) {
+			num_mismatches++;
+		}
+	}
+	write_result(results, num_flights, "weather_affected_flights", -1, num_affected, "count");
+	write_result(results, num_flights, "weather_mismatches", -1, num_mismatches, "count");
+
+	if (num_mismatches > 0) {
+		printf("  Prefiltered weather results differ from the full scan for %d flights\n", num_mismatches);
+
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * Body of a flight count run.  Runs in the run process.
+ */
+static int run_flight_count(const int num_flights, FILE* results, const vector<bench_airport_t>& airports, const vector<double>& origin_cumulative_weights, const vector<int>& origins) {
+	printf("\nFlights: %d%s\n", num_flights, g_run_fast_forward ? ", cruise fast-forward" : "");
+
+	ostringstream oss_trx, oss_mfl, oss_traj;
+	oss_trx << g_outdir << "/bench_" << num_flights << "_geo.trx";
+	oss_mfl << g_outdir << "/bench_" << num_flights << "_mfl.trx";
+	oss_traj << g_outdir << "/bench_" << num_flights << "_trajectory.csv";
+
+	double t0 = get_wall_time_ms();
+	if (generate_scenario(num_flights, airports, origin_cumulative_weights, origins, oss_trx.str(), oss_mfl.str()) != 0)
+		return -1;
+	write_result(results, num_flights, "generate_scenario", -1, get_wall_time_ms() - t0, "ms");
+
+	// The weather search does not depend on fast-forward
+	if ((g_weather_file.length() > 0) && (!g_run_fast_forward) && (run_weather(num_flights, results, airports, origin_cumulative_weights, origins) != 0))
+		return -1;
+
+	t0 = get_wall_time_ms();
+	tg_load_trx(oss_trx.str(), oss_mfl.str());
+	write_result(results, num_flights, "load_aircraft", -1, get_wall_time_ms() - t0, "ms");
+
+	write_result(results, num_flights, "loaded_flights", -1, get_num_flights(), "count");
+	if (get_num_flights() == 0)
+		return -1;
+
+	flag_enable_cdnr = g_flag_cdnr;
+	tg_enable_cruise_fast_forward(g_run_fast_forward);
+	set_propagation_profiling(true);
+
+	// Poll the pause state often so the hour boundaries are measured tightly
+	nats_simulation_check_interval = 1000;
+
+	if (propagate_flights(g_horizon_hours * SECONDS_PER_HOUR, g_t_step_surface, g_t_step_terminal, g_t_step_airborne) != 0)
+		return -1;
+
+	// The propagation pauses after every simulated hour
+	set_nats_simulation_duration((float)SECONDS_PER_HOUR);
+
+	const double t_propagation_begin = get_wall_time_ms();
+	double t_hour_begin = t_propagation_begin;
+
+	nats_simulation_operator(NATS_SIMULATION_STATUS_START);
+
+	for (int hour = 0; ; hour++) {
+		wait_propagation_pause_or_end();
+
+		write_result(results, num_flights, "propagate_hour", hour, get_wall_time_ms() - t_hour_begin, "ms");
+
+		if (get_runtime_sim_status() == NATS_SIMULATION_STATUS_ENDED)
+			break;
+
+		set_nats_simulation_duration((float)SECONDS_PER_HOUR);
+		nats_simulation_operator(NATS_SIMULATION_STATUS_RESUME);
+
+		while (flag_simulation_paused_at_step && (get_runtime_sim_status() != NATS_SIMULATION_STATUS_ENDED)) {
+			usleep(nats_simulation_check_interval);
+		}
+
+		t_hour_begin = get_wall_time_ms();
+	}
+
+	propagation_profile_t tmpProfile;
+	get_propagation_profile(&tmpProfile);
+
+	write_result(results, num_flights, "propagate_total", -1, ns_to_ms(tmpProfile.total_step_ns), "ms");
+	write_result(results, num_flights, "steps", -1, tmpProfile.steps, "count");
+	write_result(results, num_flights, "cdnr", -1, ns_to_ms(tmpProfile.stage[PROPAGATION_STAGE_CDNR].total_ns), "ms");
+	write_result(results, num_flights, "cdnr_pairs", -1, tmpProfile.cdnr_pairs_total, "count");
+	write_result(results, num_flights, "trajectory_recording", -1, ns_to_ms(tmpProfile.stage[PROPAGATION_STAGE_TRAJECTORY_RECORDING].total_ns), "ms");
+
+	for (int i = 0; i < PROPAGATION_STAGE_COUNT; i++) {
+		if (tmpProfile.stage[i].calls == 0)
+			continue;
+
+		write_result(results, num_flights, get_stage_metric((ENUM_Propagation_Stage)i).c_str(), -1, ns_to_ms(tmpProfile.stage[i].total_ns), "ms");
+	}
+
+	if (g_run_fast_forward) {
+		fast_forward_stats_t stats;
+		get_cruise_fast_forward_stats(&stats);
+
+		write_result(results, num_flights, "coasted_steps", -1, stats.skipped_steps, "count");
+		write_result(results, num_flights, "cruise_steps", -1, stats.total_steps, "count");
+		write_result(results, num_flights, "error_coast_max", -1, stats.max_error_ft, "ft");
+		write_result(results, num_flights, "error_flight_max", -1, stats.max_flight_error_ft, "ft");
+	}
+
+	t0 = get_wall_time_ms();
+	tg_write_trajectories(oss_traj.str(), g_trajectories);
+	write_result(results, num_flights, "write_trajectories", -1, get_wall_time_ms() - t0, "ms");
+
+	return 0;
+}
+
+/**
+ * Run process of one flight count: initialize the trajectory generator
+ * and append the results of the run to the results file.
+ */
+static int run_process(const int num_flights) {
+	FILE* results = fopen(g_results_file.c_str(), "a");
+	if (results == NULL) {
+		printf("Can't write results file %s\n", g_results_file.c_str());
+
+		return -1;
+	}
+
+	double t0 = get_wall_time_ms();
+	if (tg_init() != 0) {
+		printf("tg_init() failed\n");
+		fclose(results);
+
+		return -1;
+	}
+	write_result(results, num_flights, "do_init", -1, get_wall_time_ms() - t0, "ms");
+
+	set_random_scenario_seed(g_seed);
+
+	vector<bench_airport_t> airports;
+	vector<double> origin_cumulative_weights;
+	vector<int> origins;
+	if (prepare_airports(airports, origin_cumulative_weights, origins) != 0) {
+		fclose(results);
+
+		return -1;
+	}
+
+	int retValue = run_flight_count(num_flights, results, airports, origin_cumulative_weights, origins);
+
+	fclose(results);
+
+	return retValue;
+}
+
+/**
+ * Speedup of the fast-forward run of a flight count over the run that
+ * processes every step: of the whole propagation, and of the two state
+ * update kernels that fast-forward skips
+ */
+static int write_fast_forward_speedup(const int num_flights) {
+	const string metric_kernel_stage1 = get_stage_metric(PROPAGATION_STAGE_KERNEL_STAGE1);
+	const string metric_kernel_stage2 = get_stage_metric(PROPAGATION_STAGE_KERNEL_STAGE2);
+
+	double propagate_total = 0;
+	double kernel_stage1 = 0;
+	double kernel_stage2 = 0;
+	double fast_forward_propagate_total = 0;
+	double fast_forward_kernel_stage1 = 0;
+	double fast_forward_kernel_stage2 = 0;
+
+	if ((read_result(num_flights, "propagate_total", &propagate_total) != 0)
+			|| (read_result(num_flights, metric_kernel_stage1, &kernel_stage1) != 0)
+			|| (read_result(num_flights, metric_kernel_stage2, &kernel_stage2) != 0)
+			|| (read_result(num_flights, "fast_forward_propagate_total", &fast_forward_propagate_total) != 0)
+			|| (read_result(num_flights, "fast_forward_" + metric_kernel_stage1, &fast_forward_kernel_stage1) != 0)
+			|| (read_result(num_flights, "fast_forward_" + metric_kernel_stage2, &fast_forward_kernel_stage2) != 0)) {
+		printf("Missing results of the runs of %d flights\n", num_flights);
+
+		return -1;
+	}
+
+	FILE* results = fopen(g_results_file.c_str(), "a");
+	if (results == NULL) {
+		printf("Can't write results file %s\n", g_results_file.c_str());
+
+		return -1;
+	}
+
+	printf("\nFlights: %d, cruise fast-forward speedup\n", num_flights);
+
+	if (fast_forward_propagate_total > 0) {
+		write_result(results, num_flights, "fast_forward_speedup", -1, propagate_total / fast_forward_propagate_total, "x");
+	}
+
+	if (fast_forward_kernel_stage1 + fast_forward_kernel_stage2 > 0) {
+		write_result(results, num_flights, "fast_forward_speedup_kernels", -1, (kernel_stage1 + kernel_stage2) / (fast_forward_kernel_stage1 + fast_forward_kernel_stage2), "x");
+	}
+
+	fclose(results);
+
+	return 0;
+}
+
+/**
+ * Start this program with the same arguments plus --run-flights, and
+ * --run-fast-forward for a fast-forward run, and wait for it
+ */
+static int start_run_process(const int num_flights, const bool flag_fast_forward, int argc, char* argv[]) {
+	char run_option[64];
+	snprintf(run_option, sizeof(run_option), "--run-flights=%d", num_flights);
+
+	char fast_forward_option[] = "--run-fast-forward";
+
+	vector<char*> run_argv(argv, argv + argc);
+	run_argv.push_back(run_option);
+	if (flag_fast_forward) {
+		run_argv.push_back(fast_forward_option);
+	}
+	run_argv.push_back(NULL);
+
+	fflush(stdout);
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		printf("Can't start the run of %d flights\n", num_flights);
+
+		return -1;
+	} else if (pid == 0) {
+		execv("/proc/self/exe", &run_argv[0]);
+
+		printf("Can't execute the run of %d flights\n", num_flights);
+		fflush(stdout);
+
+		_exit(1);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+		printf("Run of %d flights failed\n", num_flights);
+
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	parse_args(argc, argv);
+
+	if (g_results_file.length() == 0) {
+		g_results_file = g_outdir + "/bench_results.csv";
+	}
+
+	if (g_run_flights > 0) {
+		return (run_process(g_run_flights) == 0) ? 0 : 1;
+	}
+
+	printf("*****************************************************************************\n");
+	printf("*                            GNATS Benchmark Tool                           *\n");
+	printf("*****************************************************************************\n");
+
+	printf("\n");
+	printf("  Flight counts:     %s\n", g_flight_counts.c_str());
+	printf("  Airport mix:       %s\n", g_airport_mix.c_str());
+	printf("  Aircraft types:    %s\n", g_actype_mix.c_str());
+	printf("  Route length:      %.0f to %.0f nmi\n", g_route_nmi_min, g_route_nmi_max);
+	printf("  Departure spread:  %ld sec\n", g_departure_spread_sec);
+	printf("  Horizon:           %d hours\n", g_horizon_hours);
+	printf("  Time steps:        %.1f, %.1f, %.1f sec\n", g_t_step_surface, g_t_step_terminal, g_t_step_airborne);
+	printf("  Seed:              %llu\n", g_seed);
+	printf("  CDNR:              %s\n", g_flag_cdnr ? "enabled" : "disabled");
+	printf("  Fast-forward:      %s\n", g_flag_fast_forward ? "compared" : "disabled");
+	printf("  Results file:      %s\n", g_results_file.c_str());
+	if (g_weather_file.length() > 0) {
+		printf("  Weather polygons:  %s (look-ahead %.0f nmi)\n", g_weather_file.c_str(), g_weather_lookahead_nmi);
+	}
+	printf("\n");
+
+#if USE_GPU
+	printf("The benchmark is CPU only and does not support GPU builds.\n");
+
+	return -1;
+#endif
+
+	struct stat info;
+	if (stat(g_outdir.c_str(), &info) != 0) {
+		if (mkdir(g_outdir.c_str(), 0755) != 0) {
+			printf("Can't create output folder %s\n", g_outdir.c_str());
+
+			return -1;
+		}
+	}
+
+	vector<int> flight_counts = parse_flight_counts(g_flight_counts);
+	if (flight_counts.empty()) {
+		printf("No flight count given\n");
+
+		return -1;
+	}
+
+	FILE* results = fopen(g_results_file.c_str(), "w");
+	if (results == NULL) {
+		printf("Can't write results file %s\n", g_results_file.c_str());
+
+		return -1;
+	}
+
+	fprintf(results, "flights,metric,index,value,unit\n");
+	fclose(results);
+
+	int retValue = 0;
+
+	for (unsigned int i = 0; i < flight_counts.size(); i++) {
+		if (start_run_process(flight_counts.at(i), false, argc, argv) != 0) {
+			retValue = -1;
+
+			continue;
+		}
+
+		if ((g_flag_fast_forward)
+				&& ((start_run_process(flight_counts.at(i), true, argc, argv) != 0) || (write_fast_forward_speedup(flight_counts.at(i)) != 0)))
+			retValue = -1;
+	}
+
+	printf("\nResults written to %s\n", g_results_file.c_str());
+
+	return retValue;
+}
@@ -98,6 +98,19 @@ AstarSearch::AstarSearch() :
 AstarSearch::~AstarSearch() {
 }
 
+/*
+ * Orders (cost, node id) frontier entries by cost only, lowest cost at the
+ * front, the way SearchNodeCostComparator orders nodes.  Ties are left to
+ * the heap, so searches that push the same entries in the same order
+ * pop equal-cost nodes in the same order.
+ */
+class FrontierEntryCostComparator {
+public:
+    bool operator()(const std::pair<double, int>& e1, const std::pair<double, int>& e2) const {
+        return e1.first > e2.first;
+    }
+};
+
 /**
  * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
  * Function:
@@ -136,9 +149,11 @@ void AstarSearch::findPath(SearchGraph& graph,
 		return;
 	}
 
-	// put the start node in the frontier
-	frontier.push(startNode);
-	openSet.insert(startNode);
+	// the frontier holds (f, id) values.  a node whose cost improves is
+	// pushed again and its older entry is skipped when popped, so the
+	// heap never sees a cost change under it.
+	priority_queue< std::pair<double, int>, vector< std::pair<double, int> >,
+			FrontierEntryCostComparator > localFrontier;
 
 	// map of the parent nodes that the lowest cost child node came from.
 	// this will be used to reconstruct the shortest path
@@ -155,23 +170,35 @@ void AstarSearch::findPath(SearchGraph& graph,
 	g_score[startNode->id] = 0;
 	f_score[startNode->id] = g_score[startNode->id] + graph.getHeuristicCost(startNode->id);
 
+	// put the start node in the frontier
+	localFrontier.push(std::make_pair(f_score[startNode->id], startNode->id));
+	openSet.insert(startNode);
+
 	vector<SearchNode*> unexplored(200000);
 
 
 	// the graph search loop
 
-	while(frontier.size() > 0) {
+	while(localFrontier.size() > 0) {
 
 		// select frontier node with the least cost: best first approach
 		// since the frontier is ordered by cost, the lowest cost node
 		// will be at the front.
-		SearchNode* selectedNode = frontier.top();
+		std::pair<double, int> entry = localFrontier.top();
+		SearchNode* selectedNode = graph.getNode(entry.second);
 
 		// check if we reached the goal
 		if(selectedNode->id == goalNode->id) {
 			break;
 		}
 
+		localFrontier.pop();
+
+		// skip stale entries of nodes that were already expanded
+		if((closedSet.find(selectedNode) != closedSet.end()) || (entry.first != f_score[selectedNode->id])) {
+			continue;
+		}
+
 		// did not reach the goal yet so expand the frontier:
 		// remove the selectedNode from the frontier and add
 		// the selectedNode's children (connected nodes)
@@ -183,7 +210,6 @@ void AstarSearch::findPath(SearchGraph& graph,
 		// the child came from since a child can have multiple parent
 		// nodes.
 		selectedNode->visited = true;
-		frontier.pop();
 
 		openSet.erase(selectedNode);
 		closedSet.insert(selectedNode);
@@ -211,7 +237,7 @@ void AstarSearch::findPath(SearchGraph& graph,
 				child->cost = f_score[child->id];
 
 				cameFrom[child->id] = selectedNode->id;
-				frontier.push(child);
+				localFrontier.push(std::make_pair(f_score[child->id], child->id));
 				openSet.insert(child);
 			}
 		}
@@ -234,10 +260,8 @@ void AstarSearch::findPath(SearchGraph& graph,
 	}
 	path->push_front(id);
 
-	// clear the frontier and explored members so that subsequent
+	// clear the explored members so that subsequent
 	// calls to this function will start with the initial state.
-	frontier = std::priority_queue<SearchNode*, vector<SearchNode*>, SearchNodeCostComparator>();
-
 	closedSet.clear();
 	openSet.clear();
 }
@@ -384,6 +408,127 @@ void AstarSearch::findPath(const SearchGraph& graph, const double* const h,
     openSet.clear();
 }
 
+/**
+ * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ * Function:
+ *   findPath()
+ *
+ * Description:
+ *   Find the shortest path between the specified start and end nodes
+ *   using the A* search algorithm with caller-supplied heuristic and
+ *   edge costs.  All search state is local so the graph is not modified.
+ *
+ * Inputs:
+ *   graph             the graph of nodes to search
+ *   h                 array of pre-computed heuristic costs for nodes
+ *   edgeCosts         edge costs, same layout as the graph's
+ *   edgeCostsVector   hourly edge costs, same layout as the graph's
+ *   startId           the id of the start node within the search graph
+ *   endId             the id of the goal node within the search graph
+ *
+ * In/Out:
+ *   path   Pointer to the SearchPath to hold the resulting shortest path
+ *
+ * Returns:
+ *   none
+ * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ */
+void AstarSearch::findPath(const SearchGraph& graph, const double* const h,
+                           const map< std::pair<int,int>, double >& edgeCosts,
+                           const map< std::pair<int,int>, vector<double> >& edgeCostsVector,
+                           const int startId, const int endId,
+                           SearchPath* const path, const bool& dyn_flag) const {
+    // obtain the starting node
+    SearchNode* startNode = graph.getNode(startId);
+    if(!startNode) return;
+
+    // obtain the goal node
+    SearchNode* goalNode = graph.getNode(endId);
+    if(!goalNode) return;
+
+    unsigned int numNodes = graph.size();
+    vector<double> f_score(numNodes, 0);
+    vector<double> g_score(numNodes, 0);
+
+    // open and closed set membership, and the parent node that the lowest
+    // cost child node came from (-1 if none)
+    vector<char> inOpenSet(numNodes, 0);
+    vector<char> inClosedSet(numNodes, 0);
+    vector<int> cameFrom(numNodes, -1);
+
+    // the frontier holds (f, id) values.  a node whose cost improves is
+    // pushed again and its older entry is skipped when popped, so the
+    // heap never sees a cost change under it.
+    priority_queue< std::pair<double, int>, vector< std::pair<double, int> >,
+            FrontierEntryCostComparator > localFrontier;
+
+    g_score[startNode->id] = 0;
+    f_score[startNode->id] = g_score[startNode->id] + h[startNode->id];
+
+    // put the start node in the frontier
+    localFrontier.push(std::make_pair(f_score[startNode->id], startNode->id));
+    inOpenSet[startNode->id] = 1;
+
+    // the graph search loop
+    while(localFrontier.size() > 0) {
+
+        // select frontier node with the least cost
+        std::pair<double, int> entry = localFrontier.top();
+        SearchNode* selectedNode = graph.getNode(entry.second);
+
+        // check if we reached the goal
+        if(selectedNode->id == goalNode->id) {
+            break;
+        }
+
+        localFrontier.pop();
+
+        // skip stale entries of nodes that were already expanded
+        if(inClosedSet[selectedNode->id] || (entry.first != f_score[selectedNode->id])) {
+            continue;
+        }
+
+        inOpenSet[selectedNode->id] = 0;
+        inClosedSet[selectedNode->id] = 1;
+
+        multiset<SearchNode*, SearchNodeCostComparator>::const_iterator iter;
+        for(iter=selectedNode->children.begin(); iter!=selectedNode->children.end(); ++iter) {
+            SearchNode* child = (*iter);
+            if(inClosedSet[child->id]) continue;
+
+            double g_temp = 0.0;
+            if (dyn_flag)
+                g_temp = g_score[selectedNode->id] +
+                    SearchGraph::lookupEdgeCost(edgeCosts, edgeCostsVector, selectedNode->id, child->id, g_score[selectedNode->id]);
+            else
+                g_temp = g_score[selectedNode->id] +
+                    SearchGraph::lookupEdgeCost(edgeCosts, edgeCostsVector, selectedNode->id, child->id);
+            if(!inOpenSet[child->id] || (g_temp < g_score[child->id])) {
+                g_score[child->id] = g_temp;
+                f_score[child->id] = g_score[child->id] + h[child->id];
+
+                cameFrom[child->id] = selectedNode->id;
+                localFrontier.push(std::make_pair(f_score[child->id], child->id));
+                inOpenSet[child->id] = 1;
+            }
+        }
+    }
+
+    // reconstruct the path
+    path->clear();
+    int id = goalNode->id;
+    while(id != startNode->id) {
+        path->push_front(id);
+        if(cameFrom[id] < 0) {
+            id = startNode->id;
+            break;
+        } else {
+            id = cameFrom[id];
+        }
+    }
+    path->push_front(id);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // private impl
 
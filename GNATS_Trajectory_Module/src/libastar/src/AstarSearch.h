@@ -154,6 +154,40 @@ public:
                   const int startId, const int endId,
                   SearchPath* const path, const bool& dyn_flag = false);
 
+    /**
+     * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+     * Function:
+     *   findPath()
+     *
+     * Description:
+     *   Find the shortest path between the specified start and end nodes
+     *   using the A* search algorithm with caller-supplied heuristic and
+     *   edge costs.  The graph is only used for connectivity and is not
+     *   modified, so several searches may share one graph concurrently
+     *   as long as each uses its own AstarSearch object.  For the same
+     *   costs the result is identical to the other findPath() functions.
+     *
+     * Inputs:
+     *   graph             the graph of nodes to search
+     *   h                 array of pre-computed heuristic costs for nodes
+     *   edgeCosts         edge costs, same layout as the graph's
+     *   edgeCostsVector   hourly edge costs, same layout as the graph's
+     *   startId           the id of the start node within the search graph
+     *   endId             the id of the goal node within the search graph
+     *
+     * In/Out:
+     *   path   Pointer to the SearchPath to hold the resulting shortest path
+     *
+     * Returns:
+     *   none
+     * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+     */
+    void findPath(const SearchGraph& graph, const double* const h,
+                  const map< std::pair<int,int>, double >& edgeCosts,
+                  const map< std::pair<int,int>, vector<double> >& edgeCostsVector,
+                  const int startId, const int endId,
+                  SearchPath* const path, const bool& dyn_flag = false) const;
+
 private:
 
 	/**
@@ -811,6 +811,48 @@ double& SearchGraph::getEdgeCost(const int& sourceId, const int& sinkId,
 		return (ecosts.at(idx));
 	}
 }
+/**
+ * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ * Function:
+ *   lookupEdgeCost()
+ *
+ * Description:
+ *   Get the edge cost between nodes with the specified ids from
+ *   caller-owned cost maps, using the same rules as getEdgeCost().
+ *
+ * Inputs:
+ *   edgeCosts         edge cost map
+ *   edgeCostsVector   hourly edge cost map
+ *   sourceId          id of the start node
+ *   sinkId            id of the end node
+ *   tval              elapsed time in seconds, or negative for the
+ *                     time-independent cost
+ *
+ * In/Out:
+ *   none
+ *
+ * Returns:
+ *   the edge cost between nodes with the specified ids
+ * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ */
+double SearchGraph::lookupEdgeCost(const map< std::pair<int,int>, double >& edgeCosts,
+		const map< std::pair<int,int>, vector<double> >& edgeCostsVector,
+		const int& sourceId, const int& sinkId, const double& tval) {
+	std::pair<int,int> key(sourceId, sinkId);
+
+	if (tval < 0) {
+		map< std::pair<int,int>, double >::const_iterator iter = edgeCosts.find(key);
+		return (iter != edgeCosts.end()) ? iter->second : VALUE_DBL_MAX;
+	}
+
+	const vector<double>& ecosts = edgeCostsVector.at(key);
+	if (ecosts.size() <= 1)
+		return edgeCosts.at(key);
+
+	unsigned int idx = (unsigned int)( floor(tval/3600) )% ( ecosts.size() );
+	return ecosts.at(idx);
+}
+
 /**
  * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
  * Function:
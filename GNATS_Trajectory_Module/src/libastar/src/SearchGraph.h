@@ -328,6 +328,35 @@ public:
 	 * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 	 */
 	double& getEdgeCost(const int& sourceId, const int& sinkId,const double& tval = -1.0) const;
+
+	/**
+	 * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+	 * Function:
+	 *   lookupEdgeCost()
+	 *
+	 * Description:
+	 *   Get the edge cost between nodes with the specified ids from
+	 *   caller-owned cost maps, using the same rules as getEdgeCost().
+	 *
+	 * Inputs:
+	 *   edgeCosts         edge cost map
+	 *   edgeCostsVector   hourly edge cost map
+	 *   sourceId          id of the start node
+	 *   sinkId            id of the end node
+	 *   tval              elapsed time in seconds, or negative for the
+	 *                     time-independent cost
+	 *
+	 * In/Out:
+	 *   none
+	 *
+	 * Returns:
+	 *   the edge cost between nodes with the specified ids
+	 * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+	 */
+	static double lookupEdgeCost(const map< std::pair<int,int>, double >& edgeCosts,
+			const map< std::pair<int,int>, vector<double> >& edgeCostsVector,
+			const int& sourceId, const int& sinkId, const double& tval = -1.0);
+
 	/**
 	 * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 	 * Function:
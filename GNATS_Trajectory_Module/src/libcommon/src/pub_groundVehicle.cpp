@@ -46,7 +46,13 @@ GroundVehicle::GroundVehicle() :
 	drive_plan_final_node_ptr(NULL),
 	drive_plan_length(0),
 	target_waypoint_name(""),
-	target_waypoint_index(-1)
+	target_waypoint_index(-1),
+	operator_absence_steps(0),
+	lag_params(vector<int>()),
+	lag_course_values(vector<float>()),
+	lag_speed_values(vector<float>()),
+	flag_course_override(false),
+	history_index(-1)
 {
 }
 
@@ -66,7 +72,13 @@ GroundVehicle::GroundVehicle(const GroundVehicle& that) :
 			drive_plan_final_node_ptr(that.drive_plan_final_node_ptr),
 			drive_plan_length(that.drive_plan_length),
 			target_waypoint_name(that.target_waypoint_name),
-			target_waypoint_index(that.target_waypoint_index)
+			target_waypoint_index(that.target_waypoint_index),
+			operator_absence_steps(that.operator_absence_steps),
+			lag_params(that.lag_params),
+			lag_course_values(that.lag_course_values),
+			lag_speed_values(that.lag_speed_values),
+			flag_course_override(that.flag_course_override),
+			history_index(that.history_index)
 {
 }
 
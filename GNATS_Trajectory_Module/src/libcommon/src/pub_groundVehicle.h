@@ -48,6 +48,12 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 
 using namespace std;
 
+// Ground vehicle parameters with lagged operator response
+enum ENUM_GroundVehicle_Lag_Param {
+	GROUND_VEHICLE_LAG_COURSE = 0,
+	GROUND_VEHICLE_LAG_SPEED
+};
+
 
 class GroundVehicle {
 public:
@@ -72,6 +78,15 @@ public:
 	string target_waypoint_name;
 	int target_waypoint_index;
 
+	// Ground operator state set through the controller interface
+	int operator_absence_steps; // Time steps the operator stays absent
+	vector<int> lag_params; // ENUM_GroundVehicle_Lag_Param in the order they were set
+	vector<float> lag_course_values;
+	vector<float> lag_speed_values;
+	bool flag_course_override; // Course was set externally, skip the next bearing update
+
+	int history_index; // Index in groundVehicleHistories, -1 if not assigned
+
 	GroundVehicle();
 
 	GroundVehicle(const GroundVehicle& that);
@@ -29,37 +29,625 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include "pub_logger.h"
 
 #include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <fstream>
+#include <atomic>
 
 #include "util_string.h"
 
+#include <errno.h>
+#include <pthread.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/syscall.h>
 
 #define stringify(name) #name
 
-ENUM_Log_Level console_log_level;
+// Number of slots in the ring buffer.  Must be a power of 2.
+#define LOGGER_RING_SIZE 4096
 
-ENUM_Log_Level getLog_Level(const char* log_level_string) {
-	ENUM_Log_Level retLog_level;
+// Maximum number of modules with their own threshold
+#define LOGGER_MAX_MODULES 64
 
-	if (log_level_string != NULL) {
-		for (unsigned int i = 0; i < ENUM_Log_Level_Count; i++) {
-			if (strcmp(ENUM_Log_Level_String[i], log_level_string) == 0) {
-				retLog_level = ENUM_Log_Level(i);
+// Sleep time of the writer thread when the ring buffer is empty
+#define LOGGER_WRITER_IDLE_USEC 1000
+
+// Maximum number of records taken from the ring buffer per pass of the writer thread
+#define LOGGER_WRITER_BATCH 256
+
+// Size at which formatted records are written out before the batch is complete
+#define LOGGER_BATCH_BYTES 65536
+
+typedef struct _log_record_t {
+	std::atomic<size_t> sequence;
+	ENUM_Log_Level level;
+	struct timespec timestamp;
+	long thread_id;
+	char module[LOGGER_MODULE_NAME_SIZE];
+	char message[LOGGER_MESSAGE_SIZE];
+} log_record_t;
+
+typedef struct _log_module_t {
+	char name[LOGGER_MODULE_NAME_SIZE];
+	int threshold_rank;
+} log_module_t;
+
+// Level printed by logger_printLog()
+ENUM_Log_Level console_log_level = LOG_LEVEL_DUMMY;
+
+// Threshold of LOGGER_LOG() modules without an override
+static int default_threshold_rank = 3; // INFO
+
+int logger_max_enabled_level = 3; // INFO
+
+static log_module_t log_modules[LOGGER_MAX_MODULES];
+static int log_module_count = 0;
+
+static bool flag_log_json = false;
+static bool flag_log_async = true;
+
+static FILE* log_output = NULL;
+
+// Formatted records waiting to be written to log_output
+static string log_batch;
+
+// Bounded multi-producer queue.  Each slot carries a sequence number telling
+// producers and the consumer whether it is free or holds a published record.
+static log_record_t log_ring[LOGGER_RING_SIZE];
+static std::atomic<size_t> log_ring_enqueue_pos(0);
+static size_t log_ring_dequeue_pos = 0;
+
+static std::atomic<unsigned long long> log_dropped_count(0);
+static unsigned long long log_dropped_reported = 0;
+
+static std::atomic<bool> flag_writer_running(false);
+static std::atomic<bool> flag_writer_stop(false);
+static pthread_t writer_thread;
+
+// Serializes configuration changes
+static pthread_mutex_t mutex_log_config = PTHREAD_MUTEX_INITIALIZER;
+
+// Serializes access to the output stream and the consumer side of the ring
+static pthread_mutex_t mutex_log_output = PTHREAD_MUTEX_INITIALIZER;
+
+static bool flag_logger_registered = false;
+
+static __thread long cached_thread_id = 0;
+
+static long get_thread_id() {
+	if (cached_thread_id == 0) {
+		cached_thread_id = (long)syscall(SYS_gettid);
+	}
+
+	return cached_thread_id;
+}
+
+static int getLog_Level(const char* log_level_string, ENUM_Log_Level* log_level) {
+	if ((log_level_string == NULL) || (log_level == NULL))
+		return 1;
+
+	string tmpStr = string(log_level_string);
+	if (tmpStr.find("LOG_LEVEL_") != 0) {
+		tmpStr.insert(0, "LOG_LEVEL_");
+	}
+
+	if (tmpStr.compare("LOG_LEVEL_OFF") == 0) {
+		*log_level = LOG_LEVEL_DUMMY;
+
+		return 0;
+	}
+
+	for (int i = 0; i < ENUM_Log_Level_Count; i++) {
+		if (strcmp(ENUM_Log_Level_String[i], tmpStr.c_str()) == 0) {
+			*log_level = ENUM_Log_Level(i);
+
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static const char* get_level_name(const ENUM_Log_Level logLevel) {
+	// Skip the "LOG_LEVEL_" prefix
+	return ENUM_Log_Level_String[logLevel] + 10;
+}
+
+// Call with mutex_log_config held
+static void update_max_enabled_level() {
+	int maxLevel = default_threshold_rank;
+
+	for (int i = 0; i < log_module_count; i++) {
+		if (maxLevel < log_modules[i].threshold_rank)
+			maxLevel = log_modules[i].threshold_rank;
+	}
+
+	__atomic_store_n(&logger_max_enabled_level, maxLevel, __ATOMIC_RELAXED);
+}
+
+bool logger_is_module_enabled(const ENUM_Log_Level logLevel, const char* module) {
+	int threshold = __atomic_load_n(&default_threshold_rank, __ATOMIC_RELAXED);
+
+	if (module != NULL) {
+		const int count = __atomic_load_n(&log_module_count, __ATOMIC_ACQUIRE);
+		for (int i = 0; i < count; i++) {
+			if (strcmp(log_modules[i].name, module) == 0) {
+				threshold = __atomic_load_n(&log_modules[i].threshold_rank, __ATOMIC_RELAXED);
 
 				break;
 			}
 		}
 	}
 
-	return retLog_level;
+	return (logLevel != LOG_LEVEL_DUMMY) && (logger_level_rank(logLevel) <= threshold);
+}
+
+int logger_set_module_log_level(const char* module, const ENUM_Log_Level logLevel) {
+	if ((module == NULL) || (strlen(module) == 0) || (LOGGER_MODULE_NAME_SIZE <= strlen(module)))
+		return 1;
+
+	if ((logLevel < 0) || (ENUM_Log_Level_Count <= logLevel))
+		return 1;
+
+	int retValue = 0;
+
+	pthread_mutex_lock(&mutex_log_config);
+
+	int i = 0;
+	for (i = 0; i < log_module_count; i++) {
+		if (strcmp(log_modules[i].name, module) == 0) {
+			__atomic_store_n(&log_modules[i].threshold_rank, logger_level_rank(logLevel), __ATOMIC_RELAXED);
+
+			break;
+		}
+	}
+
+	if (i == log_module_count) {
+		if (log_module_count < LOGGER_MAX_MODULES) {
+			strcpy(log_modules[i].name, module);
+			log_modules[i].threshold_rank = logger_level_rank(logLevel);
+
+			// Publish the new entry after it is complete
+			__atomic_store_n(&log_module_count, log_module_count + 1, __ATOMIC_RELEASE);
+		} else {
+			retValue = 1;
+		}
+	}
+
+	if (retValue == 0)
+		update_max_enabled_level();
+
+	pthread_mutex_unlock(&mutex_log_config);
+
+	return retValue;
 }
 
 void logger_set_console_log_level(const char* inputStr) {
-	string tmp_log_level = string("LOG_LEVEL_");
-	tmp_log_level.append(inputStr);
+	if (inputStr == NULL)
+		return;
+
+	string tmpStr = string(inputStr);
+	size_t pos_begin = 0;
+
+	while (pos_begin <= tmpStr.length()) {
+		size_t pos_end = tmpStr.find(',', pos_begin);
+		if (pos_end == string::npos)
+			pos_end = tmpStr.length();
+
+		string token = tmpStr.substr(pos_begin, pos_end - pos_begin);
+		trim(token);
+		pos_begin = pos_end + 1;
+
+		if (token.length() == 0)
+			continue;
+
+		ENUM_Log_Level tmpLevel;
+		size_t pos_equal = token.find('=');
+
+		if (pos_equal != string::npos) {
+			string module = token.substr(0, pos_equal);
+			string level = token.substr(pos_equal + 1);
+
+			trim(module);
+			trim(level);
+
+			if ((getLog_Level(level.c_str(), &tmpLevel) != 0)
+					|| (logger_set_module_log_level(module.c_str(), tmpLevel) != 0)) {
+				printf("Logger: Invalid module log level setting \"%s\".  Ignored.\n", token.c_str());
+			}
+		} else if (token.compare("json") == 0) {
+			logger_set_json_output(true);
+		} else if (token.compare("text") == 0) {
+			logger_set_json_output(false);
+		} else if (token.compare("async") == 0) {
+			logger_set_async(true);
+		} else if (token.compare("sync") == 0) {
+			logger_set_async(false);
+		} else if (getLog_Level(token.c_str(), &tmpLevel) == 0) {
+			pthread_mutex_lock(&mutex_log_config);
+
+			__atomic_store_n((int*)&console_log_level, (int)tmpLevel, __ATOMIC_RELAXED);
+			__atomic_store_n(&default_threshold_rank, logger_level_rank(tmpLevel), __ATOMIC_RELAXED);
+			update_max_enabled_level();
+
+			pthread_mutex_unlock(&mutex_log_config);
+		} else {
+			printf("Logger: Invalid log level \"%s\".  Ignored.\n", token.c_str());
+		}
+	}
+}
+
+void logger_set_json_output(const bool flag) {
+	pthread_mutex_lock(&mutex_log_output);
+	flag_log_json = flag;
+	pthread_mutex_unlock(&mutex_log_output);
+}
+
+void logger_set_async(const bool flag) {
+	if (!flag)
+		logger_flush();
+
+	__atomic_store_n(&flag_log_async, flag, __ATOMIC_RELAXED);
+}
+
+int logger_set_output_file(const char* pathfilename) {
+	FILE* tmpFile = NULL;
+
+	if ((pathfilename != NULL) && (strlen(pathfilename) > 0)) {
+		tmpFile = fopen(pathfilename, "a");
+		if (tmpFile == NULL) {
+			printf("Logger: Could not open log file %s\n", pathfilename);
+
+			return 1;
+		}
+	}
+
+	logger_flush();
+
+	pthread_mutex_lock(&mutex_log_output);
+
+	if (log_output != NULL)
+		fclose(log_output);
+
+	log_output = tmpFile;
+
+	pthread_mutex_unlock(&mutex_log_output);
+
+	return 0;
+}
+
+unsigned long long logger_get_dropped_count() {
+	return log_dropped_count.load(std::memory_order_relaxed);
+}
+
+static void append_json_string(string& out, const char* str) {
+	out.push_back('"');
+
+	for (const char* c = str; *c != '\0'; c++) {
+		switch (*c) {
+			case '"':
+				out.append("\\\"");
+				break;
+			case '\\':
+				out.append("\\\\");
+				break;
+			case '\n':
+				out.append("\\n");
+				break;
+			case '\r':
+				out.append("\\r");
+				break;
+			case '\t':
+				out.append("\\t");
+				break;
+			default:
+				if ((unsigned char)*c < 0x20) {
+					char tmpChar[8];
+					snprintf(tmpChar, sizeof(tmpChar), "\\u%04x", (unsigned char)*c);
+					out.append(tmpChar);
+				} else {
+					out.push_back(*c);
+				}
+		}
+	}
+
+	out.push_back('"');
+}
+
+// Call with mutex_log_output held
+static void write_batch() {
+	if (log_batch.empty())
+		return;
+
+	FILE* out = (log_output != NULL) ? log_output : stdout;
+
+	// Bypass stdio buffering.  A single write() per batch keeps records whole
+	// when several processes append to the same output.
+	fflush(out);
+
+	const char* ptr = log_batch.data();
+	size_t remaining = log_batch.length();
+	while (remaining > 0) {
+		ssize_t cnt = write(fileno(out), ptr, remaining);
+		if (cnt < 0) {
+			if (errno == EINTR)
+				continue;
+
+			break;
+		}
 
-	console_log_level = getLog_Level(tmp_log_level.c_str());
+		ptr += cnt;
+		remaining -= cnt;
+	}
+
+	log_batch.clear();
+}
+
+// Call with mutex_log_output held
+static void emit_record(const ENUM_Log_Level logLevel,
+		const char* module,
+		const long thread_id,
+		const struct timespec& timestamp,
+		char* message) {
+	if (!flag_log_json) {
+		log_batch.append(message);
+	} else {
+		// Leading and trailing line breaks only format console output
+		size_t len = strlen(message);
+		while ((len > 0) && ((message[len-1] == '\n') || (message[len-1] == '\r'))) {
+			message[--len] = '\0';
+		}
+		while ((*message == '\n') || (*message == '\r')) {
+			message++;
+		}
+
+		if (*message == '\0')
+			return;
+
+		struct tm tmpTm;
+		char tmpTime[32];
+		char tmpHeader[128];
+
+		gmtime_r(&timestamp.tv_sec, &tmpTm);
+		strftime(tmpTime, sizeof(tmpTime), "%Y-%m-%dT%H:%M:%S", &tmpTm);
+
+		snprintf(tmpHeader, sizeof(tmpHeader), "{\"time\":\"%s.%06ldZ\",\"level\":\"%s\",\"module\":", tmpTime, timestamp.tv_nsec / 1000, get_level_name(logLevel));
+		log_batch.append(tmpHeader);
+		append_json_string(log_batch, module);
+
+		snprintf(tmpHeader, sizeof(tmpHeader), ",\"thread\":%ld,\"msg\":", thread_id);
+		log_batch.append(tmpHeader);
+		append_json_string(log_batch, message);
+		log_batch.append("}\n");
+	}
+
+	if (LOGGER_BATCH_BYTES <= log_batch.length())
+		write_batch();
+}
+
+// Call with mutex_log_output held
+static void report_dropped_messages() {
+	const unsigned long long dropped = log_dropped_count.load(std::memory_order_relaxed);
+
+	if (dropped != log_dropped_reported) {
+		char tmpMessage[128];
+		struct timespec timestamp;
+
+		clock_gettime(CLOCK_REALTIME, &timestamp);
+		snprintf(tmpMessage, sizeof(tmpMessage), "Logger: %llu messages dropped due to full log buffer\n", dropped - log_dropped_reported);
+
+		emit_record(LOG_LEVEL_WARNING, "logger", get_thread_id(), timestamp, tmpMessage);
+
+		log_dropped_reported = dropped;
+	}
+}
+
+/*
+ * Write queued records to the output.
+ *
+ * Return the number of records written.
+ */
+static int drain_ring(const int max_records) {
+	int cnt = 0;
+
+	pthread_mutex_lock(&mutex_log_output);
+
+	while (cnt < max_records) {
+		log_record_t* record = &log_ring[log_ring_dequeue_pos & (LOGGER_RING_SIZE - 1)];
+
+		if (record->sequence.load(std::memory_order_acquire) != log_ring_dequeue_pos + 1)
+			break;
+
+		emit_record(record->level, record->module, record->thread_id, record->timestamp, record->message);
+
+		// Hand the slot back to the producers for the next lap
+		record->sequence.store(log_ring_dequeue_pos + LOGGER_RING_SIZE, std::memory_order_release);
+		log_ring_dequeue_pos++;
+
+		cnt++;
+	}
+
+	report_dropped_messages();
+
+	write_batch();
+
+	pthread_mutex_unlock(&mutex_log_output);
+
+	return cnt;
+}
+
+static void* logger_writer_proc(void* arg) {
+	(void)arg;
+
+	while (true) {
+		if (drain_ring(LOGGER_WRITER_BATCH) == 0) {
+			if (flag_writer_stop.load(std::memory_order_acquire))
+				break;
+
+			usleep(LOGGER_WRITER_IDLE_USEC);
+		}
+	}
+
+	return NULL;
+}
+
+static void reset_ring() {
+	for (size_t i = 0; i < LOGGER_RING_SIZE; i++) {
+		log_ring[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	log_ring_enqueue_pos.store(0, std::memory_order_relaxed);
+	log_ring_dequeue_pos = 0;
+}
+
+static void logger_shutdown() {
+	if (flag_writer_running.load(std::memory_order_acquire)) {
+		flag_writer_stop.store(true, std::memory_order_release);
+
+		pthread_join(writer_thread, NULL);
+
+		flag_writer_running.store(false, std::memory_order_release);
+	}
+
+	drain_ring(LOGGER_RING_SIZE);
+}
+
+static void logger_atfork_prepare() {
+	pthread_mutex_lock(&mutex_log_config);
+	pthread_mutex_lock(&mutex_log_output);
+
+	// Do not let the child inherit buffered output
+	fflush((log_output != NULL) ? log_output : stdout);
+}
+
+static void logger_atfork_parent() {
+	pthread_mutex_unlock(&mutex_log_output);
+	pthread_mutex_unlock(&mutex_log_config);
+}
+
+static void logger_atfork_child() {
+	// The writer thread does not exist in the child.  Records still queued
+	// belong to the parent, which writes them itself.
+	flag_writer_running.store(false, std::memory_order_relaxed);
+	flag_writer_stop.store(false, std::memory_order_relaxed);
+
+	reset_ring();
+
+	pthread_mutex_unlock(&mutex_log_output);
+	pthread_mutex_unlock(&mutex_log_config);
+}
+
+/*
+ * Start the writer thread on first use.
+ *
+ * Return true if the writer thread is running.
+ */
+static bool start_writer_thread() {
+	if (flag_writer_running.load(std::memory_order_acquire))
+		return true;
+
+	bool retValue = false;
+
+	pthread_mutex_lock(&mutex_log_config);
+
+	if (!flag_logger_registered) {
+		reset_ring();
+
+		atexit(logger_shutdown);
+		pthread_atfork(logger_atfork_prepare, logger_atfork_parent, logger_atfork_child);
+
+		__atomic_store_n(&flag_logger_registered, true, __ATOMIC_RELEASE);
+	}
+
+	if (flag_writer_running.load(std::memory_order_relaxed)) {
+		retValue = true;
+	} else {
+		flag_writer_stop.store(false, std::memory_order_relaxed);
+
+		if (pthread_create(&writer_thread, NULL, &logger_writer_proc, NULL) == 0) {
+			flag_writer_running.store(true, std::memory_order_release);
+
+			retValue = true;
+		}
+	}
+
+	pthread_mutex_unlock(&mutex_log_config);
+
+	return retValue;
+}
+
+static void logger_vwrite(const ENUM_Log_Level logLevel, const char* module, const char* fmt, va_list ap) {
+	if (module == NULL)
+		module = LOGGER_DEFAULT_MODULE;
+
+	if (__atomic_load_n(&flag_log_async, __ATOMIC_RELAXED) && start_writer_thread()) {
+		size_t pos = log_ring_enqueue_pos.load(std::memory_order_relaxed);
+		log_record_t* record = NULL;
+
+		while (true) {
+			record = &log_ring[pos & (LOGGER_RING_SIZE - 1)];
+
+			const size_t sequence = record->sequence.load(std::memory_order_acquire);
+			const long diff = (long)sequence - (long)pos;
+
+			if (diff == 0) {
+				if (log_ring_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				// Ring buffer is full.  Never block the caller.
+				log_dropped_count.fetch_add(1, std::memory_order_relaxed);
+
+				return;
+			} else {
+				pos = log_ring_enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		record->level = logLevel;
+		clock_gettime(CLOCK_REALTIME, &record->timestamp);
+		record->thread_id = get_thread_id();
+		snprintf(record->module, LOGGER_MODULE_NAME_SIZE, "%s", module);
+		vsnprintf(record->message, LOGGER_MESSAGE_SIZE, fmt, ap);
+
+		// Publish the record to the writer thread
+		record->sequence.store(pos + 1, std::memory_order_release);
+	} else {
+		char tmpMessage[LOGGER_MESSAGE_SIZE];
+		struct timespec timestamp;
+
+		clock_gettime(CLOCK_REALTIME, &timestamp);
+		vsnprintf(tmpMessage, LOGGER_MESSAGE_SIZE, fmt, ap);
+
+		pthread_mutex_lock(&mutex_log_output);
+
+		emit_record(logLevel, module, get_thread_id(), timestamp, tmpMessage);
+		write_batch();
+
+		pthread_mutex_unlock(&mutex_log_output);
+	}
+}
+
+void logger_write(const ENUM_Log_Level logLevel, const char* module, const char* fmt, ...) {
+	va_list ap;
+
+	va_start(ap, fmt);
+
+	logger_vwrite(logLevel, module, fmt, ap);
+
+	va_end(ap);
+}
+
+void logger_flush() {
+	if (__atomic_load_n(&flag_logger_registered, __ATOMIC_ACQUIRE))
+		drain_ring(LOGGER_RING_SIZE);
+
+	pthread_mutex_lock(&mutex_log_output);
+
+	fflush((log_output != NULL) ? log_output : stdout);
+
+	pthread_mutex_unlock(&mutex_log_output);
 }
 
 /**
@@ -68,6 +656,9 @@ void logger_set_console_log_level(const char* inputStr) {
  * This function is evolved from C printf() function.
  * The [fmt] and [...] arguments are original arguments used in printf() function.
  *
+ * Messages are written through the asynchronous logger under the
+ * LOGGER_DEFAULT_MODULE module.
+ *
  * Parameter
  * logLevel: ENUM_Log_Level type.
  * arg_count: Number of parameters in the fmt string
@@ -75,12 +666,15 @@ void logger_set_console_log_level(const char* inputStr) {
  * ...: Parameters used in fmt string content.
  */
 void logger_printLog(ENUM_Log_Level logLevel, int arg_count, const char* fmt, ...) {
-	if (console_log_level == logLevel) {
+	(void)arg_count; // The format string alone describes the arguments
+
+	if ((logLevel != LOG_LEVEL_DUMMY)
+			&& (logLevel == __atomic_load_n((int*)&console_log_level, __ATOMIC_RELAXED))) {
 		va_list ap;
 
-		va_start(ap, arg_count);
+		va_start(ap, fmt);
 
-	    vprintf(fmt, ap);
+	    logger_vwrite(logLevel, LOGGER_DEFAULT_MODULE, fmt, ap);
 
 	    va_end(ap);
 	}
@@ -38,10 +38,21 @@ using namespace std;
 		LOG_LEVEL(LOG_LEVEL_DUMMY)   \
 		LOG_LEVEL(LOG_LEVEL_INFO)   \
 		LOG_LEVEL(LOG_LEVEL_DEBUG)   \
+		LOG_LEVEL(LOG_LEVEL_ERROR)   \
+		LOG_LEVEL(LOG_LEVEL_WARNING)   \
 
 #define GENERATE_ENUM(ENUM) ENUM,
 #define GENERATE_STRING(STRING) #STRING,
 
+/*
+ * logger_printLog() prints a message when its level equals the console
+ * level, which is LOG_LEVEL_DUMMY (off) by default.
+ *
+ * LOGGER_LOG() emits a message when its level does not exceed the
+ * threshold of its module in the verbosity order of logger_level_rank().
+ * The default threshold is INFO.  A threshold of LOG_LEVEL_DUMMY turns
+ * the output off.
+ */
 enum ENUM_Log_Level {
     FOREACH_LOG_LEVEL(GENERATE_ENUM)
 };
@@ -50,10 +61,131 @@ static const char* ENUM_Log_Level_String[] = {
     FOREACH_LOG_LEVEL(GENERATE_STRING)
 };
 
-const int ENUM_Log_Level_Count = 3;
+const int ENUM_Log_Level_Count = 5;
+
+/*
+ * Position of a level in the verbosity order: OFF 0, ERROR 1, WARNING 2,
+ * INFO 3, DEBUG 4.
+ */
+inline int logger_level_rank(const ENUM_Log_Level logLevel) {
+	switch (logLevel) {
+		case LOG_LEVEL_ERROR:
+			return 1;
+		case LOG_LEVEL_WARNING:
+			return 2;
+		case LOG_LEVEL_INFO:
+			return 3;
+		case LOG_LEVEL_DEBUG:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+/*
+ * Compile-time severity ceiling, as a rank of logger_level_rank().
+ * LOGGER_LOG() statements more verbose than this are removed by the
+ * compiler.  Build with -DLOGGER_COMPILE_LEVEL=2 to keep only errors and
+ * warnings.
+ */
+#ifndef LOGGER_COMPILE_LEVEL
+#define LOGGER_COMPILE_LEVEL 4
+#endif
+
+// Maximum length of one formatted message.  Longer messages are truncated.
+#define LOGGER_MESSAGE_SIZE 1024
+
+// Maximum length of a module name
+#define LOGGER_MODULE_NAME_SIZE 32
 
+// Module name used by logger_printLog()
+#define LOGGER_DEFAULT_MODULE "general"
+
+/*
+ * Rank of the most verbose threshold over the default threshold and every
+ * module override.  Read by logger_is_enabled() so that disabled messages
+ * cost one load.
+ */
+extern int logger_max_enabled_level;
+
+bool logger_is_module_enabled(const ENUM_Log_Level logLevel, const char* module);
+
+inline bool logger_is_enabled(const ENUM_Log_Level logLevel, const char* module) {
+	if ((logLevel == LOG_LEVEL_DUMMY)
+			|| (logger_level_rank(logLevel) > __atomic_load_n(&logger_max_enabled_level, __ATOMIC_RELAXED)))
+		return false;
+
+	return logger_is_module_enabled(logLevel, module);
+}
+
+/*
+ * Log a printf-style message for a module.
+ *
+ * The level check happens before the arguments are evaluated, and levels
+ * above LOGGER_COMPILE_LEVEL compile to nothing.
+ */
+#define LOGGER_LOG(logLevel, module, ...) \
+	do { \
+		if ((logger_level_rank(logLevel) <= LOGGER_COMPILE_LEVEL) && logger_is_enabled((logLevel), (module))) \
+			logger_write((logLevel), (module), __VA_ARGS__); \
+	} while (0)
+
+/*
+ * Configure the logger.
+ *
+ * inputStr is a comma-separated list of tokens:
+ *   <LEVEL>            Console level and default threshold: OFF, ERROR,
+ *                      WARNING, INFO or DEBUG
+ *   <module>=<LEVEL>   Threshold override for one module
+ *   json               Write one JSON object per line
+ *   text               Write plain messages (default)
+ *   sync               Write messages from the calling thread
+ *   async              Queue messages for the background writer (default)
+ *
+ * Example: "WARNING,tg_simulation=DEBUG,json"
+ */
 void logger_set_console_log_level(const char* inputStr);
 
+/*
+ * Set the threshold of one module.
+ *
+ * Return 0 on success, 1 when the level is not recognized or the module
+ * table is full.
+ */
+int logger_set_module_log_level(const char* module, const ENUM_Log_Level logLevel);
+
+void logger_set_json_output(const bool flag);
+
+/*
+ * Select asynchronous output.  When enabled, messages are copied into a
+ * bounded lock-free ring buffer and written by a background thread.  When
+ * the ring buffer is full the message is dropped and counted.
+ */
+void logger_set_async(const bool flag);
+
+/*
+ * Redirect log output to a file.  NULL or an empty string restores stdout.
+ *
+ * Return 0 on success, 1 if the file could not be opened.
+ */
+int logger_set_output_file(const char* pathfilename);
+
+/*
+ * Block until every queued message has been written.
+ */
+void logger_flush();
+
+/*
+ * Number of messages dropped because the ring buffer was full.
+ */
+unsigned long long logger_get_dropped_count();
+
+/*
+ * Format and emit a message.  Callers normally go through LOGGER_LOG().
+ */
+void logger_write(const ENUM_Log_Level logLevel, const char* module, const char* fmt, ...)
+	__attribute__((format(printf, 3, 4)));
+
 /**
  * Print log to stdout
  *
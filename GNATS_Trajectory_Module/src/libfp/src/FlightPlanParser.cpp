@@ -73,6 +73,10 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include <cmath>
 
 #include <typeinfo>
+#include <unordered_map>
+#include <memory>
+
+#include <pthread.h>
 
 using std::string;
 using std::cout;
@@ -85,6 +89,8 @@ using std::upper_bound;
 using std::stringstream;
 using std::find;
 using std::list;
+using std::unordered_map;
+using std::shared_ptr;
 
 using namespace osi;
 using json = nlohmann::json;
@@ -141,6 +147,384 @@ static inline string& trim(string& str) {
 
 #define DEBUG_PARSE2 0
 
+// Set to 1 to re-parse every route cache hit and compare the result with
+// the cached flight plan.
+#define VERIFY_ROUTE_CACHE 0
+
+////////////////////////////////////////////////////////////////////////////////
+// Navdata index and parsed route cache
+//
+// The navdata vectors are loaded once and are not sorted by the keys the
+// parser searches on, so resolving a token used to be a linear find().
+// The index maps each key to the position of the element that find() would
+// return, i.e. the first match in vector order, so lookups return exactly
+// the same element.  The index is rebuilt whenever one of the vectors is
+// reallocated or resized, which also drops the parsed route cache.
+//
+// A built index is never modified.  A rebuild publishes a new index under
+// route_cache_mutex, and every parse keeps a reference to the index it
+// started with, so the maps never change under a running lookup.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct _fp_nav_index_t {
+	_fp_nav_index_t() :
+		sids_data(NULL), sids_size(0),
+		stars_data(NULL), stars_size(0),
+		approaches_data(NULL), approaches_size(0),
+		airways_data(NULL), airways_size(0),
+		waypoints_data(NULL), waypoints_size(0),
+		airports_data(NULL), airports_size(0) {
+	}
+
+	const NatsSid* sids_data;
+	size_t sids_size;
+	const NatsStar* stars_data;
+	size_t stars_size;
+	const NatsApproach* approaches_data;
+	size_t approaches_size;
+	const NatsAirway* airways_data;
+	size_t airways_size;
+	const NatsWaypoint* waypoints_data;
+	size_t waypoints_size;
+	const NatsAirport* airports_data;
+	size_t airports_size;
+
+	unordered_map<string, int> airport_by_code;
+	unordered_map<string, int> airway_by_name;
+	unordered_map<string, int> waypoint_by_name;
+
+	// Position of the first occurrence of each fix in each airway route
+	vector<unordered_map<string, int> > airway_fix_pos;
+
+	// Procedures keyed by "id:name", and the procedure positions per
+	// airport id in vector order for the name prefix searches.
+	unordered_map<string, int> sid_by_key;
+	unordered_map<string, int> star_by_key;
+	unordered_map<string, int> approach_by_key;
+	unordered_map<string, vector<int> > sids_by_id;
+	unordered_map<string, vector<int> > stars_by_id;
+} fp_nav_index_t;
+
+// Index of the current navdata, guarded by route_cache_mutex
+static shared_ptr<const fp_nav_index_t> nav_index;
+
+// Parsed flight plans keyed by the normalized route string, guarded by
+// route_cache_mutex
+static unordered_map<string, FlightPlan> route_cache;
+
+static bool route_cache_enabled = true;
+
+static pthread_mutex_t route_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// An index describing no navdata.  Every lookup through it falls back to
+// the linear search.
+static const fp_nav_index_t empty_nav_index;
+
+// Index used by the lookups of the parse running on this thread
+static __thread const fp_nav_index_t* parse_nav_index = &empty_nav_index;
+
+/*
+ * Makes an index the one used by the lookups of this thread for the
+ * lifetime of the object.  The reference keeps the index alive even if
+ * another thread publishes a new one meanwhile.
+ */
+class NavIndexScope {
+public:
+	NavIndexScope(const shared_ptr<const fp_nav_index_t>& index) :
+		index(index),
+		previous(parse_nav_index) {
+		parse_nav_index = index ? index.get() : &empty_nav_index;
+	}
+
+	~NavIndexScope() {
+		parse_nav_index = previous;
+	}
+
+private:
+	NavIndexScope(const NavIndexScope&);
+	NavIndexScope& operator=(const NavIndexScope&);
+
+	shared_ptr<const fp_nav_index_t> index;
+	const fp_nav_index_t* previous;
+};
+
+static inline string proc_key(const string& id, const string& name) {
+	return id + ":" + name;
+}
+
+template<typename T>
+static void index_procedures(const vector<T>& procs,
+		unordered_map<string, int>& by_key,
+		unordered_map<string, vector<int> >* const by_id) {
+	by_key.clear();
+	if (by_id) by_id->clear();
+
+	for (unsigned int i = 0; i < procs.size(); ++i) {
+		// emplace keeps the first occurrence, like find()
+		by_key.emplace(proc_key(procs.at(i).id, procs.at(i).name), i);
+		if (by_id) (*by_id)[procs.at(i).id].push_back(i);
+	}
+}
+
+/*
+ * Index of the given navdata.  Builds and publishes a new index, and drops
+ * the route cache, if the current one describes other vectors.  Must be
+ * called with route_cache_mutex held.
+ */
+static shared_ptr<const fp_nav_index_t> get_nav_index(const vector<NatsSid>& sids,
+		const vector<NatsStar>& stars,
+		const vector<NatsApproach>& approaches,
+		const vector<NatsAirway>& airways,
+		const vector<NatsWaypoint>& waypoints,
+		const vector<NatsAirport>& airports) {
+	if (nav_index
+			&& (nav_index->sids_data == sids.data()) && (nav_index->sids_size == sids.size())
+			&& (nav_index->stars_data == stars.data()) && (nav_index->stars_size == stars.size())
+			&& (nav_index->approaches_data == approaches.data()) && (nav_index->approaches_size == approaches.size())
+			&& (nav_index->airways_data == airways.data()) && (nav_index->airways_size == airways.size())
+			&& (nav_index->waypoints_data == waypoints.data()) && (nav_index->waypoints_size == waypoints.size())
+			&& (nav_index->airports_data == airports.data()) && (nav_index->airports_size == airports.size())) {
+		return nav_index;
+	}
+
+	route_cache.clear();
+
+	shared_ptr<fp_nav_index_t> index(new fp_nav_index_t());
+
+	for (unsigned int i = 0; i < airports.size(); ++i) {
+		index->airport_by_code.emplace(airports.at(i).code, i);
+	}
+
+	index->airway_fix_pos.assign(airways.size(), unordered_map<string, int>());
+	for (unsigned int i = 0; i < airways.size(); ++i) {
+		index->airway_by_name.emplace(airways.at(i).name, i);
+
+		const vector<string>& route = airways.at(i).route;
+		for (unsigned int j = 0; j < route.size(); ++j) {
+			index->airway_fix_pos.at(i).emplace(route.at(j), j);
+		}
+	}
+
+	for (unsigned int i = 0; i < waypoints.size(); ++i) {
+		index->waypoint_by_name.emplace(waypoints.at(i).name, i);
+	}
+
+	index_procedures<NatsSid>(sids, index->sid_by_key, &index->sids_by_id);
+	index_procedures<NatsStar>(stars, index->star_by_key, &index->stars_by_id);
+	index_procedures<NatsApproach>(approaches, index->approach_by_key, NULL);
+
+	index->sids_data = sids.data();
+	index->sids_size = sids.size();
+	index->stars_data = stars.data();
+	index->stars_size = stars.size();
+	index->approaches_data = approaches.data();
+	index->approaches_size = approaches.size();
+	index->airways_data = airways.data();
+	index->airways_size = airways.size();
+	index->waypoints_data = waypoints.data();
+	index->waypoints_size = waypoints.size();
+	index->airports_data = airports.data();
+	index->airports_size = airports.size();
+
+	nav_index = index;
+
+	return nav_index;
+}
+
+// Same result as find(waypoints, key) where key only carries the name
+static vector<NatsWaypoint>::const_iterator find_waypoint_indexed(const vector<NatsWaypoint>& waypoints,
+		const string& name) {
+	const fp_nav_index_t* const index = parse_nav_index;
+	if ((index->waypoints_data != waypoints.data()) || (index->waypoints_size != waypoints.size())) {
+		NatsWaypoint key;
+		key.name = name;
+		return find(waypoints.begin(), waypoints.end(), key);
+	}
+
+	unordered_map<string, int>::const_iterator it = index->waypoint_by_name.find(name);
+	if (it == index->waypoint_by_name.end())
+		return waypoints.end();
+
+	return waypoints.begin() + it->second;
+}
+
+// Same result as find(airports, key) with key.code = code.  NatsAirport
+// equality also accepts the K, P and C prefixed codes, so the earliest of
+// the four candidates wins.
+static vector<NatsAirport>::const_iterator find_airport_indexed(const vector<NatsAirport>& airports,
+		const string& code) {
+	const fp_nav_index_t* const index = parse_nav_index;
+	if ((index->airports_data != airports.data()) || (index->airports_size != airports.size())) {
+		NatsAirport key;
+		key.code = code;
+		return find(airports.begin(), airports.end(), key);
+	}
+
+	const string candidates[4] = {code, "K"+code, "P"+code, "C"+code};
+
+	int idx_min = -1;
+	for (int i = 0; i < 4; ++i) {
+		unordered_map<string, int>::const_iterator it = index->airport_by_code.find(candidates[i]);
+		if ((it != index->airport_by_code.end()) && ((idx_min < 0) || (it->second < idx_min))) {
+			idx_min = it->second;
+		}
+	}
+
+	if (idx_min < 0)
+		return airports.end();
+
+	return airports.begin() + idx_min;
+}
+
+static vector<NatsAirway>::const_iterator find_airway_indexed(const vector<NatsAirway>& airways,
+		const string& name) {
+	const fp_nav_index_t* const index = parse_nav_index;
+	if ((index->airways_data != airways.data()) || (index->airways_size != airways.size())) {
+		NatsAirway key;
+		key.name = name;
+		return find(airways.begin(), airways.end(), key);
+	}
+
+	unordered_map<string, int>::const_iterator it = index->airway_by_name.find(name);
+	if (it == index->airway_by_name.end())
+		return airways.end();
+
+	return airways.begin() + it->second;
+}
+
+// Position of the first occurrence of fix in the airway route, or
+// route.size() if the fix is not on the airway.
+static int find_airway_fix_indexed(const vector<NatsAirway>& airways,
+		const vector<NatsAirway>::const_iterator& airway,
+		const string& fix) {
+	const fp_nav_index_t* const index = parse_nav_index;
+	if ((index->airways_data != airways.data()) || (index->airways_size != airways.size())) {
+		return find(airway->route.begin(), airway->route.end(), fix) - airway->route.begin();
+	}
+
+	const unordered_map<string, int>& fix_pos = index->airway_fix_pos.at(airway - airways.begin());
+	unordered_map<string, int>::const_iterator it = fix_pos.find(fix);
+	if (it == fix_pos.end())
+		return airway->route.size();
+
+	return it->second;
+}
+
+// Same result as find(procs, key) with key.id = ap and key.name = name.
+// Procedure equality accepts the K, P and C prefixed airport ids.
+template<typename T>
+static typename vector<T>::const_iterator find_procedure_indexed(const vector<T>& procs,
+		const T* const indexed_data,
+		const size_t indexed_size,
+		const unordered_map<string, int>& by_key,
+		const string& ap,
+		const string& name) {
+	if ((indexed_data != procs.data()) || (indexed_size != procs.size())) {
+		T key;
+		key.name = name;
+		key.id = ap;
+		return find(procs.begin(), procs.end(), key);
+	}
+
+	const string candidates[4] = {ap, "K"+ap, "P"+ap, "C"+ap};
+
+	int idx_min = -1;
+	for (int i = 0; i < 4; ++i) {
+		unordered_map<string, int>::const_iterator it = by_key.find(proc_key(candidates[i], name));
+		if ((it != by_key.end()) && ((idx_min < 0) || (it->second < idx_min))) {
+			idx_min = it->second;
+		}
+	}
+
+	if (idx_min < 0)
+		return procs.end();
+
+	return procs.begin() + idx_min;
+}
+
+// Positions of the procedures whose id is ap, "K"+ap or "P"+ap, in vector
+// order.  Returns false if the index does not describe procs.
+template<typename T>
+static bool get_procedures_by_airport(const vector<T>& procs,
+		const T* const indexed_data,
+		const size_t indexed_size,
+		const unordered_map<string, vector<int> >& by_id,
+		const string& ap,
+		vector<int>& positions) {
+	positions.clear();
+
+	if ((indexed_data != procs.data()) || (indexed_size != procs.size()))
+		return false;
+
+	const string candidates[3] = {ap, "K"+ap, "P"+ap};
+	for (int i = 0; i < 3; ++i) {
+		unordered_map<string, vector<int> >::const_iterator it = by_id.find(candidates[i]);
+		if (it != by_id.end()) {
+			positions.insert(positions.end(), it->second.begin(), it->second.end());
+		}
+	}
+	sort(positions.begin(), positions.end());
+
+	return true;
+}
+
+// The route cache key.  A leading "FP_ROUTE " tag does not change the
+// parse result so it is dropped.  Nothing else is normalized: the parser
+// reads the origin and destination by position, so leading, trailing or
+// repeated whitespace and any other prefix can change the parsed route.
+// Such strings keep separate cache entries.
+static string normalize_route_string(const string& fpstr) {
+	if (fpstr.compare(0, strlen("FP_ROUTE "), "FP_ROUTE ") == 0) {
+		return fpstr.substr(strlen("FP_ROUTE "));
+	}
+
+	return fpstr;
+}
+
+#if VERIFY_ROUTE_CACHE
+static bool is_same_flight_plan(const FlightPlan& a, const FlightPlan& b) {
+	if ((a.origin != b.origin) || (a.destination != b.destination)
+			|| (a.initial_target != b.initial_target)
+			|| (a.route.size() != b.route.size()))
+		return false;
+
+	for (unsigned int i = 0; i < a.route.size(); ++i) {
+		const PointWGS84& pa = a.route.at(i);
+		const PointWGS84& pb = b.route.at(i);
+		if ((pa.wpname != pb.wpname) || (pa.latitude != pb.latitude) || (pa.longitude != pb.longitude)
+				|| (pa.procname != pb.procname) || (pa.proctype != pb.proctype)
+				|| (pa.path_n_terminator != pb.path_n_terminator) || (pa.alt_desc != pb.alt_desc)
+				|| (pa.alt_1 != pb.alt_1) || (pa.alt_2 != pb.alt_2) || (pa.speed_lim != pb.speed_lim))
+			return false;
+	}
+
+	return true;
+}
+#endif
+
+void FlightPlanParser::clearRouteCache() {
+	pthread_mutex_lock(&route_cache_mutex);
+
+	route_cache.clear();
+
+	// Force an index rebuild on the next parse.  Parses still running keep
+	// the index they started with.
+	nav_index.reset();
+
+	pthread_mutex_unlock(&route_cache_mutex);
+}
+
+void FlightPlanParser::setRouteCacheEnabled(const bool flag) {
+	pthread_mutex_lock(&route_cache_mutex);
+
+	route_cache_enabled = flag;
+
+	route_cache.clear();
+	nav_index.reset();
+
+	pthread_mutex_unlock(&route_cache_mutex);
+}
+
 FlightPlanParser::FlightPlanParser() {
 }
 
@@ -1038,11 +1422,84 @@ bool FlightPlanParser::parse(const string& acid,
 		 FlightPlan* fpout,
 		 const double altitude,
 		 const double cruiseAltitude) {
-	bool retValue = true; // Default
-
 	if (!fpout)
 		return false;
 
+	// The parsed route only depends on the route string (which carries the
+	// origin, destination and runways) and on the navdata, so flights
+	// sharing a route string share the parse.  Only successful parses are
+	// cached so invalid routes keep reporting their errors.  A cache hit
+	// does not repeat the warnings printed while the route was first
+	// parsed.
+	const string route_key = normalize_route_string(fpstr);
+
+	pthread_mutex_lock(&route_cache_mutex);
+
+	if (!route_cache_enabled) {
+		pthread_mutex_unlock(&route_cache_mutex);
+
+		// Linear navdata searches, nothing cached
+		const shared_ptr<const fp_nav_index_t> no_index;
+		NavIndexScope scope(no_index);
+
+		return parseRoute(acid, fpstr, sids, stars, approaches, airways, waypoints, airports, *fpout);
+	}
+
+	const shared_ptr<const fp_nav_index_t> index = get_nav_index(sids, stars, approaches, airways, waypoints, airports);
+
+	unordered_map<string, FlightPlan>::const_iterator cache_iter = route_cache.find(route_key);
+	if (cache_iter != route_cache.end()) {
+		*fpout = cache_iter->second;
+		fpout->routeString = fpstr;
+
+		pthread_mutex_unlock(&route_cache_mutex);
+
+#if VERIFY_ROUTE_CACHE
+		NavIndexScope scope(index);
+
+		FlightPlan tmpFp;
+		if (!parseRoute(acid, fpstr, sids, stars, approaches, airways, waypoints, airports, tmpFp)
+				|| !is_same_flight_plan(tmpFp, *fpout)) {
+			printf("Aircraft %s: Cached route differs from parsed route %s\n", acid.c_str(), fpstr.c_str());
+		}
+#endif
+
+		return true;
+	}
+
+	pthread_mutex_unlock(&route_cache_mutex);
+
+	FlightPlan tmpFp;
+	{
+		NavIndexScope scope(index);
+
+		if (!parseRoute(acid, fpstr, sids, stars, approaches, airways, waypoints, airports, tmpFp))
+			return false;
+	}
+
+	// A result parsed against an index replaced meanwhile is not cached
+	pthread_mutex_lock(&route_cache_mutex);
+	if (route_cache_enabled && (nav_index == index)) {
+		route_cache.emplace(route_key, tmpFp);
+	}
+	pthread_mutex_unlock(&route_cache_mutex);
+
+	*fpout = tmpFp;
+
+	return true;
+}
+
+bool FlightPlanParser::parseRoute(const string& acid,
+		 const string& fpstr,
+		 const vector<NatsSid>& sids,
+		 const vector<NatsStar>& stars,
+		 const vector<NatsApproach>& approaches,
+		 const vector<NatsAirway>& airways,
+		 const vector<NatsWaypoint>& waypoints,
+		 const vector<NatsAirport>& airports,
+		 FlightPlan& fpout) {
+	bool retValue = true; // Default
+
 	FlightPlan tmpFp;
 
 	string fp = fpstr;
@@ -1057,10 +1514,7 @@ bool FlightPlanParser::parse(const string& acid,
 		origin = fp.substr(0, firstdot);
 	}
 
-	NatsAirport tmporigin; tmporigin.code = origin;
-	vector<NatsAirport>::const_iterator itap = find(airports.begin(),
-											   airports.end(),
-											   tmporigin);
+	vector<NatsAirport>::const_iterator itap = find_airport_indexed(airports, origin);
 	if (itap == airports.end()){
 		printf("Aircraft %s: Origin %s not found.\n",acid.c_str(), origin.c_str());
 		retValue = false;
@@ -1105,8 +1559,7 @@ bool FlightPlanParser::parse(const string& acid,
 		destination = destAndEta.substr(0, pos);
 	}
 
-	NatsAirport tmpdest; tmpdest.code = destination;
-	itap = find(airports.begin(),airports.end(),tmpdest);
+	itap = find_airport_indexed(airports, destination);
 	if (itap == airports.end()){
 		printf("Aircraft %s: Destination %s not found.\n",acid.c_str(), destination.c_str());
 		retValue = false;
@@ -1330,9 +1783,7 @@ bool FlightPlanParser::parse(const string& acid,
 
 		NatsAirway airway_key;
 		airway_key.name = ss.str();
-		vector<NatsAirway>::const_iterator awIter = find(airways.begin(),
-				                                           airways.end(),
-				                                           airway_key);
+		vector<NatsAirway>::const_iterator awIter = find_airway_indexed(airways, airway_key.name);
 		if (awIter != airways.end() && awIter->name == airway_key.name) {
 			if (j < 1 ){
 				cout << " Wrong position of jet route. Please put atleast one waypoint before jet route" << endl;
@@ -1342,23 +1793,31 @@ bool FlightPlanParser::parse(const string& acid,
 
 			string aw_start = tokens.at(j-1);
 			string aw_end = tokens.at(j+1);
-			if (
-					find(airway->route.begin(),airway->route.end(),aw_start) == airway->route.end()
-				){
+			const int aw_start_index = find_airway_fix_indexed(airways, awIter, aw_start);
+			const int aw_end_index = find_airway_fix_indexed(airways, awIter, aw_end);
+			if (aw_start_index == (int)airway->route.size()) {
 				printf("ERROR: Airway %s does not have waypoint %s. Please fix flight plan.\n",
 						airway->name.c_str(),aw_start.c_str());
 				return false;
 			}
-			else if (
-					find(airway->route.begin(),airway->route.end(),aw_end) == airway->route.end()
-				){
+			else if (aw_end_index == (int)airway->route.size()) {
 				printf("ERROR:Airway %s does not have waypoint %s. Please fix flight plan.\n",
 						airway->name.c_str(),aw_end.c_str());
 				return false;
 			}
 
+			// Both fixes are on the airway so this is the slice
+			// NatsAirway::getRouteSegment() would produce.
 			vector<string> airway_seg;
-			airway->getRouteSegment(aw_start, aw_end,&airway_seg);
+			if (aw_start_index <= aw_end_index) {
+				airway_seg.insert(airway_seg.end(),
+								airway->route.begin()+aw_start_index,
+								airway->route.begin()+aw_end_index);
+			} else {
+				for (int k = aw_start_index; k >= aw_end_index; --k) {
+					airway_seg.push_back(airway->route.at(k));
+				}
+			}
 
 			FpRouteElement elem;
 			elem.identifier = airway->name;
@@ -1637,24 +2096,24 @@ bool FlightPlanParser::parse(const string& acid,
 					proctype = "SID";
 					procname = sid->name;
 
-					vector<string> wplist = sid->wp_map[sid_leg.at(k)];
-					vector<string>::iterator it = find(wplist.begin(),
+					const vector<string>& wplist = sid->wp_map[sid_leg.at(k)];
+					vector<string>::const_iterator it = find(wplist.begin(),
 							wplist.end(), wp);
 
 					//CONSTRAINTS
-					vector<pair<string,string> > path_term_v = sid->path_term[sid_leg.at(k)];
-					vector<pair<string,string> > alt_desc_v = sid->alt_desc[sid_leg.at(k)];
-					vector<pair<string,double> > alt_1_v = sid->alt_1[sid_leg.at(k)];
-					vector<pair<string,double> > alt_2_v = sid->alt_2[sid_leg.at(k)];
-					vector<pair<string,double> > spd_limit_v = sid->spd_limit[sid_leg.at(k)];
+					const vector<pair<string,string> >& path_term_v = sid->path_term[sid_leg.at(k)];
+					const vector<pair<string,string> >& alt_desc_v = sid->alt_desc[sid_leg.at(k)];
+					const vector<pair<string,double> >& alt_1_v = sid->alt_1[sid_leg.at(k)];
+					const vector<pair<string,double> >& alt_2_v = sid->alt_2[sid_leg.at(k)];
+					const vector<pair<string,double> >& spd_limit_v = sid->spd_limit[sid_leg.at(k)];
 
 					//FOR NATS
-					vector<pair<string,string> > recco_navaid_v = sid->recco_nav[sid_leg.at(k)];
-					vector<pair<string,double> > theta_v = sid->theta[sid_leg.at(k)];
-					vector<pair<string,double> > rho_v = sid->rho[sid_leg.at(k)];
-					vector<pair<string,double> > mag_course_v = sid->mag_course[sid_leg.at(k)];
-					vector<pair<string,double> > rt_dist_v = sid->rt_dist[sid_leg.at(k)];
-					vector<pair<string,string> > spdlim_desc_v = sid->spdlim_desc[sid_leg.at(k)];
+					const vector<pair<string,string> >& recco_navaid_v = sid->recco_nav[sid_leg.at(k)];
+					const vector<pair<string,double> >& theta_v = sid->theta[sid_leg.at(k)];
+					const vector<pair<string,double> >& rho_v = sid->rho[sid_leg.at(k)];
+					const vector<pair<string,double> >& mag_course_v = sid->mag_course[sid_leg.at(k)];
+					const vector<pair<string,double> >& rt_dist_v = sid->rt_dist[sid_leg.at(k)];
+					const vector<pair<string,string> >& spdlim_desc_v = sid->spdlim_desc[sid_leg.at(k)];
 
 					if (it != wplist.end()) {
 						int idx = it - wplist.begin();
@@ -1778,24 +2237,24 @@ bool FlightPlanParser::parse(const string& acid,
 					proctype = "STAR";
 					procname = star->name;
 
-					vector<string> wplist = star->wp_map[star_leg.at(k)];
-					vector<string>::iterator it = find(wplist.begin(),wplist.end(),
+					const vector<string>& wplist = star->wp_map[star_leg.at(k)];
+					vector<string>::const_iterator it = find(wplist.begin(),wplist.end(),
 							wp);
 
 					//CONSTRAINTS
-					vector<pair<string,string> > path_term_v = star->path_term[star_leg.at(k)];
-					vector<pair<string,string> > alt_desc_v = star->alt_desc[star_leg.at(k)];
-					vector<pair<string,double> > alt_1_v = star->alt_1[star_leg.at(k)];
-					vector<pair<string,double> > alt_2_v = star->alt_2[star_leg.at(k)];
-					vector<pair<string,double> > spd_limit_v = star->spd_limit[star_leg.at(k)];
+					const vector<pair<string,string> >& path_term_v = star->path_term[star_leg.at(k)];
+					const vector<pair<string,string> >& alt_desc_v = star->alt_desc[star_leg.at(k)];
+					const vector<pair<string,double> >& alt_1_v = star->alt_1[star_leg.at(k)];
+					const vector<pair<string,double> >& alt_2_v = star->alt_2[star_leg.at(k)];
+					const vector<pair<string,double> >& spd_limit_v = star->spd_limit[star_leg.at(k)];
 
 					//FOR NATS
-					vector<pair<string,string> > recco_navaid_v = star->recco_nav[star_leg.at(k)];
-					vector<pair<string,double> > theta_v = star->theta[star_leg.at(k)];
-					vector<pair<string,double> > rho_v = star->rho[star_leg.at(k)];
-					vector<pair<string,double> > mag_course_v = star->mag_course[star_leg.at(k)];
-					vector<pair<string,double> > rt_dist_v = star->rt_dist[star_leg.at(k)];
-					vector<pair<string,string> > spdlim_desc_v = star->spdlim_desc[star_leg.at(k)];
+					const vector<pair<string,string> >& recco_navaid_v = star->recco_nav[star_leg.at(k)];
+					const vector<pair<string,double> >& theta_v = star->theta[star_leg.at(k)];
+					const vector<pair<string,double> >& rho_v = star->rho[star_leg.at(k)];
+					const vector<pair<string,double> >& mag_course_v = star->mag_course[star_leg.at(k)];
+					const vector<pair<string,double> >& rt_dist_v = star->rt_dist[star_leg.at(k)];
+					const vector<pair<string,string> >& spdlim_desc_v = star->spdlim_desc[star_leg.at(k)];
 
 					if (it != wplist.end()) {
 						int idx = it- wplist.begin();
@@ -1832,23 +2291,23 @@ bool FlightPlanParser::parse(const string& acid,
 				for (size_t k=0; k<app_leg.size(); ++k) {
 					proctype = "APPROACH";
 					procname = approach->name;
-					vector<string> wplist = approach->wp_map[app_leg.at(k)];
-					vector<string>::iterator it = find(wplist.begin(),wplist.end(),wp);
+					const vector<string>& wplist = approach->wp_map[app_leg.at(k)];
+					vector<string>::const_iterator it = find(wplist.begin(),wplist.end(),wp);
 
 					//CONSTRAINTS
-					vector<pair<string,string> > path_term_v = approach->path_term[app_leg.at(k)];
-					vector<pair<string,string> > alt_desc_v = approach->alt_desc[app_leg.at(k)];
-					vector<pair<string,double> > alt_1_v = approach->alt_1[app_leg.at(k)];
-					vector<pair<string,double> > alt_2_v = approach->alt_2[app_leg.at(k)];
-					vector<pair<string,double> > spd_limit_v = approach->spd_limit[app_leg.at(k)];
+					const vector<pair<string,string> >& path_term_v = approach->path_term[app_leg.at(k)];
+					const vector<pair<string,string> >& alt_desc_v = approach->alt_desc[app_leg.at(k)];
+					const vector<pair<string,double> >& alt_1_v = approach->alt_1[app_leg.at(k)];
+					const vector<pair<string,double> >& alt_2_v = approach->alt_2[app_leg.at(k)];
+					const vector<pair<string,double> >& spd_limit_v = approach->spd_limit[app_leg.at(k)];
 
 					//FOR NATS
-					vector<pair<string,string> > recco_navaid_v = approach->recco_nav[app_leg.at(k)];
-					vector<pair<string,double> > theta_v = approach->theta[app_leg.at(k)];
-					vector<pair<string,double> > rho_v = approach->rho[app_leg.at(k)];
-					vector<pair<string,double> > mag_course_v = approach->mag_course[app_leg.at(k)];
-					vector<pair<string,double> > rt_dist_v = approach->rt_dist[app_leg.at(k)];
-					vector<pair<string,string> > spdlim_desc_v = approach->spdlim_desc[app_leg.at(k)];
+					const vector<pair<string,string> >& recco_navaid_v = approach->recco_nav[app_leg.at(k)];
+					const vector<pair<string,double> >& theta_v = approach->theta[app_leg.at(k)];
+					const vector<pair<string,double> >& rho_v = approach->rho[app_leg.at(k)];
+					const vector<pair<string,double> >& mag_course_v = approach->mag_course[app_leg.at(k)];
+					const vector<pair<string,double> >& rt_dist_v = approach->rt_dist[app_leg.at(k)];
+					const vector<pair<string,string> >& spdlim_desc_v = approach->spdlim_desc[app_leg.at(k)];
 
 					if (it != wplist.end()) {
 						wp = *it;
@@ -1922,9 +2381,7 @@ bool FlightPlanParser::parse(const string& acid,
 				wpKey.name = wp;
 
 				vector<NatsWaypoint>::const_iterator wpIter =
-						find(waypoints.begin(),
-								    waypoints.end(),
-								    wpKey);
+						find_waypoint_indexed(waypoints, wpKey.name);
 				if (wpIter != waypoints.end() && wpIter->name == wpKey.name) {
 					fixLat = wpIter->latitude;
 					fixLon = wpIter->longitude;
@@ -2160,11 +2617,8 @@ bool FlightPlanParser::parse(const string& acid,
 				//IF THE FLIGHT PLAN CONTAINS ONLY ENROUTE POINTS THEN ADD
 				// POINT ON THE SURFACE FOR THE ARRIVAL AIRPORT
 
-				NatsAirport dest_ap;
-				dest_ap.code =destination;
-
 				vector<NatsAirport>::const_iterator itap =
-						find(airports.begin(), airports.end(), dest_ap);
+						find_airport_indexed(airports, destination);
 
 				if (itap != airports.end()){
 
@@ -2211,7 +2665,7 @@ bool FlightPlanParser::parse(const string& acid,
 			tmpFp.initial_target.assign(initial_target);
 		}
 
-		*fpout = tmpFp;
+		fpout = tmpFp;
 	}
 
 	return retValue;
@@ -2800,13 +3254,12 @@ static NatsApproach* parse_approach(string& str,
 		remaining = remaining.substr(pos);
 		ptr += pos;
 
-		NatsApproach key;
-		key.name = remaining;
-		key.id = ap;
-
-		vector<NatsApproach>::const_iterator iter = find(g_approaches.begin(),
-						g_approaches.end(),
-						key);
+		vector<NatsApproach>::const_iterator iter = find_procedure_indexed<NatsApproach>(g_approaches,
+						parse_nav_index->approaches_data,
+						parse_nav_index->approaches_size,
+						parse_nav_index->approach_by_key,
+						ap,
+						remaining);
 		if(iter != g_approaches.end()) {
 			if(iter->name == remaining) {
 				approach = const_cast<NatsApproach*>(&(*iter));
@@ -2851,9 +3304,12 @@ static NatsStar* parse_star(string& str, const vector<NatsStar>& g_stars,
 		key.name = remaining;
 		key.id = ap;
 		
-		vector<NatsStar>::const_iterator iter = find(g_stars.begin(),
-				g_stars.end(),
-				key);
+		vector<NatsStar>::const_iterator iter = find_procedure_indexed<NatsStar>(g_stars,
+				parse_nav_index->stars_data,
+				parse_nav_index->stars_size,
+				parse_nav_index->star_by_key,
+				key.id,
+				key.name);
 		if(iter != g_stars.end()) {
 			if(iter->name == remaining) {
 				star = const_cast<NatsStar*>(&(*iter));
@@ -2868,15 +3324,32 @@ static NatsStar* parse_star(string& str, const vector<NatsStar>& g_stars,
 			}
 
 			size_t len = key.name.length();
-			for (iter = g_stars.begin();iter != g_stars.end(); ++iter){
-				if ( (strncmp(key.name.c_str(),iter->name.c_str(),len) == 0)
-						&& (key.id == iter->id
-						|| "K"+key.id == iter->id
-						|| "P"+key.id == iter->id
-
-						) ){
-					star = const_cast<NatsStar*>(&(*iter));
-					break;
+			vector<int> positions;
+			if (get_procedures_by_airport<NatsStar>(g_stars,
+					parse_nav_index->stars_data,
+					parse_nav_index->stars_size,
+					parse_nav_index->stars_by_id,
+					key.id,
+					positions)) {
+				// Only the stars of this airport can match
+				for (unsigned int k = 0; k < positions.size(); ++k) {
+					iter = g_stars.begin() + positions.at(k);
+					if (strncmp(key.name.c_str(),iter->name.c_str(),len) == 0) {
+						star = const_cast<NatsStar*>(&(*iter));
+						break;
+					}
+				}
+			} else {
+				for (iter = g_stars.begin();iter != g_stars.end(); ++iter){
+					if ( (strncmp(key.name.c_str(),iter->name.c_str(),len) == 0)
+							&& (key.id == iter->id
+							|| "K"+key.id == iter->id
+							|| "P"+key.id == iter->id
+
+							) ){
+						star = const_cast<NatsStar*>(&(*iter));
+						break;
+					}
 				}
 			}
 		}
@@ -2916,9 +3389,12 @@ static NatsSid* parse_sid(string& str, const vector<NatsSid>& g_sids, const stri
 		key.name = remaining;
 		key.id = ap;
 
-		vector<NatsSid>::const_iterator iter = find(g_sids.begin(),
-				g_sids.end(),
-				key);
+		vector<NatsSid>::const_iterator iter = find_procedure_indexed<NatsSid>(g_sids,
+				parse_nav_index->sids_data,
+				parse_nav_index->sids_size,
+				parse_nav_index->sid_by_key,
+				key.id,
+				key.name);
 		if(iter != g_sids.end()) {
 			if(iter->name == remaining) {
 				sid = const_cast<NatsSid*>(&(*iter));
@@ -2933,15 +3409,33 @@ static NatsSid* parse_sid(string& str, const vector<NatsSid>& g_sids, const stri
 			}
 
 			size_t len = key.name.length();
-			for (iter = g_sids.begin();iter != g_sids.end(); ++iter){
-				if ( (strncmp(key.name.c_str(),iter->name.c_str(),len) == 0)
-						&& (key.id == iter->id
-							|| "K"+key.id == iter->id
-							|| "P"+key.id == iter->id
-							) ){
-					sid = const_cast<NatsSid*>(&(*iter));
+			vector<int> positions;
+			if (get_procedures_by_airport<NatsSid>(g_sids,
+					parse_nav_index->sids_data,
+					parse_nav_index->sids_size,
+					parse_nav_index->sids_by_id,
+					key.id,
+					positions)) {
+				// Only the sids of this airport can match
+				for (unsigned int k = 0; k < positions.size(); ++k) {
+					iter = g_sids.begin() + positions.at(k);
+					if (strncmp(key.name.c_str(),iter->name.c_str(),len) == 0) {
+						sid = const_cast<NatsSid*>(&(*iter));
 
-					break;
+						break;
+					}
+				}
+			} else {
+				for (iter = g_sids.begin();iter != g_sids.end(); ++iter){
+					if ( (strncmp(key.name.c_str(),iter->name.c_str(),len) == 0)
+							&& (key.id == iter->id
+								|| "K"+key.id == iter->id
+								|| "P"+key.id == iter->id
+								) ){
+						sid = const_cast<NatsSid*>(&(*iter));
+
+						break;
+					}
 				}
 			}
 		}
@@ -3029,19 +3523,14 @@ static void populateElement(T* const proc, const deque<string>& tokens,
 				){
 			//Means that the waypoint is not a lat/lon waypoint
 			//It is a waypoint that is not in SID/STAR.
-			NatsWaypoint tmp_wp; tmp_wp.name = curr_wp;
 			vector<NatsWaypoint>::const_iterator it =
-					find(waypoints.begin(), waypoints.end(),
-									tmp_wp);
+					find_waypoint_indexed(waypoints, curr_wp);
 			if (it != waypoints.end()){
 				latf = it->latitude;
 				lonf = it->longitude;
 			}
 			else{
-				NatsAirport tmp_ap; tmp_ap.code = curr_wp;
-				vector<NatsAirport>::const_iterator it = find(airports.begin(),
-																airports.end(),
-																tmp_ap);
+				vector<NatsAirport>::const_iterator it = find_airport_indexed(airports, curr_wp);
 				if (it != airports.end()){
 					latf = it->latitude;
 					lonf = it->longitude;
@@ -3054,10 +3543,8 @@ static void populateElement(T* const proc, const deque<string>& tokens,
 
 		double m_dist = 1e10; int idx = -1;
 		for (size_t k = 0;k < proc->waypoints.size(); ++k){
-			NatsWaypoint tmp_wp; tmp_wp.name = proc->waypoints.at(k);
-			vector<NatsWaypoint>::const_iterator it = find(waypoints.begin(),
-															waypoints.end(),
-															tmp_wp);
+			vector<NatsWaypoint>::const_iterator it = find_waypoint_indexed(waypoints,
+															proc->waypoints.at(k));
 			double latt=0,lont=0;
 			if (it != waypoints.end()){
 				latt = it->latitude;
@@ -3446,10 +3933,7 @@ static void populateApproachElement(NatsApproach* const app,
 	legs.clear();
 	elem.sequence.clear();
 	elem.identifier = app->name;
-	NatsWaypoint star_wp; star_wp.name = star_end;
-
-	vector<NatsWaypoint>::const_iterator iter = find(waypoints.begin(),
-			waypoints.end(),star_wp);
+	vector<NatsWaypoint>::const_iterator iter = find_waypoint_indexed(waypoints, star_end);
 
 	double lat=0,lon=0;
 	if (iter != waypoints.end()) {
@@ -3555,8 +4039,7 @@ static void populateApproachElement(NatsApproach* const app,
 					break;
 				}
 				else{
-					iter = find(waypoints.begin(),
-							waypoints.end(),wp);
+					iter = find_waypoint_indexed(waypoints, wp.name);
 
 					double wplat = iter->latitude;
 					double wplon = iter->longitude;
@@ -65,6 +65,11 @@ public:
 	FlightPlanParser();
 	virtual ~FlightPlanParser();
 	
+	/*
+	 * Parse a route string against the navdata.  Successful parses are
+	 * cached by route string, and a cached route is returned without
+	 * repeating the warnings printed when it was first parsed.
+	 */
 	bool parse(const string& acid,
 					const string& fpstr,
 					const vector<NatsSid>& sids,
@@ -83,6 +88,30 @@ public:
 			 FlightPlan& fpout,
 			 const double altitude,
 			 const double cruiseAltitude);
+
+	/*
+	 * Drop all parsed routes cached by parse() and force the navdata
+	 * index to be rebuilt.  Call this after the navdata is reloaded.
+	 */
+	static void clearRouteCache();
+
+	/*
+	 * Enable or disable the parsed route cache and the navdata index
+	 * (enabled by default).  When disabled, parse() resolves every route
+	 * with linear searches of the navdata vectors.
+	 */
+	static void setRouteCacheEnabled(const bool flag);
+
+private:
+	bool parseRoute(const string& acid,
+					const string& fpstr,
+					const vector<NatsSid>& sids,
+					const vector<NatsStar>& stars,
+					const vector<NatsApproach>& approaches,
+					const vector<NatsAirway>& airways,
+					const vector<NatsWaypoint>& waypoints,
+					const vector<NatsAirport>& airports,
+					FlightPlan& fpout);
 };
 
 #endif  /* __FLIGHTPLANPARSER_H__ */
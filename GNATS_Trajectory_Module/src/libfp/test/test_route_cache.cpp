@@ -0,0 +1,345 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_route_cache.cpp
+ *
+ * Regression test of the parsed route cache and the navdata index.
+ *
+ * Every route of the corpus is parsed against a small synthetic navdata
+ * set with linear navdata searches (cache disabled), and then twice with
+ * the cache enabled, so that the second parse is served from the cache.
+ * All three flight plans must be identical, field by field.  The corpus
+ * is then parsed from several threads while another thread keeps
+ * clearing the cache, and every result must still match.
+ *
+ * Usage: test_route_cache [corpus file]
+ */
+
+#include "FlightPlanParser.h"
+#include "FlightPlan.h"
+#include "PointWGS84.h"
+#include "AirportLayoutDataLoader.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+
+using namespace std;
+
+#define NUM_PARSE_THREADS 4
+#define NUM_PARSE_ROUNDS 20
+
+static vector<NatsSid> test_sids;
+static vector<NatsPar> test_pars;
+static vector<NatsStar> test_stars;
+static vector<NatsApproach> test_approaches;
+static vector<NatsAirway> test_airways;
+static vector<NatsWaypoint> test_waypoints;
+static vector<NatsAirport> test_airports;
+
+static vector<string> corpus;
+
+// Reference parse of each corpus route, empty if the parse failed
+static vector<string> reference;
+
+static volatile bool flag_parsing = false;
+
+static void add_waypoint(const string& name, const double latitude, const double longitude) {
+	NatsWaypoint wp;
+	wp.name = name;
+	wp.latitude = latitude;
+	wp.longitude = longitude;
+	test_waypoints.push_back(wp);
+}
+
+static void add_airport(const string& code, const double latitude, const double longitude, const double elevation) {
+	NatsAirport ap;
+	ap.code = code;
+	ap.name = code;
+	ap.latitude = latitude;
+	ap.longitude = longitude;
+	ap.elevation = elevation;
+	test_airports.push_back(ap);
+
+	// parseRoute() only accepts airports with a surface layout
+	map_ground_waypoint_connectivity[code];
+}
+
+static void add_airway(const string& name, const char* const fixes[], const int num_fixes) {
+	NatsAirway aw;
+	aw.name = name;
+	aw.route.assign(fixes, fixes + num_fixes);
+	test_airways.push_back(aw);
+}
+
+/*
+ * Add a leg to a procedure with a constraint entry for every fix, the
+ * way the navdata loader stores them.
+ */
+template<typename T>
+static void add_leg(T& proc, const string& leg, const char* const fixes[], const int num_fixes) {
+	for (int i = 0; i < num_fixes; i++) {
+		const string wp(fixes[i]);
+
+		proc.wp_map[leg].push_back(wp);
+		if (find(proc.waypoints.begin(), proc.waypoints.end(), wp) == proc.waypoints.end())
+			proc.waypoints.push_back(wp);
+
+		proc.route_to_trans_rttype[leg] = make_pair(leg, string("1"));
+		proc.path_term[leg].push_back(make_pair(wp, string((i == 0) ? "IF" : "TF")));
+		proc.alt_desc[leg].push_back(make_pair(wp, string("NONE")));
+		proc.alt_1[leg].push_back(make_pair(wp, 1000.0 * (i + 1)));
+		proc.alt_2[leg].push_back(make_pair(wp, -10000.0));
+		proc.spd_limit[leg].push_back(make_pair(wp, 250.0));
+		proc.recco_nav[leg].push_back(make_pair(wp, string("NONE")));
+		proc.theta[leg].push_back(make_pair(wp, -1000.0));
+		proc.rho[leg].push_back(make_pair(wp, -1000.0));
+		proc.mag_course[leg].push_back(make_pair(wp, 10.0 * i));
+		proc.rt_dist[leg].push_back(make_pair(wp, 5.0 * i));
+		proc.spdlim_desc[leg].push_back(make_pair(wp, string("NONE")));
+	}
+}
+
+#define NUM_FIXES(fixes) ((int)(sizeof(fixes) / sizeof(fixes[0])))
+
+/*
+ * Synthetic navdata.  It has duplicate waypoint names, an airway passing
+ * a fix twice, airport codes reached through the K, P and C prefixes and
+ * procedures found by name prefix, so the index has to reproduce the
+ * first-match rules of find().
+ */
+static void build_navdata() {
+	add_airport("CDDD", 45.0, -75.0, 300);
+	add_airport("KAAA", 37.6, -122.4, 13);
+	add_airport("KBBB", 33.9, -118.4, 125);
+	add_airport("PBBB", 21.3, -157.9, 13);
+	add_airport("PEEE", 61.2, -150.0, 151);
+	sort(test_airports.begin(), test_airports.end());
+
+	add_waypoint("ALPHA", 37.70, -122.60);
+	add_waypoint("BRAVO", 37.50, -122.00);
+	add_waypoint("CHRLY", 37.20, -121.50);
+	add_waypoint("CHRLY", 10.00, 10.00);
+	add_waypoint("DELTA", 34.60, -119.20);
+	add_waypoint("ECHOO", 34.30, -118.90);
+	add_waypoint("FOXXX", 34.10, -118.70);
+	add_waypoint("GOLFF", 34.00, -118.55);
+	add_waypoint("HOTEL", 36.50, -120.80);
+	add_waypoint("INDIA", 35.80, -120.20);
+	add_waypoint("JULIE", 35.40, -119.10);
+	add_waypoint("KILOO", 35.00, -118.20);
+	add_waypoint("LIMAA", 40.00, -110.00);
+	add_waypoint("MIKEE", 41.00, -100.00);
+	add_waypoint("NOVMB", 43.00, -85.00);
+	add_waypoint("RW24R-KBBB", 33.95, -118.40);
+	add_waypoint("RW28L-KAAA", 37.61, -122.36);
+	add_waypoint("RW28R-KAAA", 37.62, -122.37);
+	stable_sort(test_waypoints.begin(), test_waypoints.end());
+
+	const char* const j1[] = {"CHRLY", "HOTEL", "INDIA", "DELTA"};
+	const char* const j2[] = {"INDIA", "JULIE", "KILOO"};
+	const char* const v27[] = {"LIMAA", "MIKEE", "LIMAA", "NOVMB"};
+	add_airway("J1", j1, NUM_FIXES(j1));
+	add_airway("J2", j2, NUM_FIXES(j2));
+	add_airway("J2", j1, NUM_FIXES(j1));
+	add_airway("V27", v27, NUM_FIXES(v27));
+
+	const char* const porte_rw28l[] = {"RW28L-KAAA", "ALPHA", "BRAVO"};
+	const char* const porte_rw28r[] = {"RW28R-KAAA", "ALPHA", "BRAVO"};
+	const char* const porte_bravo[] = {"BRAVO", "CHRLY"};
+	NatsSid sid;
+	sid.id = "KAAA";
+	sid.name = "PORTE3";
+	add_leg(sid, "RW28L-KAAA", porte_rw28l, NUM_FIXES(porte_rw28l));
+	add_leg(sid, "RW28R-KAAA", porte_rw28r, NUM_FIXES(porte_rw28r));
+	add_leg(sid, "BRAVO", porte_bravo, NUM_FIXES(porte_bravo));
+	test_sids.push_back(sid);
+
+	NatsSid other_sid(sid);
+	other_sid.id = "PBBB";
+	test_sids.push_back(other_sid);
+
+	const char* const serfr_delta[] = {"DELTA", "ECHOO", "FOXXX"};
+	NatsStar star;
+	star.id = "KBBB";
+	star.name = "SERFR1";
+	add_leg(star, "DELTA", serfr_delta, NUM_FIXES(serfr_delta));
+	test_stars.push_back(star);
+
+	const char* const i24r_foxxx[] = {"FOXXX", "GOLFF", "RW24R-KBBB"};
+	NatsApproach approach;
+	approach.id = "KBBB";
+	approach.name = "I24R";
+	add_leg(approach, "FOXXX", i24r_foxxx, NUM_FIXES(i24r_foxxx));
+	test_approaches.push_back(approach);
+}
+
+// All parse results in one string, so that any difference shows up
+static string describe_flight_plan(const FlightPlan& fp) {
+	string retString;
+	char buf[1024];
+
+	snprintf(buf, sizeof(buf), "origin %s destination %s initial_target %s route %d\n",
+			fp.origin.c_str(), fp.destination.c_str(), fp.initial_target.c_str(), (int)fp.route.size());
+	retString.append(buf);
+
+	for (unsigned int i = 0; i < fp.route.size(); i++) {
+		const PointWGS84& pt = fp.route.at(i);
+
+		snprintf(buf, sizeof(buf), "  %s %.17g %.17g %.17g %s %s %s %s %.17g %.17g %.17g %s %.17g %.17g %.17g %.17g %s %.17g %s %s\n",
+				pt.wpname.c_str(), pt.latitude, pt.longitude, pt.alt,
+				pt.procname.c_str(), pt.proctype.c_str(), pt.path_n_terminator.c_str(), pt.alt_desc.c_str(),
+				pt.alt_1, pt.alt_2, pt.speed_lim,
+				pt.recco_navaid.c_str(), pt.theta, pt.rho, pt.mag_course, pt.rt_dist, pt.spdlim_desc.c_str(),
+				pt.wp_cat, pt.phase.c_str(), pt.type.c_str());
+		retString.append(buf);
+	}
+
+	return retString;
+}
+
+static string parse_route(FlightPlanParser& parser, const string& route) {
+	FlightPlan fp;
+	if (!parser.parse("TEST1", route, test_sids, test_pars, test_stars, test_approaches,
+			test_airways, test_waypoints, test_airports, &fp))
+		return "";
+
+	return describe_flight_plan(fp);
+}
+
+static int load_corpus(const string& fname) {
+	ifstream in(fname.c_str());
+	if (!in.is_open()) {
+		printf("Can't open corpus file %s\n", fname.c_str());
+
+		return -1;
+	}
+
+	string line;
+	while (getline(in, line)) {
+		if ((line.length() == 0) || (line.at(0) == '#'))
+			continue;
+
+		corpus.push_back(line);
+	}
+
+	return 0;
+}
+
+static void* parse_proc(void* arg) {
+	int* const num_mismatches = (int*)arg;
+
+	FlightPlanParser parser;
+	for (int round = 0; round < NUM_PARSE_ROUNDS; round++) {
+		for (unsigned int i = 0; i < corpus.size(); i++) {
+			if (parse_route(parser, corpus.at(i)) != reference.at(i))
+				(*num_mismatches)++;
+		}
+	}
+
+	return NULL;
+}
+
+static void* clear_proc(void* arg) {
+	(void)arg;
+
+	while (flag_parsing) {
+		FlightPlanParser::clearRouteCache();
+	}
+
+	return NULL;
+}
+
+int main(int argc, char* argv[]) {
+	const string corpus_file = (argc > 1) ? argv[1] : "route_corpus.txt";
+	if (load_corpus(corpus_file) != 0)
+		return 1;
+
+	build_navdata();
+
+	FlightPlanParser parser;
+
+	int num_parsed = 0;
+	int num_failures = 0;
+
+	for (unsigned int i = 0; i < corpus.size(); i++) {
+		FlightPlanParser::setRouteCacheEnabled(false);
+		const string uncached = parse_route(parser, corpus.at(i));
+
+		FlightPlanParser::setRouteCacheEnabled(true);
+		const string first = parse_route(parser, corpus.at(i));
+		const string cached = parse_route(parser, corpus.at(i));
+
+		reference.push_back(uncached);
+
+		if (uncached.length() > 0)
+			num_parsed++;
+
+		if ((first != uncached) || (cached != uncached)) {
+			printf("FAILED: %s\n", corpus.at(i).c_str());
+			printf("  uncached:\n%s  indexed:\n%s  cached:\n%s", uncached.c_str(), first.c_str(), cached.c_str());
+			num_failures++;
+		}
+	}
+
+	// Concurrent parses while the cache and the index are dropped
+	flag_parsing = true;
+
+	pthread_t clear_thread;
+	pthread_create(&clear_thread, NULL, clear_proc, NULL);
+
+	pthread_t parse_threads[NUM_PARSE_THREADS];
+	int num_mismatches[NUM_PARSE_THREADS];
+	for (int t = 0; t < NUM_PARSE_THREADS; t++) {
+		num_mismatches[t] = 0;
+		pthread_create(&parse_threads[t], NULL, parse_proc, &num_mismatches[t]);
+	}
+
+	for (int t = 0; t < NUM_PARSE_THREADS; t++) {
+		pthread_join(parse_threads[t], NULL);
+		if (num_mismatches[t] > 0) {
+			printf("FAILED: %d concurrent parses of thread %d differ from the reference\n", num_mismatches[t], t);
+			num_failures++;
+		}
+	}
+
+	flag_parsing = false;
+	pthread_join(clear_thread, NULL);
+
+	printf("test_route_cache: %d routes, %d parsed, %d failures\n", (int)corpus.size(), num_parsed, num_failures);
+
+	return (num_failures == 0) ? 0 : 1;
+}
@@ -48,6 +48,10 @@ using std::endl;
 
 namespace osi {
 
+// Slack added to bounding cap tests, about 6 m on the earth surface, so
+// that rounding in the exact great-circle tests is never rejected early.
+#define POLYGON_CAP_TOLERANCE_RAD 1e-6
+
 static void max_value(const double* const array, const int& length, double* const max) {
 	if(!max) return;
 	*max = -999999999999;
@@ -88,6 +92,70 @@ static void compute_centroid(const double* const xdata,
 	*y_centroid = y_sum / num_points;
 }
 
+static void latlon_to_unit_vector(const double& lat_deg, const double& lon_deg, double* const v) {
+	double lat = lat_deg * M_PI / 180.;
+	double lon = lon_deg * M_PI / 180.;
+
+	v[0] = cos(lat) * cos(lon);
+	v[1] = cos(lat) * sin(lon);
+	v[2] = sin(lat);
+}
+
+static double angle_between(const double* const a, const double* const b) {
+	double dot = a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+	if(dot > 1.) dot = 1.;
+	if(dot < -1.) dot = -1.;
+	return acos(dot);
+}
+
+/*
+ * Compute the smallest-effort bounding cap of the vertices: centered on
+ * the normalized vertex sum, with the radius of the farthest vertex.  A
+ * cap of a hemisphere or more does not contain the great-circle edges
+ * between its points, so such polygons are left unbounded.
+ */
+static void compute_bounding_cap(const double* const xdata,
+		                         const double* const ydata,
+		                         const int& num_points,
+		                         double* const center,
+		                         double* const radius) {
+	center[0] = 0;
+	center[1] = 0;
+	center[2] = 1;
+	*radius = M_PI;
+
+	if(num_points < 1) return;
+
+	double sum[3] = {0, 0, 0};
+	for(int i=0; i<num_points; ++i) {
+		double v[3];
+		latlon_to_unit_vector(ydata[i], xdata[i], v);
+		sum[0] += v[0];
+		sum[1] += v[1];
+		sum[2] += v[2];
+	}
+
+	double norm = sqrt(sum[0]*sum[0] + sum[1]*sum[1] + sum[2]*sum[2]);
+	if(norm < 1e-12) return;
+
+	double c[3] = {sum[0]/norm, sum[1]/norm, sum[2]/norm};
+
+	double max_angle = 0;
+	for(int i=0; i<num_points; ++i) {
+		double v[3];
+		latlon_to_unit_vector(ydata[i], xdata[i], v);
+		double angle = angle_between(c, v);
+		if(angle > max_angle) max_angle = angle;
+	}
+
+	if(max_angle + POLYGON_CAP_TOLERANCE_RAD >= .5*M_PI) return;
+
+	center[0] = c[0];
+	center[1] = c[1];
+	center[2] = c[2];
+	*radius = max_angle + POLYGON_CAP_TOLERANCE_RAD;
+}
+
 Polygon::Polygon() :
 	x_data(NULL),
 	y_data(NULL),
@@ -99,9 +167,14 @@ Polygon::Polygon() :
 	ymax(0),
 	x_centroid(0),
 	y_centroid(0),
+	cap_radius(M_PI),
 	poly_type("NOT-ASSIGNED"),
 	start_hr(0),
 	end_hr(24){
+
+	cap_center[0] = 0;
+	cap_center[1] = 0;
+	cap_center[2] = 1;
 }
 
 Polygon::Polygon(const double* const x_data,
@@ -118,6 +191,7 @@ Polygon::Polygon(const double* const x_data,
     ymax(0),
     x_centroid(0),
     y_centroid(0),
+    cap_radius(M_PI),
     poly_type("NOT-ASSIGNED"),
 	start_hr(0),
 	end_hr(24){
@@ -148,6 +222,7 @@ Polygon::Polygon(const double* const x_data,
 	max_value(this->y_data, num_vertices, &this->ymax);
 
 	compute_centroid(this->x_data, this->y_data, num_vertices, &this->x_centroid, &this->y_centroid);
+	compute_bounding_cap(this->x_data, this->y_data, this->num_vertices, this->cap_center, &this->cap_radius);
 }
 
 Polygon::Polygon(const vector<double>& x_data,
@@ -164,6 +239,7 @@ Polygon::Polygon(const vector<double>& x_data,
 	 ymax(0),
 	 x_centroid(0),
 	 y_centroid(0),
+	 cap_radius(M_PI),
 	 poly_type("NOT-ASSIGNED"),
 	 start_hr(0),
 	 end_hr(24){
@@ -196,6 +272,11 @@ Polygon::Polygon(const vector<double>& x_data,
 		max_value(this->y_data, num_vertices, &this->ymax);
 
 		compute_centroid(this->x_data, this->y_data, this->num_vertices, &this->x_centroid, &this->y_centroid);
+		compute_bounding_cap(this->x_data, this->y_data, this->num_vertices, this->cap_center, &this->cap_radius);
+	} else {
+		cap_center[0] = 0;
+		cap_center[1] = 0;
+		cap_center[2] = 1;
 	}
 }
 
@@ -210,6 +291,7 @@ Polygon::Polygon(const Polygon& that):
     ymax(that.ymax),
     x_centroid(that.x_centroid),
     y_centroid(that.y_centroid),
+    cap_radius(that.cap_radius),
     poly_type(that.poly_type),
 	start_hr(that.start_hr),
 	end_hr(that.end_hr){
@@ -219,6 +301,7 @@ Polygon::Polygon(const Polygon& that):
 
 	memcpy(this->x_data, that.x_data, num_vertices*sizeof(double));
 	memcpy(this->y_data, that.y_data, num_vertices*sizeof(double));
+	memcpy(this->cap_center, that.cap_center, 3*sizeof(double));
 }
 
 Polygon::~Polygon() {
@@ -269,6 +352,48 @@ void Polygon::getCentroid(double* const x_centroid, double* const y_centroid) co
 	*y_centroid = this->y_centroid;
 }
 
+void Polygon::getBoundingCap(double* const center, double* const radius) const {
+	if(center) memcpy(center, cap_center, 3*sizeof(double));
+	if(radius) *radius = cap_radius;
+}
+
+bool Polygon::boundsOverlapSegment(const double& x1, const double& y1,
+		                           const double& x2, const double& y2,
+		                           const bool& gcFlag) const {
+	if(!gcFlag) {
+		// segments_intersect() only accepts intersections inside both
+		// bounding boxes
+		if((x1 < xmin && x2 < xmin) || (x1 > xmax && x2 > xmax)) return false;
+		if((y1 < ymin && y2 < ymin) || (y1 > ymax && y2 > ymax)) return false;
+		return true;
+	}
+
+	if(cap_radius >= M_PI) return true;
+
+	// contains() accepts any point of the lat/lon bounding box that the
+	// ray cast puts inside, so never reject those endpoints
+	if(x1 >= xmin && x1 <= xmax && y1 >= ymin && y1 <= ymax) return true;
+	if(x2 >= xmin && x2 <= xmax && y2 >= ymin && y2 <= ymax) return true;
+
+	// the segment lies in the cap centered on its midpoint with half of
+	// its length as radius
+	double p1[3], p2[3];
+	latlon_to_unit_vector(y1, x1, p1);
+	latlon_to_unit_vector(y2, x2, p2);
+
+	double mid[3] = {p1[0]+p2[0], p1[1]+p2[1], p1[2]+p2[2]};
+	double norm = sqrt(mid[0]*mid[0] + mid[1]*mid[1] + mid[2]*mid[2]);
+	if(norm < 1e-12) return true;
+
+	mid[0] /= norm;
+	mid[1] /= norm;
+	mid[2] /= norm;
+
+	double half_length = .5 * angle_between(p1, p2);
+
+	return angle_between(cap_center, mid) <= cap_radius + half_length + POLYGON_CAP_TOLERANCE_RAD;
+}
+
 /*
  * Return true if the point x,y lies inside this polygon or false otherwise.
  * Points that lie exactly on the polygon boundary are considered
@@ -465,6 +590,9 @@ Polygon& Polygon::operator=(const Polygon& that) {
 	this->x_centroid = that.x_centroid;
 	this->y_centroid = that.y_centroid;
 
+	memcpy(this->cap_center, that.cap_center, 3*sizeof(double));
+	this->cap_radius = that.cap_radius;
+
 	this->x_data = (double*)calloc(this->num_vertices, sizeof(double));
 	this->y_data = (double*)calloc(this->num_vertices, sizeof(double));
 
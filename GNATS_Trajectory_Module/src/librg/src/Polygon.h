@@ -86,6 +86,23 @@ public:
 
 	void getCentroid(double* const x_centroid, double* const y_centroid) const;
 
+	/*
+	 * Get the bounding cap of this polygon on the unit sphere: the unit
+	 * center vector and the angular radius in radians.  The great-circle
+	 * edges stay inside the cap.  A radius of M_PI means unbounded.
+	 */
+	void getBoundingCap(double* const center, double* const radius) const;
+
+	/*
+	 * Quick rejection test for a segment.  Returns false only if the
+	 * segment can neither intersect this polygon nor have an endpoint
+	 * inside it, so the exact tests may be skipped.  With gcFlag the
+	 * bounding caps are compared, otherwise the bounding boxes.
+	 */
+	bool boundsOverlapSegment(const double& x1, const double& y1,
+			                  const double& x2, const double& y2,
+			                  const bool& gcFlag=true) const;
+
 	/*
 	 * Output the scaled copy of this polygon
 	 */
@@ -168,6 +185,10 @@ protected:
 	double x_centroid;
 	double y_centroid;
 
+	// bounding cap on the unit sphere
+	double cap_center[3];
+	double cap_radius;
+
 	/*
 	 *TODO:PARIKSHIT ADDER FOR TYPE OF WEATHER POLYGON.
 	 */
@@ -0,0 +1,218 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * PolygonIndex.cpp
+ */
+
+#include "PolygonIndex.h"
+
+#include <cmath>
+#include <algorithm>
+
+using std::sort;
+
+namespace osi {
+
+// slack on route segment caps, matching the polygon cap tolerance
+#define POLYGON_INDEX_TOLERANCE_RAD 1e-6
+
+static void latlon_to_unit_vector(const double& lat_deg, const double& lon_deg, double* const v) {
+	double lat = lat_deg * M_PI / 180.;
+	double lon = lon_deg * M_PI / 180.;
+
+	v[0] = cos(lat) * cos(lon);
+	v[1] = cos(lat) * sin(lon);
+	v[2] = sin(lat);
+}
+
+PolygonIndex::PolygonIndex() :
+	cell_size(1.),
+	num_polygons(0),
+	unbounded(vector<int>()),
+	grid(map< GridKey, vector<int> >()) {
+}
+
+PolygonIndex::PolygonIndex(const vector<Polygon>& polygons, const double& cell_size_deg) :
+	cell_size(cell_size_deg),
+	num_polygons(0),
+	unbounded(vector<int>()),
+	grid(map< GridKey, vector<int> >()) {
+	build(polygons, cell_size_deg);
+}
+
+PolygonIndex::~PolygonIndex() {
+}
+
+void PolygonIndex::build(const vector<Polygon>& polygons, const double& cell_size_deg) {
+	cell_size = (cell_size_deg > 0 ? cell_size_deg : 1.);
+	num_polygons = (int)polygons.size();
+	unbounded.clear();
+	grid.clear();
+
+	vector<GridKey> keys;
+	for(int n=0; n<num_polygons; ++n) {
+		const Polygon& poly = polygons.at(n);
+
+		double center[3];
+		double radius;
+		poly.getBoundingCap(center, &radius);
+
+		// polygons spanning the antimeridian have a lat/lon bounding box
+		// that does not match their cap, so keep them as candidates
+		if(radius >= M_PI || poly.getNumVertices() < 1 ||
+				(poly.getXMax() - poly.getXMin()) > 180.) {
+			unbounded.push_back(n);
+			continue;
+		}
+
+		getCells(center, radius, &keys);
+		for(size_t k=0; k<keys.size(); ++k) {
+			grid[keys.at(k)].push_back(n);
+		}
+	}
+}
+
+void PolygonIndex::queryRoute(const vector<double>& lats_deg,
+		                      const vector<double>& lons_deg,
+		                      vector<int>* const candidates) const {
+	if(!candidates) return;
+	candidates->clear();
+
+	if(num_polygons < 1) return;
+	if(lats_deg.size() != lons_deg.size() || lats_deg.empty()) return;
+
+	vector<char> marked(num_polygons, 0);
+	for(size_t k=0; k<unbounded.size(); ++k) {
+		marked[unbounded.at(k)] = 1;
+	}
+
+	vector<GridKey> keys;
+	size_t num_points = lats_deg.size();
+	size_t num_segments = (num_points > 1 ? num_points-1 : 1);
+	for(size_t k=0; k<num_segments; ++k) {
+		size_t k2 = (num_points > 1 ? k+1 : k);
+
+		double p1[3], p2[3];
+		latlon_to_unit_vector(lats_deg.at(k), lons_deg.at(k), p1);
+		latlon_to_unit_vector(lats_deg.at(k2), lons_deg.at(k2), p2);
+
+		// bound the great-circle segment by the cap centered on its
+		// midpoint
+		double mid[3] = {p1[0]+p2[0], p1[1]+p2[1], p1[2]+p2[2]};
+		double norm = sqrt(mid[0]*mid[0] + mid[1]*mid[1] + mid[2]*mid[2]);
+		if(norm < 1e-12) {
+			// antipodal endpoints, every polygon is a candidate
+			for(int n=0; n<num_polygons; ++n) marked[n] = 1;
+			break;
+		}
+		mid[0] /= norm;
+		mid[1] /= norm;
+		mid[2] /= norm;
+
+		double dot = p1[0]*p2[0] + p1[1]*p2[1] + p1[2]*p2[2];
+		if(dot > 1.) dot = 1.;
+		if(dot < -1.) dot = -1.;
+		double radius = .5 * acos(dot) + POLYGON_INDEX_TOLERANCE_RAD;
+
+		getCells(mid, radius, &keys);
+		for(size_t c=0; c<keys.size(); ++c) {
+			map< GridKey, vector<int> >::const_iterator iter = grid.find(keys.at(c));
+			if(iter == grid.end()) continue;
+			const vector<int>& polys = iter->second;
+			for(size_t m=0; m<polys.size(); ++m) {
+				marked[polys.at(m)] = 1;
+			}
+		}
+	}
+
+	for(int n=0; n<num_polygons; ++n) {
+		if(marked[n]) candidates->push_back(n);
+	}
+}
+
+int PolygonIndex::getNumPolygons() const {
+	return num_polygons;
+}
+
+/*
+ * Get the grid cells covered by the latitude/longitude box of a cap.
+ * Longitude cells wrap around the antimeridian.
+ */
+void PolygonIndex::getCells(const double* const center, const double& radius,
+		                    vector<GridKey>* const keys) const {
+	keys->clear();
+
+	double z = center[2];
+	if(z > 1.) z = 1.;
+	if(z < -1.) z = -1.;
+
+	double lat_c = asin(z) * 180. / M_PI;
+	double lon_c = atan2(center[1], center[0]) * 180. / M_PI;
+	double r = radius * 180. / M_PI;
+
+	double lat_min = lat_c - r;
+	double lat_max = lat_c + r;
+
+	int num_cols = (int)ceil(360. / cell_size);
+	int jmin, jmax;
+
+	// a cap reaching a pole covers all longitudes
+	if(lat_max >= 90. || lat_min <= -90. || radius >= .5*M_PI) {
+		if(lat_max > 90.) lat_max = 90.;
+		if(lat_min < -90.) lat_min = -90.;
+		jmin = 0;
+		jmax = num_cols-1;
+	} else {
+		double ratio = sin(radius) / cos(lat_c * M_PI / 180.);
+		if(ratio >= 1.) {
+			jmin = 0;
+			jmax = num_cols-1;
+		} else {
+			double dlon = asin(ratio) * 180. / M_PI;
+			jmin = (int)floor((lon_c - dlon + 180.) / cell_size);
+			jmax = (int)floor((lon_c + dlon + 180.) / cell_size);
+			if(jmax - jmin + 1 >= num_cols) {
+				jmin = 0;
+				jmax = num_cols-1;
+			}
+		}
+	}
+
+	int imin = (int)floor((lat_min + 90.) / cell_size);
+	int imax = (int)floor((lat_max + 90.) / cell_size);
+
+	for(int i=imin; i<=imax; ++i) {
+		for(int j=jmin; j<=jmax; ++j) {
+			int jw = ((j % num_cols) + num_cols) % num_cols;
+			keys->push_back(GridKey(i, jw));
+		}
+	}
+}
+
+}
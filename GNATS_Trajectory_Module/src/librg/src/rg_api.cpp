@@ -43,6 +43,7 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include "AstarSearch.h"
 #include "DepthFirstSearch.h"
 #include "Polygon.h"
+#include "PolygonIndex.h"
 #include "osi_global_constants.h"
 #include "geometry_utils.h"
 
@@ -128,6 +129,10 @@ static ofstream error_log;
 static const string error_log_name = "rg_errors.log";
 static bool cost_compute_flag = true;
 
+// skip exact weather polygon tests for segments outside the polygon
+// bounding caps
+static bool weather_polygon_prefilter = true;
+
 
 static double g_max_wind_magnitude = 0;
 static double g_max_cost = 0;
@@ -1614,6 +1619,339 @@ static void find_wind_optimal_paths(SearchGraph& graph,
 
 
 
+/*
+ * Wind samples along one link at one cruise altitude.  Sample i of wind
+ * grid k is stored at index i*numGrids+k.  The samples do not depend on
+ * airspeed, so all flights cruising at the altitude share them.
+ */
+typedef struct _wind_link_samples_t {
+	int numSegments;
+	int numGrids;
+	double segmentLength;     // ft
+	vector<double> windAlong; // along-track wind, ft/sec
+	vector<double> windCross; // cross-track wind, ft/sec
+} wind_link_samples_t;
+
+/*
+ * Sample the wind at the segment midpoints of a link, following the same
+ * steps as wind_optimal_cost_function().
+ */
+static void sample_link_wind(const double& lat1, const double& lon1,
+		const double& lat2, const double& lon2,
+		const double& alt,
+		WindGrid* const g_wind,
+		vector<WindGrid>* const g_wind_vec,
+		wind_link_samples_t* const samples) {
+	double D = compute_distance_gc(lat1, lon1, lat2, lon2, alt); // ft
+	double dnom = 3.0 * nauticalMilesToFeet;
+	double n = ceil(D/dnom);
+	double d = D/n;
+
+	double heading = compute_heading_gc(lat1, lon1, lat2, lon2);
+
+	while(heading < 0) heading += 360.;
+	while(heading > 360) heading -= 360.;
+
+	double headingRad = heading*M_PI/180.;
+
+	samples->numSegments = (int)n;
+	samples->numGrids = g_wind_vec->empty() ? 1 : g_wind_vec->size();
+	samples->segmentLength = d;
+	samples->windAlong.resize(samples->numSegments * samples->numGrids);
+	samples->windCross.resize(samples->numSegments * samples->numGrids);
+
+	double latmid;
+	double lonmid;
+	double s = d/2;
+
+	for (int i = 0; i < samples->numSegments; ++i) {
+		compute_location_gc(lat1, lon1, s, heading, &latmid, &lonmid, alt);
+
+		for (int k = 0; k < samples->numGrids; ++k) {
+			double windNorth=0, windEast=0;
+
+			if (g_wind_vec->size())
+				g_wind_vec->at(k).getWind(latmid, lonmid, alt, &windNorth, &windEast);
+			else
+				g_wind->getWind(latmid, lonmid, alt, &windNorth, &windEast);
+
+			int idx = i*samples->numGrids + k;
+			samples->windAlong[idx] = (windNorth*cos(headingRad) + windEast*sin(headingRad)) * KnotsToFeetPerSec;
+			samples->windCross[idx] = (windNorth*sin(headingRad) - windEast*cos(headingRad)) * KnotsToFeetPerSec;
+		}
+
+		s += d;
+	}
+}
+
+/*
+ * Link transit time from the wind samples.  Same result as the scalar
+ * wind_optimal_cost_function().
+ */
+static double link_cost_from_samples(const wind_link_samples_t& samples, const double& spd) {
+	double T = 0;
+
+	for (int i = 0; i < samples.numSegments; ++i) {
+		int idx = i*samples.numGrids;
+
+		double beta = asin(-samples.windCross[idx] / spd);
+		double vg = spd*cos(beta) + samples.windAlong[idx];
+		double t = samples.segmentLength / vg;
+
+		T += t;
+	}
+
+	return T;
+}
+
+/*
+ * Link transit time for each departure hour from the wind samples.  Same
+ * result as the vector wind_optimal_cost_function().
+ */
+static void link_cost_vector_from_samples(const wind_link_samples_t& samples, const double& spd,
+		vector<double>* const Tf) {
+	Tf->clear();
+
+	for (int k = 0; k < samples.numGrids; ++k) {
+		double Tval = 0.0;
+		for (int i = 0; i < samples.numSegments; ++i) {
+			unsigned int inc = (unsigned int)(floor(Tval/3600.0));
+			unsigned int grid = (unsigned int)(k+inc)%(samples.numGrids);
+			int idx = i*samples.numGrids + grid;
+
+			double beta = asin(-samples.windCross[idx] / spd);
+			double vg = spd*cos(beta) + samples.windAlong[idx];
+			double t = samples.segmentLength / vg;
+
+			Tval += t;
+		}
+		Tf->push_back(Tval);
+	}
+}
+
+/**
+ * Find wind-optimal paths for many flights at once.
+ *
+ * Each path is the one find_lowest_cost_path() returns for the flight
+ * when its edge costs are recomputed (costFlag == false).  Flights are
+ * grouped by cruise altitude and airspeed.  Wind samples along the links
+ * are computed once per altitude, edge costs once per altitude and
+ * airspeed, and the A* searches of a group run in parallel on a shared,
+ * unmodified graph.
+ */
+static int find_wind_optimal_paths_batch(SearchGraph& graph,
+		const vector<FixPair>& flights,
+		map<FixPair, SearchPath>* const pathsOut,
+		WindGrid* const g_wind,
+		vector<WindGrid>* const g_wind_vec) {
+	int numNodes = graph.size();
+
+	// positions of the graph nodes
+	vector<double> nodeLat(numNodes, 0);
+	vector<double> nodeLon(numNodes, 0);
+
+	const map<int, SearchNode*>& nodes = graph.getNodes();
+	map<int, SearchNode*>::const_iterator niter;
+	for (niter = nodes.begin(); niter != nodes.end(); ++niter) {
+		int id = niter->first;
+
+		Fix* fix = NULL;
+		get_fix(id, &fix);
+		if ((fix == NULL) || (id < 0) || (id >= numNodes)) {
+			stringstream ss;
+			ss << "find_wind_optimal_paths_batch(): invalid node " << id;
+			log_error(ss.str(), true);
+			return -1;
+		}
+
+		nodeLat[id] = fix->getLatitude();
+		nodeLon[id] = fix->getLongitude();
+	}
+
+	// links whose costs are recomputed per flight.  removed, multiplied
+	// and max cost links keep the graph's costs.
+	map< std::pair<int, int>, double > baseCosts(graph.edgeCostsBegin(), graph.edgeCostsEnd());
+	map< std::pair<int, int>, vector<double> > baseCostVectors(graph.edgeCostsVectorBegin(), graph.edgeCostsVectorEnd());
+
+	vector< std::pair<int, int> > links;
+	vector<bool> linkRecomputed;
+	links.reserve(baseCosts.size());
+	linkRecomputed.reserve(baseCosts.size());
+
+	map< std::pair<int, int>, double >::const_iterator edgeIter;
+	for (edgeIter = baseCosts.begin(); edgeIter != baseCosts.end(); ++edgeIter) {
+		int fromId = edgeIter->first.first;
+		int toId = edgeIter->first.second;
+
+		bool recomputed = !(graph.isRemoved(fromId) ||
+				graph.isRemoved(toId) ||
+				graph.isMultiplied(fromId, toId));
+
+		if (recomputed) {
+			if (edgeIter->second >= 1e100) recomputed = false;
+
+			map< std::pair<int, int>, vector<double> >::const_iterator vecIter = baseCostVectors.find(edgeIter->first);
+			if (vecIter != baseCostVectors.end()) {
+				for (size_t s = 0; s < vecIter->second.size(); ++s) {
+					if (vecIter->second.at(s) >= 1e100) {
+						recomputed = false;
+						break;
+					}
+				}
+			}
+		}
+
+		links.push_back(edgeIter->first);
+		linkRecomputed.push_back(recomputed);
+	}
+
+	// resolve the flights and group them by cruise altitude and airspeed
+	vector<int> sourceIds(flights.size(), -1);
+	vector<int> sinkIds(flights.size(), -1);
+	vector<double> goalLat(flights.size(), 0);
+	vector<double> goalLon(flights.size(), 0);
+
+	map<double, map<double, vector<size_t> > > groups;
+
+	for (size_t i = 0; i < flights.size(); ++i) {
+		const FixPair& flight = flights.at(i);
+
+		Fix* start = NULL;
+		Fix* goal = NULL;
+
+		int sourceId = get_fix(flight.origin, &start, false);
+		int sinkId = get_fix(flight.destination, &goal, false);
+
+		if (sourceId < 0) {
+			log_error(string("Could not find fixes " + flight.origin + " on aircraft " + flight.callsign), false);
+			continue;
+		} else if (sinkId < 0) {
+			log_error(string("Could not find fixes " + flight.destination + " on aircraft " + flight.callsign), false);
+			continue;
+		}
+
+		if (graph.isRemoved(sourceId) || graph.isRemoved(sinkId))
+			continue;
+
+		sourceIds[i] = sourceId;
+		sinkIds[i] = sinkId;
+		goalLat[i] = goal->getLatitude();
+		goalLon[i] = goal->getLongitude();
+
+		groups[flight.altitude][flight.airspeed].push_back(i);
+	}
+
+	bool dynFlag = !g_wind_vec->empty();
+
+	vector<SearchPath> paths(flights.size());
+
+	map<double, map<double, vector<size_t> > >::const_iterator altIter;
+	for (altIter = groups.begin(); altIter != groups.end(); ++altIter) {
+		double alt = altIter->first;
+
+		vector<wind_link_samples_t> samples(links.size());
+
+#pragma omp parallel for schedule(dynamic, 256)
+		for (int e = 0; e < (int)links.size(); ++e) {
+			if (!linkRecomputed[e]) continue;
+
+			int fromId = links[e].first;
+			int toId = links[e].second;
+
+			sample_link_wind(nodeLat[fromId], nodeLon[fromId],
+					nodeLat[toId], nodeLon[toId],
+					alt, g_wind, g_wind_vec, &samples[e]);
+		}
+
+		map<double, vector<size_t> >::const_iterator spdIter;
+		for (spdIter = altIter->second.begin(); spdIter != altIter->second.end(); ++spdIter) {
+			double spd = spdIter->first;
+			const vector<size_t>& members = spdIter->second;
+
+			vector<double> linkCosts(links.size(), 0);
+			vector< vector<double> > linkCostVectors(dynFlag ? links.size() : 0);
+
+#pragma omp parallel for schedule(dynamic, 256)
+			for (int e = 0; e < (int)links.size(); ++e) {
+				if (!linkRecomputed[e]) continue;
+
+				linkCosts[e] = link_cost_from_samples(samples[e], spd);
+				if (dynFlag) {
+					link_cost_vector_from_samples(samples[e], spd, &linkCostVectors[e]);
+				}
+			}
+
+			map< std::pair<int, int>, double > edgeCosts(baseCosts);
+			map< std::pair<int, int>, vector<double> > edgeCostVectors(baseCostVectors);
+
+			map< std::pair<int, int>, double >::iterator costIter = edgeCosts.begin();
+			for (size_t e = 0; e < links.size(); ++e, ++costIter) {
+				if (!linkRecomputed[e]) continue;
+
+				costIter->second = linkCosts[e];
+				if (dynFlag) {
+					edgeCostVectors[links[e]].swap(linkCostVectors[e]);
+				}
+			}
+
+#pragma omp parallel for schedule(dynamic, 1)
+			for (int m = 0; m < (int)members.size(); ++m) {
+				size_t i = members[m];
+
+				// heuristics toward this flight's destination
+				vector<double> h(numNodes, 0);
+				map<int, SearchNode*>::const_iterator hiter;
+				for (hiter = nodes.begin(); hiter != nodes.end(); ++hiter) {
+					int id = hiter->first;
+					h[id] = wind_optimal_heuristic_function(nodeLat[id],
+							nodeLon[id],
+							alt,
+							goalLat[i],
+							goalLon[i],
+							alt,
+							spd);
+				}
+
+				// search straight into this flight's slot
+				SearchPath& path = paths[i];
+				AstarSearch astar;
+				astar.findPath(graph, &h[0], edgeCosts, edgeCostVectors,
+						sourceIds[i], sinkIds[i], &path, dynFlag);
+
+				// if the path contains only 1 node and the source and sink
+				// are the same, then add the sink id to make path length 2.
+				if (path.getNodes().size() == 1 && sourceIds[i] == sinkIds[i]) {
+					if ( path.front() == sourceIds[i] || path.front() == sinkIds[i] ) {
+						path.push_front(sourceIds[i]);
+					}
+				}
+
+				double c_cost = 0.0;
+				const deque<int>& pathNodes = path.getNodes();
+				for (size_t p = 0; p+1 < pathNodes.size(); ++p) {
+					if (dynFlag)
+						c_cost += SearchGraph::lookupEdgeCost(edgeCosts, edgeCostVectors,
+								pathNodes.at(p), pathNodes.at(p+1), c_cost);
+					else
+						c_cost += SearchGraph::lookupEdgeCost(edgeCosts, edgeCostVectors,
+								pathNodes.at(p), pathNodes.at(p+1));
+				}
+				path.setPathCost(c_cost);
+			}
+		}
+	}
+
+	// insert in input order so that duplicate keys resolve as in the
+	// sequential loop
+	for (size_t i = 0; i < flights.size(); ++i) {
+		if (sourceIds[i] < 0 || sinkIds[i] < 0) continue;
+
+		pathsOut->insert(std::pair<FixPair, SearchPath>(flights.at(i), paths[i]));
+	}
+
+	return 0;
+}
+
 /**
  * This function runs the lowest-level loop to invoke A* over the
  * graph and find the shortest path for each fix pair.  The input
@@ -2227,21 +2565,26 @@ bool routeIntersectsPoly(const Polygon* const poly,
 		double lon1 = lons->at(k);
 		double lon2 = lons->at(k+1);
 
-		if(poly->contains(lon1, lat1, true)) {
+		// a segment outside the bounding cap can neither touch the
+		// polygon nor have an endpoint inside it
+		bool candidate = !weather_polygon_prefilter ||
+				poly->boundsOverlapSegment(lon1, lat1, lon2, lat2, true);
+
+		if(candidate && poly->contains(lon1, lat1, true)) {
 			if (intersects == false && k > 0){
 				first_idx = k;
 			}
 			intersects = true;
 			continue;
 		}
-		if(poly->contains(lon2, lat2, true)) {
+		if(candidate && poly->contains(lon2, lat2, true)) {
 			if (intersects == false){
 				first_idx = k+1;
 			}
 			intersects = true;
 			continue;
 		}
-		if(poly->intersectsSegment(lon1,lat1,lon2,lat2,NULL,NULL,true)){
+		if(candidate && poly->intersectsSegment(lon1,lat1,lon2,lat2,NULL,NULL,true)){
 			if (intersects == false){
 				first_idx = k;
 			}
@@ -2524,10 +2867,31 @@ int weatherAvoidanceRoutesForNATS(const PolygonSet& weatherScenariosList,
 
 
 
+/*
+ * Test the index candidates exactly, in polygon order, so the result
+ * matches the full scan.
+ */
+static void push_intersecting_polygons(const PolygonIndex& index,
+				const vector<double>& lats_deg,
+				const vector<double>& lons_deg,
+				const PolygonSet& weatherpolygons,
+				PolygonSet& polygons_ahead) {
+	vector<int> candidates;
+	index.queryRoute(lats_deg, lons_deg, &candidates);
+
+	for (size_t c=0; c<candidates.size(); ++c) {
+		const Polygon& poly = weatherpolygons.at(candidates.at(c));
+		int first_idx = 0,last_idx = 0;
+		bool intersects = routeIntersectsPoly(&poly, &lats_deg, &lons_deg, first_idx, last_idx);
+		if (intersects) polygons_ahead.push_back(poly);
+	}
+}
+
 void find_intersecting_polygons(const double& lat_deg, const double& lon_deg, const double& alt_ft, const double& nmi_rad,
 				const vector<double>& fp_lat_deg,
 				const vector<double>& fp_lon_deg,
 				const PolygonSet& weatherpolygons,
+				const PolygonIndex* const index,
 				PolygonSet& polygons_ahead){
 
 	assert( fp_lat_deg.size() == fp_lon_deg.size() );
@@ -2569,6 +2933,18 @@ void find_intersecting_polygons(const double& lat_deg, const double& lon_deg, co
 	fp_lon_in_range.push_back(to_Lon);
 
 	//now push the intersecting polygons
+	if (weather_polygon_prefilter) {
+		if (index == NULL || index->getNumPolygons() != (int)weatherpolygons.size()) {
+			PolygonIndex local_index(weatherpolygons);
+			push_intersecting_polygons(local_index, fp_lat_in_range, fp_lon_in_range,
+					weatherpolygons, polygons_ahead);
+		} else {
+			push_intersecting_polygons(*index, fp_lat_in_range, fp_lon_in_range,
+					weatherpolygons, polygons_ahead);
+		}
+		return;
+	}
+
 	for (Polygon poly:weatherpolygons) {
 		int first_idx = 0,last_idx = 0;
 		bool intersects = routeIntersectsPoly(&poly, &fp_lat_in_range, &fp_lon_in_range, first_idx, last_idx);
@@ -2576,6 +2952,19 @@ void find_intersecting_polygons(const double& lat_deg, const double& lon_deg, co
 	}
 }
 
+void find_intersecting_polygons(const double& lat_deg, const double& lon_deg, const double& alt_ft, const double& nmi_rad,
+				const vector<double>& fp_lat_deg,
+				const vector<double>& fp_lon_deg,
+				const PolygonSet& weatherpolygons,
+				PolygonSet& polygons_ahead){
+	find_intersecting_polygons(lat_deg, lon_deg, alt_ft, nmi_rad, fp_lat_deg, fp_lon_deg,
+			weatherpolygons, NULL, polygons_ahead);
+}
+
+void set_weather_polygon_prefilter(const bool& flag) {
+	weather_polygon_prefilter = flag;
+}
+
 //END PARIKSHIT ADDER FOR NATS.
 
 void getPolygonEntryExitPoints(map<FixPair, SearchPath>& nominalPaths,
@@ -4273,6 +4662,44 @@ int get_wind_optimal_paths(SearchGraph& graph, const vector<FixPair>& flights,
 }
 
 
+int get_wind_optimal_paths_batch(SearchGraph& graph,
+		const vector<FixPair>& flights,
+		WindGrid* const g_wind,
+		vector<WindGrid>* const g_wind_vec,
+		map<FixPair, SearchPath>* const pathsOut) {
+	if (!pathsOut) {
+		log_error("get_wind_optimal_paths_batch(): invalid output pointer.", true);
+		return -1;
+	}
+
+	// make sure the airway data has been loaded
+	if (validate_global_data() < 0) {
+		return -1;
+	}
+
+	vector<WindGrid> no_wind_vec;
+	vector<WindGrid>* const wind_vec = (g_wind_vec != NULL) ? g_wind_vec : &no_wind_vec;
+	if ((g_wind == NULL) && wind_vec->empty()) {
+		log_error("get_wind_optimal_paths_batch(): no wind data.", true);
+		return -1;
+	}
+
+	// find the maximum wind vector magnitude for the heuristic, as in
+	// get_wind_optimal_paths()
+	if (g_wind_vec) {
+		g_max_wind_magnitude = MIN_DOUBLE;
+		for (unsigned int k = 0; k < g_wind_vec->size(); ++k) {
+			double max_mag = g_wind_vec->at(k).getMaxWind();
+			if (max_mag > g_max_wind_magnitude)
+				g_max_wind_magnitude = max_mag;
+		}
+	} else {
+		g_max_wind_magnitude = g_wind->getMaxWind();
+	}
+
+	return find_wind_optimal_paths_batch(graph, flights, pathsOut, g_wind, wind_vec);
+}
+
 int get_wind_optimal_TOS(SearchGraph& graph,
 		  const vector<FixPair>& flights,
 	      WindGrid* const g_wind,
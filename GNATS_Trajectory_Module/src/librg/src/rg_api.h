@@ -43,6 +43,7 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include "SearchPath.h"
 #include "FixPair.h"
 #include "Polygon.h"
+#include "PolygonIndex.h"
 #include "PIREP.h"
 #include "path_find.h"
 #include "pub_WaypointNode.h"
@@ -386,6 +387,39 @@ int get_wind_optimal_paths(SearchGraph& graph,
 	      PolygonSets* const polysOut=NULL,
 	      const bool& replanFlag=true);
 
+/**
+ * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ * Function:
+ *   get_wind_optimal_paths_batch()
+ *
+ * Description:
+ *   Compute the wind-optimal paths of many flights.  Flights with the
+ *   same cruise altitude share the wind sampled along the links, and
+ *   flights with the same cruise altitude and airspeed share the edge
+ *   costs, including the hourly costs when g_wind_vec is not empty.
+ *   The searches run in parallel.  Each path is identical to the one a
+ *   single-flight search returns when edge costs are recomputed for
+ *   that flight.  The graph is not modified.
+ *
+ * Inputs:
+ *   graph        nodes that define the network search graph
+ *   flights      origin, destination, cruise altitude and airspeed
+ *   g_wind       wind grid, used when g_wind_vec is NULL or empty
+ *   g_wind_vec   hourly wind grids
+ *
+ * In/Out:
+ *   pathsOut     the paths, keyed by flight
+ *
+ * Returns:
+ *   0 on success, -1 on error.
+ * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+ */
+int get_wind_optimal_paths_batch(SearchGraph& graph,
+		  const vector<FixPair>& flights,
+	      WindGrid* const g_wind,
+	      vector<WindGrid>* const g_wind_vec,
+	      map<FixPair, SearchPath>* const pathsOut);
+
 int get_wind_optimal_TOS(SearchGraph& graph,
 		  const vector<FixPair>& flights,
 	      WindGrid* const g_wind,
@@ -418,6 +452,25 @@ void find_intersecting_polygons(const double& lat_deg, const double& lon_deg, co
 				const PolygonSet& weatherpolygons,
 				PolygonSet& polygons_ahead);
 
+/**
+ * Same as above, reusing a PolygonIndex built over weatherpolygons.
+ * Callers testing many routes against one polygon set should build the
+ * index once.  A NULL or stale index is rebuilt locally.
+ */
+void find_intersecting_polygons(const double& lat_deg, const double& lon_deg, const double& alt_ft, const double& nmi_rad,
+				const vector<double>& fp_lat_deg,
+				const vector<double>& fp_lon_deg,
+				const PolygonSet& weatherpolygons,
+				const PolygonIndex* const index,
+				PolygonSet& polygons_ahead);
+
+/**
+ * Enable or disable bounding-cap prefiltering of weather polygon tests.
+ * Results are identical either way; disabling restores the full
+ * vertex-by-vertex scan for comparison.
+ */
+void set_weather_polygon_prefilter(const bool& flag);
+
 /**
  * Parse airport pairs from the trx file
  */
@@ -5744,6 +5744,19 @@ int runRgForNATS(const string& polygonFile,
 
 }
 
+int loadWeatherPolygons(const string& polygonFile,
+		vector<Polygon>& polygons) {
+	if (!exists_test(polygonFile)) {
+		printf("Polygon file %s does not exist.\n", polygonFile.c_str());
+		return -1;
+	}
+
+	polygons.clear();
+	load_scenarios_for_NATS(polygonFile, polygons);
+
+	return (int)polygons.size();
+}
+
 int getWeatherPolygons(const double& lat_deg, const double& lon_deg, const double& alt_ft, const double& nmi_rad,
 					const vector<double>& fp_lat_deg,
 					const vector<double>& fp_lon_deg,
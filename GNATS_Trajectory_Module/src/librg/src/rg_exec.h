@@ -121,6 +121,14 @@ extern set<string> rg_airportFilter;
   					const string &CIFPfilepath,
   					vector<Polygon>& polygons_ahead);
 
+  /*
+   * Load a polygon file of "longitude latitude scenario" lines with
+   * blank lines between polygons.  Returns the number of polygons
+   * loaded or -1 if the file does not exist.
+   */
+  int loadWeatherPolygons(const string& polygonFile,
+		  vector<Polygon>& polygons);
+
 }
 
 #endif
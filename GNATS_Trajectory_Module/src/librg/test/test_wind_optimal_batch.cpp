@@ -0,0 +1,293 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_wind_optimal_batch.cpp
+ *
+ * Equivalence test of get_wind_optimal_paths_batch() against the
+ * single-flight search find_lowest_cost_path(), run once per flight with
+ * its edge costs recomputed for that flight.  find_lowest_cost_path() is
+ * static, so the test compiles rg_api.cpp in.
+ *
+ * The navdata is a synthetic lattice of waypoints with east-west,
+ * north-south and diagonal airways.  Its rows are symmetric about the
+ * equator, so with no wind or a uniform east wind many routes have
+ * exactly the same cost and both searches must break those ties the
+ * same way.  A third case uses varying hourly winds.  Every ordered pair
+ * of waypoints is routed at two cruise altitudes and two airspeeds, and
+ * each batch path must equal the single-flight path node by node.
+ */
+
+#include "rg_api.cpp"
+
+#include <math.h>
+#include <stdio.h>
+
+#include <deque>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace osi;
+
+#define TEST_NUM_ROWS 5
+#define TEST_NUM_COLS 8
+
+#define TEST_WIND_NONE 0
+#define TEST_WIND_UNIFORM 1
+#define TEST_WIND_HOURLY 2
+
+static string fix_name(const int row, const int col) {
+	stringstream ss;
+	ss << "TFX" << row << col;
+
+	return ss.str();
+}
+
+static void add_airway(const string& name, const vector<string>& waypointNames) {
+	vector<double> altitudes(waypointNames.size(), 0);
+
+	rg_airways[name] = new Airway(name, name, "B", "O", waypointNames, altitudes, altitudes, altitudes);
+}
+
+/*
+ * Lattice of waypoints one degree apart, rows from 2S to 2N.
+ */
+static void load_lattice_navdata() {
+	int id = 0;
+	for (int row = 0; row < TEST_NUM_ROWS; row++) {
+		for (int col = 0; col < TEST_NUM_COLS; col++) {
+			string name = fix_name(row, col);
+			Waypoint* waypoint = new Waypoint(name, name, row - (TEST_NUM_ROWS - 1) / 2, col);
+
+			rg_fixes[name] = waypoint;
+			rg_fixes_by_id[id] = waypoint;
+			rg_fix_ids[name] = id;
+			rg_fix_names[id] = name;
+			id++;
+		}
+	}
+
+	for (int row = 0; row < TEST_NUM_ROWS; row++) {
+		vector<string> names;
+		for (int col = 0; col < TEST_NUM_COLS; col++) {
+			names.push_back(fix_name(row, col));
+		}
+
+		stringstream ss;
+		ss << "TJ" << row;
+		add_airway(ss.str(), names);
+	}
+
+	for (int col = 0; col < TEST_NUM_COLS; col++) {
+		vector<string> names;
+		for (int row = 0; row < TEST_NUM_ROWS; row++) {
+			names.push_back(fix_name(row, col));
+		}
+
+		stringstream ss;
+		ss << "TV" << col;
+		add_airway(ss.str(), names);
+	}
+
+	// Diagonals in both directions, from every cell of the first column
+	// and the outer rows
+	for (int start = -(TEST_NUM_ROWS - 1); start < TEST_NUM_COLS; start++) {
+		vector<string> up;
+		vector<string> down;
+		for (int row = 0; row < TEST_NUM_ROWS; row++) {
+			int col = start + row;
+			if ((col >= 0) && (col < TEST_NUM_COLS)) {
+				up.push_back(fix_name(row, col));
+				down.push_back(fix_name(TEST_NUM_ROWS - 1 - row, col));
+			}
+		}
+
+		if (up.size() > 1) {
+			stringstream ssUp;
+			ssUp << "TQ" << (start + TEST_NUM_ROWS);
+			add_airway(ssUp.str(), up);
+
+			stringstream ssDown;
+			ssDown << "TR" << (start + TEST_NUM_ROWS);
+			add_airway(ssDown.str(), down);
+		}
+	}
+}
+
+/*
+ * Wind grid over the lattice.  Winds are in knots.
+ */
+static WindGrid make_wind(const int windCase, const int hour) {
+	const double lat_min = -4, lat_max = 4, lat_step = 0.5;
+	const double lon_min = -2, lon_max = TEST_NUM_COLS + 1, lon_step = 0.5;
+	const double alt_min = 20000, alt_max = 40000, alt_step = 5000;
+
+	WindGrid probe(lat_min, lat_max, lat_step, lon_min, lon_max, lon_step, alt_min, alt_max, alt_step);
+
+	vector<double> n_data(probe.table_size, 0);
+	vector<double> e_data(probe.table_size, 0);
+	for (size_t i = 0; i < probe.lat_size; i++) {
+		for (size_t j = 0; j < probe.lon_size; j++) {
+			for (size_t k = 0; k < probe.alt_size; k++) {
+				int index = probe.getIndex(i, j, k);
+				if (windCase == TEST_WIND_UNIFORM) {
+					e_data[index] = 40;
+				} else if (windCase == TEST_WIND_HOURLY) {
+					n_data[index] = 30 * sin(0.7 * i + 0.3 * k + hour) + 5 * cos(1.3 * j);
+					e_data[index] = 60 * cos(0.4 * j - 0.5 * i + 0.2 * k * hour) + 10;
+				}
+			}
+		}
+	}
+
+	WindGrid wind;
+	wind.setGrid(lat_min, lat_max, lat_step, lon_min, lon_max, lon_step, alt_min, alt_max, alt_step,
+			&n_data[0], &e_data[0]);
+
+	return wind;
+}
+
+static int check_case(const int windCase, const vector<FixPair>& flights) {
+	WindGrid wind = make_wind(windCase, 0);
+
+	vector<WindGrid> windVec;
+	if (windCase == TEST_WIND_HOURLY) {
+		for (int hour = 0; hour < 3; hour++) {
+			windVec.push_back(make_wind(windCase, hour));
+		}
+	}
+
+	// Batch first, the single-flight searches rewrite the graph costs
+	SearchGraph batchGraph;
+	get_airway_connectivity(&batchGraph);
+
+	map<FixPair, SearchPath> batchPaths;
+	if (get_wind_optimal_paths_batch(batchGraph, flights, &wind, &windVec, &batchPaths) != 0) {
+		printf("FAILED: wind case %d, get_wind_optimal_paths_batch() returned an error\n", windCase);
+
+		return 1;
+	}
+
+	SearchGraph graph;
+	get_airway_connectivity(&graph);
+
+	map<FixPair, SearchPath> singlePaths;
+	for (unsigned int f = 0; f < flights.size(); f++) {
+		FixPair flight = flights.at(f);
+
+		bool costFlag = false;
+		find_lowest_cost_path(graph, flight,
+				wind_optimal_cost_function,
+				wind_optimal_heuristic_function,
+				&singlePaths,
+				&wind,
+				&windVec,
+				costFlag);
+	}
+
+	int mismatches = 0;
+	int multiNode = 0;
+	for (unsigned int f = 0; f < flights.size(); f++) {
+		const FixPair& flight = flights.at(f);
+
+		map<FixPair, SearchPath>::const_iterator batchIter = batchPaths.find(flight);
+		map<FixPair, SearchPath>::const_iterator iter = singlePaths.find(flight);
+		if ((batchIter == batchPaths.end()) || (iter == singlePaths.end())) {
+			printf("FAILED: wind case %d, no path for %s -> %s\n", windCase, flight.origin.c_str(), flight.destination.c_str());
+
+			return 1;
+		}
+
+		const deque<int>& batchNodes = batchIter->second.getNodes();
+		const deque<int>& nodes = iter->second.getNodes();
+		if (batchNodes != nodes) {
+			if (mismatches < 10) {
+				printf("Mismatch: wind case %d, %s -> %s at %.0f ft, %.0f ft/s (%u and %u nodes)\n",
+						windCase, flight.origin.c_str(), flight.destination.c_str(),
+						flight.altitude, flight.airspeed,
+						(unsigned int)batchNodes.size(), (unsigned int)nodes.size());
+			}
+			mismatches++;
+		}
+
+		if (nodes.size() > 2)
+			multiNode++;
+	}
+
+	printf("Wind case %d: %u flights, %d routed over more than one link, %d mismatches\n",
+			windCase, (unsigned int)flights.size(), multiNode, mismatches);
+
+	return (mismatches == 0) ? 0 : 1;
+}
+
+int main() {
+	load_lattice_navdata();
+
+	omp_init_lock(&paths_lock);
+
+	const double altitudes_ft[] = {31000, 35000};
+	const double airspeeds_fps[] = {750, 820};
+
+	vector<FixPair> flights;
+	int count = 0;
+	for (int from = 0; from < TEST_NUM_ROWS * TEST_NUM_COLS; from++) {
+		for (int to = 0; to < TEST_NUM_ROWS * TEST_NUM_COLS; to++) {
+			if (from == to)
+				continue;
+
+			stringstream ss;
+			ss << "TST" << count;
+
+			FixPair flight(fix_name(from / TEST_NUM_COLS, from % TEST_NUM_COLS),
+					fix_name(to / TEST_NUM_COLS, to % TEST_NUM_COLS), ss.str());
+			flight.altitude = altitudes_ft[count % 2];
+			flight.airspeed = airspeeds_fps[(count / 2) % 2];
+
+			flights.push_back(flight);
+			count++;
+		}
+	}
+
+	int failures = 0;
+	failures += check_case(TEST_WIND_NONE, flights);
+	failures += check_case(TEST_WIND_UNIFORM, flights);
+	failures += check_case(TEST_WIND_HOURLY, flights);
+
+	if (failures > 0) {
+		printf("FAILED: batch paths differ from the single-flight search\n");
+
+		return 1;
+	}
+
+	printf("PASSED\n");
+
+	return 0;
+}
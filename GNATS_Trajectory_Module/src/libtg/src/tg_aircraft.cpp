@@ -35,6 +35,7 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 
 #include "AirportLayoutDataLoader.h"
 #include "tg_aircraft.h"
+#include "tg_aircraftIndex.h"
 #include "tg_trajectory.h"
 #include "tg_pars.h"
 #include "tg_sidstars.h"
@@ -75,6 +76,7 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include <iomanip>
 
 #include <omp.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -587,7 +589,7 @@ static real_t climb_integrand(real_t h, int model_index) {
 	return (sqrt(v*v - hdot*hdot) / hdot);
 }
 
-real_t compute_descent_dist(int adb_table, real_t dest_elev, real_t cruise_alt) {
+static real_t integrate_descent_dist(int adb_table, real_t dest_elev, real_t cruise_alt) {
 	real_t dist = 0.0;
 
 	int model_index = adb_table;
@@ -627,7 +629,7 @@ real_t compute_descent_dist(int adb_table, real_t dest_elev, real_t cruise_alt)
 	return dist;
 }
 
-real_t compute_climb_dist(int adb_table, real_t orig_elev, real_t cruise_alt) {
+static real_t integrate_climb_dist(int adb_table, real_t orig_elev, real_t cruise_alt) {
 
 	int model_index = adb_table;
 	int row = 0;
@@ -685,6 +687,258 @@ real_t compute_climb_dist(int adb_table, real_t orig_elev, real_t cruise_alt) {
 	return dist;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// TOC/TOD profile cache
+//
+// The climb and descent distances only depend on the ADB type, the field
+// elevation and the cruise altitude, and a full-day load computes the
+// same few thousand profiles over and over.  Results are kept keyed by
+// the exact inputs, so a cached distance is bit-identical to a fresh
+// integration.  The cache is dropped together with the ADB tables.
+// Saved caches carry a fingerprint of the PTF tables and are only loaded
+// back against the same tables.
+////////////////////////////////////////////////////////////////////////////////
+
+static const char TOC_TOD_PROFILE_CACHE_MAGIC[8] = {'G', 'N', 'A', 'T', 'S', 'T', 'C', 'D'};
+static const int TOC_TOD_PROFILE_CACHE_VERSION = 1;
+
+typedef struct _toc_tod_profile_key_t {
+	int adb_table;
+	int flag_climb;
+	real_t elev_ft;
+	real_t cruise_alt_ft;
+
+	bool operator<(const struct _toc_tod_profile_key_t& other) const {
+		if (adb_table != other.adb_table) return adb_table < other.adb_table;
+		if (flag_climb != other.flag_climb) return flag_climb < other.flag_climb;
+		if (elev_ft != other.elev_ft) return elev_ft < other.elev_ft;
+		return cruise_alt_ft < other.cruise_alt_ft;
+	}
+} toc_tod_profile_key_t;
+
+typedef struct _toc_tod_profile_record_t {
+	int adb_table;
+	int flag_climb;
+	double elev_ft;
+	double cruise_alt_ft;
+	double dist_ft;
+} toc_tod_profile_record_t;
+
+static map<toc_tod_profile_key_t, real_t> toc_tod_profile_cache;
+
+static long long toc_tod_profile_hits = 0;
+static long long toc_tod_profile_misses = 0;
+
+static pthread_mutex_t toc_tod_profile_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void hash_bytes(unsigned long long& hash, const void* data, const size_t len) {
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ bytes[i]) * 1099511628211ULL;
+	}
+}
+
+static void hash_ptf_table(unsigned long long& hash, const map<double, double>& table) {
+	map<double, double>::const_iterator iter;
+	for (iter = table.begin(); iter != table.end(); iter++) {
+		hash_bytes(hash, &(iter->first), sizeof(double));
+		hash_bytes(hash, &(iter->second), sizeof(double));
+	}
+}
+
+// FNV-1a over the PTF tables the integrations read
+static unsigned long long compute_ptf_fingerprint() {
+	unsigned long long hash = 1469598103934665603ULL;
+
+	for (unsigned int i = 0; i < g_adb_ptf_models.size(); i++) {
+		const AdbPTFModel& model = g_adb_ptf_models.at(i);
+
+		hash_bytes(hash, model.altitudes.data(), model.altitudes.size() * sizeof(double));
+		hash_ptf_table(hash, model.cruiseTas);
+		hash_ptf_table(hash, model.climbTas);
+		hash_ptf_table(hash, model.climbRateNom);
+		hash_ptf_table(hash, model.climbDistNom);
+		hash_ptf_table(hash, model.descentTas);
+		hash_ptf_table(hash, model.descentRateNom);
+	}
+
+	return hash;
+}
+
+static real_t lookup_toc_tod_profile(const int adb_table,
+		const bool flag_climb,
+		const real_t elev,
+		const real_t cruise_alt) {
+	toc_tod_profile_key_t key;
+	key.adb_table = adb_table;
+	key.flag_climb = flag_climb ? 1 : 0;
+	key.elev_ft = elev;
+	key.cruise_alt_ft = cruise_alt;
+
+	pthread_mutex_lock(&toc_tod_profile_mutex);
+
+	map<toc_tod_profile_key_t, real_t>::const_iterator iter = toc_tod_profile_cache.find(key);
+	if (iter != toc_tod_profile_cache.end()) {
+		const real_t dist = iter->second;
+
+		toc_tod_profile_hits++;
+
+		pthread_mutex_unlock(&toc_tod_profile_mutex);
+
+		return dist;
+	}
+
+	toc_tod_profile_misses++;
+
+	pthread_mutex_unlock(&toc_tod_profile_mutex);
+
+	// Integrate outside the lock so parallel loaders fill the cache concurrently
+	const real_t dist = flag_climb ? integrate_climb_dist(adb_table, elev, cruise_alt) : integrate_descent_dist(adb_table, elev, cruise_alt);
+
+	pthread_mutex_lock(&toc_tod_profile_mutex);
+	toc_tod_profile_cache.insert(pair<toc_tod_profile_key_t, real_t>(key, dist));
+	pthread_mutex_unlock(&toc_tod_profile_mutex);
+
+	return dist;
+}
+
+real_t compute_descent_dist(int adb_table, real_t dest_elev, real_t cruise_alt) {
+	return lookup_toc_tod_profile(adb_table, false, dest_elev, cruise_alt);
+}
+
+real_t compute_climb_dist(int adb_table, real_t orig_elev, real_t cruise_alt) {
+	return lookup_toc_tod_profile(adb_table, true, orig_elev, cruise_alt);
+}
+
+void clear_toc_tod_profile_cache() {
+	pthread_mutex_lock(&toc_tod_profile_mutex);
+
+	toc_tod_profile_cache.clear();
+	toc_tod_profile_hits = 0;
+	toc_tod_profile_misses = 0;
+
+	pthread_mutex_unlock(&toc_tod_profile_mutex);
+}
+
+void clear_route_cache() {
+	FlightPlanParser::clearRouteCache();
+}
+
+int save_toc_tod_profile_cache(const string& fname) {
+	FILE* fp = fopen(fname.c_str(), "wb");
+	if (fp == NULL) {
+		printf("Can't open TOC/TOD profile cache file %s for writing\n", fname.c_str());
+
+		return -1;
+	}
+
+	pthread_mutex_lock(&toc_tod_profile_mutex);
+
+	const unsigned long long fingerprint = compute_ptf_fingerprint();
+	const long long num_records = toc_tod_profile_cache.size();
+
+	bool flag_ok = (fwrite(TOC_TOD_PROFILE_CACHE_MAGIC, sizeof(TOC_TOD_PROFILE_CACHE_MAGIC), 1, fp) == 1)
+			&& (fwrite(&TOC_TOD_PROFILE_CACHE_VERSION, sizeof(TOC_TOD_PROFILE_CACHE_VERSION), 1, fp) == 1)
+			&& (fwrite(&fingerprint, sizeof(fingerprint), 1, fp) == 1)
+			&& (fwrite(&num_records, sizeof(num_records), 1, fp) == 1);
+
+	map<toc_tod_profile_key_t, real_t>::const_iterator iter;
+	for (iter = toc_tod_profile_cache.begin(); (flag_ok) && (iter != toc_tod_profile_cache.end()); iter++) {
+		toc_tod_profile_record_t record;
+		record.adb_table = iter->first.adb_table;
+		record.flag_climb = iter->first.flag_climb;
+		record.elev_ft = iter->first.elev_ft;
+		record.cruise_alt_ft = iter->first.cruise_alt_ft;
+		record.dist_ft = iter->second;
+
+		flag_ok = (fwrite(&record, sizeof(record), 1, fp) == 1);
+	}
+
+	pthread_mutex_unlock(&toc_tod_profile_mutex);
+
+	if ((fclose(fp) != 0) || (!flag_ok)) {
+		printf("Failed to write TOC/TOD profile cache file %s\n", fname.c_str());
+
+		return -1;
+	}
+
+	printf("  Saved %lld TOC/TOD profiles to %s\n", num_records, fname.c_str());
+
+	return 0;
+}
+
+int load_toc_tod_profile_cache(const string& fname) {
+	FILE* fp = fopen(fname.c_str(), "rb");
+	if (fp == NULL) {
+		printf("Can't open TOC/TOD profile cache file %s\n", fname.c_str());
+
+		return -1;
+	}
+
+	char magic[sizeof(TOC_TOD_PROFILE_CACHE_MAGIC)];
+	int version = 0;
+	unsigned long long fingerprint = 0;
+	long long num_records = 0;
+
+	if ((fread(magic, sizeof(magic), 1, fp) != 1)
+			|| (memcmp(magic, TOC_TOD_PROFILE_CACHE_MAGIC, sizeof(magic)) != 0)
+			|| (fread(&version, sizeof(version), 1, fp) != 1)
+			|| (version != TOC_TOD_PROFILE_CACHE_VERSION)
+			|| (fread(&fingerprint, sizeof(fingerprint), 1, fp) != 1)
+			|| (fread(&num_records, sizeof(num_records), 1, fp) != 1)
+			|| (num_records < 0)) {
+		printf("%s is not a TOC/TOD profile cache file\n", fname.c_str());
+
+		fclose(fp);
+
+		return -1;
+	}
+
+	pthread_mutex_lock(&toc_tod_profile_mutex);
+
+	if (fingerprint != compute_ptf_fingerprint()) {
+		pthread_mutex_unlock(&toc_tod_profile_mutex);
+
+		printf("TOC/TOD profile cache file %s was built from different ADB tables.  Ignored.\n", fname.c_str());
+
+		fclose(fp);
+
+		return -1;
+	}
+
+	int retValue = 0;
+
+	for (long long i = 0; i < num_records; i++) {
+		toc_tod_profile_record_t record;
+		if ((fread(&record, sizeof(record), 1, fp) != 1)
+				|| (record.adb_table < 0) || (record.adb_table >= (int)g_adb_ptf_models.size())) {
+			printf("TOC/TOD profile cache file %s is truncated or corrupt\n", fname.c_str());
+
+			retValue = -1;
+
+			break;
+		}
+
+		toc_tod_profile_key_t key;
+		key.adb_table = record.adb_table;
+		key.flag_climb = record.flag_climb;
+		key.elev_ft = record.elev_ft;
+		key.cruise_alt_ft = record.cruise_alt_ft;
+
+		toc_tod_profile_cache[key] = record.dist_ft;
+	}
+
+	pthread_mutex_unlock(&toc_tod_profile_mutex);
+
+	fclose(fp);
+
+	if (retValue == 0) {
+		printf("  Loaded %lld TOC/TOD profiles from %s\n", num_records, fname.c_str());
+	}
+
+	return retValue;
+}
+
 // helper struct for storing host data for active flights
 // we use this as a temporary storage struct on the host
 // because flights may be ignored
@@ -3133,6 +3387,8 @@ int load_aircraft(const string& trx_file, const string& mfl_file, const real_t&
 {
 	ignore_count = 0; // Reset
 	filter_count = 0; // Reset
+	toc_tod_profile_hits = 0; // Reset
+	toc_tod_profile_misses = 0; // Reset
 
 	printf("  Loading flight data\n");
 
@@ -3604,6 +3860,7 @@ omp_destroy_lock(&lock);
 	printf("    Total flight count:  %7d\n", total_trx_count);
 	printf("    Ignored flights:     %7d\n", total_ignored);
 	printf("    Valid flights:       %7d\n", total_active);
+	printf("    TOC/TOD profiles:    %7lld computed, %lld reused\n", toc_tod_profile_misses, toc_tod_profile_hits);
 
 	h_aircraft_soa.V_horizontal = (real_t*)calloc(num_flights, sizeof(real_t));
 	h_aircraft_soa.acceleration_aiming_waypoint_node_ptr = (waypoint_node_t**)malloc(num_flights * sizeof(waypoint_node_t*));
@@ -3655,6 +3912,9 @@ omp_destroy_lock(&lock);
 	cuda_malloc((void**)&d_aircraft_soa.toc_index, int_array_size);
 	cuda_malloc((void**)&d_aircraft_soa.tod_index, int_array_size);
 
+	// Positions were (re)loaded on the host side
+	invalidate_aircraft_index();
+
 	// copy from host to device
 	cuda_memcpy_async(d_aircraft_soa.departure_time_sec, h_aircraft_soa.departure_time_sec, real_array_size, cudaMemcpyHostToDevice, 0);
 	cuda_memcpy_async(d_aircraft_soa.cruise_alt_ft, h_aircraft_soa.cruise_alt_ft, real_array_size, cudaMemcpyHostToDevice, 0);
@@ -4023,6 +4283,8 @@ bool collect_user_upload_aircraft(string string_track_time,
 int destroy_aircraft() {
 	g_map_clearance_aircraft.clear();
 
+	clear_aircraft_index();
+
    	if (!g_trajectories.empty()) g_trajectories.clear();
 
     if (!map_Acid_FlightSeq.empty()) map_Acid_FlightSeq.clear();
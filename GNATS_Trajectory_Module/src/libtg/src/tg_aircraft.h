@@ -185,6 +185,22 @@ real_t compute_descent_dist(int adb_table, real_t dest_elev, real_t cruise_alt);
 
 real_t compute_climb_dist(int adb_table, real_t orig_elev, real_t cruise_alt);
 
+/*
+ * Climb and descent distances are cached per ADB type, field elevation and
+ * cruise altitude.  The cache can be saved and loaded back against the
+ * same ADB tables to speed up later loads.
+ */
+void clear_toc_tod_profile_cache();
+int save_toc_tod_profile_cache(const string& fname);
+int load_toc_tod_profile_cache(const string& fname);
+
+/*
+ * Drop the routes and navdata index cached by the flight plan parser.
+ * The parser only checks the navdata vectors' address and size, so the
+ * cache must be cleared whenever the navdata is unloaded.
+ */
+void clear_route_cache();
+
 waypoint_node_t* getWaypointNodePtr_by_flightSeq(int flightSeq, int index_airborne_waypoint);
 
 real_t get_airport_elevation(const string& airport_code);
@@ -0,0 +1,368 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_aircraftIndex.cpp
+ *
+ * Latitude/longitude cell grid and altitude-sorted list over h_aircraft_soa.
+ */
+
+#include "tg_aircraftIndex.h"
+
+#include "tg_aircraft.h"
+
+#include "geometry_utils.h"
+#include "real_t.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace osi;
+
+using std::lower_bound;
+using std::max;
+using std::min;
+using std::pair;
+using std::sort;
+
+#define AIRCRAFT_INDEX_ROWS 180
+#define AIRCRAFT_INDEX_COLS 360
+
+// Angular allowance, in degrees, on the box that bounds a range query.
+// Candidates are always re-tested with compute_distance_gc().
+#define AIRCRAFT_INDEX_RANGE_SLACK_DEG 1e-6
+
+typedef struct _aircraft_index_t {
+	bool valid;
+
+	// Source arrays the snapshot was taken from
+	int num_flights;
+	const real_t* source_latitude_deg;
+
+	vector<real_t> latitude_deg;
+	vector<real_t> longitude_deg;
+	vector<real_t> altitude_ft;
+
+	// Flight sequences of cell c are cell_items[cell_start[c] .. cell_start[c+1])
+	vector<int> cell_start;
+	vector<int> cell_items;
+
+	// Flights whose position falls outside the grid extent
+	vector<int> outside_items;
+
+	// Flights with a valid altitude, sorted by altitude
+	vector<pair<real_t, int> > altitude_sorted;
+
+	_aircraft_index_t() : valid(false), num_flights(0), source_latitude_deg(NULL) {}
+} aircraft_index_t;
+
+static aircraft_index_t aircraft_index;
+
+static pthread_mutex_t aircraft_index_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static inline bool is_in_altitude_band(const real_t& altitude_ft, const double& minAltitude_ft, const double& maxAltitude_ft) {
+	if ((minAltitude_ft >= 0) && (maxAltitude_ft >= 0)) {
+		return (minAltitude_ft <= altitude_ft) && (altitude_ft < maxAltitude_ft);
+	} else if (minAltitude_ft >= 0) {
+		return (minAltitude_ft <= altitude_ft);
+	} else if (maxAltitude_ft >= 0) {
+		return (altitude_ft < maxAltitude_ft);
+	}
+
+	return true;
+}
+
+/*
+ * Grid cell of a position, or -1 if it lies outside the grid extent.
+ */
+static inline int get_cell(const real_t& latitude_deg, const real_t& longitude_deg) {
+	if (!((-90 <= latitude_deg) && (latitude_deg <= 90) && (-180 <= longitude_deg) && (longitude_deg <= 180)))
+		return -1;
+
+	int row = min((int)floor(latitude_deg + 90.), AIRCRAFT_INDEX_ROWS - 1);
+	int col = min((int)floor(longitude_deg + 180.), AIRCRAFT_INDEX_COLS - 1);
+
+	return row * AIRCRAFT_INDEX_COLS + col;
+}
+
+static inline int clamp_row(const double& latitude_deg) {
+	double row = floor(latitude_deg + 90.);
+
+	return (int)max(0., min((double)(AIRCRAFT_INDEX_ROWS - 1), row));
+}
+
+static void rebuild_aircraft_index() {
+	aircraft_index_t& idx = aircraft_index;
+
+	idx.num_flights = (h_aircraft_soa.latitude_deg == NULL) ? 0 : get_num_flights();
+
+	idx.source_latitude_deg = h_aircraft_soa.latitude_deg;
+
+	const int n = idx.num_flights;
+
+	idx.latitude_deg.assign(h_aircraft_soa.latitude_deg, h_aircraft_soa.latitude_deg + n);
+	idx.longitude_deg.assign(h_aircraft_soa.longitude_deg, h_aircraft_soa.longitude_deg + n);
+	idx.altitude_ft.assign(h_aircraft_soa.altitude_ft, h_aircraft_soa.altitude_ft + n);
+
+	idx.cell_start.assign(AIRCRAFT_INDEX_ROWS * AIRCRAFT_INDEX_COLS + 1, 0);
+	idx.cell_items.resize(n);
+	idx.outside_items.clear();
+	idx.altitude_sorted.clear();
+
+	vector<int> cells(n);
+	for (int i = 0; i < n; i++) {
+		cells[i] = get_cell(idx.latitude_deg[i], idx.longitude_deg[i]);
+		if (cells[i] < 0) {
+			// NaN positions never satisfy a query
+			if (!std::isnan(idx.latitude_deg[i]) && !std::isnan(idx.longitude_deg[i])) {
+				idx.outside_items.push_back(i);
+			}
+		} else {
+			idx.cell_start[cells[i] + 1]++;
+		}
+
+		if (!std::isnan(idx.altitude_ft[i])) {
+			idx.altitude_sorted.push_back(pair<real_t, int>(idx.altitude_ft[i], i));
+		}
+	}
+
+	for (unsigned int c = 1; c < idx.cell_start.size(); c++) {
+		idx.cell_start[c] += idx.cell_start[c - 1];
+	}
+
+	// Counting sort keeps flight sequences ascending within every cell
+	vector<int> cursor(idx.cell_start.begin(), idx.cell_start.end() - 1);
+	for (int i = 0; i < n; i++) {
+		if (cells[i] >= 0) {
+			idx.cell_items[cursor[cells[i]]++] = i;
+		}
+	}
+	idx.cell_items.resize(idx.cell_start.back());
+
+	sort(idx.altitude_sorted.begin(), idx.altitude_sorted.end());
+
+	idx.valid = true;
+}
+
+static inline bool altitude_entry_less(const pair<real_t, int>& entry, const double& altitude_ft) {
+	return (entry.first < altitude_ft);
+}
+
+static inline void lock_valid_aircraft_index() {
+	pthread_mutex_lock(&aircraft_index_mutex);
+
+	// Flights loaded or destroyed without an invalidation also force a rebuild
+	if ((!aircraft_index.valid) ||
+			(aircraft_index.source_latitude_deg != h_aircraft_soa.latitude_deg) ||
+			(aircraft_index.num_flights != ((h_aircraft_soa.latitude_deg == NULL) ? 0 : get_num_flights()))) {
+		rebuild_aircraft_index();
+	}
+}
+
+static inline void unlock_aircraft_index() {
+	pthread_mutex_unlock(&aircraft_index_mutex);
+}
+
+void invalidate_aircraft_index() {
+	pthread_mutex_lock(&aircraft_index_mutex);
+	aircraft_index.valid = false;
+	pthread_mutex_unlock(&aircraft_index_mutex);
+}
+
+void clear_aircraft_index() {
+	pthread_mutex_lock(&aircraft_index_mutex);
+
+	aircraft_index.valid = false;
+	aircraft_index.num_flights = 0;
+	aircraft_index.source_latitude_deg = NULL;
+	aircraft_index.latitude_deg.clear();
+	aircraft_index.longitude_deg.clear();
+	aircraft_index.altitude_ft.clear();
+	aircraft_index.cell_start.clear();
+	aircraft_index.cell_items.clear();
+	aircraft_index.outside_items.clear();
+	aircraft_index.altitude_sorted.clear();
+
+	pthread_mutex_unlock(&aircraft_index_mutex);
+}
+
+void get_aircraft_in_box(const double minLatitude, const double maxLatitude,
+		const double minLongitude, const double maxLongitude,
+		const double minAltitude_ft, const double maxAltitude_ft,
+		vector<int>& flight_seqs) {
+	flight_seqs.clear();
+
+	// Half-open ranges are empty unless min < max (also false on NaN)
+	if (!(minLatitude < maxLatitude) || !(minLongitude < maxLongitude))
+		return;
+
+	lock_valid_aircraft_index();
+
+	const aircraft_index_t& idx = aircraft_index;
+
+	const int rowLo = clamp_row(minLatitude);
+	const int rowHi = clamp_row(maxLatitude);
+	const int colLo = (int)max(0., min((double)(AIRCRAFT_INDEX_COLS - 1), floor(minLongitude + 180.)));
+	const int colHi = (int)max(0., min((double)(AIRCRAFT_INDEX_COLS - 1), floor(maxLongitude + 180.)));
+
+	for (int row = rowLo; row <= rowHi; row++) {
+		const int itemLo = idx.cell_start[row * AIRCRAFT_INDEX_COLS + colLo];
+		const int itemHi = idx.cell_start[row * AIRCRAFT_INDEX_COLS + colHi + 1];
+
+		for (int k = itemLo; k < itemHi; k++) {
+			const int i = idx.cell_items[k];
+			if ((minLatitude <= idx.latitude_deg[i]) &&
+					(idx.latitude_deg[i] < maxLatitude) &&
+					(minLongitude <= idx.longitude_deg[i]) &&
+					(idx.longitude_deg[i] < maxLongitude) &&
+					is_in_altitude_band(idx.altitude_ft[i], minAltitude_ft, maxAltitude_ft)) {
+				flight_seqs.push_back(i);
+			}
+		}
+	}
+
+	for (unsigned int k = 0; k < idx.outside_items.size(); k++) {
+		const int i = idx.outside_items[k];
+		if ((minLatitude <= idx.latitude_deg[i]) &&
+				(idx.latitude_deg[i] < maxLatitude) &&
+				(minLongitude <= idx.longitude_deg[i]) &&
+				(idx.longitude_deg[i] < maxLongitude) &&
+				is_in_altitude_band(idx.altitude_ft[i], minAltitude_ft, maxAltitude_ft)) {
+			flight_seqs.push_back(i);
+		}
+	}
+
+	unlock_aircraft_index();
+
+	sort(flight_seqs.begin(), flight_seqs.end());
+}
+
+void get_aircraft_within_range(const double latitude_deg, const double longitude_deg, const double range_ft,
+		const double minAltitude_ft, const double maxAltitude_ft,
+		vector<int>& flight_seqs) {
+	flight_seqs.clear();
+
+	if (!(range_ft >= 0) || std::isnan(latitude_deg) || std::isnan(longitude_deg))
+		return;
+
+	lock_valid_aircraft_index();
+
+	const aircraft_index_t& idx = aircraft_index;
+
+	const double range_deg = range_ft / RADIUS_EARTH_FT * 180. / M_PI + AIRCRAFT_INDEX_RANGE_SLACK_DEG;
+
+	int rowLo = 0;
+	int rowHi = AIRCRAFT_INDEX_ROWS - 1;
+	int colFirst = 0;
+	int colLast = AIRCRAFT_INDEX_COLS - 1;
+
+	if ((-90 <= latitude_deg) && (latitude_deg <= 90)) {
+		rowLo = clamp_row(latitude_deg - range_deg);
+		rowHi = clamp_row(latitude_deg + range_deg);
+
+		// Longitude extent of a spherical cap that does not contain a pole
+		if ((fabs(latitude_deg) + range_deg < 90) && (range_deg < 90)) {
+			const double range_rad = range_deg * M_PI / 180.;
+			const double dLon_deg = asin(min(1., sin(range_rad) / cos(latitude_deg * M_PI / 180.))) * 180. / M_PI + AIRCRAFT_INDEX_RANGE_SLACK_DEG;
+
+			if (dLon_deg < 180) {
+				colFirst = (int)floor(longitude_deg - dLon_deg + 180.);
+				colLast = (int)floor(longitude_deg + dLon_deg + 180.);
+				if (colLast - colFirst >= AIRCRAFT_INDEX_COLS) {
+					colFirst = 0;
+					colLast = AIRCRAFT_INDEX_COLS - 1;
+				}
+			}
+		}
+	}
+
+	for (int row = rowLo; row <= rowHi; row++) {
+		for (int c = colFirst; c <= colLast; c++) {
+			// Columns wrap across the antimeridian
+			const int col = ((c % AIRCRAFT_INDEX_COLS) + AIRCRAFT_INDEX_COLS) % AIRCRAFT_INDEX_COLS;
+			const int cell = row * AIRCRAFT_INDEX_COLS + col;
+
+			for (int k = idx.cell_start[cell]; k < idx.cell_start[cell + 1]; k++) {
+				const int i = idx.cell_items[k];
+				if (is_in_altitude_band(idx.altitude_ft[i], minAltitude_ft, maxAltitude_ft) &&
+						(compute_distance_gc(latitude_deg, longitude_deg, idx.latitude_deg[i], idx.longitude_deg[i], 0) <= range_ft)) {
+					flight_seqs.push_back(i);
+				}
+			}
+		}
+	}
+
+	for (unsigned int k = 0; k < idx.outside_items.size(); k++) {
+		const int i = idx.outside_items[k];
+		if (is_in_altitude_band(idx.altitude_ft[i], minAltitude_ft, maxAltitude_ft) &&
+				(compute_distance_gc(latitude_deg, longitude_deg, idx.latitude_deg[i], idx.longitude_deg[i], 0) <= range_ft)) {
+			flight_seqs.push_back(i);
+		}
+	}
+
+	unlock_aircraft_index();
+
+	sort(flight_seqs.begin(), flight_seqs.end());
+}
+
+void get_aircraft_in_altitude_band(const double minAltitude_ft, const double maxAltitude_ft,
+		vector<int>& flight_seqs) {
+	flight_seqs.clear();
+
+	lock_valid_aircraft_index();
+
+	const aircraft_index_t& idx = aircraft_index;
+
+	if (!(minAltitude_ft >= 0) && !(maxAltitude_ft >= 0)) {
+		// Unbounded band, every flight qualifies
+		for (int i = 0; i < idx.num_flights; i++) {
+			flight_seqs.push_back(i);
+		}
+	} else {
+		vector<pair<real_t, int> >::const_iterator itemLo = idx.altitude_sorted.begin();
+		vector<pair<real_t, int> >::const_iterator itemHi = idx.altitude_sorted.end();
+
+		if (minAltitude_ft >= 0) {
+			itemLo = lower_bound(itemLo, itemHi, minAltitude_ft, altitude_entry_less);
+		}
+		if (maxAltitude_ft >= 0) {
+			itemHi = max(itemLo, lower_bound(itemLo, itemHi, maxAltitude_ft, altitude_entry_less));
+		}
+
+		for (; itemLo != itemHi; itemLo++) {
+			flight_seqs.push_back(itemLo->second);
+		}
+	}
+
+	unlock_aircraft_index();
+
+	sort(flight_seqs.begin(), flight_seqs.end());
+}
@@ -0,0 +1,84 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_aircraftIndex.h
+ *
+ * Spatial index over the current aircraft positions held in h_aircraft_soa.
+ *
+ * The index is a 1x1 degree latitude/longitude cell grid plus an
+ * altitude-sorted list.  It is marked stale whenever h_aircraft_soa
+ * positions are refreshed and rebuilt on the next query, so several
+ * queries issued within one simulation step share a single rebuild.
+ *
+ * Queries return flight sequence numbers in ascending order, which is the
+ * order a linear scan over all flights would produce.
+ */
+
+#ifndef TG_AIRCRAFT_INDEX_H_
+#define TG_AIRCRAFT_INDEX_H_
+
+#include <vector>
+
+using std::vector;
+
+/*
+ * Mark the index stale.  Call after h_aircraft_soa latitude, longitude or
+ * altitude values have been written.
+ */
+void invalidate_aircraft_index();
+
+void clear_aircraft_index();
+
+/*
+ * Aircraft with minLatitude <= latitude < maxLatitude and
+ * minLongitude <= longitude < maxLongitude.
+ *
+ * The altitude band follows getAircraftIds(): a negative bound is
+ * unbounded on that side, otherwise minAltitude_ft <= altitude < maxAltitude_ft.
+ */
+void get_aircraft_in_box(const double minLatitude, const double maxLatitude,
+		const double minLongitude, const double maxLongitude,
+		const double minAltitude_ft, const double maxAltitude_ft,
+		vector<int>& flight_seqs);
+
+/*
+ * Aircraft whose great circle distance to the given position is at most
+ * range_ft.  Altitude band semantics are those of get_aircraft_in_box().
+ */
+void get_aircraft_within_range(const double latitude_deg, const double longitude_deg, const double range_ft,
+		const double minAltitude_ft, const double maxAltitude_ft,
+		vector<int>& flight_seqs);
+
+/*
+ * Aircraft inside the altitude band, regardless of position.
+ */
+void get_aircraft_in_altitude_band(const double minAltitude_ft, const double maxAltitude_ft,
+		vector<int>& flight_seqs);
+
+#endif
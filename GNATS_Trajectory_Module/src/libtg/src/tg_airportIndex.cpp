@@ -0,0 +1,349 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_airportIndex.cpp
+ *
+ * Static kd-tree over airport positions (unit vectors on the sphere).
+ */
+
+#include "tg_airportIndex.h"
+
+#include "geometry_utils.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace osi;
+
+using std::max;
+using std::min;
+using std::nth_element;
+using std::sort;
+
+// Maximum number of airports held by a leaf node
+#define AIRPORT_INDEX_LEAF_SIZE 8
+
+// Allowance, in unit-sphere chord length, for round-off between the chord
+// bound used for pruning and the haversine distance used for the answer.
+// 1e-9 of the earth radius is well under an inch.
+#define AIRPORT_INDEX_CHORD_SLACK 1e-9
+
+// Batches smaller than this are evaluated on the calling thread
+#define AIRPORT_INDEX_MIN_PARALLEL_BATCH 64
+
+typedef struct _airport_index_point_t {
+	double xyz[3];
+	double latitude;
+	double longitude;
+	int code_rank; // Position of the airport code in map order
+} airport_index_point_t;
+
+typedef struct _airport_index_node_t {
+	double box_min[3];
+	double box_max[3];
+	int lo;
+	int hi;
+	int left;  // -1 on leaf nodes
+	int right;
+} airport_index_node_t;
+
+static vector<string> airport_index_codes;
+static vector<airport_index_point_t> airport_index_points;
+static vector<airport_index_node_t> airport_index_nodes;
+
+static inline void latlon_to_unit_vector(const double& latitude_deg, const double& longitude_deg, double xyz[3]) {
+	const double latRad = latitude_deg * M_PI / 180.;
+	const double lonRad = longitude_deg * M_PI / 180.;
+	const double cosLat = cos(latRad);
+
+	xyz[0] = cosLat * cos(lonRad);
+	xyz[1] = cosLat * sin(lonRad);
+	xyz[2] = sin(latRad);
+}
+
+static inline double squared_distance_to_box(const airport_index_node_t& node, const double xyz[3]) {
+	double sum = 0;
+	for (int k = 0; k < 3; k++) {
+		double d = 0;
+		if (xyz[k] < node.box_min[k]) {
+			d = node.box_min[k] - xyz[k];
+		} else if (xyz[k] > node.box_max[k]) {
+			d = xyz[k] - node.box_max[k];
+		}
+		sum += d * d;
+	}
+
+	return sum;
+}
+
+/*
+ * Upper bound on the chord length between two points on the unit sphere
+ * whose great circle distance is dist_ft.
+ */
+static inline double chord_limit(const double& dist_ft) {
+	const double theta = dist_ft / RADIUS_EARTH_FT;
+	if (!(theta < M_PI)) {
+		return 2. + AIRPORT_INDEX_CHORD_SLACK;
+	}
+
+	return 2. * sin(0.5 * max(theta, 0.)) + AIRPORT_INDEX_CHORD_SLACK;
+}
+
+struct airport_index_axis_less {
+	int axis;
+
+	bool operator()(const airport_index_point_t& a, const airport_index_point_t& b) const {
+		return a.xyz[axis] < b.xyz[axis];
+	}
+};
+
+static int build_node(const int lo, const int hi) {
+	airport_index_node_t node;
+	node.lo = lo;
+	node.hi = hi;
+	node.left = -1;
+	node.right = -1;
+
+	for (int k = 0; k < 3; k++) {
+		node.box_min[k] = std::numeric_limits<double>::max();
+		node.box_max[k] = -std::numeric_limits<double>::max();
+	}
+	for (int i = lo; i < hi; i++) {
+		for (int k = 0; k < 3; k++) {
+			node.box_min[k] = min(node.box_min[k], airport_index_points[i].xyz[k]);
+			node.box_max[k] = max(node.box_max[k], airport_index_points[i].xyz[k]);
+		}
+	}
+
+	const int node_id = airport_index_nodes.size();
+	airport_index_nodes.push_back(node);
+
+	if (hi - lo > AIRPORT_INDEX_LEAF_SIZE) {
+		airport_index_axis_less cmp;
+		cmp.axis = 0;
+		for (int k = 1; k < 3; k++) {
+			if ((node.box_max[k] - node.box_min[k]) > (node.box_max[cmp.axis] - node.box_min[cmp.axis])) {
+				cmp.axis = k;
+			}
+		}
+
+		const int mid = lo + (hi - lo) / 2;
+		nth_element(airport_index_points.begin() + lo,
+				airport_index_points.begin() + mid,
+				airport_index_points.begin() + hi,
+				cmp);
+
+		const int left = build_node(lo, mid);
+		const int right = build_node(mid, hi);
+
+		// Vector may have grown; write through the index
+		airport_index_nodes[node_id].left = left;
+		airport_index_nodes[node_id].right = right;
+	}
+
+	return node_id;
+}
+
+void clear_airport_index() {
+	airport_index_codes.clear();
+	airport_index_points.clear();
+	airport_index_nodes.clear();
+}
+
+void build_airport_index(const map<string, NatsAirport*>& airports) {
+	clear_airport_index();
+
+	airport_index_codes.reserve(airports.size());
+	airport_index_points.reserve(airports.size());
+
+	map<string, NatsAirport*>::const_iterator ite;
+	for (ite = airports.begin(); ite != airports.end(); ite++) {
+		if (ite->second == NULL)
+			continue;
+
+		airport_index_point_t point;
+		point.latitude = ite->second->latitude;
+		point.longitude = ite->second->longitude;
+		point.code_rank = airport_index_codes.size();
+		latlon_to_unit_vector(point.latitude, point.longitude, point.xyz);
+
+		airport_index_codes.push_back(ite->first);
+		airport_index_points.push_back(point);
+	}
+
+	if (airport_index_points.size() > 0) {
+		airport_index_nodes.reserve(2 * airport_index_points.size() / AIRPORT_INDEX_LEAF_SIZE + 1);
+		build_node(0, airport_index_points.size());
+	}
+}
+
+int get_airport_index_size() {
+	return airport_index_points.size();
+}
+
+static int find_closest_rank(const double& latitude_deg, const double& longitude_deg) {
+	if (airport_index_nodes.empty())
+		return -1;
+
+	double xyz[3];
+	latlon_to_unit_vector(latitude_deg, longitude_deg, xyz);
+
+	int best_rank = -1;
+	double best_dist = std::numeric_limits<double>::infinity();
+	double best_chord2 = std::numeric_limits<double>::infinity();
+
+	vector<int> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+
+	while (!stack.empty()) {
+		const airport_index_node_t& node = airport_index_nodes[stack.back()];
+		stack.pop_back();
+
+		if (squared_distance_to_box(node, xyz) > best_chord2)
+			continue;
+
+		if (node.left < 0) {
+			for (int i = node.lo; i < node.hi; i++) {
+				const airport_index_point_t& point = airport_index_points[i];
+				const double dist = compute_distance_gc(latitude_deg, longitude_deg, point.latitude, point.longitude, 0);
+
+				// Equal distances resolve to the earlier airport in map order
+				if ((dist < best_dist) || ((dist == best_dist) && (point.code_rank < best_rank))) {
+					best_dist = dist;
+					best_rank = point.code_rank;
+
+					const double limit = chord_limit(best_dist);
+					best_chord2 = limit * limit;
+				}
+			}
+		} else {
+			// Push the farther child first so the nearer one is searched first
+			const double dLeft = squared_distance_to_box(airport_index_nodes[node.left], xyz);
+			const double dRight = squared_distance_to_box(airport_index_nodes[node.right], xyz);
+			if (dLeft < dRight) {
+				stack.push_back(node.right);
+				stack.push_back(node.left);
+			} else {
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+	}
+
+	return best_rank;
+}
+
+string get_closest_airport(const double& latitude_deg, const double& longitude_deg) {
+	const int rank = find_closest_rank(latitude_deg, longitude_deg);
+
+	return (rank < 0) ? string() : airport_index_codes[rank];
+}
+
+static void collect_ranks_within_range(const double& latitude_deg, const double& longitude_deg, const double& range_ft, vector<int>& ranks) {
+	ranks.clear();
+
+	if (airport_index_nodes.empty())
+		return;
+
+	double xyz[3];
+	latlon_to_unit_vector(latitude_deg, longitude_deg, xyz);
+
+	const double limit = chord_limit(range_ft);
+	const double limit2 = limit * limit;
+
+	vector<int> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+
+	while (!stack.empty()) {
+		const airport_index_node_t& node = airport_index_nodes[stack.back()];
+		stack.pop_back();
+
+		if (squared_distance_to_box(node, xyz) > limit2)
+			continue;
+
+		if (node.left < 0) {
+			for (int i = node.lo; i < node.hi; i++) {
+				const airport_index_point_t& point = airport_index_points[i];
+				const double dist = compute_distance_gc(latitude_deg, longitude_deg, point.latitude, point.longitude, 0);
+				if (dist <= range_ft) {
+					ranks.push_back(point.code_rank);
+				}
+			}
+		} else {
+			stack.push_back(node.left);
+			stack.push_back(node.right);
+		}
+	}
+
+	sort(ranks.begin(), ranks.end());
+}
+
+void get_airports_within_range(const double& latitude_deg, const double& longitude_deg, const double& range_ft, vector<string>& airport_codes) {
+	airport_codes.clear();
+
+	vector<int> ranks;
+	collect_ranks_within_range(latitude_deg, longitude_deg, range_ft, ranks);
+
+	airport_codes.reserve(ranks.size());
+	for (unsigned int i = 0; i < ranks.size(); i++) {
+		airport_codes.push_back(airport_index_codes[ranks[i]]);
+	}
+}
+
+void get_closest_airports(const int count, const double* latitude_deg, const double* longitude_deg, vector<string>& airport_codes) {
+	airport_codes.assign(max(count, 0), string());
+
+	if ((count <= 0) || (latitude_deg == NULL) || (longitude_deg == NULL))
+		return;
+
+#pragma omp parallel for schedule(dynamic, 16) if (count >= AIRPORT_INDEX_MIN_PARALLEL_BATCH)
+	for (int i = 0; i < count; i++) {
+		const int rank = find_closest_rank(latitude_deg[i], longitude_deg[i]);
+		if (rank >= 0) {
+			airport_codes[i] = airport_index_codes[rank];
+		}
+	}
+}
+
+void get_airports_within_range(const int count, const double* latitude_deg, const double* longitude_deg, const double& range_ft, vector<vector<string> >& airport_codes) {
+	airport_codes.assign(max(count, 0), vector<string>());
+
+	if ((count <= 0) || (latitude_deg == NULL) || (longitude_deg == NULL))
+		return;
+
+#pragma omp parallel for schedule(dynamic, 16) if (count >= AIRPORT_INDEX_MIN_PARALLEL_BATCH)
+	for (int i = 0; i < count; i++) {
+		get_airports_within_range(latitude_deg[i], longitude_deg[i], range_ft, airport_codes[i]);
+	}
+}
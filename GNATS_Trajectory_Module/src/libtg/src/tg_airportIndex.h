@@ -0,0 +1,85 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_airportIndex.h
+ *
+ * Spatial index over map_airport for closest-airport and airport-in-range
+ * queries.
+ *
+ * Airports are stored as unit vectors on the sphere in a static kd-tree.
+ * The tree only prunes candidates by chord length; every surviving airport
+ * is re-measured with compute_distance_gc() so answers are identical to a
+ * linear scan of map_airport (ties resolve to the lowest airport code, and
+ * range results are returned in airport code order).
+ */
+
+#ifndef TG_AIRPORT_INDEX_H_
+#define TG_AIRPORT_INDEX_H_
+
+#include "NatsAirport.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using std::map;
+using std::string;
+using std::vector;
+
+/*
+ * Build the index from the given airport map.  Any previous index is
+ * discarded.  Must be called again whenever map_airport changes.
+ */
+void build_airport_index(const map<string, NatsAirport*>& airports);
+
+void clear_airport_index();
+
+int get_airport_index_size();
+
+/*
+ * Code of the airport nearest to the given position.
+ * Returns an empty string if the index is empty.
+ */
+string get_closest_airport(const double& latitude_deg, const double& longitude_deg);
+
+/*
+ * Codes of all airports whose great circle distance to the given position
+ * is at most range_ft, sorted by airport code.
+ */
+void get_airports_within_range(const double& latitude_deg, const double& longitude_deg, const double& range_ft, vector<string>& airport_codes);
+
+/*
+ * Batched variants.  Positions are evaluated in parallel and results are
+ * returned in input order.
+ */
+void get_closest_airports(const int count, const double* latitude_deg, const double* longitude_deg, vector<string>& airport_codes);
+
+void get_airports_within_range(const int count, const double* latitude_deg, const double* longitude_deg, const double& range_ft, vector<vector<string> >& airport_codes);
+
+#endif
@@ -38,11 +38,13 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include "tg_api.h"
 #include "tg_adb.h"
 #include "tg_airports.h"
+#include "tg_airportIndex.h"
 #include "tg_waypoints.h"
 #include "tg_airways.h"
 #include "tg_pars.h"
 #include "tg_sidstars.h"
 #include "tg_sectors.h"
+#include "tg_centers.h"
 #include "tg_rap.h"
 #include "tg_aircraft.h"
 #include "tg_simulation.h"
@@ -178,6 +180,26 @@ typedef struct _hdf5_trajectory_t {
 	hvl_t   phase;
 } hdf5_trajectory_t;
 
+/*
+ * Entry of the /trajectory_index dataset.  The index lists the row of
+ * every trajectory in /trajectories together with its time range, sorted
+ * by callsign, so that readers can select flights without decoding the
+ * whole file.
+ */
+typedef struct _hdf5_trajectory_index_t {
+	char*   callsign;
+	long    row;
+	int     flight_index;
+	long    start_time;
+	long    end_time;
+	long    num_points;
+} hdf5_trajectory_index_t;
+
+#define TRAJECTORY_INDEX_VERSION 1
+
+// Number of trajectories read from an HDF5 file per H5Dread call
+#define TRAJECTORY_H5_READ_BATCH 256
+
 /*
  * private file-scope variables
  */
@@ -357,6 +379,14 @@ int tg_load_trx(const string& trx_file, const string& mfl_file) {
 	return 0;
 }
 
+int tg_load_toc_tod_profile_cache(const string& fname) {
+	return load_toc_tod_profile_cache(fname);
+}
+
+int tg_save_toc_tod_profile_cache(const string& fname) {
+	return save_toc_tod_profile_cache(fname);
+}
+
 int tg_generate(const long& t_horizon_minutes,
 		        const long& t_step_sec,
 		        vector<Trajectory>* const trajectories) {
@@ -368,6 +398,16 @@ int tg_generate(const long& t_horizon_minutes,
 	return err;
 }
 
+int tg_enable_cruise_fast_forward(const bool& flag) {
+	flag_enable_cruise_fast_forward = flag;
+	return 0;
+}
+
+int tg_enable_steady_step_skip(const bool& flag) {
+	flag_enable_steady_step_skip = flag;
+	return 0;
+}
+
 int tg_reset_aircraft() {
 	return 0;
 }
@@ -383,10 +423,14 @@ int tg_shutdown() {
 	// all others are stack allocated and don't need explicit memory freeing
 
 	destroy_adb_performance_tables();
+	clear_toc_tod_profile_cache();
+	clear_route_cache();
 	destroy_sectors();
+	destroy_centers();
 	destroy_rap();
 	destroy_aircraft();
 
+	clear_airport_index();
 	g_airports.clear();
 	g_airways.clear();
 
@@ -448,6 +492,75 @@ int tg_shutdown() {
 	return 0;
 }
 
+int tg_get_center_codes(vector<string>* const center_codes) {
+	if(!center_codes) return -1;
+	*center_codes = g_center_codes;
+	return 0;
+}
+
+int tg_get_fixes_in_center(const string& center_code, vector<string>* const fixes) {
+	if(!fixes) return -1;
+	fixes->clear();
+	map<string, vector<string> >::const_iterator ite = g_center_fixes.find(center_code);
+	if (ite != g_center_fixes.end()) {
+		*fixes = ite->second;
+	}
+	return 0;
+}
+
+int tg_get_current_center(const int& flight_index, string* const center_code) {
+	if(!center_code) return -1;
+	*center_code = get_center_code(get_flight_center_index(flight_index));
+	return 0;
+}
+
+int tg_get_center_traffic_count(const string& center_code, int* const count) {
+	if(!count) return -1;
+	int center_index = get_center_index(center_code);
+	if (center_index < 0) return -1;
+	vector<int> counts;
+	get_center_traffic_counts(counts);
+	*count = counts.at(center_index);
+	return 0;
+}
+
+int tg_get_center_events(vector<center_event_t>* const events) {
+	if(!events) return -1;
+	*events = g_center_events;
+	return 0;
+}
+
+int tg_enable_wake_vortex_model(const bool& flag) {
+	flag_enable_wake_vortex_model = flag;
+	return 0;
+}
+
+int tg_get_wake_encounters(vector<wake_encounter_t>* const encounters) {
+	if(!encounters) return -1;
+	*encounters = g_wake_encounters;
+	return 0;
+}
+
+int tg_enable_traffic_metrics(const bool& flag) {
+	flag_enable_traffic_metrics = flag;
+	return 0;
+}
+
+int tg_set_traffic_metrics_config(const float& bin_sec,
+		const vector<string>& sector_names,
+		const vector<string>& airport_codes,
+		const string& fname) {
+	return set_traffic_metrics_config(bin_sec, sector_names, airport_codes, fname);
+}
+
+int tg_get_traffic_metrics(traffic_metrics_t* const metrics) {
+	return get_traffic_metrics(metrics);
+}
+
+int tg_write_traffic_metrics(const string& fname) {
+	return write_traffic_metrics(fname);
+}
+
 int tg_get_trajectories(vector<Trajectory>* const trajectories) {
 	if(!trajectories) return -1;
 	trajectories->insert(trajectories->end(), g_trajectories.begin(),
@@ -455,6 +568,107 @@ int tg_get_trajectories(vector<Trajectory>* const trajectories) {
 	return 0;
 }
 
+static hid_t create_trajectory_index_mem_type(const hid_t& string_type) {
+    hid_t mem_index_type = H5Tcreate(H5T_COMPOUND, sizeof(hdf5_trajectory_index_t));
+    H5Tinsert(mem_index_type, "callsign", HOFFSET(hdf5_trajectory_index_t, callsign), string_type);
+    H5Tinsert(mem_index_type, "row", HOFFSET(hdf5_trajectory_index_t, row), H5T_NATIVE_LONG);
+    H5Tinsert(mem_index_type, "flight_index", HOFFSET(hdf5_trajectory_index_t, flight_index), H5T_NATIVE_INT);
+    H5Tinsert(mem_index_type, "start_time", HOFFSET(hdf5_trajectory_index_t, start_time), H5T_NATIVE_LONG);
+    H5Tinsert(mem_index_type, "end_time", HOFFSET(hdf5_trajectory_index_t, end_time), H5T_NATIVE_LONG);
+    H5Tinsert(mem_index_type, "num_points", HOFFSET(hdf5_trajectory_index_t, num_points), H5T_NATIVE_LONG);
+
+    return mem_index_type;
+}
+
+static bool trajectory_index_comparator(const hdf5_trajectory_index_t& a, const hdf5_trajectory_index_t& b) {
+	int cmp = strcmp(a.callsign, b.callsign);
+	if (cmp != 0)
+		return cmp < 0;
+
+	return a.row < b.row;
+}
+
+/*
+ * Write the /trajectory_index dataset next to /trajectories.
+ *
+ * Rows refer to the position of each trajectory in /trajectories.  Start
+ * and end times are the first and last timestamps of the trajectory.
+ */
+static int tg_write_trajectory_index_h5(const hid_t& file, const vector<Trajectory>& trajectories) {
+    hsize_t dims[1] = {trajectories.size()};
+
+    vector<hdf5_trajectory_index_t> index_entries(dims[0]);
+    for (hsize_t i = 0; i < dims[0]; ++i) {
+        const Trajectory& trajectory = trajectories.at(i);
+
+        index_entries[i].callsign = const_cast<char*>(trajectory.callsign.c_str());
+        index_entries[i].row = i;
+        index_entries[i].flight_index = trajectory.flight_index;
+        index_entries[i].num_points = trajectory.timestamp.size();
+        if (trajectory.timestamp.size() > 0) {
+            index_entries[i].start_time = (long)trajectory.timestamp.front();
+            index_entries[i].end_time = (long)trajectory.timestamp.back();
+        } else {
+            index_entries[i].start_time = (long)trajectory.start_time;
+            index_entries[i].end_time = (long)trajectory.start_time;
+        }
+    }
+
+    sort(index_entries.begin(), index_entries.end(), trajectory_index_comparator);
+
+    hid_t string_type = H5Tcopy(H5T_C_S1);
+    H5Tset_size(string_type, H5T_VARIABLE);
+
+    hid_t mem_index_type = create_trajectory_index_mem_type(string_type);
+
+    // Fixed-size little-endian types for the file, as for /trajectories
+    size_t file_index_size = H5Tget_size(string_type) + 4*H5Tget_size(H5T_STD_I64LE) + H5Tget_size(H5T_STD_I32LE);
+    hid_t file_index_type = H5Tcreate(H5T_COMPOUND, file_index_size);
+
+    size_t offset = 0;
+    H5Tinsert(file_index_type, "callsign", offset, string_type);
+    offset += H5Tget_size(string_type);
+    H5Tinsert(file_index_type, "row", offset, H5T_STD_I64LE);
+    offset += H5Tget_size(H5T_STD_I64LE);
+    H5Tinsert(file_index_type, "flight_index", offset, H5T_STD_I32LE);
+    offset += H5Tget_size(H5T_STD_I32LE);
+    H5Tinsert(file_index_type, "start_time", offset, H5T_STD_I64LE);
+    offset += H5Tget_size(H5T_STD_I64LE);
+    H5Tinsert(file_index_type, "end_time", offset, H5T_STD_I64LE);
+    offset += H5Tget_size(H5T_STD_I64LE);
+    H5Tinsert(file_index_type, "num_points", offset, H5T_STD_I64LE);
+
+    hid_t dataspace = H5Screate_simple(1, dims, NULL);
+    hid_t dataset = H5Dcreate2(file, "/trajectory_index",
+            file_index_type,
+            dataspace,
+            H5P_DEFAULT,
+            H5P_DEFAULT,
+            H5P_DEFAULT);
+
+    herr_t status = -1;
+    if (dataset >= 0) {
+        status = H5Dwrite(dataset, mem_index_type, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                (dims[0] > 0) ? &index_entries[0] : NULL);
+
+        int version = TRAJECTORY_INDEX_VERSION;
+        hid_t attr_space = H5Screate(H5S_SCALAR);
+        hid_t attr = H5Acreate2(dataset, "version", H5T_STD_I32LE, attr_space, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, H5T_NATIVE_INT, &version);
+        H5Aclose(attr);
+        H5Sclose(attr_space);
+
+        H5Dclose(dataset);
+    }
+
+    H5Sclose(dataspace);
+    H5Tclose(file_index_type);
+    H5Tclose(mem_index_type);
+    H5Tclose(string_type);
+
+    return (status < 0) ? -1 : 0;
+}
+
 static int tg_write_trajectories_h5(const string& fname, const vector<Trajectory>& trajectories) {
 
     // rank (num dims) of the array of output trajectories: 1
@@ -613,7 +827,7 @@ static int tg_write_trajectories_h5(const string& fname, const vector<Trajectory
     //offset = HOFFSET(hdf5_trajectory_t, sector_name);
     //H5Tinsert(mem_traj_type, "sector_name", offset, mem_str_array_type);
     offset = HOFFSET(hdf5_trajectory_t, phase);
-    H5Tinsert(mem_traj_type, "phase", offset, mem_int_array_type);
+    H5Tinsert(mem_traj_type, "mode", offset, mem_int_array_type);
 
     // Compute the size of the compound type
     // Notice
@@ -698,6 +912,8 @@ static int tg_write_trajectories_h5(const string& fname, const vector<Trajectory
     H5Dwrite(dataset, mem_traj_type, H5S_ALL, H5S_ALL, H5P_DEFAULT,
              hdf5_trajectories);
 
+    tg_write_trajectory_index_h5(file, trajectories);
+
     // close hdf5 resources
     H5Dclose(dataset);
     H5Sclose(dataspace);
@@ -1047,26 +1263,10 @@ int tg_write_trajectories(const string& fname, const vector<Trajectory>& traject
     transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
     // Start writing ground vehicle trajectory writing to CSV
-    if(groundVehicleSimulationData.size() > 0) {
-		ofstream groundTrajectories;
-		groundTrajectories.open (basename + "_groundVehicleSimulation.csv");
-		groundTrajectories << "Header Format: \nGroundVehicle_ID\nTime,AircraftInService,Latitude,Longitude,Altitude,Speed,Heading\n\n";
-		for(map<string, vector<string> >::const_iterator it = groundVehicleSimulationData.begin();
-			it != groundVehicleSimulationData.end(); ++it)
-		{
-			groundTrajectories << it->first + "\n";
-			for(int i = 0; i < it->second.size(); i++)
-				groundTrajectories << it->second.at(i) + "\n";
-
-			groundTrajectories << "\n";
-
-		}
-
-		groundTrajectories.close();
-    }
+    write_groundVehicle_histories(basename + "_groundVehicleSimulation.csv");
 
     // Clear trajectories
-    groundVehicleSimulationData.clear();
+    clear_groundVehicle_histories();
 
     // End writing ground vehicles trajectory writing to CSV end
 
@@ -1104,20 +1304,243 @@ bool flight_index_comparator(const Trajectory& a, const Trajectory& b) {
 	return a.flight_index < b.flight_index;
 }
 
-// 2018.02.09 Oliver Chen
-// This function must be tested to see if it can read h5 files.
-static int tg_read_trajectories_h5(const string& fname, vector<Trajectory>* const trajectories, const set<string>& callsign_filter) {
+/*
+ * Copy elements [begin, end) of a variable-length HDF5 array into a vector
+ * sized to fit.
+ */
+template<typename T, typename U>
+static void hvl_range_to_vector(const hvl_t& vl, const size_t& begin, const size_t& end, vector<U>* const vec) {
+	if(!vec) return;
+
+	size_t tmp_end = min(end, vl.len);
+	if ((vl.p == NULL) || (begin >= tmp_end)) {
+		vector<U>().swap(*vec);
+		return;
+	}
+
+	T* array = (T*)vl.p;
+	vector<U>(array+begin, array+tmp_end).swap(*vec);
+}
+
+static string h5_string(const char* str) {
+	return (str != NULL) ? string(str) : string();
+}
+
+static bool is_time_range_overlapped(const long& begin, const long& end, const long& t_start, const long& t_end) {
+	return ((t_start < 0) || (t_start <= end)) && ((t_end < 0) || (begin <= t_end));
+}
+
+/*
+ * Insert a member into the memory compound type only if the file compound
+ * type has it.  Files written by older versions lack some members, and
+ * the flight phase array is stored under the name "mode".
+ */
+static void insert_h5_member_if_present(const hid_t& mem_type,
+		const hid_t& file_type,
+		const char* name,
+		const size_t& offset,
+		const hid_t& member_type) {
+	if (H5Tget_member_index(file_type, name) >= 0) {
+		H5Tinsert(mem_type, name, offset, member_type);
+	}
+}
+
+/*
+ * Fill the trajectory points of one decoded trajectory, keeping only the
+ * points in [t_start, t_end].  A negative bound is not applied.
+ */
+static void decode_h5_trajectory_points(const hdf5_trajectory_t& h5_traj,
+		const long& t_start,
+		const long& t_end,
+		Trajectory* const trajectory) {
+	size_t begin = 0;
+	size_t end = (size_t)-1;
+
+	if ((t_start >= 0) || (t_end >= 0)) {
+		const long* timestamps = (const long*)h5_traj.timestamp.p;
+
+		end = h5_traj.timestamp.len;
+		if (t_start >= 0) {
+			while ((begin < end) && (timestamps[begin] < t_start)) begin++;
+		}
+		if (t_end >= 0) {
+			while ((end > begin) && (timestamps[end-1] > t_end)) end--;
+		}
+	}
+
+	hvl_range_to_vector<long, float>(h5_traj.timestamp, begin, end, &trajectory->timestamp);
+	hvl_range_to_vector<double, real_t>(h5_traj.latitude, begin, end, &trajectory->latitude_deg);
+	hvl_range_to_vector<double, real_t>(h5_traj.longitude, begin, end, &trajectory->longitude_deg);
+	hvl_range_to_vector<double, real_t>(h5_traj.altitude, begin, end, &trajectory->altitude_ft);
+	hvl_range_to_vector<double, real_t>(h5_traj.hdot, begin, end, &trajectory->rocd_fps);
+	hvl_range_to_vector<double, real_t>(h5_traj.tas, begin, end, &trajectory->tas_knots);
+	hvl_range_to_vector<double, real_t>(h5_traj.tas_ground, begin, end, &trajectory->tas_knots_ground);
+	hvl_range_to_vector<double, real_t>(h5_traj.course, begin, end, &trajectory->course_deg);
+	hvl_range_to_vector<double, real_t>(h5_traj.fpa, begin, end, &trajectory->fpa_deg);
+
+	// Convert integer flight phase to enum flight phase
+	vector<ENUM_Flight_Phase>().swap(trajectory->flight_phase);
+
+	size_t phase_end = min(end, h5_traj.phase.len);
+	if ((h5_traj.phase.p != NULL) && (begin < phase_end)) {
+		trajectory->flight_phase.reserve(phase_end - begin);
+		for (size_t j = begin; j < phase_end; ++j) {
+			trajectory->flight_phase.push_back(ENUM_Flight_Phase(((int*)(h5_traj.phase.p))[j]));
+		}
+	}
+}
+
+/*
+ * Determine the rows of /trajectories to read.
+ *
+ * Files carrying /trajectory_index are filtered by callsign and time range
+ * using the index alone.  Older files are filtered by reading only the
+ * callsign member of each row.  The time range of older files is applied
+ * after decoding.
+ */
+static int select_trajectory_rows_h5(const hid_t& file_id,
+		const hid_t& dataset,
+		const hsize_t& num_rows,
+		const set<string>& callsign_filter,
+		const long& t_start,
+		const long& t_end,
+		vector<hsize_t>* const rows) {
+	if (!rows) return -1;
+
+	rows->clear();
+
+	bool flag_time_range = (t_start >= 0) || (t_end >= 0);
+
+	if ((callsign_filter.size() == 0) && !flag_time_range) {
+		rows->reserve(num_rows);
+		for (hsize_t i = 0; i < num_rows; ++i) {
+			rows->push_back(i);
+		}
+
+		return 0;
+	}
+
+	hid_t string_type = H5Tcopy(H5T_C_S1);
+	H5Tset_size(string_type, H5T_VARIABLE);
+
+	if (H5Lexists(file_id, "/trajectory_index", H5P_DEFAULT) > 0) {
+		hid_t index_dataset = H5Dopen2(file_id, "/trajectory_index", H5P_DEFAULT);
+		hid_t index_space = H5Dget_space(index_dataset);
+		hsize_t index_dims[1] = {0};
+		H5Sget_simple_extent_dims(index_space, index_dims, NULL);
+
+		hid_t mem_index_type = create_trajectory_index_mem_type(string_type);
+
+		vector<hdf5_trajectory_index_t> index_entries(index_dims[0]);
+		if (index_dims[0] > 0) {
+			H5Dread(index_dataset, mem_index_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, &index_entries[0]);
+		}
+
+		if (callsign_filter.size() > 0) {
+			// Entries are sorted by callsign
+			set<string>::const_iterator filter_iter;
+			for (filter_iter = callsign_filter.begin(); filter_iter != callsign_filter.end(); ++filter_iter) {
+				hdf5_trajectory_index_t key;
+				key.callsign = const_cast<char*>(filter_iter->c_str());
+				key.row = -1;
+
+				vector<hdf5_trajectory_index_t>::iterator ite = lower_bound(index_entries.begin(), index_entries.end(), key, trajectory_index_comparator);
+				for (; (ite != index_entries.end()) && (ite->callsign != NULL) && (strcmp(ite->callsign, key.callsign) == 0); ++ite) {
+					if ((0 <= ite->row) && ((hsize_t)ite->row < num_rows)
+							&& is_time_range_overlapped(ite->start_time, ite->end_time, t_start, t_end)) {
+						rows->push_back(ite->row);
+					}
+				}
+			}
+		} else {
+			for (size_t i = 0; i < index_entries.size(); ++i) {
+				if ((0 <= index_entries[i].row) && ((hsize_t)index_entries[i].row < num_rows)
+						&& is_time_range_overlapped(index_entries[i].start_time, index_entries[i].end_time, t_start, t_end)) {
+					rows->push_back(index_entries[i].row);
+				}
+			}
+		}
+
+		if (index_dims[0] > 0) {
+			H5Dvlen_reclaim(mem_index_type, index_space, H5P_DEFAULT, &index_entries[0]);
+		}
+
+		H5Tclose(mem_index_type);
+		H5Sclose(index_space);
+		H5Dclose(index_dataset);
+	} else if (callsign_filter.size() > 0) {
+		// No index.  Read the callsign member only.
+		hid_t mem_callsign_type = H5Tcreate(H5T_COMPOUND, sizeof(char*));
+		H5Tinsert(mem_callsign_type, "callsign", 0, string_type);
+
+		vector<char*> callsigns(num_rows, (char*)NULL);
+		if (num_rows > 0) {
+			H5Dread(dataset, mem_callsign_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, &callsigns[0]);
+		}
+
+		for (hsize_t i = 0; i < num_rows; ++i) {
+			if ((callsigns[i] != NULL) && (callsign_filter.find(string(callsigns[i])) != callsign_filter.end())) {
+				rows->push_back(i);
+			}
+		}
+
+		if (num_rows > 0) {
+			hid_t dataspace = H5Dget_space(dataset);
+			H5Dvlen_reclaim(mem_callsign_type, dataspace, H5P_DEFAULT, &callsigns[0]);
+			H5Sclose(dataspace);
+		}
+
+		H5Tclose(mem_callsign_type);
+	} else {
+		rows->reserve(num_rows);
+		for (hsize_t i = 0; i < num_rows; ++i) {
+			rows->push_back(i);
+		}
+	}
+
+	H5Tclose(string_type);
+
+	sort(rows->begin(), rows->end());
+	rows->erase(unique(rows->begin(), rows->end()), rows->end());
+
+	return 0;
+}
+
+/*
+ * Read trajectories from an HDF5 file.
+ *
+ * Only the rows selected by callsign and time range are read.  They are
+ * read in batches, and the points of each batch are decoded in parallel.
+ */
+static int tg_read_trajectories_h5(const string& fname,
+		vector<Trajectory>* const trajectories,
+		const set<string>& callsign_filter,
+		const long& t_start,
+		const long& t_end) {
+	if (!trajectories) return -1;
+
     // open the file
     hid_t file_id = H5Fopen(fname.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file_id < 0) {
+        printf("ERROR: could not open trajectory file %s\n", fname.c_str());
+        return -1;
+    }
 
     // open the dataset
     hid_t dataset = H5Dopen2(file_id, "/trajectories", H5P_DEFAULT);
+    if (dataset < 0) {
+        printf("ERROR: could not open trajectories dataset in %s\n", fname.c_str());
+        H5Fclose(file_id);
+        return -1;
+    }
 
-    // get the dataspace and allocate memory for the read
+    // get the dataspace
     hsize_t dims[1] = {0};
     hid_t dataspace = H5Dget_space(dataset);
     H5Sget_simple_extent_dims(dataspace, dims, NULL);
 
+    hid_t file_traj_type = H5Dget_type(dataset);
+
     // define the variable-length double array type
     hid_t mem_double_array_type = H5Tvlen_create(H5T_NATIVE_DOUBLE);
     hid_t mem_int_array_type = H5Tvlen_create(H5T_NATIVE_INT);
@@ -1125,112 +1548,99 @@ static int tg_read_trajectories_h5(const string& fname, vector<Trajectory>* cons
     hid_t string_type = H5Tcopy(H5T_C_S1);
     H5Tset_size(string_type, H5T_VARIABLE);
 
-    // build the memtype struct
-    int offset = 0;
-
-    // define the compound data type for memory
+    // define the compound data type for memory.  Members missing from
+    // the file are left zero.
     hid_t mem_traj_type = H5Tcreate(H5T_COMPOUND, sizeof(hdf5_trajectory_t));
-    H5Tinsert(mem_traj_type, "flight_index", offset, H5T_NATIVE_INT);
-    offset = HOFFSET(hdf5_trajectory_t, callsign);
-    H5Tinsert(mem_traj_type, "callsign", offset, string_type);
-    offset = HOFFSET(hdf5_trajectory_t, actype);
-    H5Tinsert(mem_traj_type, "actype", offset, string_type);
-    offset = HOFFSET(hdf5_trajectory_t, origin_airport);
-    H5Tinsert(mem_traj_type, "origin_airport", offset, string_type);
-    offset = HOFFSET(hdf5_trajectory_t, destination_airport);
-    H5Tinsert(mem_traj_type, "destination_airport", offset, string_type);
-    offset = HOFFSET(hdf5_trajectory_t, start_time);
-    H5Tinsert(mem_traj_type, "start_time", offset, H5T_NATIVE_LONG);
-    offset = HOFFSET(hdf5_trajectory_t, interval_ground);
-    H5Tinsert(mem_traj_type, "interval_ground", offset, H5T_NATIVE_INT);
-    offset = HOFFSET(hdf5_trajectory_t, interval_airborne);
-    H5Tinsert(mem_traj_type, "interval_airborne", offset, H5T_NATIVE_INT);
-    offset = HOFFSET(hdf5_trajectory_t, latitude);
-    H5Tinsert(mem_traj_type, "latitude", offset, mem_double_array_type);
-    offset = HOFFSET(hdf5_trajectory_t, longitude);
-    H5Tinsert(mem_traj_type, "longitude", offset, mem_double_array_type);
-    offset = HOFFSET(hdf5_trajectory_t, altitude);
-    H5Tinsert(mem_traj_type, "altitude", offset, mem_double_array_type);
-    offset = HOFFSET(hdf5_trajectory_t, hdot);
-    H5Tinsert(mem_traj_type, "hdot", offset, mem_double_array_type);
-    offset = HOFFSET(hdf5_trajectory_t, tas);
-    H5Tinsert(mem_traj_type, "tas", offset, mem_double_array_type);
-    offset = HOFFSET(hdf5_trajectory_t, course);
-    H5Tinsert(mem_traj_type, "course", offset, mem_double_array_type);
-    offset = HOFFSET(hdf5_trajectory_t, fpa);
-    H5Tinsert(mem_traj_type, "fpa", offset, mem_double_array_type);
-    offset = HOFFSET(hdf5_trajectory_t, phase);
-    H5Tinsert(mem_traj_type, "phase", offset, mem_int_array_type);
-    offset = HOFFSET(hdf5_trajectory_t, timestamp);
-    H5Tinsert(mem_traj_type, "timestamp", offset, mem_long_array_type);
-
-    hdf5_trajectory_t* hdf5_trajectories =
-            (hdf5_trajectory_t*)calloc(dims[0], sizeof(hdf5_trajectory_t));
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "flight_index", HOFFSET(hdf5_trajectory_t, flight_index), H5T_NATIVE_INT);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "callsign", HOFFSET(hdf5_trajectory_t, callsign), string_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "actype", HOFFSET(hdf5_trajectory_t, actype), string_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "origin_airport", HOFFSET(hdf5_trajectory_t, origin_airport), string_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "destination_airport", HOFFSET(hdf5_trajectory_t, destination_airport), string_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "start_time", HOFFSET(hdf5_trajectory_t, start_time), H5T_NATIVE_LONG);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "interval_ground", HOFFSET(hdf5_trajectory_t, interval_ground), H5T_NATIVE_INT);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "interval_airborne", HOFFSET(hdf5_trajectory_t, interval_airborne), H5T_NATIVE_INT);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "cruise_altitude_ft", HOFFSET(hdf5_trajectory_t, cruise_altitude_ft), H5T_NATIVE_FLOAT);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "cruise_tas_knots", HOFFSET(hdf5_trajectory_t, cruise_tas_knots), H5T_NATIVE_FLOAT);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "origin_airport_elevation_ft", HOFFSET(hdf5_trajectory_t, origin_airport_elevation_ft), H5T_NATIVE_FLOAT);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "destination_airport_elevation_ft", HOFFSET(hdf5_trajectory_t, destination_airport_elevation_ft), H5T_NATIVE_FLOAT);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "timestamp", HOFFSET(hdf5_trajectory_t, timestamp), mem_long_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "latitude", HOFFSET(hdf5_trajectory_t, latitude), mem_double_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "longitude", HOFFSET(hdf5_trajectory_t, longitude), mem_double_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "altitude", HOFFSET(hdf5_trajectory_t, altitude), mem_double_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "hdot", HOFFSET(hdf5_trajectory_t, hdot), mem_double_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "tas", HOFFSET(hdf5_trajectory_t, tas), mem_double_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "tas_ground", HOFFSET(hdf5_trajectory_t, tas_ground), mem_double_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "course", HOFFSET(hdf5_trajectory_t, course), mem_double_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "fpa", HOFFSET(hdf5_trajectory_t, fpa), mem_double_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "phase", HOFFSET(hdf5_trajectory_t, phase), mem_int_array_type);
+    insert_h5_member_if_present(mem_traj_type, file_traj_type, "mode", HOFFSET(hdf5_trajectory_t, phase), mem_int_array_type);
+
+    vector<hsize_t> rows;
+    select_trajectory_rows_h5(file_id, dataset, dims[0], callsign_filter, t_start, t_end, &rows);
+
+    size_t base_size = trajectories->size();
+    trajectories->reserve(base_size + rows.size());
+
+    int retValue = 0;
+
+    vector<hdf5_trajectory_t> hdf5_trajectories(TRAJECTORY_H5_READ_BATCH);
+
+    for (size_t batch_begin = 0; batch_begin < rows.size(); batch_begin += TRAJECTORY_H5_READ_BATCH) {
+        hsize_t num_batch = min((size_t)TRAJECTORY_H5_READ_BATCH, rows.size() - batch_begin);
+
+        H5Sselect_elements(dataspace, H5S_SELECT_SET, num_batch, &rows[batch_begin]);
+        hid_t memspace = H5Screate_simple(1, &num_batch, NULL);
+
+        memset(&hdf5_trajectories[0], 0, num_batch * sizeof(hdf5_trajectory_t));
+
+        // read the selected rows into memtype
+        if (H5Dread(dataset, mem_traj_type, memspace, dataspace, H5P_DEFAULT,
+                &hdf5_trajectories[0]) < 0) {
+            printf("ERROR: could not read trajectories from %s\n", fname.c_str());
+            H5Sclose(memspace);
+            retValue = -1;
+            break;
+        }
 
-    // read the data into memtype
-    H5Dread(dataset, mem_traj_type, H5S_ALL, H5S_ALL, H5P_DEFAULT,
-            hdf5_trajectories);
+        size_t batch_offset = trajectories->size();
+
+        for (hsize_t i = 0; i < num_batch; ++i) {
+            const hdf5_trajectory_t& h5_traj = hdf5_trajectories[i];
+
+            trajectories->push_back(Trajectory(h5_traj.flight_index,
+                    h5_string(h5_traj.callsign),
+                    h5_string(h5_traj.actype),
+                    h5_string(h5_traj.origin_airport),
+                    h5_string(h5_traj.destination_airport),
+                    h5_traj.start_time,
+                    h5_traj.interval_ground,
+                    h5_traj.interval_airborne,
+                    h5_traj.cruise_altitude_ft,
+                    h5_traj.cruise_tas_knots,
+                    h5_traj.origin_airport_elevation_ft,
+                    h5_traj.destination_airport_elevation_ft,
+                    h5_traj.flag_externalAircraft));
+        }
 
-    // copy the data into the output vector
-    for (hsize_t i=0; i<dims[0]; ++i) {
-        hdf5_trajectory_t h5_traj = hdf5_trajectories[i];
-
-        int flight_index = h5_traj.flight_index;
-        string callsign(h5_traj.callsign);
-        string actype(h5_traj.actype);
-        string origin_airport(h5_traj.origin_airport);
-        string destination_airport(h5_traj.destination_airport);
-        long start_time = h5_traj.start_time;
-        int interval_ground = h5_traj.interval_ground;
-        int interval_airborne = h5_traj.interval_airborne;
-        float cruise_altitude_ft = h5_traj.cruise_altitude_ft;
-        float cruise_tas_knots = h5_traj.cruise_tas_knots;
-        float origin_airport_elevation_ft = h5_traj.origin_airport_elevation_ft;
-        float destination_airport_elevation_ft = h5_traj.destination_airport_elevation_ft;
-        bool flag_externalAircraft = h5_traj.flag_externalAircraft;
-
-        Trajectory trajectory(flight_index,
-        					  callsign,
-							  actype,
-							  origin_airport,
-                              destination_airport,
-							  start_time,
-							  interval_ground,
-							  interval_airborne,
-							  cruise_altitude_ft,
-							  cruise_tas_knots,
-							  origin_airport_elevation_ft,
-							  destination_airport_elevation_ft,
-							  flag_externalAircraft);
-
-        hvl_to_vector<double, real_t>(h5_traj.latitude, &(trajectory.latitude_deg));
-        hvl_to_vector<double, real_t>(h5_traj.longitude, &trajectory.longitude_deg);
-        hvl_to_vector<double, real_t>(h5_traj.altitude, &trajectory.altitude_ft);
-        hvl_to_vector<double, real_t>(h5_traj.hdot, &trajectory.rocd_fps);
-        hvl_to_vector<double, real_t>(h5_traj.tas, &trajectory.tas_knots);
-        hvl_to_vector<double, real_t>(h5_traj.course, &trajectory.course_deg);
-        hvl_to_vector<double, real_t>(h5_traj.fpa, &trajectory.fpa_deg);
-        hvl_to_vector<float, float>(h5_traj.timestamp, &trajectory.timestamp);
-
-        // Convert integer flight phase to enum flight phase
-        for (size_t j=0; j<h5_traj.phase.len; ++j) {
-        	ENUM_Flight_Phase phase;
-        	int h5_phase = ((int*)(h5_traj.phase.p))[j];;
-        	phase = ENUM_Flight_Phase(h5_phase);
-
-        	trajectory.flight_phase.push_back(phase);
+        // Each trajectory is independent.  HDF5 is not called here.
+#pragma omp parallel for schedule(dynamic, 16)
+        for (int i = 0; i < (int)num_batch; ++i) {
+            decode_h5_trajectory_points(hdf5_trajectories[i], t_start, t_end, &(trajectories->at(batch_offset + i)));
         }
 
-        // if the user specified a set of callsigns to filter, then add
-        // only the trajectories with the desired callsigns. otherwise
-        // add all trajectories.
-        if (callsign_filter.size() > 0) {
-            set<string>::iterator filter_iter = callsign_filter.find(callsign);
-            if (filter_iter != callsign_filter.end()) {
-                trajectories->push_back(trajectory);
+        H5Dvlen_reclaim(mem_traj_type, memspace, H5P_DEFAULT, &hdf5_trajectories[0]);
+        H5Sclose(memspace);
+    }
+
+    // Drop flights with no point in the requested time range
+    if ((t_start >= 0) || (t_end >= 0)) {
+        vector<Trajectory>::iterator ite = trajectories->begin() + base_size;
+        while (ite != trajectories->end()) {
+            if (ite->timestamp.size() == 0) {
+                ite = trajectories->erase(ite);
+            } else {
+                ++ite;
             }
-        } else {
-            trajectories->push_back(trajectory);
         }
     }
 
@@ -1239,6 +1649,7 @@ static int tg_read_trajectories_h5(const string& fname, vector<Trajectory>* cons
     sort(trajectories->begin(), trajectories->end(), flight_index_comparator);
 
     H5Tclose(mem_traj_type);
+    H5Tclose(file_traj_type);
     H5Tclose(string_type);
     H5Tclose(mem_int_array_type);
     H5Tclose(mem_long_array_type);
@@ -1247,10 +1658,7 @@ static int tg_read_trajectories_h5(const string& fname, vector<Trajectory>* cons
     H5Dclose(dataset);
     H5Fclose(file_id);
 
-    // free mem
-    free(hdf5_trajectories);
-
-    return 0;
+    return retValue;
 }
 
 static int tg_read_trajectories_xml(xml_document<>& doc, vector<Trajectory>* const trajectories, const set<string>& callsign_filter) {
@@ -1408,19 +1816,67 @@ static int tg_read_trajectories_xml_gz(const string& fname, vector<Trajectory>*
  * vector of Trajectories.
  */
 int tg_read_trajectories(const string& fname, vector<Trajectory>* const trajectories, const set<string>& callsign_filter) {
+    return tg_read_trajectories(fname, trajectories, callsign_filter, -1, -1);
+}
+
+/*
+ * Read the trajectories from the specified file, keeping only the points
+ * with timestamps in [t_start, t_end].  A negative bound is not applied.
+ * Flights without any point in the range are not returned.
+ */
+int tg_read_trajectories(const string& fname,
+		vector<Trajectory>* const trajectories,
+		const set<string>& callsign_filter,
+		const long& t_start,
+		const long& t_end) {
+    if (!trajectories) return -1;
 
     size_t dot_pos = fname.find_last_of(".");
     string basename = fname.substr(0, dot_pos);
     string extension = fname.substr(dot_pos);
     transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
-    if(extension == ".xml") {
-        return tg_read_trajectories_xml(fname, trajectories, callsign_filter);
-    } else if(extension == ".gz") {
-        return tg_read_trajectories_xml_gz(fname, trajectories, callsign_filter);
-    } else {
-        return tg_read_trajectories_h5(fname, trajectories, callsign_filter);
+    if ((extension != ".xml") && (extension != ".gz")) {
+        return tg_read_trajectories_h5(fname, trajectories, callsign_filter, t_start, t_end);
+    }
+
+    size_t base_size = trajectories->size();
+
+    int retValue = (extension == ".xml")
+            ? tg_read_trajectories_xml(fname, trajectories, callsign_filter)
+            : tg_read_trajectories_xml_gz(fname, trajectories, callsign_filter);
+
+    if ((t_start < 0) && (t_end < 0))
+        return retValue;
+
+    // XML files carry no index.  Apply the time range after parsing.
+    vector<Trajectory>::iterator ite = trajectories->begin() + base_size;
+    while (ite != trajectories->end()) {
+        size_t begin = 0;
+        size_t end = ite->timestamp.size();
+        while ((begin < end) && (t_start >= 0) && (ite->timestamp[begin] < t_start)) begin++;
+        while ((end > begin) && (t_end >= 0) && (ite->timestamp[end-1] > t_end)) end--;
+
+        if (begin == end) {
+            ite = trajectories->erase(ite);
+            continue;
+        }
+
+        ite->timestamp = vector<float>(ite->timestamp.begin() + begin, ite->timestamp.begin() + end);
+        ite->latitude_deg = vector<real_t>(ite->latitude_deg.begin() + begin, ite->latitude_deg.begin() + end);
+        ite->longitude_deg = vector<real_t>(ite->longitude_deg.begin() + begin, ite->longitude_deg.begin() + end);
+        ite->altitude_ft = vector<real_t>(ite->altitude_ft.begin() + begin, ite->altitude_ft.begin() + end);
+        ite->rocd_fps = vector<real_t>(ite->rocd_fps.begin() + begin, ite->rocd_fps.begin() + end);
+        ite->tas_knots = vector<real_t>(ite->tas_knots.begin() + begin, ite->tas_knots.begin() + end);
+        ite->tas_knots_ground = vector<real_t>(ite->tas_knots_ground.begin() + begin, ite->tas_knots_ground.begin() + end);
+        ite->course_deg = vector<real_t>(ite->course_deg.begin() + begin, ite->course_deg.begin() + end);
+        ite->fpa_deg = vector<real_t>(ite->fpa_deg.begin() + begin, ite->fpa_deg.begin() + end);
+        ite->flight_phase = vector<ENUM_Flight_Phase>(ite->flight_phase.begin() + begin, ite->flight_phase.begin() + end);
+
+        ++ite;
     }
+
+    return retValue;
 }
 
 static void generate_map_airport() {
@@ -1483,6 +1939,9 @@ static void generate_map_airport() {
 			cur_airport_ptr->avail_runways.insert(tmp_approach.runway);
 		}
 	}
+
+	// Spatial index for closest-airport and airports-in-range queries
+	build_airport_index(map_airport);
 }
 
 #if GEN_RTG_MAP
@@ -1662,7 +2121,8 @@ static int do_init(adb_ptf_column_e col) {
 		int thread_id = omp_get_thread_num();
 
 		if(0 == thread_id) {
-
+			// load ARTCC center boundaries and fixes (host only)
+			load_centers(g_share_dir + "/artcc");
 		}
 		else if(1 == thread_id) {
 			// load ADB (host and device)
@@ -46,6 +46,9 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include "tg_flightplan.h"
 #include "tg_trajectory.h"
 #include "tg_aircraft.h"
+#include "tg_centers.h"
+#include "tg_wake.h"
+#include "tg_trafficMetrics.h"
 
 
 
@@ -82,6 +85,8 @@ extern bool flag_adb_available;
 extern bool flag_rap_available;
 // Flag variable indicating whether Sector data is available
 extern bool flag_sector_available;
+// Flag variable indicating whether ARTCC center data is available
+extern bool flag_center_available;
 // Flag variable indicating whether Waypoint data is available
 extern bool flag_waypoint_available;
 // Flag variable indicating whether Airport data is available
@@ -105,7 +110,11 @@ int tg_info();
 int tg_init(const string& data_dir=g_data_dir, const real_t& cruise_tas_perturbation=g_perturbation, const int& device_id=g_device_id);
 int tg_load_rap(const string& grib_file);
 int tg_load_trx(const string& trx_file, const string& mfl_file);
+int tg_load_toc_tod_profile_cache(const string& fname);
+int tg_save_toc_tod_profile_cache(const string& fname);
 int tg_generate(const long& t_horizon_minutes, const long& t_step_sec, vector<Trajectory>* const trajectories=NULL);
+int tg_enable_cruise_fast_forward(const bool& flag);
+int tg_enable_steady_step_skip(const bool& flag);
 int tg_reset_aircraft();
 int tg_reset();
 int tg_shutdown();
@@ -122,10 +131,35 @@ int tg_get_destination_airport(const int& flight_index, string* const airport);
 int tg_get_destination_elevation(const int& flight_index, real_t* const elev);
 int tg_get_aircraft_type(const int& flight_index, string* const actype);
 
+// tg center interface functions
+int tg_get_center_codes(vector<string>* const center_codes);
+int tg_get_fixes_in_center(const string& center_code, vector<string>* const fixes);
+int tg_get_current_center(const int& flight_index, string* const center_code);
+int tg_get_center_traffic_count(const string& center_code, int* const count);
+int tg_get_center_events(vector<center_event_t>* const events);
+
+// tg wake vortex interface functions
+int tg_enable_wake_vortex_model(const bool& flag);
+int tg_get_wake_encounters(vector<wake_encounter_t>* const encounters);
+
+// tg traffic metrics interface functions
+int tg_enable_traffic_metrics(const bool& flag);
+int tg_set_traffic_metrics_config(const float& bin_sec,
+		const vector<string>& sector_names,
+		const vector<string>& airport_codes,
+		const string& fname);
+int tg_get_traffic_metrics(traffic_metrics_t* const metrics);
+int tg_write_traffic_metrics(const string& fname);
+
 // tg trajectory interface functions
 int tg_get_trajectories(vector<Trajectory>* const trajectories);
 int tg_write_trajectories(const string& fname, const vector<Trajectory>& trajectories);
 int tg_read_trajectories(const string& fname, vector<Trajectory>* const trajectories, const set<string>& callsign_filter=set<string>());
+int tg_read_trajectories(const string& fname,
+		vector<Trajectory>* const trajectories,
+		const set<string>& callsign_filter,
+		const long& t_start,
+		const long& t_end);
 
 
 
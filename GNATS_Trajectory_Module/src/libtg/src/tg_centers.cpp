@@ -0,0 +1,406 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_centers.cpp
+ *
+ * ARTCC center boundaries, fix membership and per-flight center tracking.
+ */
+
+#include "tg_centers.h"
+#include "tg_simulation.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * host-side global variables
+ */
+vector<string> g_center_codes;
+vector<center_boundary_t> g_center_boundaries;
+map<string, vector<string> > g_center_fixes;
+
+// Current center of each flight, -1 when outside all centers or not airborne
+vector<int> h_flight_center_index;
+vector<center_event_t> g_center_events;
+
+bool flag_center_available = false;
+
+// Boundaries whose bounding box overlaps each grid cell
+static vector<vector<int> > center_grid;
+
+static string trim_line(const string& line) {
+	size_t begin = line.find_first_not_of(" \t\r\n");
+	if (begin == string::npos)
+		return "";
+
+	size_t end = line.find_last_not_of(" \t\r\n");
+
+	return line.substr(begin, end - begin + 1);
+}
+
+static void split_line(const string& line, vector<string>& fields) {
+	size_t begin = 0;
+	size_t end;
+
+	fields.clear();
+	while ((end = line.find(',', begin)) != string::npos) {
+		fields.push_back(line.substr(begin, end - begin));
+		begin = end + 1;
+	}
+	fields.push_back(line.substr(begin));
+}
+
+static int add_center(const string& center_code) {
+	int center_index = get_center_index(center_code);
+	if (center_index < 0) {
+		g_center_codes.push_back(center_code);
+		center_index = g_center_codes.size() - 1;
+	}
+
+	return center_index;
+}
+
+static int get_grid_cell_index(const int& lat_cell, const int& lon_cell) {
+	return lat_cell * CENTER_GRID_LON_SIZE + lon_cell;
+}
+
+static int get_grid_lat_cell(const double& lat_deg) {
+	int cell = (int)floor((lat_deg - CENTER_GRID_LAT_MIN) / CENTER_GRID_CELL_SIZE);
+
+	return max(0, min(CENTER_GRID_LAT_SIZE - 1, cell));
+}
+
+// Longitudes outside [-180, 180) wrap around
+static int get_grid_lon_cell(const double& lon_deg) {
+	int cell = (int)floor((lon_deg - CENTER_GRID_LON_MIN) / CENTER_GRID_CELL_SIZE);
+
+	cell = cell % CENTER_GRID_LON_SIZE;
+	if (cell < 0)
+		cell += CENTER_GRID_LON_SIZE;
+
+	return cell;
+}
+
+static void finish_boundary(center_boundary_t& boundary) {
+	double lon_min = *min_element(boundary.longitude.begin(), boundary.longitude.end());
+	double lon_max = *max_element(boundary.longitude.begin(), boundary.longitude.end());
+
+	// A boundary wider than half the globe crosses the antimeridian
+	boundary.flag_shifted = (lon_max - lon_min > 180.0);
+	if (boundary.flag_shifted) {
+		for (unsigned int i = 0; i < boundary.longitude.size(); i++) {
+			if (boundary.longitude[i] < 0)
+				boundary.longitude[i] += 360.0;
+		}
+	}
+
+	boundary.lat_min = *min_element(boundary.latitude.begin(), boundary.latitude.end());
+	boundary.lat_max = *max_element(boundary.latitude.begin(), boundary.latitude.end());
+	boundary.lon_min = *min_element(boundary.longitude.begin(), boundary.longitude.end());
+	boundary.lon_max = *max_element(boundary.longitude.begin(), boundary.longitude.end());
+}
+
+static int load_center_boundaries(const string& fname) {
+	ifstream in(fname.c_str());
+	if (!in.is_open()) {
+		printf("      Failed to open %s\n", fname.c_str());
+		return -1;
+	}
+
+	string line;
+	vector<string> fields;
+
+	while (getline(in, line)) {
+		line = trim_line(line);
+		if (line.find("CENTER,") != 0)
+			continue;
+
+		split_line(line, fields);
+		if (fields.size() < 4) {
+			printf("      Invalid center record: %s\n", line.c_str());
+			return -1;
+		}
+
+		const string& name = fields.at(2);
+		const size_t pos_dash = name.find('-');
+		const string center_id = name.substr(0, pos_dash);
+		const string stratum = (pos_dash == string::npos) ? "" : name.substr(pos_dash + 1);
+		const int num_vertices = atoi(fields.at(3).c_str());
+
+		center_boundary_t boundary;
+		boundary.center_index = add_center(((center_id == "ZAN") || (center_id == "ZHN") ? "P" : "K") + center_id);
+		if (stratum == "HIGH")
+			boundary.stratum = CENTER_STRATUM_HIGH;
+		else if (stratum == "LOW")
+			boundary.stratum = CENTER_STRATUM_LOW;
+		else
+			boundary.stratum = CENTER_STRATUM_BOUNDARY;
+
+		for (int i = 0; i < num_vertices; i++) {
+			if (!getline(in, line)) {
+				printf("      Unexpected end of file in center %s\n", name.c_str());
+				return -1;
+			}
+
+			split_line(trim_line(line), fields);
+			if ((fields.size() < 3) || (fields.at(0) != "WAYPOINT")) {
+				printf("      Invalid center vertex: %s\n", line.c_str());
+				return -1;
+			}
+
+			boundary.latitude.push_back(atof(fields.at(1).c_str()));
+			boundary.longitude.push_back(atof(fields.at(2).c_str()));
+		}
+
+		if (num_vertices < 3)
+			continue;
+
+		finish_boundary(boundary);
+		g_center_boundaries.push_back(boundary);
+	}
+
+	return 0;
+}
+
+static int load_center_fixes(const string& fname) {
+	ifstream in(fname.c_str());
+	if (!in.is_open()) {
+		printf("      Failed to open %s\n", fname.c_str());
+		return -1;
+	}
+
+	string line;
+	vector<string> fields;
+
+	while (getline(in, line)) {
+		line = trim_line(line);
+		if (line.length() == 0)
+			continue;
+
+		split_line(line, fields);
+		if (fields.size() < 2)
+			continue;
+
+		add_center(fields.at(0));
+		g_center_fixes[fields.at(0)].push_back(fields.at(1));
+	}
+
+	return 0;
+}
+
+static void build_center_grid() {
+	center_grid.assign(CENTER_GRID_LAT_SIZE * CENTER_GRID_LON_SIZE, vector<int>());
+
+	for (unsigned int i = 0; i < g_center_boundaries.size(); i++) {
+		const center_boundary_t& boundary = g_center_boundaries.at(i);
+
+		const int lat_cell_begin = get_grid_lat_cell(boundary.lat_min);
+		const int lat_cell_end = get_grid_lat_cell(boundary.lat_max);
+
+		// Walk the longitude cells on the unwrapped axis so shifted
+		// boundaries land in the cells on both sides of the antimeridian
+		const int lon_step_begin = (int)floor(boundary.lon_min / CENTER_GRID_CELL_SIZE);
+		const int lon_step_end = (int)floor(boundary.lon_max / CENTER_GRID_CELL_SIZE);
+
+		for (int lat_cell = lat_cell_begin; lat_cell <= lat_cell_end; lat_cell++) {
+			for (int lon_step = lon_step_begin; lon_step <= lon_step_end; lon_step++) {
+				const int lon_cell = get_grid_lon_cell(lon_step * CENTER_GRID_CELL_SIZE);
+
+				center_grid.at(get_grid_cell_index(lat_cell, lon_cell)).push_back(i);
+			}
+		}
+	}
+}
+
+static bool boundary_contains(const center_boundary_t& boundary, const double& lat_deg, const double& lon_deg) {
+	const double lon = ((boundary.flag_shifted) && (lon_deg < 0)) ? (lon_deg + 360.0) : lon_deg;
+
+	if ((lat_deg < boundary.lat_min) || (lat_deg > boundary.lat_max)
+			|| (lon < boundary.lon_min) || (lon > boundary.lon_max))
+		return false;
+
+	// Even-odd crossing test in the lat/lon plane
+	bool flag_inside = false;
+	const int num_vertices = boundary.latitude.size();
+	for (int i = 0, j = num_vertices - 1; i < num_vertices; j = i++) {
+		const double lat_i = boundary.latitude[i];
+		const double lat_j = boundary.latitude[j];
+
+		if ((lat_i > lat_deg) != (lat_j > lat_deg)) {
+			const double lon_cross = boundary.longitude[i]
+					+ (lat_deg - lat_i) * (boundary.longitude[j] - boundary.longitude[i]) / (lat_j - lat_i);
+			if (lon < lon_cross)
+				flag_inside = !flag_inside;
+		}
+	}
+
+	return flag_inside;
+}
+
+int load_centers(const string& data_dir) {
+	printf("  Loading center data\n");
+
+	destroy_centers();
+
+	if ((load_center_boundaries(data_dir + "/Centers_CONUS") < 0)
+			|| (load_center_fixes(data_dir + "/ArtccWaypoints.csv") < 0)) {
+		printf("      Error loading center data\n");
+		destroy_centers();
+		return -1;
+	}
+
+	build_center_grid();
+
+	flag_center_available = true;
+
+	return 0;
+}
+
+int destroy_centers() {
+	g_center_codes.clear();
+	g_center_boundaries.clear();
+	g_center_fixes.clear();
+	center_grid.clear();
+
+	h_flight_center_index.clear();
+	g_center_events.clear();
+
+	flag_center_available = false;
+
+	return 0;
+}
+
+int get_num_centers() {
+	return g_center_codes.size();
+}
+
+int get_center_index(const string& center_code) {
+	vector<string>::const_iterator ite = find(g_center_codes.begin(), g_center_codes.end(), center_code);
+	if (ite == g_center_codes.end())
+		return -1;
+
+	return ite - g_center_codes.begin();
+}
+
+string get_center_code(const int& center_index) {
+	if ((center_index < 0) || (center_index >= (int)g_center_codes.size()))
+		return "";
+
+	return g_center_codes.at(center_index);
+}
+
+int find_center(const double& lat_deg, const double& lon_deg, const double& alt_ft) {
+	if (center_grid.empty())
+		return -1;
+
+	const vector<int>& candidates = center_grid.at(get_grid_cell_index(get_grid_lat_cell(lat_deg), get_grid_lon_cell(lon_deg)));
+	const ENUM_Center_Stratum preferred = (alt_ft >= CENTER_HIGH_STRATUM_ALT_MIN_FT) ? CENTER_STRATUM_HIGH : CENTER_STRATUM_LOW;
+
+	int center_index = -1;
+	for (unsigned int i = 0; i < candidates.size(); i++) {
+		const center_boundary_t& boundary = g_center_boundaries.at(candidates[i]);
+		if ((center_index > -1) && (boundary.stratum != preferred))
+			continue;
+
+		if (boundary_contains(boundary, lat_deg, lon_deg)) {
+			center_index = boundary.center_index;
+			if (boundary.stratum == preferred)
+				break;
+		}
+	}
+
+	return center_index;
+}
+
+void init_flight_centers(const int& num_flights) {
+	h_flight_center_index.assign(num_flights, -1);
+	g_center_events.clear();
+}
+
+void update_flight_centers(const float& t) {
+	const int num_tracked = h_flight_center_index.size();
+	if ((!flag_center_available) || (num_tracked == 0))
+		return;
+
+	vector<int> next_center_index(num_tracked, -1);
+
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int i = 0; i < num_tracked; i++) {
+		const update_states_t* update_states = array_update_states_ptr[i];
+		if ((update_states == NULL) || (!update_states->flag_data_initialized) || (update_states->landed_flag))
+			continue;
+
+		next_center_index[i] = find_center(update_states->lat, update_states->lon, update_states->altitude_ft);
+	}
+
+	// Events are appended in flight order so the log does not depend on
+	// the thread schedule
+	for (int i = 0; i < num_tracked; i++) {
+		const int prev = h_flight_center_index[i];
+		const int next = next_center_index[i];
+		if (prev == next)
+			continue;
+
+		if (prev > -1) {
+			center_event_t event = {i, prev, t, CENTER_EVENT_EXIT};
+			g_center_events.push_back(event);
+		}
+		if (next > -1) {
+			center_event_t event = {i, next, t, CENTER_EVENT_ENTRY};
+			g_center_events.push_back(event);
+		}
+
+		h_flight_center_index[i] = next;
+	}
+}
+
+int get_flight_center_index(const int& flight_index) {
+	if ((flight_index < 0) || (flight_index >= (int)h_flight_center_index.size()))
+		return -1;
+
+	return h_flight_center_index.at(flight_index);
+}
+
+void get_center_traffic_counts(vector<int>& counts) {
+	counts.assign(g_center_codes.size(), 0);
+
+	for (unsigned int i = 0; i < h_flight_center_index.size(); i++) {
+		if (h_flight_center_index[i] > -1)
+			counts.at(h_flight_center_index[i])++;
+	}
+}
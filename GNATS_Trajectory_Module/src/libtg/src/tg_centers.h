@@ -0,0 +1,140 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_centers.h
+ *
+ * ARTCC center boundaries, fix membership and per-flight center tracking.
+ *
+ * Boundaries and fixes are read once by load_centers().  Each center has a
+ * high and a low stratum polygon (ZHN has a single boundary polygon).  A
+ * lat/lon grid holds, for every cell, the boundaries whose bounding box
+ * overlaps the cell, so a position lookup only runs the point-in-polygon
+ * test on a handful of candidates.
+ *
+ * Center codes carry the ICAO region prefix ("KZAB", "PZAN") as returned
+ * by the center list.
+ */
+
+#ifndef TG_CENTERS_H_
+#define TG_CENTERS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+using std::map;
+using std::string;
+using std::vector;
+
+// center grid cell definitions
+#define CENTER_GRID_CELL_SIZE          1   /* degrees */
+#define CENTER_GRID_LAT_MIN          -90
+#define CENTER_GRID_LAT_MAX           90
+#define CENTER_GRID_LON_MIN         -180
+#define CENTER_GRID_LON_MAX          180
+
+#define CENTER_GRID_LAT_SIZE ((CENTER_GRID_LAT_MAX-CENTER_GRID_LAT_MIN)/CENTER_GRID_CELL_SIZE)
+#define CENTER_GRID_LON_SIZE ((CENTER_GRID_LON_MAX-CENTER_GRID_LON_MIN)/CENTER_GRID_CELL_SIZE)
+
+// Lowest altitude served by the high stratum
+#define CENTER_HIGH_STRATUM_ALT_MIN_FT 18000
+
+typedef enum _ENUM_Center_Stratum {
+	CENTER_STRATUM_LOW = 0,
+	CENTER_STRATUM_HIGH,
+	CENTER_STRATUM_BOUNDARY
+} ENUM_Center_Stratum;
+
+typedef enum _ENUM_Center_Event_Type {
+	CENTER_EVENT_ENTRY = 0,
+	CENTER_EVENT_EXIT
+} ENUM_Center_Event_Type;
+
+typedef struct _center_boundary_t {
+	int center_index;
+	ENUM_Center_Stratum stratum;
+
+	// polygon vertices, degrees.  Longitudes of a boundary spanning the
+	// antimeridian are shifted into [0, 360).
+	vector<double> latitude;
+	vector<double> longitude;
+	bool flag_shifted;
+
+	// bounding box
+	double lat_min;
+	double lat_max;
+	double lon_min;
+	double lon_max;
+} center_boundary_t;
+
+typedef struct _center_event_t {
+	int flight_index;
+	int center_index;
+	float time; // simulation time, sec
+	ENUM_Center_Event_Type type;
+} center_event_t;
+
+int load_centers(const string& data_dir);
+int destroy_centers();
+
+int get_num_centers();
+int get_center_index(const string& center_code);
+string get_center_code(const int& center_index);
+
+/*
+ * Index of the center containing the position, or -1.
+ *
+ * The stratum matching the altitude is tried first, then the other
+ * strata, so positions just outside a low boundary but inside the high
+ * one still resolve.
+ */
+int find_center(const double& lat_deg, const double& lon_deg, const double& alt_ft);
+
+// Reset the per-flight tracking state for a new propagation run
+void init_flight_centers(const int& num_flights);
+
+/*
+ * Update the current center of all airborne flights and record entry and
+ * exit events stamped with simulation time t.
+ */
+void update_flight_centers(const float& t);
+
+int get_flight_center_index(const int& flight_index);
+
+// Number of flights currently inside each center, indexed like g_center_codes
+void get_center_traffic_counts(vector<int>& counts);
+
+extern vector<string> g_center_codes;
+extern vector<center_boundary_t> g_center_boundaries;
+extern map<string, vector<string> > g_center_fixes;
+
+extern vector<int> h_flight_center_index;
+extern vector<center_event_t> g_center_events;
+
+#endif /* TG_CENTERS_H_ */
@@ -0,0 +1,1329 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_checkpoint.cpp
+ *
+ * Simulation checkpoint and restore.  See tg_checkpoint.h.
+ */
+
+#include "tg_checkpoint.h"
+
+#include "tg_aircraft.h"
+#include "tg_aircraftIndex.h"
+#include "tg_airports.h"
+#include "tg_centers.h"
+#include "tg_groundVehicle.h"
+#include "tg_random.h"
+#include "tg_simulation.h"
+#include "tg_trafficMetrics.h"
+#include "tg_trajectory.h"
+#include "tg_wake.h"
+
+#include <pthread.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace osi;
+
+static const char SIMULATION_CHECKPOINT_MAGIC[8] = {'G', 'N', 'A', 'T', 'S', 'C', 'K', 'P'};
+
+/*
+ * Fixed size file header.  The payload following it is covered by the
+ * checksum, so a file which passed load_simulation_checkpoint() can be
+ * applied without further error paths.
+ */
+typedef struct _checkpoint_header_t {
+	char magic[8];
+	unsigned int version;
+	unsigned int size_real_t;
+	unsigned int size_update_states_t;
+	int num_flights;
+	int num_ground_vehicles;
+	unsigned long long payload_size;
+	unsigned long long payload_checksum;
+} checkpoint_header_t;
+
+// Payload of the checkpoint waiting to be applied by the propagation thread
+static string staged_checkpoint_payload;
+static bool flag_staged_checkpoint = false;
+static pthread_mutex_t staged_checkpoint_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Read cursor over a checkpoint payload.  Every read past the end clears
+ * the ok flag and returns zeroed data, so callers check once at the end.
+ */
+typedef struct _checkpoint_reader_t {
+	const char* data;
+	size_t size;
+	size_t pos;
+	bool ok;
+} checkpoint_reader_t;
+
+static unsigned long long compute_checksum(const string& data) {
+	// FNV-1a
+	unsigned long long hash = 14695981039346656037ULL;
+
+	for (size_t i = 0; i < data.size(); i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+static void write_bytes(string& out, const void* src, const size_t len) {
+	out.append((const char*)src, len);
+}
+
+static void read_bytes(checkpoint_reader_t& in, void* dst, const size_t len) {
+	if ((!in.ok) || (in.size - in.pos < len)) {
+		in.ok = false;
+		memset(dst, 0, len);
+
+		return;
+	}
+
+	memcpy(dst, in.data + in.pos, len);
+	in.pos += len;
+}
+
+static void skip_bytes(checkpoint_reader_t& in, const size_t len) {
+	if ((!in.ok) || (in.size - in.pos < len)) {
+		in.ok = false;
+
+		return;
+	}
+
+	in.pos += len;
+}
+
+template<typename T>
+static void write_value(string& out, const T& value) {
+	write_bytes(out, &value, sizeof(T));
+}
+
+template<typename T>
+static void read_value(checkpoint_reader_t& in, T& value) {
+	read_bytes(in, &value, sizeof(T));
+}
+
+static void write_value(string& out, const string& value) {
+	unsigned int len = value.length();
+
+	write_value(out, len);
+	write_bytes(out, value.data(), len);
+}
+
+static void read_value(checkpoint_reader_t& in, string& value) {
+	unsigned int len = 0;
+
+	read_value(in, len);
+	if ((!in.ok) || (in.size - in.pos < len)) {
+		in.ok = false;
+		value.clear();
+
+		return;
+	}
+
+	value.assign(in.data + in.pos, len);
+	in.pos += len;
+}
+
+template<typename T>
+static void write_value(string& out, const vector<T>& value) {
+	unsigned int len = value.size();
+
+	write_value(out, len);
+	for (unsigned int i = 0; i < len; i++) {
+		write_value(out, value[i]);
+	}
+}
+
+template<typename T>
+static void read_value(checkpoint_reader_t& in, vector<T>& value) {
+	unsigned int len = 0;
+
+	value.clear();
+
+	read_value(in, len);
+	for (unsigned int i = 0; (i < len) && (in.ok); i++) {
+		T element;
+		read_value(in, element);
+		value.push_back(element);
+	}
+}
+
+template<typename A, typename B>
+static void write_value(string& out, const pair<A, B>& value) {
+	write_value(out, value.first);
+	write_value(out, value.second);
+}
+
+template<typename A, typename B>
+static void read_value(checkpoint_reader_t& in, pair<A, B>& value) {
+	read_value(in, value.first);
+	read_value(in, value.second);
+}
+
+template<typename K, typename V>
+static void write_value(string& out, const map<K, V>& value) {
+	unsigned int len = value.size();
+
+	write_value(out, len);
+	for (typename map<K, V>::const_iterator it = value.begin(); it != value.end(); it++) {
+		write_value(out, it->first);
+		write_value(out, it->second);
+	}
+}
+
+template<typename K, typename V>
+static void read_value(checkpoint_reader_t& in, map<K, V>& value) {
+	unsigned int len = 0;
+
+	value.clear();
+
+	read_value(in, len);
+	for (unsigned int i = 0; (i < len) && (in.ok); i++) {
+		K key;
+		read_value(in, key);
+		read_value(in, value[key]);
+	}
+}
+
+// Nullable C string owned by the simulation
+static void write_cstr(string& out, const char* value) {
+	bool present = (value != NULL);
+
+	write_value(out, present);
+	if (present) {
+		write_value(out, string(value));
+	}
+}
+
+/*
+ * Read a nullable C string into a slot, replacing and freeing the previous
+ * content.
+ */
+static void read_cstr(checkpoint_reader_t& in, char** slot) {
+	bool present = false;
+	string value;
+
+	read_value(in, present);
+	if (present) {
+		read_value(in, value);
+	}
+
+	if (*slot != NULL) {
+		free(*slot);
+		*slot = NULL;
+	}
+
+	if (present) {
+		*slot = (char*)calloc(value.length()+1, sizeof(char));
+		memcpy(*slot, value.c_str(), value.length());
+	}
+}
+
+/*
+ * Nullable C string decoded from a checkpoint but not yet installed
+ */
+typedef struct _checkpoint_cstr_t {
+	bool present;
+	string value;
+} checkpoint_cstr_t;
+
+static void read_value(checkpoint_reader_t& in, checkpoint_cstr_t& value) {
+	value.present = false;
+	value.value.clear();
+
+	read_value(in, value.present);
+	if (value.present) {
+		read_value(in, value.value);
+	}
+}
+
+/*
+ * Replace the C string in a slot by a decoded one
+ */
+static void install_cstr(char** slot, const checkpoint_cstr_t& value) {
+	if (*slot != NULL) {
+		free(*slot);
+		*slot = NULL;
+	}
+
+	if (value.present) {
+		*slot = (char*)calloc(value.value.length()+1, sizeof(char));
+		memcpy(*slot, value.value.c_str(), value.value.length());
+	}
+}
+
+template<typename T>
+static void write_array(string& out, const T* values, const int num) {
+	write_bytes(out, values, num * sizeof(T));
+}
+
+template<typename T>
+static void read_array(checkpoint_reader_t& in, T* values, const int num) {
+	read_bytes(in, values, num * sizeof(T));
+}
+
+/*
+ * Collect every pointer slot in the simulation state which refers to a
+ * waypoint node.  Save and apply enumerate the slots in the same order, so
+ * the checkpoint stores one node id per slot.
+ */
+static void collect_waypoint_node_slots(const int num_flights, vector<waypoint_node_t**>& slots) {
+	slots.clear();
+
+	for (int i = 0; i < num_flights; i++) {
+		slots.push_back(&array_Airborne_Flight_Plan_ptr[i]);
+		slots.push_back(&array_Airborne_Flight_Plan_toc_ptr[i]);
+		slots.push_back(&array_Airborne_Flight_Plan_tod_ptr[i]);
+		slots.push_back(&array_Airborne_Flight_Plan_Final_Node_ptr[i]);
+
+		slots.push_back(&h_departing_taxi_plan.waypoint_node_ptr[i]);
+		slots.push_back(&h_departing_taxi_plan.waypoint_final_node_ptr[i]);
+		slots.push_back(&h_landing_taxi_plan.waypoint_node_ptr[i]);
+		slots.push_back(&h_landing_taxi_plan.waypoint_final_node_ptr[i]);
+
+		slots.push_back(&h_aircraft_soa.target_waypoint_node_ptr[i]);
+		slots.push_back(&h_aircraft_soa.last_WaypointNode_ptr[i]);
+		slots.push_back(&h_aircraft_soa.acceleration_aiming_waypoint_node_ptr[i]);
+
+		update_states_t* update_states = array_update_states_ptr[i];
+		if (update_states != NULL) {
+			slots.push_back(&update_states->target_WaypointNode_ptr);
+			slots.push_back(&update_states->last_WaypointNode_ptr);
+			slots.push_back(&update_states->waypointNode_withValidAltitude_ptr);
+			slots.push_back(&update_states->go_around_WaypointNode_ptr);
+			slots.push_back(&update_states->pre_holding_pattern_target_WaypointNode_ptr);
+			slots.push_back(&update_states->holding_pattern_WaypointNode_ptr);
+		}
+	}
+
+	for (unsigned int i = 0; i < groundVehicleStates.size(); i++) {
+		slots.push_back(&groundVehicleStates.at(i).drive_plan_ptr);
+		slots.push_back(&groundVehicleStates.at(i).drive_plan_final_node_ptr);
+	}
+}
+
+/*
+ * Number of slots collect_waypoint_node_slots() returns for flights with
+ * and without update states
+ */
+static unsigned int count_waypoint_node_slots(const int num_flights, const int num_update_states, const int num_ground_vehicles) {
+	return 11 * num_flights + 6 * num_update_states + 2 * num_ground_vehicles;
+}
+
+/*
+ * Number the waypoint nodes reachable from the slots.  Lists are walked in
+ * both directions since holding patterns and go-around branches link into
+ * the middle of a flight plan.
+ */
+static void number_waypoint_nodes(const vector<waypoint_node_t**>& slots,
+		vector<waypoint_node_t*>& nodes,
+		map<waypoint_node_t*, int>& node_ids) {
+	vector<waypoint_node_t*> pending;
+
+	for (unsigned int i = 0; i < slots.size(); i++) {
+		pending.push_back(*slots[i]);
+	}
+
+	while (!pending.empty()) {
+		waypoint_node_t* node = pending.back();
+		pending.pop_back();
+
+		if ((node == NULL) || (node_ids.find(node) != node_ids.end())) {
+			continue;
+		}
+
+		node_ids[node] = nodes.size();
+		nodes.push_back(node);
+
+		pending.push_back(node->next_node_ptr);
+		pending.push_back(node->prev_node_ptr);
+	}
+}
+
+static int get_waypoint_node_id(const map<waypoint_node_t*, int>& node_ids, waypoint_node_t* node) {
+	if (node == NULL) {
+		return -1;
+	}
+
+	return node_ids.at(node);
+}
+
+static void write_waypoint_node(string& out, const waypoint_node_t* node) {
+	write_value(out, node->flag_geoStyle);
+	write_cstr(out, node->wpname);
+	write_cstr(out, node->wptype);
+	write_value(out, node->latitude);
+	write_value(out, node->longitude);
+	write_value(out, node->distance_to_next_node);
+	write_value(out, node->course_rad_to_next_node);
+	write_cstr(out, node->alt_desc);
+	write_value(out, node->alt_1);
+	write_value(out, node->alt_2);
+	write_value(out, node->altitude_estimate);
+	write_cstr(out, node->procname);
+	write_cstr(out, node->proctype);
+	write_cstr(out, node->recco_navaid);
+	write_value(out, node->theta);
+	write_value(out, node->rho);
+	write_value(out, node->mag_course);
+	write_value(out, node->rt_dist);
+	write_cstr(out, node->spdlim_desc);
+	write_value(out, node->speed_lim);
+	write_cstr(out, node->phase);
+}
+
+static void read_waypoint_node(checkpoint_reader_t& in, waypoint_node_t* node) {
+	read_value(in, node->flag_geoStyle);
+	read_cstr(in, &node->wpname);
+	read_cstr(in, &node->wptype);
+	read_value(in, node->latitude);
+	read_value(in, node->longitude);
+	read_value(in, node->distance_to_next_node);
+	read_value(in, node->course_rad_to_next_node);
+	read_cstr(in, &node->alt_desc);
+	read_value(in, node->alt_1);
+	read_value(in, node->alt_2);
+	read_value(in, node->altitude_estimate);
+	read_cstr(in, &node->procname);
+	read_cstr(in, &node->proctype);
+	read_cstr(in, &node->recco_navaid);
+	read_value(in, node->theta);
+	read_value(in, node->rho);
+	read_value(in, node->mag_course);
+	read_value(in, node->rt_dist);
+	read_cstr(in, &node->spdlim_desc);
+	read_value(in, node->speed_lim);
+	read_cstr(in, &node->phase);
+}
+
+struct checkpoint_array_writer {
+	template<typename T>
+	void operator()(string& out, const T* values, const int num) const {
+		write_array(out, values, num);
+	}
+};
+
+struct checkpoint_array_reader {
+	template<typename T>
+	void operator()(checkpoint_reader_t& in, T* values, const int num) const {
+		read_array(in, values, num);
+	}
+};
+
+struct checkpoint_array_skipper {
+	template<typename T>
+	void operator()(checkpoint_reader_t& in, T* values, const int num) const {
+		(void)values;
+
+		skip_bytes(in, num * sizeof(T));
+	}
+};
+
+/*
+ * Visit the per-flight arrays in checkpoint order.  Waypoint node pointers
+ * are not visited here, they are stored as slots.
+ */
+template<typename IO, typename ARRAY_FN>
+static void visit_aircraft_arrays(IO& io, const ARRAY_FN& array_fn, const int num) {
+	array_fn(io, h_aircraft_soa.flag_geoStyle, num);
+	array_fn(io, h_aircraft_soa.sector_index, num);
+	array_fn(io, h_aircraft_soa.latitude_deg, num);
+	array_fn(io, h_aircraft_soa.longitude_deg, num);
+	array_fn(io, h_aircraft_soa.altitude_ft, num);
+	array_fn(io, h_aircraft_soa.rocd_fps, num);
+	array_fn(io, h_aircraft_soa.tas_knots, num);
+	array_fn(io, h_aircraft_soa.tas_knots_ground, num);
+	array_fn(io, h_aircraft_soa.course_rad, num);
+	array_fn(io, h_aircraft_soa.fpa_rad, num);
+	array_fn(io, h_aircraft_soa.flight_phase, num);
+	array_fn(io, h_aircraft_soa.departure_time_sec, num);
+	array_fn(io, h_aircraft_soa.cruise_alt_ft, num);
+	array_fn(io, h_aircraft_soa.cruise_tas_knots, num);
+	array_fn(io, h_aircraft_soa.latitude_deg_pre_pause, num);
+	array_fn(io, h_aircraft_soa.longitude_deg_pre_pause, num);
+	array_fn(io, h_aircraft_soa.altitude_ft_pre_pause, num);
+	array_fn(io, h_aircraft_soa.rocd_fps_pre_pause, num);
+	array_fn(io, h_aircraft_soa.tas_knots_pre_pause, num);
+	array_fn(io, h_aircraft_soa.course_rad_pre_pause, num);
+	array_fn(io, h_aircraft_soa.fpa_rad_pre_pause, num);
+	array_fn(io, h_aircraft_soa.cruise_alt_ft_pre_pause, num);
+	array_fn(io, h_aircraft_soa.cruise_tas_knots_pre_pause, num);
+	array_fn(io, h_aircraft_soa.origin_airport_elevation_ft, num);
+	array_fn(io, h_aircraft_soa.destination_airport_elevation_ft, num);
+	array_fn(io, h_aircraft_soa.landed_flag, num);
+	array_fn(io, h_aircraft_soa.adb_aircraft_type_index, num);
+	array_fn(io, h_aircraft_soa.holding_started, num);
+	array_fn(io, h_aircraft_soa.holding_stopped, num);
+	array_fn(io, h_aircraft_soa.has_holding_pattern, num);
+	array_fn(io, h_aircraft_soa.hold_start_index, num);
+	array_fn(io, h_aircraft_soa.hold_end_index, num);
+	array_fn(io, h_aircraft_soa.holding_tas_knots, num);
+	array_fn(io, h_aircraft_soa.target_waypoint_index, num);
+	array_fn(io, h_aircraft_soa.target_altitude_ft, num);
+	array_fn(io, h_aircraft_soa.toc_index, num);
+	array_fn(io, h_aircraft_soa.tod_index, num);
+	array_fn(io, h_aircraft_soa.flag_target_waypoint_change, num);
+	array_fn(io, h_aircraft_soa.flag_reached_meterfix_point, num);
+	array_fn(io, h_aircraft_soa.V_horizontal, num);
+	array_fn(io, h_aircraft_soa.acceleration, num);
+	array_fn(io, h_aircraft_soa.V2_point_latitude_deg, num);
+	array_fn(io, h_aircraft_soa.V2_point_longitude_deg, num);
+	array_fn(io, h_aircraft_soa.estimate_takeoff_point_latitude_deg, num);
+	array_fn(io, h_aircraft_soa.estimate_takeoff_point_longitude_deg, num);
+	array_fn(io, h_aircraft_soa.estimate_touchdown_point_latitude_deg, num);
+	array_fn(io, h_aircraft_soa.estimate_touchdown_point_longitude_deg, num);
+	array_fn(io, h_aircraft_soa.t_takeoff, num);
+	array_fn(io, h_aircraft_soa.t_landing, num);
+	array_fn(io, h_aircraft_soa.hold_flight_phase, num);
+	array_fn(io, h_aircraft_soa.course_rad_runway, num);
+	array_fn(io, h_aircraft_soa.course_rad_taxi, num);
+
+	array_fn(io, array_Airborne_Flight_Plan_Waypoint_length, num);
+	array_fn(io, ground_departing_data_init, num);
+	array_fn(io, ground_landing_data_init, num);
+}
+
+static void write_taxi_plan(string& out, const taxi_plan_t& plan, const int index) {
+	write_cstr(out, plan.airport_code[index]);
+	write_cstr(out, plan.runway_name[index]);
+	write_value(out, plan.waypoint_length[index]);
+	write_value(out, plan.taxi_tas_knots[index]);
+	write_value(out, plan.ramp_tas_knots[index]);
+	write_value(out, plan.runway_entry_latitude_geoStyle[index]);
+	write_value(out, plan.runway_entry_longitude_geoStyle[index]);
+	write_value(out, plan.runway_end_latitude_geoStyle[index]);
+	write_value(out, plan.runway_end_longitude_geoStyle[index]);
+}
+
+// Taxi plan of one flight, waypoint node pointers excluded
+typedef struct _checkpoint_taxi_plan_t {
+	checkpoint_cstr_t airport_code;
+	checkpoint_cstr_t runway_name;
+	int waypoint_length;
+	double taxi_tas_knots;
+	double ramp_tas_knots;
+	double runway_entry_latitude_geoStyle;
+	double runway_entry_longitude_geoStyle;
+	double runway_end_latitude_geoStyle;
+	double runway_end_longitude_geoStyle;
+} checkpoint_taxi_plan_t;
+
+static void read_taxi_plan(checkpoint_reader_t& in, checkpoint_taxi_plan_t& plan) {
+	read_value(in, plan.airport_code);
+	read_value(in, plan.runway_name);
+	read_value(in, plan.waypoint_length);
+	read_value(in, plan.taxi_tas_knots);
+	read_value(in, plan.ramp_tas_knots);
+	read_value(in, plan.runway_entry_latitude_geoStyle);
+	read_value(in, plan.runway_entry_longitude_geoStyle);
+	read_value(in, plan.runway_end_latitude_geoStyle);
+	read_value(in, plan.runway_end_longitude_geoStyle);
+}
+
+static void install_taxi_plan(const checkpoint_taxi_plan_t& plan, taxi_plan_t& target, const int index) {
+	install_cstr(&target.airport_code[index], plan.airport_code);
+	install_cstr(&target.runway_name[index], plan.runway_name);
+	target.waypoint_length[index] = plan.waypoint_length;
+	target.taxi_tas_knots[index] = plan.taxi_tas_knots;
+	target.ramp_tas_knots[index] = plan.ramp_tas_knots;
+	target.runway_entry_latitude_geoStyle[index] = plan.runway_entry_latitude_geoStyle;
+	target.runway_entry_longitude_geoStyle[index] = plan.runway_entry_longitude_geoStyle;
+	target.runway_end_latitude_geoStyle[index] = plan.runway_end_latitude_geoStyle;
+	target.runway_end_longitude_geoStyle[index] = plan.runway_end_longitude_geoStyle;
+}
+
+static void write_trajectory(string& out, const Trajectory& trajectory) {
+	write_value(out, trajectory.start_time);
+	write_value(out, trajectory.interval_ground);
+	write_value(out, trajectory.interval_airborne);
+	write_value(out, trajectory.cruise_altitude_ft);
+	write_value(out, trajectory.cruise_tas_knots);
+	write_value(out, trajectory.origin_airport_elevation_ft);
+	write_value(out, trajectory.destination_airport_elevation_ft);
+	write_value(out, trajectory.latitude_deg);
+	write_value(out, trajectory.longitude_deg);
+	write_value(out, trajectory.altitude_ft);
+	write_value(out, trajectory.rocd_fps);
+	write_value(out, trajectory.tas_knots);
+	write_value(out, trajectory.tas_knots_ground);
+	write_value(out, trajectory.course_deg);
+	write_value(out, trajectory.fpa_deg);
+	write_value(out, trajectory.flight_phase);
+	write_value(out, trajectory.timestamp);
+}
+
+static void read_trajectory(checkpoint_reader_t& in, Trajectory& trajectory) {
+	read_value(in, trajectory.start_time);
+	read_value(in, trajectory.interval_ground);
+	read_value(in, trajectory.interval_airborne);
+	read_value(in, trajectory.cruise_altitude_ft);
+	read_value(in, trajectory.cruise_tas_knots);
+	read_value(in, trajectory.origin_airport_elevation_ft);
+	read_value(in, trajectory.destination_airport_elevation_ft);
+	read_value(in, trajectory.latitude_deg);
+	read_value(in, trajectory.longitude_deg);
+	read_value(in, trajectory.altitude_ft);
+	read_value(in, trajectory.rocd_fps);
+	read_value(in, trajectory.tas_knots);
+	read_value(in, trajectory.tas_knots_ground);
+	read_value(in, trajectory.course_deg);
+	read_value(in, trajectory.fpa_deg);
+	read_value(in, trajectory.flight_phase);
+	read_value(in, trajectory.timestamp);
+}
+
+// Drive plan pointers are stored as slots
+static void write_ground_vehicle(string& out, const GroundVehicle& vehicle) {
+	write_value(out, vehicle.flag_external_groundVehicle);
+	write_value(out, vehicle.flag_data_initialized);
+	write_value(out, vehicle.vehicle_id);
+	write_value(out, vehicle.aircraft_id);
+	write_value(out, vehicle.airport_id);
+	write_value(out, vehicle.latitude);
+	write_value(out, vehicle.longitude);
+	write_value(out, vehicle.altitude);
+	write_value(out, vehicle.speed);
+	write_value(out, vehicle.course);
+	write_value(out, vehicle.departure_time);
+	write_value(out, vehicle.drive_plan_length);
+	write_value(out, vehicle.target_waypoint_name);
+	write_value(out, vehicle.target_waypoint_index);
+	write_value(out, vehicle.operator_absence_steps);
+	write_value(out, vehicle.lag_params);
+	write_value(out, vehicle.lag_course_values);
+	write_value(out, vehicle.lag_speed_values);
+	write_value(out, vehicle.flag_course_override);
+	write_value(out, vehicle.history_index);
+}
+
+static void read_ground_vehicle(checkpoint_reader_t& in, GroundVehicle& vehicle) {
+	read_value(in, vehicle.flag_external_groundVehicle);
+	read_value(in, vehicle.flag_data_initialized);
+	read_value(in, vehicle.vehicle_id);
+	read_value(in, vehicle.aircraft_id);
+	read_value(in, vehicle.airport_id);
+	read_value(in, vehicle.latitude);
+	read_value(in, vehicle.longitude);
+	read_value(in, vehicle.altitude);
+	read_value(in, vehicle.speed);
+	read_value(in, vehicle.course);
+	read_value(in, vehicle.departure_time);
+	read_value(in, vehicle.drive_plan_length);
+	read_value(in, vehicle.target_waypoint_name);
+	read_value(in, vehicle.target_waypoint_index);
+	read_value(in, vehicle.operator_absence_steps);
+	read_value(in, vehicle.lag_params);
+	read_value(in, vehicle.lag_course_values);
+	read_value(in, vehicle.lag_speed_values);
+	read_value(in, vehicle.flag_course_override);
+	read_value(in, vehicle.history_index);
+}
+
+static void write_ground_vehicle_history(string& out, const groundVehicle_history_t& history) {
+	write_value(out, history.vehicle_id);
+	write_value(out, history.aircraft_ids);
+	write_value(out, history.samples);
+}
+
+static void read_ground_vehicle_history(checkpoint_reader_t& in, groundVehicle_history_t& history) {
+	read_value(in, history.vehicle_id);
+	read_value(in, history.aircraft_ids);
+	read_value(in, history.samples);
+}
+
+// Human error models, CDNR status, ground vehicles, centers, wake vortices
+// and traffic metrics
+template<typename IO, typename VALUE_FN>
+static void visit_simulation_globals(IO& io, const VALUE_FN& value_fn) {
+	value_fn(io, skipFlightPhase);
+	value_fn(io, lagParams);
+	value_fn(io, lagParamValues);
+	value_fn(io, groundOperatorActionRepeat);
+	value_fn(io, radarErrorModel);
+	value_fn(io, controllerAway);
+	value_fn(io, defaultSpeed);
+	value_fn(io, defaultCourse);
+	value_fn(io, defaultRocd);
+
+	value_fn(io, flag_enable_cdnr);
+	value_fn(io, map_CDR_status);
+	value_fn(io, cnt_event_cdnr);
+
+	value_fn(io, map_VehicleId_History);
+	value_fn(io, map_VehicleId_Seq);
+
+	value_fn(io, h_flight_center_index);
+	value_fn(io, g_center_events);
+
+	value_fn(io, flag_enable_wake_vortex_model);
+	value_fn(io, g_wake_segments);
+	value_fn(io, g_wake_encounters);
+	value_fn(io, h_wake_encounter_generator);
+	value_fn(io, t_last_wake_update);
+
+	value_fn(io, flag_enable_traffic_metrics);
+	value_fn(io, g_traffic_metrics.bin_sec);
+	value_fn(io, g_traffic_metrics.sector_names);
+	value_fn(io, g_traffic_metrics.airport_codes);
+	value_fn(io, g_traffic_metrics.sector_bins);
+	value_fn(io, g_traffic_metrics.airport_bins);
+	value_fn(io, h_traffic_metrics_sector_index);
+	value_fn(io, h_traffic_metrics_flight_status);
+	value_fn(io, h_traffic_metrics_origin_slot);
+	value_fn(io, h_traffic_metrics_destination_slot);
+}
+
+struct checkpoint_value_writer {
+	template<typename T>
+	void operator()(string& out, const T& value) const {
+		write_value(out, value);
+	}
+};
+
+struct checkpoint_value_reader {
+	template<typename T>
+	void operator()(checkpoint_reader_t& in, T& value) const {
+		read_value(in, value);
+	}
+};
+
+// Decodes into a temporary and leaves the visited value untouched
+struct checkpoint_value_skipper {
+	template<typename T>
+	void operator()(checkpoint_reader_t& in, const T& value) const {
+		(void)value;
+
+		T tmpValue;
+		read_value(in, tmpValue);
+	}
+};
+
+static void write_weather_waypoints(string& out) {
+	unsigned int len = vector_tactical_weather_waypoint.size();
+
+	write_value(out, len);
+	for (unsigned int i = 0; i < len; i++) {
+		write_value(out, vector_tactical_weather_waypoint.at(i).waypoint_name);
+		write_value(out, vector_tactical_weather_waypoint.at(i).durationSecond);
+	}
+}
+
+static void read_weather_waypoints(checkpoint_reader_t& in, vector<WeatherWaypoint>& weather_waypoints) {
+	unsigned int len = 0;
+
+	weather_waypoints.clear();
+
+	read_value(in, len);
+	for (unsigned int i = 0; (i < len) && (in.ok); i++) {
+		WeatherWaypoint tmpWeatherWaypoint;
+		read_value(in, tmpWeatherWaypoint.waypoint_name);
+		read_value(in, tmpWeatherWaypoint.durationSecond);
+
+		weather_waypoints.push_back(tmpWeatherWaypoint);
+	}
+}
+
+/*
+ * Leading part of the payload which identifies the run.  Read by load for
+ * validation and skipped by apply.
+ */
+static void read_checkpoint_preamble(checkpoint_reader_t& in,
+		const int num_flights,
+		float& t,
+		float& step_surface,
+		float& step_terminal,
+		float& step_airborne,
+		vector<string>& callsigns) {
+	read_value(in, t);
+	read_value(in, step_surface);
+	read_value(in, step_terminal);
+	read_value(in, step_airborne);
+
+	callsigns.resize(num_flights);
+	for (int i = 0; i < num_flights; i++) {
+		read_value(in, callsigns[i]);
+	}
+}
+
+int save_simulation_checkpoint(const string& path) {
+#if USE_GPU
+	printf("Simulation checkpoint: Not supported in GPU builds\n");
+
+	return -1;
+#else
+	if ((nats_simulation_status != NATS_SIMULATION_STATUS_PAUSE) || (!flag_simulation_paused_at_step)) {
+		printf("Simulation checkpoint: Simulation must be paused at a time step\n");
+
+		return -1;
+	}
+
+	const int num_flights = get_num_flights();
+
+	string payload;
+
+	write_value(payload, nats_simulation_timestamp);
+	write_value(payload, t_step);
+	write_value(payload, t_step_terminal);
+	write_value(payload, t_data_collection_period_airborne);
+
+	for (int i = 0; i < num_flights; i++) {
+		write_value(payload, g_trajectories.at(i).callsign);
+	}
+
+	vector<waypoint_node_t**> slots;
+	vector<waypoint_node_t*> nodes;
+	map<waypoint_node_t*, int> node_ids;
+
+	collect_waypoint_node_slots(num_flights, slots);
+	number_waypoint_nodes(slots, nodes, node_ids);
+
+	write_value(payload, (unsigned int)nodes.size());
+	for (unsigned int i = 0; i < nodes.size(); i++) {
+		write_waypoint_node(payload, nodes[i]);
+		write_value(payload, get_waypoint_node_id(node_ids, nodes[i]->next_node_ptr));
+		write_value(payload, get_waypoint_node_id(node_ids, nodes[i]->prev_node_ptr));
+	}
+
+	visit_aircraft_arrays(payload, checkpoint_array_writer(), num_flights);
+
+	for (int i = 0; i < num_flights; i++) {
+		write_cstr(payload, h_aircraft_soa.runway_name_departing[i]);
+		write_cstr(payload, h_aircraft_soa.runway_name_landing[i]);
+
+		write_taxi_plan(payload, h_departing_taxi_plan, i);
+		write_taxi_plan(payload, h_landing_taxi_plan, i);
+
+		bool present = (array_update_states_ptr[i] != NULL);
+		write_value(payload, present);
+		if (present) {
+			write_bytes(payload, array_update_states_ptr[i], sizeof(update_states_t));
+			write_cstr(payload, array_update_states_ptr[i]->acid);
+		}
+
+		write_trajectory(payload, g_trajectories.at(i));
+	}
+
+	visit_simulation_globals(payload, checkpoint_value_writer());
+	write_value(payload, cdnr_oss_doc.str());
+	write_weather_waypoints(payload);
+
+	// Random draws are functions of the seed and caller-side counters, so
+	// the seed is the complete generator state
+	write_value(payload, is_random_deterministic_mode());
+	write_value(payload, get_random_scenario_seed());
+
+	for (unsigned int i = 0; i < groundVehicleStates.size(); i++) {
+		write_ground_vehicle(payload, groundVehicleStates.at(i));
+	}
+
+	write_value(payload, groundVehiclePreviousStates.latitude);
+	write_value(payload, groundVehiclePreviousStates.longitude);
+	write_value(payload, groundVehiclePreviousStates.altitude);
+	write_value(payload, groundVehiclePreviousStates.speed);
+	write_value(payload, groundVehiclePreviousStates.course);
+
+	write_value(payload, (unsigned int)groundVehicleHistories.size());
+	for (unsigned int i = 0; i < groundVehicleHistories.size(); i++) {
+		write_ground_vehicle_history(payload, groundVehicleHistories.at(i));
+	}
+
+	write_value(payload, (unsigned int)slots.size());
+	for (unsigned int i = 0; i < slots.size(); i++) {
+		write_value(payload, get_waypoint_node_id(node_ids, *slots[i]));
+	}
+
+	checkpoint_header_t header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SIMULATION_CHECKPOINT_MAGIC, sizeof(header.magic));
+	header.version = SIMULATION_CHECKPOINT_VERSION;
+	header.size_real_t = sizeof(real_t);
+	header.size_update_states_t = sizeof(update_states_t);
+	header.num_flights = num_flights;
+	header.num_ground_vehicles = groundVehicleStates.size();
+	header.payload_size = payload.size();
+	header.payload_checksum = compute_checksum(payload);
+
+	FILE* fp = fopen(path.c_str(), "wb");
+	if (fp == NULL) {
+		printf("Simulation checkpoint: Can't open file %s\n", path.c_str());
+
+		return -1;
+	}
+
+	bool flag_written = (fwrite(&header, sizeof(header), 1, fp) == 1)
+			&& (fwrite(payload.data(), 1, payload.size(), fp) == payload.size());
+
+	if ((fclose(fp) != 0) || (!flag_written)) {
+		printf("Simulation checkpoint: Failed writing file %s\n", path.c_str());
+
+		return -1;
+	}
+
+	printf("Simulation checkpoint: Saved time = %f seconds, %d flights, %u waypoint nodes to %s\n", nats_simulation_timestamp, num_flights, (unsigned int)nodes.size(), path.c_str());
+
+	return 0;
+#endif
+}
+
+int load_simulation_checkpoint(const string& path) {
+#if USE_GPU
+	printf("Simulation checkpoint: Not supported in GPU builds\n");
+
+	return -1;
+#else
+	FILE* fp = fopen(path.c_str(), "rb");
+	if (fp == NULL) {
+		printf("Simulation checkpoint: Can't open file %s\n", path.c_str());
+
+		return -1;
+	}
+
+	string content;
+	char buffer[65536];
+	size_t len;
+	while ((len = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+		content.append(buffer, len);
+	}
+	fclose(fp);
+
+	checkpoint_header_t header;
+	if (content.size() < sizeof(header)) {
+		printf("Simulation checkpoint: %s is not a checkpoint file\n", path.c_str());
+
+		return -1;
+	}
+	memcpy(&header, content.data(), sizeof(header));
+
+	if (memcmp(header.magic, SIMULATION_CHECKPOINT_MAGIC, sizeof(header.magic)) != 0) {
+		printf("Simulation checkpoint: %s is not a checkpoint file\n", path.c_str());
+
+		return -1;
+	}
+
+	if (header.version != SIMULATION_CHECKPOINT_VERSION) {
+		printf("Simulation checkpoint: Unsupported version %u (expected %u)\n", header.version, SIMULATION_CHECKPOINT_VERSION);
+
+		return -1;
+	}
+
+	if ((header.size_real_t != sizeof(real_t)) || (header.size_update_states_t != sizeof(update_states_t))) {
+		printf("Simulation checkpoint: File was written by a build with different data layout\n");
+
+		return -1;
+	}
+
+	const int num_flights = get_num_flights();
+
+	if ((header.num_flights != num_flights) || (header.num_ground_vehicles != (int)groundVehicleStates.size())) {
+		printf("Simulation checkpoint: File has %d flights and %d ground vehicles, %d and %d are loaded\n",
+				header.num_flights, header.num_ground_vehicles, num_flights, (int)groundVehicleStates.size());
+
+		return -1;
+	}
+
+	string payload = content.substr(sizeof(header));
+
+	if ((header.payload_size != payload.size()) || (header.payload_checksum != compute_checksum(payload))) {
+		printf("Simulation checkpoint: %s is truncated or corrupted\n", path.c_str());
+
+		return -1;
+	}
+
+	checkpoint_reader_t in = {payload.data(), payload.size(), 0, true};
+
+	float t = 0;
+	float step_surface = 0;
+	float step_terminal = 0;
+	float step_airborne = 0;
+	vector<string> callsigns;
+
+	read_checkpoint_preamble(in, num_flights, t, step_surface, step_terminal, step_airborne, callsigns);
+	if (!in.ok) {
+		printf("Simulation checkpoint: %s is truncated or corrupted\n", path.c_str());
+
+		return -1;
+	}
+
+	for (int i = 0; i < num_flights; i++) {
+		if (callsigns[i] != g_trajectories.at(i).callsign) {
+			printf("Simulation checkpoint: Flight %d is %s in the file and %s in the loaded data\n", i, callsigns[i].c_str(), g_trajectories.at(i).callsign.c_str());
+
+			return -1;
+		}
+	}
+
+	pthread_mutex_lock(&staged_checkpoint_mutex);
+	staged_checkpoint_payload.swap(payload);
+	flag_staged_checkpoint = true;
+	pthread_mutex_unlock(&staged_checkpoint_mutex);
+
+	printf("Simulation checkpoint: Loaded %s.  Propagation resumes at time = %f seconds on next start\n", path.c_str(), t);
+
+	return 0;
+#endif
+}
+
+bool has_staged_simulation_checkpoint() {
+	pthread_mutex_lock(&staged_checkpoint_mutex);
+	bool retValue = flag_staged_checkpoint;
+	pthread_mutex_unlock(&staged_checkpoint_mutex);
+
+	return retValue;
+}
+
+void clear_staged_simulation_checkpoint() {
+	pthread_mutex_lock(&staged_checkpoint_mutex);
+	staged_checkpoint_payload.clear();
+	flag_staged_checkpoint = false;
+	pthread_mutex_unlock(&staged_checkpoint_mutex);
+}
+
+// Per-flight part of a decoded checkpoint
+typedef struct _checkpoint_flight_t {
+	checkpoint_cstr_t runway_name_departing;
+	checkpoint_cstr_t runway_name_landing;
+	checkpoint_taxi_plan_t departing_taxi_plan;
+	checkpoint_taxi_plan_t landing_taxi_plan;
+	bool has_update_states;
+	update_states_t update_states;
+	checkpoint_cstr_t acid;
+} checkpoint_flight_t;
+
+/*
+ * Checkpoint payload decoded into temporaries.  The waypoint nodes are
+ * owned by the decoded state until they are installed.  The aircraft
+ * arrays and the simulation globals were decoded for validation only and
+ * are read again from their payload position when installed.
+ */
+typedef struct _checkpoint_state_t {
+	float t;
+	float step_surface;
+	float step_terminal;
+	float step_airborne;
+	vector<waypoint_node_t*> nodes;
+	size_t aircraft_arrays_pos;
+	vector<checkpoint_flight_t> flights;
+	vector<Trajectory> trajectories;
+	size_t globals_pos;
+	string cdnr_doc;
+	vector<WeatherWaypoint> weather_waypoints;
+	bool flag_random_deterministic;
+	unsigned long long random_seed;
+	vector<GroundVehicle> ground_vehicles;
+	groundVehicle_previous_states_t ground_vehicle_previous_states;
+	vector<groundVehicle_history_t> ground_vehicle_histories;
+	vector<int> slot_node_ids;
+} checkpoint_state_t;
+
+static void release_waypoint_nodes(vector<waypoint_node_t*>& nodes) {
+	for (unsigned int i = 0; i < nodes.size(); i++) {
+		releaseWaypointNodeContent(nodes[i]);
+		free(nodes[i]);
+	}
+
+	nodes.clear();
+}
+
+/*
+ * Decode a staged payload without touching the simulation state.  Returns
+ * false when the payload is malformed.  The decoded nodes are released in
+ * that case.
+ */
+static bool decode_checkpoint(const string& payload, const int num_flights, checkpoint_state_t& state) {
+	checkpoint_reader_t in = {payload.data(), payload.size(), 0, true};
+
+	vector<string> callsigns;
+	read_checkpoint_preamble(in, num_flights, state.t, state.step_surface, state.step_terminal, state.step_airborne, callsigns);
+
+	unsigned int num_nodes = 0;
+	read_value(in, num_nodes);
+
+	vector<pair<int, int> > node_links;
+
+	for (unsigned int i = 0; (i < num_nodes) && (in.ok); i++) {
+		waypoint_node_t* node = (waypoint_node_t*)calloc(1, sizeof(waypoint_node_t));
+		pair<int, int> link;
+
+		state.nodes.push_back(node);
+
+		read_waypoint_node(in, node);
+		read_value(in, link.first);
+		read_value(in, link.second);
+
+		node_links.push_back(link);
+	}
+
+	for (unsigned int i = 0; (i < node_links.size()) && (in.ok); i++) {
+		if ((node_links[i].first >= (int)state.nodes.size()) || (node_links[i].second >= (int)state.nodes.size())) {
+			in.ok = false;
+
+			break;
+		}
+
+		state.nodes[i]->next_node_ptr = (node_links[i].first < 0) ? NULL : state.nodes[node_links[i].first];
+		state.nodes[i]->prev_node_ptr = (node_links[i].second < 0) ? NULL : state.nodes[node_links[i].second];
+	}
+
+	state.aircraft_arrays_pos = in.pos;
+	visit_aircraft_arrays(in, checkpoint_array_skipper(), num_flights);
+
+	int num_update_states = 0;
+
+	state.flights.resize(num_flights);
+	for (int i = 0; (i < num_flights) && (in.ok); i++) {
+		checkpoint_flight_t& flight = state.flights[i];
+
+		read_value(in, flight.runway_name_departing);
+		read_value(in, flight.runway_name_landing);
+
+		read_taxi_plan(in, flight.departing_taxi_plan);
+		read_taxi_plan(in, flight.landing_taxi_plan);
+
+		read_value(in, flight.has_update_states);
+		if (flight.has_update_states) {
+			read_bytes(in, &flight.update_states, sizeof(update_states_t));
+			read_value(in, flight.acid);
+
+			num_update_states++;
+		}
+
+		// Fields not stored in the checkpoint are kept
+		state.trajectories.push_back(g_trajectories.at(i));
+		read_trajectory(in, state.trajectories.back());
+	}
+
+	state.globals_pos = in.pos;
+	visit_simulation_globals(in, checkpoint_value_skipper());
+
+	read_value(in, state.cdnr_doc);
+	read_weather_waypoints(in, state.weather_waypoints);
+
+	read_value(in, state.flag_random_deterministic);
+	read_value(in, state.random_seed);
+
+	state.ground_vehicles = groundVehicleStates;
+	for (unsigned int i = 0; (i < state.ground_vehicles.size()) && (in.ok); i++) {
+		read_ground_vehicle(in, state.ground_vehicles.at(i));
+	}
+
+	read_value(in, state.ground_vehicle_previous_states.latitude);
+	read_value(in, state.ground_vehicle_previous_states.longitude);
+	read_value(in, state.ground_vehicle_previous_states.altitude);
+	read_value(in, state.ground_vehicle_previous_states.speed);
+	read_value(in, state.ground_vehicle_previous_states.course);
+
+	unsigned int num_histories = 0;
+	read_value(in, num_histories);
+	for (unsigned int i = 0; (i < num_histories) && (in.ok); i++) {
+		groundVehicle_history_t history;
+		read_ground_vehicle_history(in, history);
+		state.ground_vehicle_histories.push_back(history);
+	}
+
+	unsigned int num_slots = 0;
+	read_value(in, num_slots);
+	if (in.ok && (num_slots != count_waypoint_node_slots(num_flights, num_update_states, state.ground_vehicles.size()))) {
+		in.ok = false;
+	}
+
+	for (unsigned int i = 0; (i < num_slots) && (in.ok); i++) {
+		int node_id = -1;
+		read_value(in, node_id);
+
+		if (node_id >= (int)state.nodes.size()) {
+			in.ok = false;
+		} else {
+			state.slot_node_ids.push_back(node_id);
+		}
+	}
+
+	if ((!in.ok) || (in.pos != in.size)) {
+		release_waypoint_nodes(state.nodes);
+
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Replace the simulation state by a decoded checkpoint.  The waypoint
+ * nodes of the replaced state are freed.
+ */
+static void install_checkpoint(const string& payload, const int num_flights, checkpoint_state_t& state) {
+	vector<waypoint_node_t**> old_slots;
+	vector<waypoint_node_t*> old_nodes;
+	map<waypoint_node_t*, int> old_node_ids;
+
+	collect_waypoint_node_slots(num_flights, old_slots);
+	number_waypoint_nodes(old_slots, old_nodes, old_node_ids);
+
+	t_step = state.step_surface;
+	t_step_terminal = state.step_terminal;
+	t_data_collection_period_airborne = state.step_airborne;
+
+	checkpoint_reader_t in = {payload.data(), payload.size(), state.aircraft_arrays_pos, true};
+	visit_aircraft_arrays(in, checkpoint_array_reader(), num_flights);
+
+	for (int i = 0; i < num_flights; i++) {
+		const checkpoint_flight_t& flight = state.flights[i];
+
+		install_cstr(&h_aircraft_soa.runway_name_departing[i], flight.runway_name_departing);
+		install_cstr(&h_aircraft_soa.runway_name_landing[i], flight.runway_name_landing);
+
+		install_taxi_plan(flight.departing_taxi_plan, h_departing_taxi_plan, i);
+		install_taxi_plan(flight.landing_taxi_plan, h_landing_taxi_plan, i);
+
+		if (array_update_states_ptr[i] != NULL) {
+			if (array_update_states_ptr[i]->acid != NULL) {
+				free(array_update_states_ptr[i]->acid);
+			}
+			free(array_update_states_ptr[i]);
+			array_update_states_ptr[i] = NULL;
+		}
+
+		if (flight.has_update_states) {
+			update_states_t* update_states = (update_states_t*)calloc(1, sizeof(update_states_t));
+			memcpy(update_states, &flight.update_states, sizeof(update_states_t));
+
+			// Pointers in the raw copy belong to the saving process
+			update_states->acid = NULL;
+			install_cstr(&update_states->acid, flight.acid);
+
+			array_update_states_ptr[i] = update_states;
+		}
+	}
+
+	g_trajectories.swap(state.trajectories);
+
+	in.pos = state.globals_pos;
+	visit_simulation_globals(in, checkpoint_value_reader());
+
+	cdnr_oss_doc.str(state.cdnr_doc);
+	cdnr_oss_doc.seekp(0, ios_base::end);
+
+	vector_tactical_weather_waypoint.swap(state.weather_waypoints);
+
+	if (state.flag_random_deterministic) {
+		set_random_scenario_seed(state.random_seed);
+	} else {
+		clear_random_scenario_seed();
+	}
+
+	groundVehicleStates.swap(state.ground_vehicles);
+	groundVehiclePreviousStates = state.ground_vehicle_previous_states;
+	groundVehicleHistories.swap(state.ground_vehicle_histories);
+
+	vector<waypoint_node_t**> slots;
+	collect_waypoint_node_slots(num_flights, slots);
+
+	for (unsigned int i = 0; i < slots.size(); i++) {
+		const int node_id = state.slot_node_ids[i];
+
+		*slots[i] = (node_id < 0) ? NULL : state.nodes[node_id];
+	}
+
+	// The simulation owns the restored nodes now
+	state.nodes.clear();
+
+	// Drive plans are shared with g_groundVehicles, which frees them on
+	// release.  Hand the restored plans over when the vehicles match.
+	if (g_groundVehicles.size() == groundVehicleStates.size()) {
+		for (unsigned int i = 0; i < g_groundVehicles.size(); i++) {
+			if (g_groundVehicles.at(i).vehicle_id != groundVehicleStates.at(i).vehicle_id)
+				continue;
+
+			g_groundVehicles.at(i).drive_plan_ptr = groundVehicleStates.at(i).drive_plan_ptr;
+			g_groundVehicles.at(i).drive_plan_final_node_ptr = groundVehicleStates.at(i).drive_plan_final_node_ptr;
+		}
+	}
+
+	vector<waypoint_node_t**> kept_slots;
+	vector<waypoint_node_t*> kept_nodes;
+	map<waypoint_node_t*, int> kept_node_ids;
+
+	for (unsigned int i = 0; i < g_groundVehicles.size(); i++) {
+		kept_slots.push_back(&g_groundVehicles.at(i).drive_plan_ptr);
+		kept_slots.push_back(&g_groundVehicles.at(i).drive_plan_final_node_ptr);
+	}
+	number_waypoint_nodes(kept_slots, kept_nodes, kept_node_ids);
+
+	for (unsigned int i = 0; i < old_nodes.size(); i++) {
+		if (kept_node_ids.find(old_nodes[i]) != kept_node_ids.end())
+			continue;
+
+		releaseWaypointNodeContent(old_nodes[i]);
+		free(old_nodes[i]);
+	}
+}
+
+int apply_staged_simulation_checkpoint(float* const t_resume) {
+	string payload;
+
+	pthread_mutex_lock(&staged_checkpoint_mutex);
+	bool flag_staged = flag_staged_checkpoint;
+	payload.swap(staged_checkpoint_payload);
+	flag_staged_checkpoint = false;
+	pthread_mutex_unlock(&staged_checkpoint_mutex);
+
+	if (!flag_staged) {
+		return -1;
+	}
+
+	const int num_flights = get_num_flights();
+
+	checkpoint_state_t state;
+	if (!decode_checkpoint(payload, num_flights, state)) {
+		printf("Simulation checkpoint: Malformed checkpoint payload.  Simulation state is unchanged\n");
+
+		return -1;
+	}
+
+	install_checkpoint(payload, num_flights, state);
+
+	// Host positions were replaced; aircraft region queries must re-index
+	invalidate_aircraft_index();
+
+	*t_resume = state.t;
+
+	printf("Simulation checkpoint: Restored state at time = %f seconds\n", state.t);
+
+	return 0;
+}
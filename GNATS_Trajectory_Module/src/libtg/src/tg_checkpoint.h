@@ -0,0 +1,91 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_checkpoint.h
+ *
+ * Checkpoint and restore of a running simulation.
+ *
+ * A checkpoint is taken while the propagation is paused and captures the
+ * state the propagation loop needs to continue from that time step:
+ * aircraft SoA arrays, per-flight update states, the flight plan and taxi
+ * plan waypoint lists together with every pointer into them, pilot and
+ * controller error data, the human error models and CDNR status,
+ * tactical weather waypoints, ground vehicle states, ARTCC center
+ * tracking, live wake vortices, traffic metrics, the random scenario
+ * seed and the accumulated trajectories.
+ *
+ * Restore targets a freshly initialized process that loaded the same
+ * TRX/MFL input.  load_simulation_checkpoint() validates and stages the
+ * file.  The next propagate_flights() run applies it on top of the freshly
+ * initialized state and continues from the checkpoint time step.
+ *
+ * Files start with a magic string and a format version.  Readers reject
+ * versions and struct layouts they were not built for.
+ */
+
+#ifndef TG_CHECKPOINT_H_
+#define TG_CHECKPOINT_H_
+
+#include <string>
+
+using std::string;
+
+const unsigned int SIMULATION_CHECKPOINT_VERSION = 6;
+
+/*
+ * Write the current simulation state to a file.
+ *
+ * The propagation must be paused at a time step.  Returns 0 on success
+ * and -1 otherwise.
+ */
+int save_simulation_checkpoint(const string& path);
+
+/*
+ * Read and validate a checkpoint file and stage it for the next
+ * propagate_flights() run.  The loaded flights must match the checkpoint.
+ * Returns 0 on success and -1 otherwise.
+ */
+int load_simulation_checkpoint(const string& path);
+
+bool has_staged_simulation_checkpoint();
+
+void clear_staged_simulation_checkpoint();
+
+/*
+ * Apply the staged checkpoint.  Called by the propagation thread after it
+ * initialized its per-run state.  Time steps recorded in the checkpoint
+ * replace the current ones, and the waypoint nodes of the replaced state
+ * are freed.  Returns 0 and the time step to resume from in t_resume, or
+ * -1 when nothing is staged or the payload is malformed.  The payload is
+ * decoded completely before anything is installed, so the simulation
+ * state is unchanged when -1 is returned.
+ */
+int apply_staged_simulation_checkpoint(float* const t_resume);
+
+#endif
@@ -0,0 +1,508 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_ensemble.cpp
+ *
+ * Monte Carlo ensemble runner.  See tg_ensemble.h.
+ */
+
+#include "tg_ensemble.h"
+
+#include "tg_api.h"
+#include "tg_aircraft.h"
+#include "tg_random.h"
+#include "tg_rap.h"
+#include "tg_simulation.h"
+#include "tg_trajectory.h"
+
+#include "geometry_utils.h"
+#include "pub_logger.h"
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <thread>
+#include <utility>
+
+using namespace std;
+using namespace osi;
+
+// Loss of separation thresholds used for the per-flight conflict count
+static const double ENSEMBLE_SEPARATION_LATERAL_FT = 5 * 6076.12;
+static const double ENSEMBLE_SEPARATION_VERTICAL_FT = 1000;
+
+// Interval at which the runner checks for finished member workers
+static const int ENSEMBLE_POLL_INTERVAL_USEC = 20 * 1000;
+
+/*
+ * Result of one flight in one member, written by the member worker into
+ * the shared block.
+ */
+typedef struct _ensemble_flight_sample_t {
+	float arrival_time_sec; // NAN when the flight did not land
+	float departure_delay_sec;
+	int   conflict_count;
+} ensemble_flight_sample_t;
+
+typedef struct _ensemble_airborne_sample_t {
+	long  bucket;
+	float latitude_deg;
+	float longitude_deg;
+	float altitude_ft;
+	int   flight_index;
+} ensemble_airborne_sample_t;
+
+static bool compare_airborne_sample(const ensemble_airborne_sample_t& a, const ensemble_airborne_sample_t& b) {
+	if (a.bucket != b.bucket)
+		return a.bucket < b.bucket;
+
+	return a.latitude_deg < b.latitude_deg;
+}
+
+/*
+ * Add a bias per hourly table and altitude level to the wind uncertainty
+ * grids.  The grids are the member's private copy.
+ */
+static void perturb_member_wind(const ensemble_member_config_t& config) {
+	if ((config.wind_sigma_fps <= 0) || (h_wind_north_unc == NULL) || (h_wind_east_unc == NULL))
+		return;
+
+	const size_t lat_size = (int)1+(int)ceil(((double)g_lat_max - (double)g_lat_min) / (double)g_lat_step);
+	const size_t lon_size = (int)1+(int)ceil(((double)g_lon_max - (double)g_lon_min) / (double)g_lon_step);
+	const size_t alt_size = (int)1+(int)ceil(((double)g_alt_max - (double)g_alt_min) / (double)g_alt_step);
+	const size_t table_size = lat_size * lon_size * alt_size;
+	const int num_hours = ceil(g_horizon / 3600.);
+
+	vector<real_t> bias_north(alt_size);
+	vector<real_t> bias_east(alt_size);
+
+	for (int hour = 0; hour < num_hours; hour++) {
+		// One stream per hourly table and altitude level
+		for (size_t k = 0; k < alt_size; k++) {
+			const unsigned int stream_index = hour * alt_size + k;
+
+			bias_north[k] = (real_t)random_normal(RANDOM_COMPONENT_WIND, stream_index, 0, 0.0, config.wind_sigma_fps);
+			bias_east[k] = (real_t)random_normal(RANDOM_COMPONENT_WIND, stream_index, 1, 0.0, config.wind_sigma_fps);
+		}
+
+		// Grid layout follows get_ruc_index(): altitude varies fastest
+		const size_t offset = hour * table_size;
+		for (size_t cell = 0; cell < table_size; cell++) {
+			h_wind_north_unc[offset + cell] += bias_north[cell % alt_size];
+			h_wind_east_unc[offset + cell] += bias_east[cell % alt_size];
+		}
+	}
+}
+
+static void perturb_member_flights(const ensemble_member_config_t& config,
+		const float t_step_surface,
+		ensemble_flight_sample_t* const samples) {
+	const int num_flights = get_num_flights();
+
+	if ((config.departure_delay_mean_sec != 0) || (config.departure_delay_sigma_sec > 0)) {
+		for (int i = 0; i < num_flights; i++) {
+			double delay = (config.departure_delay_sigma_sec > 0) ?
+					random_normal(RANDOM_COMPONENT_DEPARTURE_DELAY, i, 0, config.departure_delay_mean_sec, config.departure_delay_sigma_sec)
+					: config.departure_delay_mean_sec;
+			if (delay < 0)
+				delay = 0;
+
+			// Departure is triggered by an exact comparison against the
+			// simulation time, so keep it on the surface time grid
+			delay = round(delay / t_step_surface) * t_step_surface;
+
+			h_aircraft_soa.departure_time_sec[i] += delay;
+			if (i < (int)g_trajectories.size()) {
+				g_trajectories.at(i).start_time += delay;
+			}
+
+			samples[i].departure_delay_sec = (float)delay;
+		}
+	}
+
+	if (config.cruise_tas_sigma_ratio > 0) {
+		for (int i = 0; i < num_flights; i++) {
+			double factor = random_normal(RANDOM_COMPONENT_CRUISE_TAS, i, 0, 1.0, config.cruise_tas_sigma_ratio);
+			factor = max(0.5, min(1.5, factor));
+
+			h_aircraft_soa.cruise_tas_knots[i] *= factor;
+		}
+	}
+}
+
+/*
+ * Count, for every flight, the distinct other flights it lost separation
+ * with while both were airborne.  Trajectory samples are matched within
+ * time buckets of the airborne data collection period.
+ */
+static void count_member_conflicts(const float bucket_sec, ensemble_flight_sample_t* const samples) {
+	vector<ensemble_airborne_sample_t> airborne;
+
+	for (unsigned int i = 0; i < g_trajectories.size(); i++) {
+		const Trajectory& trajectory = g_trajectories.at(i);
+
+		const unsigned int num_samples = min(trajectory.latitude_deg.size(), trajectory.flight_phase.size());
+
+		for (unsigned int j = 0; j < num_samples; j++) {
+			if (!isFlightPhase_in_airborne(trajectory.flight_phase.at(j)))
+				continue;
+
+			ensemble_airborne_sample_t sample;
+			sample.bucket = (long)floor(trajectory.timestamp.at(j) / bucket_sec);
+			sample.latitude_deg = trajectory.latitude_deg.at(j);
+			sample.longitude_deg = trajectory.longitude_deg.at(j);
+			sample.altitude_ft = trajectory.altitude_ft.at(j);
+			sample.flight_index = i;
+
+			airborne.push_back(sample);
+		}
+	}
+
+	sort(airborne.begin(), airborne.end(), compare_airborne_sample);
+
+	// Latitude window equivalent to the lateral separation
+	const double window_lat_deg = ENSEMBLE_SEPARATION_LATERAL_FT / RADIUS_EARTH_FT * 180.0 / M_PI;
+
+	vector< pair<int, int> > conflict_pairs;
+
+	for (size_t a = 0; a < airborne.size(); a++) {
+		for (size_t b = a+1; b < airborne.size(); b++) {
+			if ((airborne[b].bucket != airborne[a].bucket)
+					|| (airborne[b].latitude_deg - airborne[a].latitude_deg > window_lat_deg))
+				break;
+
+			if (airborne[b].flight_index == airborne[a].flight_index)
+				continue;
+
+			if (fabs(airborne[b].altitude_ft - airborne[a].altitude_ft) >= ENSEMBLE_SEPARATION_VERTICAL_FT)
+				continue;
+
+			if (compute_distance_gc(airborne[a].latitude_deg, airborne[a].longitude_deg,
+					airborne[b].latitude_deg, airborne[b].longitude_deg) >= ENSEMBLE_SEPARATION_LATERAL_FT)
+				continue;
+
+			conflict_pairs.push_back(make_pair(min(airborne[a].flight_index, airborne[b].flight_index),
+					max(airborne[a].flight_index, airborne[b].flight_index)));
+		}
+	}
+
+	sort(conflict_pairs.begin(), conflict_pairs.end());
+	conflict_pairs.erase(unique(conflict_pairs.begin(), conflict_pairs.end()), conflict_pairs.end());
+
+	const int num_flights = get_num_flights();
+	for (size_t p = 0; p < conflict_pairs.size(); p++) {
+		if (conflict_pairs[p].first < num_flights)
+			samples[conflict_pairs[p].first].conflict_count++;
+		if (conflict_pairs[p].second < num_flights)
+			samples[conflict_pairs[p].second].conflict_count++;
+	}
+}
+
+/*
+ * Body of a member worker.  Runs in the forked child process, on a
+ * thread started after fork().
+ */
+static int run_ensemble_member(const int member_index,
+		const ensemble_member_config_t& config,
+		const float t_horizon_sec,
+		const float t_step_surface,
+		const float t_step_terminal,
+		const float t_step_airborne,
+		ensemble_member_setup_fn member_setup,
+		ensemble_flight_sample_t* const samples) {
+	const int num_flights = get_num_flights();
+
+	for (int i = 0; i < num_flights; i++) {
+		samples[i].arrival_time_sec = NAN;
+		samples[i].departure_delay_sec = 0;
+		samples[i].conflict_count = 0;
+	}
+
+	// The member runs in its own process, so its seed does not leak into
+	// the caller
+	set_random_scenario_seed(config.seed);
+
+	perturb_member_wind(config);
+	perturb_member_flights(config, t_step_surface, samples);
+
+	if (member_setup != NULL) {
+		member_setup(member_index, config);
+	}
+
+	if (propagate_flights(t_horizon_sec, t_step_surface, t_step_terminal, t_step_airborne) != 0)
+		return -1;
+
+	nats_simulation_operator(NATS_SIMULATION_STATUS_START);
+
+	while (get_runtime_sim_status() != NATS_SIMULATION_STATUS_ENDED) {
+		usleep(nats_simulation_check_interval);
+	}
+
+	for (int i = 0; i < num_flights; i++) {
+		if ((h_aircraft_soa.flight_phase[i] == FLIGHT_PHASE_LANDED) && !(h_aircraft_soa.t_landing[i] < 0)) {
+			samples[i].arrival_time_sec = h_aircraft_soa.t_landing[i];
+		}
+	}
+
+	count_member_conflicts((t_step_airborne > 0) ? t_step_airborne : 1, samples);
+
+	if (!config.output_file.empty()) {
+		if (tg_write_trajectories(config.output_file, g_trajectories) != 0)
+			return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * Arguments and result of a member worker thread.
+ */
+typedef struct _ensemble_member_job_t {
+	int member_index;
+	const ensemble_member_config_t* config;
+	float t_horizon_sec;
+	float t_step_surface;
+	float t_step_terminal;
+	float t_step_airborne;
+	ensemble_member_setup_fn member_setup;
+	ensemble_flight_sample_t* samples;
+	int err;
+} ensemble_member_job_t;
+
+static void run_ensemble_member_proc(ensemble_member_job_t* const job) {
+	job->err = run_ensemble_member(job->member_index, *(job->config),
+			job->t_horizon_sec, job->t_step_surface, job->t_step_terminal, job->t_step_airborne,
+			job->member_setup,
+			job->samples);
+}
+
+static real_t compute_percentile(const vector<real_t>& sorted_values, const double p) {
+	if (sorted_values.empty())
+		return NAN;
+
+	const double pos = p * (sorted_values.size() - 1);
+	const size_t lo = (size_t)floor(pos);
+	const size_t hi = (size_t)ceil(pos);
+
+	return sorted_values[lo] + (real_t)(pos - lo) * (sorted_values[hi] - sorted_values[lo]);
+}
+
+static void reduce_ensemble_samples(const int num_members,
+		const int num_flights,
+		const int* const member_completed,
+		const ensemble_flight_sample_t* const samples,
+		vector<ensemble_flight_stats_t>& stats) {
+	stats.resize(num_flights);
+
+	vector<real_t> arrival_times;
+	arrival_times.reserve(num_members);
+
+	for (int i = 0; i < num_flights; i++) {
+		ensemble_flight_stats_t& flight_stats = stats[i];
+
+		flight_stats.callsign = (i < (int)g_trajectories.size()) ? g_trajectories.at(i).callsign : "";
+		flight_stats.member_count = 0;
+		flight_stats.landed_count = 0;
+		flight_stats.departure_delay_mean_sec = 0;
+		flight_stats.conflict_count_mean = 0;
+		flight_stats.conflict_count_max = 0;
+		flight_stats.conflict_member_count = 0;
+
+		arrival_times.clear();
+
+		for (int m = 0; m < num_members; m++) {
+			if (!member_completed[m])
+				continue;
+
+			const ensemble_flight_sample_t& sample = samples[(size_t)m * num_flights + i];
+
+			flight_stats.member_count++;
+			flight_stats.departure_delay_mean_sec += sample.departure_delay_sec;
+			flight_stats.conflict_count_mean += sample.conflict_count;
+			flight_stats.conflict_count_max = max(flight_stats.conflict_count_max, sample.conflict_count);
+			if (sample.conflict_count > 0)
+				flight_stats.conflict_member_count++;
+
+			if (!isnan(sample.arrival_time_sec))
+				arrival_times.push_back(sample.arrival_time_sec);
+		}
+
+		if (flight_stats.member_count > 0) {
+			flight_stats.departure_delay_mean_sec /= flight_stats.member_count;
+			flight_stats.conflict_count_mean /= flight_stats.member_count;
+		}
+
+		sort(arrival_times.begin(), arrival_times.end());
+
+		flight_stats.landed_count = arrival_times.size();
+		flight_stats.arrival_time_mean_sec = NAN;
+		if (!arrival_times.empty()) {
+			double sum = 0;
+			for (size_t k = 0; k < arrival_times.size(); k++)
+				sum += arrival_times[k];
+			flight_stats.arrival_time_mean_sec = sum / arrival_times.size();
+		}
+		flight_stats.arrival_time_p05_sec = compute_percentile(arrival_times, 0.05);
+		flight_stats.arrival_time_p50_sec = compute_percentile(arrival_times, 0.50);
+		flight_stats.arrival_time_p95_sec = compute_percentile(arrival_times, 0.95);
+	}
+}
+
+int tg_run_ensemble(const vector<ensemble_member_config_t>& members,
+		const float& t_horizon_sec,
+		const float& t_step_surface,
+		const float& t_step_terminal,
+		const float& t_step_airborne,
+		const int max_parallel,
+		vector<ensemble_flight_stats_t>& stats,
+		ensemble_member_setup_fn member_setup) {
+	stats.clear();
+
+#if USE_GPU
+	// Device contexts do not survive fork()
+	printf("Ensemble: Member workers are not supported in GPU builds.\n");
+	return -1;
+#endif
+
+	const int num_flights = get_num_flights();
+	const int num_members = members.size();
+
+	if (num_flights <= 0) {
+		printf("Ensemble: No flights loaded.\n");
+		return -1;
+	}
+
+	if (num_members == 0)
+		return 0;
+
+	if (t_step_surface <= 0) {
+		printf("Ensemble: Surface time step must be larger than zero.\n");
+		return -1;
+	}
+
+	// Completion flags followed by the [member][flight] sample matrix
+	const size_t flags_size = num_members * sizeof(int);
+	const size_t samples_offset = (flags_size + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+	const size_t shared_size = samples_offset + (size_t)num_members * num_flights * sizeof(ensemble_flight_sample_t);
+
+	void* shared_block = mmap(NULL, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shared_block == MAP_FAILED) {
+		printf("Ensemble: Failed to allocate shared result memory.\n");
+		return -1;
+	}
+
+	int* member_completed = (int*)shared_block;
+	ensemble_flight_sample_t* samples = (ensemble_flight_sample_t*)((char*)shared_block + samples_offset);
+
+	int num_parallel = max_parallel;
+	if (num_parallel <= 0) {
+		num_parallel = (int)sysconf(_SC_NPROCESSORS_ONLN);
+		if (num_parallel <= 0)
+			num_parallel = 1;
+	}
+
+	fflush(stdout);
+	fflush(stderr);
+
+	map<pid_t, int> running;
+
+	for (int m = 0; m < num_members; m++) {
+		while ((int)running.size() >= num_parallel) {
+			for (map<pid_t, int>::iterator ite = running.begin(); ite != running.end(); ) {
+				if (waitpid(ite->first, NULL, WNOHANG) == ite->first) {
+					running.erase(ite++);
+				} else {
+					ite++;
+				}
+			}
+
+			if ((int)running.size() >= num_parallel)
+				usleep(ENSEMBLE_POLL_INTERVAL_USEC);
+		}
+
+		pid_t pid = fork();
+		if (pid < 0) {
+			printf("Ensemble: Failed to start member %d.\n", m);
+			break;
+		}
+
+		if (pid == 0) {
+			ensemble_member_job_t job;
+			job.member_index = m;
+			job.config = &(members.at(m));
+			job.t_horizon_sec = t_horizon_sec;
+			job.t_step_surface = t_step_surface;
+			job.t_step_terminal = t_step_terminal;
+			job.t_step_airborne = t_step_airborne;
+			job.member_setup = member_setup;
+			job.samples = samples + (size_t)m * num_flights;
+			job.err = -1;
+
+			// The OpenMP thread team this thread started in tg_init() did not
+			// survive fork(), and libgomp would wait for it forever.  Run the
+			// member on a new thread so its parallel regions start a new team.
+			std::thread thread_member(run_ensemble_member_proc, &job);
+			thread_member.join();
+
+			if (job.err == 0)
+				member_completed[m] = 1;
+
+			// _exit() skips the atexit shutdown of the logger
+			logger_flush();
+
+			_exit((job.err == 0) ? 0 : 1);
+		}
+
+		running[pid] = m;
+	}
+
+	for (map<pid_t, int>::iterator ite = running.begin(); ite != running.end(); ite++) {
+		waitpid(ite->first, NULL, 0);
+	}
+
+	int num_completed = 0;
+	for (int m = 0; m < num_members; m++) {
+		if (member_completed[m])
+			num_completed++;
+		else
+			printf("Ensemble: Member %d did not complete.\n", m);
+	}
+
+	reduce_ensemble_samples(num_members, num_flights, member_completed, samples, stats);
+
+	munmap(shared_block, shared_size);
+
+	return num_completed;
+}
@@ -0,0 +1,144 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_ensemble.h
+ *
+ * Monte Carlo ensemble runner.
+ *
+ * The navigation data, aircraft performance tables, airport layouts, wind
+ * grids and the parsed TRX flights are loaded once by the caller through
+ * tg_init(), tg_load_rap() and tg_load_trx().  tg_run_ensemble() then runs
+ * every member simulation in a forked worker that inherits that state
+ * copy-on-write, applies the member's perturbations to its private copy
+ * and propagates it.  Static data is never reloaded and never written
+ * back, so members cannot observe each other.
+ *
+ * libgomp is not fork-safe: the OpenMP thread team of the calling thread
+ * does not exist in the child.  Each member therefore runs on a thread
+ * created after fork(), whose parallel regions start their own team.
+ * Member setup callbacks run on that thread as well and may use OpenMP.
+ *
+ * Member results are collected through a shared memory block and reduced
+ * into per-flight statistics in the calling process.  The calling process's
+ * own simulation state is left untouched.
+ */
+
+#ifndef TG_ENSEMBLE_H_
+#define TG_ENSEMBLE_H_
+
+#include "real_t.h"
+
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+/*
+ * Perturbation configuration of one ensemble member.
+ *
+ * All sigma values are one standard deviation of a zero-mean normal
+ * distribution.  A zero sigma disables that perturbation.
+ */
+typedef struct _ensemble_member_config_t {
+	// Scenario seed of the member.  Draws are made per flight from the
+	// streams in tg_random.h, so adding flights does not change the draws
+	// of the others.
+	unsigned long seed;
+
+	// Wind error.  One north and one east bias is drawn per hourly table
+	// and altitude level and added to the RAP uncertainty grids, which the
+	// propagation already sums into every wind lookup.
+	real_t wind_sigma_fps;
+
+	// Departure delay.  Negative draws are clipped to zero and the delay
+	// is rounded to the surface time step so departures stay on the
+	// simulation time grid.
+	real_t departure_delay_mean_sec;
+	real_t departure_delay_sigma_sec;
+
+	// Relative cruise true airspeed error, e.g. 0.02 for 2%
+	real_t cruise_tas_sigma_ratio;
+
+	// Trajectory output file of the member.  Empty string to skip.
+	string output_file;
+} ensemble_member_config_t;
+
+/*
+ * Optional hook run inside a member worker after the built-in
+ * perturbations were applied and before propagation starts.  Use it to
+ * install member specific pilot or controller error models.
+ */
+typedef void (*ensemble_member_setup_fn)(const int member_index, const ensemble_member_config_t& config);
+
+/*
+ * Per-flight result aggregated over the members that completed.
+ *
+ * Arrival statistics only include members in which the flight landed.
+ * A conflict is a distinct other flight that came within 5 nmi laterally
+ * and 1000 ft vertically while both were airborne.
+ */
+typedef struct _ensemble_flight_stats_t {
+	string callsign;
+
+	int member_count;
+	int landed_count;
+
+	real_t arrival_time_mean_sec;
+	real_t arrival_time_p05_sec;
+	real_t arrival_time_p50_sec;
+	real_t arrival_time_p95_sec;
+
+	real_t departure_delay_mean_sec;
+
+	real_t conflict_count_mean;
+	int    conflict_count_max;
+	int    conflict_member_count; // Members with at least one conflict
+} ensemble_flight_stats_t;
+
+/*
+ * Run the ensemble and reduce the member results.
+ *
+ * max_parallel limits the number of concurrent member workers; zero or
+ * less uses the number of processors.  The time step arguments follow
+ * propagate_flights().
+ *
+ * Returns the number of members that completed, or -1 when no flights
+ * are loaded or the build cannot fork member workers (GPU builds).
+ */
+int tg_run_ensemble(const vector<ensemble_member_config_t>& members,
+		const float& t_horizon_sec,
+		const float& t_step_surface,
+		const float& t_step_terminal,
+		const float& t_step_airborne,
+		const int max_parallel,
+		vector<ensemble_flight_stats_t>& stats,
+		ensemble_member_setup_fn member_setup = NULL);
+
+#endif
@@ -40,7 +40,11 @@ vector<GroundVehicle> g_groundVehicles;
 
 vector<GroundVehicle> groundVehicleStates;
 
-vector<GroundVehicle> groundVehiclePreviousStates;
+groundVehicle_previous_states_t groundVehiclePreviousStates;
+
+vector<groundVehicle_history_t> groundVehicleHistories;
+
+map<string, int> map_VehicleId_History;
 
 map<string, int> map_VehicleId_Seq;
 
@@ -223,3 +227,133 @@ int select_groundVehicleSeq_by_groundVehicleId(string gvid) {
 
 	return ret_GroundVehicleSeq;
 }
+
+int select_groundVehicleStateSeq(const string& gvid) {
+	int seq = select_groundVehicleSeq_by_groundVehicleId(gvid);
+	if ((seq > -1) && (seq < (int)groundVehicleStates.size()) && (groundVehicleStates.at(seq).vehicle_id == gvid))
+		return seq;
+
+	for (unsigned int i = 0; i < groundVehicleStates.size(); i++) {
+		if (groundVehicleStates.at(i).vehicle_id == gvid)
+			return i;
+	}
+
+	return -1;
+}
+
+void save_groundVehicle_previous_states() {
+	const unsigned int num_vehicles = groundVehicleStates.size();
+
+	groundVehiclePreviousStates.latitude.resize(num_vehicles);
+	groundVehiclePreviousStates.longitude.resize(num_vehicles);
+	groundVehiclePreviousStates.altitude.resize(num_vehicles);
+	groundVehiclePreviousStates.speed.resize(num_vehicles);
+	groundVehiclePreviousStates.course.resize(num_vehicles);
+
+	for (unsigned int i = 0; i < num_vehicles; i++) {
+		const GroundVehicle& vehicle = groundVehicleStates[i];
+
+		groundVehiclePreviousStates.latitude[i] = vehicle.latitude;
+		groundVehiclePreviousStates.longitude[i] = vehicle.longitude;
+		groundVehiclePreviousStates.altitude[i] = vehicle.altitude;
+		groundVehiclePreviousStates.speed[i] = vehicle.speed;
+		groundVehiclePreviousStates.course[i] = vehicle.course;
+	}
+}
+
+int get_groundVehicle_history(const string& vehicle_id) {
+	map<string, int>::iterator ite = map_VehicleId_History.find(vehicle_id);
+	if (ite != map_VehicleId_History.end())
+		return ite->second;
+
+	groundVehicle_history_t history;
+	history.vehicle_id = vehicle_id;
+
+	groundVehicleHistories.push_back(history);
+	map_VehicleId_History[vehicle_id] = groundVehicleHistories.size() - 1;
+
+	return groundVehicleHistories.size() - 1;
+}
+
+void record_groundVehicle_sample(groundVehicle_history_t& history,
+		const float time,
+		const string& aircraft_id,
+		const double latitude,
+		const double longitude,
+		const float altitude,
+		const float speed,
+		const float course) {
+	if (history.aircraft_ids.empty() || (history.aircraft_ids.back() != aircraft_id)) {
+		history.aircraft_ids.push_back(aircraft_id);
+	}
+
+	groundVehicle_sample_t sample;
+	sample.time = time;
+	sample.aircraft_id_index = history.aircraft_ids.size() - 1;
+	sample.latitude = latitude;
+	sample.longitude = longitude;
+	sample.altitude = altitude;
+	sample.speed = speed;
+	sample.course = course;
+
+	history.samples.push_back(sample);
+}
+
+int write_groundVehicle_histories(const string& filename) {
+	bool flag_has_samples = false;
+	for (unsigned int i = 0; i < groundVehicleHistories.size(); i++) {
+		if (!groundVehicleHistories.at(i).samples.empty()) {
+			flag_has_samples = true;
+			break;
+		}
+	}
+
+	if (!flag_has_samples)
+		return 0;
+
+	FILE* out = fopen(filename.c_str(), "w");
+	if (out == NULL) {
+		printf("Can't write ground vehicle file %s\n", filename.c_str());
+
+		return -1;
+	}
+
+	fprintf(out, "Header Format: \nGroundVehicle_ID\nTime,AircraftInService,Latitude,Longitude,Altitude,Speed,Heading\n\n");
+
+	// Same formatting as to_string()
+	map<string, int>::const_iterator ite;
+	for (ite = map_VehicleId_History.begin(); ite != map_VehicleId_History.end(); ++ite) {
+		const groundVehicle_history_t& history = groundVehicleHistories.at(ite->second);
+		if (history.samples.empty())
+			continue;
+
+		fprintf(out, "%s\n", history.vehicle_id.c_str());
+		for (unsigned int i = 0; i < history.samples.size(); i++) {
+			const groundVehicle_sample_t& sample = history.samples[i];
+
+			fprintf(out, "%f,%s,%f,%f,%f,%f,%f\n",
+					sample.time,
+					history.aircraft_ids.at(sample.aircraft_id_index).c_str(),
+					sample.latitude,
+					sample.longitude,
+					sample.altitude,
+					sample.speed,
+					sample.course);
+		}
+
+		fprintf(out, "\n");
+	}
+
+	fclose(out);
+
+	return 0;
+}
+
+void clear_groundVehicle_histories() {
+	groundVehicleHistories.clear();
+	map_VehicleId_History.clear();
+
+	for (unsigned int i = 0; i < groundVehicleStates.size(); i++) {
+		groundVehicleStates.at(i).history_index = -1;
+	}
+}
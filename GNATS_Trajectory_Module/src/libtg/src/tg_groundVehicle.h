@@ -41,6 +41,34 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 using namespace std;
 using namespace osi;
 
+// Kinematic state of the ground vehicles at the previous time step.
+// Arrays are indexed like groundVehicleStates.
+typedef struct _groundVehicle_previous_states_t {
+	vector<float> latitude;
+	vector<float> longitude;
+	vector<float> altitude;
+	vector<float> speed;
+	vector<float> course;
+} groundVehicle_previous_states_t;
+
+// One recorded ground vehicle state
+typedef struct _groundVehicle_sample_t {
+	float time;
+	int aircraft_id_index; // Index in the aircraft_ids of the history
+	double latitude;
+	double longitude;
+	float altitude;
+	float speed;
+	float course;
+} groundVehicle_sample_t;
+
+// Recorded states of one ground vehicle
+typedef struct _groundVehicle_history_t {
+	string vehicle_id;
+	vector<string> aircraft_ids; // Aircraft in service referenced by the samples
+	vector<groundVehicle_sample_t> samples;
+} groundVehicle_history_t;
+
 // Global variable to store TRX records of ground vehicles
 extern vector<TrxRecord_GroundVehicle> g_groundVehicleRecords;
 
@@ -51,7 +79,13 @@ extern vector<GroundVehicle> g_groundVehicles;
 extern vector<GroundVehicle> groundVehicleStates;
 
 // Global variable to store previous ground vehicle data during simulation
-extern vector<GroundVehicle> groundVehiclePreviousStates;
+extern groundVehicle_previous_states_t groundVehiclePreviousStates;
+
+// Recorded ground vehicle states to be written with the trajectories
+extern vector<groundVehicle_history_t> groundVehicleHistories;
+
+// Global data structure for mapping Vehicle ID to index of groundVehicleHistories
+extern map<string, int> map_VehicleId_History;
 
 // Global data structure for mapping Vehicle ID to vector index number of g_groundVehicles
 extern map<string, int> map_VehicleId_Seq;
@@ -65,4 +99,45 @@ int release_groundVehicle();
 
 int select_groundVehicleSeq_by_groundVehicleId(string gvid);
 
+/*
+ * Get the index of a vehicle in groundVehicleStates.  Vehicles injected
+ * during the simulation are not in map_VehicleId_Seq and are searched.
+ * Returns -1 if there is no such vehicle.
+ */
+int select_groundVehicleStateSeq(const string& gvid);
+
+/*
+ * Copy the kinematic state of all ground vehicles to
+ * groundVehiclePreviousStates.
+ */
+void save_groundVehicle_previous_states();
+
+/*
+ * Get the index of the history of a vehicle, creating it if needed.
+ */
+int get_groundVehicle_history(const string& vehicle_id);
+
+/*
+ * Append one sample to a history.
+ */
+void record_groundVehicle_sample(groundVehicle_history_t& history,
+		const float time,
+		const string& aircraft_id,
+		const double latitude,
+		const double longitude,
+		const float altitude,
+		const float speed,
+		const float course);
+
+/*
+ * Write the recorded histories to a CSV file, ordered by vehicle id.
+ * Nothing is written if no sample was recorded.
+ */
+int write_groundVehicle_histories(const string& filename);
+
+/*
+ * Clear the recorded histories.
+ */
+void clear_groundVehicle_histories();
+
 #endif
@@ -0,0 +1,271 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_kinematics.cpp
+ *
+ * Pairwise closest point of approach (CPA) between aircraft.
+ */
+
+#include "tg_kinematics.h"
+#include "tg_adb.h"
+#include "tg_aircraft.h"
+#include "tg_simulation.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Bits per axis of a packed grid cell key
+#define KINEMATICS_GRID_KEY_BITS 21
+
+typedef unsigned long long cell_key_t;
+
+static cell_key_t pack_cell_key(const long long& cx, const long long& cy, const long long& cz) {
+	const long long offset = 1LL << (KINEMATICS_GRID_KEY_BITS - 1);
+	const cell_key_t mask = (1ULL << KINEMATICS_GRID_KEY_BITS) - 1;
+
+	return (((cell_key_t)(cx + offset) & mask) << (2 * KINEMATICS_GRID_KEY_BITS))
+			| (((cell_key_t)(cy + offset) & mask) << KINEMATICS_GRID_KEY_BITS)
+			| ((cell_key_t)(cz + offset) & mask);
+}
+
+void compute_kinematic_state(const double& lat_deg,
+		const double& lon_deg,
+		const double& alt_ft,
+		const double& ground_speed_knots,
+		const double& course_rad,
+		const double& rocd_fps,
+		kinematic_state_t* const state) {
+	const double lat_rad = lat_deg * M_PI / 180.0;
+	const double lon_rad = lon_deg * M_PI / 180.0;
+	const double sin_lat = sin(lat_rad);
+	const double cos_lat = cos(lat_rad);
+	const double sin_lon = sin(lon_rad);
+	const double cos_lon = cos(lon_rad);
+
+	// Prime vertical radius of curvature
+	const double rn = SEMI_MAJOR_EARTH_FT / sqrt(1.0 - ECCENTRICITY_SQ_EARTH * sin_lat * sin_lat);
+
+	state->x = (rn + alt_ft) * cos_lat * cos_lon;
+	state->y = (rn + alt_ft) * cos_lat * sin_lon;
+	state->z = (rn * (1.0 - ECCENTRICITY_SQ_EARTH) + alt_ft) * sin_lat;
+
+	// Course is measured clockwise from true north
+	const double v_north = ground_speed_knots * KNOTS_TO_FPS * cos(course_rad);
+	const double v_east = ground_speed_knots * KNOTS_TO_FPS * sin(course_rad);
+
+	// Rotate the local east-north-up velocity into ECEF
+	state->vx = -sin_lon * v_east - sin_lat * cos_lon * v_north + cos_lat * cos_lon * rocd_fps;
+	state->vy = cos_lon * v_east - sin_lat * sin_lon * v_north + cos_lat * sin_lon * rocd_fps;
+	state->vz = cos_lat * v_north + sin_lat * rocd_fps;
+}
+
+void compute_cpa(const kinematic_state_t& state_1,
+		const kinematic_state_t& state_2,
+		cpa_result_t* const result) {
+	// Relative position and velocity of aircraft 2 seen from aircraft 1
+	const double rx = state_2.x - state_1.x;
+	const double ry = state_2.y - state_1.y;
+	const double rz = state_2.z - state_1.z;
+	const double vx = state_2.vx - state_1.vx;
+	const double vy = state_2.vy - state_1.vy;
+	const double vz = state_2.vz - state_1.vz;
+
+	const double rr = rx * rx + ry * ry + rz * rz;
+	const double rv = rx * vx + ry * vy + rz * vz;
+	const double vv = vx * vx + vy * vy + vz * vz;
+
+	result->range_ft = sqrt(rr);
+
+	// The range is minimized at t = -r.v / v.v.  A pair moving apart or
+	// holding the same relative position is at its CPA now.
+	result->t_cpa_sec = ((vv > 0.0) && (rv < 0.0)) ? (-rv / vv) : 0.0;
+
+	const double cx = rx + vx * result->t_cpa_sec;
+	const double cy = ry + vy * result->t_cpa_sec;
+	const double cz = rz + vz * result->t_cpa_sec;
+	result->d_cpa_ft = sqrt(cx * cx + cy * cy + cz * cz);
+
+	if (rr > 0.0) {
+		result->closure_rate_fps = -rv / result->range_ft;
+
+		// |r x v| / |r|^2
+		const double nx = ry * vz - rz * vy;
+		const double ny = rz * vx - rx * vz;
+		const double nz = rx * vy - ry * vx;
+		result->los_rate_rad_per_sec = sqrt(nx * nx + ny * ny + nz * nz) / rr;
+	} else {
+		result->closure_rate_fps = 0.0;
+		result->los_rate_rad_per_sec = 0.0;
+	}
+}
+
+bool is_flight_kinematically_active(const int& flight_index) {
+	if ((flight_index < 0) || (flight_index >= get_num_flights()))
+		return false;
+
+	const ENUM_Flight_Phase flight_phase = h_aircraft_soa.flight_phase[flight_index];
+
+	return (!h_aircraft_soa.landed_flag[flight_index])
+			&& (flight_phase != FLIGHT_PHASE_PREDEPARTURE)
+			&& (flight_phase != FLIGHT_PHASE_LANDED);
+}
+
+int get_flight_kinematic_state(const int& flight_index, kinematic_state_t* const state) {
+	if ((!state) || (flight_index < 0) || (flight_index >= get_num_flights()))
+		return -1;
+
+	compute_kinematic_state(h_aircraft_soa.latitude_deg[flight_index],
+			h_aircraft_soa.longitude_deg[flight_index],
+			h_aircraft_soa.altitude_ft[flight_index],
+			h_aircraft_soa.tas_knots_ground[flight_index],
+			h_aircraft_soa.course_rad[flight_index],
+			h_aircraft_soa.rocd_fps[flight_index],
+			state);
+
+	return 0;
+}
+
+int compute_flight_pair_cpa(const int& flight_index_1,
+		const int& flight_index_2,
+		cpa_result_t* const result) {
+	if (!result)
+		return -1;
+
+	kinematic_state_t state_1;
+	kinematic_state_t state_2;
+
+	if ((get_flight_kinematic_state(flight_index_1, &state_1) != 0)
+			|| (get_flight_kinematic_state(flight_index_2, &state_2) != 0))
+		return -1;
+
+	compute_cpa(state_1, state_2, result);
+	result->flight_index_1 = flight_index_1;
+	result->flight_index_2 = flight_index_2;
+
+	return 0;
+}
+
+static bool compare_cpa_result(const cpa_result_t& a, const cpa_result_t& b) {
+	if (a.flight_index_1 != b.flight_index_1)
+		return a.flight_index_1 < b.flight_index_1;
+
+	return a.flight_index_2 < b.flight_index_2;
+}
+
+int compute_cpa_within_radius(const double& radius_ft, vector<cpa_result_t>* const results) {
+	if ((!results) || (radius_ft <= 0))
+		return -1;
+
+	results->clear();
+
+	const int num_flights = get_num_flights();
+	const double cell_size = max(radius_ft, KINEMATICS_GRID_CELL_MIN_FT);
+	const double radius_sq = radius_ft * radius_ft;
+
+	// States and grid cells of the active flights
+	vector<kinematic_state_t> states(num_flights);
+	vector<long long> cell_x(num_flights), cell_y(num_flights), cell_z(num_flights);
+	vector<char> flag_active(num_flights, 0);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < num_flights; i++) {
+		if (!is_flight_kinematically_active(i))
+			continue;
+
+		flag_active[i] = 1;
+		get_flight_kinematic_state(i, &states[i]);
+		cell_x[i] = (long long)floor(states[i].x / cell_size);
+		cell_y[i] = (long long)floor(states[i].y / cell_size);
+		cell_z[i] = (long long)floor(states[i].z / cell_size);
+	}
+
+	// Active flights sorted by cell, so the members of a cell are contiguous
+	vector<pair<cell_key_t, int> > cells;
+	cells.reserve(num_flights);
+	for (int i = 0; i < num_flights; i++) {
+		if (flag_active[i]) {
+			cells.push_back(make_pair(pack_cell_key(cell_x[i], cell_y[i], cell_z[i]), i));
+		}
+	}
+
+	sort(cells.begin(), cells.end());
+
+	const int num_active = cells.size();
+	const int num_threads = omp_get_max_threads();
+	vector<vector<cpa_result_t> > thread_results(num_threads);
+
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int a = 0; a < num_active; a++) {
+		const int i = cells[a].second;
+		vector<cpa_result_t>& local_results = thread_results[omp_get_thread_num()];
+
+		// A pair is reported once, by its lower flight index
+		for (int dx = -1; dx <= 1; dx++) {
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dz = -1; dz <= 1; dz++) {
+					const cell_key_t key = pack_cell_key(cell_x[i] + dx, cell_y[i] + dy, cell_z[i] + dz);
+
+					vector<pair<cell_key_t, int> >::const_iterator ite = lower_bound(cells.begin(), cells.end(), make_pair(key, 0));
+					for (; (ite != cells.end()) && (ite->first == key); ++ite) {
+						const int j = ite->second;
+						if (j <= i)
+							continue;
+
+						const double rx = states[j].x - states[i].x;
+						const double ry = states[j].y - states[i].y;
+						const double rz = states[j].z - states[i].z;
+						if (rx * rx + ry * ry + rz * rz > radius_sq)
+							continue;
+
+						cpa_result_t result;
+						compute_cpa(states[i], states[j], &result);
+						result.flight_index_1 = i;
+						result.flight_index_2 = j;
+
+						local_results.push_back(result);
+					}
+				}
+			}
+		}
+	}
+
+	for (int t = 0; t < num_threads; t++) {
+		results->insert(results->end(), thread_results[t].begin(), thread_results[t].end());
+	}
+
+	sort(results->begin(), results->end(), compare_cpa_result);
+
+	return results->size();
+}
@@ -0,0 +1,109 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_kinematics.h
+ *
+ * Pairwise closest point of approach (CPA) between aircraft.
+ *
+ * States are taken from the host aircraft SoA arrays and converted to
+ * WGS-84 ECEF position and velocity, so ranges and rates are geodetically
+ * correct at any separation.  Both aircraft are assumed to hold their
+ * current ground velocity and vertical rate until the CPA.
+ *
+ * Units are feet and seconds throughout.
+ */
+
+#ifndef TG_KINEMATICS_H_
+#define TG_KINEMATICS_H_
+
+#include <vector>
+
+using std::vector;
+
+// Smallest grid cell of the batched pair search, ft.  Keeps the packed
+// cell keys in range for tiny search radii.
+#define KINEMATICS_GRID_CELL_MIN_FT 100.0
+
+typedef struct _kinematic_state_t {
+	// ECEF position, ft
+	double x;
+	double y;
+	double z;
+	// ECEF velocity, ft/sec
+	double vx;
+	double vy;
+	double vz;
+} kinematic_state_t;
+
+typedef struct _cpa_result_t {
+	int flight_index_1;
+	int flight_index_2;
+	double range_ft;             // current slant range
+	double t_cpa_sec;            // time to CPA, 0 when the pair is already diverging
+	double d_cpa_ft;             // slant range at the CPA
+	double closure_rate_fps;     // rate of decrease of the range, negative when diverging
+	double los_rate_rad_per_sec; // rotation rate of the line of sight
+} cpa_result_t;
+
+void compute_kinematic_state(const double& lat_deg,
+		const double& lon_deg,
+		const double& alt_ft,
+		const double& ground_speed_knots,
+		const double& course_rad,
+		const double& rocd_fps,
+		kinematic_state_t* const state);
+
+void compute_cpa(const kinematic_state_t& state_1,
+		const kinematic_state_t& state_2,
+		cpa_result_t* const result);
+
+/*
+ * Whether the flight currently has a position worth comparing: departed
+ * from the gate and not landed.
+ */
+bool is_flight_kinematically_active(const int& flight_index);
+
+int get_flight_kinematic_state(const int& flight_index, kinematic_state_t* const state);
+
+/*
+ * CPA between two flights.  Returns 0 on success and -1 when either
+ * flight index is invalid.
+ */
+int compute_flight_pair_cpa(const int& flight_index_1,
+		const int& flight_index_2,
+		cpa_result_t* const result);
+
+/*
+ * CPA of every pair of active flights currently within radius_ft slant
+ * range of each other.  Results are ordered by flight index pair.
+ * Returns the number of pairs or -1 on invalid input.
+ */
+int compute_cpa_within_radius(const double& radius_ft, vector<cpa_result_t>* const results);
+
+#endif /* TG_KINEMATICS_H_ */
@@ -0,0 +1,273 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_profiler.cpp
+ *
+ * Per-stage timers and counters of the flight propagation loop.  See
+ * tg_profiler.h.
+ */
+
+#include "tg_profiler.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sstream>
+
+using namespace std;
+
+bool flag_propagation_profiling = false;
+
+static const char* propagation_stage_names[PROPAGATION_STAGE_COUNT] = {
+	"Initialization",
+	"Trajectory recording",
+	"Meter fix",
+	"Tactical weather",
+	"Kernel stage 1",
+	"Sync device to host",
+	"External aircraft",
+	"Strategic weather",
+	"Ground vehicles",
+	"Kernel stage 2",
+	"Wake vortices",
+	"Traffic metrics",
+	"Risk measures",
+	"CDNR",
+	"Write back states",
+	"Pacing sleep",
+	"Paused"
+};
+
+static pthread_mutex_t mutex_propagation_profile = PTHREAD_MUTEX_INITIALIZER;
+
+// Run totals.  Guarded by mutex_propagation_profile.
+static propagation_profile_t run_profile;
+
+// Counters of the running time step.  Touched by the propagation thread only.
+static long long step_stage_ns[PROPAGATION_STAGE_COUNT];
+static long long step_stage_calls[PROPAGATION_STAGE_COUNT];
+static int step_flight_phase_count[ENUM_Flight_Phase_Count];
+static long long step_cdnr_pairs = 0;
+
+static void clear_step_counters() {
+	memset(step_stage_ns, 0, sizeof(step_stage_ns));
+	memset(step_stage_calls, 0, sizeof(step_stage_calls));
+	memset(step_flight_phase_count, 0, sizeof(step_flight_phase_count));
+	step_cdnr_pairs = 0;
+}
+
+const char* get_propagation_stage_name(const ENUM_Propagation_Stage stage) {
+	if ((stage < 0) || (PROPAGATION_STAGE_COUNT <= stage))
+		return "";
+
+	return propagation_stage_names[stage];
+}
+
+void set_propagation_profiling(const bool flag) {
+	flag_propagation_profiling = flag;
+}
+
+bool is_propagation_profiling() {
+	return flag_propagation_profiling;
+}
+
+void reset_propagation_profile() {
+	pthread_mutex_lock(&mutex_propagation_profile);
+
+	memset(&run_profile, 0, sizeof(propagation_profile_t));
+
+	pthread_mutex_unlock(&mutex_propagation_profile);
+}
+
+int get_propagation_profile(propagation_profile_t* const profile) {
+	if (profile == NULL)
+		return -1;
+
+	pthread_mutex_lock(&mutex_propagation_profile);
+
+	memcpy(profile, &run_profile, sizeof(propagation_profile_t));
+
+	pthread_mutex_unlock(&mutex_propagation_profile);
+
+	return 0;
+}
+
+void propagation_profile_add(const ENUM_Propagation_Stage stage, const long long elapsed_ns) {
+	step_stage_ns[stage] += elapsed_ns;
+	step_stage_calls[stage]++;
+}
+
+long long propagation_profile_begin_step() {
+	if (!flag_propagation_profiling)
+		return 0;
+
+	clear_step_counters();
+
+	return get_propagation_profile_clock_ns();
+}
+
+void propagation_profile_end_step(const long long t_step_begin_ns) {
+	if ((!flag_propagation_profiling) || (t_step_begin_ns <= 0))
+		return;
+
+	long long step_ns = get_propagation_profile_clock_ns() - t_step_begin_ns - step_stage_ns[PROPAGATION_STAGE_PAUSED];
+	if (step_ns < 0)
+		step_ns = 0;
+
+	pthread_mutex_lock(&mutex_propagation_profile);
+
+	run_profile.steps++;
+	run_profile.total_step_ns += step_ns;
+	run_profile.last_step_ns = step_ns;
+	if (run_profile.max_step_ns < step_ns)
+		run_profile.max_step_ns = step_ns;
+
+	for (int i = 0; i < PROPAGATION_STAGE_COUNT; i++) {
+		propagation_stage_profile_t* tmpStage = &run_profile.stage[i];
+
+		tmpStage->calls += step_stage_calls[i];
+		tmpStage->total_ns += step_stage_ns[i];
+		tmpStage->last_step_ns = step_stage_ns[i];
+		if (tmpStage->max_step_ns < step_stage_ns[i])
+			tmpStage->max_step_ns = step_stage_ns[i];
+	}
+
+	for (int i = 0; i < ENUM_Flight_Phase_Count; i++) {
+		run_profile.flight_phase_count_last_step[i] = step_flight_phase_count[i];
+		run_profile.flight_phase_count_total[i] += step_flight_phase_count[i];
+	}
+
+	run_profile.cdnr_pairs_last_step = step_cdnr_pairs;
+	run_profile.cdnr_pairs_total += step_cdnr_pairs;
+
+	pthread_mutex_unlock(&mutex_propagation_profile);
+}
+
+void propagation_profile_count_flight_phase(const ENUM_Flight_Phase flight_phase) {
+	if ((flight_phase < 0) || (ENUM_Flight_Phase_Count <= flight_phase))
+		return;
+
+	step_flight_phase_count[flight_phase]++;
+}
+
+void propagation_profile_count_cdnr_pairs(const long long cnt_pairs) {
+	if (!flag_propagation_profiling)
+		return;
+
+	step_cdnr_pairs += cnt_pairs;
+}
+
+static double ns_to_ms(const long long ns) {
+	return (double)ns / 1000000.0;
+}
+
+string get_propagation_profile_report() {
+	propagation_profile_t tmpProfile;
+	get_propagation_profile(&tmpProfile);
+
+	ostringstream oss;
+	char tmpLine[256];
+
+	if (tmpProfile.steps == 0) {
+		oss << "No propagation profile available.  Enable profiling before starting the simulation.\n";
+
+		return oss.str();
+	}
+
+	snprintf(tmpLine, sizeof(tmpLine), "Propagation profile: %lld time steps, %.3f ms total, %.3f ms mean, %.3f ms max per step (time paused excluded)\n",
+			tmpProfile.steps,
+			ns_to_ms(tmpProfile.total_step_ns),
+			ns_to_ms(tmpProfile.total_step_ns) / tmpProfile.steps,
+			ns_to_ms(tmpProfile.max_step_ns));
+	oss << tmpLine;
+
+	snprintf(tmpLine, sizeof(tmpLine), "%-22s %12s %12s %12s %12s %8s\n", "Stage", "Total(ms)", "Mean(ms)", "Max(ms)", "Last(ms)", "Share(%)");
+	oss << tmpLine;
+
+	long long sum_stage_ns = 0;
+
+	for (int i = 0; i < PROPAGATION_STAGE_COUNT; i++) {
+		const propagation_stage_profile_t& tmpStage = tmpProfile.stage[i];
+
+		if (i != PROPAGATION_STAGE_PAUSED)
+			sum_stage_ns += tmpStage.total_ns;
+
+		if (tmpStage.calls == 0)
+			continue;
+
+		snprintf(tmpLine, sizeof(tmpLine), "%-22s %12.3f %12.3f %12.3f %12.3f",
+				propagation_stage_names[i],
+				ns_to_ms(tmpStage.total_ns),
+				ns_to_ms(tmpStage.total_ns) / tmpProfile.steps,
+				ns_to_ms(tmpStage.max_step_ns),
+				ns_to_ms(tmpStage.last_step_ns));
+		oss << tmpLine;
+
+		// Time paused is not part of the step time
+		if (i == PROPAGATION_STAGE_PAUSED) {
+			snprintf(tmpLine, sizeof(tmpLine), " %8s\n", "-");
+		} else {
+			snprintf(tmpLine, sizeof(tmpLine), " %8.1f\n", (0 < tmpProfile.total_step_ns) ? (100.0 * tmpStage.total_ns / tmpProfile.total_step_ns) : 0.0);
+		}
+		oss << tmpLine;
+	}
+
+	long long other_ns = tmpProfile.total_step_ns - sum_stage_ns;
+	if (other_ns < 0)
+		other_ns = 0;
+
+	snprintf(tmpLine, sizeof(tmpLine), "%-22s %12.3f %12.3f %12s %12s %8.1f\n",
+			"Other",
+			ns_to_ms(other_ns),
+			ns_to_ms(other_ns) / tmpProfile.steps,
+			"-",
+			"-",
+			(0 < tmpProfile.total_step_ns) ? (100.0 * other_ns / tmpProfile.total_step_ns) : 0.0);
+	oss << tmpLine;
+
+	oss << "\nFlight phase counts (last step / flight-steps over the run)\n";
+	for (int i = 0; i < ENUM_Flight_Phase_Count; i++) {
+		if (tmpProfile.flight_phase_count_total[i] == 0)
+			continue;
+
+		snprintf(tmpLine, sizeof(tmpLine), "%-45s %8d %12lld\n",
+				ENUM_Flight_Phase_String[i],
+				tmpProfile.flight_phase_count_last_step[i],
+				tmpProfile.flight_phase_count_total[i]);
+		oss << tmpLine;
+	}
+
+	snprintf(tmpLine, sizeof(tmpLine), "\nCDNR aircraft pairs tested: %lld last step, %lld total\n",
+			tmpProfile.cdnr_pairs_last_step,
+			tmpProfile.cdnr_pairs_total);
+	oss << tmpLine;
+
+	return oss.str();
+}
@@ -0,0 +1,164 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_profiler.h
+ *
+ * Per-stage timers and counters of the flight propagation loop.
+ *
+ * Profiling is off by default.  When it is off, every hook reduces to a
+ * test of flag_propagation_profiling and no clock is read.
+ *
+ * Stage timers of the running time step are accumulated by the
+ * propagation thread only.  They are merged into the run totals once per
+ * step, under a mutex, so a report can be read from another thread.
+ */
+
+#ifndef TG_PROFILER_H_
+#define TG_PROFILER_H_
+
+#include "pub_trajectory.h"
+
+#include <time.h>
+
+#include <string>
+
+using std::string;
+
+typedef enum _ENUM_Propagation_Stage {
+	PROPAGATION_STAGE_INITIALIZATION = 0,
+	PROPAGATION_STAGE_TRAJECTORY_RECORDING,
+	PROPAGATION_STAGE_METER_FIX,
+	PROPAGATION_STAGE_TACTICAL_WEATHER,
+	PROPAGATION_STAGE_KERNEL_STAGE1,
+	PROPAGATION_STAGE_SYNC_D_TO_H,
+	PROPAGATION_STAGE_EXTERNAL_AIRCRAFT,
+	PROPAGATION_STAGE_STRATEGIC_WEATHER,
+	PROPAGATION_STAGE_GROUND_VEHICLE,
+	PROPAGATION_STAGE_KERNEL_STAGE2,
+	PROPAGATION_STAGE_WAKE_VORTEX,
+	PROPAGATION_STAGE_TRAFFIC_METRICS,
+	PROPAGATION_STAGE_RISK_MEASURES,
+	PROPAGATION_STAGE_CDNR,
+	PROPAGATION_STAGE_WRITE_BACK,
+	PROPAGATION_STAGE_PACING_SLEEP,
+	PROPAGATION_STAGE_PAUSED,
+	PROPAGATION_STAGE_COUNT
+} ENUM_Propagation_Stage;
+
+typedef struct _propagation_stage_profile_t {
+	long long calls;
+	long long total_ns;
+	long long max_step_ns;
+	long long last_step_ns;
+} propagation_stage_profile_t;
+
+typedef struct _propagation_profile_t {
+	// Number of completed time steps
+	long long steps;
+
+	// Wall time of the time steps, excluding the time paused
+	long long total_step_ns;
+	long long max_step_ns;
+	long long last_step_ns;
+
+	propagation_stage_profile_t stage[PROPAGATION_STAGE_COUNT];
+
+	// Number of flights in each flight phase at the end of the last step
+	int flight_phase_count_last_step[ENUM_Flight_Phase_Count];
+
+	// Sum of the flights in each flight phase over all steps
+	long long flight_phase_count_total[ENUM_Flight_Phase_Count];
+
+	long long cdnr_pairs_last_step;
+	long long cdnr_pairs_total;
+} propagation_profile_t;
+
+extern bool flag_propagation_profiling;
+
+const char* get_propagation_stage_name(const ENUM_Propagation_Stage stage);
+
+void set_propagation_profiling(const bool flag);
+
+bool is_propagation_profiling();
+
+/*
+ * Clear the totals of the last run
+ */
+void reset_propagation_profile();
+
+/*
+ * Copy the run totals
+ */
+int get_propagation_profile(propagation_profile_t* const profile);
+
+/*
+ * Human-readable report of the run totals
+ */
+string get_propagation_profile_report();
+
+inline long long get_propagation_profile_clock_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/*
+ * Start a stage timer.  Returns 0 when profiling is off.
+ */
+inline long long propagation_profile_begin() {
+	return flag_propagation_profiling ? get_propagation_profile_clock_ns() : 0;
+}
+
+void propagation_profile_add(const ENUM_Propagation_Stage stage, const long long elapsed_ns);
+
+/*
+ * Stop a stage timer started by propagation_profile_begin()
+ */
+inline void propagation_profile_end(const ENUM_Propagation_Stage stage, const long long t_begin_ns) {
+	if (flag_propagation_profiling && (0 < t_begin_ns)) {
+		propagation_profile_add(stage, get_propagation_profile_clock_ns() - t_begin_ns);
+	}
+}
+
+/*
+ * Start a time step.  Returns 0 when profiling is off.
+ */
+long long propagation_profile_begin_step();
+
+/*
+ * Merge the counters of the time step into the run totals
+ */
+void propagation_profile_end_step(const long long t_step_begin_ns);
+
+void propagation_profile_count_flight_phase(const ENUM_Flight_Phase flight_phase);
+
+void propagation_profile_count_cdnr_pairs(const long long cnt_pairs);
+
+#endif
@@ -0,0 +1,177 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_random.cpp
+ *
+ * Counter-based random number streams.  See tg_random.h.
+ *
+ * The generator is Philox4x32-10 (Salmon et al., "Parallel random numbers:
+ * as easy as 1, 2, 3", SC 2011).  The key is the scenario seed.  The
+ * counter holds the draw counter, the stream index and the component.
+ */
+
+#include "tg_random.h"
+
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cmath>
+
+using namespace std;
+
+static const unsigned int PHILOX_M0 = 0xD2511F53;
+static const unsigned int PHILOX_M1 = 0xCD9E8D57;
+static const unsigned int PHILOX_W0 = 0x9E3779B9;
+static const unsigned int PHILOX_W1 = 0xBB67AE85;
+static const int PHILOX_ROUNDS = 10;
+
+static bool flag_deterministic_mode = false;
+static unsigned long long scenario_seed = 0;
+static bool flag_scenario_seed_chosen = false;
+
+static void choose_process_seed() {
+	timeval tv;
+	gettimeofday(&tv, NULL);
+
+	scenario_seed = ((unsigned long long)tv.tv_sec << 20) ^ (unsigned long long)tv.tv_usec ^ ((unsigned long long)getpid() << 40);
+	flag_scenario_seed_chosen = true;
+}
+
+static void philox4x32(const unsigned int counter[4], const unsigned long long seed, unsigned int out[4]) {
+	unsigned int c0 = counter[0];
+	unsigned int c1 = counter[1];
+	unsigned int c2 = counter[2];
+	unsigned int c3 = counter[3];
+
+	unsigned int k0 = (unsigned int)(seed & 0xFFFFFFFFULL);
+	unsigned int k1 = (unsigned int)(seed >> 32);
+
+	for (int round = 0; round < PHILOX_ROUNDS; round++) {
+		if (round > 0) {
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+
+		const unsigned long long product0 = (unsigned long long)PHILOX_M0 * c0;
+		const unsigned long long product1 = (unsigned long long)PHILOX_M1 * c2;
+
+		const unsigned int hi0 = (unsigned int)(product0 >> 32);
+		const unsigned int lo0 = (unsigned int)product0;
+		const unsigned int hi1 = (unsigned int)(product1 >> 32);
+		const unsigned int lo1 = (unsigned int)product1;
+
+		c0 = hi1 ^ c1 ^ k0;
+		c1 = lo1;
+		c2 = hi0 ^ c3 ^ k1;
+		c3 = lo0;
+	}
+
+	out[0] = c0;
+	out[1] = c1;
+	out[2] = c2;
+	out[3] = c3;
+}
+
+static void random_block(const ENUM_Random_Component component,
+		const unsigned int stream_index,
+		const unsigned long long counter,
+		unsigned long long* const word0,
+		unsigned long long* const word1) {
+	if (!flag_scenario_seed_chosen) {
+		choose_process_seed();
+	}
+
+	const unsigned int ctr[4] = {(unsigned int)(counter & 0xFFFFFFFFULL),
+			(unsigned int)(counter >> 32),
+			stream_index,
+			(unsigned int)component};
+	unsigned int out[4];
+
+	philox4x32(ctr, scenario_seed, out);
+
+	*word0 = ((unsigned long long)out[0] << 32) | out[1];
+	*word1 = ((unsigned long long)out[2] << 32) | out[3];
+}
+
+// 53 significant bits, the precision of a double
+static double to_unit_interval(const unsigned long long word) {
+	return (word >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void set_random_scenario_seed(const unsigned long long seed) {
+	scenario_seed = seed;
+	flag_scenario_seed_chosen = true;
+	flag_deterministic_mode = true;
+}
+
+void clear_random_scenario_seed() {
+	flag_deterministic_mode = false;
+
+	choose_process_seed();
+}
+
+bool is_random_deterministic_mode() {
+	return flag_deterministic_mode;
+}
+
+unsigned long long get_random_scenario_seed() {
+	if (!flag_scenario_seed_chosen) {
+		choose_process_seed();
+	}
+
+	return scenario_seed;
+}
+
+double random_uniform(const ENUM_Random_Component component,
+		const unsigned int stream_index,
+		const unsigned long long counter) {
+	unsigned long long word0;
+	unsigned long long word1;
+
+	random_block(component, stream_index, counter, &word0, &word1);
+
+	return to_unit_interval(word0);
+}
+
+double random_normal(const ENUM_Random_Component component,
+		const unsigned int stream_index,
+		const unsigned long long counter,
+		const double mean,
+		const double sigma) {
+	unsigned long long word0;
+	unsigned long long word1;
+
+	random_block(component, stream_index, counter, &word0, &word1);
+
+	// Box-Muller.  u1 lies in (0, 1] so the logarithm stays finite.
+	const double u1 = 1.0 - to_unit_interval(word0);
+	const double u2 = to_unit_interval(word1);
+
+	return mean + sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
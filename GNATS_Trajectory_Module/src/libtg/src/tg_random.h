@@ -0,0 +1,83 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_random.h
+ *
+ * Counter-based random number streams.
+ *
+ * Every draw is a pure function of the scenario seed, the component
+ * drawing it, a stream index (usually the flight index) and a counter.
+ * Results therefore do not depend on the number of threads or on the
+ * order in which flights are processed.
+ *
+ * In deterministic mode the scenario seed is set by the user.  Otherwise
+ * a seed is chosen once per process.
+ */
+
+#ifndef TG_RANDOM_H_
+#define TG_RANDOM_H_
+
+typedef enum _ENUM_Random_Component {
+	RANDOM_COMPONENT_WIND = 1,
+	RANDOM_COMPONENT_DEPARTURE_DELAY = 2,
+	RANDOM_COMPONENT_CRUISE_TAS = 3,
+	RANDOM_COMPONENT_TRAFFIC_GENERATOR = 4
+} ENUM_Random_Component;
+
+/*
+ * Enable deterministic mode with the given scenario seed.
+ */
+void set_random_scenario_seed(const unsigned long long seed);
+
+/*
+ * Leave deterministic mode.  A new process-wide seed is chosen.
+ */
+void clear_random_scenario_seed();
+
+bool is_random_deterministic_mode();
+
+unsigned long long get_random_scenario_seed();
+
+/*
+ * Uniform value in [0, 1)
+ */
+double random_uniform(const ENUM_Random_Component component,
+		const unsigned int stream_index,
+		const unsigned long long counter);
+
+/*
+ * Normally distributed value
+ */
+double random_normal(const ENUM_Random_Component component,
+		const unsigned int stream_index,
+		const unsigned long long counter,
+		const double mean,
+		const double sigma);
+
+#endif
@@ -28,9 +28,21 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 
 #include "tg_riskMeasures.h"
 
+#include "AirportLayoutDataLoader.h"
+#include "tg_aircraft.h"
+#include "tg_airports.h"
+#include "tg_flightplan.h"
+#include "tg_simulation.h"
+#include "tg_wake.h"
+
 #include "util_string.h"
 
+#include <omp.h>
+
+#include <cmath>
 #include <fstream>
+#include <map>
+#include <vector>
 #include <dirent.h>
 
 #include <stdio.h>
@@ -326,3 +338,267 @@ int load_flightphase_aviationOccurence_mapping(const char* dirPath) {
 
 	return 0;
 }
+
+// ============================================================================
+// Batched aviation occurrence checks
+// ============================================================================
+
+const char* RISK_AOC_CODES[RISK_AOC_COUNT] = {
+	"GCOL", "MAC", "WAKE", "WSTRW", "CFIT", "TE", "RE", "RI", "OS", "CTOL", "TI", "US", "ML"
+};
+
+// Batches smaller than this are evaluated on the calling thread
+#define RISK_MIN_PARALLEL_BATCH 64
+
+typedef struct _risk_runway_target_t {
+	bool valid;
+
+	// [0] runway entry node, [1] runway end node, as returned by getRunwayEnds()
+	double latitude_deg[2];
+	double longitude_deg[2];
+
+	double airport_elevation_ft;
+} risk_runway_target_t;
+
+bool is_pairwise_risk_aoc(const ENUM_Risk_AOC aoc) {
+	return (aoc == RISK_AOC_GCOL) || (aoc == RISK_AOC_MAC) || (aoc == RISK_AOC_WAKE) || (aoc == RISK_AOC_RI);
+}
+
+/*
+ * Slant distance in statute miles: haversine ground distance on a 6371 km
+ * sphere combined with the altitude difference.  Same formula as
+ * CEngine calculateDistance().
+ */
+static inline double risk_distance_miles(const double lat1, const double lon1, const double alt1,
+		const double lat2, const double lon2, const double alt2) {
+	int R = 6371;
+	double latDistance, lonDistance, a, c, distance, altDiff;
+
+	latDistance = (lat2 - lat1) * M_PI / 180.;
+	lonDistance = (lon2 - lon1) * M_PI / 180.;
+	a = sin(latDistance / 2) * sin(latDistance / 2)
+			+ cos(lat1 * M_PI / 180.) * cos(lat2 * M_PI / 180.)
+			* sin(lonDistance / 2) * sin(lonDistance / 2);
+	c = 2 * atan2(sqrt(a), sqrt(1 - a));
+	distance = R * c * 1000; // Kilometer to meters
+
+	altDiff = (alt1 - alt2) * 0.3048; // Feet to meters
+	distance = pow(distance, 2) + pow(altDiff, 2);
+
+	return sqrt(distance) * 0.00062137;
+}
+
+static inline double risk_time_to_go_sec(const double distance_miles, const double speed_knots) {
+	return (distance_miles * 1609.34) / (speed_knots * 0.514444);
+}
+
+/*
+ * The phase windows of the original string protocol were written as chained
+ * comparisons (e.g. "6 < phase < 10"), which evaluate left to right to a 0/1
+ * value compared against the outer bound.  These helpers keep that result so
+ * calculateRisk() output does not change.
+ */
+static inline bool legacy_phase_window_lt(const int lower, const int phase, const int upper) {
+	return (lower < phase) < upper;
+}
+
+static inline bool legacy_phase_window_gt(const int upper, const int phase, const int lower) {
+	return (upper > phase) > lower;
+}
+
+/*
+ * Locate the arrival runway entry/end nodes of a flight the same way
+ * calculateRisk() did through getArrivalRunway(), getArrivalAirport(),
+ * getRunwayEnds() and getLayout_node_data().
+ */
+static risk_runway_target_t resolve_risk_runway_target(const int flight_seq) {
+	risk_runway_target_t target;
+	target.valid = false;
+
+	if ((flight_seq < 0) || (flight_seq >= get_num_flights()))
+		return target;
+
+	if ((h_landing_taxi_plan.runway_name == NULL) || (h_landing_taxi_plan.runway_name[flight_seq] == NULL))
+		return target;
+
+	map<int, FlightPlan>::const_iterator ite_fp = g_flightplans.find(flight_seq);
+	if (ite_fp == g_flightplans.end())
+		return target;
+
+	string airport_code = ite_fp->second.destination;
+	if (airport_code.length() < 4) {
+		if ((airport_code.find("ANC") != string::npos) || (airport_code.find("HNL") != string::npos)) {
+			airport_code.insert(0, "P");
+		} else {
+			airport_code.insert(0, "K");
+		}
+	}
+
+	pair<string, string> runway_ends = getRunwayEnds(airport_code, string(h_landing_taxi_plan.runway_name[flight_seq]));
+	if ((runway_ends.first == "") || (runway_ends.second == ""))
+		return target;
+
+	map<string, GroundWaypointConnectivity>::const_iterator ite_conn = map_ground_waypoint_connectivity.find(airport_code);
+	if (ite_conn == map_ground_waypoint_connectivity.end())
+		return target;
+
+	const string end_ids[2] = {runway_ends.first, runway_ends.second};
+	for (int k = 0; k < 2; k++) {
+		bool flag_found = false;
+
+		// First node carrying the id, in layout map order
+		map<string, AirportNode>::const_iterator ite_node;
+		for (ite_node = ite_conn->second.map_waypoint_node.begin(); ite_node != ite_conn->second.map_waypoint_node.end(); ite_node++) {
+			if (ite_node->second.id == end_ids[k]) {
+				// Layout node positions were exchanged as text with 6 decimals
+				target.latitude_deg[k] = stod(to_string(ite_node->second.latitude));
+				target.longitude_deg[k] = stod(to_string(ite_node->second.longitude));
+				flag_found = true;
+				break;
+			}
+		}
+
+		if (!flag_found)
+			return target;
+	}
+
+	target.airport_elevation_ft = get_airport_elevation(airport_code);
+	target.valid = true;
+
+	return target;
+}
+
+static inline void set_risk_aoc(risk_result_t& result, const ENUM_Risk_AOC aoc, const double time_to_go_sec) {
+	result.aoc_flags |= (1u << aoc);
+	result.time_to_go_sec[aoc] = time_to_go_sec;
+}
+
+static void evaluate_risk_case(const risk_case_t& riskCase,
+		const risk_runway_target_t* runwayTarget,
+		const vector<double>& weather,
+		risk_result_t& result) {
+	const risk_state_t& f1 = riskCase.aircraft1;
+	const risk_state_t& f2 = riskCase.aircraft2;
+	const int phase1 = f1.flight_phase;
+	const int phase2 = f2.flight_phase;
+
+	double distanceToGo, timeToGo;
+
+	result.aoc_flags = 0;
+	for (int k = 0; k < RISK_AOC_COUNT; k++) {
+		result.time_to_go_sec[k] = NAN;
+	}
+
+	if (riskCase.flag_pair) {
+		distanceToGo = risk_distance_miles(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft, f2.latitude_deg, f2.longitude_deg, f2.altitude_ft);
+		timeToGo = risk_time_to_go_sec(distanceToGo, f1.speed_knots);
+
+		if (distanceToGo < 0.1) {
+			set_risk_aoc(result, RISK_AOC_GCOL, timeToGo);
+		}
+
+		if ((distanceToGo < 3) && (phase1 > 6)) {
+			set_risk_aoc(result, RISK_AOC_MAC, timeToGo);
+		}
+
+		if (flag_enable_wake_vortex_model) {
+			// Aircraft 1 is inside a live wake segment shed by aircraft 2
+			if ((f2.flight_seq > -1) && (get_wake_encounter_generator(f1.flight_seq) == f2.flight_seq)) {
+				set_risk_aoc(result, RISK_AOC_WAKE, 0);
+			}
+		} else if ((truncf(f1.course * 10) / 10 == truncf(f2.course * 10) / 10) && (distanceToGo < 3)
+				&& legacy_phase_window_lt(6, phase1, 10) && legacy_phase_window_lt(6, phase2, 10)) {
+			set_risk_aoc(result, RISK_AOC_WAKE, timeToGo);
+		}
+	}
+
+	if (weather.size() > 4) {
+		distanceToGo = risk_distance_miles(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft, weather.at(0), weather.at(1), weather.at(4));
+		timeToGo = risk_time_to_go_sec(distanceToGo, f1.speed_knots);
+		if ((distanceToGo < 4.7) && (phase1 > 6)) {
+			set_risk_aoc(result, RISK_AOC_WSTRW, timeToGo);
+		}
+	}
+
+	distanceToGo = risk_distance_miles(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft, f1.latitude_deg, f1.longitude_deg, 0.0);
+	timeToGo = risk_time_to_go_sec(distanceToGo, f1.speed_knots);
+	if ((distanceToGo < 4.7) && legacy_phase_window_gt(21, phase1, 6)) {
+		set_risk_aoc(result, RISK_AOC_CFIT, timeToGo);
+	}
+
+	// TE and RE measure against the same offset point
+	distanceToGo = risk_distance_miles(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft,
+			f1.latitude_deg + (sin(1 / (f1.latitude_deg * M_PI / 180.0))),
+			f1.longitude_deg + (sin(1 / (f1.longitude_deg * M_PI / 180.0))),
+			f1.altitude_ft);
+	timeToGo = risk_time_to_go_sec(distanceToGo, f1.speed_knots);
+	if ((distanceToGo < 86.52) && (legacy_phase_window_gt(22, phase1, 19) || legacy_phase_window_gt(4, phase1, 1))) {
+		set_risk_aoc(result, RISK_AOC_TE, timeToGo);
+	}
+	if ((distanceToGo < 86.52) && (legacy_phase_window_gt(20, phase1, 17) || legacy_phase_window_gt(6, phase1, 3))) {
+		set_risk_aoc(result, RISK_AOC_RE, timeToGo);
+	}
+
+	if (riskCase.flag_pair) {
+		distanceToGo = risk_distance_miles(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft, f2.latitude_deg, f2.longitude_deg, f2.altitude_ft);
+		timeToGo = risk_time_to_go_sec(distanceToGo, f1.speed_knots);
+		if (distanceToGo < .375) {
+			set_risk_aoc(result, RISK_AOC_RI, timeToGo);
+		}
+	}
+
+	if ((runwayTarget == NULL) || (!runwayTarget->valid))
+		return;
+
+	// OS measures to the runway end node, the others to the runway entry node
+	distanceToGo = risk_distance_miles(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft,
+			runwayTarget->latitude_deg[1], runwayTarget->longitude_deg[1], runwayTarget->airport_elevation_ft);
+	timeToGo = risk_time_to_go_sec(distanceToGo, f1.speed_knots);
+	if ((distanceToGo < .52) && (legacy_phase_window_gt(20, phase1, 17) || legacy_phase_window_gt(6, phase1, 3))) {
+		set_risk_aoc(result, RISK_AOC_OS, timeToGo);
+	}
+
+	distanceToGo = risk_distance_miles(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft,
+			runwayTarget->latitude_deg[0], runwayTarget->longitude_deg[0], runwayTarget->airport_elevation_ft);
+	timeToGo = risk_time_to_go_sec(distanceToGo, f1.speed_knots);
+	if ((distanceToGo < 649.34) && (7 > phase1)) {
+		set_risk_aoc(result, RISK_AOC_CTOL, timeToGo);
+	}
+	if ((distanceToGo > .6) && (18 < phase1)) {
+		set_risk_aoc(result, RISK_AOC_TI, timeToGo);
+		set_risk_aoc(result, RISK_AOC_US, timeToGo);
+		set_risk_aoc(result, RISK_AOC_ML, timeToGo);
+	}
+}
+
+int calculate_risk_batch(const int count, const risk_case_t* cases, risk_result_t* results) {
+	if ((count < 0) || ((count > 0) && ((cases == NULL) || (results == NULL))))
+		return -1;
+
+	// Runway geometry comes from shared lookup tables; resolve it once per
+	// flight before the parallel section
+	map<int, int> map_flightSeq_target;
+	vector<risk_runway_target_t> runwayTargets;
+	vector<int> caseTarget(count, -1);
+
+	for (int i = 0; i < count; i++) {
+		const int flight_seq = cases[i].aircraft1.flight_seq;
+
+		map<int, int>::iterator ite = map_flightSeq_target.find(flight_seq);
+		if (ite == map_flightSeq_target.end()) {
+			ite = map_flightSeq_target.insert(pair<int, int>(flight_seq, runwayTargets.size())).first;
+			runwayTargets.push_back(resolve_risk_runway_target(flight_seq));
+		}
+
+		caseTarget[i] = ite->second;
+	}
+
+	const vector<double> weather(weatherSample);
+
+#pragma omp parallel for schedule(static) if (count >= RISK_MIN_PARALLEL_BATCH)
+	for (int i = 0; i < count; i++) {
+		evaluate_risk_case(cases[i], &runwayTargets[caseTarget[i]], weather, results[i]);
+	}
+
+	return 0;
+}
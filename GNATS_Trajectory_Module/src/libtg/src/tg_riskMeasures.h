@@ -70,4 +70,63 @@ int load_aviationOccurenceProfile(const char* dirPath);
 
 int load_flightphase_aviationOccurence_mapping(const char* dirPath);
 
+/*
+ * Aviation occurrence categories evaluated by calculate_risk_batch().
+ * The order matches the order in which calculateRisk() reports them.
+ */
+typedef enum _ENUM_Risk_AOC {
+	RISK_AOC_GCOL = 0,
+	RISK_AOC_MAC,
+	RISK_AOC_WAKE,
+	RISK_AOC_WSTRW,
+	RISK_AOC_CFIT,
+	RISK_AOC_TE,
+	RISK_AOC_RE,
+	RISK_AOC_RI,
+	RISK_AOC_OS,
+	RISK_AOC_CTOL,
+	RISK_AOC_TI,
+	RISK_AOC_US,
+	RISK_AOC_ML,
+	RISK_AOC_COUNT
+} ENUM_Risk_AOC;
+
+extern const char* RISK_AOC_CODES[RISK_AOC_COUNT];
+
+// Occurrences involving both aircraft of a risk case
+bool is_pairwise_risk_aoc(const ENUM_Risk_AOC aoc);
+
+typedef struct _risk_state_t {
+	double latitude_deg;
+	double longitude_deg;
+	double altitude_ft;
+	double course;
+	double speed_knots;
+	double rocd_fps;
+	int flight_phase;
+	int flight_seq; // Used to look up the arrival runway and wake encounters.  -1 if unknown.
+} risk_state_t;
+
+typedef struct _risk_case_t {
+	risk_state_t aircraft1;
+	risk_state_t aircraft2; // Only used when flag_pair is set
+	bool flag_pair;
+} risk_case_t;
+
+typedef struct _risk_result_t {
+	unsigned int aoc_flags; // Bit (1 << ENUM_Risk_AOC) is set for every detected occurrence
+	double time_to_go_sec[RISK_AOC_COUNT];
+} risk_result_t;
+
+/*
+ * Evaluate the aviation occurrence checks of calculateRisk() on an array of
+ * cases.  Cases are evaluated in parallel; results[i] belongs to cases[i].
+ *
+ * Runway occurrences (OS, CTOL, TI, US, ML) are skipped for cases whose
+ * aircraft1 has no resolvable arrival runway end.
+ *
+ * return: 0 on success, -1 on invalid arguments
+ */
+int calculate_risk_batch(const int count, const risk_case_t* cases, risk_result_t* results);
+
 #endif
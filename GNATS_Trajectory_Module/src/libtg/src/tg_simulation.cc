@@ -47,6 +47,12 @@
 #include "tg_simulation.h"
 
 #include "tg_aircraft.h"
+#include "tg_aircraftIndex.h"
+#include "tg_centers.h"
+#include "tg_wake.h"
+#include "tg_trafficMetrics.h"
+#include "tg_checkpoint.h"
+#include "tg_profiler.h"
 #include "tg_groundVehicle.h"
 #include "tg_airports.h"
 #include "tg_incidentFlightPhase.h"
@@ -100,6 +106,26 @@ using namespace osi;
 #define NUM_STREAMS             4
 #endif
 
+// Settled flights between two runs of changing flights below which the
+// runs are copied from device to host as one
+#define SYNC_D_TO_H_MERGE_GAP   64
+
+// Longest cruise coast, and the number of airborne steps a coast must end
+// before the target waypoint
+#define CRUISE_FAST_FORWARD_MAX_COAST_SEC      300.0
+#define CRUISE_FAST_FORWARD_WAYPOINT_MARGIN    2
+
+// Largest number of its own time steps a flight may skip the processing
+// of, by phase group, and the longest such interval in seconds
+#define STEADY_SKIP_MAX_FACTOR_SURFACE         5
+#define STEADY_SKIP_MAX_FACTOR_ENROUTE         4
+#define STEADY_SKIP_MAX_INTERVAL_SEC         120.0
+// Number of time steps before a waypoint or altitude event at which the flight is fully processed again
+#define STEADY_SKIP_EVENT_MARGIN               1
+// Largest estimated difference to processing every step over one interval
+#define STEADY_SKIP_TOLERANCE_FT              10.0
+#define STEADY_SKIP_TOLERANCE_ALTITUDE_FT      5.0
+
 //TODO :PARIKSHIT'S DEFINITIONS
 #define ENF_HDG_CONT_AIRBORNE 1
 #if ENF_HDG_CONT_AIRBORNE
@@ -114,6 +140,9 @@ using namespace osi;
 #define ENABLE_DEBUG_TRAJ_FILE  0
 #define ENABLE_PROFILER         0
 
+// Module name of the per-flight messages written through the logger
+#define LOG_MODULE_TG_SIMULATION "tg_simulation"
+
 //TODO:PARIKSHIT'S DEFNIITIONS FOR NATS BEGIN
 #define CDNR_FLAG 0
 #define DETECTION_THRESHOLD_NM 50
@@ -167,13 +196,6 @@ std::map<int, string> skipFlightPhase;
 std::map<int, std::vector<string> > lagParams;
 std::map<int, std::map<string, std::vector<float> > > lagParamValues;
 
-//Data structure to record lag parameter values for ground vehicles
-std::map< string, std::vector<string> > gvLagParams;
-std::map< string, std::map<string, std::vector<float> > > gvLagParamValues;
-
-//Data structure to record ground operator absence, and the vehicle stops for those many time steps
-std::map< string, int > groundOperatorAbsence;
-
 //Data structure to record ground operator repeat operations
 std::map< string, vector <string> > groundOperatorActionRepeat;
 
@@ -191,11 +213,6 @@ std::map< string, map <string, pair <double, double> > > aircraftRunwayData;
 //Data structure to aircraft and cargo cost within simulation
 std::map< string, map <string, double> > aircraftAndCargoData;
 
-//Data structure to store ground vehicle simulation data to be written
-std::map< string, std::vector<string> > groundVehicleSimulationData;
-
-//Data structure to handle ground operator course change for ground vehicle simulation
-std::vector<string> courseChange;
 
 //Data structure to store ground communication instrument error
 std::map< string, pair <string, double> > radarErrorModel;
@@ -233,6 +250,8 @@ int cnt_event_cdnr = 0;
 
 bool flag_enable_strategic_weather_avoidance = false;
 bool flag_enable_cdnr = false;
+bool flag_enable_cruise_fast_forward = false;
+bool flag_enable_steady_step_skip = false;
 
 float cdr_initiation_distance_ft_surface = 600.0;
 float cdr_initiation_distance_ft_terminal = 20 * NauticalMilestoFeet;//10 * NauticalMilestoFeet;
@@ -1478,15 +1497,15 @@ void pilot_compute_Lat_Lon_logic(update_states_t* update_states,
 					if (RUNWAY_OFFSET_FT < distance_to_runway_end * sin(abs(hdg_to_runway_end - update_states->course_rad_runway))) {
 						update_states->flag_abnormal_on_runway = true;
 						update_states->flight_phase = FLIGHT_PHASE_OUTOFRUNWAY;
-						printf("Aircraft %s deviate from the runway during departing\n", update_states->acid);
+						LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s deviate from the runway during departing\n", update_states->acid);
 					} else  if ((abs(update_states->course_rad_runway - hdg_to_runway_end) * 180 / PI < 80)
 									&& (runway_length_departing < distance_to_runway_end)) {
 						update_states->flag_abnormal_on_runway = true;
-						printf("Aircraft %s undershoot the runway during departing\n", update_states->acid);
+						LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s undershoot the runway during departing\n", update_states->acid);
 					} else if (abs(update_states->hdg_rad - hdg_to_runway_end) >= (PI * 10 / 180)) {
 						update_states->flag_abnormal_on_runway = true;
 						update_states->flight_phase = FLIGHT_PHASE_RUNWAYOVERSHOOT;
-						printf("Aircraft %s overshoot the runway during departing\n", update_states->acid);
+						LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s overshoot the runway during departing\n", update_states->acid);
 					}
 					// end - Check if aircraft experiences abnormal event on the runway
 				}
@@ -1530,16 +1549,16 @@ void pilot_compute_Lat_Lon_logic(update_states_t* update_states,
 					if (RUNWAY_OFFSET_FT < (distance_to_runway_end * sin(abs(hdg_to_runway_end - update_states->course_rad_runway)))) {
 						update_states->flag_abnormal_on_runway = true;
 						update_states->flight_phase = FLIGHT_PHASE_OUTOFRUNWAY;
-						printf("Aircraft %s deviate from the runway during landing\n", update_states->acid);
+						LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s deviate from the runway during landing\n", update_states->acid);
 					} else if ((abs(update_states->course_rad_runway - hdg_to_runway_end) * 180 / PI) > 90) {
 						update_states->flag_abnormal_on_runway = true;
 						update_states->flight_phase = FLIGHT_PHASE_RUNWAYOVERSHOOT;
-						printf("Aircraft %s overshoot the runway during landing\n", update_states->acid);
+						LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s overshoot the runway during landing\n", update_states->acid);
 					} else if ((abs(update_states->course_rad_runway - hdg_to_runway_end) * 180 / PI < 80)
 									&& (runway_length_landing < distance_to_runway_end)) {
 						update_states->flag_abnormal_on_runway = true;
 						update_states->flight_phase = FLIGHT_PHASE_RUNWAYUNDERSHOOT;
-						printf("Aircraft %s undershoot the runway during landing\n", update_states->acid);
+						LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s undershoot the runway during landing\n", update_states->acid);
 					}
 					// end - Check if aircraft experiences abnormal event on the runway
 				}
@@ -3117,7 +3136,7 @@ bool detect_userIncident(update_states_t* update_states,
 
 			update_states->t_processed_ifs = update_states->t_processed_ifs + update_states->elapsedSecond;
 
-			printf("Aircraft %s entering incident phase %s at t = %f due to %s\n", g_trajectories.at(index_flight).callsign.c_str(), incidentFlightPhaseMap.at(string(update_states->acid)).at(update_states->simulation_user_incident_index).getName().c_str(), update_states->t_processed_ifs, incidentFlightPhaseMap.at(string(update_states->acid)).at(update_states->simulation_user_incident_index).transitionCondition.c_str() );
+			LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s entering incident phase %s at t = %f due to %s\n", g_trajectories.at(index_flight).callsign.c_str(), incidentFlightPhaseMap.at(string(update_states->acid)).at(update_states->simulation_user_incident_index).getName().c_str(), update_states->t_processed_ifs, incidentFlightPhaseMap.at(string(update_states->acid)).at(update_states->simulation_user_incident_index).transitionCondition.c_str() );
 
 			retValue = true; // User incident occurs
 		}
@@ -3625,7 +3644,7 @@ void flightPhase_algorithm_TAKEOFF(update_states_t* update_states,
 
 					update_states->durationSecond_to_be_proc = 0;
 
-					printf("Aircraft %s take off stall\n", update_states->acid);
+					LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s take off stall\n", update_states->acid);
 				}
 			} else {
 				update_states->elapsedSecond = update_states->durationSecond_to_be_proc;
@@ -5232,7 +5251,7 @@ void flightPhase_algorithm_TOUCHDOWN(update_states_t* update_states,
 				&& (runway_length_landing < distance_to_runway_end)) {
 			update_states->flag_abnormal_on_runway = true;
 			update_states->flight_phase = FLIGHT_PHASE_RUNWAYUNDERSHOOT;
-			printf("Aircraft %s undershoot the runway during landing\n", update_states->acid);
+			LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "Aircraft %s undershoot the runway during landing\n", update_states->acid);
 
 			update_states->durationSecond_to_be_proc = 0;
 		}
@@ -6186,6 +6205,682 @@ __global__ void kernel_update_states_write_data_from_c_to_updateStates(update_st
 	update_states->course_rad_taxi = c_course_rad_taxi[index_flight];
 }
 
+/**
+ * Cruise fast-forward
+ *
+ * A flight in steady cruise keeps its true airspeed, altitude and target
+ * waypoint until it passes that waypoint.  After a fully processed
+ * airborne step, such a flight coasts along the great circle to its target
+ * waypoint until the first event ahead, which is scheduled when the coast
+ * starts.  The events are the passage of the target waypoint (and with it
+ * the top of descent) and CRUISE_FAST_FORWARD_MAX_COAST_SEC.  Sector,
+ * center and wind-cell crossings are not detected; the longest coast
+ * stands in for them and bounds the time a crossing, or any other wind
+ * change, goes unnoticed.  The coast also ends as soon as the speed,
+ * altitude, phase or target is changed by anyone else.
+ *
+ * Stage 2 moves a flight by the distance of its last processed step at
+ * every time step.  A coasting flight keeps that distance, so its position
+ * is a closed-form function of the number of time steps since the coast
+ * started.  The flight phase logic, ADB model lookups and wind sampling of
+ * stage 1 and the position integration of stage 2 are skipped.  Trajectory
+ * recording, conflict detection, center tracking and client queries read
+ * the state arrays at every time step, so the closed form is evaluated
+ * once per time step rather than only at the events.
+ *
+ * Error: step by step, a flight re-aims at its target waypoint at every
+ * move and stores its position in real_t, so it leaves the great circle
+ * by the rounding of each move.  At the end of each coast, the moves of
+ * the coast are replayed the way stage 2 integrates them and compared
+ * with the closed-form position.  The distance, plus the estimated effect
+ * of the distance per step drifting away from the held value, is the
+ * along-track error logged when the propagation completes.
+ */
+typedef struct _cruise_coast_t {
+	float t_end; // Coast applies to airborne steps before this time.  Negative if not coasting
+	float t_begin;
+	float t_step; // Time step of stage 2
+	waypoint_node_t* target_WaypointNode_ptr;
+	real_t tas_knots;
+	real_t altitude_ft;
+	real_t V_ground;
+	real_t S; // Distance per time step
+	real_t lat_begin;
+	real_t lon_begin;
+
+	waypoint_node_t* processed_WaypointNode_ptr; // Target waypoint of the last fully processed step
+
+	// Great circle from the position at t_begin to the target waypoint
+	double lat_rad_begin;
+	double lon_rad_begin;
+	double angle_rad_to_waypoint;
+
+	long long coasted_steps;
+	long long processed_steps;
+	long long num_coasts;
+	double sum_error_ft;
+	double max_error_ft;
+} cruise_coast_t;
+
+static vector<cruise_coast_t> cruise_coasts;
+
+static void init_cruise_fast_forward(const int num_flights) {
+	cruise_coast_t coast;
+	memset(&coast, 0, sizeof(coast));
+	coast.t_end = -1;
+
+	cruise_coasts.assign(num_flights, coast);
+}
+
+/**
+ * Whether the flight has a phase to skip.  Lookups with operator[] leave
+ * empty entries behind, so an entry alone does not count.
+ */
+static bool has_skip_flight_phase(const int index_flight) {
+	map<int, string>::const_iterator ite = skipFlightPhase.find(index_flight);
+
+	return (ite != skipFlightPhase.end()) && (!ite->second.empty());
+}
+
+/**
+ * Whether a fully processed flight may skip the processing of its next
+ * steps.  Its target waypoint stays, is not the last one, and no
+ * intermediate fix, phase skip or lag changes the flight in between.
+ */
+static bool is_steady_flight(const update_states_t* update_states,
+		const int index_flight,
+		const float t_step) {
+	return (!update_states->flag_target_waypoint_change)
+			&& (update_states->target_WaypointNode_ptr != NULL)
+			&& (update_states->target_WaypointNode_ptr != array_Airborne_Flight_Plan_Final_Node_ptr[index_flight])
+			&& (!update_states->flag_ifs_exist)
+			&& (0 < update_states->S_within_flightPhase_and_simCycle)
+			&& (0 < t_step)
+			&& (!has_skip_flight_phase(index_flight))
+			&& ((lagParams.find(index_flight) == lagParams.end()) || (lagParams.at(index_flight).empty()));
+}
+
+/**
+ * Along-track difference after num_moves moves of a held distance per
+ * move, when the distance of step-by-step propagation drifts linearly
+ * away from it by dS over the moves.
+ */
+static double estimate_held_distance_error(const double dS, const double num_moves) {
+	return fabs(dS) * num_moves / 2;
+}
+
+/**
+ * Stage 1 of a coasting flight in the airborne step at time t.
+ * Returns false when the flight needs the full processing.
+ */
+static bool coast_cruise_flight(update_states_t* update_states,
+		const int index_flight,
+		const float t,
+		const float t_step_airborne) {
+	if ((!flag_enable_cruise_fast_forward) || (index_flight >= (int)cruise_coasts.size()))
+		return false;
+
+	cruise_coast_t& coast = cruise_coasts[index_flight];
+	if ((coast.t_end < 0) || (coast.t_end <= t))
+		return false;
+
+	kernel_update_states_write_data_from_c_to_updateStates(update_states, index_flight);
+
+	if ((update_states->flight_phase != FLIGHT_PHASE_CRUISE)
+			|| (update_states->target_WaypointNode_ptr != coast.target_WaypointNode_ptr)
+			|| (update_states->target_WaypointNode_ptr == NULL)
+			|| (c_cruise_tas_knots[index_flight] != coast.tas_knots)
+			|| (update_states->altitude_ft != coast.altitude_ft)) {
+		// Changed from outside.  Drop the coast without an error sample
+		coast.t_end = -1;
+
+		return false;
+	}
+
+	update_states->V_ground = coast.V_ground;
+
+	update_states->elapsedSecond = t_step_airborne;
+	update_states->durationSecond_to_be_proc = 0;
+	update_states->S_within_flightPhase_and_simCycle = coast.S;
+	update_states->flag_target_waypoint_change = false;
+
+	kernel_update_states_write_data_from_updateStates_to_c(update_states, index_flight);
+
+	coast.coasted_steps++;
+
+	return true;
+}
+
+/**
+ * Closed-form position of a coasting flight after num_steps moves along
+ * the great circle to its target waypoint.
+ */
+static void get_cruise_coast_position(const cruise_coast_t& coast,
+		const double num_steps,
+		double* const lat_deg,
+		double* const lon_deg) {
+	// Point at the flown fraction of the great circle
+	const double angle_rad = num_steps * coast.S / RADIUS_EARTH_FT;
+	const double a = sin(coast.angle_rad_to_waypoint - angle_rad) / sin(coast.angle_rad_to_waypoint);
+	const double b = sin(angle_rad) / sin(coast.angle_rad_to_waypoint);
+
+	const double lat_rad_waypoint = coast.target_WaypointNode_ptr->latitude * PI / 180.;
+	const double lon_rad_waypoint = coast.target_WaypointNode_ptr->longitude * PI / 180.;
+
+	const double x = a * cos(coast.lat_rad_begin) * cos(coast.lon_rad_begin) + b * cos(lat_rad_waypoint) * cos(lon_rad_waypoint);
+	const double y = a * cos(coast.lat_rad_begin) * sin(coast.lon_rad_begin) + b * cos(lat_rad_waypoint) * sin(lon_rad_waypoint);
+	const double z = a * sin(coast.lat_rad_begin) + b * sin(lat_rad_waypoint);
+
+	*lat_deg = atan2(z, sqrt(x * x + y * y)) * 180. / PI;
+	*lon_deg = atan2(y, x) * 180. / PI;
+}
+
+/**
+ * Distance between the closed-form position of a coast after num_steps
+ * moves and the position step-by-step propagation reaches with the same
+ * moves, each re-aimed at the target waypoint and integrated by stage 2.
+ */
+static double measure_cruise_coast_error(const update_states_t* update_states,
+		const int index_flight,
+		const cruise_coast_t& coast,
+		const int num_steps) {
+	update_states_t replay_states = *update_states;
+	replay_states.lat = coast.lat_begin;
+	replay_states.lon = coast.lon_begin;
+	replay_states.S_within_flightPhase_and_simCycle = coast.S;
+
+	for (int i = 0; i < num_steps; i++) {
+		replay_states.hdg_rad = compute_heading_rad_gc(replay_states.lat,
+				replay_states.lon,
+				coast.target_WaypointNode_ptr->latitude,
+				coast.target_WaypointNode_ptr->longitude);
+
+		pilot_compute_Lat_Lon_default_logic(&replay_states, index_flight);
+	}
+
+	double lat_deg;
+	double lon_deg;
+	get_cruise_coast_position(coast, num_steps, &lat_deg, &lon_deg);
+
+	// Compared as stored
+	const real_t lat = lat_deg;
+	const real_t lon = lon_deg;
+
+	return compute_distance_gc((double)lat, (double)lon, (double)replay_states.lat, (double)replay_states.lon, 0);
+}
+
+/**
+ * Stage 2 of a coasting flight.  Moves the flight to its closed-form
+ * position at the end of the time step at time t.  Returns false when the
+ * flight is not coasting.
+ */
+static bool advance_cruise_coast(update_states_t* update_states,
+		const int index_flight,
+		const float t) {
+	if ((!flag_enable_cruise_fast_forward) || (index_flight >= (int)cruise_coasts.size()))
+		return false;
+
+	const cruise_coast_t& coast = cruise_coasts[index_flight];
+	if ((coast.t_end < 0) || (t < coast.t_begin) || (update_states->target_WaypointNode_ptr != coast.target_WaypointNode_ptr))
+		return false;
+
+	double lat_deg;
+	double lon_deg;
+	get_cruise_coast_position(coast, floor((t - coast.t_begin) / coast.t_step + 0.5) + 1, &lat_deg, &lon_deg);
+
+	update_states->lat = lat_deg;
+	update_states->lon = lon_deg;
+
+	update_states->hdg_rad = compute_heading_rad_gc(update_states->lat,
+			update_states->lon,
+			coast.target_WaypointNode_ptr->latitude,
+			coast.target_WaypointNode_ptr->longitude);
+
+	return true;
+}
+
+/**
+ * Book-keeping after a fully processed step.  Closes a finished coast and
+ * starts a new one when the flight is in steady cruise.
+ */
+static void update_cruise_coast(update_states_t* update_states,
+		const int index_flight,
+		const float t,
+		const float t_step,
+		const float t_step_airborne) {
+	if ((!flag_enable_cruise_fast_forward) || (index_flight >= (int)cruise_coasts.size()))
+		return;
+
+	cruise_coast_t& coast = cruise_coasts[index_flight];
+
+	if (update_states->flight_phase == FLIGHT_PHASE_CRUISE) {
+		coast.processed_steps++;
+	}
+
+	// A step that passed a waypoint flew only part of its distance after it
+	const bool flag_full_step = (update_states->target_WaypointNode_ptr == coast.processed_WaypointNode_ptr);
+	coast.processed_WaypointNode_ptr = update_states->target_WaypointNode_ptr;
+
+	// Rounding of the replaced moves, and the distance per step drifting away from the held value
+	if (coast.t_end >= 0) {
+		if ((update_states->flight_phase == FLIGHT_PHASE_CRUISE) && (flag_full_step)) {
+			const int num_steps = (int)floor((t - coast.t_begin) / coast.t_step + 0.5);
+			const double error_ft = measure_cruise_coast_error(update_states, index_flight, coast, num_steps)
+					+ estimate_held_distance_error(update_states->S_within_flightPhase_and_simCycle - coast.S, num_steps);
+
+			coast.num_coasts++;
+			coast.sum_error_ft += error_ft;
+			coast.max_error_ft = max(coast.max_error_ft, error_ft);
+		}
+
+		coast.t_end = -1;
+	}
+
+	if ((update_states->flight_phase != FLIGHT_PHASE_CRUISE)
+			|| (!flag_full_step)
+			|| (update_states->altitude_ft < TRACON_ALT_FT)
+			|| (!is_steady_flight(update_states, index_flight, t_step)))
+		return;
+
+	// Next event: the target waypoint, less the margin, or the longest coast
+	const double t_to_waypoint = (update_states->L_to_go - update_states->S_within_flightPhase_and_simCycle) / update_states->S_within_flightPhase_and_simCycle * t_step;
+	const double t_coast = min(t_to_waypoint - CRUISE_FAST_FORWARD_WAYPOINT_MARGIN * t_step_airborne, (double)CRUISE_FAST_FORWARD_MAX_COAST_SEC);
+
+	// Not worth a coast unless it covers at least one airborne step
+	if (t_coast <= t_step_airborne)
+		return;
+
+	// Stage 2 of this step starts the coast from the current position
+	coast.lat_begin = update_states->lat;
+	coast.lon_begin = update_states->lon;
+	coast.lat_rad_begin = update_states->lat * PI / 180.;
+	coast.lon_rad_begin = update_states->lon * PI / 180.;
+	coast.angle_rad_to_waypoint = compute_distance_gc_rad(coast.lat_rad_begin,
+			coast.lon_rad_begin,
+			update_states->target_WaypointNode_ptr->latitude * PI / 180.,
+			update_states->target_WaypointNode_ptr->longitude * PI / 180.,
+			0,
+			1);
+	if (coast.angle_rad_to_waypoint <= 0)
+		return;
+
+	coast.t_begin = t;
+	coast.t_end = t + t_coast;
+	coast.t_step = t_step;
+	coast.target_WaypointNode_ptr = update_states->target_WaypointNode_ptr;
+	coast.tas_knots = c_cruise_tas_knots[index_flight];
+	coast.altitude_ft = update_states->altitude_ft;
+	coast.V_ground = update_states->V_ground;
+	coast.S = update_states->S_within_flightPhase_and_simCycle;
+}
+
+void get_cruise_fast_forward_stats(fast_forward_stats_t* const stats) {
+	double sum_error_ft = 0;
+
+	memset(stats, 0, sizeof(fast_forward_stats_t));
+
+	for (unsigned int i = 0; i < cruise_coasts.size(); i++) {
+		stats->skipped_steps += cruise_coasts[i].coasted_steps;
+		stats->total_steps += cruise_coasts[i].coasted_steps + cruise_coasts[i].processed_steps;
+		stats->num_intervals += cruise_coasts[i].num_coasts;
+		sum_error_ft += cruise_coasts[i].sum_error_ft;
+		stats->max_error_ft = max(stats->max_error_ft, cruise_coasts[i].max_error_ft);
+		stats->max_flight_error_ft = max(stats->max_flight_error_ft, cruise_coasts[i].sum_error_ft);
+	}
+
+	if (0 < stats->num_intervals) {
+		stats->mean_error_ft = sum_error_ft / stats->num_intervals;
+	}
+}
+
+static void print_cruise_fast_forward_summary() {
+	fast_forward_stats_t stats;
+	get_cruise_fast_forward_stats(&stats);
+
+	LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "Cruise fast-forward: %lld of %lld cruise steps coasted\n", stats.skipped_steps, stats.total_steps);
+	if (0 < stats.num_intervals) {
+		LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "Cruise fast-forward: estimated along-track error %.1f ft mean, %.1f ft max over %lld coasts, %.1f ft summed over the coasts of one flight\n", stats.mean_error_ft, stats.max_error_ft, stats.num_intervals, stats.max_flight_error_ft);
+	}
+}
+
+/**
+ * Steady step skipping
+ *
+ * Every flight is processed on each of its own time steps: the surface
+ * step on the ground, the terminal step below TRACON_ALT_FT and the
+ * airborne step above it.  With steady step skipping, a flight in a
+ * steady phase away from any event skips the stage 1 processing of a few
+ * of its time steps.  This is not a per-flight time step: the integration
+ * step is never lengthened, stage 2 still moves every flight at every
+ * time step, and every flight holds synchronized states at every output
+ * time for trajectory recording, conflict detection and client queries.
+ * Only the flight phase logic, performance table lookups and wind
+ * sampling of the skipped steps are saved.  Cruise fast-forward is the
+ * same idea for cruise, with the position of stage 2 in closed form.
+ *
+ * The number of steps is chosen after each full processing from the
+ * flight phase (taxiing on the surface, enroute climb, cruise and
+ * descent) and from the number of steps left until the target waypoint
+ * and the next altitude event: TRACON entry, level-off and cruise
+ * altitude.  A climbing or descending flight is further limited to the
+ * steps over which the speed and rate of its performance tables change by
+ * less than the tolerance.  Runway, terminal area, holding and transition
+ * phases are processed at every step.  In the skipped steps, the flight
+ * keeps its speeds and rate of climb or descent and only re-aims its
+ * heading at the target waypoint.
+ *
+ * Stage 2 applies the distance and altitude change of the last processed
+ * step at every time step, so a flight moves t_step_flight / t_step times
+ * that much per step of its own.  The distances to the events account for
+ * it.
+ *
+ * A step that passed a waypoint flew only part of its distance after it,
+ * so an interval only starts after a step that kept its target waypoint.
+ *
+ * Tolerance: compared with processing every step, states at the output
+ * times differ only through the rates held over an interval of at most
+ * STEADY_SKIP_MAX_INTERVAL_SEC, by up to STEADY_SKIP_TOLERANCE_FT and
+ * STEADY_SKIP_TOLERANCE_ALTITUDE_FT per interval.  In a climb or descent
+ * the held rates lag behind on every interval, so the differences add up
+ * over the phase.  The differences are estimated at the
+ * end of each interval as |dS| n / 2 along track and |dROCD| T / 2 in
+ * altitude, with dS the change of the distance per step over the n steps
+ * of the interval, and logged when the propagation completes.
+ */
+typedef struct _steady_skip_t {
+	float t_next; // Time of the next full processing.  Negative when the flight is processed every step
+	float t_begin;
+	float dt;
+	float num_moves; // Moves of stage 2 in one step of the flight
+	ENUM_Flight_Phase flight_phase;
+	waypoint_node_t* target_WaypointNode_ptr;
+	waypoint_node_t* processed_WaypointNode_ptr; // Target waypoint of the last fully processed step
+	real_t tas_knots;
+	real_t rocd_fps;
+	real_t target_altitude_ft;
+	real_t V_ground;
+	real_t S; // Distance per step
+
+	long long skipped_steps;
+	long long processed_steps;
+	long long num_intervals;
+	double sum_error_ft;
+	double max_error_ft;
+	double max_error_altitude_ft;
+} steady_skip_t;
+
+static vector<steady_skip_t> steady_skips;
+
+static void init_steady_step_skip(const int num_flights) {
+	steady_skip_t step;
+	memset(&step, 0, sizeof(step));
+	step.t_next = -1;
+
+	steady_skips.assign(num_flights, step);
+}
+
+static int get_steady_skip_max_factor(const update_states_t* update_states) {
+	switch (update_states->flight_phase) {
+		case FLIGHT_PHASE_TAXI_DEPARTING:
+		case FLIGHT_PHASE_TAXI_ARRIVING:
+			return STEADY_SKIP_MAX_FACTOR_SURFACE;
+
+		case FLIGHT_PHASE_CLIMB_TO_CRUISE_ALTITUDE:
+		case FLIGHT_PHASE_INITIAL_DESCENT:
+			return (update_states->altitude_ft < TRACON_ALT_FT) ? 1 : STEADY_SKIP_MAX_FACTOR_ENROUTE;
+
+		case FLIGHT_PHASE_CRUISE:
+			// Cruise fast-forward handles cruise when it is enabled
+			if ((flag_enable_cruise_fast_forward) || (update_states->altitude_ft < TRACON_ALT_FT))
+				return 1;
+
+			return STEADY_SKIP_MAX_FACTOR_ENROUTE;
+
+		default:
+			return 1;
+	}
+}
+
+/**
+ * Nearest altitude ahead of a climbing or descending flight at which its
+ * phase logic changes behavior.
+ */
+static double get_steady_skip_event_altitude(const update_states_t* update_states,
+		const int index_flight) {
+	double altitude_event;
+
+	if (0 < update_states->rocd_fps) {
+		altitude_event = c_cruise_alt_ft[index_flight];
+
+		if (update_states->altitude_ft < TRACON_ALT_FT) {
+			altitude_event = min(altitude_event, (double)TRACON_ALT_FT);
+		}
+
+		// Start of the level-off below cruise altitude
+		if (update_states->flight_phase == FLIGHT_PHASE_CLIMB_TO_CRUISE_ALTITUDE) {
+			const AdbPTFModel& adbPTFModel = g_adb_ptf_models.at(c_adb_aircraft_type_index[index_flight]);
+
+			for (int i = 1; i < adbPTFModel.getNumRows(); i++) {
+				if (c_cruise_alt_ft[index_flight] <= adbPTFModel.getAltitude(i)) {
+					altitude_event = min(altitude_event, adbPTFModel.getAltitude(i - 1));
+
+					break;
+				}
+			}
+		}
+
+		if (update_states->altitude_ft < update_states->target_altitude_ft) {
+			altitude_event = min(altitude_event, (double)update_states->target_altitude_ft);
+		}
+	} else {
+		altitude_event = max((double)c_destination_airport_elevation_ft[index_flight], (double)TRACON_ALT_FT + CLEARANCE_BUFFER_ALT_RANGE_FT);
+
+		if (update_states->target_altitude_ft < update_states->altitude_ft) {
+			altitude_event = max(altitude_event, (double)update_states->target_altitude_ft);
+		}
+	}
+
+	return altitude_event;
+}
+
+/**
+ * Number of time steps until the next full processing of a flight that
+ * was just fully processed.  1 means the flight keeps the fixed step.
+ */
+static int compute_steady_skip_factor(const update_states_t* update_states,
+		const int index_flight,
+		const float dt,
+		const float t_step) {
+	int factor = get_steady_skip_max_factor(update_states);
+
+	if ((factor <= 1)
+			|| (!is_steady_flight(update_states, index_flight, t_step)))
+		return 1;
+
+	factor = min(factor, (int)floor(STEADY_SKIP_MAX_INTERVAL_SEC / dt));
+
+	// Moves of stage 2 in one step of the flight
+	const double num_moves = max(1.0, floor(dt / t_step + 0.5));
+
+	// Stop short of the target waypoint
+	factor = min(factor, (int)floor(update_states->L_to_go / (num_moves * update_states->S_within_flightPhase_and_simCycle)) - STEADY_SKIP_EVENT_MARGIN);
+
+	// Stop short of the next altitude event
+	const double dh = num_moves * update_states->rocd_fps * dt;
+	if (dh != 0) {
+		const double altitude_event = get_steady_skip_event_altitude(update_states, index_flight);
+
+		factor = min(factor, (int)floor((altitude_event - update_states->altitude_ft) / dh) - STEADY_SKIP_EVENT_MARGIN);
+
+		// Stop while the held speeds stay within the tolerance of the performance tables
+		const AdbPTFModel& adbPTFModel = g_adb_ptf_models.at(c_adb_aircraft_type_index[index_flight]);
+
+		for (; 1 < factor; factor--) {
+			const double altitude_end = update_states->altitude_ft + factor * dh;
+			const double T = factor * dt;
+			double dV;
+			double dROCD;
+
+			if (0 < dh) {
+				dV = adbPTFModel.getClimbTas(altitude_end) - adbPTFModel.getClimbTas(update_states->altitude_ft);
+				dROCD = (adbPTFModel.getClimbRate(altitude_end, LOW) - adbPTFModel.getClimbRate(update_states->altitude_ft, LOW)) / 60;
+			} else {
+				dV = adbPTFModel.getDescentTas(altitude_end) - adbPTFModel.getDescentTas(update_states->altitude_ft);
+				dROCD = (adbPTFModel.getDescentRate(altitude_end, NOMINAL) - adbPTFModel.getDescentRate(update_states->altitude_ft, NOMINAL)) / 60;
+			}
+
+			if ((num_moves * fabs(dV) * KnotsToFps * T / 2 <= STEADY_SKIP_TOLERANCE_FT)
+					&& (num_moves * fabs(dROCD) * T / 2 <= STEADY_SKIP_TOLERANCE_ALTITUDE_FT))
+				break;
+		}
+	}
+
+	return max(factor, 1);
+}
+
+/**
+ * Advance a flight between two full processings by one of its time steps.
+ * Returns false when the flight needs the full processing.
+ */
+static bool skip_steady_step(update_states_t* update_states,
+		const int index_flight,
+		const float t) {
+	if ((!flag_enable_steady_step_skip) || (index_flight >= (int)steady_skips.size()))
+		return false;
+
+	steady_skip_t& step = steady_skips[index_flight];
+	if ((step.t_next < 0) || (step.t_next - 0.5 * step.dt <= t))
+		return false;
+
+	kernel_update_states_write_data_from_c_to_updateStates(update_states, index_flight);
+
+	if ((update_states->flight_phase != step.flight_phase)
+			|| (update_states->target_WaypointNode_ptr != step.target_WaypointNode_ptr)
+			|| (update_states->target_WaypointNode_ptr == NULL)
+			|| (update_states->tas_knots != step.tas_knots)
+			|| (update_states->rocd_fps != step.rocd_fps)
+			|| (update_states->target_altitude_ft != step.target_altitude_ft)) {
+		// Changed from outside.  Drop the interval without an error sample
+		step.t_next = -1;
+
+		return false;
+	}
+
+	// Held speeds may bring the flight close to the target waypoint earlier than planned
+	const double L_to_go = compute_distance_gc((double)update_states->lat,
+			(double)update_states->lon,
+			update_states->target_WaypointNode_ptr->latitude,
+			update_states->target_WaypointNode_ptr->longitude,
+			update_states->target_WaypointNode_ptr->altitude_estimate);
+	if (L_to_go < (1 + STEADY_SKIP_EVENT_MARGIN) * step.num_moves * step.S)
+		return false;
+
+	update_states->hdg_rad = compute_heading_rad_gc(update_states->lat,
+			update_states->lon,
+			update_states->target_WaypointNode_ptr->latitude,
+			update_states->target_WaypointNode_ptr->longitude);
+
+	update_states->V_ground = step.V_ground;
+
+	update_states->elapsedSecond = step.dt;
+	update_states->durationSecond_to_be_proc = 0;
+	update_states->durationSecond_altitude_proc = step.dt;
+	update_states->S_within_flightPhase_and_simCycle = step.S;
+	update_states->flag_target_waypoint_change = false;
+
+	kernel_update_states_write_data_from_updateStates_to_c(update_states, index_flight);
+
+	step.skipped_steps++;
+
+	return true;
+}
+
+/**
+ * Book-keeping after a full processing.  Closes the previous interval and
+ * schedules the next full processing.
+ */
+static void update_steady_skip(update_states_t* update_states,
+		const int index_flight,
+		const float t,
+		const float t_step_surface,
+		const float t_step_airborne) {
+	if ((!flag_enable_steady_step_skip) || (index_flight >= (int)steady_skips.size()))
+		return;
+
+	steady_skip_t& step = steady_skips[index_flight];
+
+	step.processed_steps++;
+
+	const bool flag_full_step = (update_states->target_WaypointNode_ptr == step.processed_WaypointNode_ptr);
+	step.processed_WaypointNode_ptr = update_states->target_WaypointNode_ptr;
+
+	// Differences of rates drifting linearly away from the held values
+	if (step.t_next >= 0) {
+		if ((update_states->flight_phase == step.flight_phase) && (flag_full_step)) {
+			const double error_ft = estimate_held_distance_error(update_states->S_within_flightPhase_and_simCycle - step.S, (t - step.t_begin) / t_step_surface);
+			const double error_altitude_ft = step.num_moves * fabs(update_states->rocd_fps - step.rocd_fps) * (t - step.t_begin) / 2;
+
+			step.num_intervals++;
+			step.sum_error_ft += error_ft;
+			step.max_error_ft = max(step.max_error_ft, error_ft);
+			step.max_error_altitude_ft = max(step.max_error_altitude_ft, error_altitude_ft);
+		}
+
+		step.t_next = -1;
+	}
+
+	if (!flag_full_step)
+		return;
+
+	const float dt = ((isFlightPhase_in_ground_departing(update_states->flight_phase)) || (isFlightPhase_in_ground_landing(update_states->flight_phase))) ? t_step_surface : t_step_airborne;
+
+	const int factor = compute_steady_skip_factor(update_states, index_flight, dt, t_step_surface);
+	if (factor <= 1)
+		return;
+
+	step.t_begin = t;
+	step.t_next = t + factor * dt;
+	step.dt = dt;
+	step.num_moves = max(1.0, floor(dt / t_step_surface + 0.5));
+	step.flight_phase = update_states->flight_phase;
+	step.target_WaypointNode_ptr = update_states->target_WaypointNode_ptr;
+	step.tas_knots = update_states->tas_knots;
+	step.rocd_fps = update_states->rocd_fps;
+	step.target_altitude_ft = update_states->target_altitude_ft;
+	step.V_ground = update_states->V_ground;
+	step.S = update_states->S_within_flightPhase_and_simCycle;
+}
+
+void get_steady_step_skip_stats(fast_forward_stats_t* const stats) {
+	double sum_error_ft = 0;
+
+	memset(stats, 0, sizeof(fast_forward_stats_t));
+
+	for (unsigned int i = 0; i < steady_skips.size(); i++) {
+		stats->skipped_steps += steady_skips[i].skipped_steps;
+		stats->total_steps += steady_skips[i].skipped_steps + steady_skips[i].processed_steps;
+		stats->num_intervals += steady_skips[i].num_intervals;
+		sum_error_ft += steady_skips[i].sum_error_ft;
+		stats->max_error_ft = max(stats->max_error_ft, steady_skips[i].max_error_ft);
+		stats->max_flight_error_ft = max(stats->max_flight_error_ft, steady_skips[i].sum_error_ft);
+		stats->max_error_altitude_ft = max(stats->max_error_altitude_ft, steady_skips[i].max_error_altitude_ft);
+	}
+
+	if (0 < stats->num_intervals) {
+		stats->mean_error_ft = sum_error_ft / stats->num_intervals;
+	}
+}
+
+static void print_steady_step_skip_summary() {
+	fast_forward_stats_t stats;
+	get_steady_step_skip_stats(&stats);
+
+	LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "Steady step skip: %lld of %lld flight steps skipped the processing\n", stats.skipped_steps, stats.total_steps);
+	if (0 < stats.num_intervals) {
+		LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "Steady step skip: estimated along-track error %.1f ft mean, %.1f ft max, altitude error %.1f ft max over %lld intervals, %.1f ft summed over the intervals of one flight\n", stats.mean_error_ft, stats.max_error_ft, stats.max_error_altitude_ft, stats.num_intervals, stats.max_flight_error_ft);
+	}
+}
+
 __global__ void kernel_update_states_stage1(const int num_flights,
 		const float t,
 		const float t_step_surface,
@@ -6265,6 +6960,13 @@ __global__ void kernel_update_states_stage1(const int num_flights,
 			}
 		}
 
+		if ((!update_states->flag_aircraft_held_strategic) && (!update_states->flag_aircraft_held_tactical)
+				&& (update_states->duration_held_cdnr <= 0)
+				&& ((coast_cruise_flight(update_states, index, t, t_step_airborne))
+					|| (skip_steady_step(update_states, index, t)))) {
+			return;
+		}
+
 		kernel_update_states_prepare_data(update_states,
 				index,
 				t_step_surface,
@@ -6353,6 +7055,10 @@ __global__ void kernel_update_states_stage1(const int num_flights,
 		} // end - while
 
 		kernel_update_states_write_data_from_updateStates_to_c(update_states, index);
+
+		update_cruise_coast(update_states, index, t, t_step_surface, t_step_airborne);
+
+		update_steady_skip(update_states, index, t, t_step_surface, t_step_airborne);
 	}
 }
 
@@ -6415,6 +7121,11 @@ __global__ void kernel_update_states_stage2(const int num_flights,
 
 	kernel_update_states_write_data_from_c_to_updateStates(cur_update_states_ptr, index);
 
+	// Coasting flights hold their altitude and move in closed form
+	if (advance_cruise_coast(cur_update_states_ptr, index, t)) {
+		return;
+	}
+
 	aircraft_proc_altitude(cur_update_states_ptr,
 		index,
 		t_step_surface,
@@ -6840,6 +7551,7 @@ static void launch_kernel_external_aircraft(float t,
 
 float nats_simulation_timestamp = 0;
 int nats_simulation_status = 0;
+bool flag_simulation_paused_at_step = false;
 int nats_simulation_check_interval = 200 * 1000; // micro seconds
 float nats_simulation_duration = -1;
 
@@ -6870,6 +7582,32 @@ void set_target_altitude_ft(int index_flight, float target_altitude_ft) {
 	}
 }
 
+/*
+ * Collect the flights inside every region of regard defined for the aircraft.
+ * Each region is {minLat, maxLat, minLon, maxLon, minAlt_ft, maxAlt_ft};
+ * results are appended region by region, in flight sequence order.
+ */
+void get_aircraft_in_region_of_regard(const string& acid, vector<int>& flight_seqs) {
+	flight_seqs.clear();
+
+	std::map< string, std::vector<vector<double>> >::const_iterator ite = regionOfRegard.find(acid);
+	if (ite == regionOfRegard.end())
+		return;
+
+	vector<int> tmp_flight_seqs;
+	for (unsigned int i = 0; i < ite->second.size(); i++) {
+		const vector<double>& region = ite->second.at(i);
+		if (region.size() < 6)
+			continue;
+
+		if (isnan(region[0]) || isnan(region[1]) || isnan(region[2]) || isnan(region[3]))
+			continue;
+
+		get_aircraft_in_box(region[0], region[1], region[2], region[3], region[4], region[5], tmp_flight_seqs);
+		flight_seqs.insert(flight_seqs.end(), tmp_flight_seqs.begin(), tmp_flight_seqs.end());
+	}
+}
+
 /**
  * Return runtime simulation status
  *
@@ -6944,92 +7682,138 @@ void scheduler_proc() {
 
 }
 
+#if USE_GPU
+/**
+ * Copy the synchronized per-flight states of flights [start, start + num)
+ * from device to host
+ */
+static void copy_aircraft_states_D_to_H(const int start, const int num, cuda_stream_t& stream) {
+	cuda_memcpy_async(&h_aircraft_soa.sector_index[start],
+			&d_aircraft_soa.sector_index[start],
+			num*sizeof(int), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.latitude_deg[start],
+			&d_aircraft_soa.latitude_deg[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.longitude_deg[start],
+			&d_aircraft_soa.longitude_deg[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.altitude_ft[start],
+			&d_aircraft_soa.altitude_ft[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.rocd_fps[start],
+			&d_aircraft_soa.rocd_fps[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.tas_knots[start],
+			&d_aircraft_soa.tas_knots[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.tas_knots_ground[start],
+			&d_aircraft_soa.tas_knots_ground[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.course_rad[start],
+			&d_aircraft_soa.course_rad[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.fpa_rad[start],
+			&d_aircraft_soa.fpa_rad[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.flight_phase[start],
+			&d_aircraft_soa.flight_phase[start],
+			num*sizeof(ENUM_Flight_Phase), cuda_memcpy_DtoH,
+			stream);
+
+	cuda_memcpy_async(&h_aircraft_soa.latitude_deg_pre_pause[start],
+			&d_aircraft_soa.latitude_deg_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.longitude_deg_pre_pause[start],
+			&d_aircraft_soa.longitude_deg_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.altitude_ft_pre_pause[start],
+			&d_aircraft_soa.altitude_ft_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.rocd_fps_pre_pause[start],
+			&d_aircraft_soa.rocd_fps_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.tas_knots_pre_pause[start],
+			&d_aircraft_soa.tas_knots_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.course_rad_pre_pause[start],
+			&d_aircraft_soa.course_rad_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.fpa_rad_pre_pause[start],
+			&d_aircraft_soa.fpa_rad_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.cruise_alt_ft_pre_pause[start],
+			&d_aircraft_soa.cruise_alt_ft_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+	cuda_memcpy_async(&h_aircraft_soa.cruise_tas_knots_pre_pause[start],
+			&d_aircraft_soa.cruise_tas_knots_pre_pause[start],
+			num*sizeof(real_t), cuda_memcpy_DtoH,
+			stream);
+}
+
+/**
+ * A landed flight is skipped by both kernel stages.  Once its landed phase
+ * has reached the host, its device states cannot differ from the host copy.
+ */
+static inline bool is_flight_state_settled(const int index) {
+	return (h_aircraft_soa.flight_phase[index] == FLIGHT_PHASE_LANDED);
+}
+#endif
+
 void synchronize_data_from_D_to_H() {
+#if USE_GPU
+	// Copy only the runs of flights whose states may have changed.  Runs
+	// separated by a short gap are copied as one to limit the transfer count.
 	for (int i = 0; i < NUM_STREAMS; ++i) {
 		int stream_start = stream_len * i;
 
 		int num = (i < NUM_STREAMS-1 ? stream_len : stream_len - num_overflow);
 
-		cuda_memcpy_async(&h_aircraft_soa.sector_index[stream_start],
-				&d_aircraft_soa.sector_index[stream_start],
-				num*sizeof(int), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.latitude_deg[stream_start],
-				&d_aircraft_soa.latitude_deg[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.longitude_deg[stream_start],
-				&d_aircraft_soa.longitude_deg[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.altitude_ft[stream_start],
-				&d_aircraft_soa.altitude_ft[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.rocd_fps[stream_start],
-				&d_aircraft_soa.rocd_fps[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.tas_knots[stream_start],
-				&d_aircraft_soa.tas_knots[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.tas_knots_ground[stream_start],
-				&d_aircraft_soa.tas_knots_ground[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.course_rad[stream_start],
-				&d_aircraft_soa.course_rad[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.fpa_rad[stream_start],
-				&d_aircraft_soa.fpa_rad[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.flight_phase[stream_start],
-				&d_aircraft_soa.flight_phase[stream_start],
-				num*sizeof(ENUM_Flight_Phase), cuda_memcpy_DtoH,
-				streams[i]);
-
-		cuda_memcpy_async(&h_aircraft_soa.latitude_deg_pre_pause[stream_start],
-				&d_aircraft_soa.latitude_deg_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.longitude_deg_pre_pause[stream_start],
-				&d_aircraft_soa.longitude_deg_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.altitude_ft_pre_pause[stream_start],
-				&d_aircraft_soa.altitude_ft_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.rocd_fps_pre_pause[stream_start],
-				&d_aircraft_soa.rocd_fps_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.tas_knots_pre_pause[stream_start],
-				&d_aircraft_soa.tas_knots_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.course_rad_pre_pause[stream_start],
-				&d_aircraft_soa.course_rad_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.fpa_rad_pre_pause[stream_start],
-				&d_aircraft_soa.fpa_rad_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.cruise_alt_ft_pre_pause[stream_start],
-				&d_aircraft_soa.cruise_alt_ft_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
-		cuda_memcpy_async(&h_aircraft_soa.cruise_tas_knots_pre_pause[stream_start],
-				&d_aircraft_soa.cruise_tas_knots_pre_pause[stream_start],
-				num*sizeof(real_t), cuda_memcpy_DtoH,
-				streams[i]);
+		int run_start = -1;
+		int run_end = -1;
+		for (int index = stream_start; index < stream_start + num; index++) {
+			if (is_flight_state_settled(index))
+				continue;
+
+			if (run_start < 0) {
+				run_start = index;
+			} else if (index - run_end > SYNC_D_TO_H_MERGE_GAP) {
+				copy_aircraft_states_D_to_H(run_start, run_end - run_start, streams[i]);
+
+				run_start = index;
+			}
+
+			run_end = index + 1;
+		}
+
+		if (run_start > -1) {
+			copy_aircraft_states_D_to_H(run_start, run_end - run_start, streams[i]);
+		}
 
 		cuda_stream_synchronize(streams[i]);
 	}
+#endif
+	// CPU builds point the d_aircraft_soa arrays at the host arrays, so the
+	// host already holds the propagated states
+
+	// Host positions changed; aircraft region queries must re-index
+	invalidate_aircraft_index();
 }
 
 ECEF GeodeticToECEFConversion(const double latitude_rad,
@@ -7532,6 +8316,113 @@ int propagate_flights(const float& input_t_end,
 	return 0;
 }
 
+/*
+ * Propagate ground vehicle i by one terminal area time step along its
+ * drive plan and record its states in the history.  Externally injected
+ * vehicles are only recorded.
+ */
+static void propagate_groundVehicle(const int i,
+		const float t,
+		const float t_step,
+		GroundVehicle& vehicle,
+		groundVehicle_history_t& history) {
+	int tmpCountWaypoint;
+	float distanceCovered = 0.0, distanceBuffer, distanceDiff = 0.0, distanceToRadius, prevLat, prevLon, nextLat, nextLon;
+
+	// Externally injected ground vehicle logic
+	if (vehicle.flag_external_groundVehicle) {
+		record_groundVehicle_sample(history, t, vehicle.aircraft_id, vehicle.latitude * M_PI / 180.0, vehicle.longitude * M_PI / 180.0, vehicle.altitude, vehicle.speed, vehicle.course);
+
+		return;
+	}
+
+	if (vehicle.target_waypoint_index >= vehicle.drive_plan_length - 1)
+		return;
+
+	//Get drive plan for current ground vehicle, starting at index 0
+	waypoint_node_t* tmp_wp_ptr = vehicle.drive_plan_ptr;
+
+	// Check if ground operator is absent for current vehicle
+	if (vehicle.operator_absence_steps > 0) {
+		vehicle.speed = 0;
+		vehicle.operator_absence_steps--;
+		if (vehicle.operator_absence_steps == 0)
+			vehicle.speed = g_groundVehicles.at(i).speed;
+	}
+
+	// Set lagged parameter values to vehicles if applicable.  A parameter
+	// without values is dropped.
+	for (unsigned int paramCount = 0; paramCount < vehicle.lag_params.size(); paramCount++) {
+		if (vehicle.lag_params[paramCount] == GROUND_VEHICLE_LAG_COURSE) {
+			if (vehicle.lag_course_values.size() == 0)
+				vehicle.lag_params.erase(vehicle.lag_params.begin() + paramCount);
+			else
+				vehicle.course = vehicle.lag_course_values[0];
+		}
+		if ((paramCount < vehicle.lag_params.size()) && (vehicle.lag_params[paramCount] == GROUND_VEHICLE_LAG_SPEED)) {
+			if (vehicle.lag_speed_values.size() == 0)
+				vehicle.lag_params.erase(vehicle.lag_params.begin() + paramCount);
+			else
+				vehicle.speed = vehicle.lag_speed_values[0];
+		}
+	}
+
+	if (vehicle.target_waypoint_index == -1) {
+		// Set target waypoint as next node in drive plan
+		vehicle.target_waypoint_name = tmp_wp_ptr->next_node_ptr->wpname;
+		vehicle.target_waypoint_index = 1;
+	}
+	// Calculate distance (ft) covered in past time step
+	distanceCovered = vehicle.speed * 1.68780986 * t_step;
+	tmpCountWaypoint = 0;
+	while (tmpCountWaypoint < vehicle.target_waypoint_index) {
+		tmp_wp_ptr = tmp_wp_ptr->next_node_ptr;
+		tmpCountWaypoint++;
+	}
+
+	prevLat = vehicle.latitude * M_PI / 180.0;
+	prevLon = vehicle.longitude * M_PI / 180.0;
+	nextLat = tmp_wp_ptr->latitude * M_PI / 180.0;
+	nextLon = tmp_wp_ptr->longitude * M_PI / 180.0;
+
+	distanceBuffer = compute_distance_gc(vehicle.latitude, vehicle.longitude, tmp_wp_ptr->latitude, tmp_wp_ptr->longitude, 0.0);
+	distanceDiff = distanceCovered;
+
+	while ((distanceCovered > distanceBuffer)) {
+		distanceBuffer += compute_distance_gc(tmp_wp_ptr->latitude, tmp_wp_ptr->longitude, tmp_wp_ptr->next_node_ptr->latitude, tmp_wp_ptr->next_node_ptr->longitude, 0.0);
+		distanceDiff = distanceBuffer - distanceCovered;
+		prevLat = tmp_wp_ptr->latitude * M_PI / 180.0;
+		prevLon = tmp_wp_ptr->longitude * M_PI / 180.0;
+		nextLat = tmp_wp_ptr->next_node_ptr->latitude * M_PI / 180.0;
+		nextLon = tmp_wp_ptr->next_node_ptr->longitude * M_PI / 180.0;
+		tmp_wp_ptr = tmp_wp_ptr->next_node_ptr;
+		tmpCountWaypoint++;
+		if (tmpCountWaypoint == vehicle.drive_plan_length - 1)
+			break;
+	}
+
+	distanceToRadius = ((distanceDiff * 0.0003048) / (6367.0211));
+	record_groundVehicle_sample(history, t, vehicle.aircraft_id, vehicle.latitude, vehicle.longitude, vehicle.altitude, vehicle.speed, vehicle.course);
+
+	vehicle.target_waypoint_index = tmpCountWaypoint;
+	vehicle.target_waypoint_name = tmp_wp_ptr->wpname;
+
+	// Keep a course set by the operator for one step
+	if (!vehicle.flag_course_override)
+		vehicle.course = calculateBearing(prevLat, prevLon, nextLat, nextLon) * M_PI / 180.0;
+	else
+		vehicle.flag_course_override = false;
+
+	vehicle.latitude = (asin(sin(prevLat) * cos(distanceToRadius) + cos(prevLat) * sin(distanceToRadius) * cos(vehicle.course))) * 180.0 / M_PI;
+	vehicle.longitude = (prevLon + atan2(sin(vehicle.course) * sin(distanceToRadius) * cos(prevLat), cos(distanceToRadius) - sin(prevLat) * sin(vehicle.latitude * M_PI / 180.0))) * 180.0 / M_PI;
+	if (vehicle.target_waypoint_index == vehicle.drive_plan_length - 1) {
+		vehicle.speed = 0;
+		vehicle.latitude = nextLat * 180.0 / M_PI;
+		vehicle.longitude = nextLon * 180.0 / M_PI;
+		record_groundVehicle_sample(history, t + t_step, vehicle.aircraft_id, vehicle.latitude, vehicle.longitude, vehicle.altitude, vehicle.speed, vehicle.course);
+	}
+}
+
 void propagate_flights_proc() {
 	float t_duration_target = -1; // Reset
 
@@ -7554,6 +8445,14 @@ void propagate_flights_proc() {
 	// Flag to process airborne state to variable "g_trajectories"
 	bool flag_proc_airborne_trajectory = false; // Reset
 
+	// Flag indicating the current time step was restored from a checkpoint taken during the pause of this step
+	// The work before the pause was already done by the run which saved the checkpoint
+	bool flag_resume_step = false;
+
+	// Profiling timestamps.  Zero when profiling is off.
+	long long t_profile_step_begin = 0;
+	long long t_profile_stage_begin = 0;
+
 	ground_departing_data_init = (bool*)malloc(num_flights * sizeof(bool));
 	ground_landing_data_init = (bool*)malloc(num_flights * sizeof(bool));
 
@@ -7590,6 +8489,12 @@ void propagate_flights_proc() {
 		c_course_rad_taxi[i] = DBL_MIN;
 	}
 
+	init_flight_centers(num_flights);
+	init_wake_vortices(num_flights);
+	init_traffic_metrics(num_flights);
+	init_cruise_fast_forward(num_flights);
+	init_steady_step_skip(num_flights);
+
 	// Calculate estimate altitude of waypoints ============================================
 	waypoint_node_t* tmpWaypoint_validAltitude;
 	waypoint_node_t* tmpAirborne_Flight_Plan_ptr;
@@ -7701,6 +8606,18 @@ void propagate_flights_proc() {
 		if (nats_simulation_status == NATS_SIMULATION_STATUS_START) {
 			nats_simulation_timestamp = 0; // Reset
 
+			reset_propagation_profile();
+
+			if (has_staged_simulation_checkpoint()) {
+				if (apply_staged_simulation_checkpoint(&t_start) != 0) {
+					printf("Simulation checkpoint could not be applied.  Simulation ended.\n");
+
+					break;
+				}
+
+				flag_resume_step = true;
+			}
+
 			if (flag_realTime_simulation) {
 				sleep_duration_realTime_simulation = t_step * 1000 * 1000 - pause_duration_realTime_simulation;
 
@@ -7712,7 +8629,7 @@ void propagate_flights_proc() {
 			}
 
 			if (nats_simulation_duration > 0) {
-				t_duration_target = nats_simulation_duration;
+				t_duration_target = t_start + nats_simulation_duration;
 
 				printf("\nBegin flight propagation for %f seconds duration from %f to %f second with time step %.1f seconds (surface), %.1f seconds (terminal area), %.1f seconds (above TRACON)\n\n", nats_simulation_duration, t_start, t_end, t_step, t_step_terminal, t_data_collection_period_airborne);
 
@@ -7744,10 +8661,14 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 				nats_simulation_timestamp = t;
 				flag_proc_airborne_trajectory = false; // Reset
 
+				t_profile_step_begin = propagation_profile_begin_step();
+
 				if (fmod(trunc_double(t, 1), t_data_collection_period_airborne) == 0) {
 					flag_proc_airborne_trajectory = true;
 				}
 
+				t_profile_stage_begin = propagation_profile_begin();
+
 				// Initialization of state data
 				for (int i = 0; i < num_flights; i++) {
 					AdbPTFModel tmpAdbPTFModel;
@@ -7840,14 +8761,22 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 					}
 				} // end - Initialization of state data
 
-				for (int i = 0; i < num_flights; i++) {
-					if (array_update_states_ptr[i] != NULL) {
-						array_update_states_ptr[i]->flag_aircraft_held_tactical = false; // Reset
+				propagation_profile_end(PROPAGATION_STAGE_INITIALIZATION, t_profile_stage_begin);
+
+				if (!flag_resume_step) {
+					for (int i = 0; i < num_flights; i++) {
+						if (array_update_states_ptr[i] != NULL) {
+							array_update_states_ptr[i]->flag_aircraft_held_tactical = false; // Reset
+						}
 					}
-				}
 
-				// Output trajectory data to file
-				traj_data_callback(t, t_step_terminal, flag_proc_airborne_trajectory);
+					t_profile_stage_begin = propagation_profile_begin();
+
+					// Output trajectory data to file
+					traj_data_callback(t, t_step_terminal, flag_proc_airborne_trajectory);
+
+					propagation_profile_end(PROPAGATION_STAGE_TRAJECTORY_RECORDING, t_profile_stage_begin);
+				}
 
 				for (int i = 0; i < num_flights; i++) {
 					if (array_update_states_ptr[i] != NULL) {
@@ -7855,7 +8784,7 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 					}
 				}
 
-				for (int i = 0; i < num_flights; i++) {
+				for (int i = 0; (i < num_flights) && (!flag_resume_step); i++) {
 					if (array_update_states_ptr[i] != NULL) {
 						if ((array_update_states_ptr[i]->altitude_ft == 0)
 							|| ((array_update_states_ptr[i]->flag_abnormal_on_runway)
@@ -7867,7 +8796,7 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 							|| ((array_update_states_ptr[i]->flight_phase == FLIGHT_PHASE_TOUCHDOWN) && (h_landing_taxi_plan.waypoint_node_ptr[i] == NULL))
 							) {
 							if ((array_update_states_ptr[i]->flight_phase == FLIGHT_PHASE_RUNWAY_THRESHOLD_DEPARTING) && (array_Airborne_Flight_Plan_ptr[i] == NULL)) {
-								printf("%s: No airborne flight plan found.  Simulation ended.\n", array_update_states_ptr[i]->acid);
+								LOGGER_LOG(LOG_LEVEL_ERROR, LOG_MODULE_TG_SIMULATION, "%s: No airborne flight plan found.  Simulation ended.\n", array_update_states_ptr[i]->acid);
 							}
 
 							array_update_states_ptr[i]->flight_phase = FLIGHT_PHASE_LANDED;
@@ -7879,20 +8808,20 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 					}
 				}
 
+				t_profile_stage_begin = propagation_profile_begin();
+
+				update_flight_centers(t);
+
 				string currentCenter;
 				int meterFixListSize = 0;
 				int meterFixCount = 0;
 				
 				// Traverse all aircraft
 				for (int j = 0; j < num_flights; j++) {
-					currentCenter = "";
+					currentCenter = get_center_code(get_flight_center_index(j));
 
 					if (currentCenter == "")
 						continue;
-					else if (currentCenter == "ZHN" || currentCenter == "ZAN")
-					    currentCenter = "P" + currentCenter;
-				    else
-				        currentCenter = "K" + currentCenter;
 
 					meterFixListSize = 0;
 					if (meterFixMap.find(currentCenter) != meterFixMap.end())
@@ -7920,7 +8849,7 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 											ite_wp->longitude,
 											tmp_update_states_ptr->altitude_ft)) < spacingDistMap[currentCenter][tmpNatsWaypoint.name].second) {
 										tmp_update_states_ptr->flag_aircraft_spacing = true;
-										cout << "Aircraft: " << g_trajectories.at(j).callsign << " held for spacing at meter fix point " << tmpNatsWaypoint.name << endl;
+										LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "Aircraft: %s held for spacing at meter fix point %s\n", g_trajectories.at(j).callsign.c_str(), tmpNatsWaypoint.name.c_str());
 									}
 								}
 								else if (spacingDistMap[currentCenter][tmpNatsWaypoint.name].first == "TIME") {
@@ -7930,7 +8859,7 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 											ite_wp->longitude,
 											tmp_update_states_ptr->altitude_ft) * 0.00018939 ) < (tmp_update_states_ptr->V_ground * 0.0191796575 * spacingDistMap[currentCenter][tmpNatsWaypoint.name].second)) {
 										tmp_update_states_ptr->flag_aircraft_spacing = true;
-										cout << "Aircraft: " << g_trajectories.at(j).callsign << " held for spacing at meter fix point " << tmpNatsWaypoint.name << endl;
+										LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "Aircraft: %s held for spacing at meter fix point %s\n", g_trajectories.at(j).callsign.c_str(), tmpNatsWaypoint.name.c_str());
 									}
 								}
 							}
@@ -7938,10 +8867,14 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 					}
 				}
 
+				propagation_profile_end(PROPAGATION_STAGE_METER_FIX, t_profile_stage_begin);
+
+				t_profile_stage_begin = propagation_profile_begin();
+
 				// Check tactical weather avoidance
 				// User can specify certain waypoints to be blocked for a period of time
 				// If the distance to the blocked waypoint is close, we freeze the aircraft
-				if (0 < vector_tactical_weather_waypoint.size()) {
+				if ((!flag_resume_step) && (0 < vector_tactical_weather_waypoint.size())) {
 					vector<WeatherWaypoint>::iterator ite_weatherWaypoint;
 					ite_weatherWaypoint = vector_tactical_weather_waypoint.begin();
 
@@ -7955,7 +8888,7 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 
 						vector<NatsWaypoint>::iterator ite_wp = find(g_waypoints.begin(), g_waypoints.end(), tmpNatsWaypoint);
 						if (ite_wp != g_waypoints.end()) {
-							cout << "Processing tactical weather avoidance of waypoint " << tmp_weatherWaypoint.waypoint_name << " at timestamp = " << t << " sec" << endl;
+							LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "Processing tactical weather avoidance of waypoint %s at timestamp = %g sec\n", tmp_weatherWaypoint.waypoint_name.c_str(), (double)t);
 
 							// Traverse all aircraft
 							for (int j = 0; j < num_flights; j++) {
@@ -7971,7 +8904,7 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 												tmp_update_states_ptr->altitude_ft) < (50 * NauticalMilestoFeet)) {
 											tmp_update_states_ptr->flag_aircraft_held_tactical = true;
 
-											cout << "Aircraft: " << g_trajectories.at(j).callsign << " held due to tactical weather avoidance of waypoint " << tmp_weatherWaypoint.waypoint_name << endl;
+											LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "Aircraft: %s held due to tactical weather avoidance of waypoint %s\n", g_trajectories.at(j).callsign.c_str(), tmp_weatherWaypoint.waypoint_name.c_str());
 										}
 									}
 								}
@@ -7994,17 +8927,31 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 					}
 				}
 
+				propagation_profile_end(PROPAGATION_STAGE_TACTICAL_WEATHER, t_profile_stage_begin);
+
+				t_profile_stage_begin = propagation_profile_begin();
+
 				// Process stage 1 calculation on all aircrafts
-				for (int i = 0; i < NUM_STREAMS; ++i) {
+				for (int i = 0; (i < NUM_STREAMS) && (!flag_resume_step); ++i) {
 					launch_kernel_stage1(grid_size, block_size, 0, streams[i], num_flights, t, t_step, t_step_terminal, t_data_collection_period_airborne, i, flag_proc_airborne_trajectory);
 				}
 
+				propagation_profile_end(PROPAGATION_STAGE_KERNEL_STAGE1, t_profile_stage_begin);
+
+				t_profile_stage_begin = propagation_profile_begin();
+
 				// Synchronize data from d_aircraft_soa to h_aircraft_soa so that Java functions can access latest data
 				synchronize_data_from_D_to_H();
 
+				propagation_profile_end(PROPAGATION_STAGE_SYNC_D_TO_H, t_profile_stage_begin);
+
 				// Propagate state data on external aircrafts
-				if (t > 0) {
+				if ((t > 0) && (!flag_resume_step)) {
+					t_profile_stage_begin = propagation_profile_begin();
+
 					launch_kernel_external_aircraft(t, t_step, t_step_terminal, t_data_collection_period_airborne);
+
+					propagation_profile_end(PROPAGATION_STAGE_EXTERNAL_AIRCRAFT, t_profile_stage_begin);
 				}
 
 				if ((t_duration_target > 0) && (t >= t_duration_target)) {
@@ -8021,10 +8968,18 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 						nextPropagation_utc_time_realTime_simulation = tmpUTC + long(pause_duration_realTime_simulation / (2*1000));
 					}
 
+					t_profile_stage_begin = propagation_profile_begin();
+
 					usleep(pause_duration_realTime_simulation);
+
+					propagation_profile_end(PROPAGATION_STAGE_PACING_SLEEP, t_profile_stage_begin);
 				} else {
 					// Handle simulation PAUSE controlling
 					if (nats_simulation_status == NATS_SIMULATION_STATUS_PAUSE) {
+						flag_simulation_paused_at_step = true;
+
+						t_profile_stage_begin = propagation_profile_begin();
+
 						while (1) {
 							usleep(nats_simulation_check_interval);
 
@@ -8044,11 +8999,19 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 								break;
 							}
 						}
+
+						propagation_profile_end(PROPAGATION_STAGE_PAUSED, t_profile_stage_begin);
+
+						flag_simulation_paused_at_step = false;
 					}
 				}
 
+				flag_resume_step = false; // Reset
+
 				// Handle simulation STOP controlling
 				if (nats_simulation_status == NATS_SIMULATION_STATUS_STOP) {
+					propagation_profile_end_step(t_profile_step_begin);
+
 					printf("Stop flight propagation\n");
 
 					break;
@@ -8073,6 +9036,8 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 					}
 				}
 
+				t_profile_stage_begin = propagation_profile_begin();
+
 				// If the timestamp is an exact value of hour, execute the corresponding logic at every exact hour.
 				if (fmod(t, 3600) == 0) {
 					printf("    Simulation time: %2.0f hours\n", (float)t/(float)3600);
@@ -8188,7 +9153,7 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 									// Freeze this aircraft
 									array_update_states_ptr[i]->flag_aircraft_held_strategic = true;
 
-									cout << g_trajectories.at(i).callsign << ": no available route in weather zone.  This aircraft will be freezed." << endl;
+									LOGGER_LOG(LOG_LEVEL_WARNING, LOG_MODULE_TG_SIMULATION, "%s: no available route in weather zone.  This aircraft will be freezed.\n", g_trajectories.at(i).callsign.c_str());
 								} else {
 									bool tmpFlag_waypoint_change = false;
 									for (int cntt = 0; cntt < vector_similar_idx_wpts.size(); cntt++) {
@@ -8200,7 +9165,7 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 									}
 
 									if (tmpFlag_waypoint_change)
-										printf("%s: Found new route to avoid weather issue.  Processing new flight plan.\n", g_trajectories.at(i).callsign.c_str());
+										LOGGER_LOG(LOG_LEVEL_INFO, LOG_MODULE_TG_SIMULATION, "%s: Found new route to avoid weather issue.  Processing new flight plan.\n", g_trajectories.at(i).callsign.c_str());
 
 									for (int p = 0; p < vector_reroute_waypoint_lat_deg.size(); p++) {
 										set_reroute_waypoint_pairs.insert(pair<double, double>(vector_reroute_waypoint_lat_deg.at(p), vector_reroute_waypoint_lon_deg.at(p)));
@@ -8302,116 +9267,40 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 					} // end - Strategic weather avoidance
 				} // end - Exact hour
 
-				// Ground Vehicle Simulation Logic Start
-				int tmpCountWaypoint;
-				float distanceCovered = 0.0, distanceBuffer, distanceDiff = 0.0, distanceToRadius, prevLat, prevLon, nextLat, nextLon;
-
-				groundVehiclePreviousStates = groundVehicleStates;
-				int i = 0, groundVehicleListSize = groundVehicleStates.size();
-				while ( i < groundVehicleListSize) {
-					// Externally injected ground vehicle logic
-					if(groundVehicleStates.at(i).flag_external_groundVehicle)
-						groundVehicleSimulationData[groundVehicleStates.at(i).vehicle_id].push_back(to_string(t) + "," + groundVehicleStates.at(i).aircraft_id + "," + to_string(groundVehicleStates.at(i).latitude * M_PI / 180.0) + "," + to_string(groundVehicleStates.at(i).longitude * M_PI / 180.0) + "," + to_string(groundVehicleStates.at(i).altitude) + "," + to_string(groundVehicleStates.at(i).speed) + "," + to_string(groundVehicleStates.at(i).course));
-					else {
-
-						//Get drive plan for current ground vehicle, starting at index 0
-						waypoint_node_t* tmp_wp_ptr = groundVehicleStates.at(i).drive_plan_ptr;
-
-						if (groundVehicleStates.at(i).target_waypoint_index < groundVehicleStates.at(i).drive_plan_length - 1) {
-
-							// Check if ground operator is absent for current vehicle
-							if (groundOperatorAbsence[groundVehicleStates.at(i).vehicle_id] > 0) {
-								groundVehicleStates.at(i).speed = 0;
-								groundOperatorAbsence[groundVehicleStates.at(i).vehicle_id]--;
-								if (groundOperatorAbsence[groundVehicleStates.at(i).vehicle_id] == 0)
-									groundVehicleStates.at(i).speed = g_groundVehicles.at(i).speed;
-							}
-							// Set lagged parameter values to vehicles if applicable
-							int paramCount;
-							for (paramCount = 0; paramCount < gvLagParams[groundVehicleStates.at(i).vehicle_id].size(); paramCount++) {
-								if (gvLagParams[groundVehicleStates.at(i).vehicle_id][paramCount] == "COURSE") {
-									if(gvLagParamValues[groundVehicleStates.at(i).vehicle_id]["COURSE"].size() == 0)
-										gvLagParams[groundVehicleStates.at(i).vehicle_id].erase(gvLagParams[groundVehicleStates.at(i).vehicle_id].begin() + paramCount);
-									else
-										groundVehicleStates.at(i).course = gvLagParamValues[groundVehicleStates.at(i).vehicle_id]["COURSE"][0];
-								}
-								if (gvLagParams[groundVehicleStates.at(i).vehicle_id][paramCount] == "SPEED") {
-									if(gvLagParamValues[groundVehicleStates.at(i).vehicle_id]["SPEED"].size() == 0)
-										gvLagParams[groundVehicleStates.at(i).vehicle_id].erase(gvLagParams[groundVehicleStates.at(i).vehicle_id].begin() + paramCount);
-									else
-										groundVehicleStates.at(i).speed = gvLagParamValues[groundVehicleStates.at(i).vehicle_id]["SPEED"][0];
-								}
-							}
-
-							if (groundVehicleStates.at(i).target_waypoint_index == -1) {
-								// Set target waypoint as next node in drive plan
-								groundVehicleStates.at(i).target_waypoint_name = tmp_wp_ptr->next_node_ptr->wpname;
-								groundVehicleStates.at(i).target_waypoint_index = 1;
-								prevLat = groundVehicleStates.at(i).latitude * M_PI / 180.0;
-								prevLon = groundVehicleStates.at(i).longitude * M_PI / 180.0;
-								nextLat = tmp_wp_ptr->next_node_ptr->latitude * M_PI / 180.0;
-								nextLon = tmp_wp_ptr->next_node_ptr->longitude * M_PI / 180.0;
-							}
-							// Calculate distance (ft) covered in past time step
-							distanceCovered = groundVehicleStates.at(i).speed * 1.68780986 * t_step_terminal;
-							tmpCountWaypoint = 0;
-							while(tmpCountWaypoint < groundVehicleStates.at(i).target_waypoint_index) {
-								tmp_wp_ptr = tmp_wp_ptr->next_node_ptr;
-								tmpCountWaypoint++;
-							}
-
-							prevLat = groundVehicleStates.at(i).latitude * M_PI / 180.0;
-							prevLon = groundVehicleStates.at(i).longitude * M_PI / 180.0;
-							nextLat = tmp_wp_ptr->latitude * M_PI / 180.0;
-							nextLon = tmp_wp_ptr->longitude * M_PI / 180.0;
-
-							distanceBuffer = compute_distance_gc(groundVehicleStates.at(i).latitude, groundVehicleStates.at(i).longitude, tmp_wp_ptr->latitude, tmp_wp_ptr->longitude, 0.0);
-							distanceDiff = distanceCovered;
-
-							while((distanceCovered > distanceBuffer)) {
-								distanceBuffer += compute_distance_gc(tmp_wp_ptr->latitude, tmp_wp_ptr->longitude, tmp_wp_ptr->next_node_ptr->latitude, tmp_wp_ptr->next_node_ptr->longitude, 0.0);
-								distanceDiff = distanceBuffer - distanceCovered;
-								prevLat = tmp_wp_ptr->latitude * M_PI / 180.0;
-								prevLon = tmp_wp_ptr->longitude * M_PI / 180.0;
-								nextLat = tmp_wp_ptr->next_node_ptr->latitude * M_PI / 180.0;
-								nextLon = tmp_wp_ptr->next_node_ptr->longitude * M_PI / 180.0;
-								tmp_wp_ptr = tmp_wp_ptr->next_node_ptr;
-								tmpCountWaypoint++;
-								if(tmpCountWaypoint == groundVehicleStates.at(i).drive_plan_length - 1)
-									break;
+				propagation_profile_end(PROPAGATION_STAGE_STRATEGIC_WEATHER, t_profile_stage_begin);
 
-							}
+				t_profile_stage_begin = propagation_profile_begin();
 
-							distanceToRadius = ((distanceDiff * 0.0003048) / (6367.0211));
-							groundVehicleSimulationData[groundVehicleStates.at(i).vehicle_id].push_back(to_string(t) + "," + groundVehicleStates.at(i).aircraft_id + "," + to_string(groundVehicleStates.at(i).latitude) + "," + to_string(groundVehicleStates.at(i).longitude) + "," + to_string(groundVehicleStates.at(i).altitude) + "," + to_string(groundVehicleStates.at(i).speed) + "," + to_string(groundVehicleStates.at(i).course));
+				// Ground Vehicle Simulation Logic Start
+				save_groundVehicle_previous_states();
 
-							groundVehicleStates.at(i).target_waypoint_index = tmpCountWaypoint;
-							groundVehicleStates.at(i).target_waypoint_name = tmp_wp_ptr->wpname;
-							if (!std::count(courseChange.begin(), courseChange.end(), groundVehicleStates.at(i).vehicle_id))
-								groundVehicleStates.at(i).course = calculateBearing(prevLat, prevLon, nextLat, nextLon) * M_PI / 180.0;
-							else {
-								for (auto it = courseChange.begin(); it != courseChange.end();)
-										if (*it == groundVehicleStates.at(i).vehicle_id)
-											it = courseChange.erase(it);
-										else
-										   ++it;
-							}
-							groundVehicleStates.at(i).latitude = (asin(sin(prevLat) * cos(distanceToRadius) + cos(prevLat) * sin(distanceToRadius) * cos(groundVehicleStates.at(i).course))) * 180.0 / M_PI;
-							groundVehicleStates.at(i).longitude = (prevLon + atan2(sin(groundVehicleStates.at(i).course) * sin(distanceToRadius) * cos(prevLat), cos(distanceToRadius) - sin(prevLat) * sin(groundVehicleStates.at(i).latitude * M_PI / 180.0))) * 180.0 / M_PI;
-							if(groundVehicleStates.at(i).target_waypoint_index == groundVehicleStates.at(i).drive_plan_length - 1) {
-								groundVehicleStates.at(i).speed = 0;
-								groundVehicleStates.at(i).latitude = nextLat * 180.0 / M_PI;
-								groundVehicleStates.at(i).longitude = nextLon * 180.0 / M_PI;
-								groundVehicleSimulationData[groundVehicleStates.at(i).vehicle_id].push_back(to_string(t + t_step_terminal) + "," + groundVehicleStates.at(i).aircraft_id + "," + to_string(groundVehicleStates.at(i).latitude) + "," + to_string(groundVehicleStates.at(i).longitude) + "," + to_string(groundVehicleStates.at(i).altitude) + "," + to_string(groundVehicleStates.at(i).speed) + "," + to_string(groundVehicleStates.at(i).course));
-							}
+				const int groundVehicleListSize = groundVehicleStates.size();
+				for (int i = 0; i < groundVehicleListSize; i++) {
+					GroundVehicle& tmpGroundVehicle = groundVehicleStates[i];
+					if ((tmpGroundVehicle.history_index < 0) || (tmpGroundVehicle.history_index >= (int)groundVehicleHistories.size()))
+						tmpGroundVehicle.history_index = get_groundVehicle_history(tmpGroundVehicle.vehicle_id);
+				}
 
-						}
+				// Vehicles sharing an id share a history and are propagated in order
+				bool flag_shared_history = false;
+				vector<char> flag_history_used(groundVehicleHistories.size(), 0);
+				for (int i = 0; i < groundVehicleListSize; i++) {
+					const int history_index = groundVehicleStates[i].history_index;
+					if (flag_history_used[history_index]) {
+						flag_shared_history = true;
+						break;
 					}
-					groundVehicleListSize = groundVehicleStates.size();
-					i++;
+					flag_history_used[history_index] = 1;
+				}
+
+#pragma omp parallel for schedule(dynamic, 16) if (!flag_shared_history)
+				for (int i = 0; i < groundVehicleListSize; i++) {
+					propagate_groundVehicle(i, t, t_step_terminal, groundVehicleStates[i], groundVehicleHistories[groundVehicleStates[i].history_index]);
 				}
 				// Ground Vehicle Simulation Logic End
 
+				propagation_profile_end(PROPAGATION_STAGE_GROUND_VEHICLE, t_profile_stage_begin);
+
 				for (int i = 0; i < num_flights; i++) {
 					// If this aircraft is not freezed
 					if ((array_update_states_ptr[i] != NULL) && (!array_update_states_ptr[i]->flag_aircraft_held_strategic) && (!array_update_states_ptr[i]->flag_aircraft_held_tactical) && (!array_update_states_ptr[i]->flag_aircraft_spacing)) {
@@ -8507,11 +9396,28 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 				// We have to synchronize it again.
 				set_device_ac_pointers();
 
+				t_profile_stage_begin = propagation_profile_begin();
+
 				// Process stage 2 calculation on all aircraft
 				for (int i = 0; i < NUM_STREAMS; ++i) {
 					launch_kernel_stage2(grid_size, block_size, 0, streams[i], num_flights, t, t_step, t_step_terminal, t_data_collection_period_airborne, i, flag_proc_airborne_trajectory);
 				}
 
+				propagation_profile_end(PROPAGATION_STAGE_KERNEL_STAGE2, t_profile_stage_begin);
+
+				t_profile_stage_begin = propagation_profile_begin();
+
+				// Shed, transport and encounter wake vortices on the synchronized host states
+				update_wake_vortices(t);
+
+				propagation_profile_end(PROPAGATION_STAGE_WAKE_VORTEX, t_profile_stage_begin);
+
+				t_profile_stage_begin = propagation_profile_begin();
+
+				update_traffic_metrics(t, t_step);
+
+				propagation_profile_end(PROPAGATION_STAGE_TRAFFIC_METRICS, t_profile_stage_begin);
+
 
 
 
@@ -8523,6 +9429,8 @@ logger_printLog(LOG_LEVEL_DEBUG, 1, "Propagation timestamp = %f\n", t);
 
 
 
+				t_profile_stage_begin = propagation_profile_begin();
+
 				// Risk Measures
 				if (flag_exist_ac_risk_measures_data) {
 printf("\nRisk Measures starting =================================\n");
@@ -8661,6 +9569,8 @@ printf("\nRisk Measures starting =================================\n");
 						}
 					}
 				} // end - Risk Measures
+
+				propagation_profile_end(PROPAGATION_STAGE_RISK_MEASURES, t_profile_stage_begin);
 
 
 
@@ -8684,6 +9594,10 @@ printf("\nRisk Measures starting =================================\n");
 
 				// Conflict Detection and Resolution
 				if (flag_enable_cdnr) {
+					t_profile_stage_begin = propagation_profile_begin();
+
+					long long cnt_pairs_cdnr = 0;
+
 					for (int i = 0; i < num_flights; i++) {
 						if (array_update_states_ptr[i] != NULL) {
 							// If this aircraft is CDNR held
@@ -8730,6 +9644,8 @@ printf("\nRisk Measures starting =================================\n");
 										int delay_step = 0;
 
 										if ((update_states_ptr_i->duration_held_cdnr == 0) && (update_states_ptr_j->duration_held_cdnr == 0)) {
+											cnt_pairs_cdnr++;
+
 											ConflictDetectionAndResolution(t,
 													update_states_ptr_i,
 													update_states_ptr_i->lat * PI/180.,
@@ -8784,8 +9700,14 @@ printf("\nRisk Measures starting =================================\n");
 							}
 						}
 					}
+
+					propagation_profile_count_cdnr_pairs(cnt_pairs_cdnr);
+
+					propagation_profile_end(PROPAGATION_STAGE_CDNR, t_profile_stage_begin);
 				} // end - Conflict Detection and Resolution
 
+				t_profile_stage_begin = propagation_profile_begin();
+
 				// Write data from update_states to c_ data variables
 				for (int i = 0; i < num_flights; i++) {
 					if (array_update_states_ptr[i] != NULL) {
@@ -8793,18 +9715,47 @@ printf("\nRisk Measures starting =================================\n");
 					}
 				}
 
+				propagation_profile_end(PROPAGATION_STAGE_WRITE_BACK, t_profile_stage_begin);
+
 				if (flag_realTime_simulation) {
 					long tmpUTC = getCurrentCpuTime_milliSec();
 					nextPropagation_utc_time_realTime_simulation = tmpUTC + long(sleep_duration_realTime_simulation / 1000);
 
+					t_profile_stage_begin = propagation_profile_begin();
+
 					usleep(sleep_duration_realTime_simulation);
+
+					propagation_profile_end(PROPAGATION_STAGE_PACING_SLEEP, t_profile_stage_begin);
+				}
+
+				if (flag_propagation_profiling) {
+					for (int i = 0; i < num_flights; i++) {
+						if (array_update_states_ptr[i] != NULL) {
+							propagation_profile_count_flight_phase(array_update_states_ptr[i]->flight_phase);
+						}
+					}
 				}
 
+				propagation_profile_end_step(t_profile_step_begin);
+
 				t += t_step;
 			} // end - while loop
 
+			// Write out per-flight messages still queued in the logger
+			logger_flush();
+
 			printf("\nFlight propagation completed.\n");
 
+			if (flag_enable_cruise_fast_forward) {
+				print_cruise_fast_forward_summary();
+			}
+
+			if (flag_enable_steady_step_skip) {
+				print_steady_step_skip_summary();
+			}
+
+			finish_traffic_metrics();
+
 			// Write statistics of CDNR
 			if (flag_enable_cdnr) {
 				stringstream tmpOSS;
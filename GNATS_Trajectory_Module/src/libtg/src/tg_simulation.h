@@ -55,6 +55,7 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 #include "util_windows_funcs.h"
 
 #include <cfloat>
+#include <sstream>
 
 const int NATS_SIMULATION_STATUS_READY = 0;
 const int NATS_SIMULATION_STATUS_START = 1;
@@ -195,13 +196,6 @@ extern std::map<int, string> skipFlightPhase;
 extern std::map< int, std::vector<string> > lagParams;
 extern std::map< int, std::map<string, std::vector<float> > > lagParamValues;
 
-//Data structure to record lag parameter values for ground vehicles
-extern std::map< string, std::vector<string> > gvLagParams;
-extern std::map< string, std::map<string, std::vector<float> > > gvLagParamValues;
-
-//Data structure to record ground operator absence, and the vehicle stops for those many time steps
-extern std::map< string, int > groundOperatorAbsence;
-
 //Data structure to record ground operator repeat operations
 extern std::map< string, vector <string> > groundOperatorActionRepeat;
 
@@ -217,12 +211,6 @@ extern std::map< string, map <string, pair <string, float> > > spacingDistMap;
 //Data structure for touchdown and takeoff points points of an aircraft
 extern std::map< string, map <string, pair <double, double> > > aircraftRunwayData;
 
-//Data structure to store ground vehicle simulation data to be written
-extern std::map< string, std::vector<string> > groundVehicleSimulationData;
-
-//Data structure to handle ground operator course change for ground vehicle simulation
-extern std::vector<string> courseChange;
-
 //Data structure to store ground communication instrument error
 extern std::map< string, pair <string, double> > radarErrorModel;
 
@@ -231,6 +219,8 @@ extern std::map<string, pair<string, float> > map_CDR_status;
 //Region of regard for given aircraft
 extern std::map< string, std::vector<vector<double>> > regionOfRegard;
 
+void get_aircraft_in_region_of_regard(const string& acid, vector<int>& flight_seqs);
+
 //Weather sample for simulation
 extern std::vector<double> weatherSample;
 
@@ -271,6 +261,8 @@ extern long nextPropagation_utc_time_realTime_simulation;
 
 extern bool flag_enable_strategic_weather_avoidance;
 extern bool flag_enable_cdnr;
+extern bool flag_enable_cruise_fast_forward;
+extern bool flag_enable_steady_step_skip;
 
 extern int cnt_event_cdnr;
 
@@ -287,6 +279,18 @@ extern string tg_pathFilename_pirep;
 
 extern vector<WeatherWaypoint> vector_tactical_weather_waypoint;
 
+extern std::stringstream cdnr_oss_doc;
+
+extern float nats_simulation_timestamp;
+
+// True while the propagation thread waits in the pause loop of a time step
+extern bool flag_simulation_paused_at_step;
+
+extern bool* ground_departing_data_init;
+extern bool* ground_landing_data_init;
+
+extern update_states_t** array_update_states_ptr;
+
 // device constant memory pointers(CUDA)
 __device__ real_t*        c_departure_time_sec;
 __device__ real_t*        c_cruise_alt_ft;
@@ -422,6 +426,27 @@ void set_nats_simulation_duration(float value);
 
 void set_target_altitude_ft(int index_flight, float target_altitude_ft);
 
+/*
+ * Steps that were advanced without the full processing, and the estimated
+ * differences to step-by-step propagation.  Cruise holds the altitude, so
+ * the altitude difference of cruise fast-forward is 0.
+ */
+typedef struct _fast_forward_stats_t {
+	long long skipped_steps;
+	long long total_steps;
+	long long num_intervals;
+	double mean_error_ft;
+	double max_error_ft;
+	double max_error_altitude_ft;
+	double max_flight_error_ft; // Largest sum of the along-track errors of one flight
+} fast_forward_stats_t;
+
+// Counters of the last propagation with cruise fast-forward enabled
+void get_cruise_fast_forward_stats(fast_forward_stats_t* const stats);
+
+// Counters of the last propagation with steady step skipping enabled
+void get_steady_step_skip_stats(fast_forward_stats_t* const stats);
+
 /*************************************CDNR STARTS*******************************************/
 #if CDNR_FLAG
 // Conflict detection and Resolution
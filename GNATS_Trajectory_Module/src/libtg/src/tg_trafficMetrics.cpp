@@ -0,0 +1,627 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_trafficMetrics.cpp
+ *
+ * Streaming sector and airport traffic metrics.
+ */
+
+#include "tg_trafficMetrics.h"
+#include "tg_api.h"
+#include "tg_aircraft.h"
+#include "tg_sectors.h"
+#include "tg_simulation.h"
+
+#include "hdf5.h"
+
+#include <omp.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Flight status bits
+#define TRAFFIC_METRICS_FLIGHT_ON_GROUND  0x1
+#define TRAFFIC_METRICS_FLIGHT_DEPARTED   0x2
+#define TRAFFIC_METRICS_FLIGHT_AIRBORNE   0x4
+#define TRAFFIC_METRICS_FLIGHT_ARRIVED    0x8
+
+// Length of the fixed-size name field of the HDF5 records
+#define TRAFFIC_METRICS_H5_NAME_LEN 32
+
+typedef struct _h5_sector_metrics_t {
+	char name[TRAFFIC_METRICS_H5_NAME_LEN];
+	double bin_start_sec;
+	double bin_end_sec;
+	int entries;
+	int peak_count;
+	double occupancy_flight_sec;
+	double mean_count;
+} h5_sector_metrics_t;
+
+typedef struct _h5_airport_metrics_t {
+	char name[TRAFFIC_METRICS_H5_NAME_LEN];
+	double bin_start_sec;
+	double bin_end_sec;
+	int departures;
+	int arrivals;
+} h5_airport_metrics_t;
+
+/*
+ * host-side global variables
+ */
+bool flag_enable_traffic_metrics = false;
+
+traffic_metrics_t g_traffic_metrics;
+
+// Sector of each flight at the last update, an index into g_sectors or -1
+vector<int> h_traffic_metrics_sector_index;
+vector<int> h_traffic_metrics_flight_status;
+
+// Airport slot of the origin and destination of each flight, -1 if not collected
+vector<int> h_traffic_metrics_origin_slot;
+vector<int> h_traffic_metrics_destination_slot;
+
+static float traffic_metrics_bin_sec = TRAFFIC_METRICS_DEFAULT_BIN_SEC;
+static vector<string> traffic_metrics_sector_selection;
+static vector<string> traffic_metrics_airport_selection;
+static string traffic_metrics_output_file;
+
+// Sector slot of each entry of g_sectors, -1 if not collected, and the
+// number of collected sectors it was built for
+static vector<int> traffic_metrics_sector_slot;
+static unsigned int traffic_metrics_sector_slot_num_names = 0;
+
+// Guards g_traffic_metrics, which is read by API calls during the run
+static pthread_mutex_t mutex_traffic_metrics = PTHREAD_MUTEX_INITIALIZER;
+
+static inline bool is_ground_departure_phase(const int& flight_phase) {
+	return (flight_phase < FLIGHT_PHASE_TAKEOFF);
+}
+
+static inline bool is_airborne_phase(const int& flight_phase) {
+	return ((FLIGHT_PHASE_TAKEOFF <= flight_phase) && (flight_phase < FLIGHT_PHASE_TOUCHDOWN));
+}
+
+static inline bool is_arrival_phase(const int& flight_phase) {
+	return ((FLIGHT_PHASE_TOUCHDOWN <= flight_phase) && (flight_phase <= FLIGHT_PHASE_LANDED));
+}
+
+static inline int get_sector_slot(const int& sector_index) {
+	if ((sector_index < 0) || (sector_index >= (int)traffic_metrics_sector_slot.size()))
+		return -1;
+
+	return traffic_metrics_sector_slot[sector_index];
+}
+
+static void build_sector_slots() {
+	map<string, int> map_slot;
+	for (unsigned int i = 0; i < g_traffic_metrics.sector_names.size(); i++) {
+		map_slot[g_traffic_metrics.sector_names[i]] = i;
+	}
+
+	traffic_metrics_sector_slot.assign(g_sectors.size(), -1);
+	traffic_metrics_sector_slot_num_names = g_traffic_metrics.sector_names.size();
+	for (unsigned int i = 0; i < g_sectors.size(); i++) {
+		map<string, int>::const_iterator ite = map_slot.find(g_sectors[i].name);
+		if (ite != map_slot.end()) {
+			traffic_metrics_sector_slot[i] = ite->second;
+		}
+	}
+}
+
+// Grow every sector and airport series to num_bins bins
+static void reserve_bins(const int& num_bins) {
+	const sector_metrics_bin_t empty_sector_bin = {0, 0, 0.0};
+	const airport_metrics_bin_t empty_airport_bin = {0, 0};
+
+	for (unsigned int i = 0; i < g_traffic_metrics.sector_bins.size(); i++) {
+		if ((int)g_traffic_metrics.sector_bins[i].size() < num_bins)
+			g_traffic_metrics.sector_bins[i].resize(num_bins, empty_sector_bin);
+	}
+	for (unsigned int i = 0; i < g_traffic_metrics.airport_bins.size(); i++) {
+		if ((int)g_traffic_metrics.airport_bins[i].size() < num_bins)
+			g_traffic_metrics.airport_bins[i].resize(num_bins, empty_airport_bin);
+	}
+}
+
+static int get_num_bins(const traffic_metrics_t& metrics) {
+	if (!metrics.sector_bins.empty())
+		return metrics.sector_bins[0].size();
+	if (!metrics.airport_bins.empty())
+		return metrics.airport_bins[0].size();
+
+	return 0;
+}
+
+int set_traffic_metrics_config(const float& bin_sec,
+		const vector<string>& sector_names,
+		const vector<string>& airport_codes,
+		const string& fname) {
+	if (bin_sec <= 0) {
+		printf("Traffic metrics: bin length must be positive\n");
+
+		return -1;
+	}
+
+	traffic_metrics_bin_sec = bin_sec;
+	traffic_metrics_sector_selection = sector_names;
+	traffic_metrics_airport_selection = airport_codes;
+	traffic_metrics_output_file = fname;
+
+	return 0;
+}
+
+void init_traffic_metrics(const int& num_flights) {
+	pthread_mutex_lock(&mutex_traffic_metrics);
+
+	g_traffic_metrics = traffic_metrics_t();
+	g_traffic_metrics.bin_sec = traffic_metrics_bin_sec;
+
+	h_traffic_metrics_sector_index.clear();
+	h_traffic_metrics_flight_status.clear();
+	h_traffic_metrics_origin_slot.clear();
+	h_traffic_metrics_destination_slot.clear();
+	traffic_metrics_sector_slot.clear();
+	traffic_metrics_sector_slot_num_names = 0;
+
+	if (!flag_enable_traffic_metrics) {
+		pthread_mutex_unlock(&mutex_traffic_metrics);
+
+		return;
+	}
+
+	const int num_trajectories = min(num_flights, (int)g_trajectories.size());
+
+	// Sectors
+	set<string> set_sector_names;
+	for (unsigned int i = 0; i < g_sectors.size(); i++) {
+		set_sector_names.insert(g_sectors[i].name);
+	}
+	if (traffic_metrics_sector_selection.empty()) {
+		g_traffic_metrics.sector_names.assign(set_sector_names.begin(), set_sector_names.end());
+	} else {
+		for (unsigned int i = 0; i < traffic_metrics_sector_selection.size(); i++) {
+			const string& name = traffic_metrics_sector_selection[i];
+			if (set_sector_names.find(name) == set_sector_names.end()) {
+				printf("Traffic metrics: sector %s not found\n", name.c_str());
+			} else if (find(g_traffic_metrics.sector_names.begin(), g_traffic_metrics.sector_names.end(), name) == g_traffic_metrics.sector_names.end()) {
+				g_traffic_metrics.sector_names.push_back(name);
+			}
+		}
+	}
+
+	// Airports
+	if (traffic_metrics_airport_selection.empty()) {
+		set<string> set_airport_codes;
+		for (int i = 0; i < num_trajectories; i++) {
+			if (!g_trajectories[i].origin_airport.empty())
+				set_airport_codes.insert(g_trajectories[i].origin_airport);
+			if (!g_trajectories[i].destination_airport.empty())
+				set_airport_codes.insert(g_trajectories[i].destination_airport);
+		}
+		g_traffic_metrics.airport_codes.assign(set_airport_codes.begin(), set_airport_codes.end());
+	} else {
+		for (unsigned int i = 0; i < traffic_metrics_airport_selection.size(); i++) {
+			const string& code = traffic_metrics_airport_selection[i];
+			if (find(g_traffic_metrics.airport_codes.begin(), g_traffic_metrics.airport_codes.end(), code) == g_traffic_metrics.airport_codes.end()) {
+				g_traffic_metrics.airport_codes.push_back(code);
+			}
+		}
+	}
+
+	g_traffic_metrics.sector_bins.resize(g_traffic_metrics.sector_names.size());
+	g_traffic_metrics.airport_bins.resize(g_traffic_metrics.airport_codes.size());
+
+	build_sector_slots();
+
+	map<string, int> map_airport_slot;
+	for (unsigned int i = 0; i < g_traffic_metrics.airport_codes.size(); i++) {
+		map_airport_slot[g_traffic_metrics.airport_codes[i]] = i;
+	}
+
+	h_traffic_metrics_sector_index.assign(num_flights, -1);
+	h_traffic_metrics_flight_status.assign(num_flights, 0);
+	h_traffic_metrics_origin_slot.assign(num_flights, -1);
+	h_traffic_metrics_destination_slot.assign(num_flights, -1);
+	for (int i = 0; i < num_trajectories; i++) {
+		map<string, int>::const_iterator ite = map_airport_slot.find(g_trajectories[i].origin_airport);
+		if (ite != map_airport_slot.end())
+			h_traffic_metrics_origin_slot[i] = ite->second;
+
+		ite = map_airport_slot.find(g_trajectories[i].destination_airport);
+		if (ite != map_airport_slot.end())
+			h_traffic_metrics_destination_slot[i] = ite->second;
+	}
+
+	pthread_mutex_unlock(&mutex_traffic_metrics);
+}
+
+void update_traffic_metrics(const float& t, const float& t_step) {
+	const int num_tracked = h_traffic_metrics_sector_index.size();
+	if ((!flag_enable_traffic_metrics) || (num_tracked == 0) || (g_traffic_metrics.bin_sec <= 0))
+		return;
+
+	// The slot table is not checkpointed.  Rebuild it when a restored
+	// checkpoint replaced the collected sectors.
+	if ((traffic_metrics_sector_slot.size() != g_sectors.size())
+			|| (traffic_metrics_sector_slot_num_names != g_traffic_metrics.sector_names.size()))
+		build_sector_slots();
+
+	vector<int> next_sector_index(num_tracked, -1);
+	vector<int> flight_phase(num_tracked, -1);
+
+	// Sector lookups start from the sector of the previous step, so only
+	// flights crossing a boundary search the sector grid
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int i = 0; i < num_tracked; i++) {
+		const update_states_t* update_states = array_update_states_ptr[i];
+		if ((update_states == NULL) || (!update_states->flag_data_initialized))
+			continue;
+
+		flight_phase[i] = update_states->flight_phase;
+
+		// Without sector data the grid is not allocated
+		if ((update_states->landed_flag) || (!is_airborne_phase(update_states->flight_phase)) || (!flag_sector_available))
+			continue;
+
+		next_sector_index[i] = compute_flight_sector(update_states->lat,
+				update_states->lon,
+				update_states->altitude_ft,
+				h_traffic_metrics_sector_index[i]);
+	}
+
+	const int num_sector_slots = g_traffic_metrics.sector_names.size();
+	const int bin = max(0, (int)floor(t / g_traffic_metrics.bin_sec));
+
+	vector<int> counts(num_sector_slots, 0);
+
+	pthread_mutex_lock(&mutex_traffic_metrics);
+
+	reserve_bins(bin + 1);
+
+	for (int i = 0; i < num_tracked; i++) {
+		const int prev_slot = get_sector_slot(h_traffic_metrics_sector_index[i]);
+		const int next_slot = get_sector_slot(next_sector_index[i]);
+		if (next_slot > -1) {
+			counts[next_slot]++;
+			if (next_slot != prev_slot)
+				g_traffic_metrics.sector_bins[next_slot][bin].entries++;
+		}
+
+		h_traffic_metrics_sector_index[i] = next_sector_index[i];
+
+		if (flight_phase[i] < 0)
+			continue;
+
+		int& status = h_traffic_metrics_flight_status[i];
+		if (is_ground_departure_phase(flight_phase[i])) {
+			status |= TRAFFIC_METRICS_FLIGHT_ON_GROUND;
+		} else if (is_airborne_phase(flight_phase[i])) {
+			// Flights starting airborne have no departure
+			if ((status & TRAFFIC_METRICS_FLIGHT_ON_GROUND) && !(status & TRAFFIC_METRICS_FLIGHT_DEPARTED)) {
+				status |= TRAFFIC_METRICS_FLIGHT_DEPARTED;
+				if (h_traffic_metrics_origin_slot[i] > -1)
+					g_traffic_metrics.airport_bins[h_traffic_metrics_origin_slot[i]][bin].departures++;
+			}
+			status |= TRAFFIC_METRICS_FLIGHT_AIRBORNE;
+		} else if (is_arrival_phase(flight_phase[i])) {
+			if ((status & TRAFFIC_METRICS_FLIGHT_AIRBORNE) && !(status & TRAFFIC_METRICS_FLIGHT_ARRIVED)) {
+				status |= TRAFFIC_METRICS_FLIGHT_ARRIVED;
+				if (h_traffic_metrics_destination_slot[i] > -1)
+					g_traffic_metrics.airport_bins[h_traffic_metrics_destination_slot[i]][bin].arrivals++;
+			}
+		}
+	}
+
+	for (int s = 0; s < num_sector_slots; s++) {
+		if (counts[s] == 0)
+			continue;
+
+		sector_metrics_bin_t& sector_bin = g_traffic_metrics.sector_bins[s][bin];
+		sector_bin.occupancy_flight_sec += counts[s] * t_step;
+		if (sector_bin.peak_count < counts[s])
+			sector_bin.peak_count = counts[s];
+	}
+
+	pthread_mutex_unlock(&mutex_traffic_metrics);
+}
+
+int get_traffic_metrics(traffic_metrics_t* const metrics) {
+	if (metrics == NULL)
+		return -1;
+
+	pthread_mutex_lock(&mutex_traffic_metrics);
+	*metrics = g_traffic_metrics;
+	pthread_mutex_unlock(&mutex_traffic_metrics);
+
+	return 0;
+}
+
+static int write_traffic_metrics_csv(const string& fname, const traffic_metrics_t& metrics) {
+	FILE* out = fopen(fname.c_str(), "w");
+	if (out == NULL) {
+		printf("Can't write traffic metrics file %s\n", fname.c_str());
+
+		return -1;
+	}
+
+	const int num_bins = get_num_bins(metrics);
+
+	fprintf(out, "Record,Name,BinStartSec,BinEndSec,Entries,PeakCount,OccupancyFlightSec,MeanCount,Departures,Arrivals\n");
+
+	for (unsigned int s = 0; s < metrics.sector_names.size(); s++) {
+		for (int b = 0; b < num_bins; b++) {
+			const sector_metrics_bin_t& sector_bin = metrics.sector_bins[s][b];
+
+			fprintf(out, "SECTOR,%s,%f,%f,%d,%d,%f,%f,,\n",
+					metrics.sector_names[s].c_str(),
+					b * metrics.bin_sec,
+					(b + 1) * metrics.bin_sec,
+					sector_bin.entries,
+					sector_bin.peak_count,
+					sector_bin.occupancy_flight_sec,
+					sector_bin.occupancy_flight_sec / metrics.bin_sec);
+		}
+	}
+
+	for (unsigned int a = 0; a < metrics.airport_codes.size(); a++) {
+		for (int b = 0; b < num_bins; b++) {
+			const airport_metrics_bin_t& airport_bin = metrics.airport_bins[a][b];
+
+			fprintf(out, "AIRPORT,%s,%f,%f,,,,,%d,%d\n",
+					metrics.airport_codes[a].c_str(),
+					b * metrics.bin_sec,
+					(b + 1) * metrics.bin_sec,
+					airport_bin.departures,
+					airport_bin.arrivals);
+		}
+	}
+
+	fclose(out);
+
+	return 0;
+}
+
+static void write_traffic_metrics_h5_bin_sec(const hid_t& dataset, const float& bin_sec) {
+	double value = bin_sec;
+	hid_t attr_space = H5Screate(H5S_SCALAR);
+	hid_t attr = H5Acreate2(dataset, "bin_sec", H5T_IEEE_F64LE, attr_space, H5P_DEFAULT, H5P_DEFAULT);
+	H5Awrite(attr, H5T_NATIVE_DOUBLE, &value);
+	H5Aclose(attr);
+	H5Sclose(attr_space);
+}
+
+static int write_traffic_metrics_h5(const string& fname, const traffic_metrics_t& metrics) {
+	const int num_bins = get_num_bins(metrics);
+
+	vector<h5_sector_metrics_t> sector_records;
+	sector_records.reserve(metrics.sector_names.size() * num_bins);
+	for (unsigned int s = 0; s < metrics.sector_names.size(); s++) {
+		for (int b = 0; b < num_bins; b++) {
+			const sector_metrics_bin_t& sector_bin = metrics.sector_bins[s][b];
+
+			h5_sector_metrics_t record;
+			memset(&record, 0, sizeof(record));
+			strncpy(record.name, metrics.sector_names[s].c_str(), TRAFFIC_METRICS_H5_NAME_LEN-1);
+			record.bin_start_sec = b * metrics.bin_sec;
+			record.bin_end_sec = (b + 1) * metrics.bin_sec;
+			record.entries = sector_bin.entries;
+			record.peak_count = sector_bin.peak_count;
+			record.occupancy_flight_sec = sector_bin.occupancy_flight_sec;
+			record.mean_count = sector_bin.occupancy_flight_sec / metrics.bin_sec;
+			sector_records.push_back(record);
+		}
+	}
+
+	vector<h5_airport_metrics_t> airport_records;
+	airport_records.reserve(metrics.airport_codes.size() * num_bins);
+	for (unsigned int a = 0; a < metrics.airport_codes.size(); a++) {
+		for (int b = 0; b < num_bins; b++) {
+			const airport_metrics_bin_t& airport_bin = metrics.airport_bins[a][b];
+
+			h5_airport_metrics_t record;
+			memset(&record, 0, sizeof(record));
+			strncpy(record.name, metrics.airport_codes[a].c_str(), TRAFFIC_METRICS_H5_NAME_LEN-1);
+			record.bin_start_sec = b * metrics.bin_sec;
+			record.bin_end_sec = (b + 1) * metrics.bin_sec;
+			record.departures = airport_bin.departures;
+			record.arrivals = airport_bin.arrivals;
+			airport_records.push_back(record);
+		}
+	}
+
+	hid_t file = H5Fcreate(fname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	if (file < 0) {
+		printf("Can't write traffic metrics file %s\n", fname.c_str());
+
+		return -1;
+	}
+
+	hid_t string_type = H5Tcopy(H5T_C_S1);
+	H5Tset_size(string_type, TRAFFIC_METRICS_H5_NAME_LEN);
+
+	// In-memory types follow the record structs, the file types are
+	// packed little-endian as for the trajectory files
+	hid_t mem_sector_type = H5Tcreate(H5T_COMPOUND, sizeof(h5_sector_metrics_t));
+	H5Tinsert(mem_sector_type, "name", HOFFSET(h5_sector_metrics_t, name), string_type);
+	H5Tinsert(mem_sector_type, "bin_start_sec", HOFFSET(h5_sector_metrics_t, bin_start_sec), H5T_NATIVE_DOUBLE);
+	H5Tinsert(mem_sector_type, "bin_end_sec", HOFFSET(h5_sector_metrics_t, bin_end_sec), H5T_NATIVE_DOUBLE);
+	H5Tinsert(mem_sector_type, "entries", HOFFSET(h5_sector_metrics_t, entries), H5T_NATIVE_INT);
+	H5Tinsert(mem_sector_type, "peak_count", HOFFSET(h5_sector_metrics_t, peak_count), H5T_NATIVE_INT);
+	H5Tinsert(mem_sector_type, "occupancy_flight_sec", HOFFSET(h5_sector_metrics_t, occupancy_flight_sec), H5T_NATIVE_DOUBLE);
+	H5Tinsert(mem_sector_type, "mean_count", HOFFSET(h5_sector_metrics_t, mean_count), H5T_NATIVE_DOUBLE);
+
+	hid_t file_sector_type = H5Tcreate(H5T_COMPOUND, TRAFFIC_METRICS_H5_NAME_LEN + 4*H5Tget_size(H5T_IEEE_F64LE) + 2*H5Tget_size(H5T_STD_I32LE));
+	size_t offset = 0;
+	H5Tinsert(file_sector_type, "name", offset, string_type);
+	offset += TRAFFIC_METRICS_H5_NAME_LEN;
+	H5Tinsert(file_sector_type, "bin_start_sec", offset, H5T_IEEE_F64LE);
+	offset += H5Tget_size(H5T_IEEE_F64LE);
+	H5Tinsert(file_sector_type, "bin_end_sec", offset, H5T_IEEE_F64LE);
+	offset += H5Tget_size(H5T_IEEE_F64LE);
+	H5Tinsert(file_sector_type, "entries", offset, H5T_STD_I32LE);
+	offset += H5Tget_size(H5T_STD_I32LE);
+	H5Tinsert(file_sector_type, "peak_count", offset, H5T_STD_I32LE);
+	offset += H5Tget_size(H5T_STD_I32LE);
+	H5Tinsert(file_sector_type, "occupancy_flight_sec", offset, H5T_IEEE_F64LE);
+	offset += H5Tget_size(H5T_IEEE_F64LE);
+	H5Tinsert(file_sector_type, "mean_count", offset, H5T_IEEE_F64LE);
+
+	hid_t mem_airport_type = H5Tcreate(H5T_COMPOUND, sizeof(h5_airport_metrics_t));
+	H5Tinsert(mem_airport_type, "name", HOFFSET(h5_airport_metrics_t, name), string_type);
+	H5Tinsert(mem_airport_type, "bin_start_sec", HOFFSET(h5_airport_metrics_t, bin_start_sec), H5T_NATIVE_DOUBLE);
+	H5Tinsert(mem_airport_type, "bin_end_sec", HOFFSET(h5_airport_metrics_t, bin_end_sec), H5T_NATIVE_DOUBLE);
+	H5Tinsert(mem_airport_type, "departures", HOFFSET(h5_airport_metrics_t, departures), H5T_NATIVE_INT);
+	H5Tinsert(mem_airport_type, "arrivals", HOFFSET(h5_airport_metrics_t, arrivals), H5T_NATIVE_INT);
+
+	hid_t file_airport_type = H5Tcreate(H5T_COMPOUND, TRAFFIC_METRICS_H5_NAME_LEN + 2*H5Tget_size(H5T_IEEE_F64LE) + 2*H5Tget_size(H5T_STD_I32LE));
+	offset = 0;
+	H5Tinsert(file_airport_type, "name", offset, string_type);
+	offset += TRAFFIC_METRICS_H5_NAME_LEN;
+	H5Tinsert(file_airport_type, "bin_start_sec", offset, H5T_IEEE_F64LE);
+	offset += H5Tget_size(H5T_IEEE_F64LE);
+	H5Tinsert(file_airport_type, "bin_end_sec", offset, H5T_IEEE_F64LE);
+	offset += H5Tget_size(H5T_IEEE_F64LE);
+	H5Tinsert(file_airport_type, "departures", offset, H5T_STD_I32LE);
+	offset += H5Tget_size(H5T_STD_I32LE);
+	H5Tinsert(file_airport_type, "arrivals", offset, H5T_STD_I32LE);
+
+	herr_t status = 0;
+
+	hsize_t dims[1] = {sector_records.size()};
+	hid_t dataspace = H5Screate_simple(1, dims, NULL);
+	hid_t dataset = H5Dcreate2(file, "/sector_metrics", file_sector_type, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	if (dataset >= 0) {
+		if (H5Dwrite(dataset, mem_sector_type, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+				(dims[0] > 0) ? &sector_records[0] : NULL) < 0)
+			status = -1;
+		write_traffic_metrics_h5_bin_sec(dataset, metrics.bin_sec);
+		H5Dclose(dataset);
+	} else {
+		status = -1;
+	}
+	H5Sclose(dataspace);
+
+	dims[0] = airport_records.size();
+	dataspace = H5Screate_simple(1, dims, NULL);
+	dataset = H5Dcreate2(file, "/airport_metrics", file_airport_type, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	if (dataset >= 0) {
+		if (H5Dwrite(dataset, mem_airport_type, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+				(dims[0] > 0) ? &airport_records[0] : NULL) < 0)
+			status = -1;
+		write_traffic_metrics_h5_bin_sec(dataset, metrics.bin_sec);
+		H5Dclose(dataset);
+	} else {
+		status = -1;
+	}
+	H5Sclose(dataspace);
+
+	H5Tclose(file_airport_type);
+	H5Tclose(mem_airport_type);
+	H5Tclose(file_sector_type);
+	H5Tclose(mem_sector_type);
+	H5Tclose(string_type);
+	H5Fclose(file);
+
+	if (status < 0) {
+		printf("Can't write traffic metrics file %s\n", fname.c_str());
+
+		return -1;
+	}
+
+	return 0;
+}
+
+int write_traffic_metrics(const string& fname) {
+	if (fname.empty())
+		return -1;
+
+	traffic_metrics_t metrics;
+	get_traffic_metrics(&metrics);
+
+	string extension;
+	size_t dot_pos = fname.find_last_of(".");
+	if (dot_pos != string::npos) {
+		extension = fname.substr(dot_pos);
+		transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	}
+
+	if (extension == ".h5") {
+		return write_traffic_metrics_h5(fname, metrics);
+	}
+
+	return write_traffic_metrics_csv(fname, metrics);
+}
+
+void finish_traffic_metrics() {
+	if (!flag_enable_traffic_metrics)
+		return;
+
+	traffic_metrics_t metrics;
+	get_traffic_metrics(&metrics);
+
+	long cnt_entries = 0;
+	for (unsigned int s = 0; s < metrics.sector_bins.size(); s++) {
+		for (unsigned int b = 0; b < metrics.sector_bins[s].size(); b++) {
+			cnt_entries += metrics.sector_bins[s][b].entries;
+		}
+	}
+
+	long cnt_departures = 0;
+	long cnt_arrivals = 0;
+	for (unsigned int a = 0; a < metrics.airport_bins.size(); a++) {
+		for (unsigned int b = 0; b < metrics.airport_bins[a].size(); b++) {
+			cnt_departures += metrics.airport_bins[a][b].departures;
+			cnt_arrivals += metrics.airport_bins[a][b].arrivals;
+		}
+	}
+
+	printf("Traffic metrics: %d bins of %.0f sec, %ld sector entries, %ld departures, %ld arrivals\n",
+			get_num_bins(metrics),
+			metrics.bin_sec,
+			cnt_entries,
+			cnt_departures,
+			cnt_arrivals);
+
+	if (!traffic_metrics_output_file.empty()) {
+		if (write_traffic_metrics(traffic_metrics_output_file) == 0) {
+			printf("Traffic metrics written to %s\n", traffic_metrics_output_file.c_str());
+		}
+	}
+}
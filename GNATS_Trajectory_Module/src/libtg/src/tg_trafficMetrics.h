@@ -0,0 +1,134 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_trafficMetrics.h
+ *
+ * Streaming sector and airport traffic metrics.
+ *
+ * The collector runs once per time step on the synchronized host states.
+ * Each airborne flight is located in a sector, starting the search from
+ * the sector it was in at the previous step, and the statistics of the
+ * running time bin are accumulated in place:
+ *
+ *   sector   entries, peak instantaneous count and occupancy, the integral
+ *            of the aircraft count over the bin in flight-seconds.  The
+ *            mean count of a bin is occupancy / bin length.
+ *   airport  departures (ground to airborne) and arrivals (airborne to
+ *            touchdown) of the flights' origin and destination airports.
+ *
+ * Sectors sharing a name (the strata of one sector) are counted as one.
+ * Bins are numbered from simulation time zero.  When the bin length is
+ * not a multiple of the time step, a step straddling a bin boundary is
+ * credited to the bin in which it starts.
+ *
+ * The collector is off by default.  Results can be read at any time during
+ * the run and are written at the end of the run when an output file is
+ * configured.
+ */
+
+#ifndef TG_TRAFFICMETRICS_H_
+#define TG_TRAFFICMETRICS_H_
+
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+#define TRAFFIC_METRICS_DEFAULT_BIN_SEC 900.0
+
+typedef struct _sector_metrics_bin_t {
+	int entries;
+	int peak_count;
+	double occupancy_flight_sec;
+} sector_metrics_bin_t;
+
+typedef struct _airport_metrics_bin_t {
+	int departures;
+	int arrivals;
+} airport_metrics_bin_t;
+
+typedef struct _traffic_metrics_t {
+	float bin_sec;
+
+	vector<string> sector_names;
+	vector<string> airport_codes;
+
+	// Indexed [sector or airport][bin]
+	vector<vector<sector_metrics_bin_t> > sector_bins;
+	vector<vector<airport_metrics_bin_t> > airport_bins;
+} traffic_metrics_t;
+
+extern bool flag_enable_traffic_metrics;
+
+extern traffic_metrics_t g_traffic_metrics;
+
+// Per-flight collector state, indexed by flight
+extern vector<int> h_traffic_metrics_sector_index;
+extern vector<int> h_traffic_metrics_flight_status;
+extern vector<int> h_traffic_metrics_origin_slot;
+extern vector<int> h_traffic_metrics_destination_slot;
+
+/*
+ * Set the bin length and the sectors and airports to collect.  An empty
+ * selection collects all of them.  When fname is not empty the metrics
+ * are written to it at the end of the run.  Takes effect at the start of
+ * the next propagation run.
+ */
+int set_traffic_metrics_config(const float& bin_sec,
+		const vector<string>& sector_names,
+		const vector<string>& airport_codes,
+		const string& fname);
+
+// Reset the collector for a new propagation run
+void init_traffic_metrics(const int& num_flights);
+
+/*
+ * Accumulate the state at simulation time t into the running bin.  The
+ * state is held for t_step seconds.  Does nothing unless the collector is
+ * enabled.
+ */
+void update_traffic_metrics(const float& t, const float& t_step);
+
+// Copy of the metrics collected so far
+int get_traffic_metrics(traffic_metrics_t* const metrics);
+
+/*
+ * Write the metrics collected so far.  Files ending in ".h5" are written
+ * as HDF5, anything else as CSV.  Returns 0 on success and -1 otherwise.
+ */
+int write_traffic_metrics(const string& fname);
+
+/*
+ * Write the metrics to the configured output file, if any, and print a
+ * one-line summary
+ */
+void finish_traffic_metrics();
+
+#endif /* TG_TRAFFICMETRICS_H_ */
@@ -0,0 +1,453 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_wake.cpp
+ *
+ * Wake vortex generation, transport and encounter detection.
+ */
+
+#include "tg_wake.h"
+#include "tg_adb.h"
+#include "tg_aircraft.h"
+#include "tg_simulation.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+#define WAKE_GRAVITY_MPS2     9.80665
+#define WAKE_FT_PER_M         3.2808399
+#define WAKE_FT_PER_DEG_LAT   (60.0 * 6076.12)
+#define WAKE_GRID_MAX_LAT_DEG 80.0
+
+// Bits per axis of a packed grid cell key
+#define WAKE_GRID_KEY_BITS 21
+
+typedef unsigned long long wake_cell_key_t;
+
+typedef struct _wake_generator_t {
+	double mass_kg;
+	double span_m;
+	adb_wake_category_e category;
+} wake_generator_t;
+
+/*
+ * host-side global variables
+ */
+bool flag_enable_wake_vortex_model = false;
+
+vector<wake_segment_t> g_wake_segments;
+vector<wake_encounter_t> g_wake_encounters;
+
+vector<int> h_wake_encounter_generator;
+
+float t_last_wake_update = -1;
+
+static vector<wake_generator_t> wake_generators;
+
+// Typical mass and span by wake category, used when the ADB model is unknown
+static const double wake_category_mass_kg[] = {5000.0, 60000.0, 200000.0, 400000.0};
+static const double wake_category_span_m[] = {15.0, 34.0, 60.0, 70.0};
+
+// Circulation a follower of each wake category tolerates, m^2/sec
+static const float wake_hazard_circulation_m2ps[] = {50.0, 120.0, 200.0, 250.0};
+
+static inline int pack_wake_cell_key(const long long& c_lat, const long long& c_lon, const long long& c_alt, wake_cell_key_t* const key) {
+	const long long offset = 1LL << (WAKE_GRID_KEY_BITS - 1);
+	const wake_cell_key_t mask = (1ULL << WAKE_GRID_KEY_BITS) - 1;
+
+	*key = (((wake_cell_key_t)(c_lat + offset) & mask) << (2 * WAKE_GRID_KEY_BITS))
+			| (((wake_cell_key_t)(c_lon + offset) & mask) << WAKE_GRID_KEY_BITS)
+			| ((wake_cell_key_t)(c_alt + offset) & mask);
+
+	return 0;
+}
+
+// ISA air density, kg/m^3
+static double isa_density_kgpm3(const double& alt_ft) {
+	const double h_m = max(0.0, alt_ft / WAKE_FT_PER_M);
+
+	if (h_m < 11000.0)
+		return 1.225 * pow(1.0 - 2.25577e-5 * h_m, 4.25588);
+
+	return 0.36392 * exp(-(h_m - 11000.0) / 6341.62);
+}
+
+static bool is_wake_generating_phase(const ENUM_Flight_Phase& flight_phase) {
+	return ((FLIGHT_PHASE_TAKEOFF <= flight_phase) && (flight_phase <= FLIGHT_PHASE_GO_AROUND))
+			|| (flight_phase == FLIGHT_PHASE_HOLDING);
+}
+
+static double get_circulation(const wake_segment_t& segment) {
+	const double t_star = segment.age_sec / segment.t0_sec;
+	if (t_star < WAKE_DECAY_ONSET)
+		return segment.circulation0_m2ps;
+
+	return segment.circulation0_m2ps * exp(-WAKE_DECAY_RATE * (t_star - WAKE_DECAY_ONSET));
+}
+
+/*
+ * Offset of a point from the nearest point of a segment, in a local
+ * east/north/up frame, ft.
+ */
+static void get_segment_offset(const wake_segment_t& segment,
+		const double& lat_deg,
+		const double& lon_deg,
+		const double& alt_ft,
+		double* const east_ft,
+		double* const north_ft,
+		double* const up_ft) {
+	const double dx = (lon_deg - segment.longitude_deg) * WAKE_FT_PER_DEG_LAT * cos(segment.latitude_deg * M_PI / 180.0);
+	const double dy = (lat_deg - segment.latitude_deg) * WAKE_FT_PER_DEG_LAT;
+
+	const double sin_course = sin(segment.course_rad);
+	const double cos_course = cos(segment.course_rad);
+
+	// Clamp the along-track coordinate to the segment
+	const double along = dx * sin_course + dy * cos_course;
+	const double along_clamped = max(-segment.half_length_ft, min(segment.half_length_ft, along));
+
+	*east_ft = dx - along_clamped * sin_course;
+	*north_ft = dy - along_clamped * cos_course;
+	*up_ft = alt_ft - segment.altitude_ft;
+}
+
+static void init_wake_generators(const int& num_flights) {
+	wake_generators.assign(num_flights, wake_generator_t());
+
+	for (int i = 0; i < num_flights; i++) {
+		wake_generator_t& generator = wake_generators[i];
+		const int adb_index = h_aircraft_soa.adb_aircraft_type_index[i];
+
+		if ((0 <= adb_index) && (adb_index < (int)g_adb_opf_models.size())) {
+			const AdbOPFModel& model = g_adb_opf_models.at(adb_index);
+
+			generator.category = model.wakeCategory;
+			generator.mass_kg = model.mref * 0.45359237;
+			generator.span_m = sqrt(WAKE_WING_ASPECT_RATIO * model.s * 0.09290304);
+		} else {
+			generator.category = MEDIUM;
+			generator.mass_kg = 0;
+			generator.span_m = 0;
+		}
+
+		if ((generator.mass_kg <= 0) || (generator.span_m <= 0)) {
+			generator.mass_kg = wake_category_mass_kg[generator.category];
+			generator.span_m = wake_category_span_m[generator.category];
+		}
+	}
+}
+
+void init_wake_vortices(const int& num_flights) {
+	g_wake_segments.clear();
+	g_wake_encounters.clear();
+	h_wake_encounter_generator.assign(num_flights, -1);
+	t_last_wake_update = -1;
+
+	init_wake_generators(num_flights);
+}
+
+/*
+ * Shed a segment behind the flight covering the track flown in the last
+ * dt seconds.  Returns false when the flight generates no wake.
+ */
+static bool shed_wake_segment(const int& flight_index, const double& dt, wake_segment_t* const segment) {
+	if (!is_wake_generating_phase(h_aircraft_soa.flight_phase[flight_index]))
+		return false;
+
+	const wake_generator_t& generator = wake_generators[flight_index];
+
+	const double airspeed_mps = h_aircraft_soa.tas_knots[flight_index] * 0.514444;
+	if (airspeed_mps < WAKE_MIN_AIRSPEED_MPS)
+		return false;
+
+	const double altitude_ft = h_aircraft_soa.altitude_ft[flight_index];
+	const double b0 = M_PI / 4.0 * generator.span_m;
+	const double circulation0 = generator.mass_kg * WAKE_GRAVITY_MPS2 / (isa_density_kgpm3(altitude_ft) * airspeed_mps * b0);
+	const double w0 = circulation0 / (2.0 * M_PI * b0);
+
+	const double course = h_aircraft_soa.course_rad[flight_index];
+	const double half_length_ft = h_aircraft_soa.tas_knots_ground[flight_index] * KNOTS_TO_FPS * dt / 2.0;
+	const double lat_deg = h_aircraft_soa.latitude_deg[flight_index];
+
+	segment->generator_index = flight_index;
+	segment->latitude_deg = lat_deg - half_length_ft * cos(course) / WAKE_FT_PER_DEG_LAT;
+	segment->longitude_deg = h_aircraft_soa.longitude_deg[flight_index]
+			- half_length_ft * sin(course) / (WAKE_FT_PER_DEG_LAT * cos(lat_deg * M_PI / 180.0));
+	segment->altitude_ft = altitude_ft;
+	segment->course_rad = course;
+	segment->half_length_ft = half_length_ft;
+	segment->age_sec = 0;
+	segment->circulation0_m2ps = circulation0;
+	segment->circulation_m2ps = circulation0;
+	segment->b0_m = b0;
+	segment->t0_sec = b0 / w0;
+
+	return true;
+}
+
+static void transport_wake_segments(const float& t, const double& dt) {
+	const int num_segments = g_wake_segments.size();
+
+#pragma omp parallel for schedule(static)
+	for (int k = 0; k < num_segments; k++) {
+		wake_segment_t& segment = g_wake_segments[k];
+
+		real_t wind_east_fps = 0;
+		real_t wind_north_fps = 0;
+		get_wind_field_components(t, segment.latitude_deg, segment.longitude_deg, segment.altitude_ft, &wind_east_fps, &wind_north_fps);
+
+		const double sink_fps = segment.circulation_m2ps / (2.0 * M_PI * segment.b0_m) * WAKE_FT_PER_M;
+
+		segment.latitude_deg += wind_north_fps * dt / WAKE_FT_PER_DEG_LAT;
+		segment.longitude_deg += wind_east_fps * dt / (WAKE_FT_PER_DEG_LAT * cos(segment.latitude_deg * M_PI / 180.0));
+		segment.altitude_ft -= sink_fps * dt;
+		segment.age_sec += dt;
+		segment.circulation_m2ps = get_circulation(segment);
+	}
+
+	// Drop expired segments, keeping the order of the rest
+	vector<wake_segment_t>::iterator ite_end = remove_if(g_wake_segments.begin(), g_wake_segments.end(),
+			[](const wake_segment_t& segment) {
+				return (segment.age_sec > WAKE_MAX_AGE_SEC)
+						|| (segment.circulation_m2ps < WAKE_MIN_CIRCULATION_FRACTION * segment.circulation0_m2ps)
+						|| (segment.altitude_ft <= 0);
+			});
+	g_wake_segments.erase(ite_end, g_wake_segments.end());
+}
+
+static void detect_wake_encounters(const float& t) {
+	const int num_flights = wake_generators.size();
+	const int num_segments = g_wake_segments.size();
+
+	// Size the cells so that every segment a follower can touch lies in
+	// the follower's cell or a neighbouring one
+	double reach_ft = WAKE_GRID_CELL_MIN_FT;
+	double alt_cell_ft = WAKE_GRID_ALT_CELL_FT;
+	double max_abs_lat_deg = 0;
+	for (int k = 0; k < num_segments; k++) {
+		const wake_segment_t& segment = g_wake_segments[k];
+		const double b0_ft = segment.b0_m * WAKE_FT_PER_M;
+
+		reach_ft = max(reach_ft, segment.half_length_ft + b0_ft);
+		alt_cell_ft = max(alt_cell_ft, b0_ft);
+		max_abs_lat_deg = max(max_abs_lat_deg, fabs(segment.latitude_deg));
+	}
+
+	const double cell_lat_deg = reach_ft / WAKE_FT_PER_DEG_LAT;
+	const double cell_lon_deg = cell_lat_deg / cos(min(max_abs_lat_deg + cell_lat_deg, WAKE_GRID_MAX_LAT_DEG) * M_PI / 180.0);
+
+	vector<pair<wake_cell_key_t, int> > cells(num_segments);
+
+#pragma omp parallel for schedule(static)
+	for (int k = 0; k < num_segments; k++) {
+		const wake_segment_t& segment = g_wake_segments[k];
+
+		pack_wake_cell_key((long long)floor(segment.latitude_deg / cell_lat_deg),
+				(long long)floor(segment.longitude_deg / cell_lon_deg),
+				(long long)floor(segment.altitude_ft / alt_cell_ft),
+				&cells[k].first);
+		cells[k].second = k;
+	}
+
+	sort(cells.begin(), cells.end());
+
+	vector<int> encounter_segment(num_flights, -1);
+
+#pragma omp parallel for schedule(dynamic, 16)
+	for (int i = 0; i < num_flights; i++) {
+		if (!is_wake_generating_phase(h_aircraft_soa.flight_phase[i]))
+			continue;
+
+		const double lat_deg = h_aircraft_soa.latitude_deg[i];
+		const double lon_deg = h_aircraft_soa.longitude_deg[i];
+		const double alt_ft = h_aircraft_soa.altitude_ft[i];
+		const float hazard_circulation = wake_hazard_circulation_m2ps[wake_generators[i].category];
+
+		const long long c_lat = (long long)floor(lat_deg / cell_lat_deg);
+		const long long c_lon = (long long)floor(lon_deg / cell_lon_deg);
+		const long long c_alt = (long long)floor(alt_ft / alt_cell_ft);
+
+		int best_segment = -1;
+		for (int d_lat = -1; d_lat <= 1; d_lat++) {
+			for (int d_lon = -1; d_lon <= 1; d_lon++) {
+				for (int d_alt = -1; d_alt <= 1; d_alt++) {
+					wake_cell_key_t key;
+					pack_wake_cell_key(c_lat + d_lat, c_lon + d_lon, c_alt + d_alt, &key);
+
+					vector<pair<wake_cell_key_t, int> >::const_iterator ite = lower_bound(cells.begin(), cells.end(), make_pair(key, 0));
+					for (; (ite != cells.end()) && (ite->first == key); ++ite) {
+						const wake_segment_t& segment = g_wake_segments[ite->second];
+						if ((segment.generator_index == i) || (segment.circulation_m2ps < hazard_circulation))
+							continue;
+
+						double east_ft, north_ft, up_ft;
+						get_segment_offset(segment, lat_deg, lon_deg, alt_ft, &east_ft, &north_ft, &up_ft);
+
+						const double b0_ft = segment.b0_m * WAKE_FT_PER_M;
+						if ((east_ft * east_ft + north_ft * north_ft > b0_ft * b0_ft) || (fabs(up_ft) > b0_ft))
+							continue;
+
+						// Strongest wake wins, the lower segment index breaks ties
+						if ((best_segment < 0)
+								|| (segment.circulation_m2ps > g_wake_segments[best_segment].circulation_m2ps)
+								|| ((segment.circulation_m2ps == g_wake_segments[best_segment].circulation_m2ps) && (ite->second < best_segment))) {
+							best_segment = ite->second;
+						}
+					}
+				}
+			}
+		}
+
+		encounter_segment[i] = best_segment;
+	}
+
+	// An encounter is recorded when a flight enters the wake of a new generator
+	for (int i = 0; i < num_flights; i++) {
+		const int k = encounter_segment[i];
+		const int generator_index = (k < 0) ? -1 : g_wake_segments[k].generator_index;
+
+		if ((generator_index > -1) && (generator_index != h_wake_encounter_generator[i])) {
+			const wake_segment_t& segment = g_wake_segments[k];
+
+			double east_ft, north_ft, up_ft;
+			get_segment_offset(segment, h_aircraft_soa.latitude_deg[i], h_aircraft_soa.longitude_deg[i], h_aircraft_soa.altitude_ft[i], &east_ft, &north_ft, &up_ft);
+
+			wake_encounter_t encounter;
+			encounter.time = t;
+			encounter.follower_index = i;
+			encounter.generator_index = generator_index;
+			encounter.circulation_m2ps = segment.circulation_m2ps;
+			encounter.lateral_distance_ft = sqrt(east_ft * east_ft + north_ft * north_ft);
+			encounter.vertical_distance_ft = up_ft;
+
+			g_wake_encounters.push_back(encounter);
+		}
+
+		h_wake_encounter_generator[i] = generator_index;
+	}
+}
+
+void update_wake_vortices(const float& t) {
+	const int num_flights = wake_generators.size();
+	if ((!flag_enable_wake_vortex_model) || (num_flights == 0))
+		return;
+
+	const double dt = (t_last_wake_update < 0) ? 0.0 : max(0.0, (double)(t - t_last_wake_update));
+
+	transport_wake_segments(t, dt);
+
+	vector<wake_segment_t> new_segments(num_flights);
+	vector<char> flag_shed(num_flights, 0);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < num_flights; i++) {
+		flag_shed[i] = shed_wake_segment(i, dt, &new_segments[i]);
+	}
+
+	for (int i = 0; i < num_flights; i++) {
+		if (flag_shed[i]) {
+			g_wake_segments.push_back(new_segments[i]);
+		}
+	}
+
+	detect_wake_encounters(t);
+
+	t_last_wake_update = t;
+}
+
+int get_wake_encounter_generator(const int& flight_index) {
+	if ((flight_index < 0) || (flight_index >= (int)h_wake_encounter_generator.size()))
+		return -1;
+
+	return h_wake_encounter_generator.at(flight_index);
+}
+
+int compute_rate_of_approach_to_wake(const int& generator_index,
+		const int& follower_index,
+		double* const rate_fps) {
+	if ((!rate_fps) || (follower_index < 0) || (follower_index >= get_num_flights()))
+		return -1;
+
+	const double lat_deg = h_aircraft_soa.latitude_deg[follower_index];
+	const double lon_deg = h_aircraft_soa.longitude_deg[follower_index];
+	const double alt_ft = h_aircraft_soa.altitude_ft[follower_index];
+
+	// Nearest live segment of the generator
+	int nearest_segment = -1;
+	double nearest_distance_sq = 0;
+	double nearest_offset[3] = {0, 0, 0};
+	for (unsigned int k = 0; k < g_wake_segments.size(); k++) {
+		if (g_wake_segments[k].generator_index != generator_index)
+			continue;
+
+		double offset[3];
+		get_segment_offset(g_wake_segments[k], lat_deg, lon_deg, alt_ft, &offset[0], &offset[1], &offset[2]);
+
+		const double distance_sq = offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2];
+		if ((nearest_segment < 0) || (distance_sq < nearest_distance_sq)) {
+			nearest_segment = k;
+			nearest_distance_sq = distance_sq;
+			copy(offset, offset + 3, nearest_offset);
+		}
+	}
+
+	if (nearest_segment < 0)
+		return -1;
+
+	*rate_fps = 0;
+	if (nearest_distance_sq <= 0)
+		return 0;
+
+	const wake_segment_t& segment = g_wake_segments[nearest_segment];
+
+	real_t wind_east_fps = 0;
+	real_t wind_north_fps = 0;
+	get_wind_field_components(t_last_wake_update, segment.latitude_deg, segment.longitude_deg, segment.altitude_ft, &wind_east_fps, &wind_north_fps);
+
+	const double ground_speed_fps = h_aircraft_soa.tas_knots_ground[follower_index] * KNOTS_TO_FPS;
+	const double course = h_aircraft_soa.course_rad[follower_index];
+
+	// Follower velocity relative to the drifting, sinking segment
+	const double v_east = ground_speed_fps * sin(course) - wind_east_fps;
+	const double v_north = ground_speed_fps * cos(course) - wind_north_fps;
+	const double v_up = h_aircraft_soa.rocd_fps[follower_index]
+			+ segment.circulation_m2ps / (2.0 * M_PI * segment.b0_m) * WAKE_FT_PER_M;
+
+	// The offset points from the segment to the follower, so closing
+	// speed is the negative of its rate of change
+	*rate_fps = -(nearest_offset[0] * v_east + nearest_offset[1] * v_north + nearest_offset[2] * v_up) / sqrt(nearest_distance_sq);
+
+	return 0;
+}
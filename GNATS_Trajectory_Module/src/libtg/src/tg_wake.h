@@ -0,0 +1,130 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * tg_wake.h
+ *
+ * Wake vortex generation, transport and encounter detection.
+ *
+ * Every update, each airborne aircraft sheds one wake segment covering the
+ * track flown since the previous update.  The initial circulation of the
+ * vortex pair follows from lift balance,
+ *
+ *     gamma0 = m g / (rho V b0),   b0 = pi/4 * span,
+ *
+ * with mass and wing span taken from the ADB OPF model of the aircraft.
+ * Segments drift with the loaded RAP winds, descend at the mutually
+ * induced velocity gamma / (2 pi b0) and keep their circulation for
+ * WAKE_DECAY_ONSET reference times t0 = b0 / w0 before decaying
+ * exponentially.
+ *
+ * Live segments are binned into a sorted lat/lon/altitude cell grid which
+ * is rebuilt every update.  A following aircraft encounters a segment when
+ * it is within the vortex spacing of the segment laterally and vertically
+ * and the remaining circulation exceeds the tolerance of its wake
+ * category.
+ *
+ * The model is off by default.  Enabling it changes how the WAKE aviation
+ * occurrence of the risk measures is detected.
+ */
+
+#ifndef TG_WAKE_H_
+#define TG_WAKE_H_
+
+#include <vector>
+
+using std::vector;
+
+#define WAKE_MAX_AGE_SEC                180.0
+#define WAKE_MIN_CIRCULATION_FRACTION     0.1  /* segments weaker than this share of gamma0 are dropped */
+#define WAKE_DECAY_ONSET                  1.5  /* t0 units */
+#define WAKE_DECAY_RATE                   1.0  /* per t0 */
+#define WAKE_MIN_AIRSPEED_MPS            30.0
+#define WAKE_WING_ASPECT_RATIO            8.5
+
+#define WAKE_GRID_CELL_MIN_FT          6000.0
+#define WAKE_GRID_ALT_CELL_FT          1000.0
+
+typedef struct _wake_segment_t {
+	int generator_index;
+
+	// Segment center, oriented along the generator course
+	double latitude_deg;
+	double longitude_deg;
+	double altitude_ft;
+	double course_rad;
+	double half_length_ft;
+
+	float age_sec;
+	float circulation0_m2ps;
+	float circulation_m2ps;
+	float b0_m;    // vortex spacing
+	float t0_sec;  // reference time b0 / w0
+} wake_segment_t;
+
+typedef struct _wake_encounter_t {
+	float time;  // simulation time, sec
+	int follower_index;
+	int generator_index;
+	float circulation_m2ps;
+	float lateral_distance_ft;
+	float vertical_distance_ft;  // follower altitude above the segment
+} wake_encounter_t;
+
+extern bool flag_enable_wake_vortex_model;
+
+extern vector<wake_segment_t> g_wake_segments;
+extern vector<wake_encounter_t> g_wake_encounters;
+
+// Generator whose wake each flight is currently inside, -1 if none
+extern vector<int> h_wake_encounter_generator;
+
+extern float t_last_wake_update;
+
+// Reset the wake state and the per-flight generator data for a new propagation run
+void init_wake_vortices(const int& num_flights);
+
+/*
+ * Shed new segments, transport and decay the live ones to time t and
+ * record encounters of following aircraft.  Does nothing unless the wake
+ * model is enabled.
+ */
+void update_wake_vortices(const float& t);
+
+int get_wake_encounter_generator(const int& flight_index);
+
+/*
+ * Rate at which the follower closes on the nearest live wake segment of
+ * the generator, ft/sec.  Returns 0 on success and -1 when the generator
+ * has no live segments.
+ */
+int compute_rate_of_approach_to_wake(const int& generator_index,
+		const int& follower_index,
+		double* const rate_fps);
+
+#endif /* TG_WAKE_H_ */
@@ -0,0 +1,475 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_aircraft_index.cpp
+ *
+ * Equivalence test of the aircraft index against the linear scan of
+ * h_aircraft_soa that getAircraftIds carried before it.
+ *
+ * The demo flight is loaded under many call signs and its host positions
+ * are then overwritten.  Many flights sit exactly on whole degrees, which
+ * are grid cell edges and the edges of most query boxes, and on whole
+ * thousands of feet, which are the edges of the altitude bands.  A few sit
+ * on the poles and the antimeridian, outside the grid or at NaN.  Range
+ * queries are also run with the range set to the exact distance of a
+ * flight.
+ */
+
+#include "tg_api.h"
+#include "tg_aircraft.h"
+#include "tg_aircraftIndex.h"
+
+#include "geometry_utils.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace osi;
+
+#define TEST_NUM_FLIGHTS 400
+#define TEST_NUM_ROUNDS 2
+#define TEST_NUM_RANDOM_BOXES 300
+#define TEST_NUM_RANDOM_CENTERS 200
+#define TEST_SEED 24680
+
+static const string TEST_TRX_FILE = "share/tg/trx/TRX_DEMO_SFO_PHX_GateToGate_geo.trx";
+static const string TEST_MFL_FILE = "share/tg/trx/TRX_DEMO_SFO_PHX_mfl.trx";
+static const string TEST_ACID = "SWA1897";
+
+static unsigned int test_rand_state = TEST_SEED;
+
+// Uniform in [lo, hi), repeatable across platforms
+static double test_uniform(const double lo, const double hi) {
+	test_rand_state = test_rand_state * 1103515245u + 12345u;
+
+	return lo + (hi - lo) * ((test_rand_state >> 8) / 16777216.);
+}
+
+static int test_rand_int(const int lo, const int hi) {
+	return lo + (int)floor(test_uniform(0, hi - lo + 1));
+}
+
+static string make_acid(const int number) {
+	char tmpAcid[16];
+	snprintf(tmpAcid, sizeof(tmpAcid), "TST%04d", number);
+
+	return string(tmpAcid);
+}
+
+/*
+ * Write TRX and MFL files holding num_flights copies of the demo flight.
+ */
+static int write_test_trx(const string& trx_file, const string& mfl_file, const int num_flights) {
+	ifstream in(TEST_TRX_FILE.c_str());
+	if (!in.is_open())
+		return 1;
+
+	string line_time;
+	string line_track;
+	string line_route;
+	getline(in, line_time);
+	getline(in, line_track);
+	getline(in, line_route);
+	in.close();
+
+	const size_t pos_acid = line_track.find(TEST_ACID);
+	if (pos_acid == string::npos)
+		return 1;
+
+	ofstream trx(trx_file.c_str());
+	ofstream mfl(mfl_file.c_str());
+
+	trx << line_time << endl;
+	for (int i = 0; i < num_flights; i++) {
+		string tmpTrack = line_track;
+		tmpTrack.replace(pos_acid, TEST_ACID.length(), make_acid(i));
+
+		trx << tmpTrack << endl << line_route << endl;
+		mfl << make_acid(i) << " 330" << endl;
+	}
+	trx << endl;
+
+	return (trx.good() && mfl.good()) ? 0 : 1;
+}
+
+/*
+ * Overwrite the host positions.  Positions on whole degrees and whole
+ * thousands of feet are over-represented.
+ */
+static void set_test_positions(const int num_flights) {
+	for (int i = 0; i < num_flights; i++) {
+		real_t latitude;
+		real_t longitude;
+		real_t altitude;
+
+		switch (i % 4) {
+			case 0:
+				latitude = test_rand_int(30, 40);
+				longitude = test_rand_int(-120, -100);
+				break;
+			case 1:
+				latitude = test_rand_int(30, 40) + 0.5 * test_rand_int(0, 1);
+				longitude = test_rand_int(-120, -100) + 0.5 * test_rand_int(0, 1);
+				break;
+			case 2:
+				latitude = test_uniform(25., 49.);
+				longitude = test_uniform(-125., -67.);
+				break;
+			default:
+				latitude = test_uniform(-90., 90.);
+				longitude = test_uniform(-180., 180.);
+				break;
+		}
+
+		if (i % 3 == 0) {
+			altitude = 1000 * test_rand_int(0, 40);
+		} else {
+			altitude = test_uniform(0., 40000.);
+		}
+
+		h_aircraft_soa.latitude_deg[i] = latitude;
+		h_aircraft_soa.longitude_deg[i] = longitude;
+		h_aircraft_soa.altitude_ft[i] = altitude;
+	}
+
+	// Poles, antimeridian, outside the grid and undefined positions
+	const real_t special[][3] = {
+		{90, 0, 35000},
+		{-90, 45, 35000},
+		{0, 180, 20000},
+		{0, -180, 20000},
+		{10, 200, 10000},
+		{95, 0, 10000},
+		{NAN, -110, 30000},
+		{35, -110, NAN}
+	};
+	const int num_special = sizeof(special) / sizeof(special[0]);
+	for (int k = 0; (k < num_special) && (k < num_flights); k++) {
+		h_aircraft_soa.latitude_deg[k] = special[k][0];
+		h_aircraft_soa.longitude_deg[k] = special[k][1];
+		h_aircraft_soa.altitude_ft[k] = special[k][2];
+	}
+}
+
+// Altitude test of getAircraftIds before the index
+static bool scan_altitude_band(const real_t altitude_ft, const double minAltitude_ft, const double maxAltitude_ft) {
+	if ((minAltitude_ft >= 0) && (maxAltitude_ft >= 0)) {
+		if ((minAltitude_ft <= altitude_ft) &&
+				(altitude_ft < maxAltitude_ft)) {
+			return true;
+		}
+	} else if (minAltitude_ft >= 0) {
+		if (minAltitude_ft <= altitude_ft) {
+			return true;
+		}
+	} else if (maxAltitude_ft >= 0) {
+		if (altitude_ft < maxAltitude_ft) {
+			return true;
+		}
+	} else {
+		return true;
+	}
+
+	return false;
+}
+
+// getAircraftIds before the index
+static void scan_aircraft_in_box(const double minLatitude, const double maxLatitude,
+		const double minLongitude, const double maxLongitude,
+		const double minAltitude_ft, const double maxAltitude_ft,
+		vector<int>& flight_seqs) {
+	flight_seqs.clear();
+
+	int c_num_flights = get_num_flights();
+	for (int i = 0; i < c_num_flights; i++) {
+		if ((minLatitude <= h_aircraft_soa.latitude_deg[i]) &&
+				(h_aircraft_soa.latitude_deg[i] < maxLatitude) &&
+				(minLongitude <= h_aircraft_soa.longitude_deg[i]) &&
+				(h_aircraft_soa.longitude_deg[i] < maxLongitude)) {
+			if (scan_altitude_band(h_aircraft_soa.altitude_ft[i], minAltitude_ft, maxAltitude_ft)) {
+				flight_seqs.push_back(i);
+			}
+		}
+	}
+}
+
+static void scan_aircraft_within_range(const double latitude_deg, const double longitude_deg, const double range_ft,
+		const double minAltitude_ft, const double maxAltitude_ft,
+		vector<int>& flight_seqs) {
+	flight_seqs.clear();
+
+	int c_num_flights = get_num_flights();
+	for (int i = 0; i < c_num_flights; i++) {
+		if (scan_altitude_band(h_aircraft_soa.altitude_ft[i], minAltitude_ft, maxAltitude_ft) &&
+				(compute_distance_gc(latitude_deg, longitude_deg, h_aircraft_soa.latitude_deg[i], h_aircraft_soa.longitude_deg[i], 0) <= range_ft)) {
+			flight_seqs.push_back(i);
+		}
+	}
+}
+
+static string join_seqs(const vector<int>& seqs) {
+	ostringstream oss;
+	for (unsigned int i = 0; i < seqs.size(); i++) {
+		if (i > 0)
+			oss << ",";
+		oss << seqs[i];
+	}
+
+	return oss.str();
+}
+
+// Altitude bands as (min, max).  Negative bounds are unbounded.
+static const double TEST_BANDS[][2] = {
+	{-1, -1},
+	{10000, -1},
+	{-1, 20000},
+	{10000, 20000},
+	{20000, 10000},
+	{15000, 15000},
+	{0, 1000}
+};
+static const int TEST_NUM_BANDS = sizeof(TEST_BANDS) / sizeof(TEST_BANDS[0]);
+
+static int check_boxes(int& num_boundary) {
+	int num_failures = 0;
+
+	vector<vector<double> > boxes;
+
+	// Whole world, beyond the world, empty and inverted boxes
+	const double fixed[][4] = {
+		{-90, 90, -180, 180},
+		{-100, 100, -200, 300},
+		{35, 35, -110, -100},
+		{40, 30, -120, -100},
+		{-90, -89, -180, 180},
+		{-1, 1, 179, 181}
+	};
+	for (unsigned int k = 0; k < sizeof(fixed) / sizeof(fixed[0]); k++) {
+		boxes.push_back(vector<double>(fixed[k], fixed[k] + 4));
+	}
+
+	// Boxes with edges on whole and half degrees, where flights sit
+	for (int k = 0; k < TEST_NUM_RANDOM_BOXES; k++) {
+		vector<double> box(4);
+		if (k % 2 == 0) {
+			box[0] = 0.5 * test_rand_int(58, 80);
+			box[1] = box[0] + 0.5 * test_rand_int(1, 8);
+			box[2] = 0.5 * test_rand_int(-240, -200);
+			box[3] = box[2] + 0.5 * test_rand_int(1, 12);
+		} else {
+			box[0] = test_uniform(-90., 80.);
+			box[1] = box[0] + test_uniform(0., 20.);
+			box[2] = test_uniform(-180., 160.);
+			box[3] = box[2] + test_uniform(0., 40.);
+		}
+		boxes.push_back(box);
+	}
+
+	for (unsigned int k = 0; k < boxes.size(); k++) {
+		const vector<double>& box = boxes[k];
+
+		for (int b = 0; b < TEST_NUM_BANDS; b++) {
+			vector<int> expected;
+			scan_aircraft_in_box(box[0], box[1], box[2], box[3], TEST_BANDS[b][0], TEST_BANDS[b][1], expected);
+
+			vector<int> actual;
+			get_aircraft_in_box(box[0], box[1], box[2], box[3], TEST_BANDS[b][0], TEST_BANDS[b][1], actual);
+
+			if (actual != expected) {
+				printf("FAILED: box [%g, %g) x [%g, %g) band [%g, %g) holds [%s], index returned [%s]\n",
+						box[0], box[1], box[2], box[3], TEST_BANDS[b][0], TEST_BANDS[b][1],
+						join_seqs(expected).c_str(), join_seqs(actual).c_str());
+				num_failures++;
+			}
+
+			// Flights on an edge of the box or band
+			for (unsigned int j = 0; j < expected.size(); j++) {
+				const int i = expected[j];
+				if ((h_aircraft_soa.latitude_deg[i] == box[0]) || (h_aircraft_soa.longitude_deg[i] == box[2])
+						|| (h_aircraft_soa.altitude_ft[i] == TEST_BANDS[b][0]))
+					num_boundary++;
+			}
+		}
+	}
+
+	return num_failures;
+}
+
+static int check_ranges(int& num_boundary) {
+	int num_failures = 0;
+
+	const int num_flights = get_num_flights();
+
+	vector<double> latitudes;
+	vector<double> longitudes;
+	for (int i = 0; i < num_flights; i += 10) {
+		latitudes.push_back(h_aircraft_soa.latitude_deg[i]);
+		longitudes.push_back(h_aircraft_soa.longitude_deg[i]);
+	}
+	for (int k = 0; k < TEST_NUM_RANDOM_CENTERS; k++) {
+		latitudes.push_back(test_uniform(-90., 90.));
+		longitudes.push_back(test_uniform(-180., 180.));
+	}
+
+	const double ranges_mile[] = {0., 1., 50., 500., 3000.};
+	const int num_ranges = sizeof(ranges_mile) / sizeof(ranges_mile[0]);
+
+	for (unsigned int k = 0; k < latitudes.size(); k++) {
+		// The fixed ranges plus the exact distance of a flight
+		vector<double> ranges_ft;
+		for (int r = 0; r < num_ranges; r++) {
+			ranges_ft.push_back(5280 * ranges_mile[r]);
+		}
+
+		const int other = test_rand_int(0, num_flights - 1);
+		const double dist_other = compute_distance_gc(latitudes[k], longitudes[k],
+				h_aircraft_soa.latitude_deg[other], h_aircraft_soa.longitude_deg[other], 0);
+		if (!isnan(dist_other)) {
+			ranges_ft.push_back(dist_other);
+		}
+
+		for (unsigned int r = 0; r < ranges_ft.size(); r++) {
+			for (int b = 0; b < TEST_NUM_BANDS; b++) {
+				vector<int> expected;
+				scan_aircraft_within_range(latitudes[k], longitudes[k], ranges_ft[r], TEST_BANDS[b][0], TEST_BANDS[b][1], expected);
+
+				vector<int> actual;
+				get_aircraft_within_range(latitudes[k], longitudes[k], ranges_ft[r], TEST_BANDS[b][0], TEST_BANDS[b][1], actual);
+
+				if (actual != expected) {
+					printf("FAILED: within %.3f ft of (%.6f, %.6f) band [%g, %g) are [%s], index returned [%s]\n",
+							ranges_ft[r], latitudes[k], longitudes[k], TEST_BANDS[b][0], TEST_BANDS[b][1],
+							join_seqs(expected).c_str(), join_seqs(actual).c_str());
+					num_failures++;
+				}
+
+				if ((r == (unsigned int)num_ranges)
+						&& (find(expected.begin(), expected.end(), other) != expected.end()))
+					num_boundary++;
+			}
+		}
+	}
+
+	return num_failures;
+}
+
+static int check_altitude_bands(int& num_boundary) {
+	int num_failures = 0;
+
+	const int num_flights = get_num_flights();
+
+	for (int b = 0; b < TEST_NUM_BANDS; b++) {
+		vector<int> expected;
+		for (int i = 0; i < num_flights; i++) {
+			if (scan_altitude_band(h_aircraft_soa.altitude_ft[i], TEST_BANDS[b][0], TEST_BANDS[b][1])) {
+				expected.push_back(i);
+
+				if (h_aircraft_soa.altitude_ft[i] == TEST_BANDS[b][0])
+					num_boundary++;
+			}
+		}
+
+		vector<int> actual;
+		get_aircraft_in_altitude_band(TEST_BANDS[b][0], TEST_BANDS[b][1], actual);
+
+		if (actual != expected) {
+			printf("FAILED: band [%g, %g) holds [%s], index returned [%s]\n",
+					TEST_BANDS[b][0], TEST_BANDS[b][1],
+					join_seqs(expected).c_str(), join_seqs(actual).c_str());
+			num_failures++;
+		}
+	}
+
+	return num_failures;
+}
+
+int main() {
+	char tmpName[64];
+	snprintf(tmpName, sizeof(tmpName), "/tmp/test_aircraft_index_%d", (int)getpid());
+
+	const string trx_file = string(tmpName) + "_geo.trx";
+	const string mfl_file = string(tmpName) + "_mfl.trx";
+
+	if (write_test_trx(trx_file, mfl_file, TEST_NUM_FLIGHTS) != 0) {
+		printf("FAILED: Can't write %s from %s\n", trx_file.c_str(), TEST_TRX_FILE.c_str());
+
+		return 1;
+	}
+
+	if (tg_init() != 0) {
+		printf("FAILED: tg_init()\n");
+
+		return 1;
+	}
+
+	const int retLoad = tg_load_trx(trx_file, mfl_file);
+
+	unlink(trx_file.c_str());
+	unlink(mfl_file.c_str());
+
+	if ((retLoad != 0) || (get_num_flights() != TEST_NUM_FLIGHTS)) {
+		printf("FAILED: Loaded %d of %d flights\n", get_num_flights(), TEST_NUM_FLIGHTS);
+
+		return 1;
+	}
+
+	int num_failures = 0;
+	int num_box_boundary = 0;
+	int num_range_boundary = 0;
+	int num_band_boundary = 0;
+
+	// The second round checks that invalidation rebuilds the index
+	for (int round = 0; round < TEST_NUM_ROUNDS; round++) {
+		set_test_positions(TEST_NUM_FLIGHTS);
+		invalidate_aircraft_index();
+
+		num_failures += check_boxes(num_box_boundary);
+		num_failures += check_ranges(num_range_boundary);
+		num_failures += check_altitude_bands(num_band_boundary);
+	}
+
+	if ((num_box_boundary == 0) || (num_range_boundary == 0) || (num_band_boundary == 0)) {
+		printf("FAILED: boundary cases not reached, box %d, range %d, band %d\n",
+				num_box_boundary, num_range_boundary, num_band_boundary);
+		num_failures++;
+	}
+
+	printf("test_aircraft_index: %d flights, boundary hits box %d, range %d, band %d, %d failures\n",
+			TEST_NUM_FLIGHTS, num_box_boundary, num_range_boundary, num_band_boundary, num_failures);
+
+	return (num_failures == 0) ? 0 : 1;
+}
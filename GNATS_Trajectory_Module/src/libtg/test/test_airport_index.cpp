@@ -0,0 +1,314 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_airport_index.cpp
+ *
+ * Equivalence test of the airport index against the linear scans of
+ * map_airport that getClosestAirport and getAirportsWithinMiles carried
+ * before it.
+ *
+ * The closest-airport reference keeps the first airport in map order among
+ * equal distances.  The original scan never recorded the code of the first
+ * airport, so the reference records it; otherwise it is the original loop.
+ *
+ * The airport set mixes random positions with airports at identical
+ * positions and airports mirrored about the query points, so both queries
+ * see exact and near distance ties.  Range queries are also run with the range set
+ * to the exact distance of an airport.
+ */
+
+#include "tg_airportIndex.h"
+
+#include "geometry_utils.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace osi;
+
+#define TEST_NUM_RANDOM_AIRPORTS 3000
+#define TEST_NUM_RANDOM_QUERIES 2000
+#define TEST_NUM_TIE_QUERIES 50
+#define TEST_SEED 12345
+
+static unsigned int test_rand_state = TEST_SEED;
+
+// Uniform in [lo, hi), repeatable across platforms
+static double test_uniform(const double lo, const double hi) {
+	test_rand_state = test_rand_state * 1103515245u + 12345u;
+
+	return lo + (hi - lo) * ((test_rand_state >> 8) / 16777216.);
+}
+
+static void add_airport(map<string, NatsAirport*>& airports, const string& code, const double latitude, const double longitude) {
+	NatsAirport* airport = new NatsAirport();
+	airport->code = code;
+	airport->latitude = latitude;
+	airport->longitude = longitude;
+
+	airports[code] = airport;
+}
+
+static string make_code(const char* prefix, const int number) {
+	char tmpCode[16];
+	snprintf(tmpCode, sizeof(tmpCode), "%s%04d", prefix, number);
+
+	return string(tmpCode);
+}
+
+// getClosestAirport before the index, recording the first airport
+static string scan_closest_airport(const map<string, NatsAirport*>& airports, const double latitude, const double longitude) {
+	string tmp_closest_airport;
+	double tmp_min_distance = -1; // Reset
+
+	map<string, NatsAirport*>::const_iterator ite;
+	for (ite = airports.begin(); ite != airports.end(); ite++) {
+		NatsAirport* cur_airport_ptr = ite->second;
+		double cur_dist_to_airport = compute_distance_gc(latitude, longitude, cur_airport_ptr->latitude, cur_airport_ptr->longitude, 0);
+
+		if (tmp_min_distance == -1) {
+			tmp_min_distance = cur_dist_to_airport;
+			tmp_closest_airport = ite->first;
+		} else if (cur_dist_to_airport < tmp_min_distance) {
+			tmp_min_distance = cur_dist_to_airport; // Update
+			tmp_closest_airport = ite->first;
+		}
+	}
+
+	return tmp_closest_airport;
+}
+
+// getAirportsWithinMiles before the index
+static void scan_airports_within_range(const map<string, NatsAirport*>& airports, const double latitude, const double longitude, const double range_ft, vector<string>& airport_codes) {
+	airport_codes.clear();
+
+	map<string, NatsAirport*>::const_iterator ite;
+	for (ite = airports.begin(); ite != airports.end(); ite++) {
+		NatsAirport* cur_airport_ptr = ite->second;
+		double cur_dist_to_airport = compute_distance_gc(latitude, longitude, cur_airport_ptr->latitude, cur_airport_ptr->longitude, 0);
+		if (cur_dist_to_airport <= range_ft) {
+			airport_codes.push_back(ite->first);
+		}
+	}
+}
+
+// Number of airports at the smallest distance from the position
+static int count_closest_ties(const map<string, NatsAirport*>& airports, const double latitude, const double longitude) {
+	double min_distance = -1;
+	int count = 0;
+
+	map<string, NatsAirport*>::const_iterator ite;
+	for (ite = airports.begin(); ite != airports.end(); ite++) {
+		double dist = compute_distance_gc(latitude, longitude, ite->second->latitude, ite->second->longitude, 0);
+		if ((min_distance == -1) || (dist < min_distance)) {
+			min_distance = dist;
+			count = 1;
+		} else if (dist == min_distance) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static string join_codes(const vector<string>& codes) {
+	string tmpStr;
+	for (unsigned int i = 0; i < codes.size(); i++) {
+		if (i > 0)
+			tmpStr.append(",");
+		tmpStr.append(codes[i]);
+	}
+
+	return tmpStr;
+}
+
+int main() {
+	map<string, NatsAirport*> airports;
+
+	vector<double> latitudes;
+	vector<double> longitudes;
+
+	// Random airports, denser over CONUS
+	for (int i = 0; i < TEST_NUM_RANDOM_AIRPORTS; i++) {
+		if (i % 3 == 0) {
+			add_airport(airports, make_code("W", i), test_uniform(-89.9, 89.9), test_uniform(-180., 180.));
+		} else {
+			add_airport(airports, make_code("K", i), test_uniform(25., 49.), test_uniform(-125., -67.));
+		}
+	}
+
+	// Tie groups.  Each query point gets two airports at the same position,
+	// which are its closest, and two farther airports mirrored in longitude
+	// about it, whose distances agree to round-off.  The codes are not in
+	// the insertion order so that the tie break is by code.
+	for (int i = 0; i < TEST_NUM_TIE_QUERIES; i++) {
+		const double latitude = test_uniform(25., 49.);
+		const double longitude = test_uniform(-125., -67.);
+		const double offset = test_uniform(0.05, 0.2);
+
+		add_airport(airports, make_code("T", 4 * i + 3), latitude + 0.01, longitude);
+		add_airport(airports, make_code("T", 4 * i + 2), latitude + 0.01, longitude);
+		add_airport(airports, make_code("T", 4 * i + 1), latitude, longitude + offset);
+		add_airport(airports, make_code("T", 4 * i), latitude, longitude - offset);
+
+		latitudes.push_back(latitude);
+		longitudes.push_back(longitude);
+	}
+
+	// Queries on airports, the poles and the antimeridian
+	map<string, NatsAirport*>::const_iterator ite = airports.begin();
+	for (int i = 0; (i < 200) && (ite != airports.end()); i++, ite++) {
+		latitudes.push_back(ite->second->latitude);
+		longitudes.push_back(ite->second->longitude);
+	}
+	latitudes.push_back(90.);
+	longitudes.push_back(0.);
+	latitudes.push_back(-90.);
+	longitudes.push_back(0.);
+	latitudes.push_back(0.);
+	longitudes.push_back(180.);
+	latitudes.push_back(0.);
+	longitudes.push_back(-180.);
+
+	for (int i = 0; i < TEST_NUM_RANDOM_QUERIES; i++) {
+		latitudes.push_back(test_uniform(-90., 90.));
+		longitudes.push_back(test_uniform(-180., 180.));
+	}
+
+	build_airport_index(airports);
+
+	int num_failures = 0;
+
+	if (get_airport_index_size() != (int)airports.size()) {
+		printf("FAILED: index holds %d airports, expected %d\n", get_airport_index_size(), (int)airports.size());
+		num_failures++;
+	}
+
+	const int count = latitudes.size();
+
+	// Closest airport, single and batch
+	vector<string> batch_closest;
+	get_closest_airports(count, latitudes.data(), longitudes.data(), batch_closest);
+
+	int num_ties = 0;
+	for (int i = 0; i < count; i++) {
+		const string expected = scan_closest_airport(airports, latitudes[i], longitudes[i]);
+		const string single = get_closest_airport(latitudes[i], longitudes[i]);
+
+		if (count_closest_ties(airports, latitudes[i], longitudes[i]) > 1)
+			num_ties++;
+
+		if ((single != expected) || (batch_closest.at(i) != expected)) {
+			printf("FAILED: closest airport to (%.6f, %.6f) is %s, single %s, batch %s\n",
+					latitudes[i], longitudes[i], expected.c_str(), single.c_str(), batch_closest.at(i).c_str());
+			num_failures++;
+		}
+	}
+
+	if (num_ties < TEST_NUM_TIE_QUERIES) {
+		printf("FAILED: only %d queries have equidistant closest airports\n", num_ties);
+		num_failures++;
+	}
+
+	// Airports within range, single and batch
+	const double ranges_mile[] = {0.5, 5., 50., 300.};
+	const int num_ranges = sizeof(ranges_mile) / sizeof(ranges_mile[0]);
+
+	for (int r = 0; r < num_ranges; r++) {
+		const double range_ft = 5280 * ranges_mile[r];
+
+		vector<vector<string> > batch_codes;
+		get_airports_within_range(count, latitudes.data(), longitudes.data(), range_ft, batch_codes);
+
+		for (int i = 0; i < count; i++) {
+			vector<string> expected;
+			scan_airports_within_range(airports, latitudes[i], longitudes[i], range_ft, expected);
+
+			vector<string> single;
+			get_airports_within_range(latitudes[i], longitudes[i], range_ft, single);
+
+			if ((single != expected) || (batch_codes.at(i) != expected)) {
+				printf("FAILED: airports within %.1f miles of (%.6f, %.6f) are [%s], single [%s], batch [%s]\n",
+						ranges_mile[r], latitudes[i], longitudes[i],
+						join_codes(expected).c_str(), join_codes(single).c_str(), join_codes(batch_codes.at(i)).c_str());
+				num_failures++;
+			}
+		}
+	}
+
+	// Range equal to the distance of the mirrored tie airports, which must
+	// both be included
+	int num_boundary = 0;
+	for (int i = 0; i < TEST_NUM_TIE_QUERIES; i++) {
+		const NatsAirport* airport = airports.at(make_code("T", 4 * i));
+		const double range_ft = compute_distance_gc(latitudes[i], longitudes[i], airport->latitude, airport->longitude, 0);
+
+		vector<string> expected;
+		scan_airports_within_range(airports, latitudes[i], longitudes[i], range_ft, expected);
+
+		vector<string> single;
+		get_airports_within_range(latitudes[i], longitudes[i], range_ft, single);
+
+		vector<vector<string> > batch_codes;
+		get_airports_within_range(1, &latitudes[i], &longitudes[i], range_ft, batch_codes);
+
+		if ((single != expected) || (batch_codes.at(0) != expected)) {
+			printf("FAILED: airports within %.3f ft of (%.6f, %.6f) are [%s], single [%s], batch [%s]\n",
+					range_ft, latitudes[i], longitudes[i],
+					join_codes(expected).c_str(), join_codes(single).c_str(), join_codes(batch_codes.at(0)).c_str());
+			num_failures++;
+		}
+
+		for (unsigned int j = 0; j < expected.size(); j++) {
+			if (expected[j] == make_code("T", 4 * i))
+				num_boundary++;
+		}
+	}
+
+	if (num_boundary != TEST_NUM_TIE_QUERIES) {
+		printf("FAILED: %d of %d airports at the exact range were found\n", num_boundary, TEST_NUM_TIE_QUERIES);
+		num_failures++;
+	}
+
+	printf("test_airport_index: %d airports, %d queries, %d with ties, %d failures\n",
+			(int)airports.size(), count, num_ties, num_failures);
+
+	clear_airport_index();
+
+	for (ite = airports.begin(); ite != airports.end(); ite++) {
+		delete ite->second;
+	}
+
+	return (num_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,372 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_checkpoint.cpp
+ *
+ * Test of the simulation checkpoint and restore.
+ *
+ * The reference run propagates the two aircraft demo, pauses, saves a
+ * checkpoint and continues to the end.  Its flights are perturbed before
+ * the propagation, so a run from the TRX input alone gives different
+ * trajectories.  A new process restores the checkpoint and continues from
+ * it.  Both runs have to write byte identical trajectories.
+ *
+ * A third process stages a checkpoint whose payload lost its last node
+ * id.  The checksum is recomputed, so only applying the payload can
+ * detect the damage, and the simulation state must be left unchanged.
+ */
+
+#include "tg_api.h"
+#include "tg_aircraft.h"
+#include "tg_checkpoint.h"
+#include "tg_simulation.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define TEST_HORIZON_SEC 7200
+#define TEST_PAUSE_SEC 1800
+#define TEST_TIMEOUT_SEC 600
+
+static const string TEST_TRX_FILE = "share/tg/trx/TRX_DEMO_2Aircrafts_RiskMeasures_test_geo.trx";
+static const string TEST_MFL_FILE = "share/tg/trx/TRX_DEMO_2Aircrafts_RiskMeasures_test_mfl.trx";
+
+// Layout of checkpoint_header_t in tg_checkpoint.cpp
+typedef struct _test_checkpoint_header_t {
+	char magic[8];
+	unsigned int version;
+	unsigned int size_real_t;
+	unsigned int size_update_states_t;
+	int num_flights;
+	int num_ground_vehicles;
+	unsigned long long payload_size;
+	unsigned long long payload_checksum;
+} test_checkpoint_header_t;
+
+static unsigned long long compute_checksum(const string& data) {
+	// FNV-1a
+	unsigned long long hash = 14695981039346656037ULL;
+
+	for (size_t i = 0; i < data.size(); i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+static bool read_file(const string& path, string& content) {
+	ifstream in(path.c_str(), ios::binary);
+	if (!in.is_open())
+		return false;
+
+	ostringstream oss;
+	oss << in.rdbuf();
+	content = oss.str();
+
+	return true;
+}
+
+static bool write_file(const string& path, const string& content) {
+	ofstream out(path.c_str(), ios::binary);
+	if (!out.is_open())
+		return false;
+
+	out << content;
+
+	return out.good();
+}
+
+static void remove_folder(const string& dir) {
+	DIR* dp = opendir(dir.c_str());
+	if (dp == NULL)
+		return;
+
+	struct dirent* entry;
+	while ((entry = readdir(dp)) != NULL) {
+		const string name(entry->d_name);
+		if ((name != ".") && (name != ".."))
+			unlink((dir + "/" + name).c_str());
+	}
+	closedir(dp);
+
+	rmdir(dir.c_str());
+}
+
+static int init_simulation() {
+	alarm(TEST_TIMEOUT_SEC);
+
+	if (tg_init() != 0) {
+		printf("FAILED: tg_init()\n");
+
+		return -1;
+	}
+
+	if ((tg_load_trx(TEST_TRX_FILE, TEST_MFL_FILE) != 0) || (get_num_flights() <= 0)) {
+		printf("FAILED: Can't load %s\n", TEST_TRX_FILE.c_str());
+
+		return -1;
+	}
+
+	// Wake vortices and traffic metrics are part of the checkpoint
+	tg_enable_wake_vortex_model(true);
+	tg_enable_traffic_metrics(true);
+
+	return 0;
+}
+
+static void wait_pause_or_end() {
+	while ((!flag_simulation_paused_at_step) && (get_runtime_sim_status() != NATS_SIMULATION_STATUS_ENDED)) {
+		usleep(nats_simulation_check_interval);
+	}
+}
+
+static void wait_end() {
+	while (get_runtime_sim_status() != NATS_SIMULATION_STATUS_ENDED) {
+		usleep(nats_simulation_check_interval);
+	}
+}
+
+/*
+ * Reference run: save a checkpoint at the pause and continue to the end
+ */
+static int run_reference(const string& dir) {
+	if (init_simulation() != 0)
+		return -1;
+
+	// Only the checkpoint carries these changes to the restored run
+	for (int i = 0; i < get_num_flights(); i++) {
+		h_aircraft_soa.cruise_tas_knots[i] *= 1.05;
+	}
+
+	if (propagate_flights(TEST_HORIZON_SEC, 10, 10, 30) != 0)
+		return -1;
+
+	set_nats_simulation_duration((float)TEST_PAUSE_SEC);
+	nats_simulation_operator(NATS_SIMULATION_STATUS_START);
+
+	wait_pause_or_end();
+	if (get_runtime_sim_status() == NATS_SIMULATION_STATUS_ENDED) {
+		printf("FAILED: Simulation ended before the pause\n");
+
+		return -1;
+	}
+
+	if (save_simulation_checkpoint(dir + "/checkpoint.bin") != 0)
+		return -1;
+
+	set_nats_simulation_duration((float)TEST_HORIZON_SEC);
+	nats_simulation_operator(NATS_SIMULATION_STATUS_RESUME);
+
+	wait_end();
+
+	return tg_write_trajectories(dir + "/reference.csv", g_trajectories);
+}
+
+/*
+ * Restore the checkpoint in a freshly initialized process and continue
+ */
+static int run_restore(const string& dir) {
+	if (init_simulation() != 0)
+		return -1;
+
+	if (load_simulation_checkpoint(dir + "/checkpoint.bin") != 0)
+		return -1;
+
+	if (propagate_flights(TEST_HORIZON_SEC, 10, 10, 30) != 0)
+		return -1;
+
+	nats_simulation_operator(NATS_SIMULATION_STATUS_START);
+
+	wait_end();
+
+	return tg_write_trajectories(dir + "/restored.csv", g_trajectories);
+}
+
+/*
+ * Stage a checkpoint with a truncated payload and check that applying it
+ * changes nothing
+ */
+static int run_malformed(const string& dir) {
+	if (init_simulation() != 0)
+		return -1;
+
+	string content;
+	if (!read_file(dir + "/checkpoint.bin", content) || (content.size() < sizeof(test_checkpoint_header_t) + sizeof(int))) {
+		printf("FAILED: Can't read the checkpoint\n");
+
+		return -1;
+	}
+
+	test_checkpoint_header_t header;
+	memcpy(&header, content.data(), sizeof(header));
+
+	string payload = content.substr(sizeof(header), content.size() - sizeof(header) - sizeof(int));
+	header.payload_size = payload.size();
+	header.payload_checksum = compute_checksum(payload);
+
+	string malformed((const char*)&header, sizeof(header));
+	malformed += payload;
+
+	if (!write_file(dir + "/malformed.bin", malformed) || (load_simulation_checkpoint(dir + "/malformed.bin") != 0)) {
+		printf("FAILED: Can't stage the malformed checkpoint\n");
+
+		return -1;
+	}
+
+	const int num_flights = get_num_flights();
+
+	vector<real_t> latitudes(h_aircraft_soa.latitude_deg, h_aircraft_soa.latitude_deg + num_flights);
+	vector<waypoint_node_t*> flight_plans(array_Airborne_Flight_Plan_ptr, array_Airborne_Flight_Plan_ptr + num_flights);
+	const float saved_t_step_airborne = t_data_collection_period_airborne;
+
+	// Time steps differing from the checkpoint show whether the preamble
+	// was applied
+	if (propagate_flights(TEST_HORIZON_SEC, 5, 5, 15) != 0)
+		return -1;
+
+	nats_simulation_operator(NATS_SIMULATION_STATUS_START);
+
+	wait_end();
+
+	int num_failures = 0;
+
+	for (int i = 0; i < num_flights; i++) {
+		if ((h_aircraft_soa.latitude_deg[i] != latitudes[i]) || (array_Airborne_Flight_Plan_ptr[i] != flight_plans[i])) {
+			printf("FAILED: Flight %d was changed by the malformed checkpoint\n", i);
+			num_failures++;
+		}
+	}
+
+	if (t_data_collection_period_airborne == 30) {
+		printf("FAILED: Time steps were taken from the malformed checkpoint (%f, before %f)\n", t_data_collection_period_airborne, saved_t_step_airborne);
+		num_failures++;
+	}
+
+	if (has_staged_simulation_checkpoint()) {
+		printf("FAILED: Malformed checkpoint is still staged\n");
+		num_failures++;
+	}
+
+	return (num_failures == 0) ? 0 : -1;
+}
+
+static int run_self(char* argv0, const char* mode, const string& dir) {
+	(void)argv0;
+
+	fflush(stdout);
+
+	pid_t pid = fork();
+	if (pid < 0)
+		return -1;
+
+	if (pid == 0) {
+		char* child_argv[] = {argv0, (char*)mode, (char*)dir.c_str(), NULL};
+		execv("/proc/self/exe", child_argv);
+
+		_exit(1);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	return (WIFEXITED(status) && (WEXITSTATUS(status) == 0)) ? 0 : -1;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc == 3) {
+		const string mode(argv[1]);
+		const string dir(argv[2]);
+
+		int err = -1;
+		if (mode == "reference") {
+			err = run_reference(dir);
+		} else if (mode == "restore") {
+			err = run_restore(dir);
+		} else if (mode == "malformed") {
+			err = run_malformed(dir);
+		}
+
+		return (err == 0) ? 0 : 1;
+	}
+
+	char dir_template[] = "/tmp/test_checkpoint_XXXXXX";
+	if (mkdtemp(dir_template) == NULL) {
+		printf("FAILED: Can't create a temporary folder\n");
+
+		return 1;
+	}
+	const string dir(dir_template);
+
+	int num_failures = 0;
+
+	// Every run needs a freshly initialized process
+	if (run_self(argv[0], "reference", dir) != 0) {
+		printf("FAILED: Reference run\n");
+		num_failures++;
+	} else if (run_self(argv[0], "restore", dir) != 0) {
+		printf("FAILED: Restored run\n");
+		num_failures++;
+	} else {
+		string reference, restored;
+		if (!read_file(dir + "/reference.csv", reference) || !read_file(dir + "/restored.csv", restored) || reference.empty()) {
+			printf("FAILED: Missing trajectory files in %s\n", dir.c_str());
+			num_failures++;
+		} else if (reference != restored) {
+			printf("FAILED: Restored trajectories differ from the reference run (see %s)\n", dir.c_str());
+			num_failures++;
+		}
+	}
+
+	if (run_self(argv[0], "malformed", dir) != 0) {
+		printf("FAILED: Malformed checkpoint run\n");
+		num_failures++;
+	}
+
+	// Files of failed runs are kept for inspection
+	if (num_failures == 0)
+		remove_folder(dir);
+
+	printf("test_checkpoint: %d failures\n", num_failures);
+
+	return (num_failures == 0) ? 0 : 1;
+}
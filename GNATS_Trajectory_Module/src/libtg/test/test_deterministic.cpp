@@ -0,0 +1,362 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_deterministic.cpp
+ *
+ * Regression test of the deterministic mode across thread counts.
+ *
+ * The same seeded scenario runs three times, each in a new process with
+ * OMP_NUM_THREADS and the ensemble parallelism set to 1, 3 and 8.  Every
+ * run propagates an ensemble with random departure delay and cruise
+ * speed perturbations, and one unperturbed simulation of the two aircraft
+ * demo.  Ground vehicles at KSFO, ARTCC center tracking, the wake vortex
+ * model and traffic metrics are enabled, so their OpenMP loops run with
+ * every thread count.
+ *
+ * The member and simulation trajectories, the ground vehicle histories,
+ * the traffic metrics, the center events and the wake encounters have to
+ * be byte identical for all thread counts.
+ */
+
+#include "tg_api.h"
+#include "tg_aircraft.h"
+#include "tg_ensemble.h"
+#include "tg_groundVehicle.h"
+#include "tg_random.h"
+#include "tg_simulation.h"
+
+#include "AirportLayoutDataLoader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define TEST_NUM_MEMBERS 4
+#define TEST_NUM_GROUND_VEHICLES 40
+#define TEST_HORIZON_SEC 7200
+#define TEST_TIMEOUT_SEC 900
+
+static const unsigned long long TEST_SEED = 20211;
+
+static const int TEST_THREAD_COUNTS[] = {1, 3, 8};
+static const int TEST_NUM_THREAD_COUNTS = sizeof(TEST_THREAD_COUNTS) / sizeof(TEST_THREAD_COUNTS[0]);
+
+static const string TEST_TRX_FILE = "share/tg/trx/TRX_DEMO_2Aircrafts_RiskMeasures_test_geo.trx";
+static const string TEST_MFL_FILE = "share/tg/trx/TRX_DEMO_2Aircrafts_RiskMeasures_test_mfl.trx";
+
+// Consecutive nodes along taxiway A of KSFO
+static const char* TEST_DRIVE_PLAN_NODES[] = {"Txy_A_015", "Txy_A_013", "Txy_A_012", "Txy_A_011"};
+static const int TEST_NUM_DRIVE_PLAN_NODES = sizeof(TEST_DRIVE_PLAN_NODES) / sizeof(TEST_DRIVE_PLAN_NODES[0]);
+
+static bool read_file(const string& path, string& content) {
+	ifstream in(path.c_str(), ios::binary);
+	if (!in.is_open())
+		return false;
+
+	ostringstream oss;
+	oss << in.rdbuf();
+	content = oss.str();
+
+	return true;
+}
+
+static void remove_folder(const string& dir) {
+	DIR* dp = opendir(dir.c_str());
+	if (dp == NULL)
+		return;
+
+	struct dirent* entry;
+	while ((entry = readdir(dp)) != NULL) {
+		const string name(entry->d_name);
+		if ((name != ".") && (name != ".."))
+			unlink((dir + "/" + name).c_str());
+	}
+	closedir(dp);
+
+	rmdir(dir.c_str());
+}
+
+/*
+ * Ground vehicles driving taxiway A of KSFO at different speeds, half of
+ * them in the opposite direction
+ */
+static int write_ground_vehicle_trx(const string& fname) {
+	ofstream out(fname.c_str());
+	if (!out.is_open())
+		return -1;
+
+	out << "TRACK_TIME 1121238067\n";
+
+	for (int v = 0; v < TEST_NUM_GROUND_VEHICLES; v++) {
+		const bool flag_reverse = ((v % 2) == 1);
+
+		out << "TRACK TUG" << v << " SWA1897 " << (flag_reverse ? "373713.0 1222305.0" : "373720.0 1222319.0") << " " << (5 + v % 7) << " 13 90\n";
+		out << "    FP_ROUTE KSFO.<";
+		for (int k = 0; k < TEST_NUM_DRIVE_PLAN_NODES; k++) {
+			const int node = flag_reverse ? (TEST_NUM_DRIVE_PLAN_NODES - 1 - k) : k;
+
+			out << ((k > 0) ? ", " : "") << "{\"id\": \"" << TEST_DRIVE_PLAN_NODES[node] << "\"}";
+		}
+		out << ">\n\n";
+	}
+
+	out.close();
+
+	return out.fail() ? -1 : 0;
+}
+
+static int write_events(const string& fname) {
+	FILE* fp = fopen(fname.c_str(), "w");
+	if (fp == NULL)
+		return -1;
+
+	vector<center_event_t> center_events;
+	tg_get_center_events(&center_events);
+	for (unsigned int i = 0; i < center_events.size(); i++) {
+		fprintf(fp, "center,%d,%d,%a,%d\n", center_events[i].flight_index, center_events[i].center_index, center_events[i].time, (int)center_events[i].type);
+	}
+
+	vector<wake_encounter_t> wake_encounters;
+	tg_get_wake_encounters(&wake_encounters);
+	for (unsigned int i = 0; i < wake_encounters.size(); i++) {
+		fprintf(fp, "wake,%a,%d,%d,%a,%a,%a\n", wake_encounters[i].time, wake_encounters[i].follower_index, wake_encounters[i].generator_index,
+				wake_encounters[i].circulation_m2ps, wake_encounters[i].lateral_distance_ft, wake_encounters[i].vertical_distance_ft);
+	}
+
+	return (fclose(fp) == 0) ? 0 : -1;
+}
+
+static string get_output_prefix(const string& dir, const int num_threads) {
+	ostringstream oss;
+	oss << dir << "/run" << num_threads;
+
+	return oss.str();
+}
+
+/*
+ * Body of one run process
+ */
+static int run_scenario(const int num_threads, const string& dir) {
+	alarm(TEST_TIMEOUT_SEC);
+
+	if (tg_init() != 0) {
+		printf("FAILED: tg_init()\n");
+
+		return -1;
+	}
+
+	if ((tg_load_trx(TEST_TRX_FILE, TEST_MFL_FILE) != 0) || (get_num_flights() <= 0)) {
+		printf("FAILED: Can't load %s\n", TEST_TRX_FILE.c_str());
+
+		return -1;
+	}
+
+	// The surface layouts come with the airport data.  Without it, load
+	// the layouts alone for the drive plans of the ground vehicles.
+	if (map_ground_waypoint_connectivity.find("KSFO") == map_ground_waypoint_connectivity.end()) {
+		AirportLayoutDataLoader airportLayoutDataLoader;
+		airportLayoutDataLoader.loadAirportLayout(g_share_dir + "/libairport_layout/Airport_Rwy");
+	}
+
+	if ((load_groundVehicle(dir + "/ground_vehicles.trx") != 0) || (groundVehicleStates.size() != TEST_NUM_GROUND_VEHICLES)) {
+		printf("FAILED: Can't load the ground vehicles\n");
+
+		return -1;
+	}
+
+	if (!flag_center_available) {
+		printf("FAILED: No ARTCC center data\n");
+
+		return -1;
+	}
+
+	set_random_scenario_seed(TEST_SEED);
+
+	tg_enable_wake_vortex_model(true);
+	tg_enable_traffic_metrics(true);
+
+	const string prefix = get_output_prefix(dir, num_threads);
+
+	vector<ensemble_member_config_t> members(TEST_NUM_MEMBERS);
+	for (int m = 0; m < TEST_NUM_MEMBERS; m++) {
+		ostringstream oss;
+		oss << prefix << "_member" << m << ".csv";
+
+		members[m].seed = TEST_SEED + m;
+		members[m].departure_delay_mean_sec = 30;
+		members[m].departure_delay_sigma_sec = 60;
+		members[m].cruise_tas_sigma_ratio = 0.02;
+		members[m].output_file = oss.str();
+	}
+
+	vector<ensemble_flight_stats_t> stats;
+	if (tg_run_ensemble(members, TEST_HORIZON_SEC, 10, 10, 30, num_threads, stats) != TEST_NUM_MEMBERS) {
+		printf("FAILED: Ensemble with %d threads\n", num_threads);
+
+		return -1;
+	}
+
+	if (propagate_flights(TEST_HORIZON_SEC, 10, 10, 30) != 0)
+		return -1;
+
+	nats_simulation_operator(NATS_SIMULATION_STATUS_START);
+
+	while (get_runtime_sim_status() != NATS_SIMULATION_STATUS_ENDED) {
+		usleep(nats_simulation_check_interval);
+	}
+
+	if ((tg_write_traffic_metrics(prefix + "_metrics.csv") != 0) || (write_events(prefix + "_events.txt") != 0))
+		return -1;
+
+	return tg_write_trajectories(prefix + "_simulation.csv", g_trajectories);
+}
+
+static int run_self(char* argv0, const int num_threads, const string& dir) {
+	char str_threads[16];
+	snprintf(str_threads, sizeof(str_threads), "%d", num_threads);
+
+	fflush(stdout);
+
+	pid_t pid = fork();
+	if (pid < 0)
+		return -1;
+
+	if (pid == 0) {
+		// The OpenMP runtime reads the team size when it is loaded
+		setenv("OMP_NUM_THREADS", str_threads, 1);
+
+		char* child_argv[] = {argv0, (char*)"run", str_threads, (char*)dir.c_str(), NULL};
+		execv("/proc/self/exe", child_argv);
+
+		_exit(1);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	return (WIFEXITED(status) && (WEXITSTATUS(status) == 0)) ? 0 : -1;
+}
+
+int main(int argc, char* argv[]) {
+	if ((argc == 4) && (string(argv[1]) == "run")) {
+		return (run_scenario(atoi(argv[2]), argv[3]) == 0) ? 0 : 1;
+	}
+
+	char dir_template[] = "/tmp/test_deterministic_XXXXXX";
+	if (mkdtemp(dir_template) == NULL) {
+		printf("FAILED: Can't create a temporary folder\n");
+
+		return 1;
+	}
+	const string dir(dir_template);
+
+	if (write_ground_vehicle_trx(dir + "/ground_vehicles.trx") != 0) {
+		printf("FAILED: Can't write the ground vehicle TRX file\n");
+
+		return 1;
+	}
+
+	int num_failures = 0;
+
+	for (int r = 0; r < TEST_NUM_THREAD_COUNTS; r++) {
+		if (run_self(argv[0], TEST_THREAD_COUNTS[r], dir) != 0) {
+			printf("FAILED: Run with %d threads\n", TEST_THREAD_COUNTS[r]);
+			num_failures++;
+		}
+	}
+
+	vector<string> suffixes;
+	for (int m = 0; m < TEST_NUM_MEMBERS; m++) {
+		ostringstream oss;
+		oss << "_member" << m;
+
+		suffixes.push_back(oss.str() + ".csv");
+		suffixes.push_back(oss.str() + "_groundVehicleSimulation.csv");
+	}
+	suffixes.push_back("_simulation.csv");
+	suffixes.push_back("_simulation_groundVehicleSimulation.csv");
+	suffixes.push_back("_metrics.csv");
+	suffixes.push_back("_events.txt");
+
+	for (unsigned int s = 0; (s < suffixes.size()) && (num_failures == 0); s++) {
+		string reference;
+		if (!read_file(get_output_prefix(dir, TEST_THREAD_COUNTS[0]) + suffixes[s], reference)) {
+			printf("FAILED: Missing output run%d%s\n", TEST_THREAD_COUNTS[0], suffixes[s].c_str());
+			num_failures++;
+
+			continue;
+		}
+
+		// Ground vehicles have to move, and the members have to differ from
+		// the unperturbed simulation
+		if ((suffixes[s].find("groundVehicle") != string::npos) && (count(reference.begin(), reference.end(), '\n') <= TEST_NUM_GROUND_VEHICLES)) {
+			printf("FAILED: No ground vehicle samples in run%d%s\n", TEST_THREAD_COUNTS[0], suffixes[s].c_str());
+			num_failures++;
+		}
+
+		for (int r = 1; r < TEST_NUM_THREAD_COUNTS; r++) {
+			string content;
+			if (!read_file(get_output_prefix(dir, TEST_THREAD_COUNTS[r]) + suffixes[s], content) || (content != reference)) {
+				printf("FAILED: run%d%s differs from run%d%s\n", TEST_THREAD_COUNTS[r], suffixes[s].c_str(), TEST_THREAD_COUNTS[0], suffixes[s].c_str());
+				num_failures++;
+			}
+		}
+	}
+
+	string member_trajectories, simulation_trajectories;
+	if ((num_failures == 0)
+			&& read_file(get_output_prefix(dir, TEST_THREAD_COUNTS[0]) + "_member0.csv", member_trajectories)
+			&& read_file(get_output_prefix(dir, TEST_THREAD_COUNTS[0]) + "_simulation.csv", simulation_trajectories)
+			&& (member_trajectories == simulation_trajectories)) {
+		printf("FAILED: Ensemble perturbations had no effect\n");
+		num_failures++;
+	}
+
+	// Files of failed runs are kept for inspection
+	if (num_failures == 0)
+		remove_folder(dir);
+	else
+		printf("Outputs are in %s\n", dir.c_str());
+
+	printf("test_deterministic: %d thread counts, %d failures\n", TEST_NUM_THREAD_COUNTS, num_failures);
+
+	return (num_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_ensemble.cpp
+ *
+ * Test of the Monte Carlo ensemble runner with OpenMP teams.
+ *
+ * Runs several members of the two aircraft demo concurrently, with the
+ * wake vortex model and traffic metrics enabled so that the OpenMP loops
+ * of the propagation execute inside the member workers, and with a member
+ * setup hook that runs an OpenMP region of its own.  The test runs
+ * with OMP_NUM_THREADS set to more than one thread and a watchdog alarm,
+ * so a worker stuck in an OpenMP region fails the test instead of
+ * blocking it.  Every member has to complete, and a second run of the
+ * same ensemble has to reproduce the statistics of the first.
+ *
+ * The horizon lets every member land, so the arrival statistics are
+ * aggregated over all members.  An ensemble without perturbations gives
+ * the undelayed arrival times: all of its members land at the same time,
+ * and the mean arrival of the perturbed ensemble has to follow it by the
+ * mean departure delay, within TEST_ARRIVAL_TOLERANCE_SEC for the cruise
+ * speed perturbations.
+ */
+
+#include "tg_api.h"
+#include "tg_aircraft.h"
+#include "tg_ensemble.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define TEST_NUM_MEMBERS 4
+#define TEST_MAX_PARALLEL 2
+#define TEST_OMP_NUM_THREADS "4"
+#define TEST_TIMEOUT_SEC 600
+
+// The demo flights land at about 6600 sec with 10 second time steps.  The
+// horizon leaves room for the departure delays.
+#define TEST_HORIZON_SEC 9000
+#define TEST_STEP_SEC 10
+
+#define TEST_ARRIVAL_TOLERANCE_SEC 300
+
+static const string TEST_TRX_FILE = "share/tg/trx/TRX_DEMO_2Aircrafts_RiskMeasures_test_geo.trx";
+static const string TEST_MFL_FILE = "share/tg/trx/TRX_DEMO_2Aircrafts_RiskMeasures_test_mfl.trx";
+
+// OpenMP region run inside every member worker before propagation
+static void member_setup(const int member_index, const ensemble_member_config_t& config) {
+	(void)config;
+
+	vector<int> values(1000, member_index);
+	long sum = 0;
+
+#pragma omp parallel for reduction(+:sum)
+	for (int i = 0; i < (int)values.size(); i++) {
+		sum += values[i];
+	}
+
+	if (sum != 1000L * member_index)
+		_exit(1);
+}
+
+static bool same_value(const real_t a, const real_t b) {
+	return (isnan(a) && isnan(b)) || (a == b);
+}
+
+static bool same_stats(const ensemble_flight_stats_t& a, const ensemble_flight_stats_t& b) {
+	return (a.callsign == b.callsign)
+			&& (a.member_count == b.member_count)
+			&& (a.landed_count == b.landed_count)
+			&& same_value(a.arrival_time_mean_sec, b.arrival_time_mean_sec)
+			&& same_value(a.arrival_time_p05_sec, b.arrival_time_p05_sec)
+			&& same_value(a.arrival_time_p50_sec, b.arrival_time_p50_sec)
+			&& same_value(a.arrival_time_p95_sec, b.arrival_time_p95_sec)
+			&& same_value(a.departure_delay_mean_sec, b.departure_delay_mean_sec)
+			&& same_value(a.conflict_count_mean, b.conflict_count_mean)
+			&& (a.conflict_count_max == b.conflict_count_max)
+			&& (a.conflict_member_count == b.conflict_member_count);
+}
+
+/*
+ * Checks the arrival statistics of a flight against those of the ensemble
+ * without perturbations.  Returns the number of failures.
+ */
+static int check_arrival_stats(const ensemble_flight_stats_t& a, const ensemble_flight_stats_t& reference) {
+	int num_failures = 0;
+
+	if ((reference.landed_count != TEST_NUM_MEMBERS)
+			|| (reference.arrival_time_p05_sec != reference.arrival_time_mean_sec)
+			|| (reference.arrival_time_p50_sec != reference.arrival_time_mean_sec)
+			|| (reference.arrival_time_p95_sec != reference.arrival_time_mean_sec)
+			|| (reference.departure_delay_mean_sec != 0)) {
+		printf("FAILED: Flight %s without perturbations: %d landed, mean arrival %f sec (p05 %f, p50 %f, p95 %f), mean delay %f sec\n",
+				reference.callsign.c_str(), reference.landed_count, reference.arrival_time_mean_sec,
+				reference.arrival_time_p05_sec, reference.arrival_time_p50_sec, reference.arrival_time_p95_sec, reference.departure_delay_mean_sec);
+		num_failures++;
+	}
+
+	if (a.landed_count != TEST_NUM_MEMBERS) {
+		printf("FAILED: Flight %s landed in %d of %d members\n", a.callsign.c_str(), a.landed_count, TEST_NUM_MEMBERS);
+		num_failures++;
+	}
+
+	if (!((a.arrival_time_p05_sec <= a.arrival_time_p50_sec)
+			&& (a.arrival_time_p50_sec <= a.arrival_time_p95_sec)
+			&& (a.arrival_time_p05_sec <= a.arrival_time_mean_sec)
+			&& (a.arrival_time_mean_sec <= a.arrival_time_p95_sec)
+			&& (a.arrival_time_p05_sec < a.arrival_time_p95_sec))) {
+		printf("FAILED: Flight %s arrival percentiles %f, %f, %f sec around the mean %f sec\n",
+				a.callsign.c_str(), a.arrival_time_p05_sec, a.arrival_time_p50_sec, a.arrival_time_p95_sec, a.arrival_time_mean_sec);
+		num_failures++;
+	}
+
+	const double delay_sec = a.arrival_time_mean_sec - reference.arrival_time_mean_sec;
+	if (!(fabs(delay_sec - a.departure_delay_mean_sec) <= TEST_ARRIVAL_TOLERANCE_SEC)) {
+		printf("FAILED: Flight %s arrives %f sec late on average with a mean departure delay of %f sec\n",
+				a.callsign.c_str(), delay_sec, a.departure_delay_mean_sec);
+		num_failures++;
+	}
+
+	return num_failures;
+}
+
+int main(int argc, char* argv[]) {
+	(void)argc;
+
+	// The OpenMP runtime reads the team size when it is loaded
+	const char* omp_num_threads = getenv("OMP_NUM_THREADS");
+	if ((omp_num_threads == NULL) || (atoi(omp_num_threads) < 2)) {
+		setenv("OMP_NUM_THREADS", TEST_OMP_NUM_THREADS, 1);
+		execv("/proc/self/exe", argv);
+
+		printf("FAILED: Can't restart with OMP_NUM_THREADS=%s\n", TEST_OMP_NUM_THREADS);
+
+		return 1;
+	}
+
+	alarm(TEST_TIMEOUT_SEC);
+
+	if (tg_init() != 0) {
+		printf("FAILED: tg_init()\n");
+
+		return 1;
+	}
+
+	if ((tg_load_trx(TEST_TRX_FILE, TEST_MFL_FILE) != 0) || (get_num_flights() <= 0)) {
+		printf("FAILED: Can't load %s\n", TEST_TRX_FILE.c_str());
+
+		return 1;
+	}
+
+	tg_enable_wake_vortex_model(true);
+	tg_enable_traffic_metrics(true);
+
+	vector<ensemble_member_config_t> members(TEST_NUM_MEMBERS);
+	for (int m = 0; m < TEST_NUM_MEMBERS; m++) {
+		members[m].seed = 1000 + m;
+		members[m].wind_sigma_fps = 0;
+		members[m].departure_delay_mean_sec = 30;
+		members[m].departure_delay_sigma_sec = 60;
+		members[m].cruise_tas_sigma_ratio = 0.02;
+	}
+
+	int num_failures = 0;
+
+	vector<ensemble_flight_stats_t> stats[2];
+	for (int run = 0; run < 2; run++) {
+		const int num_completed = tg_run_ensemble(members, TEST_HORIZON_SEC, TEST_STEP_SEC, TEST_STEP_SEC, TEST_STEP_SEC, TEST_MAX_PARALLEL, stats[run], member_setup);
+		if (num_completed != TEST_NUM_MEMBERS) {
+			printf("FAILED: Run %d completed %d of %d members\n", run, num_completed, TEST_NUM_MEMBERS);
+			num_failures++;
+		}
+	}
+
+	// The same ensemble without perturbations
+	vector<ensemble_member_config_t> members_reference(TEST_NUM_MEMBERS);
+	for (int m = 0; m < TEST_NUM_MEMBERS; m++) {
+		members_reference[m].seed = 2000 + m;
+		members_reference[m].wind_sigma_fps = 0;
+		members_reference[m].departure_delay_mean_sec = 0;
+		members_reference[m].departure_delay_sigma_sec = 0;
+		members_reference[m].cruise_tas_sigma_ratio = 0;
+	}
+
+	vector<ensemble_flight_stats_t> stats_reference;
+	const int num_completed_reference = tg_run_ensemble(members_reference, TEST_HORIZON_SEC, TEST_STEP_SEC, TEST_STEP_SEC, TEST_STEP_SEC, TEST_MAX_PARALLEL, stats_reference, member_setup);
+	if (num_completed_reference != TEST_NUM_MEMBERS) {
+		printf("FAILED: Run without perturbations completed %d of %d members\n", num_completed_reference, TEST_NUM_MEMBERS);
+		num_failures++;
+	}
+
+	if ((stats[0].size() != (size_t)get_num_flights()) || (stats_reference.size() != stats[0].size())) {
+		printf("FAILED: %d flight statistics for %d flights\n", (int)stats[0].size(), get_num_flights());
+		num_failures++;
+	}
+
+	for (unsigned int i = 0; (i < stats[0].size()) && (i < stats[1].size()); i++) {
+		if (!same_stats(stats[0][i], stats[1][i])) {
+			printf("FAILED: Statistics of flight %s differ between runs\n", stats[0][i].callsign.c_str());
+			num_failures++;
+		}
+
+		if (i < stats_reference.size()) {
+			num_failures += check_arrival_stats(stats[0][i], stats_reference[i]);
+		}
+
+		printf("  %s: %d members, %d landed, mean arrival %f sec (p05 %f, p50 %f, p95 %f), mean delay %f sec\n",
+				stats[0][i].callsign.c_str(), stats[0][i].member_count, stats[0][i].landed_count,
+				stats[0][i].arrival_time_mean_sec, stats[0][i].arrival_time_p05_sec, stats[0][i].arrival_time_p50_sec, stats[0][i].arrival_time_p95_sec, stats[0][i].departure_delay_mean_sec);
+	}
+
+	printf("test_ensemble: %d members, OMP_NUM_THREADS=%s, %d failures\n", TEST_NUM_MEMBERS, getenv("OMP_NUM_THREADS"), num_failures);
+
+	return (num_failures == 0) ? 0 : 1;
+}
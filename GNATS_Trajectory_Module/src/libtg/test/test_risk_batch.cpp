@@ -0,0 +1,235 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+ * test_risk_batch.cpp
+ *
+ * Equivalence test of calculate_risk_batch() against the aviation
+ * occurrence checks calculateRisk() carried before the batch evaluation.
+ *
+ * The reference below is a transcription of the original string protocol
+ * checks.  Its phase windows were chained comparisons such as
+ * "6 < phase1 < 10", which C++ evaluates as "(6 < phase1) < 10"; the
+ * reference spells that evaluation out so the batch helpers
+ * legacy_phase_window_lt() and legacy_phase_window_gt() are compared
+ * against it for every flight phase, including values outside the enum.
+ * Read that way, the windows of WAKE always hold and those of CFIT, TE
+ * and RE never do.
+ *
+ * Runway occurrences (OS, CTOL, TI, US, ML) need an airport layout and
+ * are left out.  OS uses the same phase window as RE.
+ */
+
+#include "tg_riskMeasures.h"
+#include "tg_simulation.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define TEST_PHASE_MIN -2
+#define TEST_PHASE_MAX 40
+
+// Value of a chained comparison "a OP1 b OP2 c" as the compiler reads it
+static inline int chained_lt(const int a, const int b, const int c) {
+	const int inner = (a < b) ? 1 : 0;
+
+	return (inner < c) ? 1 : 0;
+}
+
+static inline int chained_gt(const int a, const int b, const int c) {
+	const int inner = (a > b) ? 1 : 0;
+
+	return (inner > c) ? 1 : 0;
+}
+
+// calculateDistance() of the engine
+static double legacy_distance(double lat1, double lon1, double alt1, double lat2, double lon2, double alt2) {
+	int R = 6371;
+	double latDistance, lonDistance, a, c, distance, altDiff;
+
+	latDistance = (lat2 - lat1) * M_PI / 180.;
+	lonDistance = (lon2 - lon1) * M_PI / 180.;
+	a = sin(latDistance / 2) * sin(latDistance / 2)
+			+ cos(lat1 * M_PI / 180.) * cos(lat2 * M_PI / 180.)
+			* sin(lonDistance / 2) * sin(lonDistance / 2);
+	c = 2 * atan2(sqrt(a), sqrt(1 - a));
+	distance = R * c * 1000;
+
+	altDiff = (alt1 - alt2) * 0.3048;
+	distance = pow(distance, 2) + pow(altDiff, 2);
+
+	return sqrt(distance) * 0.00062137;
+}
+
+/*
+ * Occurrence bit mask of the original checks, without the runway ones.
+ */
+static unsigned int legacy_risk_flags(const risk_case_t& riskCase, const vector<double>& weather) {
+	const risk_state_t& f1 = riskCase.aircraft1;
+	const risk_state_t& f2 = riskCase.aircraft2;
+	const int phase1 = f1.flight_phase;
+	const int phase2 = f2.flight_phase;
+
+	unsigned int flags = 0;
+
+	double distanceToGo = legacy_distance(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft, f2.latitude_deg, f2.longitude_deg, f2.altitude_ft);
+
+	if (riskCase.flag_pair && (distanceToGo < 0.1))
+		flags |= (1u << RISK_AOC_GCOL);
+
+	if (riskCase.flag_pair && (distanceToGo < 3) && (phase1 > 6))
+		flags |= (1u << RISK_AOC_MAC);
+
+	// 6 < phase1 < 10 && 6 < phase2 < 10
+	if (riskCase.flag_pair && (truncf(f1.course * 10) / 10 == truncf(f2.course * 10) / 10) && (distanceToGo < 3)
+			&& chained_lt(6, phase1, 10) && chained_lt(6, phase2, 10))
+		flags |= (1u << RISK_AOC_WAKE);
+
+	if (weather.size() > 4) {
+		distanceToGo = legacy_distance(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft, weather.at(0), weather.at(1), weather.at(4));
+		if ((distanceToGo < 4.7) && (phase1 > 6))
+			flags |= (1u << RISK_AOC_WSTRW);
+	}
+
+	// 21 > phase1 > 6
+	distanceToGo = legacy_distance(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft, f1.latitude_deg, f1.longitude_deg, 0.0);
+	if ((distanceToGo < 4.7) && chained_gt(21, phase1, 6))
+		flags |= (1u << RISK_AOC_CFIT);
+
+	// (22 > phase1 > 19) || (4 > phase1 > 1) and (20 > phase1 > 17) || (6 > phase1 > 3)
+	distanceToGo = legacy_distance(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft,
+			f1.latitude_deg + (sin(1 / (f1.latitude_deg * M_PI / 180.0))),
+			f1.longitude_deg + (sin(1 / (f1.longitude_deg * M_PI / 180.0))),
+			f1.altitude_ft);
+	if ((distanceToGo < 86.52) && (chained_gt(22, phase1, 19) || chained_gt(4, phase1, 1)))
+		flags |= (1u << RISK_AOC_TE);
+	if ((distanceToGo < 86.52) && (chained_gt(20, phase1, 17) || chained_gt(6, phase1, 3)))
+		flags |= (1u << RISK_AOC_RE);
+
+	distanceToGo = legacy_distance(f1.latitude_deg, f1.longitude_deg, f1.altitude_ft, f2.latitude_deg, f2.longitude_deg, f2.altitude_ft);
+	if (riskCase.flag_pair && (distanceToGo < .375))
+		flags |= (1u << RISK_AOC_RI);
+
+	return flags;
+}
+
+static risk_state_t make_state(const double latitude_deg, const double longitude_deg, const double altitude_ft,
+		const double course, const int flight_phase) {
+	risk_state_t state;
+	state.latitude_deg = latitude_deg;
+	state.longitude_deg = longitude_deg;
+	state.altitude_ft = altitude_ft;
+	state.course = course;
+	state.speed_knots = 250;
+	state.rocd_fps = 0;
+	state.flight_phase = flight_phase;
+	state.flight_seq = -1; // No runway lookup
+
+	return state;
+}
+
+int main() {
+	// Weather cell next to the first aircraft position
+	weatherSample.clear();
+	weatherSample.push_back(37.62);
+	weatherSample.push_back(-122.37);
+	weatherSample.push_back(0);
+	weatherSample.push_back(0);
+	weatherSample.push_back(3000);
+
+	// Positions close enough for every distance threshold, and far apart
+	const double altitudes_ft[] = {0, 1500, 3000, 12000, 35000};
+	const double separations_deg[] = {0, 0.001, 0.02, 1.0};
+	const double courses[] = {1.23, 1.24};
+
+	vector<risk_case_t> cases;
+
+	for (int phase1 = TEST_PHASE_MIN; phase1 <= TEST_PHASE_MAX; phase1++) {
+		for (int phase2 = TEST_PHASE_MIN; phase2 <= TEST_PHASE_MAX; phase2 += 3) {
+			for (unsigned int a = 0; a < sizeof(altitudes_ft) / sizeof(double); a++) {
+				for (unsigned int s = 0; s < sizeof(separations_deg) / sizeof(double); s++) {
+					for (unsigned int c = 0; c < sizeof(courses) / sizeof(double); c++) {
+						risk_case_t riskCase;
+						riskCase.aircraft1 = make_state(37.62, -122.37, altitudes_ft[a], courses[0], phase1);
+						riskCase.aircraft2 = make_state(37.62 + separations_deg[s], -122.37, altitudes_ft[a], courses[c], phase2);
+						riskCase.flag_pair = (s + c) % 3 != 2;
+
+						cases.push_back(riskCase);
+					}
+				}
+			}
+		}
+	}
+
+	vector<risk_result_t> results(cases.size());
+	if (calculate_risk_batch(cases.size(), cases.data(), results.data()) != 0) {
+		printf("FAILED: calculate_risk_batch() rejected the cases\n");
+
+		return 1;
+	}
+
+	const unsigned int runway_mask = (1u << RISK_AOC_OS) | (1u << RISK_AOC_CTOL) | (1u << RISK_AOC_TI) | (1u << RISK_AOC_US) | (1u << RISK_AOC_ML);
+
+	int num_failures = 0;
+	unsigned int seen_flags = 0;
+
+	for (unsigned int i = 0; i < cases.size(); i++) {
+		const unsigned int expected = legacy_risk_flags(cases[i], weatherSample);
+		const unsigned int actual = results[i].aoc_flags;
+
+		seen_flags |= expected;
+
+		if ((actual & runway_mask) != 0) {
+			printf("FAILED: case %u reports a runway occurrence without a runway\n", i);
+			num_failures++;
+		} else if (actual != expected) {
+			printf("FAILED: case %u phases %d/%d, expected flags 0x%x, got 0x%x\n",
+					i, cases[i].aircraft1.flight_phase, cases[i].aircraft2.flight_phase, expected, actual);
+			num_failures++;
+		}
+	}
+
+	// The chained windows of CFIT, TE and RE never hold, the occurrences
+	// with a reachable condition must have been exercised
+	const ENUM_Risk_AOC reachable[] = {RISK_AOC_GCOL, RISK_AOC_MAC, RISK_AOC_WAKE, RISK_AOC_WSTRW, RISK_AOC_RI};
+	for (unsigned int k = 0; k < sizeof(reachable) / sizeof(ENUM_Risk_AOC); k++) {
+		if ((seen_flags & (1u << reachable[k])) == 0) {
+			printf("FAILED: no case raised %s\n", RISK_AOC_CODES[reachable[k]]);
+			num_failures++;
+		}
+	}
+
+	printf("test_risk_batch: %d cases, %d failures\n", (int)cases.size(), num_failures);
+
+	return (num_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,338 @@
+/*
+------------------------------------- Credits -----------------------------------------------------------------
+Generalized National Airspace Trajectory Simulation (GNATS) software
+2017-2021 GNATS Development Team at Optimal Synthesis Inc. are:
+Team Lead, Software Architecture and Algorithms: Dr. P. K. Menon
+Algorithms and Prototyping: Dr. Parikshit Dutta
+Java and C++ Code Development: Oliver Chen and Hari N. Iyer
+Illustrative Examples in Python and MATLAB: Dr. Parikshit Dutta, Dr. Bong-Jun Yang, Hari Iyer
+Illustrative Examples in SciLab and R: Hari Iyer
+Vedik Jayaraj (Summer Intern) helped digitize 39 US airports together with the Arrival-Departure procedures and helped in beta testing of GNATS.
+Acknowledgements: 
+GNATS software was developed under the Arizona State University Subaward No. 18-275 under the NASA University Leadership Initiative Prime Contract No. NNX17AJ86A, with Professor Yongming Liu serving as the Principal Investigator. 
+Beta Testing outside Optimal Synthesis Inc. was carried out at Arizona State University under the direction of Professor Yongming Liu, at Vanderbilt University under the direction of Professor Sankaran Mahadevan and Professor Pranav Karve, at the Southwest Research Institute under the direction of Dr. Baron Bichon and Dr. Erin DeCarlo, and at Carnegie-Mellon University under the direction of Professor Pingbo Tang.
+NASA Technical points-of-contact: Dr. Anupa Bajwa, Dr. Kaushik Datta, Dr. John Cavolowsky, Dr. Kai Goebel
+------------------------------------Legacy Source Code--------------------------------------------------------
+Legacy Code for the GNATS software was derived from the software packages developed under the following NASA Small Business Innovation Research Projects:
+1. 2004-2006 NASA Contract No. NNA05BE64C with Dr. Shon Grabbe of NASA Ames Research Center as the Technical Monitor.
+2. 2008-2010 NASA Contract No. NNX08CA02C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+3. 2010-2011 NASA Phase III Contract No. NNA10DC12C with Dr. Joseph Rios of Ames Research Center as the Technical Monitor.
+4. 2016-2018 NASA Contract No. NNX16CL11C with Dr. Nash’at Ahmad of NASA Langley Research Center as the Technical Monitor.
+
+Contributors to these SBIR projects at Optimal Synthesis Inc. were: Dr. P. K. Menon (Principal Investigator), Jason Kwan (Software Engineer), Gerald M. Diaz (Software Engineer), Dr. Monish Tandale (Research Scientist), Dr. Prasenjit Sengupta (Research Scientist), Dr. Sang-Gyun Park (Research Scientist) and Dr. Parikshit Dutta (Research Scientist).
+The inspiration for the SBIR projects is derived from the FACET software developed at NASA Ames Research Center by Dr. Banavar Sridhar, Dr. Karl Bilimoria, Dr. Gano Chatterji, Dr. Shon Grabbe and Dr. Kapil Sheth.
+
+Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for 40 major US Airports
+---------------------------------------------------------------------------------------------------------------------
+*/
+
+/*
+
+/*
+ * test_skip_processing.cpp
+ *
+ * Test of the modes that skip the processing of steady flights against
+ * propagation that processes every step.
+ *
+ * The two aircraft demo is propagated once per mode, each time in a new
+ * process: once processing every step, which is the reference, and once
+ * with each of cruise fast-forward and steady step skipping.  Every run
+ * has to record samples at the same times in the same flight phases as
+ * the reference, and its positions have to stay within TEST_TOLERANCE_FT
+ * horizontally and TEST_TOLERANCE_ALTITUDE_FT vertically.  Each mode has
+ * to skip the processing of its share of steps, and its estimated errors
+ * have to be within the same tolerances.  The estimated errors summed
+ * over the intervals of one flight have to bound the measured horizontal
+ * difference, up to the rounding of the recorded positions.
+ *
+ * All time steps are TEST_STEP_SEC.  Without wind data the flights are
+ * steady on the surface and in cruise, and the performance tables keep
+ * the held values of a climb or descent within STEADY_SKIP_TOLERANCE_FT
+ * per interval, so the differences stay well within the tolerances.
+ */
+
+#include "tg_api.h"
+#include "tg_aircraft.h"
+#include "tg_simulation.h"
+
+#include "geometry_utils.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define TEST_HORIZON_SEC 7200
+#define TEST_STEP_SEC 10
+#define TEST_TIMEOUT_SEC 600
+
+// Largest allowed difference to processing every step
+#define TEST_TOLERANCE_FT 25.0
+#define TEST_TOLERANCE_ALTITUDE_FT 5.0
+
+// Rounding of recorded positions allowed beyond the estimated errors
+#define TEST_ROUNDING_FT 1.0
+
+static const string TEST_TRX_FILE = "share/tg/trx/TRX_DEMO_2Aircrafts_RiskMeasures_test_geo.trx";
+static const string TEST_MFL_FILE = "share/tg/trx/TRX_DEMO_2Aircrafts_RiskMeasures_test_mfl.trx";
+
+typedef struct _test_mode_t {
+	const char* name;
+	int (*enable)(const bool& flag);
+	void (*get_stats)(fast_forward_stats_t* const stats);
+	double min_skipped_ratio; // Smallest share of the counted steps that must skip the processing
+} test_mode_t;
+
+// The first mode is the reference
+static const test_mode_t TEST_MODES[] = {
+	{"every step", NULL, NULL, 0},
+	{"cruise fast-forward", tg_enable_cruise_fast_forward, get_cruise_fast_forward_stats, 0.8},
+	{"steady step skip", tg_enable_steady_step_skip, get_steady_step_skip_stats, 0.3}
+};
+
+#define TEST_NUM_MODES ((int)(sizeof(TEST_MODES) / sizeof(TEST_MODES[0])))
+
+typedef struct _test_sample_t {
+	int flight_index;
+	double t;
+	double lat;
+	double lon;
+	double altitude;
+	int flight_phase;
+} test_sample_t;
+
+/*
+ * Body of one run process.  Writes the counters of the mode, then every
+ * trajectory sample.
+ */
+static int run_propagation(const int index_mode, const string& fname) {
+	const test_mode_t& mode = TEST_MODES[index_mode];
+
+	alarm(TEST_TIMEOUT_SEC);
+
+	if (tg_init() != 0) {
+		printf("FAILED: tg_init()\n");
+
+		return -1;
+	}
+
+	if ((tg_load_trx(TEST_TRX_FILE, TEST_MFL_FILE) != 0) || (get_num_flights() <= 0)) {
+		printf("FAILED: Can't load %s\n", TEST_TRX_FILE.c_str());
+
+		return -1;
+	}
+
+	if (mode.enable != NULL) {
+		mode.enable(true);
+	}
+
+	if (propagate_flights(TEST_HORIZON_SEC, TEST_STEP_SEC, TEST_STEP_SEC, TEST_STEP_SEC) != 0)
+		return -1;
+
+	nats_simulation_operator(NATS_SIMULATION_STATUS_START);
+
+	while (get_runtime_sim_status() != NATS_SIMULATION_STATUS_ENDED) {
+		usleep(nats_simulation_check_interval);
+	}
+
+	FILE* fp = fopen(fname.c_str(), "w");
+	if (fp == NULL)
+		return -1;
+
+	fast_forward_stats_t stats;
+	memset(&stats, 0, sizeof(stats));
+	if (mode.get_stats != NULL) {
+		mode.get_stats(&stats);
+	}
+
+	fprintf(fp, "stats %lld %lld %a %a %a\n", stats.skipped_steps, stats.total_steps, stats.max_error_ft, stats.max_error_altitude_ft, stats.max_flight_error_ft);
+
+	for (unsigned int i = 0; i < g_trajectories.size(); i++) {
+		const Trajectory& trajectory = g_trajectories.at(i);
+
+		for (unsigned int j = 0; j < trajectory.timestamp.size(); j++) {
+			fprintf(fp, "%u %a %a %a %a %d\n", i, (double)trajectory.timestamp.at(j),
+					(double)trajectory.latitude_deg.at(j), (double)trajectory.longitude_deg.at(j),
+					(double)trajectory.altitude_ft.at(j), (int)trajectory.flight_phase.at(j));
+		}
+	}
+
+	return (fclose(fp) == 0) ? 0 : -1;
+}
+
+static int run_self(char* argv0, const int index_mode, const string& fname) {
+	char str_mode[16];
+	snprintf(str_mode, sizeof(str_mode), "%d", index_mode);
+
+	fflush(stdout);
+
+	pid_t pid = fork();
+	if (pid < 0)
+		return -1;
+
+	if (pid == 0) {
+		char* child_argv[] = {argv0, (char*)"run", str_mode, (char*)fname.c_str(), NULL};
+		execv("/proc/self/exe", child_argv);
+
+		_exit(1);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	return (WIFEXITED(status) && (WEXITSTATUS(status) == 0)) ? 0 : -1;
+}
+
+static int read_samples(const string& fname, vector<test_sample_t>& samples, fast_forward_stats_t* stats) {
+	FILE* fp = fopen(fname.c_str(), "r");
+	if (fp == NULL)
+		return -1;
+
+	memset(stats, 0, sizeof(fast_forward_stats_t));
+	if (fscanf(fp, "stats %lld %lld %la %la %la\n", &stats->skipped_steps, &stats->total_steps, &stats->max_error_ft, &stats->max_error_altitude_ft, &stats->max_flight_error_ft) != 5) {
+		fclose(fp);
+
+		return -1;
+	}
+
+	test_sample_t sample;
+	while (fscanf(fp, "%d %la %la %la %la %d\n", &sample.flight_index, &sample.t, &sample.lat, &sample.lon, &sample.altitude, &sample.flight_phase) == 6) {
+		samples.push_back(sample);
+	}
+
+	fclose(fp);
+
+	return 0;
+}
+
+/*
+ * Checks the run of one mode against the reference.  Returns the number
+ * of failures.
+ */
+static int check_mode(const test_mode_t& mode,
+		const vector<test_sample_t>& samples_reference,
+		const vector<test_sample_t>& samples,
+		const fast_forward_stats_t& stats) {
+	int num_failures = 0;
+
+	if (samples_reference.empty() || (samples_reference.size() != samples.size())) {
+		printf("FAILED: %u samples processing every step, %u with %s\n", (unsigned int)samples_reference.size(), (unsigned int)samples.size(), mode.name);
+
+		return 1;
+	}
+
+	if ((stats.total_steps <= 0) || (stats.skipped_steps <= 0) || (stats.skipped_steps < mode.min_skipped_ratio * stats.total_steps)) {
+		printf("FAILED: %lld of %lld steps skipped the processing with %s\n", stats.skipped_steps, stats.total_steps, mode.name);
+		num_failures++;
+	}
+
+	if ((TEST_TOLERANCE_FT < stats.max_error_ft) || (TEST_TOLERANCE_ALTITUDE_FT < stats.max_error_altitude_ft)) {
+		printf("FAILED: Estimated errors %.1f ft along track, %.1f ft in altitude with %s\n", stats.max_error_ft, stats.max_error_altitude_ft, mode.name);
+		num_failures++;
+	}
+
+	double max_difference_ft = 0;
+	double max_difference_altitude_ft = 0;
+
+	for (unsigned int i = 0; i < samples_reference.size(); i++) {
+		const test_sample_t& a = samples_reference[i];
+		const test_sample_t& b = samples[i];
+
+		if ((a.flight_index != b.flight_index) || (a.t != b.t) || (a.flight_phase != b.flight_phase)) {
+			printf("FAILED: Flight %d at t = %.0f in phase %d processing every step, flight %d at t = %.0f in phase %d with %s\n",
+					a.flight_index, a.t, a.flight_phase, b.flight_index, b.t, b.flight_phase, mode.name);
+			num_failures++;
+
+			break;
+		}
+
+		max_difference_ft = max(max_difference_ft, compute_distance_gc(a.lat, a.lon, b.lat, b.lon, 0));
+		max_difference_altitude_ft = max(max_difference_altitude_ft, fabs(a.altitude - b.altitude));
+	}
+
+	if ((TEST_TOLERANCE_FT < max_difference_ft) || (TEST_TOLERANCE_ALTITUDE_FT < max_difference_altitude_ft)) {
+		printf("FAILED: Positions differ by up to %.1f ft, altitudes by up to %.1f ft with %s\n", max_difference_ft, max_difference_altitude_ft, mode.name);
+		num_failures++;
+	}
+
+	if (stats.max_flight_error_ft + TEST_ROUNDING_FT < max_difference_ft) {
+		printf("FAILED: Positions differ by up to %.1f ft, estimated at most %.1f ft with %s\n", max_difference_ft, stats.max_flight_error_ft, mode.name);
+		num_failures++;
+	}
+
+	printf("test_skip_processing: %s skipped %lld of %lld steps, max difference %.3f ft, altitude %.3f ft, estimated %.3f ft per interval, %.3f ft per flight, altitude %.3f ft\n",
+			mode.name, stats.skipped_steps, stats.total_steps, max_difference_ft, max_difference_altitude_ft, stats.max_error_ft, stats.max_flight_error_ft, stats.max_error_altitude_ft);
+
+	return num_failures;
+}
+
+int main(int argc, char* argv[]) {
+	if ((argc == 4) && (string(argv[1]) == "run")) {
+		const int index_mode = atoi(argv[2]);
+		if ((index_mode < 0) || (TEST_NUM_MODES <= index_mode))
+			return 1;
+
+		return (run_propagation(index_mode, argv[3]) == 0) ? 0 : 1;
+	}
+
+	char dir_template[] = "/tmp/test_skip_processing_XXXXXX";
+	if (mkdtemp(dir_template) == NULL) {
+		printf("FAILED: Can't create a temporary folder\n");
+
+		return 1;
+	}
+	const string dir(dir_template);
+
+	int num_failures = 0;
+
+	vector<string> fnames;
+	vector<test_sample_t> samples_reference;
+
+	for (int i = 0; i < TEST_NUM_MODES; i++) {
+		char fname[64];
+		snprintf(fname, sizeof(fname), "/mode_%d.txt", i);
+		fnames.push_back(dir + fname);
+
+		vector<test_sample_t> samples;
+		fast_forward_stats_t stats;
+
+		if ((run_self(argv[0], i, fnames.back()) != 0) || (read_samples(fnames.back(), samples, &stats) != 0)) {
+			printf("FAILED: Run with %s\n", TEST_MODES[i].name);
+			num_failures++;
+
+			if (i == 0)
+				break;
+
+			continue;
+		}
+
+		if (i == 0) {
+			samples_reference.swap(samples);
+		} else {
+			num_failures += check_mode(TEST_MODES[i], samples_reference, samples, stats);
+		}
+	}
+
+	// Files of failed runs are kept for inspection
+	if (num_failures == 0) {
+		for (unsigned int i = 0; i < fnames.size(); i++) {
+			unlink(fnames[i].c_str());
+		}
+		rmdir(dir.c_str());
+	} else {
+		printf("Outputs are in %s\n", dir.c_str());
+	}
+
+	printf("test_skip_processing: %d failures\n", num_failures);
+
+	return (num_failures == 0) ? 0 : 1;
+}
@@ -54,6 +54,8 @@ Dr. Victor H. L. Cheng of Optimal Synthesis Inc. provided the digitized data for
 
 #include <dirent.h>
 #include <getopt.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -76,6 +78,15 @@ typedef struct _grib_filename_t {
   int    forecast_hour;
 } grib_filename_t;
 
+/*
+ * One hourly GRIB file to convert
+ */
+typedef struct _wind_task_t {
+  int    hour;
+  string grib_file;
+  string out_file;
+} wind_task_t;
+
 static string g_config_file = "wind_tool.conf";
 
 static string g_outdir = ".";
@@ -93,6 +104,27 @@ static double g_alt_max;
 static double g_alt_step;
 static string g_grid_definition_file;
 
+// Number of hours converted concurrently.  0 means one per OpenMP thread.
+static int g_num_jobs = 0;
+
+// Memory budget in MB for hours in flight.  0 means no limit.
+static size_t g_max_memory_mb = 0;
+
+// Deflate level of the wind datasets.  0 disables compression.
+static int g_compress_level = 0;
+
+// Reconvert hours whose output file already exists
+static bool g_overwrite = false;
+
+// Target size of one HDF5 chunk of a wind dataset
+static const size_t WIND_CHUNK_BYTES = 1 << 20;
+
+static pthread_mutex_t g_budget_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_budget_cond = PTHREAD_COND_INITIALIZER;
+static size_t g_budget_in_use = 0;
+static size_t g_budget_estimate = 0;
+static int g_budget_jobs = 0;
+
 
 /**
  * Print usage
@@ -103,6 +135,13 @@ static void print_usage(char* progname) {
   printf("  Option:\n");
   printf("    --config-file=<file>    -f <file>   Configuration file\n");
   printf("    --out-folder=<dir>      -o <dir>    Output folder\n");
+  printf("    --jobs=<n>              -j <n>      Number of hours converted in parallel\n");
+  printf("                                        (default: number of OpenMP threads)\n");
+  printf("    --max-memory=<MB>       -m <MB>     Memory budget for hours in flight\n");
+  printf("                                        (default: no limit)\n");
+  printf("    --compress=<0-9>        -z <0-9>    Deflate level of wind datasets\n");
+  printf("                                        (default: 0, no compression)\n");
+  printf("    --overwrite             -w          Reconvert hours already converted\n");
   printf("    --help                  -h          Print this message\n");
   printf("\n");
 }
@@ -122,11 +161,15 @@ static void parse_args(int argc, char* argv[]) {
     static struct option opts[] = {
       {"config-file", 1, 0, 'f'},
       {"out-folder", 1, 0, 'o'},
+      {"jobs", 1, 0, 'j'},
+      {"max-memory", 1, 0, 'm'},
+      {"compress", 1, 0, 'z'},
+      {"overwrite", 0, 0, 'w'},
       {"help", 0, 0, 'h'},
       {0, 0, 0, 0}
     };
 
-    string optstr = "f:o:h";
+    string optstr = "f:o:j:m:z:wh";
 
     c = getopt_long(argc, argv, optstr.c_str(), opts, &option_index);
     if (c == -1) {
@@ -140,6 +183,21 @@ static void parse_args(int argc, char* argv[]) {
     case 'o':
       g_outdir = optarg;
       break;
+    case 'j':
+      g_num_jobs = atoi(optarg);
+      if (g_num_jobs < 0) g_num_jobs = 0;
+      break;
+    case 'm':
+      g_max_memory_mb = (atol(optarg) > 0) ? atol(optarg) : 0;
+      break;
+    case 'z':
+      g_compress_level = atoi(optarg);
+      if (g_compress_level < 0) g_compress_level = 0;
+      if (g_compress_level > 9) g_compress_level = 9;
+      break;
+    case 'w':
+      g_overwrite = true;
+      break;
     case 'h':
     default:
       print_usage(argv[0]);
@@ -579,26 +637,392 @@ static int write_hdf5(const string& hdf5_file,
 }
 */
 
-static int build_wind_grid(const GribData& grib, WindGrid* const grid) {
-    if(!grid) return -1;
-    int index = 0;
-    for(double lat=grid->lat_min; lat<=grid->lat_max; lat+=grid->lat_step) {
-      for(double lon=grid->lon_min; lon<=grid->lon_max; lon+=grid->lon_step) {
-        for(double alt=grid->alt_min; alt<=grid->alt_max; alt+=grid->alt_step) {
+static double delta_timeval(struct timeval& tvend, struct timeval& tvstart) {
+  double dsec = tvend.tv_sec - tvstart.tv_sec;
+  double dusec = tvend.tv_usec - tvstart.tv_usec;
+  return (dsec + dusec / 1000000.); // seconds
+}
+
+/*
+ * Set the grid definition fields of a WindGrid without allocating its
+ * tables.  Sizes follow the WindGrid constructor.
+ */
+static void init_grid_definition(WindGrid* const grid) {
+    grid->lat_min = g_lat_min;
+    grid->lat_max = g_lat_max;
+    grid->lat_step = g_lat_step;
+    grid->lon_min = g_lon_min;
+    grid->lon_max = g_lon_max;
+    grid->lon_step = g_lon_step;
+    grid->alt_min = g_alt_min;
+    grid->alt_max = g_alt_max;
+    grid->alt_step = g_alt_step;
+
+    grid->lat_size = (int)1+ceil((g_lat_max-g_lat_min) / g_lat_step);
+    grid->lon_size = (int)1+ceil((g_lon_max-g_lon_min) / g_lon_step);
+    grid->alt_size = (int)1+ceil((g_alt_max-g_alt_min) / g_alt_step);
+    grid->table_size = grid->lat_size * grid->lon_size * grid->alt_size;
+}
+
+static void get_grid_def_data(const WindGrid& grid, double* const def_data) {
+    def_data[0] = grid.lat_min;
+    def_data[1] = grid.lat_max;
+    def_data[2] = grid.lat_step;
+    def_data[3] = grid.lon_min;
+    def_data[4] = grid.lon_max;
+    def_data[5] = grid.lon_step;
+    def_data[6] = grid.alt_min;
+    def_data[7] = grid.alt_max;
+    def_data[8] = grid.alt_step;
+    def_data[9] = (double)grid.lat_size;
+    def_data[10] = (double)grid.lon_size;
+    def_data[11] = (double)grid.alt_size;
+    def_data[12] = (double)grid.table_size;
+}
+
+/*
+ * Compute the wind table rows [lat_begin, lat_begin+lat_count) of an hour.
+ *
+ * Grid points are computed from their index so that the table always
+ * matches the lat_size x lon_size x alt_size layout read by WindGrid.
+ */
+static int build_wind_slab(const GribData& grib,
+                           const WindGrid& grid,
+                           const size_t lat_begin,
+                           const size_t lat_count,
+                           double* const n_data,
+                           double* const e_data) {
+    if(!n_data) return -1;
+    if(!e_data) return -1;
+
+    size_t slab_size = lat_count * grid.lon_size * grid.alt_size;
+    memset(n_data, 0, slab_size * sizeof(double));
+    memset(e_data, 0, slab_size * sizeof(double));
+
+    size_t index = 0;
+    for(size_t i=lat_begin; i<lat_begin+lat_count; ++i) {
+      double lat = grid.lat_min + i * grid.lat_step;
+      for(size_t j=0; j<grid.lon_size; ++j) {
+        double lon = grid.lon_min + j * grid.lon_step;
+        for(size_t k=0; k<grid.alt_size; ++k) {
+          double alt = grid.alt_min + k * grid.alt_step;
           get_wind_components(grib, lat, lon, alt,
-                      &grid->n_data[index], &grid->e_data[index],
+                      &n_data[index], &e_data[index],
                       KNOTS);
           ++index;
         }
       }
     }
+
     return 0;
 }
 
-static double delta_timeval(struct timeval& tvend, struct timeval& tvstart) {
-  double dsec = tvend.tv_sec - tvstart.tv_sec;
-  double dusec = tvend.tv_usec - tvstart.tv_usec;
-  return (dsec + dusec / 1000000.); // seconds
+/*
+ * Number of latitude rows per HDF5 chunk
+ */
+static size_t get_chunk_lat_rows(const WindGrid& grid) {
+    size_t row_bytes = grid.lon_size * grid.alt_size * sizeof(double);
+    size_t rows = (row_bytes > 0) ? WIND_CHUNK_BYTES / row_bytes : 1;
+
+    if (rows < 1) rows = 1;
+    if (rows > grid.lat_size) rows = grid.lat_size;
+
+    return rows;
+}
+
+static size_t get_grib_data_bytes(const GribData& grib) {
+    const map< long, vector<double> >* tables[5] = {
+        &grib.h_data, &grib.u_data, &grib.v_data, &grib.t_data, &grib.p_data};
+
+    size_t bytes = 0;
+    for (int i = 0; i < 5; ++i) {
+      map< long, vector<double> >::const_iterator iter;
+      for (iter = tables[i]->begin(); iter != tables[i]->end(); ++iter) {
+        bytes += iter->second.capacity() * sizeof(double);
+      }
+    }
+
+    return bytes;
+}
+
+/*
+ * Reserve memory budget for one hour before its GRIB file is loaded.
+ *
+ * The reservation uses the largest hour seen so far.  Until the first
+ * hour has been measured, hours are admitted one at a time.  One hour is
+ * always admitted when nothing is in flight so that the conversion makes
+ * progress under any budget.
+ */
+static size_t acquire_memory_budget() {
+    size_t limit = g_max_memory_mb * 1024 * 1024;
+
+    pthread_mutex_lock(&g_budget_mutex);
+
+    while ((limit > 0) && (g_budget_jobs > 0)
+           && ((g_budget_estimate == 0) || (limit < g_budget_in_use + g_budget_estimate))) {
+      pthread_cond_wait(&g_budget_cond, &g_budget_mutex);
+    }
+
+    size_t reserved = g_budget_estimate;
+    g_budget_in_use += reserved;
+    g_budget_jobs++;
+
+    pthread_mutex_unlock(&g_budget_mutex);
+
+    return reserved;
+}
+
+/*
+ * Replace the reservation of an hour with its measured size
+ */
+static void update_memory_budget(const size_t reserved, const size_t actual) {
+    pthread_mutex_lock(&g_budget_mutex);
+
+    g_budget_in_use = g_budget_in_use - reserved + actual;
+    if (g_budget_estimate < actual) g_budget_estimate = actual;
+
+    pthread_mutex_unlock(&g_budget_mutex);
+}
+
+static void release_memory_budget(const size_t actual) {
+    pthread_mutex_lock(&g_budget_mutex);
+
+    g_budget_in_use -= actual;
+    g_budget_jobs--;
+
+    pthread_cond_broadcast(&g_budget_cond);
+    pthread_mutex_unlock(&g_budget_mutex);
+}
+
+/*
+ * Check whether an hour was converted by a previous run with the same grid
+ * definition.  Output files are renamed into place only when complete, so
+ * an existing file with a matching grid definition can be reused.
+ *
+ * Called before the parallel conversion starts.
+ */
+static bool is_hour_converted(const string& hdf5_file, const WindGrid& grid) {
+    struct stat info;
+    if (stat(hdf5_file.c_str(), &info) != 0) return false;
+
+    bool retValue = false;
+    hid_t file_id = -1;
+
+    H5E_BEGIN_TRY {
+      file_id = H5Fopen(hdf5_file.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    } H5E_END_TRY;
+
+    if (file_id < 0) return false;
+
+    hid_t def_dataset_id = -1;
+    H5E_BEGIN_TRY {
+      def_dataset_id = H5Dopen2(file_id, "/grid_def", H5P_DEFAULT);
+    } H5E_END_TRY;
+
+    if (def_dataset_id >= 0) {
+      double file_def[13];
+      double grid_def[13];
+
+      get_grid_def_data(grid, grid_def);
+
+      if (H5Dread(def_dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+                  H5P_DEFAULT, file_def) >= 0) {
+        retValue = true;
+        for (int i = 0; i < 13; ++i) {
+          if (fabs(file_def[i] - grid_def[i]) > 1e-9) {
+            retValue = false;
+            break;
+          }
+        }
+      }
+
+      H5Dclose(def_dataset_id);
+    }
+
+    H5Fclose(file_id);
+
+    return retValue;
+}
+
+/*
+ * Compute and write the wind tables of one hour.
+ *
+ * The tables are computed one chunk of latitude rows at a time and written
+ * to chunked, optionally compressed datasets, so only one slab of the
+ * output is held in memory.  HDF5 calls are serialized because the HDF5
+ * library is not built thread-safe.
+ */
+static int write_wind_hour_hdf5(const string& hdf5_file,
+                                const GribData& grib,
+                                const WindGrid& grid) {
+    hsize_t chunk_lat = get_chunk_lat_rows(grid);
+    hsize_t dims[3] = {grid.lat_size, grid.lon_size, grid.alt_size};
+    hsize_t chunk_dims[3] = {chunk_lat, grid.lon_size, grid.alt_size};
+
+    hid_t file_id = -1;
+    hid_t n_dataset_id = -1;
+    hid_t e_dataset_id = -1;
+    hid_t dataspace_id = -1;
+
+    int retValue = 0;
+
+#pragma omp critical(hdf5)
+    {
+      file_id = H5Fcreate(hdf5_file.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+
+      if (file_id >= 0) {
+        dataspace_id = H5Screate_simple(3, dims, NULL);
+
+        hsize_t def_dims[1] = {13};
+        hid_t def_dataspace_id = H5Screate_simple(1, def_dims, NULL);
+
+        // Same grid definition layout as write_wind_grid_hdf5()
+        double def_data[13];
+        get_grid_def_data(grid, def_data);
+
+        hid_t def_dataset_id = H5Dcreate2(file_id, "/grid_def", H5T_NATIVE_DOUBLE,
+                def_dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        H5Dwrite(def_dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+                H5P_DEFAULT, def_data);
+        H5Dclose(def_dataset_id);
+        H5Sclose(def_dataspace_id);
+
+        hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+        H5Pset_chunk(dcpl_id, 3, chunk_dims);
+        if (g_compress_level > 0) {
+          H5Pset_shuffle(dcpl_id);
+          H5Pset_deflate(dcpl_id, g_compress_level);
+        }
+
+        n_dataset_id = H5Dcreate2(file_id, "/wind_north", H5T_NATIVE_DOUBLE,
+                dataspace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+        e_dataset_id = H5Dcreate2(file_id, "/wind_east", H5T_NATIVE_DOUBLE,
+                dataspace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+
+        H5Pclose(dcpl_id);
+      }
+    }
+
+    if ((file_id < 0) || (n_dataset_id < 0) || (e_dataset_id < 0)) {
+      retValue = -1;
+    }
+
+    size_t slab_size = chunk_lat * grid.lon_size * grid.alt_size;
+    vector<double> n_slab((retValue == 0) ? slab_size : 0);
+    vector<double> e_slab((retValue == 0) ? slab_size : 0);
+
+    for (hsize_t lat_begin = 0; (retValue == 0) && (lat_begin < grid.lat_size); lat_begin += chunk_lat) {
+      hsize_t lat_count = min(chunk_lat, (hsize_t)grid.lat_size - lat_begin);
+
+      build_wind_slab(grib, grid, lat_begin, lat_count, &n_slab[0], &e_slab[0]);
+
+#pragma omp critical(hdf5)
+      {
+        hsize_t offset[3] = {lat_begin, 0, 0};
+        hsize_t count[3] = {lat_count, grid.lon_size, grid.alt_size};
+
+        hid_t memspace_id = H5Screate_simple(3, count, NULL);
+        H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET, offset, NULL, count, NULL);
+
+        if ((H5Dwrite(n_dataset_id, H5T_NATIVE_DOUBLE, memspace_id, dataspace_id,
+                      H5P_DEFAULT, &n_slab[0]) < 0)
+            || (H5Dwrite(e_dataset_id, H5T_NATIVE_DOUBLE, memspace_id, dataspace_id,
+                         H5P_DEFAULT, &e_slab[0]) < 0)) {
+          retValue = -1;
+        }
+
+        H5Sclose(memspace_id);
+      }
+    }
+
+#pragma omp critical(hdf5)
+    {
+      if (n_dataset_id >= 0) H5Dclose(n_dataset_id);
+      if (e_dataset_id >= 0) H5Dclose(e_dataset_id);
+      if (dataspace_id >= 0) H5Sclose(dataspace_id);
+
+      if ((file_id >= 0) && (H5Fclose(file_id) < 0)) {
+        retValue = -1;
+      }
+    }
+
+    return retValue;
+}
+
+/*
+ * Load the GRIB file of one hour and write its wind tables to hdf5_file.
+ *
+ * The GRIB data is released on return.  Its measured size replaces the
+ * memory budget reservation and is returned in budget.
+ */
+static int load_and_write_wind_hour(const wind_task_t& task,
+                                    const WindGrid& grid,
+                                    const string& hdf5_file,
+                                    size_t* const budget) {
+    GribData grib;
+    int err = 0;
+
+    // GRIB decoding is serialized since grib_api is not guaranteed to be
+    // built with thread support.
+#pragma omp critical(grib_api)
+    {
+#ifndef _INC__MINGW_H
+      err = load_grib(task.grib_file, &grib);
+#else
+      err = load_grib_v2_win(task.grib_file, &grib);
+#endif
+    }
+
+    size_t slab_bytes = get_chunk_lat_rows(grid) * grid.lon_size * grid.alt_size * 2 * sizeof(double);
+    size_t actual = get_grib_data_bytes(grib) + slab_bytes;
+    update_memory_budget(*budget, actual);
+    *budget = actual;
+
+    if (err != 0) return err;
+
+    printf("  hour: %d,  file: %s,  GRIB edition: %d,  levels: %d,  grid size: %d, %d\n",
+           task.hour, task.grib_file.c_str(), grib.grib_edition,
+           (int)grib.h_data.size(), grib.grid_ni, grib.grid_nj);
+
+    return write_wind_hour_hdf5(hdf5_file, grib, grid);
+}
+
+/*
+ * Convert one hourly GRIB file.
+ *
+ * Output goes to a temporary file that is renamed to its final name when
+ * complete, so an interrupted run never leaves a truncated output file.
+ */
+static int convert_wind_hour(const wind_task_t& task, const WindGrid& grid) {
+    struct timeval t_start, t_end;
+    gettimeofday(&t_start, NULL);
+
+    string part_file = task.out_file + ".part";
+
+    size_t budget = acquire_memory_budget();
+
+    int err = load_and_write_wind_hour(task, grid, part_file, &budget);
+
+    release_memory_budget(budget);
+
+    if (err == 0) {
+      if (rename(part_file.c_str(), task.out_file.c_str()) != 0) {
+        err = -1;
+      }
+    }
+
+    gettimeofday(&t_end, NULL);
+
+    if (err == 0) {
+      printf("    hour %d written to %s (%.1f sec)\n", task.hour,
+             task.out_file.c_str(), delta_timeval(t_end, t_start));
+    } else {
+      fprintf(stderr, "ERROR: could not convert hour %d, file %s\n",
+              task.hour, task.grib_file.c_str());
+      unlink(part_file.c_str());
+    }
+
+    return err;
 }
 
 
@@ -654,68 +1078,81 @@ int main(int argc, char* argv[]) {
 		  g_lon_min, g_lon_max, g_lon_step,
 		  g_alt_min, g_alt_max, g_alt_step);
 
-    // compute table sizes
-    size_t lat_size = (int)1+ceil((g_lat_max-g_lat_min) / g_lat_step);
-    size_t lon_size = (int)1+ceil((g_lon_max-g_lon_min) / g_lon_step);
-    size_t alt_size = (int)1+ceil((g_alt_max-g_alt_min) / g_alt_step);
+    WindGrid grid;
+    init_grid_definition(&grid);
 
-    // iterate over each entry and load the grib data
-    map<int,string>::iterator iter;
-//  map<int, GribData> grib_data;
-  
-    //TODO:PARIKSHIT ADDER
-    unsigned int num_time_steps = g_grib_files.size();
+    printf("\n");
+    printf("    Output Table Bounds:\n");
+    printf("      Latitude -  min: %f, max: %f, step: %f\n",
+           g_lat_min, g_lat_max, g_lat_step);
+    printf("      Longitude - min: %f, max: %f, step: %f\n",
+           g_lon_min, g_lon_max, g_lon_step);
+    printf("      Altitude -  min: %f, max: %f, step: %f\n",
+           g_alt_min, g_alt_max, g_alt_step);
+    printf("      Latitude cells:  %ld\n", grid.lat_size);
+    printf("      Longitude cells: %ld\n", grid.lon_size);
+    printf("      Altitude cells:  %ld\n\n", grid.alt_size);
+
+    if ((g_compress_level > 0) && (H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)) {
+      fprintf(stderr, "WARNING: HDF5 deflate filter not available.  Writing uncompressed datasets.\n");
+      g_compress_level = 0;
+    }
 
-    hsize_t t_dims[1] = {num_time_steps};
-    hid_t def_dataspace_id = H5Screate_simple(1, t_dims, NULL);
+    // Collect the hours to convert.  Hours whose output file is complete
+    // are skipped so that an interrupted conversion can be resumed.
+    vector<wind_task_t> tasks;
+    map<string, int> out_files;
+    int num_skipped = 0;
 
+    map<int,string>::iterator iter;
     for (iter = g_grib_files.begin(); iter != g_grib_files.end(); ++iter) {
-        printf("  hour: %d,  file: %s\n", iter->first, iter->second.c_str());
-
-        GribData grib;
-
-#ifndef _INC__MINGW_H
-        load_grib(iter->second, &grib);
-#else
-	    load_grib_v2_win(iter->second, &grib);
-#endif
-
-        int num_levels = grib.h_data.size();
-
-        printf("\n    GRIB edition: %d\n", grib.grib_edition);
-        printf("\n    Num levels: %d\n", num_levels);
-        printf("    Grid size: %d, %d\n", grib.grid_ni, grib.grid_nj);
-        printf("\n");
-        printf("    Output Table Bounds:\n");
-        printf("      Latitude -  min: %f, max: %f, step: %f\n",
-	       g_lat_min, g_lat_max, g_lat_step);
-        printf("      Longitude - min: %f, max: %f, step: %f\n",
-	       g_lon_min, g_lon_max, g_lon_step);
-        printf("      Altitude -  min: %f, max: %f, step: %f\n",
-	       g_alt_min, g_alt_max, g_alt_step);
-        printf("      Latitude cells:  %ld\n", lat_size);
-        printf("      Longitude cells: %ld\n", lon_size);
-        printf("      Altitude cells:  %ld\n\n", alt_size);
-
-        // Declare grid
-        WindGrid grid(g_lat_min, g_lat_max, g_lat_step,
-                  g_lon_min, g_lon_max, g_lon_step,
-                  g_alt_min, g_alt_max, g_alt_step);
-
-    // build the wind tables for the current file
-        build_wind_grid(grib, &grid);
-
         int slash = iter->second.find_last_of("/");
         string basename = iter->second.substr(slash+1);
 
-        // write the output for the current hour
         int dot = basename.find_last_of(".");
         string ofname = basename.substr(0, dot)+".h5";
         string ofpath = out_dir + "/" + ofname;
 
-        write_wind_grid_hdf5(ofpath, grid);
+        // Several hours may share one GRIB file
+        if (out_files.find(ofpath) != out_files.end()) continue;
+        out_files[ofpath] = iter->first;
+
+        if (!g_overwrite && is_hour_converted(ofpath, grid)) {
+          printf("  hour: %d,  file: %s already converted.  Skipped.\n",
+                 iter->first, ofpath.c_str());
+          num_skipped++;
+          continue;
+        }
+
+        wind_task_t task;
+        task.hour = iter->first;
+        task.grib_file = iter->second;
+        task.out_file = ofpath;
+
+        tasks.push_back(task);
+    }
+
+    int num_jobs = (g_num_jobs > 0) ? g_num_jobs : omp_get_max_threads();
+    if (num_jobs > (int)tasks.size()) num_jobs = (int)tasks.size();
+    if (num_jobs < 1) num_jobs = 1;
+
+    printf("  Converting %d hours with %d jobs", (int)tasks.size(), num_jobs);
+    if (g_max_memory_mb > 0) printf(", memory budget %ld MB", (long)g_max_memory_mb);
+    if (g_compress_level > 0) printf(", deflate level %d", g_compress_level);
+    printf("\n\n");
+
+    int num_failed = 0;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_jobs) reduction(+:num_failed)
+    for (int i = 0; i < (int)tasks.size(); ++i) {
+        if (convert_wind_hour(tasks[i], grid) != 0) {
+          num_failed++;
+        }
     }
 
+    printf("\n  Hours converted: %d,  skipped: %d,  failed: %d\n",
+           (int)tasks.size() - num_failed, num_skipped, num_failed);
+
     gettimeofday(&t_end, NULL);
 
     double total_time = delta_timeval(t_end, t_start);
@@ -723,5 +1160,5 @@ int main(int argc, char* argv[]) {
 
     printf("\nGood bye.\n");
 
-    return 0;
+    return (num_failed > 0) ? -1 : 0;
 }